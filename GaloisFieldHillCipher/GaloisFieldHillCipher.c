@@ -7,6 +7,7 @@ int main(int argc, char** argv)
     OPERATION_MODE mode = MODE_UNINITIALIZED;
     GlobalArguments* global_arguments = NULL;
     void* parsed_arguments = NULL;
+    uint64_t run_start_time = get_monotonic_time_ns();
 
     return_code = parse_mode(&mode, argc, argv);
     if (STATUS_FAILED(return_code))
@@ -23,11 +24,28 @@ int main(int argc, char** argv)
     }
 
     set_verbose_mode(global_arguments->verbose);
+    // Debug lines only reach the console in verbose mode, so their formatting can be skipped otherwise
+    set_console_log_level(global_arguments->verbose ? LOG_TRACE : LOG_WARN);
+    // Stage latencies feed both the --stats breakdown and the metrics histograms
+    set_stage_timing_mode(global_arguments->stats || (NULL != global_arguments->metrics_file));
+    set_tuning_cache_file(global_arguments->tuning_cache_file);
 
     if (global_arguments->log_file)
     {
         log_file = fopen(global_arguments->log_file, "a");
-        log_add_fp(log_file, LOG_TRACE);
+        if (NULL == log_file)
+        {
+            printf("[!] Failed to open log file %s.\n", global_arguments->log_file);
+            return_code = STATUS_CODE_COULDNT_OPEN_FILE;
+            goto cleanup;
+        }
+        // Hot path log calls format their message into a record in a ring, a writer thread timestamps, writes and flushes them
+        return_code = start_async_logger(log_file, LOG_TRACE);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+        set_log_file_level(LOG_TRACE);
     }
 
     return_code = parse_mode_arguments(&parsed_arguments, mode, argc, argv);
@@ -57,12 +75,36 @@ int main(int argc, char** argv)
     case GENERATE_AND_DECRYPT_MODE:
         return_code = handle_generate_and_decrypt_mode((GenerateAndDecryptArguments*)parsed_arguments);
         break;
+    case REKEY_MODE:
+        return_code = handle_rekey_mode((RekeyArguments*)parsed_arguments);
+        break;
+    case BATCH_MODE:
+        return_code = handle_batch_mode((BatchArguments*)parsed_arguments);
+        break;
+    case SHARD_MODE:
+        return_code = handle_shard_mode((ShardArguments*)parsed_arguments);
+        break;
     default:
         printf("[!] Invalid mode specified.\n");
         return_code = STATUS_CODE_INVALID_ARGUMENT;
     }
 
+    if (global_arguments->stats)
+    {
+        print_stage_statistics(get_status_output());
+    }
+
+    if (NULL != global_arguments->metrics_file)
+    {
+        set_metric_gauge(METRIC_GAUGE_RUN_DURATION_SECONDS, (double)(get_monotonic_time_ns() - run_start_time) / (double)NANOSECONDS_IN_SECOND);
+        if (STATUS_FAILED(dump_metrics_to_file(global_arguments->metrics_file)))
+        {
+            log_error("[!] Failed to dump metrics to %s", global_arguments->metrics_file);
+        }
+    }
+
 cleanup:
+    stop_async_logger();
     if (log_file)
     {
         fclose(log_file);
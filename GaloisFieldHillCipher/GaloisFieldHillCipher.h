@@ -11,3 +11,6 @@
 #include "include/Cipher/CipherModeHandlers.h"
 #include "include/IO/PrintUtils.h"
 #include "include/IO/VerbosityControl.h"
+#include "include/IO/AsyncLogger.h"
+#include "include/Instrumentation/StageTimers.h"
+#include "include/Instrumentation/Metrics.h"
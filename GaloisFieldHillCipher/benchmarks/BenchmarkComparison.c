@@ -0,0 +1,216 @@
+#include "BenchmarkComparison.h"
+
+static const char* find_json_value(const char* object_start, const char* object_end, const char* key)
+{
+    char pattern[BENCHMARK_NAME_SIZE];
+    const char* position = NULL;
+    size_t pattern_length = 0;
+
+    (void)snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    pattern_length = strlen(pattern);
+
+    for (position = object_start; position + pattern_length <= object_end; ++position)
+    {
+        if (0 == strncmp(position, pattern, pattern_length))
+        {
+            position += pattern_length;
+            while ((position < object_end) && (' ' == *position))
+            {
+                ++position;
+            }
+            return position;
+        }
+    }
+
+    return NULL;
+}
+
+static STATUS_CODE parse_benchmark_result(BenchmarkResult* out_result, const char* object_start, const char* object_end)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    const char* name = NULL;
+    const char* name_end = NULL;
+    const char* dimension = find_json_value(object_start, object_end, "dimension");
+    const char* prime_field = find_json_value(object_start, object_end, "prime_field");
+    const char* input_size = find_json_value(object_start, object_end, "input_size");
+    const char* iterations = find_json_value(object_start, object_end, "iterations");
+    const char* nanoseconds_per_operation = find_json_value(object_start, object_end, "ns_per_op");
+    const char* megabytes_per_second = find_json_value(object_start, object_end, "mb_per_s");
+    const char* cycles_per_byte = find_json_value(object_start, object_end, "cycles_per_byte");
+
+    name = find_json_value(object_start, object_end, "name");
+    if ((NULL == name) || ('"' != *name) || (NULL == dimension) || (NULL == prime_field) || (NULL == input_size) ||
+        (NULL == iterations) || (NULL == nanoseconds_per_operation) || (NULL == megabytes_per_second) || (NULL == cycles_per_byte))
+    {
+        log_error("[!] Benchmark entry is missing a field");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    ++name;
+    name_end = memchr(name, '"', (size_t)(object_end - name));
+    if ((NULL == name_end) || ((size_t)(name_end - name) >= BENCHMARK_NAME_SIZE))
+    {
+        log_error("[!] Benchmark entry has an invalid name");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    memset(out_result, 0, sizeof(*out_result));
+    memcpy(out_result->name, name, (size_t)(name_end - name));
+    out_result->dimension = (uint32_t)strtoul(dimension, NULL, 10);
+    out_result->prime_field = (uint32_t)strtoul(prime_field, NULL, 10);
+    out_result->input_size = (uint32_t)strtoul(input_size, NULL, 10);
+    out_result->iterations = (uint64_t)strtoull(iterations, NULL, 10);
+    out_result->nanoseconds_per_operation = strtod(nanoseconds_per_operation, NULL);
+    out_result->megabytes_per_second = strtod(megabytes_per_second, NULL);
+    out_result->has_cycle_counter = (0 != strncmp(cycles_per_byte, "null", strlen("null")));
+    out_result->cycles_per_byte = out_result->has_cycle_counter ? strtod(cycles_per_byte, NULL) : 0.0;
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE load_benchmark_report_json(BenchmarkReport* out_report, const char* filepath)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    BenchmarkReport report = {0};
+    BenchmarkResult result;
+    uint8_t* data = NULL;
+    uint32_t data_size = 0;
+    char* text = NULL;
+    const char* object_start = NULL;
+    const char* object_end = NULL;
+
+    if ((NULL == out_report) || (NULL == filepath))
+    {
+        log_error("[!] Invalid arguments in load_benchmark_report_json");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    return_code = read_uint8_from_file(&data, &data_size, filepath);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    text = (char*)malloc((size_t)data_size + 1);
+    if (NULL == text)
+    {
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    memcpy(text, data, data_size);
+    text[data_size] = '\0';
+
+    object_start = strstr(text, "\"benchmarks\"");
+    object_start = (NULL != object_start) ? strchr(object_start, '[') : NULL;
+    if (NULL == object_start)
+    {
+        log_error("[!] %s is not a benchmark report", filepath);
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    // Entries are flat objects, so every '{' is closed by the next '}'
+    while (NULL != (object_start = strchr(object_start, '{')))
+    {
+        object_end = strchr(object_start, '}');
+        if (NULL == object_end)
+        {
+            log_error("[!] Unterminated benchmark entry in %s", filepath);
+            return_code = STATUS_CODE_INVALID_ARGUMENT;
+            goto cleanup;
+        }
+
+        return_code = parse_benchmark_result(&result, object_start, object_end);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+
+        return_code = append_benchmark_result(&report, &result);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+        object_start = object_end + 1;
+    }
+
+    *out_report = report;
+    memset(&report, 0, sizeof(report));
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    free_benchmark_report(&report);
+    free(data);
+    free(text);
+    return return_code;
+}
+
+static const BenchmarkResult* find_matching_result(const BenchmarkReport* report, const BenchmarkResult* result)
+{
+    uint32_t index = 0;
+
+    for (index = 0; index < report->number_of_results; ++index)
+    {
+        if ((0 == strcmp(report->results[index].name, result->name)) &&
+            (report->results[index].dimension == result->dimension) &&
+            (report->results[index].prime_field == result->prime_field) &&
+            (report->results[index].input_size == result->input_size))
+        {
+            return &report->results[index];
+        }
+    }
+
+    return NULL;
+}
+
+STATUS_CODE compare_benchmark_reports(bool* out_regressed, const BenchmarkReport* baseline, const BenchmarkReport* current, double threshold, FILE* output)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    const BenchmarkResult* baseline_result = NULL;
+    const BenchmarkResult* current_result = NULL;
+    double change = 0.0;
+    bool regressed = false, case_regressed = false;
+    uint32_t index = 0;
+
+    if ((NULL == out_regressed) || (NULL == baseline) || (NULL == current) || (threshold < 0.0) || (NULL == output))
+    {
+        log_error("[!] Invalid arguments in compare_benchmark_reports");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    fprintf(output, "%-36s %6s %11s %8s %12s %12s %9s\n", "kernel", "d", "p", "n", "base MB/s", "curr MB/s", "change");
+    for (index = 0; index < baseline->number_of_results; ++index)
+    {
+        baseline_result = &baseline->results[index];
+        current_result = find_matching_result(current, baseline_result);
+        if (NULL == current_result)
+        {
+            fprintf(output, "%-36s %6u %11u %8u %12.2f %12s %9s  MISSING\n", baseline_result->name, baseline_result->dimension,
+                    baseline_result->prime_field, baseline_result->input_size, baseline_result->megabytes_per_second, "-", "-");
+            regressed = true;
+            continue;
+        }
+
+        change = (baseline_result->megabytes_per_second > 0.0) ?
+            (current_result->megabytes_per_second / baseline_result->megabytes_per_second) - 1.0 : 0.0;
+        case_regressed = (change < -threshold);
+        regressed = regressed || case_regressed;
+
+        fprintf(output, "%-36s %6u %11u %8u %12.2f %12.2f %+8.1f%%%s\n", baseline_result->name, baseline_result->dimension,
+                baseline_result->prime_field, baseline_result->input_size, baseline_result->megabytes_per_second,
+                current_result->megabytes_per_second, change * PERCENT, case_regressed ? "  REGRESSED" : "");
+    }
+
+    fprintf(output, "%s: allowed throughput loss is %.1f%%\n", regressed ? "FAILED" : "PASSED", threshold * PERCENT);
+
+    *out_regressed = regressed;
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
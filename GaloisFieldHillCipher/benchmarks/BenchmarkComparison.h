@@ -0,0 +1,36 @@
+#ifndef BENCHMARK_COMPARISON_H
+#define BENCHMARK_COMPARISON_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "BenchmarkHarness.h"
+#include "IO/FileOperations.h"
+
+#define DEFAULT_REGRESSION_THRESHOLD (0.25)
+#define PERCENT (100.0)
+
+/**
+ * @brief Loads a report previously written by write_benchmark_report_json.
+ *
+ * @param out_report - Pointer to the output report, released with free_benchmark_report.
+ * @param filepath - Path of the JSON report.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE load_benchmark_report_json(BenchmarkReport* out_report, const char* filepath);
+
+/**
+ * @brief Compares the throughput of every baseline case with the matching current case and prints a per-kernel diff.
+ *        Cases are matched by name, dimension, prime field and input size.
+ *
+ * @param out_regressed - Pointer to the output flag, true if any case lost more than the threshold of its baseline throughput.
+ * @param baseline - The stored baseline report.
+ * @param current - The freshly measured report.
+ * @param threshold - The allowed relative throughput loss, e.g. 0.25 for 25%.
+ * @param output - The stream the diff is printed to.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE compare_benchmark_reports(bool* out_regressed, const BenchmarkReport* baseline, const BenchmarkReport* current, double threshold, FILE* output);
+
+#endif //BENCHMARK_COMPARISON_H
@@ -0,0 +1,173 @@
+#include "BenchmarkHarness.h"
+
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+bool read_cycle_counter(uint64_t* out_cycles)
+{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    *out_cycles = (uint64_t)__rdtsc();
+    return true;
+#else
+    *out_cycles = 0;
+    return false;
+#endif
+}
+
+STATUS_CODE append_benchmark_result(BenchmarkReport* report, const BenchmarkResult* result)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    BenchmarkResult* results = NULL;
+    uint32_t capacity = 0;
+
+    if ((NULL == report) || (NULL == result))
+    {
+        log_error("[!] Invalid arguments in append_benchmark_result");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    if (report->number_of_results == report->capacity)
+    {
+        capacity = (0 == report->capacity) ? INITIAL_BENCHMARK_REPORT_CAPACITY : (report->capacity * 2);
+        results = (BenchmarkResult*)realloc(report->results, capacity * sizeof(BenchmarkResult));
+        if (NULL == results)
+        {
+            log_error("[!] Memory allocation failed for benchmark report");
+            return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+            goto cleanup;
+        }
+        report->results = results;
+        report->capacity = capacity;
+    }
+
+    report->results[report->number_of_results++] = *result;
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE run_benchmark(BenchmarkReport* report, const char* name, uint32_t dimension, uint32_t prime_field, uint32_t input_size, BenchmarkOperation operation, void* context)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    BenchmarkResult result;
+    uint64_t iterations = 1, iteration = 0;
+    uint64_t start_time = 0, elapsed_time = 0, start_cycles = 0, end_cycles = 0;
+    bool has_cycle_counter = false;
+
+    if ((NULL == report) || (NULL == name) || (NULL == operation))
+    {
+        log_error("[!] Invalid arguments in run_benchmark");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    // Warm up caches and lazy initializations once
+    return_code = operation(context);
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("[!] Benchmark %s failed with status %d", name, return_code);
+        goto cleanup;
+    }
+
+    for (;;)
+    {
+        has_cycle_counter = read_cycle_counter(&start_cycles);
+        start_time = get_monotonic_time_ns();
+        for (iteration = 0; iteration < iterations; ++iteration)
+        {
+            return_code = operation(context);
+            if (STATUS_FAILED(return_code))
+            {
+                log_error("[!] Benchmark %s failed with status %d", name, return_code);
+                goto cleanup;
+            }
+        }
+        elapsed_time = get_monotonic_time_ns() - start_time;
+        (void)read_cycle_counter(&end_cycles);
+
+        if ((elapsed_time >= BENCHMARK_MINIMAL_DURATION_NS) || (iterations >= BENCHMARK_MAXIMAL_ITERATIONS))
+        {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    memset(&result, 0, sizeof(result));
+    strncpy(result.name, name, BENCHMARK_NAME_SIZE - 1);
+    result.dimension = dimension;
+    result.prime_field = prime_field;
+    result.input_size = input_size;
+    result.iterations = iterations;
+    result.nanoseconds_per_operation = (double)elapsed_time / (double)iterations;
+    result.megabytes_per_second = (0 == elapsed_time) ? 0.0 :
+        ((double)input_size * (double)iterations / BYTES_IN_MEGABYTE) / ((double)elapsed_time / (double)NANOSECONDS_IN_SECOND);
+    result.has_cycle_counter = has_cycle_counter && (0 != input_size);
+    result.cycles_per_byte = result.has_cycle_counter ?
+        ((double)(end_cycles - start_cycles) / ((double)input_size * (double)iterations)) : 0.0;
+
+    fprintf(stderr, "[*] %-40s d=%-5u p=%-11u n=%-8u %14.1f ns/op %10.2f MB/s\n",
+            result.name, dimension, prime_field, input_size, result.nanoseconds_per_operation, result.megabytes_per_second);
+
+    return_code = append_benchmark_result(report, &result);
+
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE write_benchmark_report_json(FILE* output, const BenchmarkReport* report)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    const BenchmarkResult* result = NULL;
+    uint32_t index = 0;
+
+    if ((NULL == output) || (NULL == report))
+    {
+        log_error("[!] Invalid arguments in write_benchmark_report_json");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    fprintf(output, "{\n  \"benchmarks\": [\n");
+    for (index = 0; index < report->number_of_results; ++index)
+    {
+        result = &report->results[index];
+        fprintf(output,
+                "    {\"name\": \"%s\", \"dimension\": %u, \"prime_field\": %u, \"input_size\": %u, "
+                "\"iterations\": %llu, \"ns_per_op\": %.3f, \"mb_per_s\": %.3f, ",
+                result->name, result->dimension, result->prime_field, result->input_size,
+                (unsigned long long)result->iterations, result->nanoseconds_per_operation, result->megabytes_per_second);
+        if (result->has_cycle_counter)
+        {
+            fprintf(output, "\"cycles_per_byte\": %.3f}", result->cycles_per_byte);
+        }
+        else
+        {
+            fprintf(output, "\"cycles_per_byte\": null}");
+        }
+        fprintf(output, "%s\n", (index + 1 < report->number_of_results) ? "," : "");
+    }
+    fprintf(output, "  ]\n}\n");
+
+    return_code = (0 == ferror(output)) ? STATUS_CODE_SUCCESS : STATUS_CODE_COULDNT_WRITE_FILE;
+
+cleanup:
+    return return_code;
+}
+
+void free_benchmark_report(BenchmarkReport* report)
+{
+    if (NULL == report)
+    {
+        return;
+    }
+
+    free(report->results);
+    report->results = NULL;
+    report->number_of_results = 0;
+    report->capacity = 0;
+}
@@ -0,0 +1,91 @@
+#ifndef BENCHMARK_HARNESS_H
+#define BENCHMARK_HARNESS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+#include "Instrumentation/StageTimers.h"
+
+#define BENCHMARK_NAME_SIZE (64)
+#define BENCHMARK_MINIMAL_DURATION_NS (50000000ULL)
+#define BENCHMARK_MAXIMAL_ITERATIONS (1ULL << 24)
+#define INITIAL_BENCHMARK_REPORT_CAPACITY (64)
+
+/**
+ * A single timed operation, the context holds every input the operation needs
+ * so that only the measured work runs inside the timing loop.
+ */
+typedef STATUS_CODE (*BenchmarkOperation)(void* context);
+
+struct BenchmarkResult {
+    char name[BENCHMARK_NAME_SIZE];
+    uint32_t dimension;
+    uint32_t prime_field;
+    uint32_t input_size;
+    uint64_t iterations;
+    double nanoseconds_per_operation;
+    double megabytes_per_second;
+    double cycles_per_byte;
+    bool has_cycle_counter;
+} typedef BenchmarkResult;
+
+struct BenchmarkReport {
+    BenchmarkResult* results;
+    uint32_t number_of_results;
+    uint32_t capacity;
+} typedef BenchmarkReport;
+
+/**
+ * @brief Reads the CPU cycle counter when the platform exposes one.
+ *
+ * @param out_cycles - Pointer to the output cycle count.
+ * @return true if the platform has a cycle counter, false otherwise.
+ */
+bool read_cycle_counter(uint64_t* out_cycles);
+
+/**
+ * @brief Appends a result to a report, growing it as needed.
+ *
+ * @param report - The report to append the result to.
+ * @param result - The result to copy into the report.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE append_benchmark_result(BenchmarkReport* report, const BenchmarkResult* result);
+
+/**
+ * @brief Times an operation, doubling the number of iterations until the run lasts at least BENCHMARK_MINIMAL_DURATION_NS,
+ *        and appends the result to the report.
+ *
+ * @param report - The report to append the result to.
+ * @param name - The benchmark name.
+ * @param dimension - The dimension of the benchmark case, 0 if not relevant.
+ * @param prime_field - The prime field of the benchmark case, 0 if not relevant.
+ * @param input_size - The number of input bytes processed by a single operation.
+ * @param operation - The operation to time.
+ * @param context - The context passed to the operation.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE run_benchmark(BenchmarkReport* report, const char* name, uint32_t dimension, uint32_t prime_field, uint32_t input_size, BenchmarkOperation operation, void* context);
+
+/**
+ * @brief Writes the report as a JSON document.
+ *
+ * @param output - The output stream.
+ * @param report - The report to write.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE write_benchmark_report_json(FILE* output, const BenchmarkReport* report);
+
+/**
+ * @brief Frees the memory held by a report.
+ *
+ * @param report - The report to free, may be NULL.
+ */
+void free_benchmark_report(BenchmarkReport* report);
+
+#endif //BENCHMARK_HARNESS_H
@@ -0,0 +1,359 @@
+#include "bench_CipherParts.h"
+
+#define BENCHMARK_RANDOM_BITS_TO_ADD (2)
+#define BENCHMARK_NUMBER_OF_ERROR_VECTORS (2)
+#define BENCHMARK_LETTERS_PER_DIGIT (2)
+
+static const uint32_t input_sizes[] = {1024, 65536};
+static const uint32_t cipher_dimensions[] = {4, 16, 64};
+static const uint32_t prime_fields[] = {257, 65537, 16777619};
+
+struct BytesBenchmarkContext {
+    uint8_t* bytes;
+    uint32_t size;
+    uint8_t* permutation_vector;
+    uint32_t number_of_letters_per_element;
+} typedef BytesBenchmarkContext;
+
+struct ElementsBenchmarkContext {
+    int64_t* elements;
+    uint32_t number_of_elements;
+    uint32_t prime_field;
+    uint8_t** ascii_mapping;
+    uint32_t digits_per_element;
+} typedef ElementsBenchmarkContext;
+
+struct CipherBenchmarkContext {
+    Secrets* secrets;
+    uint8_t* plaintext;
+    uint32_t plaintext_size;
+    int64_t* ciphertext;
+    uint32_t ciphertext_bit_size;
+    uint8_t* serialized_ciphertext;
+    uint32_t serialized_ciphertext_size;
+    CIPHERTEXT_FORMAT format;
+} typedef CipherBenchmarkContext;
+
+static STATUS_CODE benchmark_add_random_bits_between_bytes(void* context)
+{
+    BytesBenchmarkContext* benchmark_context = (BytesBenchmarkContext*)context;
+    uint8_t* expanded = NULL;
+    uint32_t expanded_bit_size = 0;
+    STATUS_CODE return_code = add_random_bits_between_bytes(&expanded, &expanded_bit_size, benchmark_context->bytes,
+                                                            benchmark_context->size * BYTE_SIZE, BENCHMARK_RANDOM_BITS_TO_ADD);
+    free(expanded);
+    return return_code;
+}
+
+static STATUS_CODE benchmark_permutate_uint8_vector(void* context)
+{
+    BytesBenchmarkContext* benchmark_context = (BytesBenchmarkContext*)context;
+    uint8_t* permuted = NULL;
+    STATUS_CODE return_code = permutate_uint8_vector(&permuted, benchmark_context->bytes, benchmark_context->size,
+                                                     benchmark_context->permutation_vector, benchmark_context->number_of_letters_per_element);
+    free(permuted);
+    return return_code;
+}
+
+static STATUS_CODE benchmark_map_from_int64_to_ascii(void* context)
+{
+    ElementsBenchmarkContext* benchmark_context = (ElementsBenchmarkContext*)context;
+    uint8_t* ascii = NULL;
+    uint32_t ascii_size = 0;
+    STATUS_CODE return_code = map_from_int64_to_ascii(&ascii, &ascii_size, benchmark_context->elements, benchmark_context->number_of_elements,
+                                                      benchmark_context->ascii_mapping, BENCHMARK_LETTERS_PER_DIGIT,
+                                                      benchmark_context->digits_per_element);
+    free(ascii);
+    return return_code;
+}
+
+static STATUS_CODE benchmark_serialize_vector(void* context)
+{
+    ElementsBenchmarkContext* benchmark_context = (ElementsBenchmarkContext*)context;
+    uint8_t* serialized = NULL;
+    uint32_t serialized_size = 0;
+    STATUS_CODE return_code = serialize_vector(&serialized, &serialized_size, benchmark_context->elements,
+                                               benchmark_context->number_of_elements, benchmark_context->prime_field);
+    free(serialized);
+    return return_code;
+}
+
+static STATUS_CODE benchmark_encrypt(void* context)
+{
+    CipherBenchmarkContext* benchmark_context = (CipherBenchmarkContext*)context;
+    int64_t* ciphertext = NULL;
+    uint32_t ciphertext_bit_size = 0;
+    STATUS_CODE return_code = encrypt(&ciphertext, &ciphertext_bit_size, benchmark_context->plaintext,
+                                      benchmark_context->plaintext_size * BYTE_SIZE, *benchmark_context->secrets);
+    free(ciphertext);
+    return return_code;
+}
+
+static STATUS_CODE benchmark_decrypt(void* context)
+{
+    CipherBenchmarkContext* benchmark_context = (CipherBenchmarkContext*)context;
+    uint8_t* plaintext = NULL;
+    uint32_t plaintext_bit_size = 0;
+    STATUS_CODE return_code = decrypt(&plaintext, &plaintext_bit_size, benchmark_context->ciphertext,
+                                      benchmark_context->ciphertext_bit_size, *benchmark_context->secrets);
+    free(plaintext);
+    return return_code;
+}
+
+static STATUS_CODE benchmark_encrypt_and_serialize(void* context)
+{
+    CipherBenchmarkContext* benchmark_context = (CipherBenchmarkContext*)context;
+    uint8_t* ciphertext = NULL;
+    uint32_t ciphertext_size = 0;
+    STATUS_CODE return_code = encrypt_and_serialize(&ciphertext, &ciphertext_size, benchmark_context->plaintext,
+                                                    benchmark_context->plaintext_size, *benchmark_context->secrets,
+                                                    benchmark_context->format);
+    free(ciphertext);
+    return return_code;
+}
+
+static STATUS_CODE benchmark_deserialize_and_decrypt(void* context)
+{
+    CipherBenchmarkContext* benchmark_context = (CipherBenchmarkContext*)context;
+    uint8_t* plaintext = NULL;
+    uint32_t plaintext_size = 0;
+    STATUS_CODE return_code = deserialize_and_decrypt(&plaintext, &plaintext_size, benchmark_context->serialized_ciphertext,
+                                                      benchmark_context->serialized_ciphertext_size, *benchmark_context->secrets,
+                                                      benchmark_context->format);
+    free(plaintext);
+    return return_code;
+}
+
+static STATUS_CODE run_bytes_benchmarks(BenchmarkReport* report, uint32_t size)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    BytesBenchmarkContext context = {0};
+
+    context.size = size;
+    context.number_of_letters_per_element = calculate_digits_per_element(DEFAULT_PRIME_GALOIS_FIELD) * BENCHMARK_LETTERS_PER_DIGIT;
+    // Keep whole permutation groups
+    context.size -= context.size % context.number_of_letters_per_element;
+
+    context.bytes = (uint8_t*)malloc(context.size);
+    if (NULL == context.bytes)
+    {
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    return_code = generate_secure_random_bytes(context.bytes, context.size);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    return_code = generate_permutation_vector(&context.permutation_vector, context.number_of_letters_per_element);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    return_code = run_benchmark(report, "add_random_bits_between_bytes", 0, 0, context.size,
+                                benchmark_add_random_bits_between_bytes, &context);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    return_code = run_benchmark(report, "permutate_uint8_vector", 0, 0, context.size,
+                                benchmark_permutate_uint8_vector, &context);
+
+cleanup:
+    free(context.bytes);
+    free(context.permutation_vector);
+    return return_code;
+}
+
+static STATUS_CODE run_elements_benchmarks(BenchmarkReport* report, uint32_t prime_field, uint32_t size)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    ElementsBenchmarkContext context = {0};
+    uint32_t random_number = 0;
+    size_t index = 0;
+
+    context.prime_field = prime_field;
+    context.number_of_elements = size / (uint32_t)sizeof(int64_t);
+    context.digits_per_element = calculate_digits_per_element(prime_field);
+
+    context.elements = (int64_t*)malloc(context.number_of_elements * sizeof(int64_t));
+    if (NULL == context.elements)
+    {
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    for (index = 0; index < context.number_of_elements; ++index)
+    {
+        return_code = generate_secure_random_number(&random_number, 0, prime_field);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+        context.elements[index] = random_number;
+    }
+
+    return_code = generate_ascii_mapping(&context.ascii_mapping, BENCHMARK_LETTERS_PER_DIGIT, NUMBER_OF_DIGITS);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    return_code = run_benchmark(report, "map_from_int64_to_ascii", 0, prime_field, size,
+                                benchmark_map_from_int64_to_ascii, &context);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    return_code = run_benchmark(report, "serialize_vector", 0, prime_field, size,
+                                benchmark_serialize_vector, &context);
+
+cleanup:
+    free(context.elements);
+    if (context.ascii_mapping)
+    {
+        (void)free_uint8_matrix(context.ascii_mapping, NUMBER_OF_DIGITS);
+    }
+    return return_code;
+}
+
+static STATUS_CODE run_cipher_benchmarks(BenchmarkReport* report, uint32_t dimension, uint32_t prime_field, uint32_t size)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    KeyGenerationArguments key_generation_arguments = {NULL, dimension, BENCHMARK_NUMBER_OF_ERROR_VECTORS, prime_field,
+                                                       BENCHMARK_RANDOM_BITS_TO_ADD, BENCHMARK_LETTERS_PER_DIGIT};
+    Secrets* encryption_secrets = NULL;
+    Secrets* decryption_secrets = NULL;
+    CipherBenchmarkContext context = {0};
+
+    context.plaintext_size = size;
+    context.format = CIPHERTEXT_FORMAT_BINARY;
+    context.plaintext = (uint8_t*)malloc(size);
+    if (NULL == context.plaintext)
+    {
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    return_code = generate_secure_random_bytes(context.plaintext, size);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    return_code = build_encryption_secrets(&encryption_secrets, &key_generation_arguments);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    context.secrets = encryption_secrets;
+
+    return_code = run_benchmark(report, "encrypt", dimension, prime_field, size, benchmark_encrypt, &context);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    return_code = run_benchmark(report, "encrypt_and_serialize", dimension, prime_field, size, benchmark_encrypt_and_serialize, &context);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    // Keep one ciphertext of each kind for the decryption side
+    return_code = encrypt(&context.ciphertext, &context.ciphertext_bit_size, context.plaintext, size * BYTE_SIZE, *encryption_secrets);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    return_code = encrypt_and_serialize(&context.serialized_ciphertext, &context.serialized_ciphertext_size, context.plaintext, size,
+                                        *encryption_secrets, context.format);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    // Takes ownership of part of the encryption secrets, so encryption benchmarks must run before
+    return_code = build_decryption_secrets(&decryption_secrets, encryption_secrets);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    context.secrets = decryption_secrets;
+
+    return_code = run_benchmark(report, "decrypt", dimension, prime_field, size, benchmark_decrypt, &context);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    return_code = run_benchmark(report, "deserialize_and_decrypt", dimension, prime_field, size, benchmark_deserialize_and_decrypt, &context);
+
+cleanup:
+    if (encryption_secrets)
+    {
+        free_secrets(encryption_secrets);
+        free(encryption_secrets);
+    }
+    if (decryption_secrets)
+    {
+        free_secrets(decryption_secrets);
+        free(decryption_secrets);
+    }
+    free(context.plaintext);
+    free(context.ciphertext);
+    free(context.serialized_ciphertext);
+    return return_code;
+}
+
+STATUS_CODE run_all_CipherParts_benchmarks(BenchmarkReport* report)
+{
+    STATUS_CODE return_code = STATUS_CODE_SUCCESS;
+    size_t size_index = 0, prime_index = 0, dimension_index = 0;
+
+    for (size_index = 0; size_index < sizeof(input_sizes) / sizeof(input_sizes[0]); ++size_index)
+    {
+        return_code = run_bytes_benchmarks(report, input_sizes[size_index]);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+
+        for (prime_index = 0; prime_index < sizeof(prime_fields) / sizeof(prime_fields[0]); ++prime_index)
+        {
+            return_code = run_elements_benchmarks(report, prime_fields[prime_index], input_sizes[size_index]);
+            if (STATUS_FAILED(return_code))
+            {
+                goto cleanup;
+            }
+
+            for (dimension_index = 0; dimension_index < sizeof(cipher_dimensions) / sizeof(cipher_dimensions[0]); ++dimension_index)
+            {
+                return_code = run_cipher_benchmarks(report, cipher_dimensions[dimension_index], prime_fields[prime_index], input_sizes[size_index]);
+                if (STATUS_FAILED(return_code))
+                {
+                    goto cleanup;
+                }
+            }
+        }
+    }
+
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE run_hot_CipherParts_benchmarks(BenchmarkReport* report)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+
+    return_code = run_elements_benchmarks(report, HOT_CIPHER_PRIME_FIELD, HOT_CIPHER_INPUT_SIZE);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    return_code = run_cipher_benchmarks(report, HOT_CIPHER_DIMENSION, HOT_CIPHER_PRIME_FIELD, HOT_CIPHER_INPUT_SIZE);
+
+cleanup:
+    return return_code;
+}
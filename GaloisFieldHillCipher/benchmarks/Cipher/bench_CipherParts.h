@@ -0,0 +1,18 @@
+#pragma once
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "BenchmarkHarness.h"
+#include "Cipher/Cipher.h"
+#include "Cipher/CipherParts/CiphertextExpansion.h"
+#include "Cipher/CipherParts/AsciiMapping.h"
+#include "Cipher/CipherParts/Permutation.h"
+#include "Secrets/SecretsGeneration.h"
+#include "IO/SerDes.h"
+
+#define HOT_CIPHER_DIMENSION (16)
+#define HOT_CIPHER_PRIME_FIELD (16777619)
+#define HOT_CIPHER_INPUT_SIZE (65536)
+
+STATUS_CODE run_all_CipherParts_benchmarks(BenchmarkReport* report);
+STATUS_CODE run_hot_CipherParts_benchmarks(BenchmarkReport* report);
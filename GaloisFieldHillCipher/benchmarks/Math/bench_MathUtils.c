@@ -0,0 +1,337 @@
+#include "bench_MathUtils.h"
+
+static const uint32_t multiplication_dimensions[] = {4, 16, 64, 256};
+static const uint32_t elimination_dimensions[] = {8, 32, 128};
+static const uint32_t prime_fields[] = {257, 65537, 16777619, 2147483647};
+static const uint32_t gf2_dimensions[] = {8, 64, 256};
+static const uint32_t column_tables_dimensions[] = {8, 16}; // The unrolled dimensions whose tables fit the default budget
+static const uint32_t column_tables_prime_fields[] = {257, 65537};
+
+struct MatrixBenchmarkContext {
+    int64_t** matrix;
+    uint8_t* vector;
+    uint32_t dimension;
+    uint32_t prime_field;
+} typedef MatrixBenchmarkContext;
+
+struct GF2BenchmarkContext {
+    GF2BitMatrix matrix;
+    uint8_t* blocks;
+    uint8_t* out_blocks;
+} typedef GF2BenchmarkContext;
+
+struct ColumnTablesBenchmarkContext {
+    FieldVector flat_matrix;
+    FieldVector offset_vector;
+    ColumnProductTables tables;
+    uint8_t* blocks;
+    FieldVector out_blocks;
+} typedef ColumnTablesBenchmarkContext;
+
+static STATUS_CODE benchmark_multiply_matrix_with_uint8_t_vector(void* context)
+{
+    MatrixBenchmarkContext* benchmark_context = (MatrixBenchmarkContext*)context;
+    int64_t* result = NULL;
+    STATUS_CODE return_code = multiply_matrix_with_uint8_t_vector(&result, benchmark_context->matrix, benchmark_context->vector,
+                                                                  benchmark_context->dimension, benchmark_context->prime_field);
+    free(result);
+    return return_code;
+}
+
+static STATUS_CODE benchmark_inverse_square_matrix_gauss_jordan(void* context)
+{
+    MatrixBenchmarkContext* benchmark_context = (MatrixBenchmarkContext*)context;
+    int64_t** inverse = NULL;
+    STATUS_CODE return_code = inverse_square_matrix_gauss_jordan(&inverse, benchmark_context->matrix,
+                                                                 benchmark_context->dimension, benchmark_context->prime_field);
+    if (inverse)
+    {
+        (void)free_int64_matrix(inverse, benchmark_context->dimension);
+    }
+    return return_code;
+}
+
+static STATUS_CODE benchmark_matrix_determinant_over_galois_field_gauss_jordan(void* context)
+{
+    MatrixBenchmarkContext* benchmark_context = (MatrixBenchmarkContext*)context;
+    int64_t determinant = 0;
+    return matrix_determinant_over_galois_field_gauss_jordan(&determinant, benchmark_context->matrix,
+                                                             benchmark_context->dimension, benchmark_context->prime_field);
+}
+
+static STATUS_CODE run_matrix_benchmark(BenchmarkReport* report, const char* name, BenchmarkOperation operation, uint32_t dimension, uint32_t prime_field, uint32_t input_size)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    MatrixBenchmarkContext context = {0};
+
+    context.dimension = dimension;
+    context.prime_field = prime_field;
+
+    return_code = generate_invertible_matrix_over_field(&context.matrix, NULL, dimension, prime_field);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    context.vector = (uint8_t*)malloc(dimension);
+    if (NULL == context.vector)
+    {
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    return_code = generate_secure_random_bytes(context.vector, dimension);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    return_code = run_benchmark(report, name, dimension, prime_field, input_size, operation, &context);
+
+cleanup:
+    if (context.matrix)
+    {
+        (void)free_int64_matrix(context.matrix, dimension);
+    }
+    free(context.vector);
+    return return_code;
+}
+
+static STATUS_CODE benchmark_multiply_gf2_blocks(void* context)
+{
+    GF2BenchmarkContext* benchmark_context = (GF2BenchmarkContext*)context;
+    return multiply_gf2_blocks(benchmark_context->out_blocks, benchmark_context->blocks, GF2_BENCHMARK_BLOCKS,
+                               &benchmark_context->matrix, NULL, NULL);
+}
+
+static STATUS_CODE run_gf2_benchmark(BenchmarkReport* report, uint32_t dimension)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    GF2BenchmarkContext context = {0};
+    int64_t** matrix = NULL;
+    FieldVector flat_matrix = {0};
+    uint32_t input_size = GF2_BENCHMARK_BLOCKS * (dimension / GF2_BITS_PER_BYTE);
+
+    return_code = generate_invertible_matrix_over_field(&matrix, NULL, dimension, GF2_PRIME_FIELD);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    return_code = flatten_square_matrix_over_field(&flat_matrix, matrix, dimension, GF2_PRIME_FIELD);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    return_code = pack_gf2_bit_matrix(&context.matrix, &flat_matrix, dimension);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    context.blocks = (uint8_t*)malloc(input_size);
+    context.out_blocks = (uint8_t*)malloc(input_size);
+    if ((NULL == context.blocks) || (NULL == context.out_blocks))
+    {
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    return_code = generate_secure_random_bytes(context.blocks, input_size);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    return_code = run_benchmark(report, "multiply_gf2_blocks", dimension, GF2_PRIME_FIELD, input_size, benchmark_multiply_gf2_blocks, &context);
+
+cleanup:
+    if (matrix)
+    {
+        (void)free_int64_matrix(matrix, dimension);
+    }
+    free_field_vector(&flat_matrix);
+    free_gf2_bit_matrix(&context.matrix);
+    free(context.blocks);
+    free(context.out_blocks);
+    return return_code;
+}
+
+static STATUS_CODE benchmark_multiply_flat_matrix_with_uint8_t_blocks(void* context)
+{
+    ColumnTablesBenchmarkContext* benchmark_context = (ColumnTablesBenchmarkContext*)context;
+    return multiply_flat_matrix_with_uint8_t_blocks(&benchmark_context->out_blocks, &benchmark_context->flat_matrix, benchmark_context->blocks,
+                                                    COLUMN_TABLES_BENCHMARK_BLOCKS, &benchmark_context->offset_vector,
+                                                    benchmark_context->tables.dimension, benchmark_context->tables.prime_field, true);
+}
+
+static STATUS_CODE benchmark_multiply_column_product_tables_with_uint8_t_blocks(void* context)
+{
+    ColumnTablesBenchmarkContext* benchmark_context = (ColumnTablesBenchmarkContext*)context;
+    return multiply_column_product_tables_with_uint8_t_blocks(&benchmark_context->out_blocks, &benchmark_context->tables, benchmark_context->blocks,
+                                                              COLUMN_TABLES_BENCHMARK_BLOCKS, &benchmark_context->offset_vector);
+}
+
+static STATUS_CODE run_column_tables_benchmark(BenchmarkReport* report, uint32_t dimension, uint32_t prime_field)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    ColumnTablesBenchmarkContext context = {0};
+    int64_t** matrix = NULL;
+    uint32_t input_size = COLUMN_TABLES_BENCHMARK_BLOCKS * dimension;
+
+    return_code = generate_invertible_matrix_over_field(&matrix, NULL, dimension, prime_field);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    return_code = flatten_square_matrix_over_field(&context.flat_matrix, matrix, dimension, prime_field);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    return_code = build_column_product_tables(&context.tables, &context.flat_matrix, dimension, prime_field);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    return_code = allocate_field_vector(&context.offset_vector, dimension, prime_field);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    return_code = allocate_field_vector(&context.out_blocks, input_size, prime_field);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    context.blocks = (uint8_t*)malloc(input_size);
+    if (NULL == context.blocks)
+    {
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    return_code = generate_secure_random_bytes(context.blocks, input_size);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    return_code = run_benchmark(report, "multiply_flat_matrix_with_uint8_t_blocks", dimension, prime_field, input_size,
+                                benchmark_multiply_flat_matrix_with_uint8_t_blocks, &context);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    return_code = run_benchmark(report, "multiply_column_product_tables_with_uint8_t_blocks", dimension, prime_field, input_size,
+                                benchmark_multiply_column_product_tables_with_uint8_t_blocks, &context);
+
+cleanup:
+    if (matrix)
+    {
+        (void)free_int64_matrix(matrix, dimension);
+    }
+    free_field_vector(&context.flat_matrix);
+    free_field_vector(&context.offset_vector);
+    free_field_vector(&context.out_blocks);
+    free_column_product_tables(&context.tables);
+    free(context.blocks);
+    return return_code;
+}
+
+STATUS_CODE run_all_MathUtils_benchmarks(BenchmarkReport* report)
+{
+    STATUS_CODE return_code = STATUS_CODE_SUCCESS;
+    size_t dimension_index = 0, prime_index = 0;
+    uint32_t dimension = 0, prime_field = 0;
+
+    for (prime_index = 0; prime_index < sizeof(prime_fields) / sizeof(prime_fields[0]); ++prime_index)
+    {
+        prime_field = prime_fields[prime_index];
+
+        for (dimension_index = 0; dimension_index < sizeof(multiplication_dimensions) / sizeof(multiplication_dimensions[0]); ++dimension_index)
+        {
+            dimension = multiplication_dimensions[dimension_index];
+            // One plaintext block of dimension bytes per operation
+            return_code = run_matrix_benchmark(report, "multiply_matrix_with_uint8_t_vector",
+                                               benchmark_multiply_matrix_with_uint8_t_vector, dimension, prime_field, dimension);
+            if (STATUS_FAILED(return_code))
+            {
+                goto cleanup;
+            }
+        }
+
+        for (dimension_index = 0; dimension_index < sizeof(elimination_dimensions) / sizeof(elimination_dimensions[0]); ++dimension_index)
+        {
+            dimension = elimination_dimensions[dimension_index];
+            return_code = run_matrix_benchmark(report, "inverse_square_matrix_gauss_jordan",
+                                               benchmark_inverse_square_matrix_gauss_jordan, dimension, prime_field,
+                                               dimension * dimension * (uint32_t)sizeof(int64_t));
+            if (STATUS_FAILED(return_code))
+            {
+                goto cleanup;
+            }
+
+            return_code = run_matrix_benchmark(report, "matrix_determinant_gauss_jordan",
+                                               benchmark_matrix_determinant_over_galois_field_gauss_jordan, dimension, prime_field,
+                                               dimension * dimension * (uint32_t)sizeof(int64_t));
+            if (STATUS_FAILED(return_code))
+            {
+                goto cleanup;
+            }
+        }
+    }
+
+    // Small keys encrypt through their column product tables, next to the interleaved kernel they replace
+    for (prime_index = 0; prime_index < sizeof(column_tables_prime_fields) / sizeof(column_tables_prime_fields[0]); ++prime_index)
+    {
+        for (dimension_index = 0; dimension_index < sizeof(column_tables_dimensions) / sizeof(column_tables_dimensions[0]); ++dimension_index)
+        {
+            return_code = run_column_tables_benchmark(report, column_tables_dimensions[dimension_index], column_tables_prime_fields[prime_index]);
+            if (STATUS_FAILED(return_code))
+            {
+                goto cleanup;
+            }
+        }
+    }
+
+    // Over GF(2) the blocks are bits, the inverse runs the Four Russians elimination
+    for (dimension_index = 0; dimension_index < sizeof(gf2_dimensions) / sizeof(gf2_dimensions[0]); ++dimension_index)
+    {
+        return_code = run_gf2_benchmark(report, gf2_dimensions[dimension_index]);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+    }
+    for (dimension_index = 0; dimension_index < sizeof(elimination_dimensions) / sizeof(elimination_dimensions[0]); ++dimension_index)
+    {
+        dimension = elimination_dimensions[dimension_index];
+        return_code = run_matrix_benchmark(report, "inverse_square_matrix_gauss_jordan", benchmark_inverse_square_matrix_gauss_jordan,
+                                           dimension, GF2_PRIME_FIELD, dimension * dimension * (uint32_t)sizeof(int64_t));
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+    }
+
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE run_hot_MathUtils_benchmarks(BenchmarkReport* report)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+
+    return_code = run_matrix_benchmark(report, "multiply_matrix_with_uint8_t_vector",
+                                       benchmark_multiply_matrix_with_uint8_t_vector, HOT_KERNEL_DIMENSION, HOT_KERNEL_PRIME_FIELD,
+                                       HOT_KERNEL_DIMENSION);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    return_code = run_matrix_benchmark(report, "inverse_square_matrix_gauss_jordan",
+                                       benchmark_inverse_square_matrix_gauss_jordan, HOT_KERNEL_DIMENSION, HOT_KERNEL_PRIME_FIELD,
+                                       HOT_KERNEL_DIMENSION * HOT_KERNEL_DIMENSION * (uint32_t)sizeof(int64_t));
+
+cleanup:
+    return return_code;
+}
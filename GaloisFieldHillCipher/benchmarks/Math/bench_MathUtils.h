@@ -0,0 +1,20 @@
+#pragma once
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "BenchmarkHarness.h"
+#include "Math/MatrixUtils.h"
+#include "Math/MatrixInverse.h"
+#include "Math/MatrixDeterminant.h"
+#include "Math/MatrixMultiplication.h"
+#include "Math/BitslicedGF2.h"
+#include "Math/ColumnProductTables.h"
+#include "Cipher/CipherParts/CSPRNG.h"
+
+#define HOT_KERNEL_DIMENSION (64)
+#define HOT_KERNEL_PRIME_FIELD (16777619)
+#define GF2_BENCHMARK_BLOCKS (1024) // Blocks per multiply_gf2_blocks call, whole slices
+#define COLUMN_TABLES_BENCHMARK_BLOCKS (1024) // Blocks per call of the table kernel and of the interleaved kernel it replaces
+
+STATUS_CODE run_all_MathUtils_benchmarks(BenchmarkReport* report);
+STATUS_CODE run_hot_MathUtils_benchmarks(BenchmarkReport* report);
@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "BenchmarkHarness.h"
+#include "BenchmarkComparison.h"
+#include "Math/bench_MathUtils.h"
+#include "Cipher/bench_CipherParts.h"
+
+struct BenchmarkArguments {
+    bool hot_kernels_only;
+    const char* output_file;
+    const char* baseline_file;
+    double threshold;
+} typedef BenchmarkArguments;
+
+static void print_benchmark_usage(const char* program)
+{
+    fprintf(stderr, "Usage: %s [--hot] [--output report.json] [--gate baseline.json] [--threshold 0.25]\n", program);
+    fprintf(stderr, "  --hot        Only run the hot kernels covered by the regression gate\n");
+    fprintf(stderr, "  --output     Write the JSON report to a file instead of stdout\n");
+    fprintf(stderr, "  --gate       Run the hot kernels and fail if throughput regressed against the baseline\n");
+    fprintf(stderr, "  --threshold  Allowed relative throughput loss for --gate (default %.2f)\n", DEFAULT_REGRESSION_THRESHOLD);
+}
+
+static STATUS_CODE parse_benchmark_arguments(BenchmarkArguments* out_arguments, int argc, char** argv)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    char* end = NULL;
+    int index = 0;
+
+    out_arguments->hot_kernels_only = false;
+    out_arguments->output_file = NULL;
+    out_arguments->baseline_file = NULL;
+    out_arguments->threshold = DEFAULT_REGRESSION_THRESHOLD;
+
+    for (index = 1; index < argc; ++index)
+    {
+        if (0 == strcmp(argv[index], "--hot"))
+        {
+            out_arguments->hot_kernels_only = true;
+        }
+        else if ((0 == strcmp(argv[index], "--output")) && (index + 1 < argc))
+        {
+            out_arguments->output_file = argv[++index];
+        }
+        else if ((0 == strcmp(argv[index], "--gate")) && (index + 1 < argc))
+        {
+            out_arguments->baseline_file = argv[++index];
+            out_arguments->hot_kernels_only = true;
+        }
+        else if ((0 == strcmp(argv[index], "--threshold")) && (index + 1 < argc))
+        {
+            out_arguments->threshold = strtod(argv[++index], &end);
+            if ((end == argv[index]) || (out_arguments->threshold < 0.0) || (out_arguments->threshold >= 1.0))
+            {
+                log_error("[!] Threshold must be in [0, 1)");
+                return_code = STATUS_CODE_INVALID_ARGUMENT;
+                goto cleanup;
+            }
+        }
+        else
+        {
+            print_benchmark_usage(argv[0]);
+            return_code = STATUS_CODE_INVALID_ARGUMENT;
+            goto cleanup;
+        }
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
+
+int main(int argc, char** argv)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    BenchmarkArguments arguments;
+    BenchmarkReport report = {0};
+    BenchmarkReport baseline = {0};
+    FILE* output = stdout;
+    bool regressed = false;
+
+    // Per-block debug logs would dominate the measurements
+    log_set_level(LOG_ERROR);
+
+    return_code = parse_benchmark_arguments(&arguments, argc, argv);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    // Load the baseline first so a bad path fails before minutes of measurements
+    if (NULL != arguments.baseline_file)
+    {
+        return_code = load_benchmark_report_json(&baseline, arguments.baseline_file);
+        if (STATUS_FAILED(return_code))
+        {
+            log_error("[!] Couldn't load baseline %s", arguments.baseline_file);
+            goto cleanup;
+        }
+    }
+
+    return_code = arguments.hot_kernels_only ? run_hot_MathUtils_benchmarks(&report) : run_all_MathUtils_benchmarks(&report);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    return_code = arguments.hot_kernels_only ? run_hot_CipherParts_benchmarks(&report) : run_all_CipherParts_benchmarks(&report);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    if (NULL != arguments.output_file)
+    {
+        output = fopen(arguments.output_file, "w");
+        if (NULL == output)
+        {
+            log_error("[!] Couldn't open %s for writing", arguments.output_file);
+            return_code = STATUS_CODE_COULDNT_OPEN_FILE;
+            goto cleanup;
+        }
+    }
+
+    if ((NULL == arguments.baseline_file) || (NULL != arguments.output_file))
+    {
+        return_code = write_benchmark_report_json(output, &report);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+    }
+
+    if (NULL != arguments.baseline_file)
+    {
+        return_code = compare_benchmark_reports(&regressed, &baseline, &report, arguments.threshold, stdout);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+        return_code = regressed ? STATUS_CODE_PERFORMANCE_REGRESSION : STATUS_CODE_SUCCESS;
+    }
+
+cleanup:
+    if ((NULL != output) && (stdout != output))
+    {
+        fclose(output);
+    }
+    free_benchmark_report(&report);
+    free_benchmark_report(&baseline);
+    return STATUS_FAILED(return_code) ? 1 : 0;
+}
@@ -0,0 +1,603 @@
+#ifndef HILL_CIPHER_HPP
+#define HILL_CIPHER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include "StatusCodes.h"
+#include "Secrets/Secrets.h"
+#include "Secrets/SecretsGeneration.h"
+#include "Secrets/MappedSecrets.h"
+#include "Parsing/ModeParsers.h"
+#include "Cipher/Cipher.h"
+#include "Cipher/CipherParts/AffineTransformation.h"
+#include "Cipher/CipherParts/CSPRNG.h"
+#include "Cipher/CipherParts/Padding.h"
+#include "IO/FileOperations.h"
+#include "IO/SerDes.h"
+#include "Math/MatrixUtils.h"
+#include "Math/BitslicedGF2.h"
+}
+
+/**
+ * Header-only C++17 wrapper around the C core for services that embed the cipher.
+ * Secrets and buffers are move-only RAII owners, inputs are borrowed through Span without copies.
+ * HillCipher<Dimension, PrimeField> compiles the binary hot path for one key shape with constexpr reduction constants and
+ * std::array kernels, HillCipher<> and any key the fixed shape can't run (circulant keys, keys over GF(2), text ciphertexts) use the C core.
+ * Failures are thrown as hill::Error carrying the STATUS_CODE of the C core.
+ */
+namespace hill {
+
+constexpr uint32_t DYNAMIC_EXTENT = 0;
+
+class Error : public std::runtime_error {
+public:
+    Error(STATUS_CODE status, const std::string& operation)
+        : std::runtime_error(operation + " failed with status " + std::to_string(static_cast<int>(status))), m_status(status) {}
+
+    STATUS_CODE status() const noexcept { return m_status; }
+
+private:
+    STATUS_CODE m_status;
+};
+
+inline void throw_if_failed(STATUS_CODE status, const char* operation)
+{
+    if (STATUS_FAILED(status))
+    {
+        throw Error(status, operation);
+    }
+}
+
+/**
+ * Non-owning view of contiguous elements, the C++17 stand-in for std::span.
+ */
+template <typename T>
+class Span {
+public:
+    constexpr Span() noexcept = default;
+    constexpr Span(T* data, std::size_t size) noexcept : m_data(data), m_size(size) {}
+    template <std::size_t N>
+    constexpr Span(T (&array)[N]) noexcept : m_data(array), m_size(N) {}
+    template <typename U, std::size_t N, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(std::array<U, N>& array) noexcept : m_data(array.data()), m_size(N) {}
+    template <typename U, std::size_t N, typename = std::enable_if_t<std::is_convertible_v<const U (*)[], T (*)[]>>>
+    constexpr Span(const std::array<U, N>& array) noexcept : m_data(array.data()), m_size(N) {}
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    Span(std::vector<U>& vector) noexcept : m_data(vector.data()), m_size(vector.size()) {}
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<const U (*)[], T (*)[]>>>
+    Span(const std::vector<U>& vector) noexcept : m_data(vector.data()), m_size(vector.size()) {}
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(const Span<U>& other) noexcept : m_data(other.data()), m_size(other.size()) {}
+
+    constexpr T* data() const noexcept { return m_data; }
+    constexpr std::size_t size() const noexcept { return m_size; }
+    constexpr bool empty() const noexcept { return 0 == m_size; }
+    constexpr T& operator[](std::size_t index) const noexcept { return m_data[index]; }
+    constexpr T* begin() const noexcept { return m_data; }
+    constexpr T* end() const noexcept { return m_data + m_size; }
+
+private:
+    T* m_data = nullptr;
+    std::size_t m_size = 0;
+};
+
+using ByteSpan = Span<const uint8_t>;
+
+enum class Format {
+    Binary = CIPHERTEXT_FORMAT_BINARY,
+    Text = CIPHERTEXT_FORMAT_TEXT,
+};
+
+/**
+ * A byte buffer allocated with malloc, either by the C core or by the fixed-shape path, released with free.
+ */
+class Buffer {
+public:
+    Buffer() noexcept = default;
+    Buffer(uint8_t* data, std::size_t size) noexcept : m_data(data), m_size(size) {}
+    explicit Buffer(std::size_t size) : m_data(static_cast<uint8_t*>(std::malloc((0 == size) ? 1 : size))), m_size(size)
+    {
+        if (nullptr == m_data)
+        {
+            throw Error(STATUS_CODE_ERROR_MEMORY_ALLOCATION, "Buffer allocation");
+        }
+    }
+    ~Buffer() { std::free(m_data); }
+
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+    Buffer(Buffer&& other) noexcept : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)) {}
+    Buffer& operator=(Buffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            std::free(m_data);
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+        }
+        return *this;
+    }
+
+    uint8_t* data() noexcept { return m_data; }
+    const uint8_t* data() const noexcept { return m_data; }
+    std::size_t size() const noexcept { return m_size; }
+    ByteSpan span() const noexcept { return ByteSpan(m_data, m_size); }
+
+    void shrink(std::size_t size) noexcept { m_size = (size < m_size) ? size : m_size; }
+
+private:
+    uint8_t* m_data = nullptr;
+    std::size_t m_size = 0;
+};
+
+/**
+ * Owner of a deserialized key, the memory is released with free_secrets.
+ */
+class Secrets {
+public:
+    Secrets() noexcept { std::memset(&m_secrets, 0, sizeof(m_secrets)); }
+    ~Secrets() { free_secrets(&m_secrets); }
+
+    Secrets(const Secrets&) = delete;
+    Secrets& operator=(const Secrets&) = delete;
+    Secrets(Secrets&& other) noexcept : m_secrets(other.m_secrets) { std::memset(&other.m_secrets, 0, sizeof(other.m_secrets)); }
+    Secrets& operator=(Secrets&& other) noexcept
+    {
+        if (this != &other)
+        {
+            free_secrets(&m_secrets);
+            m_secrets = other.m_secrets;
+            std::memset(&other.m_secrets, 0, sizeof(other.m_secrets));
+        }
+        return *this;
+    }
+
+    static Secrets from_bytes(ByteSpan key_data)
+    {
+        Secrets secrets;
+        throw_if_failed(deserialize_secrets(&secrets.m_secrets, const_cast<uint8_t*>(key_data.data()), static_cast<uint32_t>(key_data.size())),
+                        "deserialize_secrets");
+        return secrets;
+    }
+
+    // Mapped keys stay mapped for the lifetime of the object
+    static Secrets from_file(const std::string& path)
+    {
+        Secrets secrets;
+        throw_if_failed(load_secrets_file(&secrets.m_secrets, nullptr, path.c_str()), "load_secrets_file");
+        return secrets;
+    }
+
+    static Secrets generate(const KeyGenerationArguments& arguments)
+    {
+        ::Secrets* generated = nullptr;
+        throw_if_failed(build_encryption_secrets(&generated, &arguments), "build_encryption_secrets");
+        return adopt(generated);
+    }
+
+    /**
+     * @brief Builds the decryption key of this encryption key, which is left intact.
+     */
+    Secrets to_decryption_secrets() const
+    {
+        // build_decryption_secrets takes members over from its input, so it consumes a copy
+        Secrets encryption_secrets = from_bytes(to_bytes().span());
+        ::Secrets* generated = nullptr;
+        throw_if_failed(build_decryption_secrets(&generated, &encryption_secrets.m_secrets), "build_decryption_secrets");
+        Secrets decryption_secrets = adopt(generated);
+        decryption_secrets.m_secrets.number_of_random_bits_to_add = m_secrets.number_of_random_bits_to_add; // Not part of the serialized key
+        return decryption_secrets;
+    }
+
+    Buffer to_bytes() const
+    {
+        uint8_t* key_data = nullptr;
+        uint32_t key_size = 0;
+        throw_if_failed(serialize_secrets(&key_data, &key_size, m_secrets), "serialize_secrets");
+        return Buffer(key_data, key_size);
+    }
+
+    const ::Secrets& get() const noexcept { return m_secrets; }
+    uint32_t dimension() const noexcept { return m_secrets.dimension; }
+    uint32_t prime_field() const noexcept { return m_secrets.prime_field; }
+    bool is_circulant() const noexcept { return KEY_STRUCTURE_CIRCULANT == m_secrets.key_structure; }
+
+private:
+    // Takes over the members of a key allocated by the C core, the struct itself is released here
+    static Secrets adopt(::Secrets* generated) noexcept
+    {
+        Secrets secrets;
+        secrets.m_secrets = *generated;
+        std::free(generated);
+        return secrets;
+    }
+
+    ::Secrets m_secrets;
+};
+
+namespace detail {
+
+constexpr uint32_t bytes_per_element(uint32_t prime_field)
+{
+    uint32_t bits = 0;
+    for (uint32_t value = prime_field - 1; 0 != value; value >>= 1)
+    {
+        ++bits;
+    }
+    return (bits + 7) / 8;
+}
+
+// Number of products that can be summed on top of a reduced value without overflowing 64 bits, as calculate_accumulation_window
+constexpr uint64_t accumulation_window(uint64_t maximal_product, uint32_t prime_field)
+{
+    return (0 == maximal_product) ? std::numeric_limits<uint64_t>::max()
+                                  : (std::numeric_limits<uint64_t>::max() - prime_field) / maximal_product;
+}
+
+} // namespace detail
+
+/**
+ * A cipher bound to one key, move-only. Encryption keys encrypt and decryption keys decrypt, as with the C core.
+ *
+ * @tparam Dimension - The key dimension, DYNAMIC_EXTENT to run every key shape on the C core.
+ * @tparam PrimeField - The prime field, DYNAMIC_EXTENT to run every key shape on the C core.
+ */
+template <uint32_t Dimension = DYNAMIC_EXTENT, uint32_t PrimeField = DYNAMIC_EXTENT>
+class HillCipher {
+public:
+    static constexpr bool IS_FIXED_SHAPE = (DYNAMIC_EXTENT != Dimension) && (DYNAMIC_EXTENT != PrimeField);
+
+    static_assert((Dimension == DYNAMIC_EXTENT) == (PrimeField == DYNAMIC_EXTENT), "Dimension and prime field are fixed together");
+    static_assert(!IS_FIXED_SHAPE || (PrimeField >= 2), "The prime field must be at least 2");
+
+    using Element = std::conditional_t<(PrimeField <= MAXIMAL_PRIME_FIELD_FOR_UINT16_ELEMENTS), uint16_t, uint32_t>;
+
+    static constexpr std::size_t DIMENSION = IS_FIXED_SHAPE ? Dimension : 1;
+    static constexpr uint32_t BYTES_PER_ELEMENT = IS_FIXED_SHAPE ? detail::bytes_per_element(PrimeField) : 0;
+    static constexpr uint64_t ENCRYPTION_WINDOW = IS_FIXED_SHAPE ? detail::accumulation_window((uint64_t)(PrimeField - 1) * UINT8_MAX, PrimeField) : 0;
+    static constexpr uint64_t DECRYPTION_WINDOW = IS_FIXED_SHAPE ? detail::accumulation_window((uint64_t)(PrimeField - 1) * (PrimeField - 1), PrimeField) : 0;
+
+    using Block = std::array<uint8_t, DIMENSION>;
+    using FieldBlock = std::array<Element, DIMENSION>;
+
+    /**
+     * @brief Binds a key, a fixed-shape cipher rejects keys of another dimension or prime field.
+     *
+     * @param secrets - The key, owned by the cipher from now on.
+     */
+    explicit HillCipher(Secrets secrets) : m_secrets(std::move(secrets))
+    {
+        if constexpr (IS_FIXED_SHAPE)
+        {
+            if ((Dimension != m_secrets.dimension()) || (PrimeField != m_secrets.prime_field()))
+            {
+                throw Error(STATUS_CODE_INVALID_ARGUMENT, "HillCipher key shape check");
+            }
+            // GF(2) blocks are packed bits, the bit-sliced engine of the C core runs them
+            m_use_fixed_shape = !m_secrets.is_circulant() && (GF2_PRIME_FIELD != PrimeField);
+            if (m_use_fixed_shape)
+            {
+                load_fixed_shape_key();
+            }
+        }
+    }
+
+    HillCipher(const HillCipher&) = delete;
+    HillCipher& operator=(const HillCipher&) = delete;
+    HillCipher(HillCipher&&) noexcept = default;
+    HillCipher& operator=(HillCipher&&) noexcept = default;
+
+    const Secrets& secrets() const noexcept { return m_secrets; }
+
+    /**
+     * @brief Whether the binary hot path runs the compile-time kernels for this key.
+     */
+    bool uses_fixed_shape_kernels() const noexcept { return m_use_fixed_shape; }
+
+    /**
+     * @brief Encrypts a plaintext into a serialized ciphertext, byte compatible with encrypt_and_serialize.
+     *
+     * @param plaintext - The plaintext, read in place.
+     * @param format - Binary or text ciphertext.
+     * @return The serialized ciphertext, text ciphertexts end with a null terminator.
+     */
+    Buffer encrypt(ByteSpan plaintext, Format format = Format::Binary) const
+    {
+        if constexpr (IS_FIXED_SHAPE)
+        {
+            if (m_use_fixed_shape && (Format::Binary == format) && !plaintext.empty())
+            {
+                return encrypt_fixed_shape(plaintext);
+            }
+        }
+        uint8_t* ciphertext = nullptr;
+        uint32_t ciphertext_size = 0;
+        throw_if_failed(encrypt_and_serialize(&ciphertext, &ciphertext_size, const_cast<uint8_t*>(plaintext.data()), static_cast<uint32_t>(plaintext.size()),
+                                              m_secrets.get(), static_cast<CIPHERTEXT_FORMAT>(format)),
+                        "encrypt_and_serialize");
+        return Buffer(ciphertext, ciphertext_size);
+    }
+
+    /**
+     * @brief Decrypts a serialized ciphertext, byte compatible with deserialize_and_decrypt.
+     *
+     * @param ciphertext - The serialized ciphertext, read in place.
+     * @param format - Binary or text ciphertext.
+     * @return The plaintext.
+     */
+    Buffer decrypt(ByteSpan ciphertext, Format format = Format::Binary) const
+    {
+        if constexpr (IS_FIXED_SHAPE)
+        {
+            if (m_use_fixed_shape && (Format::Binary == format))
+            {
+                return decrypt_fixed_shape(ciphertext);
+            }
+        }
+        uint8_t* plaintext = nullptr;
+        uint32_t plaintext_size = 0;
+        throw_if_failed(deserialize_and_decrypt(&plaintext, &plaintext_size, const_cast<uint8_t*>(ciphertext.data()), static_cast<uint32_t>(ciphertext.size()),
+                                                m_secrets.get(), static_cast<CIPHERTEXT_FORMAT>(format)),
+                        "deserialize_and_decrypt");
+        return Buffer(plaintext, plaintext_size);
+    }
+
+    /**
+     * @brief Encrypts one assembled block, out = K * block + offset. Only available for a fixed shape.
+     */
+    template <bool Fixed = IS_FIXED_SHAPE, typename = std::enable_if_t<Fixed>>
+    void encrypt_block(FieldBlock& out_block, const Block& block) const
+    {
+        multiply_rows<ENCRYPTION_WINDOW>(out_block, block, m_offset);
+    }
+
+    /**
+     * @brief Decrypts one block with the offset already subtracted, out = K^-1 * block. Only available for a fixed shape.
+     */
+    template <bool Fixed = IS_FIXED_SHAPE, typename = std::enable_if_t<Fixed>>
+    void decrypt_block(Block& out_block, const FieldBlock& block) const
+    {
+        FieldBlock result;
+        multiply_rows<DECRYPTION_WINDOW>(result, block, ZERO_OFFSET);
+        for (std::size_t row = 0; row < DIMENSION; ++row)
+        {
+            if (result[row] > UINT8_MAX)
+            {
+                throw Error(STATUS_CODE_INVALID_RESULT_WIDTH, "HillCipher::decrypt_block");
+            }
+            out_block[row] = static_cast<uint8_t>(result[row]);
+        }
+    }
+
+private:
+    static constexpr FieldBlock ZERO_OFFSET = {};
+
+    void load_fixed_shape_key()
+    {
+        const ::Secrets& secrets = m_secrets.get();
+        FieldVector flat_matrix = {};
+        FieldVector offset = {};
+        STATUS_CODE status = STATUS_CODE_SUCCESS;
+        // Mapped keys are already flat
+        if (nullptr == secrets.flat_key_matrix.elements)
+        {
+            status = flatten_square_matrix_over_field(&flat_matrix, secrets.key_matrix, Dimension, PrimeField);
+        }
+        if (STATUS_SUCCESS(status) && (nullptr == secrets.combined_error_vector.elements))
+        {
+            status = combine_error_vectors(&offset, secrets.error_vectors, secrets.number_of_error_vectors, Dimension, PrimeField);
+        }
+        if (STATUS_SUCCESS(status))
+        {
+            const FieldVector* matrix_source = (nullptr == secrets.flat_key_matrix.elements) ? &flat_matrix : &secrets.flat_key_matrix;
+            const FieldVector* offset_source = (nullptr == secrets.combined_error_vector.elements) ? &offset : &secrets.combined_error_vector;
+            for (std::size_t index = 0; index < m_matrix.size(); ++index)
+            {
+                m_matrix[index] = static_cast<Element>(get_field_vector_element(matrix_source, index));
+            }
+            for (std::size_t index = 0; index < DIMENSION; ++index)
+            {
+                m_offset[index] = static_cast<Element>(get_field_vector_element(offset_source, index));
+            }
+        }
+        free_field_vector(&flat_matrix);
+        free_field_vector(&offset);
+        throw_if_failed(status, "HillCipher key flattening");
+    }
+
+    // Both loops have compile-time bounds and the reduction constant is known, so the compiler unrolls and strength-reduces the modulo
+    template <uint64_t Window, typename Input>
+    void multiply_rows(FieldBlock& out_block, const std::array<Input, DIMENSION>& block, const FieldBlock& offset) const
+    {
+        for (std::size_t row = 0; row < DIMENSION; ++row)
+        {
+            const Element* matrix_row = m_matrix.data() + (row * DIMENSION);
+            uint64_t accumulator = offset[row];
+            for (std::size_t column = 0; column < DIMENSION; ++column)
+            {
+                accumulator += static_cast<uint64_t>(matrix_row[column]) * block[column];
+                if constexpr (Window < DIMENSION)
+                {
+                    if (0 == ((column + 1) % Window))
+                    {
+                        accumulator %= PrimeField;
+                    }
+                }
+            }
+            out_block[row] = static_cast<Element>(accumulator % PrimeField);
+        }
+    }
+
+    // Mirrors encrypt_and_serialize for binary ciphertexts: bit expansion, padding, multiplication and big-endian serialization per block
+    Buffer encrypt_fixed_shape(ByteSpan plaintext) const
+    {
+        const uint32_t random_bits = m_secrets.get().number_of_random_bits_to_add;
+        const uint64_t expanded_size = ((static_cast<uint64_t>(plaintext.size()) * (BYTE_SIZE + random_bits)) + BYTE_SIZE - 1) / BYTE_SIZE;
+        const uint64_t number_of_blocks = (expanded_size / DIMENSION) + 1;
+        const uint64_t serialized_size = number_of_blocks * DIMENSION * BYTES_PER_ELEMENT;
+        if (serialized_size > UINT32_MAX)
+        {
+            throw Error(STATUS_CODE_ERROR_INVALID_SIZE, "HillCipher::encrypt");
+        }
+
+        Buffer ciphertext(static_cast<std::size_t>(serialized_size));
+        SecureRandomPool random_pool;
+        if (0 != random_bits)
+        {
+            throw_if_failed(initialize_secure_random_pool(&random_pool), "initialize_secure_random_pool");
+        }
+
+        Block block;
+        FieldBlock encrypted_block;
+        uint8_t* serialized_element = ciphertext.data();
+        uint64_t byte_index = 0, plaintext_byte = 0;
+        uint32_t bit_in_group = 0;
+        for (uint64_t block_number = 0; block_number < number_of_blocks; ++block_number)
+        {
+            for (std::size_t row = 0; row < DIMENSION; ++row, ++byte_index)
+            {
+                if (byte_index > expanded_size)
+                {
+                    block[row] = 0;
+                }
+                else if (byte_index == expanded_size)
+                {
+                    block[row] = PADDING_MAGIC;
+                }
+                else if (0 == random_bits)
+                {
+                    block[row] = plaintext[static_cast<std::size_t>(byte_index)];
+                }
+                else
+                {
+                    block[row] = expand_next_byte(plaintext, plaintext_byte, bit_in_group, random_bits, random_pool);
+                }
+            }
+
+            encrypt_block(encrypted_block, block);
+            for (std::size_t row = 0; row < DIMENSION; ++row)
+            {
+                uint32_t value = encrypted_block[row];
+                for (std::size_t byte = BYTES_PER_ELEMENT; byte > 0; --byte)
+                {
+                    serialized_element[byte - 1] = static_cast<uint8_t>(value & BYTE_MASK);
+                    value >>= BYTE_SIZE;
+                }
+                serialized_element += BYTES_PER_ELEMENT;
+            }
+        }
+        return ciphertext;
+    }
+
+    // Each plaintext byte is followed by random_bits random bits, the stream is consumed MSB first
+    static uint8_t expand_next_byte(ByteSpan plaintext, uint64_t& plaintext_byte, uint32_t& bit_in_group, uint32_t random_bits, SecureRandomPool& random_pool)
+    {
+        uint8_t expanded_byte = 0, bit = 0;
+        for (uint32_t bit_number = 0; bit_number < BYTE_SIZE; ++bit_number)
+        {
+            if (plaintext_byte >= plaintext.size())
+            {
+                bit = 0;
+            }
+            else if (bit_in_group < BYTE_SIZE)
+            {
+                bit = (plaintext[static_cast<std::size_t>(plaintext_byte)] >> (BYTE_SIZE - 1 - bit_in_group)) & 1;
+            }
+            else
+            {
+                throw_if_failed(draw_secure_random_bit(&bit, &random_pool), "draw_secure_random_bit");
+            }
+
+            expanded_byte = static_cast<uint8_t>((expanded_byte << 1) | bit);
+            if (++bit_in_group == BYTE_SIZE + random_bits)
+            {
+                bit_in_group = 0;
+                ++plaintext_byte;
+            }
+        }
+        return expanded_byte;
+    }
+
+    // Mirrors deserialize_and_decrypt for binary ciphertexts
+    Buffer decrypt_fixed_shape(ByteSpan ciphertext) const
+    {
+        const std::size_t block_size = DIMENSION * BYTES_PER_ELEMENT;
+        if ((0 == ciphertext.size()) || (0 != (ciphertext.size() % block_size)) || (ciphertext.size() > UINT32_MAX))
+        {
+            throw Error(STATUS_CODE_ERROR_INVALID_FILE_SIZE, "HillCipher::decrypt");
+        }
+
+        const std::size_t number_of_blocks = ciphertext.size() / block_size;
+        Buffer plaintext(number_of_blocks * DIMENSION);
+        FieldBlock field_block;
+        Block decrypted_block;
+        const uint8_t* serialized_element = ciphertext.data();
+        for (std::size_t block_number = 0; block_number < number_of_blocks; ++block_number)
+        {
+            for (std::size_t row = 0; row < DIMENSION; ++row)
+            {
+                uint64_t value = 0;
+                for (std::size_t byte = 0; byte < BYTES_PER_ELEMENT; ++byte)
+                {
+                    value = (value << BYTE_SIZE) | serialized_element[byte];
+                }
+                serialized_element += BYTES_PER_ELEMENT;
+                field_block[row] = static_cast<Element>(((value % PrimeField) + PrimeField - m_offset[row]) % PrimeField);
+            }
+            decrypt_block(decrypted_block, field_block);
+            std::memcpy(plaintext.data() + (block_number * DIMENSION), decrypted_block.data(), DIMENSION);
+        }
+
+        // The padding magic byte is the last non-zero byte, the random bits are then compacted out in place
+        std::size_t expanded_size = plaintext.size();
+        while ((expanded_size > 0) && (0 == plaintext.data()[expanded_size - 1]))
+        {
+            --expanded_size;
+        }
+        if ((0 == expanded_size) || (PADDING_MAGIC != plaintext.data()[expanded_size - 1]))
+        {
+            throw Error(STATUS_CODE_NO_PADDING, "HillCipher::decrypt");
+        }
+        --expanded_size;
+
+        const uint32_t group_size = BYTE_SIZE + m_secrets.get().number_of_random_bits_to_add;
+        const std::size_t plaintext_size = static_cast<std::size_t>((static_cast<uint64_t>(expanded_size) * BYTE_SIZE) / group_size);
+        if (BYTE_SIZE != group_size)
+        {
+            uint8_t* bytes = plaintext.data();
+            for (std::size_t byte_index = 0; byte_index < plaintext_size; ++byte_index)
+            {
+                uint64_t stream_bit = static_cast<uint64_t>(byte_index) * group_size;
+                uint8_t plaintext_byte = 0;
+                for (uint32_t bit_number = 0; bit_number < BYTE_SIZE; ++bit_number, ++stream_bit)
+                {
+                    plaintext_byte = static_cast<uint8_t>((plaintext_byte << 1) |
+                        ((bytes[stream_bit / BYTE_SIZE] >> (BYTE_SIZE - 1 - (stream_bit % BYTE_SIZE))) & 1));
+                }
+                bytes[byte_index] = plaintext_byte;
+            }
+        }
+        plaintext.shrink(plaintext_size);
+        return plaintext;
+    }
+
+    Secrets m_secrets;
+    bool m_use_fixed_shape = false;
+    std::array<Element, DIMENSION * DIMENSION> m_matrix = {};
+    FieldBlock m_offset = {};
+};
+
+} // namespace hill
+
+#endif //HILL_CIPHER_HPP
@@ -0,0 +1,109 @@
+#ifndef BATCH_PROCESSING_H
+#define BATCH_PROCESSING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+#include "Cipher/KeyStore.h"
+
+#define BATCH_KEY_STORE_BYTE_BUDGET ((size_t)256 * 1000 * 1000) // A dense d=512 key over GF(65537) prepares to about 1MB
+#define BATCH_MANIFEST_COMMENT_CHARACTER '#'
+#define BATCH_MANIFEST_FIELD_SEPARATORS " \t"
+#define BATCH_MANIFEST_TAB_SEPARATOR "\t" // Lines with a tab are split on tabs only, so paths may hold spaces
+#define BATCH_PATH_SEPARATOR '/'
+#define BATCH_INITIAL_JOB_CAPACITY (64)
+
+enum BATCH_DIRECTION
+{
+    BATCH_DIRECTION_ENCRYPT = 0,
+    BATCH_DIRECTION_DECRYPT,
+
+    NUMBER_OF_BATCH_DIRECTIONS
+} typedef BATCH_DIRECTION;
+
+/**
+ * One file of a batch. The formats follow the extensions as in the encrypt and decrypt modes:
+ * the output file picks the ciphertext format when encrypting, the input file when decrypting.
+ */
+struct BatchJob {
+    char* input_file;
+    char* output_file;
+    char* key_file; // Encryption key when encrypting, decryption key when decrypting
+    STATUS_CODE status; // Set by run_batch
+    uint32_t input_size;
+    uint32_t output_size;
+    uint64_t elapsed_ns;
+} typedef BatchJob;
+
+struct BatchJobList {
+    BatchJob* jobs;
+    uint32_t number_of_jobs;
+    uint32_t capacity;
+} typedef BatchJobList;
+
+struct BatchConfiguration {
+    BATCH_DIRECTION direction;
+    uint32_t number_of_threads; // The calling thread is one of them
+    size_t in_flight_byte_budget; // Input and output buffers of the files being processed, a file larger than it runs alone
+    size_t key_store_byte_budget;
+    FILE* status_output; // Receives a status line per file as it completes, may be NULL
+} typedef BatchConfiguration;
+
+struct BatchSummary {
+    uint32_t succeeded;
+    uint32_t failed;
+    uint64_t bytes_in;
+    uint64_t bytes_out;
+    uint64_t elapsed_ns;
+    size_t peak_in_flight_bytes;
+    KeyStoreStatistics key_store_statistics;
+} typedef BatchSummary;
+
+/**
+ * @brief Reads a manifest of files to process, one "input output [key]" line per file.
+ *        Blank lines and lines starting with '#' are skipped, fields are split on tabs when the line has one and on spaces otherwise.
+ *
+ * @param out_jobs - Pointer to the output job list, released with free_batch_jobs.
+ * @param manifest_file - The path of the manifest.
+ * @param default_key_file - The key of lines without one, may be NULL when every line has a key.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE read_batch_manifest(BatchJobList* out_jobs, const char* manifest_file, const char* default_key_file);
+
+/**
+ * @brief Lists the regular files of a directory as jobs writing files of the same name to another directory, sorted by name.
+ *
+ * @param out_jobs - Pointer to the output job list, released with free_batch_jobs.
+ * @param input_directory - The directory of the files to process.
+ * @param output_directory - The existing directory the results are written to.
+ * @param key_file - The key every file is processed with.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE list_batch_directory(BatchJobList* out_jobs, const char* input_directory, const char* output_directory, const char* key_file);
+
+/**
+ * @brief Frees the jobs of a list and resets it.
+ *
+ * @param jobs - The job list, may be NULL.
+ */
+void free_batch_jobs(BatchJobList* jobs);
+
+/**
+ * @brief Processes the jobs of a list on a pool of threads. Keys are loaded and prepared once through a shared key store,
+ *        and a file is only read once the buffers of the files in flight leave room for it within the budget.
+ *        A failed file is recorded in its job and does not stop the others.
+ *
+ * @param out_summary - Pointer to the output summary.
+ * @param jobs - The jobs, their status, sizes and timings are filled in.
+ * @param configuration - The direction, threads and budgets of the batch.
+ * @return STATUS_CODE - Success when every file succeeded, STATUS_CODE_BATCH_FILES_FAILED when some failed.
+ */
+STATUS_CODE run_batch(BatchSummary* out_summary, BatchJobList* jobs, const BatchConfiguration* configuration);
+
+#endif //BATCH_PROCESSING_H
@@ -10,14 +10,33 @@
 #include "CipherParts/BlockDividing.h"
 #include "Math/MatrixInverse.h"
 #include "Math/MatrixMultiplication.h"
+#include "Math/CirculantMatrix.h"
 #include "CipherParts/CiphertextExpansion.h"
 #include "CipherParts/Padding.h"
 #include "Cipher/CipherParts/AffineTransformation.h"
+#include "Cipher/CipherParts/Rekeying.h"
+#include "Cipher/CipherParts/BlockLoop.h"
+#include "Cipher/CipherContext.h"
+#include "Tuning/Autotuner.h"
 #include "IO/SerDes.h"
+#include "IO/AsyncFileIO.h"
 #include "../Secrets/Secrets.h"
 #include "IO/PrintUtils.h"
+#include "CipherParts/AsciiMapping.h"
+#include "CipherParts/CSPRNG.h"
+#include "Instrumentation/StageTimers.h"
 #include "log.h"
 
+enum CIPHERTEXT_FORMAT
+{
+	CIPHERTEXT_FORMAT_BINARY = 0,
+	CIPHERTEXT_FORMAT_TEXT,
+
+	NUMBER_OF_CIPHERTEXT_FORMATS
+} typedef CIPHERTEXT_FORMAT;
+
+#define CIPHER_STREAM_CHUNK_SIZE (1 << 16) // Bytes read per chunk of a stream, rounded to whole blocks of ciphertext when decrypting
+
 
 /**
  * @brief Encrypts a plaintext vector using the Extended Hill Cipher algorithm with affine transformation (error vectors).
@@ -43,5 +62,141 @@ STATUS_CODE encrypt(int64_t** out_ciphertext, uint32_t* out_ciphertext_size, uin
  */
 STATUS_CODE decrypt(uint8_t** out_plaintext, uint32_t* out_plaintext_size, int64_t* ciphertext_vector, uint32_t vector_size, Secrets secrets);
 
+/**
+ * @brief Encrypts a plaintext vector and serializes the ciphertext in a single pass.
+ *        Every block is expanded, padded, multiplied, offset and serialized while it is still in cache,
+ *        without building the intermediate full-size buffers of encrypt().
+ *
+ * @param out_serialized_ciphertext - Pointer to the output serialized ciphertext - allocated inside the function and memory released if fails.
+ * @param out_serialized_ciphertext_size - Pointer to the size of the serialized ciphertext in bytes (including the null terminator for text).
+ * @param plaintext_vector - The plaintext vector to be encrypted.
+ * @param plaintext_size - The size of the plaintext vector in bytes.
+ * @param secrets - The secrets containing the encryption matrix, error vectors, and other parameters.
+ * @param format - Binary (big-endian elements, see serialize_vector) or text (mapped and permutated ASCII).
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE encrypt_and_serialize(uint8_t** out_serialized_ciphertext, uint32_t* out_serialized_ciphertext_size, uint8_t* plaintext_vector, uint32_t plaintext_size, Secrets secrets, CIPHERTEXT_FORMAT format);
+
+/**
+ * @brief encrypt_and_serialize with a prepared key, nothing is derived from the secrets per call.
+ *        The context is only read, several threads may encrypt with the same context at once.
+ *
+ * @param out_serialized_ciphertext - Pointer to the output serialized ciphertext - allocated inside the function and memory released if fails.
+ * @param out_serialized_ciphertext_size - Pointer to the size of the serialized ciphertext in bytes (including the null terminator for text).
+ * @param plaintext_vector - The plaintext vector to be encrypted.
+ * @param plaintext_size - The size of the plaintext vector in bytes.
+ * @param context - The context prepared from the encryption secrets (see prepare_cipher_context).
+ * @param format - Binary (big-endian elements, see serialize_vector) or text (mapped and permutated ASCII).
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE encrypt_and_serialize_with_context(uint8_t** out_serialized_ciphertext, uint32_t* out_serialized_ciphertext_size, uint8_t* plaintext_vector, uint32_t plaintext_size, const CipherContext* context, CIPHERTEXT_FORMAT format);
+
+/**
+ * @brief Deserializes a ciphertext and decrypts it in a single pass, the mirror of encrypt_and_serialize.
+ *
+ * @param out_plaintext - Pointer to the output plaintext - allocated inside the function and memory released if fails.
+ * @param out_plaintext_size - Pointer to the size of the plaintext in bytes.
+ * @param serialized_ciphertext - The serialized ciphertext.
+ * @param serialized_ciphertext_size - The size of the serialized ciphertext in bytes (including the null terminator for text).
+ * @param secrets - The secrets containing the decryption matrix, error vectors, and other parameters.
+ * @param format - Binary or text, must match the format used for encryption.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE deserialize_and_decrypt(uint8_t** out_plaintext, uint32_t* out_plaintext_size, uint8_t* serialized_ciphertext, uint32_t serialized_ciphertext_size, Secrets secrets, CIPHERTEXT_FORMAT format);
+
+/**
+ * @brief deserialize_and_decrypt with a prepared key, the mirror of encrypt_and_serialize_with_context.
+ *
+ * @param out_plaintext - Pointer to the output plaintext - allocated inside the function and memory released if fails.
+ * @param out_plaintext_size - Pointer to the size of the plaintext in bytes.
+ * @param serialized_ciphertext - The serialized ciphertext.
+ * @param serialized_ciphertext_size - The size of the serialized ciphertext in bytes (including the null terminator for text).
+ * @param context - The context prepared from the decryption secrets (see prepare_cipher_context).
+ * @param format - Binary or text, must match the format used for encryption.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE deserialize_and_decrypt_with_context(uint8_t** out_plaintext, uint32_t* out_plaintext_size, uint8_t* serialized_ciphertext, uint32_t serialized_ciphertext_size, const CipherContext* context, CIPHERTEXT_FORMAT format);
+
+/**
+ * @brief Adds the random bits after every byte of a chunk of plaintext, the stage of the chunked encryptions before the block products.
+ *        Chunks of whole groups of BYTE_SIZE bytes expand to whole bytes, so they join up exactly like the whole plaintext would.
+ *
+ * @param out_expanded - Caller owned output of at least ceil(plaintext_size * (BYTE_SIZE + number_of_random_bits) / BYTE_SIZE) bytes.
+ * @param out_expanded_size - Pointer to the number of expanded bytes, the last one zero filled past the plaintext.
+ * @param plaintext - The plaintext chunk.
+ * @param plaintext_size - The size of the chunk in bytes.
+ * @param number_of_random_bits - The number of random bits added after every byte.
+ * @param random_pool - The random pool the bits are drawn from.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE expand_plaintext_chunk(uint8_t* out_expanded, size_t* out_expanded_size, const uint8_t* plaintext, size_t plaintext_size, uint32_t number_of_random_bits, SecureRandomPool* random_pool);
+
+/**
+ * @brief Serializes encrypted blocks to binary or maps them to permuted ASCII digits, the last stage of the chunked encryptions before the write.
+ *
+ * @param out_serialized - Caller owned output of chunk_elements * element_size bytes.
+ * @param ciphertext_chunk - The encrypted blocks.
+ * @param chunk_elements - The number of elements of the chunk to serialize.
+ * @param element_size - The bytes (binary) or digits (text) per element.
+ * @param digits_buffer - Caller owned scratch of element_size bytes, used for text only.
+ * @param secrets - The secrets holding the ASCII mapping and the permutation.
+ * @param random_pool - The random pool the mapped letters are drawn from.
+ * @param format - Binary or text.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE serialize_ciphertext_chunk(uint8_t* out_serialized, const FieldVector* ciphertext_chunk, size_t chunk_elements, uint32_t element_size,
+	uint8_t* digits_buffer, const Secrets* secrets, SecureRandomPool* random_pool, CIPHERTEXT_FORMAT format);
+
+/**
+ * @brief Encrypts a stream until the end of its input in chunks of CIPHER_STREAM_CHUNK_SIZE plaintext bytes,
+ *        only a chunk and the partial block carried over are held. The output is in the format of encrypt_and_serialize.
+ *        The next chunks are read ahead and the previous ones written behind while a chunk is encrypted (see AsyncFile).
+ *
+ * @param output - The stream the serialized ciphertext is written to, every write has completed on return.
+ * @param input - The plaintext stream, may be empty, with no buffered input.
+ * @param context - The context prepared from the encryption secrets (see prepare_cipher_context).
+ * @param format - Binary or text, a text ciphertext ends with a null terminator.
+ * @param io_backend - The backend reading ahead and writing behind.
+ * @param out_bytes_read - Pointer to the number of plaintext bytes read, may be NULL.
+ * @param out_bytes_written - Pointer to the number of ciphertext bytes written, may be NULL.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE encrypt_stream_with_context(FILE* output, FILE* input, const CipherContext* context, CIPHERTEXT_FORMAT format, ASYNC_IO_BACKEND io_backend,
+	uint64_t* out_bytes_read, uint64_t* out_bytes_written);
+
+/**
+ * @brief Decrypts a stream of serialized ciphertext until the end of its input, the mirror of encrypt_stream_with_context.
+ *        The last block is held back until the input ends since it holds the padding.
+ *
+ * @param output - The stream the plaintext is written to, every write has completed on return.
+ * @param input - The serialized ciphertext stream, with no buffered input.
+ * @param context - The context prepared from the decryption secrets (see prepare_cipher_context).
+ * @param format - Binary or text, must match the format used for encryption.
+ * @param io_backend - The backend reading ahead and writing behind.
+ * @param out_bytes_read - Pointer to the number of ciphertext bytes read, may be NULL.
+ * @param out_bytes_written - Pointer to the number of plaintext bytes written, may be NULL.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE decrypt_stream_with_context(FILE* output, FILE* input, const CipherContext* context, CIPHERTEXT_FORMAT format, ASYNC_IO_BACKEND io_backend,
+	uint64_t* out_bytes_read, uint64_t* out_bytes_written);
+
+/**
+ * @brief Moves a serialized ciphertext from one key to another in a single pass without recovering the plaintext,
+ *        every block goes through one product with K_new * K_old^-1 (see RekeyTransform).
+ *        Text ciphertexts are unmapped and unpermuted with the old secrets and mapped and permuted with the new ones.
+ *
+ * @param out_serialized_ciphertext - Pointer to the output serialized ciphertext - allocated inside the function and memory released if fails.
+ * @param out_serialized_ciphertext_size - Pointer to the size of the output ciphertext in bytes (including the null terminator for text).
+ * @param serialized_ciphertext - The serialized ciphertext under the old key.
+ * @param serialized_ciphertext_size - The size of the serialized ciphertext in bytes (including the null terminator for text).
+ * @param old_decryption_secrets - Decryption secrets of the old key.
+ * @param new_encryption_secrets - Encryption secrets of the new key, same dimension and prime field.
+ * @param input_format - Format of the input ciphertext.
+ * @param output_format - Format of the output ciphertext.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE rekey_serialized_ciphertext(uint8_t** out_serialized_ciphertext, uint32_t* out_serialized_ciphertext_size, uint8_t* serialized_ciphertext, uint32_t serialized_ciphertext_size,
+	Secrets old_decryption_secrets, Secrets new_encryption_secrets, CIPHERTEXT_FORMAT input_format, CIPHERTEXT_FORMAT output_format);
+
 #endif
 
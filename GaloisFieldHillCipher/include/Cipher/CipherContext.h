@@ -0,0 +1,88 @@
+#ifndef CIPHER_CONTEXT_H
+#define CIPHER_CONTEXT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+#include "Secrets/Secrets.h"
+#include "Math/FieldElement.h"
+#include "Math/MatrixUtils.h"
+#include "Math/CirculantMatrix.h"
+#include "Math/BitslicedGF2.h"
+#include "Math/ColumnProductTables.h"
+#include "Cipher/CipherParts/AffineTransformation.h"
+#include "Cipher/CipherParts/AsciiMapping.h"
+#include "Cipher/CipherParts/BlockLoop.h"
+#include "Tuning/Autotuner.h"
+
+#define UNKNOWN_CIPHER_INPUT_SIZE (UINT64_MAX) // The key serves any amount of input, e.g. a stream or a cached key
+
+/**
+ * Everything encryption and decryption derive from a key before the first block: the flat key matrix or the transformed
+ * circulant column, the combined error vector, the tuned block loop configuration and the text format tables.
+ * Keys over GF(2) are packed for the bit-sliced engine instead, their blocks are bits of the expanded plaintext.
+ * Dense encryption keys whose column product tables fit COLUMN_PRODUCT_TABLES_MEMORY_BUDGET encrypt through the tables.
+ * A prepared context is only read by the fused cipher functions, so one context can serve any number of threads at once,
+ * the per call buffers (circulant workspace, random pool, block loop workers) are made by every call.
+ */
+struct CipherContext {
+    Secrets secrets;
+    bool owns_secrets; // The secrets are released with the context, see adopt_secrets_into_cipher_context
+    bool is_circulant;
+    bool is_gf2; // Dense keys over GF(2), encrypted by multiply_gf2_blocks, binary ciphertexts only
+    FieldVector flat_key_matrix; // Owned, or a view of the flat key matrix of the secrets (mapped keys). Unused for circulant keys
+    FieldVector combined_error_vector; // Owned, or a view of the combined error vector of the secrets
+    CirculantKey circulant_key; // Circulant keys only, calls multiply through a view of it (see create_circulant_key_view)
+    GF2BitMatrix gf2_key_matrix; // Keys over GF(2) only, the packed flat key matrix
+    uint64_t* gf2_error_vector; // Keys over GF(2) only, the packed combined error vector
+    bool has_column_tables;
+    ColumnProductTables column_tables; // Dense encryption keys within the table budget only
+    BlockLoopConfiguration block_loop_configuration;
+    STATUS_CODE text_format_status; // Why the text format can't be used with the key, success when it can
+    int8_t ascii_to_digit_table[ASCII_TABLE_SIZE];
+    size_t size_in_bytes; // Memory held by the context, what a key cache accounts for it
+} typedef CipherContext;
+
+/**
+ * @brief Prepares a context for encryption or decryption, borrowing the secrets. The secrets must outlive the context.
+ *
+ * @param out_context - Pointer to the output context, released with free_cipher_context.
+ * @param secrets - The encryption or decryption secrets.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE prepare_cipher_context(CipherContext* out_context, const Secrets* secrets);
+
+/**
+ * @brief prepare_cipher_context for a known amount of input. Building the column product tables costs about as much as
+ *        encrypting COLUMN_PRODUCT_TABLE_ENTRIES blocks, so they are only built for inputs of at least that many blocks.
+ *
+ * @param out_context - Pointer to the output context, released with free_cipher_context.
+ * @param secrets - The encryption or decryption secrets.
+ * @param input_size - Bytes of plaintext the context will encrypt, 0 for decryption, UNKNOWN_CIPHER_INPUT_SIZE when unknown.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE prepare_cipher_context_for_input(CipherContext* out_context, const Secrets* secrets, uint64_t input_size);
+
+/**
+ * @brief Prepares a context that owns the secrets. Members of the secrets replaced by their prepared forms
+ *        (the jagged key and inverse matrices, the error vectors and the circulant column) are released right away.
+ *
+ * @param out_context - Pointer to the output context, released with free_cipher_context.
+ * @param secrets - The secrets, moved into the context and cleared on success.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE adopt_secrets_into_cipher_context(CipherContext* out_context, Secrets* secrets);
+
+/**
+ * @brief Frees a context, and its secrets if it owns them.
+ *
+ * @param context - The context to free, may be NULL.
+ */
+void free_cipher_context(CipherContext* context);
+
+#endif //CIPHER_CONTEXT_H
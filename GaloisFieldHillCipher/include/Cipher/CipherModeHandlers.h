@@ -9,10 +9,16 @@
 #include "IO/SerDes.h"
 #include "CipherParts/BlockDividing.h"
 #include "Cipher.h"
+#include "Cipher/BatchProcessing.h"
+#include "Cipher/CipherPipeline.h"
+#include "Cipher/ShardCoordinator.h"
 #include "CipherParts/AsciiMapping.h"
 #include "CipherParts/Permutation.h"
 #include "Secrets/SecretsGeneration.h"
+#include "Secrets/MappedSecrets.h"
 #include "IO/LoggerUtils.h"
+#include "Instrumentation/StageTimers.h"
+#include "Tuning/Autotuner.h"
 #include "log.h"
 
 /**
@@ -55,6 +61,30 @@ STATUS_CODE handle_decrypt_mode(const DecryptArguments* args);
  */
 STATUS_CODE handle_generate_and_decrypt_mode(const GenerateAndDecryptArguments* args);
 
+/**
+ * @brief Handle rekey mode - Move a ciphertext from one key to another without recovering the plaintext.
+ *
+ * @param args - The parsed main arguments
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE handle_rekey_mode(const RekeyArguments* args);
+
+/**
+ * @brief Handle batch mode - Encrypt or decrypt every file of a manifest or a directory in one process.
+ *
+ * @param args - The parsed main arguments
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE handle_batch_mode(const BatchArguments* args);
+
+/**
+ * @brief Handle shard mode - Encrypt a file in shards on local worker processes into an indexed container, or decrypt the container.
+ *
+ * @param args - The parsed main arguments
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE handle_shard_mode(const ShardArguments* args);
+
 /**
  * @brief Handle generate and encrypt mode - Generate an encryption key and then encrypt.
  *
@@ -3,6 +3,7 @@
 
 #include "StatusCodes.h"
 #include "Math/MathUtils.h"
+#include "Math/FieldElement.h"
 
 /**
  * @brief Adds multiple error vectors to a vector over a finite field (affine transformation).
@@ -30,4 +31,16 @@ STATUS_CODE add_affine_transformation(int64_t** out_transformed_vector, int64_t*
  */
 STATUS_CODE substruct_affine_transformation(int64_t** out_transformed_vector, int64_t** error_vectors, uint32_t number_of_error_vectors, int64_t* vector_to_transform, uint32_t dimension, uint32_t prime_field);
 
+/**
+ * @brief Sums all error vectors into a single offset vector over a finite field, so the affine step costs one addition per element.
+ *
+ * @param out_combined_error_vector Pointer to the output field vector - allocated inside the function and memory released if fails.
+ * @param error_vectors Array of error vectors to combine.
+ * @param number_of_error_vectors Number of error vectors.
+ * @param dimension The length of each vector.
+ * @param prime_field The modulus for finite field arithmetic.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE combine_error_vectors(FieldVector* out_combined_error_vector, int64_t** error_vectors, uint32_t number_of_error_vectors, uint32_t dimension, uint32_t prime_field);
+
 #endif
@@ -12,6 +12,8 @@
 #include "log.h"
 
 #define MAX_DIGIT (9)
+#define ASCII_TABLE_SIZE (256)
+#define UNMAPPED_ASCII_CHARACTER (-1)
 
 /**
  * @brief Maps an ASCII char into the corresponding digit.
@@ -52,4 +54,23 @@ STATUS_CODE map_from_int64_to_ascii(uint8_t** out_ascii, uint32_t* out_ascii_siz
 */
 STATUS_CODE map_from_ascii_to_int64(int64_t** out_int64, uint32_t* out_int64_size, uint8_t* data, uint32_t data_size, uint8_t** digit_to_ascii, uint32_t number_of_letters, uint32_t number_of_digits_per_field_element);
 
+/**
+ * @brief Builds a reverse lookup table from ASCII char to digit, so decoding costs one lookup per char.
+ *
+ * @param out_table - Caller owned table of ASCII_TABLE_SIZE entries, unmapped chars are set to UNMAPPED_ASCII_CHARACTER.
+ * @param digit_to_ascii - The digit-to-ASCII mapping matrix.
+ * @param number_of_letters - Number of letters for each digit.
+ * @return STATUS_CODE - Status of the operation.
+*/
+STATUS_CODE build_ascii_to_digit_table(int8_t* out_table, uint8_t** digit_to_ascii, uint32_t number_of_letters);
+
+/**
+ * @brief Checks that every index of a digit permutation lies inside a field element.
+ *
+ * @param permutation_vector - The permutation of the digits of a field element.
+ * @param digits_per_element - Number of digits per field element.
+ * @return STATUS_CODE - Status of the operation.
+*/
+STATUS_CODE validate_permutation_vector(const uint8_t* permutation_vector, uint32_t digits_per_element);
+
 #endif
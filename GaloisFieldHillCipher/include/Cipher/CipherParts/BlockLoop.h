@@ -0,0 +1,141 @@
+#ifndef BLOCK_LOOP_H
+#define BLOCK_LOOP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+#include "Math/FieldElement.h"
+#include "Math/MatrixMultiplication.h"
+#include "Math/CirculantMatrix.h"
+#include "Math/ColumnProductTables.h"
+
+#define DEFAULT_BLOCKS_PER_BATCH (1)
+#define DEFAULT_NUMBER_OF_BLOCK_LOOP_THREADS (1)
+#define MAXIMAL_BLOCKS_PER_BATCH (1024)
+#define MAXIMAL_NUMBER_OF_BLOCK_LOOP_THREADS (64)
+
+enum BLOCK_KERNEL
+{
+    BLOCK_KERNEL_BLOCK_BY_BLOCK = 0, // One matrix-vector product per block
+    BLOCK_KERNEL_BATCHED, // Every key row is applied to the whole batch while it is hot in cache
+    BLOCK_KERNEL_BATCHED_INTERLEAVED, // Batched, four blocks share every load of a key element
+
+    NUMBER_OF_BLOCK_KERNELS
+} typedef BLOCK_KERNEL;
+
+/**
+ * How the dense block loop is run: blocks are handed out in chunks of blocks_per_batch * number_of_threads,
+ * every thread multiplies its share of the chunk batch after batch with the selected kernel.
+ */
+struct BlockLoopConfiguration {
+    BLOCK_KERNEL kernel;
+    uint32_t blocks_per_batch;
+    uint32_t number_of_threads;
+} typedef BlockLoopConfiguration;
+
+/**
+ * The key a block loop multiplies with, either a flattened dense matrix or a circulant key.
+ * Circulant keys own a single transform workspace, so they always run block by block on the calling thread.
+ * Dense keys with column product tables encrypt through the tables whatever the kernel, decryption always runs the kernel.
+ */
+struct BlockMultiplier {
+    uint32_t dimension;
+    uint32_t prime_field;
+    const FieldVector* flat_matrix; // Dense keys, NULL for circulant keys
+    CirculantKey* circulant_key; // Circulant keys, NULL for dense keys
+    const ColumnProductTables* column_tables; // Dense encryption keys within the table budget, may be NULL
+    const FieldVector* offset_vector; // Added to every encrypted block, may be NULL
+} typedef BlockMultiplier;
+
+struct BlockLoopWorkers typedef BlockLoopWorkers;
+
+struct BlockLoop {
+    BlockLoopConfiguration configuration;
+    BlockLoopWorkers* workers; // NULL when the loop runs on the calling thread only
+} typedef BlockLoop;
+
+/**
+ * @brief Fills the configuration matching the original block loop, one block at a time on the calling thread.
+ *
+ * @param out_configuration - Pointer to the output configuration.
+ */
+void get_default_block_loop_configuration(BlockLoopConfiguration* out_configuration);
+
+/**
+ * @brief Validates a block loop configuration.
+ *
+ * @param configuration - The configuration to validate.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE validate_block_loop_configuration(const BlockLoopConfiguration* configuration);
+
+/**
+ * @brief Gets the printable name of a block kernel, also used as its name in the tuning cache.
+ *
+ * @param kernel - The kernel to query.
+ * @return The kernel name, "unknown" for an invalid kernel.
+ */
+const char* get_block_kernel_name(BLOCK_KERNEL kernel);
+
+/**
+ * @brief Looks a block kernel up by name.
+ *
+ * @param out_kernel - Pointer to the output kernel.
+ * @param name - The kernel name (see get_block_kernel_name).
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE parse_block_kernel_name(BLOCK_KERNEL* out_kernel, const char* name);
+
+/**
+ * @brief Prepares a block loop, starting number_of_threads - 1 worker threads that live until free_block_loop.
+ *
+ * @param out_loop - Pointer to the output loop, released with free_block_loop.
+ * @param configuration - The configuration to run with.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE initialize_block_loop(BlockLoop* out_loop, const BlockLoopConfiguration* configuration);
+
+/**
+ * @brief Stops the worker threads of a block loop and resets it.
+ *
+ * @param loop - The loop to free, may be NULL.
+ */
+void free_block_loop(BlockLoop* loop);
+
+/**
+ * @brief Gets the number of blocks a caller should gather before handing them to the loop.
+ *
+ * @param loop - The loop to query.
+ * @return The number of blocks per chunk.
+ */
+uint32_t get_block_loop_chunk_size(const BlockLoop* loop);
+
+/**
+ * @brief Encrypts a chunk of contiguous plaintext blocks, out_blocks[block] = K * blocks[block] + offset.
+ *
+ * @param out_blocks - Caller owned output of at least number_of_blocks * dimension elements, block after block.
+ * @param loop - The block loop to run on.
+ * @param multiplier - The key to multiply with.
+ * @param blocks - The plaintext blocks, number_of_blocks * dimension bytes.
+ * @param number_of_blocks - The number of blocks in the chunk.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE multiply_uint8_t_blocks(FieldVector* out_blocks, BlockLoop* loop, const BlockMultiplier* multiplier, const uint8_t* blocks, uint32_t number_of_blocks);
+
+/**
+ * @brief Decrypts a chunk of contiguous ciphertext blocks with the affine offset already subtracted, out_blocks[block] = K^-1 * blocks[block].
+ *
+ * @param out_blocks - Caller owned output of number_of_blocks * dimension bytes.
+ * @param loop - The block loop to run on.
+ * @param multiplier - The inverse key to multiply with, its offset vector is ignored.
+ * @param blocks - The ciphertext blocks, at least number_of_blocks * dimension elements.
+ * @param number_of_blocks - The number of blocks in the chunk.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE multiply_field_blocks(uint8_t* out_blocks, BlockLoop* loop, const BlockMultiplier* multiplier, const FieldVector* blocks, uint32_t number_of_blocks);
+
+#endif //BLOCK_LOOP_H
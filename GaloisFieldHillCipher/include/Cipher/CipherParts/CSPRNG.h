@@ -4,10 +4,36 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <string.h>
 #include <sodium.h>
 
 #include "StatusCodes.h"
 #include "log.h"
+#include "Instrumentation/Metrics.h"
+
+#define SECURE_RANDOM_POOL_SIZE (256)
+#define SECURE_RANDOM_BYTE_RANGE (256)
+#define RANDOM_SEED_SIZE (crypto_stream_chacha20_KEYBYTES)
+
+struct SecureRandomPool {
+    uint8_t buffer[SECURE_RANDOM_POOL_SIZE];
+    uint32_t position;
+    uint8_t bits;
+    uint8_t number_of_bits_left;
+} typedef SecureRandomPool;
+
+/**
+ * A ChaCha20 keystream under a seed, a new nonce is used for every refill of the buffer.
+ */
+struct SeededRandomStream {
+    bool is_active;
+    uint8_t seed[RANDOM_SEED_SIZE];
+    uint64_t refill_counter;
+    uint8_t buffer[SECURE_RANDOM_POOL_SIZE];
+    uint32_t position;
+} typedef SeededRandomStream;
 
 /**
  * @brief Initialize sodium.
@@ -26,6 +52,56 @@ STATUS_CODE initialize_sodium_library();
  */
 STATUS_CODE generate_secure_random_number(uint32_t* out_number, uint32_t minimum_value, uint32_t maximum_value);
 
+/**
+ * @brief Fill a buffer with cryptography secure random bytes.
+ *
+ * @param out_buffer - The buffer to be filled.
+ * @param size - The number of bytes to generate.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE generate_secure_random_bytes(uint8_t* out_buffer, size_t size);
+
+/**
+ * @brief Initialize a random pool, the pool is refilled in bulk so hot loops don't pay for a CSPRNG call per draw.
+ *
+ * @param pool - The pool to be initialized.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE initialize_secure_random_pool(SecureRandomPool* pool);
+
+/**
+ * @brief Draw a single secure random bit from a random pool.
+ *
+ * @param out_bit - A pointer to the output bit (0 or 1).
+ * @param pool - The random pool to draw from.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE draw_secure_random_bit(uint8_t* out_bit, SecureRandomPool* pool);
+
+/**
+ * @brief Draw a uniformly distributed secure random number in [0, upper_bound) from a random pool.
+ *
+ * @param out_number - A pointer to the output number.
+ * @param upper_bound - The exclusive upper bound, must not exceed SECURE_RANDOM_BYTE_RANGE (0 and 1 always yield 0).
+ * @param pool - The random pool to draw from.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE draw_secure_random_number(uint32_t* out_number, uint32_t upper_bound, SecureRandomPool* pool);
+
+/**
+ * @brief Makes the secure random generators of the calling thread draw from a ChaCha20 stream under a seed,
+ *        so the generation routines become deterministic until end_seeded_random_stream. Other threads are unaffected.
+ *
+ * @param seed - The seed, RANDOM_SEED_SIZE bytes.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE begin_seeded_random_stream(const uint8_t* seed);
+
+/**
+ * @brief Returns the secure random generators of the calling thread to the system CSPRNG and wipes the seeded stream.
+ */
+void end_seeded_random_stream(void);
+
 /**
  * @brief Perform a secure Fisher-Yates shuffle on an array.
  *
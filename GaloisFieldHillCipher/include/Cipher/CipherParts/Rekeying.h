@@ -0,0 +1,59 @@
+#ifndef REKEYING_H
+#define REKEYING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+#include "Math/FieldElement.h"
+#include "Math/MatrixUtils.h"
+#include "Math/MatrixMultiplication.h"
+#include "Math/CirculantMatrix.h"
+#include "Cipher/CipherParts/AffineTransformation.h"
+#include "Secrets/Secrets.h"
+
+/**
+ * Encryption is c = K * x + e, so a ciphertext block moves to another key without recovering x:
+ * c' = K' * K^-1 * (c - e) + e' = R * c + (e' - R * e), with R = K' * K^-1 composed once per key pair.
+ * R is circulant when both keys are circulant, dense otherwise.
+ */
+struct RekeyTransform {
+    KEY_STRUCTURE key_structure;
+    uint32_t dimension;
+    uint32_t prime_field;
+    FieldVector flat_matrix; // Dense R, row-major
+    CirculantKey circulant_key; // Circulant R
+    FieldVector offset_vector; // e' - R * e
+} typedef RekeyTransform;
+
+/**
+ * @brief Composes the transform moving ciphertext blocks from the old key to the new key.
+ *
+ * @param out_transform - Pointer to the output transform, released with free_rekey_transform.
+ * @param old_decryption_secrets - Decryption secrets of the key the ciphertext is currently under.
+ * @param new_encryption_secrets - Encryption secrets of the key to move the ciphertext to, same dimension and prime field.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE build_rekey_transform(RekeyTransform* out_transform, const Secrets* old_decryption_secrets, const Secrets* new_encryption_secrets);
+
+/**
+ * @brief Moves a single ciphertext block to the new key.
+ *
+ * @param out_block - Preallocated output block of the transform dimension, must not be the input block.
+ * @param transform - The transform.
+ * @param block - The ciphertext block under the old key, elements aligned to [0, prime_field).
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE apply_rekey_transform(FieldVector* out_block, RekeyTransform* transform, const FieldVector* block);
+
+/**
+ * @brief Frees the memory held by a rekey transform.
+ *
+ * @param transform - The transform to free, may be NULL.
+ */
+void free_rekey_transform(RekeyTransform* transform);
+
+#endif //REKEYING_H
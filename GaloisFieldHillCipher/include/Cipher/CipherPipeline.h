@@ -0,0 +1,48 @@
+#ifndef CIPHER_PIPELINE_H
+#define CIPHER_PIPELINE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+#include "Cipher/Cipher.h"
+#include "Cipher/CipherContext.h"
+#include "Cipher/SpscQueue.h"
+
+#define CIPHER_PIPELINE_NUMBER_OF_CHUNKS (8) // Chunk buffers in flight, enough for every stage to hold one with the next ones queued behind it
+
+enum CIPHER_PIPELINE_STAGE
+{
+    CIPHER_PIPELINE_STAGE_READ = 0,
+    CIPHER_PIPELINE_STAGE_EXPAND, // Random bits between bytes, the carried over partial block and the padding
+    CIPHER_PIPELINE_STAGE_MULTIPLY, // The block loop, on its own worker threads
+    CIPHER_PIPELINE_STAGE_ENCODE, // Binary serialization or the ASCII mapping and permutation
+    CIPHER_PIPELINE_STAGE_WRITE, // Runs on the calling thread and hands the chunks back to the read stage
+
+    NUMBER_OF_CIPHER_PIPELINE_STAGES
+} typedef CIPHER_PIPELINE_STAGE;
+
+/**
+ * @brief Encrypts a stream like encrypt_stream_with_context, with the read, expansion, multiplication, encoding and write
+ *        of the chunks running at once on a thread each. The stages pass a fixed pool of CIPHER_PIPELINE_NUMBER_OF_CHUNKS
+ *        chunk buffers along a ring of single-producer single-consumer queues, so a stage that falls behind stalls the ones before it
+ *        and memory stays bounded. A dense key on a single threaded block loop configuration is multiplied on the hardware threads
+ *        the other stages leave free. The output is the same as the output of encrypt_stream_with_context.
+ *
+ * @param output - The stream the serialized ciphertext is written to, flushed on return.
+ * @param input - The plaintext stream, may be empty.
+ * @param context - The context prepared from the encryption secrets (see prepare_cipher_context).
+ * @param format - Binary or text, a text ciphertext ends with a null terminator.
+ * @param out_bytes_read - Pointer to the number of plaintext bytes read, may be NULL.
+ * @param out_bytes_written - Pointer to the number of ciphertext bytes written, may be NULL.
+ * @return STATUS_CODE - Status of the operation, the first stage to fail gives the status.
+ */
+STATUS_CODE encrypt_stream_pipelined_with_context(FILE* output, FILE* input, const CipherContext* context, CIPHERTEXT_FORMAT format,
+    uint64_t* out_bytes_read, uint64_t* out_bytes_written);
+
+#endif //CIPHER_PIPELINE_H
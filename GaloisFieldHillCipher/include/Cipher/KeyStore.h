@@ -0,0 +1,88 @@
+#ifndef KEY_STORE_H
+#define KEY_STORE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+#include "Cipher/CipherContext.h"
+
+#define KEY_STORE_DIGEST_SIZE (32)
+#define KEY_STORE_NUMBER_OF_BUCKETS (1024) // A power of two, a batch runs with a few hundred keys
+#define KEY_STORE_PATH_DIGEST_KEY "HillKeyStorePath" // Separates path digests from content digests, 16 bytes as BLAKE2b requires
+
+/**
+ * A cache of prepared cipher contexts shared by the threads of a process, keyed by the digest of a key file path or of the key contents.
+ * Lookups take the lock shared and stamp the entry with an atomic clock, only a miss takes it exclusively to insert and evict.
+ * Threads missing on a key another thread is loading wait for that load, so a key is loaded and prepared once however many threads ask for it.
+ * Eviction drops the least recently used entries until the prepared keys fit the byte budget. Entries are reference counted,
+ * so an evicted context stays valid until every thread that acquired it has released it.
+ */
+struct KeyStore typedef KeyStore;
+
+struct KeyStoreStatistics {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t number_of_entries;
+    uint64_t bytes_in_use;
+} typedef KeyStoreStatistics;
+
+/**
+ * @brief Creates an empty key store.
+ *
+ * @param out_store - Pointer to the output store, released with free_key_store.
+ * @param byte_budget - The memory prepared keys may take (see CipherContext.size_in_bytes), the last inserted key is kept even if it alone exceeds it.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE create_key_store(KeyStore** out_store, size_t byte_budget);
+
+/**
+ * @brief Frees a key store. Contexts still acquired stay valid and are freed when released.
+ *
+ * @param store - The store to free, may be NULL.
+ */
+void free_key_store(KeyStore* store);
+
+/**
+ * @brief Gets the prepared context of a key file, loading and preparing it on a miss.
+ *        A file whose size, modification time (to the nanosecond), inode or device changed since it was cached is loaded again.
+ *
+ * @param out_context - Pointer to the output context, read only and released with release_key_store_context.
+ * @param store - The key store.
+ * @param filepath - The path of the key file, any format load_secrets_file accepts.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE acquire_key_store_context_from_file(const CipherContext** out_context, KeyStore* store, const char* filepath);
+
+/**
+ * @brief Gets the prepared context of a serialized key, keyed by the digest of its contents.
+ *
+ * @param out_context - Pointer to the output context, read only and released with release_key_store_context.
+ * @param store - The key store.
+ * @param data - The serialized key, any format deserialize_secrets accepts.
+ * @param size - The size of the serialized key.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE acquire_key_store_context_from_data(const CipherContext** out_context, KeyStore* store, const uint8_t* data, uint32_t size);
+
+/**
+ * @brief Releases a context acquired from a key store.
+ *
+ * @param context - The context, may be NULL.
+ */
+void release_key_store_context(const CipherContext* context);
+
+/**
+ * @brief Gets the counters of a key store.
+ *
+ * @param out_statistics - Pointer to the output statistics.
+ * @param store - The key store.
+ */
+void get_key_store_statistics(KeyStoreStatistics* out_statistics, KeyStore* store);
+
+#endif //KEY_STORE_H
@@ -0,0 +1,134 @@
+#ifndef SHARD_COORDINATOR_H
+#define SHARD_COORDINATOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+#include "Cipher/Cipher.h"
+
+/**
+ * Shard container: a header, an index entry per shard and the shard ciphertexts in the order the workers finished them.
+ * Every shard is the ciphertext of its own plaintext range, serialized like an encrypted file, so it decrypts on its own.
+ * Integers are little endian. The magic is written last, a container whose coordinator failed is never recognized.
+ *
+ * | header | index entry 0 | ... | index entry n-1 | shard ciphertexts |
+ */
+#define SHARD_CONTAINER_MAGIC "HCSHARD1"
+#define SHARD_CONTAINER_MAGIC_SIZE (8)
+#define SHARD_CONTAINER_VERSION (1)
+#define SHARD_CONTAINER_HEADER_SIZE (40) // magic, version u32, format u32, number of shards u32, reserved u32, plaintext size u64, shard size u64
+#define SHARD_CONTAINER_INDEX_ENTRY_SIZE (32) // plaintext offset, plaintext size, ciphertext offset, ciphertext size, all u64
+
+#define MAXIMAL_SHARD_SIZE_IN_MEGABYTES (256) // A text ciphertext is about 13 times its plaintext at most and has to fit a uint32 size
+
+/**
+ * Coordinator to worker protocol, over a stream socket per worker. Every message is a SHARD_MESSAGE_HEADER_SIZE header
+ * (type u32, reserved u32, payload size u64) and its payload, little endian, so the same messages can later go over TCP.
+ *
+ * HELLO   coordinator -> worker: direction u32, format u32, key path size u32, input path size u32, key path, input path
+ * JOB     coordinator -> worker: shard index u32, reserved u32, offset u64, size u64 (a range of the input file)
+ * RESULT  worker -> coordinator: shard index u32, status u32, the ciphertext (encrypt) or plaintext (decrypt) of the shard
+ *
+ * Workers open the key and the input by path and hold nothing of the coordinator. A worker exits when its socket is closed.
+ */
+#define SHARD_MESSAGE_HEADER_SIZE (16)
+#define SHARD_JOB_PAYLOAD_SIZE (24)
+#define SHARD_RESULT_HEADER_SIZE (8)
+
+enum SHARD_MESSAGE_TYPE
+{
+    SHARD_MESSAGE_HELLO = 1,
+    SHARD_MESSAGE_JOB,
+    SHARD_MESSAGE_RESULT,
+} typedef SHARD_MESSAGE_TYPE;
+
+enum SHARD_DIRECTION
+{
+    SHARD_DIRECTION_ENCRYPT = 0, // A plain file into a container
+    SHARD_DIRECTION_DECRYPT, // A container back into the plain file
+
+    NUMBER_OF_SHARD_DIRECTIONS
+} typedef SHARD_DIRECTION;
+
+struct ShardIndexEntry {
+    uint64_t plaintext_offset;
+    uint64_t plaintext_size;
+    uint64_t ciphertext_offset; // From the start of the container
+    uint64_t ciphertext_size;
+} typedef ShardIndexEntry;
+
+struct ShardContainerHeader {
+    uint32_t version;
+    CIPHERTEXT_FORMAT format;
+    uint32_t number_of_shards;
+    uint64_t plaintext_size;
+    uint64_t shard_size;
+} typedef ShardContainerHeader;
+
+struct ShardConfiguration {
+    SHARD_DIRECTION direction;
+    CIPHERTEXT_FORMAT format; // Encryption only, a container records its format
+    uint32_t number_of_workers; // Local worker processes, fewer are started when there are fewer shards
+    uint64_t shard_size; // Plaintext bytes per shard, encryption only
+    uint32_t number_of_retries; // Further attempts of a shard whose worker failed or died before the run fails
+    FILE* status_output; // Receives a status line per shard as it completes, may be NULL
+} typedef ShardConfiguration;
+
+struct ShardSummary {
+    uint32_t number_of_shards;
+    uint32_t retries; // Attempts beyond the first of every shard
+    uint32_t workers_started; // Including the replacements of dead workers
+    uint64_t bytes_in;
+    uint64_t bytes_out;
+    uint64_t elapsed_ns;
+} typedef ShardSummary;
+
+/**
+ * @brief Called in a worker process for every job it receives, before the job is processed.
+ *
+ * @param shard - The shard of the job.
+ */
+typedef void (*ShardWorkerJobHook)(uint32_t shard);
+
+/**
+ * @brief Installs a hook the workers call for every job, the tests use it to make workers die and exercise the retries.
+ *        Workers inherit the hook when they are forked, so a hook that counts jobs across workers keeps its count in
+ *        memory shared between the processes.
+ *
+ * @param hook - The hook, NULL removes it.
+ */
+void set_shard_worker_job_hook(ShardWorkerJobHook hook);
+
+/**
+ * @brief Reads the header and the index of a shard container and checks that the shards cover the plaintext in order
+ *        and lie within the container.
+ *
+ * @param out_header - Pointer to the output header.
+ * @param out_entries - Pointer to the output index, allocated inside the function, NULL for a container without shards.
+ * @param input - The container, read from its start.
+ * @return STATUS_CODE - Status of the operation, STATUS_CODE_INVALID_SHARD_CONTAINER when it isn't a complete container.
+ */
+STATUS_CODE read_shard_container_index(ShardContainerHeader* out_header, ShardIndexEntry** out_entries, FILE* input);
+
+/**
+ * @brief Splits a file into shards and encrypts them on local worker processes into a container, or decrypts a container
+ *        back into the file. Idle workers are handed the next shard as soon as they reply, a shard whose worker fails or dies
+ *        is handed out again up to the number of retries, and a dead worker is replaced.
+ *
+ * @param out_summary - Pointer to the output summary, may be NULL.
+ * @param output_file - The container when encrypting, the plain file when decrypting. Written at offsets, so not a stream.
+ * @param input_file - The plain file when encrypting, the container when decrypting.
+ * @param key_file - The encryption or decryption key, loaded by every worker.
+ * @param configuration - The direction, workers, shard size and retries.
+ * @return STATUS_CODE - Status of the operation, STATUS_CODE_SHARDS_FAILED when a shard failed on every attempt.
+ */
+STATUS_CODE run_shard_coordinator(ShardSummary* out_summary, const char* output_file, const char* input_file, const char* key_file,
+    const ShardConfiguration* configuration);
+
+#endif //SHARD_COORDINATOR_H
@@ -0,0 +1,77 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+
+#define SPSC_QUEUE_CACHE_LINE_SIZE (64)
+#define SPSC_QUEUE_SPIN_LIMIT (256) // Failed attempts that yield the processor before a waiting side starts to sleep
+#define SPSC_QUEUE_IDLE_SLEEP_US (50)
+
+/**
+ * A bounded lock-free ring of pointers between exactly one producer thread and one consumer thread.
+ * Each side owns its own position and only reads the other's, so a push or a pop is one acquire load and one release store.
+ * Blocking waits spin, then yield, then sleep, and give up once the shared abort flag is raised.
+ */
+struct SpscQueue typedef SpscQueue;
+
+/**
+ * @brief Creates an empty queue.
+ *
+ * @param out_queue - Pointer to the output queue, released with free_spsc_queue.
+ * @param capacity - The number of items the queue holds, rounded up to a power of two.
+ * @param abort_flag - Raised to a non-zero value to release every blocked push and pop, may be NULL. Read atomically.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE create_spsc_queue(SpscQueue** out_queue, uint32_t capacity, const uint64_t* abort_flag);
+
+/**
+ * @brief Frees a queue, the items still in it are not touched.
+ *
+ * @param queue - Pointer to the queue to free, set to NULL, may point to NULL.
+ */
+void free_spsc_queue(SpscQueue** queue);
+
+/**
+ * @brief Pushes an item if the queue has room, called by the producer only.
+ *
+ * @param queue - The queue.
+ * @param item - The item.
+ * @return bool - True if the item was pushed, false if the queue is full.
+ */
+bool try_push_spsc_queue(SpscQueue* queue, void* item);
+
+/**
+ * @brief Pops the oldest item if there is one, called by the consumer only.
+ *
+ * @param out_item - Pointer to the output item.
+ * @param queue - The queue.
+ * @return bool - True if an item was popped, false if the queue is empty.
+ */
+bool try_pop_spsc_queue(void** out_item, SpscQueue* queue);
+
+/**
+ * @brief Pushes an item, waiting while the queue is full.
+ *
+ * @param queue - The queue.
+ * @param item - The item.
+ * @return STATUS_CODE - Status of the operation, STATUS_CODE_PIPELINE_ABORTED once the abort flag is raised.
+ */
+STATUS_CODE push_spsc_queue(SpscQueue* queue, void* item);
+
+/**
+ * @brief Pops the oldest item, waiting while the queue is empty.
+ *
+ * @param out_item - Pointer to the output item.
+ * @param queue - The queue.
+ * @return STATUS_CODE - Status of the operation, STATUS_CODE_PIPELINE_ABORTED once the abort flag is raised.
+ */
+STATUS_CODE pop_spsc_queue(void** out_item, SpscQueue* queue);
+
+#endif //SPSC_QUEUE_H
@@ -0,0 +1,105 @@
+#ifndef ASYNC_FILE_IO_H
+#define ASYNC_FILE_IO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+
+#define ASYNC_IO_QUEUE_DEPTH (3) // Triple buffered: one chunk with the caller, the others read ahead or written behind
+#define ASYNC_IO_BUFFER_ALIGNMENT (4096) // Page aligned, as registered io_uring buffers are pinned by page
+
+#define IO_BACKEND_AUTO "auto"
+#define IO_BACKEND_IO_URING "uring"
+#define IO_BACKEND_THREADS "threads"
+
+enum ASYNC_IO_BACKEND
+{
+    ASYNC_IO_BACKEND_AUTO = 0, // io_uring for regular files when the kernel has it, the I/O thread otherwise
+    ASYNC_IO_BACKEND_IO_URING,
+    ASYNC_IO_BACKEND_THREADS,
+
+    NUMBER_OF_ASYNC_IO_BACKENDS
+} typedef ASYNC_IO_BACKEND;
+
+/**
+ * A file read ahead or written behind in chunks through a ring of ASYNC_IO_QUEUE_DEPTH buffers, so the disk works while the caller computes.
+ * On Linux the buffers are registered with an io_uring instance and read or written with fixed buffer operations.
+ * Without io_uring, and for pipes and terminals, an I/O thread serves the buffers in order with pread and pwrite,
+ * or read and write when the file can't seek.
+ */
+struct AsyncFile typedef AsyncFile;
+
+/**
+ * @brief Parses a backend name (IO_BACKEND_AUTO, IO_BACKEND_IO_URING or IO_BACKEND_THREADS).
+ *
+ * @param out_backend - Pointer to the output backend.
+ * @param name - The backend name, NULL gives ASYNC_IO_BACKEND_AUTO.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE parse_async_io_backend(ASYNC_IO_BACKEND* out_backend, const char* name);
+
+/**
+ * @brief Starts asynchronous I/O on an open stream from its current position. Reads start right away, ahead of the first async_read_next.
+ *        The stream is not closed with the file. A stream that can't seek, like a pipe, must have no buffered input.
+ *        io_uring falls back to the I/O thread when the kernel doesn't have it or the stream isn't a regular file.
+ *
+ * @param out_file - Pointer to the output file, released with close_async_file.
+ * @param stream - The stream to read or write, buffered output is flushed first.
+ * @param is_output - Write behind, read ahead otherwise.
+ * @param chunk_size - The size of the buffers, every read but the last fills a whole buffer.
+ * @param backend - The backend to use.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE open_async_file(AsyncFile** out_file, FILE* stream, bool is_output, size_t chunk_size, ASYNC_IO_BACKEND backend);
+
+/**
+ * @brief Gets the backend a file runs on, never ASYNC_IO_BACKEND_AUTO.
+ *
+ * @param file - The file.
+ * @return ASYNC_IO_BACKEND - The backend.
+ */
+ASYNC_IO_BACKEND get_async_file_backend(const AsyncFile* file);
+
+/**
+ * @brief Gets the next chunk of a file opened for reading, and hands the previous chunk back to be read ahead again.
+ *
+ * @param out_chunk - Pointer to the chunk, valid until the next call.
+ * @param out_size - Pointer to the size of the chunk, less than the chunk size only at the end of the file and 0 past it.
+ * @param file - The file.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE async_read_next(const uint8_t** out_chunk, size_t* out_size, AsyncFile* file);
+
+/**
+ * @brief Gets a buffer of a file opened for writing to fill, waiting for the write it held last to complete.
+ *
+ * @param out_buffer - Pointer to the buffer of the chunk size, valid until it's submitted.
+ * @param file - The file.
+ * @return STATUS_CODE - Status of the operation, a failed earlier write is reported here.
+ */
+STATUS_CODE async_write_acquire(uint8_t** out_buffer, AsyncFile* file);
+
+/**
+ * @brief Queues the acquired buffer to be written after the chunks submitted before it.
+ *
+ * @param file - The file.
+ * @param size - The bytes of the buffer to write, at most the chunk size.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE async_write_submit(AsyncFile* file, size_t size);
+
+/**
+ * @brief Waits for the queued operations, leaves the stream positioned after the bytes read or written, and frees the file.
+ *
+ * @param file - Pointer to the file to close, set to NULL, may point to NULL.
+ * @return STATUS_CODE - Status of the operation, a failed write is reported here.
+ */
+STATUS_CODE close_async_file(AsyncFile** file);
+
+#endif //ASYNC_FILE_IO_H
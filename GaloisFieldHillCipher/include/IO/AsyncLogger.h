@@ -0,0 +1,61 @@
+#ifndef ASYNC_LOGGER_H
+#define ASYNC_LOGGER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+
+#define ASYNC_LOG_RING_CAPACITY (2048) // Must be a power of two
+#define ASYNC_LOG_MESSAGE_SIZE (1024) // Fits a full vector or matrix preview
+#define ASYNC_LOG_TIME_FORMAT "%Y-%m-%d %H:%M:%S"
+#define ASYNC_LOG_TIME_SIZE (32)
+#define ASYNC_LOG_IDLE_SLEEP_MS (1)
+
+/**
+ * A fixed-size log record, the message is formatted by the producer since the
+ * arguments do not outlive the log call, everything else is formatted by the writer thread.
+ */
+struct AsyncLogRecord {
+    struct tm time;
+    const char* file; // __FILE__ literal, lives for the whole program
+    int line;
+    int level;
+    char message[ASYNC_LOG_MESSAGE_SIZE];
+} typedef AsyncLogRecord;
+
+/**
+ * @brief Attaches a log file through a lock-free multi-producer ring drained by a background writer thread.
+ *        Log calls only copy a record into the ring, records are dropped and counted when the ring is full.
+ *
+ * @param output - The log file, must stay open until stop_async_logger returns.
+ * @param level - The minimal level written to the log file.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE start_async_logger(FILE* output, int level);
+
+/**
+ * @brief Stops accepting records, waits for the writer thread to drain the ring and flushes the log file.
+ *        Writes the number of dropped records to the log file if any were dropped.
+ */
+void stop_async_logger(void);
+
+/**
+ * @brief Called in a child right after fork, which copies the ring but not the writer thread. The child's log calls then
+ *        write and flush their records themselves, through a stream of their own on the log file, the records the parent
+ *        had queued are left to the parent. Does nothing when the logger isn't running.
+ */
+void switch_async_logger_to_synchronous_after_fork(void);
+
+/**
+ * @brief Gets the number of records dropped because the ring was full since the logger was started.
+ *
+ * @return The number of dropped records.
+ */
+uint64_t get_async_logger_dropped_records(void);
+
+#endif //ASYNC_LOGGER_H
@@ -1,15 +1,21 @@
 #ifndef FILE_OPERATIONS_H
 #define FILE_OPERATIONS_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
 
 #include "FileValidation.h"
 #include "StatusCodes.h"
 #include "Cipher/CipherParts/BlockDividing.h"
 #include "log.h"
+#include "Instrumentation/Metrics.h"
 
 /**
  * @brief Write uint8_t vector to a file.
@@ -31,4 +37,22 @@ STATUS_CODE write_uint8_to_file(const char* filepath, const uint8_t* data, uint3
  */
 STATUS_CODE read_uint8_from_file(uint8_t** out_data, uint32_t* out_size, const char* filepath);
 
+/**
+ * @brief Opens a file to be read or written in chunks. STANDARD_STREAM_PATH gives the standard input or output,
+ *        switched to binary mode so piped data passes unchanged.
+ *
+ * @param out_stream - Pointer to the opened stream, released with close_stream.
+ * @param filepath - The path to the file, or STANDARD_STREAM_PATH.
+ * @param is_output - Open for writing, for reading otherwise.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE open_stream(FILE** out_stream, const char* filepath, bool is_output);
+
+/**
+ * @brief Closes a stream opened with open_stream, the standard streams are left open.
+ *
+ * @param stream - The stream to close, may be NULL.
+ */
+void close_stream(FILE* stream);
+
 #endif
@@ -4,10 +4,13 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/stat.h>
 
 #include "StatusCodes.h"
 #include "log.h"
 
+#define STANDARD_STREAM_PATH "-" // Stands for the standard input or output in place of a file
+
 /**
  * @brief Validates if the given file exists and is readable.
  *
@@ -32,4 +35,20 @@ STATUS_CODE validate_file_is_binary(const char* path);
  */
 STATUS_CODE validate_file_is_writeable(const char* path);
 
+/**
+ * @brief Validates if the given path is an existing directory.
+ *
+ * @param path - The path to be validated.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE validate_path_is_directory(const char* path);
+
+/**
+ * @brief Checks if a path stands for the standard input or output.
+ *
+ * @param path - The path to be checked, may be NULL.
+ * @return true if the path is STANDARD_STREAM_PATH, false otherwise.
+ */
+bool is_standard_stream_path(const char* path);
+
 #endif
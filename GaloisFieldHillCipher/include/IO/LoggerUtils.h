@@ -17,7 +17,8 @@
 #define BYTES_LINE_SIZE (16)
 
 /**
- * @brief Log a uint8_t vector to the console with optional verbose output
+ * @brief Log a uint8_t vector to the console with optional verbose output, capped to the preview element budget.
+ *        Nothing is formatted when neither the console nor the log file would write the line.
  *
  * @param data Pointer to the uint8_t vector to be logged
  * @param size Size of the vector in bytes
@@ -27,17 +28,17 @@
 void log_uint8_vector(const uint8_t* data, size_t size, const char* prefix, bool is_verbose_only);
 
 /**
- * @brief Log a int64_t vector to the console with optional verbose output
+ * @brief Log a int64_t vector to the console with optional verbose output, capped to the preview element budget
  *
  * @param data Pointer to the int64_t vector to be logged
- * @param size Size of the vector in bytes
+ * @param size Number of elements in the vector
  * @param prefix Prefix string to be logged before the vector
  * @param is_verbose_only If true, logs only in verbose mode
  */
 void log_int64_vector(const int64_t* data, size_t size, const char* prefix, bool is_verbose_only);
 
 /**
- * @brief Log a matrix to the console with optional verbose output
+ * @brief Log a matrix to the console with optional verbose output, capped to the preview element budget
  *
  * @param matrix Pointer to the matrix to be logged
  * @param dimension Dimension of the square matrix
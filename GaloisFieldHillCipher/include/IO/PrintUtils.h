@@ -4,6 +4,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <stdbool.h>
 
 #include "log.h"
@@ -15,9 +16,52 @@
 #define PRINT_BUFFER_EXTRA (128)
 #define NUMBERS_LINE_SIZE (8)
 #define BYTES_LINE_SIZE (16)
+#define PREVIEW_DIGEST_OFFSET_BASIS (0xcbf29ce484222325ULL)
+#define PREVIEW_DIGEST_PRIME (0x100000001b3ULL)
 
 /**
- * @brief Print a uint8_t vector to the console with optional verbose output
+ * @brief Feeds bytes into a 64-bit FNV-1a digest.
+ *
+ * @param digest The running digest, PREVIEW_DIGEST_OFFSET_BASIS for a new one
+ * @param data The bytes to digest
+ * @param size Number of bytes
+ * @return The updated digest
+ */
+uint64_t update_preview_digest(uint64_t digest, const void* data, size_t size);
+
+/**
+ * @brief Formats a uint8_t vector preview: every byte if the vector fits the preview element budget,
+ *        otherwise the first and last halves of the budget followed by the size and digest of the whole vector.
+ *
+ * @param data Pointer to the uint8_t vector
+ * @param size Size of the vector in bytes
+ * @param prefix Prefix string placed on the first line
+ * @return The formatted preview, owned by the caller, or NULL on failure
+ */
+char* format_uint8_vector_preview(const uint8_t* data, size_t size, const char* prefix);
+
+/**
+ * @brief Formats a int64_t vector preview, capped to the preview element budget like format_uint8_vector_preview.
+ *
+ * @param data Pointer to the int64_t vector
+ * @param size Number of elements in the vector
+ * @param prefix Prefix string placed on the first line
+ * @return The formatted preview, owned by the caller, or NULL on failure
+ */
+char* format_int64_vector_preview(const int64_t* data, size_t size, const char* prefix);
+
+/**
+ * @brief Formats a matrix preview row by row, capped to the preview element budget like format_uint8_vector_preview.
+ *
+ * @param matrix Pointer to the matrix
+ * @param dimension Dimension of the square matrix
+ * @param prefix Prefix string placed on the first line
+ * @return The formatted preview, owned by the caller, or NULL on failure
+ */
+char* format_matrix_preview(int64_t** matrix, uint32_t dimension, const char* prefix);
+
+/**
+ * @brief Print a uint8_t vector to the console with optional verbose output, capped to the preview element budget
  *
  * @param data Pointer to the uint8_t vector to be printed
  * @param size Size of the vector in bytes
@@ -27,17 +71,17 @@
 void print_uint8_vector(const uint8_t* data, size_t size, const char* prefix, bool is_verbose_only);
 
 /**
- * @brief Print a int64_t vector to the console with optional verbose output
+ * @brief Print a int64_t vector to the console with optional verbose output, capped to the preview element budget
  *
  * @param data Pointer to the int64_t vector to be printed
- * @param size Size of the vector in bytes
+ * @param size Number of elements in the vector
  * @param prefix Prefix string to be printed before the vector
  * @param is_verbose_only If true, prints only in verbose mode
  */
 void print_int64_vector(const int64_t* data, size_t size, const char* prefix, bool is_verbose_only);
 
 /**
- * @brief Print a matrix to the console with optional verbose output
+ * @brief Print a matrix to the console with optional verbose output, capped to the preview element budget
  *
  * @param matrix Pointer to the matrix to be printed
  * @param dimension Dimension of the square matrix
@@ -9,6 +9,7 @@
 
 #include "StatusCodes.h"
 #include "Math/MatrixUtils.h"
+#include "Math/FieldElement.h"
 #include "Cipher/CipherParts/BlockDividing.h"
 #include "log.h"
 #include "Cipher/Cipher.h"
@@ -16,6 +17,17 @@
 
 #define NUMBER_OF_DIGITS (10)
 #define BYTE_MASK (0xFF)
+#define CIRCULANT_KEY_FLAG ((uint32_t)1 << 31) // Set on the serialized dimension, the key section then holds a single column
+
+/**
+ * Full key file: a format header, the key parameters and the sections, elements take calculate_bytes_per_element bytes.
+ * Files written before the header start at the dimension, they are read only when their prime field kept its element width.
+ *
+ * | magic | version | dimension | error vectors | prime field | letters per digit | key | error vectors | ASCII mapping | permutation |
+ */
+#define FULL_KEY_MAGIC (0x4B464348u) // "HCFK"
+#define FULL_KEY_VERSION (1) // Elements hold the full bit length of prime_field - 1, headerless files dropped its top bit
+#define FULL_KEY_HEADER_SIZE (sizeof(uint32_t) * 2)
 
 /**
  * @brief Calculate the number of bytes per element on the prime field.
@@ -34,7 +46,7 @@ uint32_t calculate_bytes_per_element(uint32_t prime_field);
 uint32_t calculate_digits_per_element(uint32_t prime_field);
 
 /**
- * @brief Serialize secrets to binary.
+ * @brief Serialize secrets to binary, seeded and mapped keys keep their format.
  *
  * @param out_data - A pointer to an output vector.
  * @param out_size - A pointer to the size of the output vector.
@@ -44,7 +56,8 @@ uint32_t calculate_digits_per_element(uint32_t prime_field);
 STATUS_CODE serialize_secrets(uint8_t** out_data, uint32_t* out_size, Secrets secrets);
 
 /**
- * @brief Deserialize secrets from binary.
+ * @brief Deserialize secrets from binary, in any of the key formats.
+ *        Headerless full keys whose prime field now takes wider elements fail with STATUS_CODE_UNSUPPORTED_KEY_FORMAT.
  *
  * @param out_secrets - A pointer to an output Secrets.
  * @param data - The data to be deserialized.
@@ -164,4 +177,25 @@ STATUS_CODE deserialize_uint8_matrix(uint8_t*** out_matrix, uint32_t rows, uint3
  */
 STATUS_CODE copy_uint8_matrix_to_int64_matrix(int64_t*** out_matrix, uint8_t** matrix, uint32_t rows, uint32_t columns);
 
+/**
+ * @brief Serialize a field vector to big-endian binary into a caller owned buffer.
+ *
+ * @param out_data - Caller owned output buffer of at least vector->length * bytes_per_element bytes.
+ * @param vector - The field vector to be serialized.
+ * @param bytes_per_element - The number of bytes per element (see calculate_bytes_per_element).
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE serialize_field_vector(uint8_t* out_data, const FieldVector* vector, uint32_t bytes_per_element);
+
+/**
+ * @brief Deserialize big-endian binary into a preallocated field vector, every element is reduced to [0, prime_field).
+ *
+ * @param out_vector - Preallocated field vector, out_vector->length elements are read.
+ * @param data - The data to be deserialized, at least out_vector->length * bytes_per_element bytes.
+ * @param bytes_per_element - The number of bytes per element (see calculate_bytes_per_element).
+ * @param prime_field - The prime field used to reduce the elements.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE deserialize_field_vector(FieldVector* out_vector, const uint8_t* data, uint32_t bytes_per_element, uint32_t prime_field);
+
 #endif
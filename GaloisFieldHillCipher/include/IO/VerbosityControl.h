@@ -2,6 +2,13 @@
 #define VERBOSITY_CONTROL_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "log.h"
+
+#define DEFAULT_PREVIEW_ELEMENT_BUDGET (64)
+#define LOG_LEVEL_DISABLED (LOG_FATAL + 1)
 
 extern bool g_verbose_mode;
 
@@ -19,4 +26,57 @@ void set_verbose_mode(bool verbose);
  */
 bool is_verbose_mode();
 
+/**
+ * @brief Sets the minimal level written to the console, forwarded to log_set_level.
+ *
+ * @param level The minimal console level, LOG_LEVEL_DISABLED for none
+ */
+void set_console_log_level(int level);
+
+/**
+ * @brief Sets the minimal level written to the log file.
+ *
+ * @param level The minimal log file level, LOG_LEVEL_DISABLED when there is no log file
+ */
+void set_log_file_level(int level);
+
+/**
+ * @brief Checks if a line of the given level reaches the console or the log file,
+ *        so callers can skip formatting lines that would be dropped.
+ *
+ * @param level The level of the line
+ * @return true if any sink writes the level, false otherwise
+ */
+bool is_log_level_enabled(int level);
+
+/**
+ * @brief Sets the number of elements shown by the vector and matrix previews,
+ *        larger buffers show the first and last halves of the budget and a digest.
+ *
+ * @param budget Number of elements to show, 0 restores DEFAULT_PREVIEW_ELEMENT_BUDGET
+ */
+void set_preview_element_budget(size_t budget);
+
+/**
+ * @brief Gets the number of elements shown by the vector and matrix previews.
+ *
+ * @return The preview element budget
+ */
+size_t get_preview_element_budget();
+
+/**
+ * @brief Sets the stream the status lines and the --stats breakdown are printed to,
+ *        moved to stderr when the data itself is written to stdout.
+ *
+ * @param output The status stream, NULL restores stdout
+ */
+void set_status_output(FILE* output);
+
+/**
+ * @brief Gets the stream the status lines are printed to.
+ *
+ * @return The status stream, stdout unless set otherwise
+ */
+FILE* get_status_output();
+
 #endif
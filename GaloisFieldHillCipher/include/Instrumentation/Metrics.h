@@ -0,0 +1,120 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+#include "Instrumentation/StageTimers.h"
+
+#define METRICS_NAME_PREFIX "hillcipher_"
+#define METRICS_TEMPORARY_FILE_SUFFIX ".tmp"
+#define METRICS_PATH_SIZE (4096)
+#define NUMBER_OF_LATENCY_BUCKETS (12)
+
+enum METRIC_COUNTER
+{
+    METRIC_COUNTER_BLOCKS_ENCRYPTED = 0,
+    METRIC_COUNTER_BLOCKS_DECRYPTED,
+    METRIC_COUNTER_BLOCKS_REKEYED,
+    METRIC_COUNTER_BYTES_IN,
+    METRIC_COUNTER_BYTES_OUT,
+    METRIC_COUNTER_ALLOCATIONS,
+    METRIC_COUNTER_RNG_BYTES_DRAWN,
+    METRIC_COUNTER_KEYS_LOADED,
+
+    NUMBER_OF_METRIC_COUNTERS
+} typedef METRIC_COUNTER;
+
+enum METRIC_GAUGE
+{
+    METRIC_GAUGE_KEY_DIMENSION = 0,
+    METRIC_GAUGE_PRIME_FIELD,
+    METRIC_GAUGE_RUN_DURATION_SECONDS,
+
+    NUMBER_OF_METRIC_GAUGES
+} typedef METRIC_GAUGE;
+
+/**
+ * Per-stage latency histogram with cumulative Prometheus buckets, observed from stop_stage_timer.
+ */
+struct LatencyHistogram {
+    uint64_t bucket_counts[NUMBER_OF_LATENCY_BUCKETS];
+    uint64_t count;
+    uint64_t sum_ns;
+} typedef LatencyHistogram;
+
+/**
+ * @brief Atomically adds a value to a counter written by several threads (stage statistics, histograms).
+ *
+ * @param counter - The counter to increase.
+ * @param value - The value to add.
+ */
+void add_to_shared_counter(uint64_t* counter, uint64_t value);
+
+/**
+ * @brief Adds a value to a counter, safe to call from several threads.
+ *
+ * @param counter - The counter to increase.
+ * @param value - The value to add.
+ */
+void increase_metric_counter(METRIC_COUNTER counter, uint64_t value);
+
+/**
+ * @brief Sets the value of a gauge.
+ *
+ * @param gauge - The gauge to set.
+ * @param value - The new value.
+ */
+void set_metric_gauge(METRIC_GAUGE gauge, double value);
+
+/**
+ * @brief Records a stage latency into the stage histogram.
+ *
+ * @param stage - The stage the latency belongs to.
+ * @param latency_ns - The latency in nanoseconds.
+ */
+void observe_stage_latency(PIPELINE_STAGE stage, uint64_t latency_ns);
+
+/**
+ * @brief Gets the current value of a counter.
+ *
+ * @param counter - The counter to query.
+ * @return The counter value, 0 for an invalid counter.
+ */
+uint64_t get_metric_counter(METRIC_COUNTER counter);
+
+/**
+ * @brief Gets the latency histogram of a stage.
+ *
+ * @param stage - The stage to query.
+ * @return Pointer to the histogram, NULL for an invalid stage.
+ */
+const LatencyHistogram* get_stage_latency_histogram(PIPELINE_STAGE stage);
+
+/**
+ * @brief Clears every counter, gauge and histogram.
+ */
+void reset_metrics(void);
+
+/**
+ * @brief Writes every metric in the Prometheus text exposition format.
+ *
+ * @param output - The output stream.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE write_metrics_prometheus(FILE* output);
+
+/**
+ * @brief Dumps the metrics to a file for a textfile collector, written to a temporary file first and renamed
+ *        so a scraper never reads a partial dump.
+ *
+ * @param filepath - Path of the metrics file.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE dump_metrics_to_file(const char* filepath);
+
+#endif //METRICS_H
@@ -0,0 +1,101 @@
+#ifndef STAGE_TIMERS_H
+#define STAGE_TIMERS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define NANOSECONDS_IN_SECOND (1000000000ULL)
+#define NANOSECONDS_IN_MILLISECOND (1000000.0)
+#define BYTES_IN_MEGABYTE (1000000.0)
+
+enum PIPELINE_STAGE
+{
+    PIPELINE_STAGE_READ = 0,
+    PIPELINE_STAGE_DESERIALIZE_SECRETS,
+    PIPELINE_STAGE_RANDOM_BIT_EXPANSION,
+    PIPELINE_STAGE_PADDING,
+    PIPELINE_STAGE_BLOCK_MULTIPLY,
+    PIPELINE_STAGE_AFFINE,
+    PIPELINE_STAGE_MAPPING_PERMUTATION,
+    PIPELINE_STAGE_SERIALIZE,
+    PIPELINE_STAGE_WRITE,
+
+    NUMBER_OF_PIPELINE_STAGES
+} typedef PIPELINE_STAGE;
+
+struct StageStatistics {
+    uint64_t calls;
+    uint64_t elapsed_ns;
+    uint64_t bytes_processed;
+} typedef StageStatistics;
+
+extern bool g_stage_timing_mode;
+
+/**
+ * @brief Reads a monotonic clock.
+ *
+ * @return The current time in nanoseconds.
+ */
+uint64_t get_monotonic_time_ns(void);
+
+/**
+ * @brief Enables or disables per-stage timing, statistics are only collected while enabled.
+ *
+ * @param enabled - If true, stage timers record their measurements.
+ */
+void set_stage_timing_mode(bool enabled);
+
+/**
+ * @brief Checks if per-stage timing is enabled.
+ *
+ * @return true if per-stage timing is enabled, false otherwise.
+ */
+bool is_stage_timing_mode(void);
+
+/**
+ * @brief Starts a stage timer, does not touch the clock while timing is disabled.
+ *
+ * @return The start time to pass to stop_stage_timer.
+ */
+uint64_t start_stage_timer(void);
+
+/**
+ * @brief Stops a stage timer and accumulates the elapsed time and processed bytes into the stage statistics.
+ *
+ * @param stage - The stage that was timed.
+ * @param start_time - The value returned by start_stage_timer.
+ * @param bytes_processed - The number of bytes the stage handled.
+ */
+void stop_stage_timer(PIPELINE_STAGE stage, uint64_t start_time, uint64_t bytes_processed);
+
+/**
+ * @brief Gets the printable name of a stage.
+ *
+ * @param stage - The stage to query.
+ * @return The stage name, "unknown" for an invalid stage.
+ */
+const char* get_stage_name(PIPELINE_STAGE stage);
+
+/**
+ * @brief Gets the accumulated statistics of a stage.
+ *
+ * @param stage - The stage to query.
+ * @return Pointer to the stage statistics, NULL for an invalid stage.
+ */
+const StageStatistics* get_stage_statistics(PIPELINE_STAGE stage);
+
+/**
+ * @brief Clears the accumulated statistics of every stage.
+ */
+void reset_stage_statistics(void);
+
+/**
+ * @brief Prints a per-stage breakdown of calls, time, bytes processed and throughput.
+ *
+ * @param output - The output stream.
+ */
+void print_stage_statistics(FILE* output);
+
+#endif //STAGE_TIMERS_H
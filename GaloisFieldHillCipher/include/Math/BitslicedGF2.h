@@ -0,0 +1,111 @@
+#ifndef BITSLICED_GF2_H
+#define BITSLICED_GF2_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+#include "Math/FieldElement.h"
+#include "Math/MatrixUtils.h"
+
+#define GF2_PRIME_FIELD (2)
+#define GF2_BITS_PER_WORD (64)
+#define GF2_BITS_PER_BYTE (8)
+#define GF2_BLOCKS_PER_SLICE (64) // Blocks multiplied together, one bit of every slice word each
+#define GF2_MINIMAL_SLICED_BLOCKS (8) // Fewer blocks are multiplied one by one with row parities, a transposition costs more
+#define GF2_M4RI_STRIP_WIDTH (8) // Columns eliminated together by a table of every combination of their pivot rows
+
+/**
+ * A matrix over GF(2) with every row packed into 64 bit words, column j of a row is bit j % 64 of word j / 64.
+ * Blocks over GF(2) are dimension bits in dimension / 8 bytes, element i is bit 7 - i % 8 of byte i / 8,
+ * so the bit expansion of a plaintext is encrypted as is and a block is a whole number of bytes.
+ */
+struct GF2BitMatrix {
+    uint64_t* rows; // dimension rows of words_per_row words
+    uint32_t dimension;
+    uint32_t words_per_row;
+} typedef GF2BitMatrix;
+
+/**
+ * @brief Calculates the number of 64 bit words holding a row or a vector of the dimension.
+ *
+ * @param dimension - The dimension.
+ * @return The number of words.
+ */
+uint32_t calculate_gf2_words_per_row(uint32_t dimension);
+
+/**
+ * @brief Packs a row-major matrix of field elements over GF(2).
+ *
+ * @param out_matrix - Pointer to the output matrix, released with free_gf2_bit_matrix.
+ * @param flat_matrix - dimension * dimension elements aligned to [0, 2).
+ * @param dimension - Dimension of the matrix.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE pack_gf2_bit_matrix(GF2BitMatrix* out_matrix, const FieldVector* flat_matrix, uint32_t dimension);
+
+/**
+ * @brief Packs a vector of field elements over GF(2) the way the rows of a GF2BitMatrix are packed.
+ *
+ * @param out_vector - Pointer to the output vector of calculate_gf2_words_per_row(dimension) words, allocated inside the function.
+ * @param vector - dimension elements aligned to [0, 2).
+ * @param dimension - Length of the vector.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE pack_gf2_bit_vector(uint64_t** out_vector, const FieldVector* vector, uint32_t dimension);
+
+/**
+ * @brief Frees the rows of a packed matrix and resets it.
+ *
+ * @param matrix - The matrix to free, may be NULL.
+ */
+void free_gf2_bit_matrix(GF2BitMatrix* matrix);
+
+/**
+ * @brief Inverts a packed matrix with the Method of Four Russians: columns are eliminated in strips of GF2_M4RI_STRIP_WIDTH,
+ *        every other row is cleared in a strip by a single XOR of a precomputed combination of the strip's pivot rows.
+ *
+ * @param out_inverse - Pointer to the output inverse, released with free_gf2_bit_matrix.
+ * @param matrix - The matrix to invert.
+ * @return STATUS_CODE - Status of the operation, STATUS_CODE_MATRIX_NOT_INVERTIBLE if the matrix is singular.
+ */
+STATUS_CODE invert_gf2_bit_matrix(GF2BitMatrix* out_inverse, const GF2BitMatrix* matrix);
+
+/**
+ * @brief Calculates the inverse of a square matrix over GF(2) with invert_gf2_bit_matrix.
+ *
+ * @param out_inverse_matrix - Pointer to the output inverse matrix (allocated inside function).
+ * @param matrix - Pointer to the input matrix, any integers, only their parity is used.
+ * @param dimension - Dimension of the square matrix.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE inverse_square_matrix_over_gf2(int64_t*** out_inverse_matrix, int64_t** matrix, uint32_t dimension);
+
+/**
+ * @brief Transposes a 64x64 bit matrix in place, bit c of word r is swapped with bit r of word c.
+ *
+ * @param words - The 64 words of the matrix.
+ */
+void transpose_gf2_64x64(uint64_t* words);
+
+/**
+ * @brief Multiplies packed blocks with a packed matrix, out_block = matrix * (block + input_offset) + output_offset over GF(2).
+ *        Blocks are transposed 64 at a time into bit slices, one word per element holding it for all 64 blocks, so every
+ *        key row costs an AND and an XOR per element for 64 blocks at once. Constant time in the key and the data.
+ *
+ * @param out_blocks - Output of number_of_blocks * dimension / 8 bytes, may not overlap the input.
+ * @param blocks - The input blocks, number_of_blocks * dimension / 8 bytes.
+ * @param number_of_blocks - Number of blocks.
+ * @param matrix - The packed matrix, its dimension must be a multiple of 8.
+ * @param input_offset - Packed vector added to every block before the product, may be NULL.
+ * @param output_offset - Packed vector added to every product, may be NULL.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE multiply_gf2_blocks(uint8_t* out_blocks, const uint8_t* blocks, size_t number_of_blocks, const GF2BitMatrix* matrix,
+    const uint64_t* input_offset, const uint64_t* output_offset);
+
+#endif //BITSLICED_GF2_H
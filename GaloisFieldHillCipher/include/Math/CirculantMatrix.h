@@ -0,0 +1,117 @@
+#ifndef CIRCULANT_MATRIX_H
+#define CIRCULANT_MATRIX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+#include "Math/FieldElement.h"
+#include "Math/FieldInverse.h"
+#include "Math/MatrixUtils.h"
+#include "Math/NumberTheoreticTransform.h"
+
+/**
+ * A circulant matrix C[row][column] = column_vector[(row - column) mod n] is fully described by its first column.
+ * C * x is the cyclic convolution of the column with x, so with a length-n NTT it costs O(n log n) instead of O(n^2),
+ * and the transformed column holds the eigenvalues of C: C is invertible iff none of them is zero.
+ */
+struct CirculantKey {
+    NttContext transform;
+    uint32_t* transformed_column; // NTT of the first column
+    uint32_t* workspace; // Per block transform buffer, a key is used by a single thread at a time
+} typedef CirculantKey;
+
+/**
+ * @brief Transforms the first column of a circulant matrix for repeated multiplications.
+ *
+ * @param out_key - Pointer to the output key, released with free_circulant_key.
+ * @param column - The first column of the matrix, dimension elements aligned to [0, prime_field).
+ * @param dimension - Dimension of the matrix, see is_ntt_compatible.
+ * @param prime_field - The prime field.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE initialize_circulant_key(CirculantKey* out_key, const int64_t* column, uint32_t dimension, uint32_t prime_field);
+
+/**
+ * @brief Frees the memory held by a circulant key.
+ *
+ * @param key - The key to free, may be NULL.
+ */
+void free_circulant_key(CirculantKey* key);
+
+/**
+ * @brief Makes a view of a transformed key with a workspace of its own, so one key can be shared by several threads.
+ *
+ * @param out_view - Pointer to the output view, released with free_circulant_key_view before the key.
+ * @param key - The key to view.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE create_circulant_key_view(CirculantKey* out_view, const CirculantKey* key);
+
+/**
+ * @brief Frees the workspace of a view made by create_circulant_key_view, the viewed key is left intact.
+ *
+ * @param view - The view to free, may be NULL.
+ */
+void free_circulant_key_view(CirculantKey* view);
+
+/**
+ * @brief Calculates the first column of the inverse of a circulant matrix, inverting the eigenvalues in the transform domain.
+ *
+ * @param out_inverse_column - Pointer to the output column, allocated inside the function.
+ * @param column - The first column of the matrix.
+ * @param dimension - Dimension of the matrix, see is_ntt_compatible.
+ * @param prime_field - The prime field.
+ * @return STATUS_CODE - Status of the operation, STATUS_CODE_MATRIX_NOT_INVERTIBLE if an eigenvalue is zero.
+ */
+STATUS_CODE invert_circulant_column(int64_t** out_inverse_column, const int64_t* column, uint32_t dimension, uint32_t prime_field);
+
+/**
+ * @brief Builds the dense matrix of a circulant column.
+ *
+ * @param out_matrix - Pointer to the output matrix, allocated inside the function.
+ * @param column - The first column of the matrix.
+ * @param dimension - Dimension of the matrix.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE expand_circulant_column(int64_t*** out_matrix, const int64_t* column, uint32_t dimension);
+
+/**
+ * @brief Multiplies a circulant matrix with a plaintext block and adds an offset vector, the circulant counterpart
+ *        of multiply_flat_matrix_with_uint8_t_vector.
+ *
+ * @param out_vector - Preallocated output vector of the key dimension.
+ * @param key - The circulant key.
+ * @param vector - The plaintext block.
+ * @param offset_vector - Vector added to the product, may be NULL.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE multiply_circulant_with_uint8_t_vector(FieldVector* out_vector, CirculantKey* key, const uint8_t* vector, const FieldVector* offset_vector);
+
+/**
+ * @brief Multiplies a circulant matrix with a field vector whose product is a plaintext block, the circulant
+ *        counterpart of multiply_flat_matrix_with_field_vector.
+ *
+ * @param out_vector - Output buffer of the key dimension.
+ * @param key - The circulant key.
+ * @param vector - The vector to multiply.
+ * @return STATUS_CODE - Status of the operation, STATUS_CODE_INVALID_RESULT_WIDTH if an element exceeds a byte.
+ */
+STATUS_CODE multiply_circulant_with_field_vector(uint8_t* out_vector, CirculantKey* key, const FieldVector* vector);
+
+/**
+ * @brief Multiplies a circulant matrix with a field vector and adds an offset vector, the result stays over the field,
+ *        the circulant counterpart of multiply_flat_matrix_with_field_vector_over_field.
+ *
+ * @param out_vector - Preallocated output vector of the key dimension, may be the input vector.
+ * @param key - The circulant key.
+ * @param vector - The field vector.
+ * @param offset_vector - Vector added to the product, may be NULL.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE multiply_circulant_with_field_vector_over_field(FieldVector* out_vector, CirculantKey* key, const FieldVector* vector, const FieldVector* offset_vector);
+
+#endif //CIRCULANT_MATRIX_H
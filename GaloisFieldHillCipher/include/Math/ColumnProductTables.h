@@ -0,0 +1,105 @@
+#ifndef COLUMN_PRODUCT_TABLES_H
+#define COLUMN_PRODUCT_TABLES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+#include "Math/FieldElement.h"
+#include "Math/SpecializedKernels.h"
+
+/**
+ * Largest memory the tables of a key may take, keys whose tables don't fit multiply the key matrix instead.
+ * Override at build time to trade memory for speed, e.g. -DCOLUMN_PRODUCT_TABLES_MEMORY_BUDGET=0 to never build them.
+ */
+#ifndef COLUMN_PRODUCT_TABLES_MEMORY_BUDGET
+#define COLUMN_PRODUCT_TABLES_MEMORY_BUDGET (256 * 1024) // Tables past the L2 cache miss on most lookups and lose to the matrix kernels
+#endif
+
+#define COLUMN_PRODUCT_TABLE_ENTRIES (UINT8_MAX + 1) // A table row for every plaintext byte value
+#define COLUMN_PRODUCT_ROWS_PER_PASS (64) // Output rows the runtime-dimension loop accumulates together, longer blocks run in strips of rows
+
+/**
+ * Width of the sums of a block, the narrowest that holds dimension + 1 elements below the prime.
+ */
+enum COLUMN_PRODUCT_SUMS
+{
+    COLUMN_PRODUCT_SUMS_UINT16 = 0, // Small primes, twice the lanes of 32 bit sums
+    COLUMN_PRODUCT_SUMS_UINT32, // 16 bit elements, a FieldVector holds the tables of dimensions below 4096 only so their sums fit
+    COLUMN_PRODUCT_SUMS_UINT64, // 32 bit elements
+
+    NUMBER_OF_COLUMN_PRODUCT_SUMS
+} typedef COLUMN_PRODUCT_SUMS;
+
+/**
+ * The product of every key column with every byte value, so encrypting a block is a table row added per plaintext byte,
+ * no multiplications and a single reduction per element (Method of Four Russians over byte digits).
+ * Row b of table j holds b * K[:, j] reduced to [0, prime_field), the tables are stored column after column.
+ * Lookups are indexed by the plaintext, a block loop with tables isn't constant time in the data.
+ */
+struct ColumnProductTables {
+    FieldVector products; // dimension * COLUMN_PRODUCT_TABLE_ENTRIES * dimension elements of the key width
+    uint32_t dimension;
+    uint32_t prime_field;
+    COLUMN_PRODUCT_SUMS sums;
+    uint64_t reduction_multiplier; // 16 and 32 bit sums are reduced by a multiplication and a shift instead of a division
+    uint32_t reduction_shift;
+} typedef ColumnProductTables;
+
+/**
+ * @brief Calculates the memory the column product tables of a key take.
+ *
+ * @param dimension - Dimension of the key.
+ * @param prime_field - Prime field of the key.
+ * @return The size of the tables in bytes.
+ */
+uint64_t calculate_column_product_tables_size(uint32_t dimension, uint32_t prime_field);
+
+/**
+ * @brief Checks whether a key should encrypt with column product tables: its tables fit COLUMN_PRODUCT_TABLES_MEMORY_BUDGET
+ *        and its dimension is in SPECIALIZED_KERNEL_DIMENSIONS. Only the unrolled table kernels beat the matrix kernels,
+ *        the runtime-dimension loop merely matches the interleaved one.
+ *
+ * @param dimension - Dimension of the key.
+ * @param prime_field - Prime field of the key.
+ * @return True if the tables should be built for the key.
+ */
+bool can_use_column_product_tables(uint32_t dimension, uint32_t prime_field);
+
+/**
+ * @brief Builds the column product tables of a key, every row from the previous one with a single modular addition.
+ *
+ * @param out_tables - Pointer to the output tables, released with free_column_product_tables.
+ * @param flat_matrix - Row-major key elements aligned to [0, prime_field).
+ * @param dimension - Dimension of the key.
+ * @param prime_field - Prime field of the key.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE build_column_product_tables(ColumnProductTables* out_tables, const FieldVector* flat_matrix, uint32_t dimension, uint32_t prime_field);
+
+/**
+ * @brief Frees the column product tables and resets them.
+ *
+ * @param tables - The tables to free, may be NULL.
+ */
+void free_column_product_tables(ColumnProductTables* tables);
+
+/**
+ * @brief Encrypts contiguous blocks with the tables, out_blocks[block] = K * blocks[block] + offset over the field.
+ *        Dimensions in SPECIALIZED_KERNEL_DIMENSIONS run a fully unrolled kernel, any other runs the runtime-dimension loop.
+ *
+ * @param out_blocks - Output of at least number_of_blocks * dimension elements of the key width, block after block.
+ * @param tables - The column product tables of the key.
+ * @param blocks - The plaintext blocks, number_of_blocks * dimension bytes.
+ * @param number_of_blocks - Number of blocks.
+ * @param offset_vector - Elements of the key width aligned to [0, prime_field) added to every product, may be NULL.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE multiply_column_product_tables_with_uint8_t_blocks(FieldVector* out_blocks, const ColumnProductTables* tables, const uint8_t* blocks,
+    uint32_t number_of_blocks, const FieldVector* offset_vector);
+
+#endif //COLUMN_PRODUCT_TABLES_H
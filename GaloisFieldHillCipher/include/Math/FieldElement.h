@@ -0,0 +1,83 @@
+#ifndef FIELD_ELEMENT_H
+#define FIELD_ELEMENT_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+#include "Instrumentation/Metrics.h"
+
+#define MAXIMAL_PRIME_FIELD_FOR_UINT16_ELEMENTS ((uint32_t)UINT16_MAX + 1)
+
+enum FIELD_ELEMENT_WIDTH
+{
+	FIELD_ELEMENT_WIDTH_UINT16 = 0,
+	FIELD_ELEMENT_WIDTH_UINT32,
+
+	NUMBER_OF_FIELD_ELEMENT_WIDTHS
+} typedef FIELD_ELEMENT_WIDTH;
+
+/**
+ * Vector of field elements stored in the narrowest lane that holds [0, prime_field).
+ * Hot loops switch on the width once and then run over the typed array.
+ */
+struct FieldVector {
+    void* elements;
+    uint32_t length;
+    FIELD_ELEMENT_WIDTH width;
+} typedef FieldVector;
+
+/**
+ * @brief Selects the narrowest element width that holds every element of the prime field.
+ *
+ * @param prime_field - The prime field used.
+ * @return The element width for the prime field.
+ */
+FIELD_ELEMENT_WIDTH select_field_element_width(uint32_t prime_field);
+
+/**
+ * @brief Gets the size of a single element of the given width.
+ *
+ * @param width - The element width.
+ * @return The size of an element in bytes, 0 for an invalid width.
+ */
+size_t get_field_element_size(FIELD_ELEMENT_WIDTH width);
+
+/**
+ * @brief Allocates a zeroed vector of field elements with the width selected for the prime field.
+ *
+ * @param out_vector - Pointer to the output vector, its elements are released with free_field_vector.
+ * @param length - The number of elements in the vector.
+ * @param prime_field - The prime field used to select the element width.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE allocate_field_vector(FieldVector* out_vector, uint32_t length, uint32_t prime_field);
+
+/**
+ * @brief Frees the elements of a field vector and resets it.
+ *
+ * @param vector - The vector to free, may be NULL.
+ */
+void free_field_vector(FieldVector* vector);
+
+/**
+ * @brief Reads a single element of a field vector, meant for code outside of hot loops.
+ *
+ * @param vector - The vector to read from.
+ * @param index - The index of the element.
+ * @return The element value.
+ */
+uint32_t get_field_vector_element(const FieldVector* vector, size_t index);
+
+/**
+ * @brief Writes a single element of a field vector, meant for code outside of hot loops.
+ *
+ * @param vector - The vector to write to.
+ * @param index - The index of the element.
+ * @param value - The element value, must be below the prime field of the vector.
+ */
+void set_field_vector_element(FieldVector* vector, size_t index, uint32_t value);
+
+#endif //FIELD_ELEMENT_H
@@ -0,0 +1,72 @@
+#ifndef FIELD_INVERSE_H
+#define FIELD_INVERSE_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+
+#define INVERSE_TABLE_PRIME_FIELD_LIMIT ((uint32_t)1 << 20)
+#define INVERSE_TABLE_ENTRIES_PER_INVERSION (16) // Table entries filled in about the time of one extended Euclid inversion
+
+/**
+ * Per-field context for multiplicative inverses.
+ * Fields below INVERSE_TABLE_PRIME_FIELD_LIMIT get a precomputed inverse table when the expected inversions outweigh filling it,
+ * otherwise every inversion runs the extended Euclidean algorithm.
+ */
+struct FieldContext {
+    uint32_t prime_field;
+    uint32_t* inverse_table; // inverse_table[x] = x^-1, NULL when the field is too large for a table
+} typedef FieldContext;
+
+/**
+ * @brief Initializes a field context, building the inverse table for small prime fields when it pays off.
+ *        A table costs O(prime_field), so it is only built when
+ *        number_of_inversions * INVERSE_TABLE_ENTRIES_PER_INVERSION reaches the prime field.
+ *
+ * @param out_context - Pointer to the output context, released with free_field_context.
+ * @param prime_field - The prime field of the context.
+ * @param number_of_inversions - The number of inversions the context is expected to serve.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE initialize_field_context(FieldContext* out_context, uint32_t prime_field, uint64_t number_of_inversions);
+
+/**
+ * @brief Frees the memory held by a field context.
+ *
+ * @param context - The context to free, may be NULL.
+ */
+void free_field_context(FieldContext* context);
+
+/**
+ * @brief Calculates a multiplicative inverse with the extended Euclidean algorithm.
+ *
+ * @param element - The element to invert, aligned to [1, prime_field).
+ * @param prime_field - The prime field to use for calculations.
+ * @return The inverse of the element.
+ */
+uint32_t extended_euclid_inverse(uint32_t element, uint32_t prime_field);
+
+/**
+ * @brief Calculates the multiplicative inverse of an element over the field of the context.
+ *
+ * @param out_inverse - Pointer to the output inverse.
+ * @param element - The element to invert, any value that is not a multiple of the prime field.
+ * @param context - The field context.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE inverse_over_galois_field(int64_t* out_inverse, int64_t element, const FieldContext* context);
+
+/**
+ * @brief Inverts a vector of elements with Montgomery's batch trick, one inversion and 3(n-1) multiplications in total.
+ *
+ * @param out_inverses - Caller owned output vector of length elements, may be the input vector.
+ * @param elements - The elements to invert, none of them may be a multiple of the prime field.
+ * @param length - The number of elements.
+ * @param context - The field context.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE batch_inverse_over_galois_field(int64_t* out_inverses, const int64_t* elements, uint32_t length, const FieldContext* context);
+
+#endif //FIELD_INVERSE_H
@@ -9,7 +9,9 @@
 
 #include "StatusCodes.h"
 #include "Math/FieldBasicOperations.h"
+#include "Math/FieldInverse.h"
 #include "Math/MatrixDeterminant.h"
+#include "Math/BitslicedGF2.h"
 #include "log.h"
 
 #define IS_ODD(x) ((x) % 2 != 0)
@@ -17,6 +19,7 @@
 
 /**
  * @brief Calculates the inverse of a square matrix using Gauss-Jordan elimination.
+ *        Over GF(2) the elimination runs on packed rows, see inverse_square_matrix_over_gf2.
  *
  * @param out_inverse_matrix - Pointer to the output inverse matrix (allocated inside function).
  * @param matrix - Pointer to the input matrix.
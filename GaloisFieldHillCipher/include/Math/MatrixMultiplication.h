@@ -9,9 +9,12 @@
 
 #include "StatusCodes.h"
 #include "FieldBasicOperations.h"
+#include "FieldElement.h"
+#include "SpecializedKernels.h"
 #include "log.h"
 
 #define MEMORY_BUFFER_FOR_PLAINTEXT_BLOCK (3)
+#define BLOCKS_PER_INTERLEAVED_PASS (4)
 
 /**
  * @brief Multiplies a square matrix with a vector.
@@ -37,4 +40,85 @@ STATUS_CODE multiply_matrix_with_uint8_t_vector(int64_t** out_vector, int64_t**
  */
 STATUS_CODE multiply_matrix_with_int64_t_vector(uint8_t** out_vector, int64_t** matrix, int64_t* vector, uint32_t dimension, uint32_t prime_field);
 
+/**
+ * @brief Multiplies a flat row-major square matrix with a uint8_t vector into a caller owned buffer and adds an optional offset.
+ *        Products are accumulated in 64 bits and reduced once per accumulation window instead of once per product.
+ *
+ * @param out_vector - Caller owned output vector of at least dimension elements, same width as the matrix.
+ * @param flat_matrix - Row-major matrix with elements aligned to [0, prime_field) (see flatten_square_matrix_over_field).
+ * @param vector - Pointer to the input vector.
+ * @param offset_vector - Vector aligned to [0, prime_field) added to the product, may be NULL.
+ * @param dimension - Dimension of the square matrix and vector.
+ * @param prime_field - Prime field to use for calculations.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE multiply_flat_matrix_with_uint8_t_vector(FieldVector* out_vector, const FieldVector* flat_matrix, const uint8_t* vector, const FieldVector* offset_vector, uint32_t dimension, uint32_t prime_field);
+
+/**
+ * @brief Multiplies a flat row-major square matrix with a field vector for decryption into a caller owned uint8_t buffer.
+ *
+ * @param out_vector - Caller owned output vector of dimension elements.
+ * @param flat_matrix - Row-major matrix with elements aligned to [0, prime_field) (see flatten_square_matrix_over_field).
+ * @param vector - Pointer to the input vector, same width as the matrix and elements aligned to [0, prime_field).
+ * @param dimension - Dimension of the square matrix and vector.
+ * @param prime_field - Prime field to use for calculations.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE multiply_flat_matrix_with_field_vector(uint8_t* out_vector, const FieldVector* flat_matrix, const FieldVector* vector, uint32_t dimension, uint32_t prime_field);
+
+/**
+ * @brief Multiplies a flat row-major square matrix with a field vector into a caller owned field vector and adds an optional offset,
+ *        the result stays over the field (used to move a ciphertext block from one key to another).
+ * @param out_vector - Caller owned output vector of at least dimension elements, same width as the matrix, must not be the input vector.
+ * @param flat_matrix - Row-major matrix with elements aligned to [0, prime_field) (see flatten_square_matrix_over_field).
+ * @param vector - Pointer to the input vector, same width as the matrix and elements aligned to [0, prime_field).
+ * @param offset_vector - Vector aligned to [0, prime_field) added to the product, may be NULL.
+ * @param dimension - Dimension of the square matrix and vector.
+ * @param prime_field - Prime field to use for calculations.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE multiply_flat_matrix_with_field_vector_over_field(FieldVector* out_vector, const FieldVector* flat_matrix, const FieldVector* vector, const FieldVector* offset_vector, uint32_t dimension, uint32_t prime_field);
+
+/**
+ * @brief Multiplies two square matrices over the field.
+ * @param out_matrix - Pointer to the output matrix - allocated inside the function and memory released if fails.
+ * @param left_matrix - The left matrix, elements aligned to [0, prime_field).
+ * @param right_matrix - The right matrix, elements aligned to [0, prime_field).
+ * @param dimension - Dimension of the square matrices.
+ * @param prime_field - Prime field to use for calculations.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE multiply_square_matrices_over_field(int64_t*** out_matrix, int64_t** left_matrix, int64_t** right_matrix, uint32_t dimension, uint32_t prime_field);
+
+/**
+ * @brief Multiplies a flat row-major square matrix with a batch of contiguous uint8_t blocks and adds an optional offset to every block.
+ *        Every matrix row is applied to the whole batch before moving to the next row, so a row is read once per batch instead of once per block.
+ *
+ * @param out_blocks - Caller owned output of at least number_of_blocks * dimension elements, same width as the matrix, block after block.
+ * @param flat_matrix - Row-major matrix with elements aligned to [0, prime_field) (see flatten_square_matrix_over_field).
+ * @param blocks - The input blocks, number_of_blocks * dimension bytes, block after block.
+ * @param number_of_blocks - The number of blocks in the batch.
+ * @param offset_vector - Vector aligned to [0, prime_field) added to every product, may be NULL.
+ * @param dimension - Dimension of the square matrix and of every block.
+ * @param prime_field - Prime field to use for calculations.
+ * @param interleave_blocks - If true, four blocks are accumulated together so every load of a matrix element is shared by four products.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE multiply_flat_matrix_with_uint8_t_blocks(FieldVector* out_blocks, const FieldVector* flat_matrix, const uint8_t* blocks, uint32_t number_of_blocks, const FieldVector* offset_vector, uint32_t dimension, uint32_t prime_field, bool interleave_blocks);
+
+/**
+ * @brief Multiplies a flat row-major square matrix with a batch of contiguous field blocks for decryption into a caller owned uint8_t buffer.
+ *        Every matrix row is applied to the whole batch before moving to the next row.
+ *
+ * @param out_blocks - Caller owned output of number_of_blocks * dimension bytes, block after block.
+ * @param flat_matrix - Row-major matrix with elements aligned to [0, prime_field) (see flatten_square_matrix_over_field).
+ * @param blocks - The input blocks, at least number_of_blocks * dimension elements of the matrix width, aligned to [0, prime_field).
+ * @param number_of_blocks - The number of blocks in the batch.
+ * @param dimension - Dimension of the square matrix and of every block.
+ * @param prime_field - Prime field to use for calculations.
+ * @param interleave_blocks - If true, four blocks are accumulated together so every load of a matrix element is shared by four products.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE multiply_flat_matrix_with_field_blocks(uint8_t* out_blocks, const FieldVector* flat_matrix, const FieldVector* blocks, uint32_t number_of_blocks, uint32_t dimension, uint32_t prime_field, bool interleave_blocks);
+
 #endif //MATRIXMULTIPLICATION_H
@@ -11,6 +11,8 @@
 #include "StatusCodes.h"
 #include "log.h"
 #include "Math/MathUtils.h"
+#include "Math/FieldElement.h"
+#include "Math/FieldInverse.h"
 
 /**
  * @brief Frees the memory allocated for a matrix.
@@ -51,6 +53,30 @@ STATUS_CODE generate_square_matrix_over_field(int64_t*** out_matrix, uint32_t di
  */
 STATUS_CODE generate_matrix_over_field(int64_t*** out_matrix, uint32_t rows, uint32_t columns, uint32_t prime_field);
 
+/**
+ * @brief Allocates a zeroed matrix.
+ *
+ * @param out_matrix - Pointer to the output matrix - allocated inside the function and memory released if fails.
+ * @param rows - Number of rows in the matrix.
+ * @param columns - Number of columns in the matrix.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE allocate_int64_matrix(int64_t*** out_matrix, uint32_t rows, uint32_t columns);
+
+/**
+ * @brief Generates an invertible square matrix and its inverse with cryptography secure random values, without retries.
+ *        The matrix is built as P * L * U from a random row permutation P, a random unit lower triangular L
+ *        and a random upper triangular U with a non-zero diagonal, so it is invertible by construction and
+ *        its inverse U^-1 * L^-1 * P^-1 comes out of the same O(n^3) pass.
+ *
+ * @param out_matrix - Pointer to the output matrix - allocated inside the function and memory released if fails.
+ * @param out_inverse_matrix - Pointer to the output inverse matrix, may be NULL when the inverse is not needed.
+ * @param dimension - Dimension of the square matrix.
+ * @param prime_field - Prime field to use for generating random values.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE generate_invertible_matrix_over_field(int64_t*** out_matrix, int64_t*** out_inverse_matrix, uint32_t dimension, uint32_t prime_field);
+
 /**
  * @brief Checks if a matrix is invertible.
  *
@@ -74,4 +100,16 @@ STATUS_CODE is_matrix_invertible(bool* out_is_invertible, int64_t** matrix, uint
  */
 STATUS_CODE build_minor_matrix(int64_t*** out_minor_matrix, int64_t** matrix, uint32_t dimension, uint32_t row_to_exclude, size_t column_to_exclude);
 
+/**
+ * @brief Copies a square matrix into a contiguous row-major buffer with every element aligned to [0, prime_field).
+ *        Elements are stored in the narrowest width that holds the prime field (see select_field_element_width).
+ *
+ * @param out_flat_matrix - Pointer to the output flat matrix - allocated inside the function and memory released if fails.
+ * @param matrix - Pointer to the input matrix.
+ * @param dimension - Dimension of the square matrix.
+ * @param prime_field - Prime field to align the elements to.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE flatten_square_matrix_over_field(FieldVector* out_flat_matrix, int64_t** matrix, uint32_t dimension, uint32_t prime_field);
+
 #endif
@@ -0,0 +1,75 @@
+#ifndef NUMBER_THEORETIC_TRANSFORM_H
+#define NUMBER_THEORETIC_TRANSFORM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+
+/**
+ * Twiddle factors of a length-n number-theoretic transform over GF(p).
+ * A length-n transform exists when n is a power of two dividing p - 1, i.e. p = k * 2^m + 1 with n <= 2^m.
+ */
+struct NttContext {
+    uint32_t prime_field;
+    uint32_t length;
+    uint32_t inverse_length; // length^-1 mod prime_field, applied by the inverse transform
+    uint32_t* roots; // roots[i] = w^i for i < length / 2, w a primitive length-th root of unity
+    uint32_t* inverse_roots; // inverse_roots[i] = w^-i
+} typedef NttContext;
+
+/**
+ * @brief Checks if GF(prime_field) has a number-theoretic transform of the given length.
+ *
+ * @param length - The transform length.
+ * @param prime_field - The prime field.
+ * @return true if length is a power of two dividing prime_field - 1, false otherwise.
+ */
+bool is_ntt_compatible(uint32_t length, uint32_t prime_field);
+
+/**
+ * @brief Calculates base^exponent mod prime_field.
+ *
+ * @param base - The base, aligned to [0, prime_field).
+ * @param exponent - The exponent.
+ * @param prime_field - The prime field.
+ * @return The power.
+ */
+uint32_t power_over_galois_field(uint32_t base, uint64_t exponent, uint32_t prime_field);
+
+/**
+ * @brief Finds a primitive root of unity of the given length and builds the twiddle tables.
+ *
+ * @param out_context - Pointer to the output context, released with free_ntt_context.
+ * @param length - The transform length, see is_ntt_compatible.
+ * @param prime_field - The prime field.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE initialize_ntt_context(NttContext* out_context, uint32_t length, uint32_t prime_field);
+
+/**
+ * @brief Frees the twiddle tables of a context.
+ *
+ * @param context - The context to free, may be NULL.
+ */
+void free_ntt_context(NttContext* context);
+
+/**
+ * @brief Transforms the values in place, input and output are in natural order.
+ *
+ * @param values - context->length values aligned to [0, prime_field).
+ * @param context - The transform context.
+ */
+void ntt_forward(uint32_t* values, const NttContext* context);
+
+/**
+ * @brief Inverse of ntt_forward, including the scaling by length^-1.
+ *
+ * @param values - context->length values aligned to [0, prime_field).
+ * @param context - The transform context.
+ */
+void ntt_inverse(uint32_t* values, const NttContext* context);
+
+#endif //NUMBER_THEORETIC_TRANSFORM_H
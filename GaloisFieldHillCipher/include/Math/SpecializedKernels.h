@@ -0,0 +1,80 @@
+#ifndef SPECIALIZED_KERNELS_H
+#define SPECIALIZED_KERNELS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "StatusCodes.h"
+#include "FieldElement.h"
+#include "log.h"
+
+/**
+ * Dimensions that get a fully unrolled kernel, every entry expands X(dimension).
+ * Override at build time to match the key sizes in use, e.g. -D'SPECIALIZED_KERNEL_DIMENSIONS(X)=X(8) X(12) X(24)'.
+ */
+#ifndef SPECIALIZED_KERNEL_DIMENSIONS
+#define SPECIALIZED_KERNEL_DIMENSIONS(X) X(8) X(16) X(32) X(64)
+#endif
+
+#define SPECIALIZED_KERNEL_ROWS_PER_PASS (4) // Rows accumulated together, every block element is loaded once per pass
+
+// The column loops have a constant trip count, asking for a full unroll turns every row into straight-line code
+#if defined(__clang__)
+#define UNROLL_FULLY _Pragma("clang loop unroll(full)")
+#elif defined(__GNUC__)
+#define UNROLL_FULLY _Pragma("GCC unroll 64")
+#else
+#define UNROLL_FULLY
+#endif
+
+/**
+ * @brief Encrypts one block with a fixed dimension, out_block = matrix * block + offset over the field.
+ *        Only valid when dimension products fit a 64 bit accumulator without reduction (see can_use_specialized_kernel).
+ *
+ * @param out_block - Output of dimension elements, same width as the matrix.
+ * @param flat_matrix - Row-major matrix elements of the kernel width, aligned to [0, prime_field).
+ * @param block - The plaintext block, dimension bytes.
+ * @param offset_vector - Elements of the kernel width aligned to [0, prime_field) added to the product, may be NULL.
+ * @param prime_field - Prime field to use for calculations.
+ */
+typedef void (*SpecializedEncryptKernel)(void* out_block, const void* flat_matrix, const uint8_t* block, const void* offset_vector, uint32_t prime_field);
+
+/**
+ * @brief Decrypts one block with a fixed dimension, out_block = matrix * block over the field.
+ *
+ * @param out_block - Output of dimension bytes.
+ * @param flat_matrix - Row-major matrix elements of the kernel width, aligned to [0, prime_field).
+ * @param block - The ciphertext block, dimension elements of the kernel width aligned to [0, prime_field).
+ * @param prime_field - Prime field to use for calculations.
+ * @return STATUS_CODE - Status of the operation, STATUS_CODE_INVALID_RESULT_WIDTH if a result doesn't fit a byte.
+ */
+typedef STATUS_CODE (*SpecializedDecryptKernel)(uint8_t* out_block, const void* flat_matrix, const void* block, uint32_t prime_field);
+
+/**
+ * The unrolled kernels of one dimension, indexed by the element width of the flat matrix.
+ */
+struct SpecializedBlockKernels {
+    uint32_t dimension;
+    SpecializedEncryptKernel encrypt_kernels[NUMBER_OF_FIELD_ELEMENT_WIDTHS];
+    SpecializedDecryptKernel decrypt_kernels[NUMBER_OF_FIELD_ELEMENT_WIDTHS];
+} typedef SpecializedBlockKernels;
+
+/**
+ * @brief Looks up the unrolled kernels generated for a dimension.
+ *
+ * @param dimension - The key dimension.
+ * @return The kernels of the dimension, NULL if the dimension runs the runtime-dimension loops.
+ */
+const SpecializedBlockKernels* get_specialized_block_kernels(uint32_t dimension);
+
+/**
+ * @brief Checks that a whole row fits the accumulation window, the unrolled kernels reduce once per row.
+ *
+ * @param dimension - The key dimension.
+ * @param accumulation_window - Number of products that can be summed on top of a reduced value without overflow.
+ * @return true if the unrolled kernels may be used.
+ */
+bool can_use_specialized_kernel(uint32_t dimension, uint32_t accumulation_window);
+
+#endif //SPECIALIZED_KERNELS_H
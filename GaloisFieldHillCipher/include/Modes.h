@@ -10,6 +10,9 @@ enum OPERATION_MODE
 	ENCRYPT_MODE,
 	GENERATE_AND_ENCRYPT_MODE,
 	GENERATE_AND_DECRYPT_MODE,
+	REKEY_MODE,
+	BATCH_MODE,
+	SHARD_MODE,
 
 	NUMBER_OF_MODES
 } typedef OPERATION_MODE;
@@ -13,6 +13,7 @@
 #include "Modes.h"
 #include "StatusCodes.h"
 #include "IO/FileValidation.h"
+#include "IO/AsyncFileIO.h"
 #include "Parsing/ModeParsers.h"
 
 #define MAX_ERROR_MSG_LEN (256)
@@ -21,6 +22,9 @@
 #define DEFAULT_VALUE_OF_NUMBER_OF_ERROR_VECTORS_TO_ADD (5)
 #define DEFAULT_VALUE_OF_NUMBER_OF_ASCII_CHARACTERS_MAPPED_TO_EACH_DIGIT (5)
 #define DEFAULT_VALUE_OF_GALOIS_FIELD (16777619)
+#define DEFAULT_VALUE_OF_BATCH_MEMORY_BUDGET_IN_MEGABYTES (256)
+#define DEFAULT_VALUE_OF_SHARD_SIZE_IN_MEGABYTES (64)
+#define DEFAULT_VALUE_OF_SHARD_RETRIES (3)
 #define NUMBER_OF_FLAGS_FOR_EACH_OPTION (2)
 #define MEMORY_FOR_FLAG_PREFIX (3)
 
@@ -30,16 +34,19 @@
 #define MODE_DECRYPT "d"
 #define MODE_GENERATE_AND_ENCRYPT "kge"
 #define MODE_GENERATE_AND_DECRYPT "kgd"
+#define MODE_REKEY "rk"
+#define MODE_BATCH "b"
+#define MODE_SHARD "sh"
 
 #define FLAG_INPUT_FILE "input"
 #define FLAG_INPUT_FILE_SHORT "i"
 #define FLAG_INPUT_FILE_TYPE "<FILE>"
-#define FLAG_INPUT_FILE_DESCRIPTION "Specify the input file (required for encrypt, decrypt, generate_and_encrypt, and generate_and_decrypt modes)."
+#define FLAG_INPUT_FILE_DESCRIPTION "Specify the input file (required for encrypt, decrypt, generate_and_encrypt, and generate_and_decrypt modes), " STANDARD_STREAM_PATH " reads stdin in encrypt and decrypt modes."
 
 #define FLAG_OUTPUT_FILE "output"
 #define FLAG_OUTPUT_FILE_SHORT "o"
 #define FLAG_OUTPUT_FILE_TYPE "<FILE>"
-#define FLAG_OUTPUT_FILE_DESCRIPTION "Specify the output file (required for all modes)."
+#define FLAG_OUTPUT_FILE_DESCRIPTION "Specify the output file (required for all modes), " STANDARD_STREAM_PATH " writes stdout in encrypt and decrypt modes."
 
 #define FLAG_KEY_FILE "key"
 #define FLAG_KEY_FILE_SHORT "k"
@@ -71,6 +78,21 @@
 #define FLAG_VERBOSE_TYPE ""
 #define FLAG_VERBOSE_DESCRIPTION "Enable verbose output (optional)."
 
+#define FLAG_STATS "stats"
+#define FLAG_STATS_SHORT "s"
+#define FLAG_STATS_TYPE ""
+#define FLAG_STATS_DESCRIPTION "Print a per-stage timing breakdown with bytes processed and throughput (optional)."
+
+#define FLAG_METRICS_FILE "metrics"
+#define FLAG_METRICS_FILE_SHORT "M"
+#define FLAG_METRICS_FILE_TYPE "<FILE>"
+#define FLAG_METRICS_FILE_DESCRIPTION "Dump counters, gauges and stage latency histograms in Prometheus text format to a file on exit (optional)."
+
+#define FLAG_TUNING_CACHE_FILE "tuning-cache"
+#define FLAG_TUNING_CACHE_FILE_SHORT "T"
+#define FLAG_TUNING_CACHE_FILE_TYPE "<FILE>"
+#define FLAG_TUNING_CACHE_FILE_DESCRIPTION "Autotune the block loop kernel, batch size and threads per host and key shape, results are cached in the file (optional)."
+
 #define FLAG_MODE "mode"
 #define FLAG_MODE_SHORT "m"
 #define FLAG_MODE_TYPE "<MODE>"
@@ -80,23 +102,94 @@
     MODE_ENCRYPT " (encrypt), " \
     MODE_DECRYPT " (decrypt), " \
     MODE_GENERATE_AND_ENCRYPT " (generate and encrypt), " \
-    MODE_GENERATE_AND_DECRYPT " (generate and decrypt)."
+    MODE_GENERATE_AND_DECRYPT " (generate and decrypt), " \
+    MODE_REKEY " (rekey ciphertext), " \
+    MODE_BATCH " (batch encrypt or decrypt), " \
+    MODE_SHARD " (sharded encrypt or decrypt)."
 
 #define FLAG_PRIME_FIELD "prime-field"
 #define FLAG_PRIME_FIELD_SHORT "f"
 #define FLAG_PRIME_FIELD_TYPE "<NUMBER>"
-#define FLAG_PRIME_FIELD_DESCRIPTION "Specify the prime field (optional, default: 16777619)."
+#define FLAG_PRIME_FIELD_DESCRIPTION "Specify the prime field (optional, default: 16777619, 2 needs a dimension that is a multiple of 8)."
 
 #define FLAG_ASCII_MAPPING_LETTERS "ascii-mapping-letters"
 #define FLAG_ASCII_MAPPING_LETTERS_SHORT "a"
 #define FLAG_ASCII_MAPPING_LETTERS_TYPE "<NUMBER>"
 #define FLAG_ASCII_MAPPING_LETTERS_DESCRIPTION "Specify the number of letters for ASCII mapping (optional)."
 
+#define FLAG_CIRCULANT "circulant"
+#define FLAG_CIRCULANT_SHORT "c"
+#define FLAG_CIRCULANT_TYPE ""
+#define FLAG_CIRCULANT_DESCRIPTION "Generate a circulant key multiplied in O(n log n), the dimension must be a power of two dividing prime-field - 1 (optional)."
+
+#define FLAG_SEEDED_KEY "seeded-key"
+#define FLAG_SEEDED_KEY_SHORT "S"
+#define FLAG_SEEDED_KEY_TYPE ""
+#define FLAG_SEEDED_KEY_DESCRIPTION "Store the key as a 32 byte seed and its parameters, the matrices are regenerated when the key is loaded (optional)."
+
+#define FLAG_MAPPED_KEY "mapped-key"
+#define FLAG_MAPPED_KEY_SHORT "z"
+#define FLAG_MAPPED_KEY_TYPE ""
+#define FLAG_MAPPED_KEY_DESCRIPTION "Store the key with its inverse as aligned flat sections that are mapped in place when the key is loaded (optional)."
+
+#define FLAG_NEW_KEY_FILE "new-key"
+#define FLAG_NEW_KEY_FILE_SHORT "n"
+#define FLAG_NEW_KEY_FILE_TYPE "<FILE>"
+#define FLAG_NEW_KEY_FILE_DESCRIPTION "Specify the encryption key the ciphertext is moved to (required for rekey mode, --key is then the old decryption key)."
+
 #define FLAG_DECRYPTION_KEY_OUTPUT_FILE "decryption-key-output"
 #define FLAG_DECRYPTION_KEY_OUTPUT_FILE_SHORT "y"
 #define FLAG_DECRYPTION_KEY_OUTPUT_FILE_TYPE "<FILE>"
 #define FLAG_DECRYPTION_KEY_OUTPUT_FILE_DESCRIPTION "Specify the decryption key output file (required for generate_and_decrypt mode)."
 
+#define FLAG_BATCH_DECRYPT "batch-decrypt"
+#define FLAG_BATCH_DECRYPT_SHORT "D"
+#define FLAG_BATCH_DECRYPT_TYPE ""
+#define FLAG_BATCH_DECRYPT_DESCRIPTION "Decrypt the files of a batch with decryption keys, they are encrypted otherwise (optional)."
+
+#define FLAG_THREADS "threads"
+#define FLAG_THREADS_SHORT "t"
+#define FLAG_THREADS_TYPE "<NUMBER>"
+#define FLAG_THREADS_DESCRIPTION "Specify the number of files a batch processes at once (optional, default: the hardware threads)."
+
+#define FLAG_MEMORY_BUDGET "memory-budget"
+#define FLAG_MEMORY_BUDGET_SHORT "B"
+#define FLAG_MEMORY_BUDGET_TYPE "<MB>"
+#define FLAG_MEMORY_BUDGET_DESCRIPTION "Specify the megabytes of file buffers a batch may hold in flight, a larger file runs alone (optional, default: 256)."
+
+#define FLAG_WORKERS "workers"
+#define FLAG_WORKERS_SHORT "w"
+#define FLAG_WORKERS_TYPE "<NUMBER>"
+#define FLAG_WORKERS_DESCRIPTION "Specify the number of worker processes a sharded run starts (optional, default: the hardware threads)."
+
+#define FLAG_SHARD_SIZE "shard-size"
+#define FLAG_SHARD_SIZE_SHORT "Z"
+#define FLAG_SHARD_SIZE_TYPE "<MB>"
+#define FLAG_SHARD_SIZE_DESCRIPTION "Specify the megabytes of plaintext in each shard, at most 256 (optional, default: 64)."
+
+#define FLAG_RETRIES "retries"
+#define FLAG_RETRIES_SHORT "R"
+#define FLAG_RETRIES_TYPE "<NUMBER>"
+#define FLAG_RETRIES_DESCRIPTION "Specify how many times a shard whose worker failed is handed out again (optional, default: 3)."
+
+#define FORMAT_BINARY "bin"
+#define FORMAT_TEXT "text"
+
+#define FLAG_FORMAT "format"
+#define FLAG_FORMAT_SHORT "F"
+#define FLAG_FORMAT_TYPE "<bin|text>"
+#define FLAG_FORMAT_DESCRIPTION "Specify the ciphertext format in place of the file extension (required when the ciphertext is streamed through " STANDARD_STREAM_PATH ")."
+
+#define FLAG_IO_BACKEND "io-backend"
+#define FLAG_IO_BACKEND_SHORT "I"
+#define FLAG_IO_BACKEND_TYPE "<" IO_BACKEND_AUTO "|" IO_BACKEND_IO_URING "|" IO_BACKEND_THREADS ">"
+#define FLAG_IO_BACKEND_DESCRIPTION "Process files in chunks, reading ahead and writing behind on io_uring or an I/O thread (optional, streams use " IO_BACKEND_AUTO ")."
+
+#define FLAG_PIPELINE "pipeline"
+#define FLAG_PIPELINE_SHORT "P"
+#define FLAG_PIPELINE_TYPE ""
+#define FLAG_PIPELINE_DESCRIPTION "Encrypt in chunks with the read, expansion, multiplication, encoding and write on a thread each (optional, " MODE_ENCRYPT " only)."
+
 #define USAGE_STRING \
 "Usage: GaloisFieldHillCipher [OPTIONS]\n" \
 "\n" \
@@ -109,6 +202,9 @@
 "      " MODE_DECRYPT " - Decrypt\n" \
 "      " MODE_GENERATE_AND_ENCRYPT " - Generate and encrypt\n" \
 "      " MODE_GENERATE_AND_DECRYPT " - Generate and decrypt\n" \
+"      " MODE_REKEY " - Rekey ciphertext\n" \
+"      " MODE_BATCH " - Batch encrypt or decrypt a manifest or a directory of files\n" \
+"      " MODE_SHARD " - Encrypt a file in shards on worker processes into a container, or decrypt the container\n" \
 "\n" \
 "General Options:\n" \
 "  --" FLAG_INPUT_FILE ", -" FLAG_INPUT_FILE_SHORT " " FLAG_INPUT_FILE_TYPE "          " FLAG_INPUT_FILE_DESCRIPTION "\n" \
@@ -120,8 +216,24 @@
 "  --" FLAG_ERROR_VECTORS ", -" FLAG_ERROR_VECTORS_SHORT " " FLAG_ERROR_VECTORS_TYPE "    " FLAG_ERROR_VECTORS_DESCRIPTION "\n" \
 "  --" FLAG_PRIME_FIELD ", -" FLAG_PRIME_FIELD_SHORT " " FLAG_PRIME_FIELD_TYPE "      " FLAG_PRIME_FIELD_DESCRIPTION "\n" \
 "  --" FLAG_ASCII_MAPPING_LETTERS ", -" FLAG_ASCII_MAPPING_LETTERS_SHORT " " FLAG_ASCII_MAPPING_LETTERS_TYPE " " FLAG_ASCII_MAPPING_LETTERS_DESCRIPTION "\n" \
+"  --" FLAG_CIRCULANT ", -" FLAG_CIRCULANT_SHORT "                 " FLAG_CIRCULANT_DESCRIPTION "\n" \
+"  --" FLAG_SEEDED_KEY ", -" FLAG_SEEDED_KEY_SHORT "                " FLAG_SEEDED_KEY_DESCRIPTION "\n" \
+"  --" FLAG_MAPPED_KEY ", -" FLAG_MAPPED_KEY_SHORT "                " FLAG_MAPPED_KEY_DESCRIPTION "\n" \
 "  --" FLAG_DECRYPTION_KEY_OUTPUT_FILE ", -" FLAG_DECRYPTION_KEY_OUTPUT_FILE_SHORT " " FLAG_DECRYPTION_KEY_OUTPUT_FILE_TYPE " " FLAG_DECRYPTION_KEY_OUTPUT_FILE_DESCRIPTION "\n" \
+"  --" FLAG_NEW_KEY_FILE ", -" FLAG_NEW_KEY_FILE_SHORT " " FLAG_NEW_KEY_FILE_TYPE "        " FLAG_NEW_KEY_FILE_DESCRIPTION "\n" \
+"  --" FLAG_FORMAT ", -" FLAG_FORMAT_SHORT " " FLAG_FORMAT_TYPE "      " FLAG_FORMAT_DESCRIPTION "\n" \
+"  --" FLAG_IO_BACKEND ", -" FLAG_IO_BACKEND_SHORT " " FLAG_IO_BACKEND_TYPE " " FLAG_IO_BACKEND_DESCRIPTION "\n" \
+"  --" FLAG_PIPELINE ", -" FLAG_PIPELINE_SHORT "                 " FLAG_PIPELINE_DESCRIPTION "\n" \
+"  --" FLAG_BATCH_DECRYPT ", -" FLAG_BATCH_DECRYPT_SHORT "             " FLAG_BATCH_DECRYPT_DESCRIPTION "\n" \
+"  --" FLAG_THREADS ", -" FLAG_THREADS_SHORT " " FLAG_THREADS_TYPE "          " FLAG_THREADS_DESCRIPTION "\n" \
+"  --" FLAG_MEMORY_BUDGET ", -" FLAG_MEMORY_BUDGET_SHORT " " FLAG_MEMORY_BUDGET_TYPE "        " FLAG_MEMORY_BUDGET_DESCRIPTION "\n" \
+"  --" FLAG_WORKERS ", -" FLAG_WORKERS_SHORT " " FLAG_WORKERS_TYPE "          " FLAG_WORKERS_DESCRIPTION "\n" \
+"  --" FLAG_SHARD_SIZE ", -" FLAG_SHARD_SIZE_SHORT " " FLAG_SHARD_SIZE_TYPE "           " FLAG_SHARD_SIZE_DESCRIPTION "\n" \
+"  --" FLAG_RETRIES ", -" FLAG_RETRIES_SHORT " " FLAG_RETRIES_TYPE "          " FLAG_RETRIES_DESCRIPTION "\n" \
 "  --" FLAG_VERBOSE ", -" FLAG_VERBOSE_SHORT "                   " FLAG_VERBOSE_DESCRIPTION "\n" \
+"  --" FLAG_STATS ", -" FLAG_STATS_SHORT "                     " FLAG_STATS_DESCRIPTION "\n" \
+"  --" FLAG_METRICS_FILE ", -" FLAG_METRICS_FILE_SHORT " " FLAG_METRICS_FILE_TYPE "        " FLAG_METRICS_FILE_DESCRIPTION "\n" \
+"  --" FLAG_TUNING_CACHE_FILE ", -" FLAG_TUNING_CACHE_FILE_SHORT " " FLAG_TUNING_CACHE_FILE_TYPE "   " FLAG_TUNING_CACHE_FILE_DESCRIPTION "\n" \
 "\n" \
 "Examples:\n" \
 "  GaloisFieldHillCipher --" FLAG_MODE " " MODE_KEY_GENERATION " --" FLAG_OUTPUT_FILE " key.txt --" FLAG_DIMENSION " 4\n" \
@@ -129,19 +241,38 @@
 "             --" FLAG_KEY_FILE " key.txt\n" \
 "  GaloisFieldHillCipher --" FLAG_MODE " " MODE_DECRYPT " --" FLAG_INPUT_FILE " ciphertext.txt --" FLAG_OUTPUT_FILE " plaintext.txt\n" \
 "             --" FLAG_KEY_FILE " key.txt\n" \
+"  tar -c docs | GaloisFieldHillCipher --" FLAG_MODE " " MODE_ENCRYPT " --" FLAG_INPUT_FILE " " STANDARD_STREAM_PATH " --" FLAG_OUTPUT_FILE " " STANDARD_STREAM_PATH "\n" \
+"             --" FLAG_KEY_FILE " key.bin --" FLAG_FORMAT " " FORMAT_BINARY " | zstd > docs.tar.enc.zst\n" \
+"  GaloisFieldHillCipher --" FLAG_MODE " " MODE_ENCRYPT " --" FLAG_INPUT_FILE " disk.img --" FLAG_OUTPUT_FILE " disk.img.bin\n" \
+"             --" FLAG_KEY_FILE " key.bin --" FLAG_IO_BACKEND " " IO_BACKEND_IO_URING "\n" \
+"  GaloisFieldHillCipher --" FLAG_MODE " " MODE_ENCRYPT " --" FLAG_INPUT_FILE " backup.tar --" FLAG_OUTPUT_FILE " backup.tar.bin\n" \
+"             --" FLAG_KEY_FILE " key.bin --" FLAG_PIPELINE "\n" \
 "  GaloisFieldHillCipher --" FLAG_MODE " " MODE_GENERATE_AND_ENCRYPT " --" FLAG_INPUT_FILE " plaintext.txt\n" \
 "             --" FLAG_OUTPUT_FILE " ciphertext.txt --" FLAG_KEY_FILE " key.txt --" FLAG_DIMENSION " 4\n" \
 "  GaloisFieldHillCipher --" FLAG_MODE " " MODE_GENERATE_AND_DECRYPT " --" FLAG_INPUT_FILE " ciphertext.txt\n" \
 "             --" FLAG_OUTPUT_FILE " plaintext.txt --" FLAG_KEY_FILE " encryption_key.txt --" FLAG_DECRYPTION_KEY_OUTPUT_FILE " decryption_key.txt\n" \
+"  GaloisFieldHillCipher --" FLAG_MODE " " MODE_REKEY " --" FLAG_INPUT_FILE " ciphertext.bin --" FLAG_OUTPUT_FILE " rekeyed.bin\n" \
+"             --" FLAG_KEY_FILE " old_decryption_key.bin --" FLAG_NEW_KEY_FILE " new_encryption_key.bin\n" \
+"  GaloisFieldHillCipher --" FLAG_MODE " " MODE_BATCH " --" FLAG_INPUT_FILE " manifest.txt --" FLAG_THREADS " 8\n" \
+"  GaloisFieldHillCipher --" FLAG_MODE " " MODE_BATCH " --" FLAG_INPUT_FILE " ciphertexts/ --" FLAG_OUTPUT_FILE " plaintexts/\n" \
+"             --" FLAG_KEY_FILE " decryption_key.bin --" FLAG_BATCH_DECRYPT "\n" \
+"  GaloisFieldHillCipher --" FLAG_MODE " " MODE_SHARD " --" FLAG_INPUT_FILE " archive.tar --" FLAG_OUTPUT_FILE " archive.tar.shards\n" \
+"             --" FLAG_KEY_FILE " key.bin --" FLAG_WORKERS " 16 --" FLAG_SHARD_SIZE " 128\n" \
+"  GaloisFieldHillCipher --" FLAG_MODE " " MODE_SHARD " --" FLAG_INPUT_FILE " archive.tar.shards --" FLAG_OUTPUT_FILE " archive.tar\n" \
+"             --" FLAG_KEY_FILE " decryption_key.bin --" FLAG_BATCH_DECRYPT "\n" \
 "\n" \
 "Notes:\n" \
 "  - The input and output files must be readable and writable, respectively.\n" \
+"  - Streams through " STANDARD_STREAM_PATH " are processed in fixed-size chunks, status lines then go to stderr.\n" \
 "  - The key file must be a valid binary file.\n" \
 "  - The log file must be a text file.\n"
 
 typedef struct GlobalArguments {
     bool verbose;
     const char* log_file;
+    bool stats;
+    const char* metrics_file;
+    const char* tuning_cache_file;
 } GlobalArguments;
 
 /**
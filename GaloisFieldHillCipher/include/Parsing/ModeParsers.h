@@ -3,6 +3,9 @@
 
 #include "Parsing/ArgumentParser.h"
 #include "log.h"
+#include "Math/NumberTheoreticTransform.h"
+#include "Math/BitslicedGF2.h"
+#include "Cipher/ShardCoordinator.h"
 
 
 #define USAGE_KEY_GENERATION_MODE \
@@ -12,7 +15,10 @@
     "  --" FLAG_ERROR_VECTORS ", -" FLAG_ERROR_VECTORS_SHORT " " FLAG_ERROR_VECTORS_TYPE "    " FLAG_ERROR_VECTORS_DESCRIPTION "\n" \
     "  --" FLAG_PRIME_FIELD ", -" FLAG_PRIME_FIELD_SHORT " " FLAG_PRIME_FIELD_TYPE "      " FLAG_PRIME_FIELD_DESCRIPTION "\n" \
     "  --" FLAG_RANDOM_BITS ", -" FLAG_RANDOM_BITS_SHORT " " FLAG_RANDOM_BITS_TYPE "      " FLAG_RANDOM_BITS_DESCRIPTION "\n" \
-    "  --" FLAG_ASCII_MAPPING_LETTERS ", -" FLAG_ASCII_MAPPING_LETTERS_SHORT " " FLAG_ASCII_MAPPING_LETTERS_TYPE " " FLAG_ASCII_MAPPING_LETTERS_DESCRIPTION "\n"
+    "  --" FLAG_ASCII_MAPPING_LETTERS ", -" FLAG_ASCII_MAPPING_LETTERS_SHORT " " FLAG_ASCII_MAPPING_LETTERS_TYPE " " FLAG_ASCII_MAPPING_LETTERS_DESCRIPTION "\n" \
+    "  --" FLAG_CIRCULANT ", -" FLAG_CIRCULANT_SHORT "                 " FLAG_CIRCULANT_DESCRIPTION "\n" \
+    "  --" FLAG_SEEDED_KEY ", -" FLAG_SEEDED_KEY_SHORT "                " FLAG_SEEDED_KEY_DESCRIPTION "\n" \
+    "  --" FLAG_MAPPED_KEY ", -" FLAG_MAPPED_KEY_SHORT "                " FLAG_MAPPED_KEY_DESCRIPTION "\n"
 
 #define USAGE_DECRYPTION_KEY_GENERATION_MODE \
     "Usage for decryption key generation mode:\n" \
@@ -23,13 +29,18 @@
     "Usage for decrypt mode:\n" \
     "  --" FLAG_INPUT_FILE ", -" FLAG_INPUT_FILE_SHORT " " FLAG_INPUT_FILE_TYPE "          " FLAG_INPUT_FILE_DESCRIPTION "\n" \
     "  --" FLAG_OUTPUT_FILE ", -" FLAG_OUTPUT_FILE_SHORT " " FLAG_OUTPUT_FILE_TYPE "         " FLAG_OUTPUT_FILE_DESCRIPTION "\n" \
-    "  --" FLAG_KEY_FILE ", -" FLAG_KEY_FILE_SHORT " " FLAG_KEY_FILE_TYPE "            " FLAG_KEY_FILE_DESCRIPTION "\n"
+    "  --" FLAG_KEY_FILE ", -" FLAG_KEY_FILE_SHORT " " FLAG_KEY_FILE_TYPE "            " FLAG_KEY_FILE_DESCRIPTION "\n" \
+    "  --" FLAG_FORMAT ", -" FLAG_FORMAT_SHORT " " FLAG_FORMAT_TYPE "      " FLAG_FORMAT_DESCRIPTION "\n" \
+    "  --" FLAG_IO_BACKEND ", -" FLAG_IO_BACKEND_SHORT " " FLAG_IO_BACKEND_TYPE " " FLAG_IO_BACKEND_DESCRIPTION "\n"
 
 #define USAGE_ENCRYPT_MODE \
     "Usage for encrypt mode:\n" \
     "  --" FLAG_INPUT_FILE ", -" FLAG_INPUT_FILE_SHORT " " FLAG_INPUT_FILE_TYPE "          " FLAG_INPUT_FILE_DESCRIPTION "\n" \
     "  --" FLAG_OUTPUT_FILE ", -" FLAG_OUTPUT_FILE_SHORT " " FLAG_OUTPUT_FILE_TYPE "         " FLAG_OUTPUT_FILE_DESCRIPTION "\n" \
-    "  --" FLAG_KEY_FILE ", -" FLAG_KEY_FILE_SHORT " " FLAG_KEY_FILE_TYPE "            " FLAG_KEY_FILE_DESCRIPTION "\n"
+    "  --" FLAG_KEY_FILE ", -" FLAG_KEY_FILE_SHORT " " FLAG_KEY_FILE_TYPE "            " FLAG_KEY_FILE_DESCRIPTION "\n" \
+    "  --" FLAG_FORMAT ", -" FLAG_FORMAT_SHORT " " FLAG_FORMAT_TYPE "      " FLAG_FORMAT_DESCRIPTION "\n" \
+    "  --" FLAG_IO_BACKEND ", -" FLAG_IO_BACKEND_SHORT " " FLAG_IO_BACKEND_TYPE " " FLAG_IO_BACKEND_DESCRIPTION "\n" \
+    "  --" FLAG_PIPELINE ", -" FLAG_PIPELINE_SHORT "                 " FLAG_PIPELINE_DESCRIPTION "\n"
 
 #define USAGE_GENERATE_AND_ENCRYPT_MODE \
     "Usage for generate and encrypt mode:\n" \
@@ -40,7 +51,10 @@
     "  --" FLAG_ERROR_VECTORS ", -" FLAG_ERROR_VECTORS_SHORT " " FLAG_ERROR_VECTORS_TYPE "    " FLAG_ERROR_VECTORS_DESCRIPTION "\n" \
     "  --" FLAG_PRIME_FIELD ", -" FLAG_PRIME_FIELD_SHORT " " FLAG_PRIME_FIELD_TYPE "      " FLAG_PRIME_FIELD_DESCRIPTION "\n" \
     "  --" FLAG_RANDOM_BITS ", -" FLAG_RANDOM_BITS_SHORT " " FLAG_RANDOM_BITS_TYPE "      " FLAG_RANDOM_BITS_DESCRIPTION "\n" \
-    "  --" FLAG_ASCII_MAPPING_LETTERS ", -" FLAG_ASCII_MAPPING_LETTERS_SHORT " " FLAG_ASCII_MAPPING_LETTERS_TYPE " " FLAG_ASCII_MAPPING_LETTERS_DESCRIPTION "\n"
+    "  --" FLAG_ASCII_MAPPING_LETTERS ", -" FLAG_ASCII_MAPPING_LETTERS_SHORT " " FLAG_ASCII_MAPPING_LETTERS_TYPE " " FLAG_ASCII_MAPPING_LETTERS_DESCRIPTION "\n" \
+    "  --" FLAG_CIRCULANT ", -" FLAG_CIRCULANT_SHORT "                 " FLAG_CIRCULANT_DESCRIPTION "\n" \
+    "  --" FLAG_SEEDED_KEY ", -" FLAG_SEEDED_KEY_SHORT "                " FLAG_SEEDED_KEY_DESCRIPTION "\n" \
+    "  --" FLAG_MAPPED_KEY ", -" FLAG_MAPPED_KEY_SHORT "                " FLAG_MAPPED_KEY_DESCRIPTION "\n"
 
 #define USAGE_GENERATE_AND_DECRYPT_MODE \
     "Usage for generate and decrypt mode:\n" \
@@ -49,6 +63,33 @@
     "  --" FLAG_KEY_FILE ", -" FLAG_KEY_FILE_SHORT " " FLAG_KEY_FILE_TYPE "            " FLAG_KEY_FILE_DESCRIPTION "\n" \
     "  --" FLAG_DECRYPTION_KEY_OUTPUT_FILE ", -" FLAG_DECRYPTION_KEY_OUTPUT_FILE_SHORT " " FLAG_DECRYPTION_KEY_OUTPUT_FILE_TYPE " " FLAG_DECRYPTION_KEY_OUTPUT_FILE_DESCRIPTION "\n"
 
+#define USAGE_REKEY_MODE \
+    "Usage for rekey mode:\n" \
+    "  --" FLAG_INPUT_FILE ", -" FLAG_INPUT_FILE_SHORT " " FLAG_INPUT_FILE_TYPE "          " FLAG_INPUT_FILE_DESCRIPTION "\n" \
+    "  --" FLAG_OUTPUT_FILE ", -" FLAG_OUTPUT_FILE_SHORT " " FLAG_OUTPUT_FILE_TYPE "         " FLAG_OUTPUT_FILE_DESCRIPTION "\n" \
+    "  --" FLAG_KEY_FILE ", -" FLAG_KEY_FILE_SHORT " " FLAG_KEY_FILE_TYPE "            " FLAG_KEY_FILE_DESCRIPTION "\n" \
+    "  --" FLAG_NEW_KEY_FILE ", -" FLAG_NEW_KEY_FILE_SHORT " " FLAG_NEW_KEY_FILE_TYPE "        " FLAG_NEW_KEY_FILE_DESCRIPTION "\n"
+
+#define USAGE_BATCH_MODE \
+    "Usage for batch mode:\n" \
+    "  --" FLAG_INPUT_FILE ", -" FLAG_INPUT_FILE_SHORT " " FLAG_INPUT_FILE_TYPE "          A manifest with an \"input output [key]\" line per file, or a directory of files.\n" \
+    "  --" FLAG_OUTPUT_FILE ", -" FLAG_OUTPUT_FILE_SHORT " " FLAG_OUTPUT_FILE_TYPE "         The directory results are written to (required for a directory input).\n" \
+    "  --" FLAG_KEY_FILE ", -" FLAG_KEY_FILE_SHORT " " FLAG_KEY_FILE_TYPE "            The key of every file of a directory, or of manifest lines without one.\n" \
+    "  --" FLAG_BATCH_DECRYPT ", -" FLAG_BATCH_DECRYPT_SHORT "             " FLAG_BATCH_DECRYPT_DESCRIPTION "\n" \
+    "  --" FLAG_THREADS ", -" FLAG_THREADS_SHORT " " FLAG_THREADS_TYPE "          " FLAG_THREADS_DESCRIPTION "\n" \
+    "  --" FLAG_MEMORY_BUDGET ", -" FLAG_MEMORY_BUDGET_SHORT " " FLAG_MEMORY_BUDGET_TYPE "        " FLAG_MEMORY_BUDGET_DESCRIPTION "\n"
+
+#define USAGE_SHARD_MODE \
+    "Usage for shard mode:\n" \
+    "  --" FLAG_INPUT_FILE ", -" FLAG_INPUT_FILE_SHORT " " FLAG_INPUT_FILE_TYPE "          The file to encrypt, or the shard container to decrypt.\n" \
+    "  --" FLAG_OUTPUT_FILE ", -" FLAG_OUTPUT_FILE_SHORT " " FLAG_OUTPUT_FILE_TYPE "         The shard container, or the decrypted file. Not a stream, shards are written at offsets.\n" \
+    "  --" FLAG_KEY_FILE ", -" FLAG_KEY_FILE_SHORT " " FLAG_KEY_FILE_TYPE "            The encryption key, or the decryption key with --" FLAG_BATCH_DECRYPT ", loaded by every worker.\n" \
+    "  --" FLAG_BATCH_DECRYPT ", -" FLAG_BATCH_DECRYPT_SHORT "             Decrypt a shard container, a file is encrypted into one otherwise (optional).\n" \
+    "  --" FLAG_FORMAT ", -" FLAG_FORMAT_SHORT " " FLAG_FORMAT_TYPE "      The format of the shard ciphertexts, the container records it (optional, default: " FORMAT_BINARY ").\n" \
+    "  --" FLAG_WORKERS ", -" FLAG_WORKERS_SHORT " " FLAG_WORKERS_TYPE "          " FLAG_WORKERS_DESCRIPTION "\n" \
+    "  --" FLAG_SHARD_SIZE ", -" FLAG_SHARD_SIZE_SHORT " " FLAG_SHARD_SIZE_TYPE "           " FLAG_SHARD_SIZE_DESCRIPTION "\n" \
+    "  --" FLAG_RETRIES ", -" FLAG_RETRIES_SHORT " " FLAG_RETRIES_TYPE "          " FLAG_RETRIES_DESCRIPTION "\n"
+
 typedef struct
 {
     const char* output_file;
@@ -57,6 +98,9 @@ typedef struct
     uint32_t prime_field;
     uint32_t number_of_random_bits_to_add;
     uint32_t number_of_letters_for_each_digit_ascii_mapping;
+    bool circulant_key;
+    bool seeded_key;
+    bool mapped_key;
 } KeyGenerationArguments;
 
 typedef struct {
@@ -68,12 +112,17 @@ typedef struct {
     const char* input_file;
     const char* output_file;
     const char* key;
+    const char* format; // FORMAT_BINARY or FORMAT_TEXT, NULL picks the format from the input file extension
+    const char* io_backend; // IO_BACKEND_AUTO, IO_BACKEND_IO_URING or IO_BACKEND_THREADS, NULL reads and writes files whole
 } DecryptArguments;
 
 typedef struct {
     const char* input_file;
     const char* output_file;
     const char* key;
+    const char* format; // FORMAT_BINARY or FORMAT_TEXT, NULL picks the format from the output file extension
+    const char* io_backend; // IO_BACKEND_AUTO, IO_BACKEND_IO_URING or IO_BACKEND_THREADS, NULL reads and writes files whole
+    bool pipeline; // Encrypt in chunks on the staged pipeline, the I/O backend is not used then
 } EncryptArguments;
 
 typedef struct {
@@ -86,6 +135,34 @@ typedef struct {
     DecryptionKeyGenerationArguments* key_generation_arguments;
 } GenerateAndDecryptArguments;
 
+typedef struct {
+    const char* input_file;
+    const char* output_file;
+    const char* key; // Decryption key of the key the ciphertext is currently under
+    const char* new_key; // Encryption key the ciphertext is moved to
+} RekeyArguments;
+
+typedef struct {
+    const char* input; // A manifest file or a directory
+    const char* output_directory; // Directory inputs only
+    const char* key; // Every file of a directory, manifest lines without a key
+    bool is_directory;
+    bool decrypt;
+    uint32_t number_of_threads; // 0 for the hardware threads
+    uint32_t memory_budget_in_megabytes;
+} BatchArguments;
+
+typedef struct {
+    const char* input_file;
+    const char* output_file;
+    const char* key; // Encryption key, or the decryption key of a container
+    const char* format; // FORMAT_BINARY or FORMAT_TEXT, NULL for binary, containers record their format
+    bool decrypt;
+    uint32_t number_of_workers; // 0 for the hardware threads
+    uint32_t shard_size_in_megabytes;
+    uint32_t number_of_retries;
+} ShardArguments;
+
 /**
  * @brief Parses arguments for the key generation mode.
  *
@@ -146,4 +223,34 @@ STATUS_CODE parse_generate_and_encrypt_arguments(GenerateAndEncryptArguments** o
  */
 STATUS_CODE parse_generate_and_decrypt_arguments(GenerateAndDecryptArguments** out_arguments, int argc, char** argv);
 
+/**
+ * @brief Parses arguments for the rekey mode.
+ *
+ * @param out_arguments Pointer to store the parsed arguments.
+ * @param argc The number of command-line arguments.
+ * @param argv The command-line arguments array.
+ * @return STATUS_CODE Status of the operation.
+ */
+STATUS_CODE parse_rekey_arguments(RekeyArguments** out_arguments, int argc, char** argv);
+
+/**
+ * @brief Parses arguments for the batch mode.
+ *
+ * @param out_arguments Pointer to store the parsed arguments.
+ * @param argc The number of command-line arguments.
+ * @param argv The command-line arguments array.
+ * @return STATUS_CODE Status of the operation.
+ */
+STATUS_CODE parse_batch_arguments(BatchArguments** out_arguments, int argc, char** argv);
+
+/**
+ * @brief Parses arguments for the shard mode.
+ *
+ * @param out_arguments Pointer to store the parsed arguments.
+ * @param argc The number of command-line arguments.
+ * @param argv The command-line arguments array.
+ * @return STATUS_CODE Status of the operation.
+ */
+STATUS_CODE parse_shard_arguments(ShardArguments** out_arguments, int argc, char** argv);
+
 #endif // MODEPARSERS_H
\ No newline at end of file
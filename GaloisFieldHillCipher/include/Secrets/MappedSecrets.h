@@ -0,0 +1,111 @@
+#ifndef MAPPED_SECRETS_H
+#define MAPPED_SECRETS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+#include "Secrets.h"
+#include "Secrets/SecretsGeneration.h"
+#include "Math/FieldElement.h"
+#include "Math/MatrixUtils.h"
+#include "Cipher/CipherParts/AffineTransformation.h"
+#include "Instrumentation/Metrics.h"
+
+/**
+ * Mapped key file: a header, a section table and the sections, each starting at a MAPPED_KEY_SECTION_ALIGNMENT aligned offset.
+ * Matrices and the combined error vector are flat little endian arrays of the element width of the prime field (see Math/FieldElement.h),
+ * so the loader maps the file and points the flat views of the secrets straight into the mapping, nothing is parsed or copied.
+ *
+ * | header | section table | key matrix | inverse key matrix | combined error vector | ASCII mapping | permutation |
+ */
+#define MAPPED_KEY_MAGIC (0x4B4D4348u) // "HCMK"
+#define MAPPED_KEY_VERSION (1)
+#define MAPPED_KEY_FLAG_DECRYPTION ((uint32_t)1 << 0)
+#define MAPPED_KEY_KNOWN_FLAGS (MAPPED_KEY_FLAG_DECRYPTION)
+#define MAPPED_KEY_SECTION_ALIGNMENT (64) // A cache line, and a multiple of every element width
+#define MAPPED_KEY_MAXIMAL_SECTIONS (16) // Sections of an unknown type are skipped, newer writers may add some
+
+enum MAPPED_KEY_SECTION {
+    MAPPED_KEY_SECTION_KEY_MATRIX = 0,
+    MAPPED_KEY_SECTION_INVERSE_KEY_MATRIX,
+    MAPPED_KEY_SECTION_COMBINED_ERROR_VECTOR,
+    MAPPED_KEY_SECTION_ASCII_MAPPING,
+    MAPPED_KEY_SECTION_PERMUTATION,
+    NUMBER_OF_MAPPED_KEY_SECTIONS
+} typedef MAPPED_KEY_SECTION;
+
+struct MappedKeyHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t flags;
+    uint32_t dimension;
+    uint32_t prime_field;
+    uint32_t element_size; // Bytes per matrix element, must match the width selected for the prime field
+    uint32_t number_of_error_vectors; // Informational, only their combination is stored
+    uint32_t number_of_letters_for_each_digit_ascii_mapping;
+    uint32_t number_of_sections;
+    uint32_t reserved;
+} typedef MappedKeyHeader;
+
+struct MappedKeySection {
+    uint32_t type; // MAPPED_KEY_SECTION
+    uint32_t reserved;
+    uint64_t offset; // From the start of the file
+    uint64_t size;
+} typedef MappedKeySection;
+
+/**
+ * @brief Checks whether serialized key data is in the mapped key format.
+ *
+ * @param data - The serialized key.
+ * @param size - The size of the serialized key.
+ * @return true if the data holds a mapped key.
+ */
+bool is_mapped_key_data(const uint8_t* data, size_t size);
+
+/**
+ * @brief Serialize dense secrets to the mapped key format. Flat members are written as they are, otherwise the key matrix is
+ *        flattened, the inverse is taken from the secrets or generated, and the error vectors are combined.
+ *
+ * @param out_data - A pointer to an output vector.
+ * @param out_size - A pointer to the size of the output vector.
+ * @param secrets - The secrets to be serialized.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE serialize_mapped_secrets(uint8_t** out_data, uint32_t* out_size, Secrets secrets);
+
+/**
+ * @brief Deserialize a mapped key by copying its sections, for keys that are not loaded with load_secrets_file.
+ *
+ * @param out_secrets - A pointer to an output Secrets.
+ * @param data - The data to be deserialized.
+ * @param size - The size of the data.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE deserialize_mapped_secrets(Secrets* out_secrets, const uint8_t* data, size_t size);
+
+/**
+ * @brief Loads a key file of any format. The file is mapped, a mapped key keeps the mapping and its flat members point into it,
+ *        so the load cost doesn't depend on the key dimension. Other formats are deserialized from the mapping, which is then released.
+ *
+ * @param out_secrets - A pointer to an output Secrets, released with free_secrets.
+ * @param out_size - A pointer to the size of the key file, may be NULL.
+ * @param filepath - The path of the key file.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE load_secrets_file(Secrets* out_secrets, uint32_t* out_size, const char* filepath);
+
+/**
+ * @brief Releases the mapping of a key loaded by load_secrets_file, called by free_secrets.
+ *
+ * @param mapping - The mapping, may be NULL.
+ * @param size - The size of the mapping.
+ */
+void unmap_secrets_file(void* mapping, size_t size);
+
+#endif //MAPPED_SECRETS_H
@@ -1,12 +1,24 @@
 #ifndef SECRETS_H
 #define SECRETS_H
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+#include "Math/FieldElement.h"
+
 #define NUMBER_OF_UINT32_SECRETS (5)
 
+enum KEY_STRUCTURE {
+    KEY_STRUCTURE_DENSE = 0,
+    KEY_STRUCTURE_CIRCULANT, // Only the first column is stored, see Math/CirculantMatrix.h
+    NUMBER_OF_KEY_STRUCTURES
+} typedef KEY_STRUCTURE;
+
 struct Secrets {
-    int64_t** key_matrix;
+    KEY_STRUCTURE key_structure;
+    int64_t** key_matrix; // NULL for circulant keys
+    int64_t* circulant_column; // First column of a circulant key, NULL for dense keys
     uint32_t dimension;
     int64_t** error_vectors;
     uint32_t number_of_error_vectors;
@@ -15,6 +27,14 @@ struct Secrets {
     uint8_t** ascii_mapping;
     uint32_t number_of_letters_for_each_digit_ascii_mapping;
     uint8_t* permutation_vector;
+    int64_t** inverse_key_matrix; // Produced together with the key matrix on generation, never serialized, may be NULL
+    uint8_t* key_seed; // Seed every other member is regenerated from (RANDOM_SEED_SIZE bytes), NULL for keys stored in full
+    bool is_decryption_key; // Only serialized for seeded keys, a decryption key is regenerated as its encryption key and then inverted
+    FieldVector flat_key_matrix; // Mapped keys only (see Secrets/MappedSecrets.h), key_matrix is NULL for them
+    FieldVector flat_inverse_key_matrix; // Mapped keys only, stored with the key so a decryption key is a swap of the two
+    FieldVector combined_error_vector; // Mapped keys only, error_vectors is NULL for them
+    void* key_mapping; // The mapped key file the flat members point into, NULL when they are owned
+    size_t key_mapping_size;
 } typedef Secrets;
 
 #endif //SECRETS_H
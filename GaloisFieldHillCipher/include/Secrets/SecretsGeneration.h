@@ -8,10 +8,12 @@
 #include "Cipher/CipherParts/CSPRNG.h"
 #include "IO/SerDes.h"
 #include "Math/MatrixUtils.h"
+#include "Math/CirculantMatrix.h"
 #include "IO/LoggerUtils.h"
 
 #define MINIMUM_ASCII_PRINTABLE_CHARACTER (33)
 #define MAXIMUM_ASCII_PRINTABLE_CHARACTER (94)
+#define MAXIMUM_CIRCULANT_KEY_ATTEMPTS (16) // A random column is singular with probability below dimension / prime_field
 
 /**
  * Generates a secure random mapping from digits to ASCII characters.
@@ -33,18 +35,28 @@ STATUS_CODE generate_ascii_mapping(uint8_t*** out_mapping, uint32_t letters_per_
 STATUS_CODE generate_permutation_vector(uint8_t** out_permutation_vector, uint32_t length);
 
 /**
- * @brief Generates an encryption matrix with cryptography secure random values.
+ * @brief Generates an encryption matrix with cryptography secure random values, invertible by construction.
  *
  * @param out_matrix - Pointer to the output matrix - allocated inside the function and memory released if fails.
+ * @param out_inverse_matrix - Pointer to the output decryption matrix generated in the same pass, may be NULL.
  * @param dimension - Dimension of the square matrix.
  * @param prime_field - Prime field to use for generating random values.
- * @param max_attempts - Maximum number of attempts to generate an invertible matrix.
  * @return STATUS_CODE - Status of the operation.
  */
-STATUS_CODE generate_encryption_matrix(int64_t*** out_matrix, uint32_t dimension, uint32_t prime_field, uint32_t max_attempts);
+STATUS_CODE generate_encryption_matrix(int64_t*** out_matrix, int64_t*** out_inverse_matrix, uint32_t dimension, uint32_t prime_field);
 
 /**
- * @brief Generates a decryption matrix from encryption matrix.
+ * @brief Generates the first column of an invertible circulant encryption matrix with cryptography secure random values.
+ *
+ * @param out_column - Pointer to the output column - allocated inside the function and memory released if fails.
+ * @param dimension - Dimension of the matrix, see is_ntt_compatible.
+ * @param prime_field - Prime field to use for generating random values.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE generate_circulant_encryption_column(int64_t** out_column, uint32_t dimension, uint32_t prime_field);
+
+/**
+ * @brief Generates a decryption matrix from encryption matrix, used when the inverse was not kept from key generation.
  *
  * @param out_matrix - Pointer to the output matrix - allocated inside the function and memory released if fails.
  * @param dimension - Dimension of the square matrix.
@@ -62,7 +74,7 @@ STATUS_CODE generate_decryption_matrix(int64_t*** out_matrix, uint32_t dimension
 void free_secrets(Secrets* secrets);
 
 /**
- * @brief Generates all necessary secrets for encryption.
+ * @brief Generates all necessary secrets for encryption, from a fresh seed when args->seeded_key is set (see build_encryption_secrets_from_seed).
  *
  * @param out_secrets - Pointer to the output Secrets structure - allocated inside the function and memory released if fails.
  * @param args - Key generation arguments containing parameters for secret generation.
@@ -70,8 +82,21 @@ void free_secrets(Secrets* secrets);
  */
 STATUS_CODE build_encryption_secrets(Secrets** out_secrets, const KeyGenerationArguments *args);
 
+/**
+ * @brief Deterministically generates the encryption secrets of a seed, all generation routines draw from a ChaCha20 stream under it.
+ *        The seed is kept in the secrets, so they serialize to the compact seeded key format.
+ *
+ * @param out_secrets - Pointer to the output Secrets structure - allocated inside the function and memory released if fails.
+ * @param args - Key generation arguments containing parameters for secret generation.
+ * @param seed - The seed, RANDOM_SEED_SIZE bytes.
+ * @param with_inverse_key_matrix - Whether to produce the inverse of a dense key alongside, only needed to build decryption secrets.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE build_encryption_secrets_from_seed(Secrets** out_secrets, const KeyGenerationArguments *args, const uint8_t* seed, bool with_inverse_key_matrix);
+
 /**
  * @brief Generates all necessary secrets for decryption based on encryption secrets.
+ *        Mapped keys swap their key matrix with the stored inverse, nothing is inverted.
  *
  * @param out_secrets - Pointer to the output Secrets structure - allocated inside the function and memory released if fails.
  * @param encryption_secrets - Pointer to the encryption Secrets structure **which is modified in this function**.
@@ -0,0 +1,59 @@
+#ifndef SEEDED_SECRETS_H
+#define SEEDED_SECRETS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+#include "Secrets.h"
+#include "Secrets/SecretsGeneration.h"
+#include "Math/NumberTheoreticTransform.h"
+#include "Instrumentation/Metrics.h"
+
+/**
+ * Seeded key file: the key parameters and the seed, every other member is regenerated on load.
+ * The words are native endian like the full key format, whose first word is its own magic or the dimension of a headerless key.
+ *
+ * | magic | version | flags | dimension | error vectors | prime field | letters per digit | seed (RANDOM_SEED_SIZE bytes) |
+ */
+#define SEEDED_KEY_MAGIC (0x4B534348u) // "HCSK"
+#define SEEDED_KEY_VERSION (1) // Bound to the generation routines, a change in what they draw needs a new version
+#define SEEDED_KEY_FLAG_CIRCULANT ((uint32_t)1 << 0)
+#define SEEDED_KEY_FLAG_DECRYPTION ((uint32_t)1 << 1)
+#define SEEDED_KEY_KNOWN_FLAGS (SEEDED_KEY_FLAG_CIRCULANT | SEEDED_KEY_FLAG_DECRYPTION)
+#define NUMBER_OF_UINT32_SEEDED_KEY_FIELDS (7)
+#define SEEDED_KEY_SIZE ((sizeof(uint32_t) * NUMBER_OF_UINT32_SEEDED_KEY_FIELDS) + RANDOM_SEED_SIZE)
+
+/**
+ * @brief Checks whether serialized key data is in the seeded key format.
+ *
+ * @param data - The serialized key.
+ * @param size - The size of the serialized key.
+ * @return true if the data holds a seeded key.
+ */
+bool is_seeded_key_data(const uint8_t* data, uint32_t size);
+
+/**
+ * @brief Serialize secrets that carry a key seed to the seeded key format.
+ *
+ * @param out_data - A pointer to an output vector.
+ * @param out_size - A pointer to the size of the output vector.
+ * @param secrets - The secrets to be serialized, key_seed must be set.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE serialize_seeded_secrets(uint8_t** out_data, uint32_t* out_size, Secrets secrets);
+
+/**
+ * @brief Deserialize a seeded key by regenerating its secrets from the seed, decryption keys are inverted after regeneration.
+ *
+ * @param out_secrets - A pointer to an output Secrets.
+ * @param data - The data to be deserialized.
+ * @param size - The size of the data.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE deserialize_seeded_secrets(Secrets* out_secrets, const uint8_t* data, uint32_t size);
+
+#endif //SEEDED_SECRETS_H
@@ -35,6 +35,13 @@ enum STATUS_CODE
 	STATUS_CODE_OUTPUT_FILE_NOT_TEXT,
 	STATUS_CODE_ERROR_INVALID_SIZE,
 	STATUS_CODE_CONVERSION_FAILED,
+	STATUS_CODE_PERFORMANCE_REGRESSION,
+	STATUS_CODE_COULDNT_START_THREAD,
+	STATUS_CODE_BATCH_FILES_FAILED,
+	STATUS_CODE_PIPELINE_ABORTED,
+	STATUS_CODE_SHARDS_FAILED,
+	STATUS_CODE_INVALID_SHARD_CONTAINER,
+	STATUS_CODE_UNSUPPORTED_KEY_FORMAT,
 
 	NUMBER_OF_STATUS_CODES
 	
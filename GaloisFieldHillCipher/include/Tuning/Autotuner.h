@@ -0,0 +1,116 @@
+#ifndef AUTOTUNER_H
+#define AUTOTUNER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StatusCodes.h"
+#include "log.h"
+#include "Math/FieldElement.h"
+#include "Cipher/CipherParts/BlockLoop.h"
+#include "Instrumentation/StageTimers.h"
+
+#define CPU_MODEL_NAME_SIZE (128)
+#define TUNING_CACHE_LINE_SIZE (512)
+#define TUNING_CACHE_SEPARATOR ';'
+#define TUNING_CACHE_COMMENT '#'
+#define TUNING_CACHE_HEADER "# cpu_model;hardware_threads;dimension;prime_field;kernel;blocks_per_batch;threads\n"
+
+#define AUTOTUNE_MULTIPLY_ADDS_PER_SAMPLE (1u << 24) // Roughly 10ms of a single core per measurement
+#define AUTOTUNE_MINIMAL_SAMPLE_BLOCKS (8)
+#define AUTOTUNE_MAXIMAL_SAMPLE_BLOCKS (1u << 16)
+#define AUTOTUNE_REPETITIONS (2) // After one warm up run, the fastest repetition counts
+#define AUTOTUNE_MAXIMAL_THREADS (16)
+
+/**
+ * The key a tuned configuration is valid for, the host is part of it since the fleet mixes CPU generations.
+ */
+struct TuningKey {
+    char cpu_model[CPU_MODEL_NAME_SIZE];
+    uint32_t hardware_threads;
+    uint32_t dimension;
+    uint32_t prime_field;
+} typedef TuningKey;
+
+/**
+ * @brief Reads the CPU model name, from the CPUID brand string on x86 and from /proc/cpuinfo elsewhere.
+ *        Separators and line breaks are replaced so the name fits a tuning cache line.
+ *
+ * @param out_name - Output buffer for the name, "unknown" if it can't be read.
+ * @param size - Size of the output buffer.
+ */
+void get_cpu_model_name(char* out_name, size_t size);
+
+/**
+ * @brief Gets the number of hardware threads available to the process.
+ *
+ * @return The number of hardware threads, at least 1.
+ */
+uint32_t get_number_of_hardware_threads(void);
+
+/**
+ * @brief Builds the tuning key of the current host for a key shape.
+ *
+ * @param out_key - Pointer to the output key.
+ * @param dimension - The key dimension.
+ * @param prime_field - The prime field.
+ */
+void get_host_tuning_key(TuningKey* out_key, uint32_t dimension, uint32_t prime_field);
+
+/**
+ * @brief Microbenchmarks block loop variants for a key shape on the current host and picks the fastest.
+ *        Kernels and batch sizes are measured on a single thread first, the winner is then scaled over threads.
+ *
+ * @param out_configuration - Pointer to the fastest configuration.
+ * @param dimension - The key dimension.
+ * @param prime_field - The prime field.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE autotune_block_loop(BlockLoopConfiguration* out_configuration, uint32_t dimension, uint32_t prime_field);
+
+/**
+ * @brief Looks a tuned configuration up in a tuning cache file, the last matching line wins.
+ *
+ * @param out_configuration - Pointer to the output configuration, untouched if not found.
+ * @param out_found - Set to true if the cache holds a configuration for the key.
+ * @param cache_path - Path of the tuning cache, a missing file holds no configuration.
+ * @param key - The tuning key to look up.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE load_tuned_block_loop_configuration(BlockLoopConfiguration* out_configuration, bool* out_found, const char* cache_path, const TuningKey* key);
+
+/**
+ * @brief Appends a tuned configuration to a tuning cache file, creating it if needed.
+ *        The file is locked for the append, processes sharing the cache don't interleave their lines.
+ *
+ * @param cache_path - Path of the tuning cache.
+ * @param key - The tuning key the configuration is valid for.
+ * @param configuration - The tuned configuration.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE store_tuned_block_loop_configuration(const char* cache_path, const TuningKey* key, const BlockLoopConfiguration* configuration);
+
+/**
+ * @brief Sets the tuning cache used by get_block_loop_configuration, tuning is disabled while it is NULL.
+ *
+ * @param cache_path - Path of the tuning cache, must outlive the cipher operations, may be NULL.
+ */
+void set_tuning_cache_file(const char* cache_path);
+
+/**
+ * @brief Gets the block loop configuration to encrypt or decrypt with for a key shape.
+ *        Without a tuning cache this is the default configuration, otherwise the cached configuration of this host,
+ *        autotuned and appended to the cache on the first run for the key shape.
+ *        Thread safe, concurrent callers wait for a single tuning instead of measuring the shape again.
+ *
+ * @param out_configuration - Pointer to the output configuration.
+ * @param dimension - The key dimension.
+ * @param prime_field - The prime field.
+ * @return STATUS_CODE - Status of the operation.
+ */
+STATUS_CODE get_block_loop_configuration(BlockLoopConfiguration* out_configuration, uint32_t dimension, uint32_t prime_field);
+
+#endif //AUTOTUNER_H
@@ -0,0 +1,707 @@
+#include "Cipher/BatchProcessing.h"
+
+#include <sys/stat.h>
+
+#include "Cipher/Cipher.h"
+#include "IO/FileOperations.h"
+#include "IO/FileValidation.h"
+#include "IO/SerDes.h"
+#include "Instrumentation/StageTimers.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <pthread.h>
+#endif
+
+#ifdef _WIN32
+typedef CRITICAL_SECTION BatchMutex;
+typedef CONDITION_VARIABLE BatchCondition;
+typedef HANDLE BatchThread;
+#define ATOMIC_FETCH_ADD(pointer, value) ((uint64_t)InterlockedExchangeAdd64((volatile LONG64*)(pointer), (LONG64)(value)))
+#else
+typedef pthread_mutex_t BatchMutex;
+typedef pthread_cond_t BatchCondition;
+typedef pthread_t BatchThread;
+#define ATOMIC_FETCH_ADD(pointer, value) __atomic_fetch_add((pointer), (value), __ATOMIC_ACQ_REL)
+#endif
+
+struct BatchScheduler {
+    BatchMutex mutex;
+    BatchCondition memory_released;
+    BatchJobList* jobs;
+    const BatchConfiguration* configuration;
+    KeyStore* key_store;
+    uint64_t next_job; // Atomic, workers take jobs in manifest order
+    size_t in_flight_bytes; // Under the mutex
+    size_t peak_in_flight_bytes;
+} typedef BatchScheduler;
+
+static void lock_batch_scheduler(BatchScheduler* scheduler)
+{
+#ifdef _WIN32
+    EnterCriticalSection(&scheduler->mutex);
+#else
+    pthread_mutex_lock(&scheduler->mutex);
+#endif
+}
+
+static void unlock_batch_scheduler(BatchScheduler* scheduler)
+{
+#ifdef _WIN32
+    LeaveCriticalSection(&scheduler->mutex);
+#else
+    pthread_mutex_unlock(&scheduler->mutex);
+#endif
+}
+
+static void reserve_batch_memory(BatchScheduler* scheduler, size_t size)
+{
+    lock_batch_scheduler(scheduler);
+    // A file that doesn't fit the budget waits until it runs alone rather than failing
+    while ((0 != scheduler->in_flight_bytes) && (scheduler->in_flight_bytes + size > scheduler->configuration->in_flight_byte_budget))
+    {
+#ifdef _WIN32
+        SleepConditionVariableCS(&scheduler->memory_released, &scheduler->mutex, INFINITE);
+#else
+        pthread_cond_wait(&scheduler->memory_released, &scheduler->mutex);
+#endif
+    }
+    scheduler->in_flight_bytes += size;
+    if (scheduler->in_flight_bytes > scheduler->peak_in_flight_bytes)
+    {
+        scheduler->peak_in_flight_bytes = scheduler->in_flight_bytes;
+    }
+    unlock_batch_scheduler(scheduler);
+}
+
+static void release_batch_memory(BatchScheduler* scheduler, size_t size)
+{
+    lock_batch_scheduler(scheduler);
+    scheduler->in_flight_bytes -= size;
+#ifdef _WIN32
+    WakeAllConditionVariable(&scheduler->memory_released);
+#else
+    pthread_cond_broadcast(&scheduler->memory_released);
+#endif
+    unlock_batch_scheduler(scheduler);
+}
+
+static char* duplicate_batch_string(const char* string)
+{
+    size_t length = strlen(string);
+    char* duplicate = (char*)malloc(length + 1);
+
+    if (NULL != duplicate)
+    {
+        memcpy(duplicate, string, length + 1);
+    }
+    return duplicate;
+}
+
+static char* join_batch_path(const char* directory, const char* name)
+{
+    size_t directory_length = strlen(directory), name_length = strlen(name);
+    bool needs_separator = (0 != directory_length) && ('/' != directory[directory_length - 1]) && ('\\' != directory[directory_length - 1]);
+    char* path = (char*)malloc(directory_length + (needs_separator ? 1 : 0) + name_length + 1);
+
+    if (NULL == path)
+    {
+        return NULL;
+    }
+
+    memcpy(path, directory, directory_length);
+    if (needs_separator)
+    {
+        path[directory_length++] = BATCH_PATH_SEPARATOR;
+    }
+    memcpy(path + directory_length, name, name_length + 1);
+    return path;
+}
+
+static STATUS_CODE append_batch_job(BatchJobList* jobs, char* input_file, char* output_file, const char* key_file)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    BatchJob* grown_jobs = NULL;
+    BatchJob* job = NULL;
+    char* job_key_file = NULL;
+    uint32_t capacity = 0;
+
+    if ((NULL == input_file) || (NULL == output_file) || (NULL == key_file))
+    {
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    if (jobs->number_of_jobs == jobs->capacity)
+    {
+        capacity = (0 == jobs->capacity) ? BATCH_INITIAL_JOB_CAPACITY : (2 * jobs->capacity);
+        grown_jobs = (BatchJob*)realloc(jobs->jobs, capacity * sizeof(BatchJob));
+        if (NULL == grown_jobs)
+        {
+            log_error("[!] Memory allocation failed for batch jobs");
+            return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+            goto cleanup;
+        }
+        jobs->jobs = grown_jobs;
+        jobs->capacity = capacity;
+    }
+
+    job_key_file = duplicate_batch_string(key_file);
+    if (NULL == job_key_file)
+    {
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    job = &jobs->jobs[jobs->number_of_jobs++];
+    memset(job, 0, sizeof(*job));
+    job->input_file = input_file;
+    job->output_file = output_file;
+    job->key_file = job_key_file;
+    job->status = STATUS_CODE_UNINITIALIZED;
+    input_file = NULL;
+    output_file = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free(input_file);
+    free(output_file);
+    return return_code;
+}
+
+static int compare_batch_jobs_by_input(const void* first, const void* second)
+{
+    return strcmp(((const BatchJob*)first)->input_file, ((const BatchJob*)second)->input_file);
+}
+
+static char* get_next_manifest_field(char** cursor, const char* separators)
+{
+    char* field = *cursor + strspn(*cursor, separators);
+    char* end = NULL;
+
+    if ('\0' == *field)
+    {
+        *cursor = field;
+        return NULL;
+    }
+
+    end = field + strcspn(field, separators);
+    *cursor = ('\0' == *end) ? end : (end + 1);
+    *end = '\0';
+    return field;
+}
+
+STATUS_CODE read_batch_manifest(BatchJobList* out_jobs, const char* manifest_file, const char* default_key_file)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    BatchJobList jobs = {0};
+    uint8_t* manifest = NULL;
+    uint32_t manifest_size = 0, line_number = 0;
+    char* text = NULL;
+    char* line = NULL;
+    char* next_line = NULL;
+    char* cursor = NULL;
+    char* fields[3] = {NULL};
+    const char* separators = NULL;
+    size_t number_of_fields = 0, line_length = 0;
+
+    if ((NULL == out_jobs) || (NULL == manifest_file))
+    {
+        log_error("[!] Invalid arguments in read_batch_manifest");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    return_code = read_uint8_from_file(&manifest, &manifest_size, manifest_file);
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("[!] Failed to read batch manifest %s", manifest_file);
+        goto cleanup;
+    }
+
+    text = (char*)malloc((size_t)manifest_size + 1);
+    if (NULL == text)
+    {
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    memcpy(text, manifest, manifest_size);
+    text[manifest_size] = '\0';
+
+    for (line = text; NULL != line; line = next_line)
+    {
+        ++line_number;
+        next_line = strchr(line, '\n');
+        if (NULL != next_line)
+        {
+            *next_line++ = '\0';
+        }
+        line_length = strlen(line);
+        if ((0 != line_length) && ('\r' == line[line_length - 1]))
+        {
+            line[line_length - 1] = '\0';
+        }
+
+        cursor = line + strspn(line, BATCH_MANIFEST_FIELD_SEPARATORS);
+        if (('\0' == *cursor) || (BATCH_MANIFEST_COMMENT_CHARACTER == *cursor))
+        {
+            continue;
+        }
+
+        separators = (NULL != strchr(cursor, '\t')) ? BATCH_MANIFEST_TAB_SEPARATOR : BATCH_MANIFEST_FIELD_SEPARATORS;
+        for (number_of_fields = 0; number_of_fields < 3; ++number_of_fields)
+        {
+            fields[number_of_fields] = get_next_manifest_field(&cursor, separators);
+            if (NULL == fields[number_of_fields])
+            {
+                break;
+            }
+        }
+
+        if ((number_of_fields < 2) || (NULL != get_next_manifest_field(&cursor, separators)) ||
+            ((2 == number_of_fields) && (NULL == default_key_file)))
+        {
+            log_error("[!] Invalid batch manifest line %u in %s, expected \"input output key\"%s",
+                      line_number, manifest_file, (NULL == default_key_file) ? "" : " or \"input output\"");
+            return_code = STATUS_CODE_INVALID_ARGUMENT;
+            goto cleanup;
+        }
+
+        return_code = append_batch_job(&jobs, duplicate_batch_string(fields[0]), duplicate_batch_string(fields[1]),
+                                       (3 == number_of_fields) ? fields[2] : default_key_file);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+    }
+
+    log_info("Read %u files from batch manifest %s", jobs.number_of_jobs, manifest_file);
+
+    *out_jobs = jobs;
+    memset(&jobs, 0, sizeof(jobs));
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free_batch_jobs(&jobs);
+    free(text);
+    free(manifest);
+    return return_code;
+}
+
+STATUS_CODE list_batch_directory(BatchJobList* out_jobs, const char* input_directory, const char* output_directory, const char* key_file)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    BatchJobList jobs = {0};
+    char* input_file = NULL;
+#ifdef _WIN32
+    WIN32_FIND_DATAA entry;
+    HANDLE directory = INVALID_HANDLE_VALUE;
+    char* pattern = NULL;
+#else
+    DIR* directory = NULL;
+    struct dirent* entry = NULL;
+    struct stat file_status;
+#endif
+
+    if ((NULL == out_jobs) || (NULL == input_directory) || (NULL == output_directory) || (NULL == key_file))
+    {
+        log_error("[!] Invalid arguments in list_batch_directory");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+#ifdef _WIN32
+    pattern = join_batch_path(input_directory, "*");
+    if (NULL == pattern)
+    {
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    directory = FindFirstFileA(pattern, &entry);
+    if (INVALID_HANDLE_VALUE == directory)
+    {
+        log_error("[!] Failed to list batch directory %s", input_directory);
+        return_code = STATUS_CODE_COULDNT_OPEN_FILE;
+        goto cleanup;
+    }
+
+    do
+    {
+        if (0 != (entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+        {
+            continue;
+        }
+        return_code = append_batch_job(&jobs, join_batch_path(input_directory, entry.cFileName),
+                                       join_batch_path(output_directory, entry.cFileName), key_file);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+    } while (FindNextFileA(directory, &entry));
+#else
+    directory = opendir(input_directory);
+    if (NULL == directory)
+    {
+        log_error("[!] Failed to list batch directory %s", input_directory);
+        return_code = STATUS_CODE_COULDNT_OPEN_FILE;
+        goto cleanup;
+    }
+
+    while (NULL != (entry = readdir(directory)))
+    {
+        input_file = join_batch_path(input_directory, entry->d_name);
+        if (NULL == input_file)
+        {
+            return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+            goto cleanup;
+        }
+        // Subdirectories, links to them and special files are not processed
+        if ((0 != stat(input_file, &file_status)) || !S_ISREG(file_status.st_mode))
+        {
+            free(input_file);
+            input_file = NULL;
+            continue;
+        }
+
+        return_code = append_batch_job(&jobs, input_file, join_batch_path(output_directory, entry->d_name), key_file);
+        input_file = NULL;
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+    }
+#endif
+
+    // Directory order depends on the file system, reports are easier to compare sorted
+    if (0 != jobs.number_of_jobs)
+    {
+        qsort(jobs.jobs, jobs.number_of_jobs, sizeof(BatchJob), compare_batch_jobs_by_input);
+    }
+    log_info("Listed %u files in batch directory %s", jobs.number_of_jobs, input_directory);
+
+    *out_jobs = jobs;
+    memset(&jobs, 0, sizeof(jobs));
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+#ifdef _WIN32
+    if (INVALID_HANDLE_VALUE != directory)
+    {
+        FindClose(directory);
+    }
+    free(pattern);
+#else
+    if (NULL != directory)
+    {
+        closedir(directory);
+    }
+#endif
+    free(input_file);
+    free_batch_jobs(&jobs);
+    return return_code;
+}
+
+void free_batch_jobs(BatchJobList* jobs)
+{
+    uint32_t job = 0;
+
+    if (NULL == jobs)
+    {
+        return;
+    }
+
+    for (job = 0; job < jobs->number_of_jobs; ++job)
+    {
+        free(jobs->jobs[job].input_file);
+        free(jobs->jobs[job].output_file);
+        free(jobs->jobs[job].key_file);
+    }
+    free(jobs->jobs);
+    memset(jobs, 0, sizeof(*jobs));
+}
+
+static STATUS_CODE get_batch_file_size(uint32_t* out_size, const char* filepath)
+{
+    struct stat file_status;
+
+    if (0 != stat(filepath, &file_status))
+    {
+        log_error("[!] Input file does not exist or is not readable: %s", filepath);
+        return STATUS_CODE_INPUT_FILE_DOESNT_EXISTS_OR_NOT_READBLE;
+    }
+    if ((uint64_t)file_status.st_size > UINT32_MAX)
+    {
+        log_error("[!] Input file %s is larger than 4GB", filepath);
+        return STATUS_CODE_ERROR_INVALID_FILE_SIZE;
+    }
+
+    *out_size = (uint32_t)file_status.st_size;
+    return STATUS_CODE_SUCCESS;
+}
+
+static size_t estimate_batch_job_memory(const CipherContext* context, BATCH_DIRECTION direction, CIPHERTEXT_FORMAT format, uint32_t input_size)
+{
+    const Secrets* secrets = &context->secrets;
+    uint64_t expanded_size = 0, number_of_blocks = 0, element_size = 0;
+
+    // A plaintext is never larger than its ciphertext
+    if (BATCH_DIRECTION_DECRYPT == direction)
+    {
+        return 2 * (size_t)input_size;
+    }
+
+    // The ciphertext size is known upfront, as in encrypt_and_serialize_with_context
+    element_size = (CIPHERTEXT_FORMAT_BINARY == format) ? calculate_bytes_per_element(secrets->prime_field) :
+                                                          calculate_digits_per_element(secrets->prime_field);
+    expanded_size = (((uint64_t)input_size * (BYTE_SIZE + secrets->number_of_random_bits_to_add)) + BYTE_SIZE - 1) / BYTE_SIZE;
+    number_of_blocks = (expanded_size / secrets->dimension) + 1;
+    return (size_t)input_size + (size_t)(number_of_blocks * secrets->dimension * element_size) + 1;
+}
+
+static void report_batch_job(BatchScheduler* scheduler, const BatchJob* job)
+{
+    FILE* output = scheduler->configuration->status_output;
+
+    if (STATUS_SUCCESS(job->status))
+    {
+        log_info("Batch file %s -> %s done, %u -> %u bytes", job->input_file, job->output_file, job->input_size, job->output_size);
+    }
+    else
+    {
+        log_error("[!] Batch file %s -> %s failed with status %d", job->input_file, job->output_file, (int)job->status);
+    }
+
+    if (NULL == output)
+    {
+        return;
+    }
+
+    // One call per line, so lines of different workers don't interleave
+    if (STATUS_SUCCESS(job->status))
+    {
+        fprintf(output, "[+] %s -> %s: %u -> %u bytes in %.3f ms\n", job->input_file, job->output_file,
+                job->input_size, job->output_size, (double)job->elapsed_ns / NANOSECONDS_IN_MILLISECOND);
+    }
+    else
+    {
+        fprintf(output, "[!] %s -> %s: failed with status %d\n", job->input_file, job->output_file, (int)job->status);
+    }
+}
+
+static STATUS_CODE process_batch_job(BatchScheduler* scheduler, BatchJob* job)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    BATCH_DIRECTION direction = scheduler->configuration->direction;
+    const CipherContext* context = NULL;
+    CIPHERTEXT_FORMAT format = CIPHERTEXT_FORMAT_BINARY;
+    uint8_t* input = NULL;
+    uint8_t* output = NULL;
+    uint32_t input_size = 0, output_size = 0;
+    size_t reserved_size = 0;
+    uint64_t stage_start_time = 0;
+
+    return_code = acquire_key_store_context_from_file(&context, scheduler->key_store, job->key_file);
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("[!] Failed to load key %s", job->key_file);
+        goto cleanup;
+    }
+
+    return_code = get_batch_file_size(&input_size, job->input_file);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    format = STATUS_SUCCESS(validate_file_is_binary((BATCH_DIRECTION_ENCRYPT == direction) ? job->output_file : job->input_file)) ?
+        CIPHERTEXT_FORMAT_BINARY : CIPHERTEXT_FORMAT_TEXT;
+    reserved_size = estimate_batch_job_memory(context, direction, format, input_size);
+    reserve_batch_memory(scheduler, reserved_size);
+
+    stage_start_time = start_stage_timer();
+    return_code = read_uint8_from_file(&input, &input_size, job->input_file);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    stop_stage_timer(PIPELINE_STAGE_READ, stage_start_time, input_size);
+    increase_metric_counter(METRIC_COUNTER_BYTES_IN, input_size);
+    job->input_size = input_size;
+
+    return_code = (BATCH_DIRECTION_ENCRYPT == direction) ?
+        encrypt_and_serialize_with_context(&output, &output_size, input, input_size, context, format) :
+        deserialize_and_decrypt_with_context(&output, &output_size, input, input_size, context, format);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    stage_start_time = start_stage_timer();
+    return_code = write_uint8_to_file(job->output_file, output, output_size);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    stop_stage_timer(PIPELINE_STAGE_WRITE, stage_start_time, output_size);
+    increase_metric_counter(METRIC_COUNTER_BYTES_OUT, output_size);
+    job->output_size = output_size;
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free(input);
+    free(output);
+    if (0 != reserved_size)
+    {
+        release_batch_memory(scheduler, reserved_size);
+    }
+    release_key_store_context(context);
+    return return_code;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI batch_worker(LPVOID argument)
+#else
+static void* batch_worker(void* argument)
+#endif
+{
+    BatchScheduler* scheduler = (BatchScheduler*)argument;
+    BatchJob* job = NULL;
+    uint64_t job_index = 0;
+    uint64_t start_time = 0;
+
+    for (;;)
+    {
+        job_index = ATOMIC_FETCH_ADD(&scheduler->next_job, 1);
+        if (job_index >= scheduler->jobs->number_of_jobs)
+        {
+            break;
+        }
+
+        job = &scheduler->jobs->jobs[job_index];
+        start_time = get_monotonic_time_ns();
+        job->status = process_batch_job(scheduler, job);
+        job->elapsed_ns = get_monotonic_time_ns() - start_time;
+        report_batch_job(scheduler, job);
+    }
+
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+STATUS_CODE run_batch(BatchSummary* out_summary, BatchJobList* jobs, const BatchConfiguration* configuration)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    BatchScheduler scheduler;
+    BatchSummary summary;
+    BatchThread* threads = NULL;
+    bool is_scheduler_initialized = false;
+    uint32_t number_of_threads = 0, number_of_started_threads = 0, thread = 0, job = 0;
+    uint64_t start_time = get_monotonic_time_ns();
+
+    memset(&scheduler, 0, sizeof(scheduler));
+    memset(&summary, 0, sizeof(summary));
+
+    if ((NULL == out_summary) || (NULL == jobs) || ((0 != jobs->number_of_jobs) && (NULL == jobs->jobs)) || (NULL == configuration) ||
+        (configuration->direction >= NUMBER_OF_BATCH_DIRECTIONS) || (0 == configuration->number_of_threads) ||
+        (0 == configuration->in_flight_byte_budget) || (0 == configuration->key_store_byte_budget))
+    {
+        log_error("[!] Invalid arguments in run_batch");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    scheduler.jobs = jobs;
+    scheduler.configuration = configuration;
+    return_code = create_key_store(&scheduler.key_store, configuration->key_store_byte_budget);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+#ifdef _WIN32
+    InitializeCriticalSection(&scheduler.mutex);
+    InitializeConditionVariable(&scheduler.memory_released);
+#else
+    pthread_mutex_init(&scheduler.mutex, NULL);
+    pthread_cond_init(&scheduler.memory_released, NULL);
+#endif
+    is_scheduler_initialized = true;
+
+    // The calling thread works too, only the others are started
+    number_of_threads = (configuration->number_of_threads < jobs->number_of_jobs) ? configuration->number_of_threads : jobs->number_of_jobs;
+    if (number_of_threads > 1)
+    {
+        threads = (BatchThread*)malloc((number_of_threads - 1) * sizeof(BatchThread));
+        if (NULL == threads)
+        {
+            log_error("[!] Memory allocation failed for batch threads");
+            return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+            goto cleanup;
+        }
+    }
+
+    log_info("Running a batch of %u files on %u threads", jobs->number_of_jobs, (0 == number_of_threads) ? 1 : number_of_threads);
+
+    for (thread = 1; thread < number_of_threads; ++thread)
+    {
+#ifdef _WIN32
+        threads[number_of_started_threads] = CreateThread(NULL, 0, batch_worker, &scheduler, 0, NULL);
+        if (NULL == threads[number_of_started_threads])
+#else
+        if (0 != pthread_create(&threads[number_of_started_threads], NULL, batch_worker, &scheduler))
+#endif
+        {
+            // The threads that did start, and this one, still finish the batch
+            log_warn("Failed to start batch worker thread, running on %u threads", number_of_started_threads + 1);
+            break;
+        }
+        ++number_of_started_threads;
+    }
+
+    (void)batch_worker(&scheduler);
+
+    for (thread = 0; thread < number_of_started_threads; ++thread)
+    {
+#ifdef _WIN32
+        WaitForSingleObject(threads[thread], INFINITE);
+        CloseHandle(threads[thread]);
+#else
+        pthread_join(threads[thread], NULL);
+#endif
+    }
+
+    for (job = 0; job < jobs->number_of_jobs; ++job)
+    {
+        if (STATUS_SUCCESS(jobs->jobs[job].status))
+        {
+            ++summary.succeeded;
+            summary.bytes_in += jobs->jobs[job].input_size;
+            summary.bytes_out += jobs->jobs[job].output_size;
+        }
+        else
+        {
+            ++summary.failed;
+        }
+    }
+    summary.elapsed_ns = get_monotonic_time_ns() - start_time;
+    summary.peak_in_flight_bytes = scheduler.peak_in_flight_bytes;
+    get_key_store_statistics(&summary.key_store_statistics, scheduler.key_store);
+
+    *out_summary = summary;
+    return_code = (0 == summary.failed) ? STATUS_CODE_SUCCESS : STATUS_CODE_BATCH_FILES_FAILED;
+cleanup:
+    if (is_scheduler_initialized)
+    {
+#ifdef _WIN32
+        DeleteCriticalSection(&scheduler.mutex);
+#else
+        pthread_mutex_destroy(&scheduler.mutex);
+        pthread_cond_destroy(&scheduler.memory_released);
+#endif
+    }
+    free(threads);
+    free_key_store(scheduler.key_store);
+    return return_code;
+}
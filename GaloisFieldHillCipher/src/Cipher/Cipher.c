@@ -1,5 +1,7 @@
 #include "Cipher/Cipher.h"
 
+#include "Parsing/ArgumentParser.h"
+
 STATUS_CODE encrypt(int64_t** out_ciphertext, uint32_t* out_ciphertext_bit_size, uint8_t* plaintext_vector, uint32_t vector_bit_size, Secrets secrets)
 {
 	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
@@ -14,6 +16,7 @@ STATUS_CODE encrypt(int64_t** out_ciphertext, uint32_t* out_ciphertext_bit_size,
 	int64_t* ciphertext_block = NULL;
 	int64_t* ciphertext_buffer = NULL;
 	int64_t* original_hill_cipher_block = NULL;
+	uint64_t stage_start_time = 0;
 
 	if ((secrets.dimension > (UINT32_MAX / BYTE_SIZE)) || (NULL == out_ciphertext) ||
         (NULL == out_ciphertext_bit_size) || (NULL == plaintext_vector) ||
@@ -32,6 +35,7 @@ STATUS_CODE encrypt(int64_t** out_ciphertext, uint32_t* out_ciphertext_bit_size,
 
     log_info("Starting encryption: dimension=%u, input_size=%u bits", secrets.dimension, vector_bit_size);
 
+    stage_start_time = start_stage_timer();
     return_code = add_random_bits_between_bytes(&random_inserted_plaintext,
         &random_inserted_plaintext_bit_size, plaintext_vector, vector_bit_size,
         secrets.number_of_random_bits_to_add);
@@ -40,9 +44,11 @@ STATUS_CODE encrypt(int64_t** out_ciphertext, uint32_t* out_ciphertext_bit_size,
 		log_error("[!] Failed to add random bits between bytes");
 		goto cleanup;
 	}
+	stop_stage_timer(PIPELINE_STAGE_RANDOM_BIT_EXPANSION, stage_start_time, vector_bit_size / BYTE_SIZE);
 	log_debug("Added random bits: original_size=%u bits, new_size=%u bits",
              vector_bit_size, random_inserted_plaintext_bit_size);
 
+	stage_start_time = start_stage_timer();
 	return_code = pad_to_length(&padded_plaintext,
 		&padded_plaintext_bit_size,
 		random_inserted_plaintext,
@@ -54,6 +60,7 @@ STATUS_CODE encrypt(int64_t** out_ciphertext, uint32_t* out_ciphertext_bit_size,
 		log_error("[!] Failed to pad plaintext to block size");
 		goto cleanup;
 	}
+	stop_stage_timer(PIPELINE_STAGE_PADDING, stage_start_time, padded_plaintext_bit_size / BYTE_SIZE);
 	log_debug("Padded plaintext to length %u bits", padded_plaintext_bit_size);
 
 	return_code = divide_uint8_t_into_blocks(&plaintext_blocks, &number_of_blocks, padded_plaintext,
@@ -74,17 +81,21 @@ STATUS_CODE encrypt(int64_t** out_ciphertext, uint32_t* out_ciphertext_bit_size,
 
 	for (block_number = 0; block_number < number_of_blocks; ++block_number)
 	{
+		stage_start_time = start_stage_timer();
 		return_code = multiply_matrix_with_uint8_t_vector(&original_hill_cipher_block, secrets.key_matrix, plaintext_blocks[block_number], secrets.dimension, secrets.prime_field);
 		if (STATUS_FAILED(return_code))
 		{
 			goto cleanup;
 		}
+		stop_stage_timer(PIPELINE_STAGE_BLOCK_MULTIPLY, stage_start_time, secrets.dimension);
 
+		stage_start_time = start_stage_timer();
 		return_code = add_affine_transformation(&ciphertext_block, secrets.error_vectors, secrets.number_of_error_vectors, original_hill_cipher_block, secrets.dimension, secrets.prime_field);
 		if (STATUS_FAILED(return_code))
 		{
 			goto cleanup;
 		}
+		stop_stage_timer(PIPELINE_STAGE_AFFINE, stage_start_time, secrets.dimension * sizeof(int64_t));
 
 		for (copy_index = 0; copy_index < block_size_in_bits / BYTE_SIZE; ++copy_index)
 		{
@@ -95,6 +106,7 @@ STATUS_CODE encrypt(int64_t** out_ciphertext, uint32_t* out_ciphertext_bit_size,
 		free(ciphertext_block);
 	}
 
+	increase_metric_counter(METRIC_COUNTER_BLOCKS_ENCRYPTED, number_of_blocks);
 	*out_ciphertext = ciphertext_buffer;
 	ciphertext_buffer = NULL;
 	*out_ciphertext_bit_size = block_size_in_bits * number_of_blocks * sizeof(int64_t);
@@ -125,6 +137,7 @@ STATUS_CODE decrypt(uint8_t** out_plaintext, uint32_t* out_plaintext_bit_size, i
 	uint8_t* original_plaintext = NULL;
 	uint32_t original_plaintext_bit_size = 0;
 	int64_t* affine_subtracted_block = NULL;
+	uint64_t stage_start_time = 0;
 
 	if ((NULL == out_plaintext) || (NULL == out_plaintext_bit_size) || (NULL == ciphertext_vector) ||
         (NULL == secrets.key_matrix) || (NULL == secrets.error_vectors))
@@ -154,17 +167,21 @@ STATUS_CODE decrypt(uint8_t** out_plaintext, uint32_t* out_plaintext_bit_size, i
 
 	for (block_number = 0; block_number < number_of_blocks; ++block_number)
 	{
+		stage_start_time = start_stage_timer();
 		return_code = substruct_affine_transformation(&affine_subtracted_block, secrets.error_vectors, secrets.number_of_error_vectors, ciphertext_blocks[block_number], secrets.dimension, secrets.prime_field);
 		if (STATUS_FAILED(return_code))
 		{
 			goto cleanup;
 		}
+		stop_stage_timer(PIPELINE_STAGE_AFFINE, stage_start_time, secrets.dimension * sizeof(int64_t));
 
+		stage_start_time = start_stage_timer();
 		return_code = multiply_matrix_with_int64_t_vector(&plaintext_block, secrets.key_matrix, affine_subtracted_block, secrets.dimension, secrets.prime_field);
 		if (STATUS_FAILED(return_code))
 		{
 			goto cleanup;
 		}
+		stop_stage_timer(PIPELINE_STAGE_BLOCK_MULTIPLY, stage_start_time, secrets.dimension * sizeof(int64_t));
 		for (block_index = 0; block_index < (block_size_in_bits_aligned_to_uint8_t / BYTE_SIZE); ++block_index)
 		{
 			decrypted_plaintext_blocks[(block_number * secrets.dimension) + block_index] = plaintext_block[block_index];
@@ -175,6 +192,7 @@ STATUS_CODE decrypt(uint8_t** out_plaintext, uint32_t* out_plaintext_bit_size, i
 		affine_subtracted_block = NULL;
 	}
 
+	stage_start_time = start_stage_timer();
 	return_code = remove_padding(&unpadded_plaintext, &unpadded_plaintext_bit_size,
         decrypted_plaintext_blocks, vector_bit_size_aligned_to_uint8_t);
 	if (STATUS_FAILED(return_code))
@@ -182,8 +200,10 @@ STATUS_CODE decrypt(uint8_t** out_plaintext, uint32_t* out_plaintext_bit_size, i
 		log_error("[!] Failed to remove padding from decrypted plaintext");
 		goto cleanup;
 	}
+	stop_stage_timer(PIPELINE_STAGE_PADDING, stage_start_time, vector_bit_size_aligned_to_uint8_t / BYTE_SIZE);
 	log_debug("Removed padding: size after removal %u bits", unpadded_plaintext_bit_size);
 
+	stage_start_time = start_stage_timer();
 	return_code = remove_random_bits_between_bytes(&original_plaintext, &original_plaintext_bit_size,
         unpadded_plaintext, unpadded_plaintext_bit_size, secrets.number_of_random_bits_to_add);
     if (STATUS_FAILED(return_code))
@@ -191,8 +211,10 @@ STATUS_CODE decrypt(uint8_t** out_plaintext, uint32_t* out_plaintext_bit_size, i
         log_error("[!] Failed to remove random bits between bytes");
         goto cleanup;
     }
+	stop_stage_timer(PIPELINE_STAGE_RANDOM_BIT_EXPANSION, stage_start_time, unpadded_plaintext_bit_size / BYTE_SIZE);
     log_debug("Removed random bits: final plaintext size %u bits", original_plaintext_bit_size);
 
+	increase_metric_counter(METRIC_COUNTER_BLOCKS_DECRYPTED, number_of_blocks);
 	*out_plaintext = original_plaintext;
 	original_plaintext = NULL;
 	*out_plaintext_bit_size = original_plaintext_bit_size;
@@ -207,3 +229,1463 @@ cleanup:
 	(void)free_int64_matrix(ciphertext_blocks, number_of_blocks);
 	return return_code;
 }
+
+struct BitExpansionState {
+	uint64_t plaintext_byte;
+	uint32_t bit_in_group;
+} typedef BitExpansionState;
+
+static STATUS_CODE expand_next_byte(uint8_t* out_byte, BitExpansionState* state, const uint8_t* plaintext_vector, uint32_t plaintext_size, uint32_t number_of_random_bits, SecureRandomPool* random_pool)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+	uint8_t expanded_byte = 0, bit = 0;
+	size_t bit_number = 0;
+
+	// Each plaintext byte is followed by number_of_random_bits random bits, the stream is consumed MSB first
+	for (bit_number = 0; bit_number < BYTE_SIZE; ++bit_number)
+	{
+		if (state->plaintext_byte >= plaintext_size)
+		{
+			bit = 0;
+		}
+		else if (state->bit_in_group < BYTE_SIZE)
+		{
+			bit = (plaintext_vector[state->plaintext_byte] >> (BYTE_SIZE - 1 - state->bit_in_group)) & 1;
+		}
+		else
+		{
+			return_code = draw_secure_random_bit(&bit, random_pool);
+			if (STATUS_FAILED(return_code))
+			{
+				goto cleanup;
+			}
+		}
+
+		expanded_byte = (uint8_t)((expanded_byte << 1) | bit);
+		if (++state->bit_in_group == BYTE_SIZE + number_of_random_bits)
+		{
+			state->bit_in_group = 0;
+			++state->plaintext_byte;
+		}
+	}
+
+	*out_byte = expanded_byte;
+	return_code = STATUS_CODE_SUCCESS;
+cleanup:
+	return return_code;
+}
+
+STATUS_CODE expand_plaintext_chunk(uint8_t* out_expanded, size_t* out_expanded_size, const uint8_t* plaintext, size_t plaintext_size, uint32_t number_of_random_bits, SecureRandomPool* random_pool)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+	BitExpansionState expansion_state = {0};
+	size_t expanded_size = 0, byte_index = 0;
+
+	if ((NULL == out_expanded) || (NULL == out_expanded_size) || ((NULL == plaintext) && (0 != plaintext_size)) || (NULL == random_pool) ||
+		(plaintext_size > UINT32_MAX))
+	{
+		return_code = STATUS_CODE_INVALID_ARGUMENT;
+		goto cleanup;
+	}
+
+	expanded_size = ((plaintext_size * (BYTE_SIZE + number_of_random_bits)) + BYTE_SIZE - 1) / BYTE_SIZE;
+	if ((0 == number_of_random_bits) && (0 != plaintext_size))
+	{
+		memcpy(out_expanded, plaintext, plaintext_size);
+	}
+	else if (0 != number_of_random_bits)
+	{
+		for (byte_index = 0; byte_index < expanded_size; ++byte_index)
+		{
+			return_code = expand_next_byte(&out_expanded[byte_index], &expansion_state, plaintext, (uint32_t)plaintext_size, number_of_random_bits, random_pool);
+			if (STATUS_FAILED(return_code))
+			{
+				log_error("[!] Failed to add random bits between bytes");
+				goto cleanup;
+			}
+		}
+	}
+
+	*out_expanded_size = expanded_size;
+	return_code = STATUS_CODE_SUCCESS;
+cleanup:
+	return return_code;
+}
+
+static STATUS_CODE serialize_element_as_text(uint8_t* out_text, uint32_t value, uint8_t* digits_buffer, uint32_t digits_per_element, const Secrets* secrets, SecureRandomPool* random_pool)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+	uint32_t digit_index = 0, variant = 0;
+
+	for (digit_index = digits_per_element; digit_index > 0; --digit_index)
+	{
+		return_code = draw_secure_random_number(&variant, secrets->number_of_letters_for_each_digit_ascii_mapping, random_pool);
+		if (STATUS_FAILED(return_code))
+		{
+			goto cleanup;
+		}
+		digits_buffer[digit_index - 1] = secrets->ascii_mapping[value % DECIMAL_BASE][variant];
+		value /= DECIMAL_BASE;
+	}
+
+	for (digit_index = 0; digit_index < digits_per_element; ++digit_index)
+	{
+		out_text[digit_index] = digits_buffer[secrets->permutation_vector[digit_index]];
+	}
+
+	return_code = STATUS_CODE_SUCCESS;
+cleanup:
+	return return_code;
+}
+
+static STATUS_CODE deserialize_element_from_text(uint32_t* out_value, const uint8_t* text, uint32_t digits_per_element, const int8_t* ascii_to_digit_table, const uint8_t* permutation_vector)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+	uint32_t digit_index = 0;
+	int8_t digit = 0;
+	uint64_t value = 0;
+
+	for (digit_index = 0; digit_index < digits_per_element; ++digit_index)
+	{
+		digit = ascii_to_digit_table[text[permutation_vector[digit_index]]];
+		if (UNMAPPED_ASCII_CHARACTER == digit)
+		{
+			log_error("[!] No mapping found for ASCII character '%c' (0x%02x)", text[permutation_vector[digit_index]], text[permutation_vector[digit_index]]);
+			return_code = STATUS_CODE_CONVERSION_FAILED;
+			goto cleanup;
+		}
+		value = (value * DECIMAL_BASE) + (uint64_t)digit;
+	}
+
+	if (value > UINT32_MAX)
+	{
+		log_error("[!] Mapped ciphertext element out of range");
+		return_code = STATUS_CODE_CONVERSION_FAILED;
+		goto cleanup;
+	}
+
+	*out_value = (uint32_t)value;
+	return_code = STATUS_CODE_SUCCESS;
+cleanup:
+	return return_code;
+}
+
+STATUS_CODE serialize_ciphertext_chunk(uint8_t* out_serialized, const FieldVector* ciphertext_chunk, size_t chunk_elements, uint32_t element_size,
+	uint8_t* digits_buffer, const Secrets* secrets, SecureRandomPool* random_pool, CIPHERTEXT_FORMAT format)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+	FieldVector ciphertext_view = *ciphertext_chunk;
+	size_t row = 0;
+	uint64_t stage_start_time = start_stage_timer();
+
+	if (CIPHERTEXT_FORMAT_BINARY == format)
+	{
+		ciphertext_view.length = (uint32_t)chunk_elements;
+		return_code = serialize_field_vector(out_serialized, &ciphertext_view, element_size);
+		if (STATUS_FAILED(return_code))
+		{
+			goto cleanup;
+		}
+		stop_stage_timer(PIPELINE_STAGE_SERIALIZE, stage_start_time, (uint64_t)chunk_elements * element_size);
+	}
+	else
+	{
+		for (row = 0; row < chunk_elements; ++row)
+		{
+			return_code = serialize_element_as_text(out_serialized + (row * element_size), get_field_vector_element(ciphertext_chunk, row), digits_buffer, element_size, secrets, random_pool);
+			if (STATUS_FAILED(return_code))
+			{
+				log_error("[!] Failed to map ciphertext element to ASCII");
+				goto cleanup;
+			}
+		}
+		stop_stage_timer(PIPELINE_STAGE_MAPPING_PERMUTATION, stage_start_time, (uint64_t)chunk_elements * element_size);
+	}
+
+	return_code = STATUS_CODE_SUCCESS;
+cleanup:
+	return return_code;
+}
+
+static STATUS_CODE decrypt_serialized_chunk(uint8_t* out_expanded, const uint8_t* serialized_chunk, uint32_t blocks_in_chunk, FieldVector* ciphertext_chunk,
+	BlockLoop* block_loop, const BlockMultiplier* multiplier, const CipherContext* context, uint32_t element_size, CIPHERTEXT_FORMAT format)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+	const Secrets* secrets = &context->secrets;
+	const FieldVector* error_vector_in_use = &context->combined_error_vector;
+	const uint8_t* serialized_element = serialized_chunk;
+	size_t chunk_elements = (size_t)blocks_in_chunk * secrets->dimension;
+	size_t element_index = 0, row = 0;
+	FieldVector ciphertext_view = *ciphertext_chunk;
+	uint32_t value = 0;
+	uint64_t stage_start_time = 0;
+
+	ciphertext_view.length = (uint32_t)chunk_elements;
+	if (CIPHERTEXT_FORMAT_BINARY == format)
+	{
+		stage_start_time = start_stage_timer();
+		return_code = deserialize_field_vector(&ciphertext_view, serialized_element, element_size, secrets->prime_field);
+		if (STATUS_FAILED(return_code))
+		{
+			goto cleanup;
+		}
+		stop_stage_timer(PIPELINE_STAGE_SERIALIZE, stage_start_time, (uint64_t)chunk_elements * element_size);
+	}
+
+	// For text ciphertexts the row loop interleaves the ASCII mapping with the affine subtraction
+	stage_start_time = start_stage_timer();
+	for (element_index = 0, row = 0; element_index < chunk_elements; ++element_index, row = ((row + 1) == secrets->dimension) ? 0 : (row + 1))
+	{
+		if (CIPHERTEXT_FORMAT_BINARY == format)
+		{
+			value = get_field_vector_element(ciphertext_chunk, element_index);
+		}
+		else
+		{
+			return_code = deserialize_element_from_text(&value, serialized_element, element_size, context->ascii_to_digit_table, secrets->permutation_vector);
+			if (STATUS_FAILED(return_code))
+			{
+				goto cleanup;
+			}
+			serialized_element += element_size;
+			value %= secrets->prime_field;
+		}
+
+		set_field_vector_element(ciphertext_chunk, element_index, (uint32_t)(((uint64_t)value + secrets->prime_field -
+			get_field_vector_element(error_vector_in_use, row)) % secrets->prime_field));
+	}
+	stop_stage_timer((CIPHERTEXT_FORMAT_BINARY == format) ? PIPELINE_STAGE_AFFINE : PIPELINE_STAGE_MAPPING_PERMUTATION,
+		stage_start_time, (uint64_t)chunk_elements * element_size);
+
+	stage_start_time = start_stage_timer();
+	return_code = multiply_field_blocks(out_expanded, block_loop, multiplier, &ciphertext_view, blocks_in_chunk);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+	stop_stage_timer(PIPELINE_STAGE_BLOCK_MULTIPLY, stage_start_time, (uint64_t)chunk_elements * element_size);
+
+	return_code = STATUS_CODE_SUCCESS;
+cleanup:
+	return return_code;
+}
+
+static STATUS_CODE find_padding_magic(uint32_t* out_expanded_size, const uint8_t* expanded, uint32_t size)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+	uint32_t expanded_size = 0;
+
+	// The padding magic byte is the last non-zero byte and always lies in the final block
+	for (expanded_size = size; expanded_size > 0; --expanded_size)
+	{
+		if (0 != expanded[expanded_size - 1])
+		{
+			break;
+		}
+	}
+	if ((0 == expanded_size) || (PADDING_MAGIC != expanded[expanded_size - 1]))
+	{
+		log_error("[!] Padding magic byte not found in data");
+		return_code = STATUS_CODE_NO_PADDING;
+		goto cleanup;
+	}
+
+	*out_expanded_size = expanded_size - 1;
+	return_code = STATUS_CODE_SUCCESS;
+cleanup:
+	return return_code;
+}
+
+static uint32_t remove_random_bits_in_place(uint8_t* expanded, uint32_t expanded_size, uint32_t number_of_random_bits)
+{
+	uint32_t group_size = BYTE_SIZE + number_of_random_bits;
+	uint32_t plaintext_size = (uint32_t)(((uint64_t)expanded_size * BYTE_SIZE) / group_size);
+	uint64_t stream_bit = 0;
+	size_t byte_index = 0, bit_number = 0;
+	uint8_t plaintext_byte = 0;
+
+	// Writes never overtake reads
+	if (0 != number_of_random_bits)
+	{
+		for (byte_index = 0; byte_index < plaintext_size; ++byte_index)
+		{
+			stream_bit = (uint64_t)byte_index * group_size;
+			plaintext_byte = 0;
+			for (bit_number = 0; bit_number < BYTE_SIZE; ++bit_number, ++stream_bit)
+			{
+				plaintext_byte = (uint8_t)((plaintext_byte << 1) |
+					((expanded[stream_bit / BYTE_SIZE] >> (BYTE_SIZE - 1 - (stream_bit % BYTE_SIZE))) & 1));
+			}
+			expanded[byte_index] = plaintext_byte;
+		}
+	}
+
+	return plaintext_size;
+}
+
+// Over GF(2) the expanded plaintext is encrypted bit by bit, a block and its ciphertext are dimension / 8 bytes in both formats
+static STATUS_CODE encrypt_gf2_with_context(uint8_t** out_ciphertext, uint32_t* out_ciphertext_size, const uint8_t* plaintext_vector, uint32_t plaintext_size, const CipherContext* context)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+	const Secrets* secrets = &context->secrets;
+	uint32_t bytes_per_block = secrets->dimension / BYTE_SIZE;
+	uint64_t expanded_size = 0, number_of_blocks = 0, padded_size = 0;
+	size_t expanded_chunk_size = 0;
+	uint8_t* padded_plaintext = NULL;
+	uint8_t* ciphertext = NULL;
+	SecureRandomPool random_pool;
+	uint64_t stage_start_time = 0;
+
+	expanded_size = (((uint64_t)plaintext_size * (BYTE_SIZE + secrets->number_of_random_bits_to_add)) + BYTE_SIZE - 1) / BYTE_SIZE;
+	number_of_blocks = (expanded_size / bytes_per_block) + 1;
+	padded_size = number_of_blocks * bytes_per_block;
+	if (padded_size > UINT32_MAX)
+	{
+		log_error("[!] Ciphertext size overflow in encrypt_and_serialize");
+		return_code = STATUS_CODE_ERROR_INVALID_SIZE;
+		goto cleanup;
+	}
+
+	log_info("Starting bit-sliced GF(2) encryption: dimension=%u, input_size=%u bytes, blocks=%llu",
+		secrets->dimension, plaintext_size, (unsigned long long)number_of_blocks);
+
+	return_code = initialize_secure_random_pool(&random_pool);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+
+	// Zeroed, so the padding is the magic byte only
+	padded_plaintext = (uint8_t*)calloc((size_t)padded_size, sizeof(uint8_t));
+	ciphertext = (uint8_t*)malloc((size_t)padded_size);
+	if ((NULL == padded_plaintext) || (NULL == ciphertext))
+	{
+		log_error("[!] Memory allocation failed in encrypt_and_serialize");
+		return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+		goto cleanup;
+	}
+	increase_metric_counter(METRIC_COUNTER_ALLOCATIONS, 2);
+
+	stage_start_time = start_stage_timer();
+	return_code = expand_plaintext_chunk(padded_plaintext, &expanded_chunk_size, plaintext_vector, plaintext_size, secrets->number_of_random_bits_to_add, &random_pool);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+	padded_plaintext[expanded_chunk_size] = PADDING_MAGIC;
+	stop_stage_timer(PIPELINE_STAGE_RANDOM_BIT_EXPANSION, stage_start_time, padded_size);
+
+	stage_start_time = start_stage_timer();
+	return_code = multiply_gf2_blocks(ciphertext, padded_plaintext, (size_t)number_of_blocks, &context->gf2_key_matrix, NULL, context->gf2_error_vector);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+	stop_stage_timer(PIPELINE_STAGE_BLOCK_MULTIPLY, stage_start_time, padded_size);
+
+	increase_metric_counter(METRIC_COUNTER_BLOCKS_ENCRYPTED, number_of_blocks);
+
+	*out_ciphertext = ciphertext;
+	ciphertext = NULL;
+	*out_ciphertext_size = (uint32_t)padded_size;
+
+	return_code = STATUS_CODE_SUCCESS;
+cleanup:
+	free(padded_plaintext);
+	free(ciphertext);
+	return return_code;
+}
+
+static STATUS_CODE decrypt_gf2_with_context(uint8_t** out_plaintext, uint32_t* out_plaintext_size, const uint8_t* ciphertext, uint32_t ciphertext_size, const CipherContext* context)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+	const Secrets* secrets = &context->secrets;
+	uint32_t bytes_per_block = secrets->dimension / BYTE_SIZE;
+	uint32_t number_of_blocks = 0, expanded_size = 0, plaintext_size = 0;
+	uint8_t* plaintext_buffer = NULL;
+	uint64_t stage_start_time = 0;
+
+	if ((0 == ciphertext_size) || (0 != (ciphertext_size % bytes_per_block)))
+	{
+		log_error("[!] Invalid ciphertext size %u for GF(2) blocks of %u bytes", ciphertext_size, bytes_per_block);
+		return_code = STATUS_CODE_ERROR_INVALID_FILE_SIZE;
+		goto cleanup;
+	}
+	number_of_blocks = ciphertext_size / bytes_per_block;
+
+	log_info("Starting bit-sliced GF(2) decryption: dimension=%u, blocks=%u", secrets->dimension, number_of_blocks);
+
+	plaintext_buffer = (uint8_t*)malloc(ciphertext_size);
+	if (NULL == plaintext_buffer)
+	{
+		log_error("[!] Memory allocation failed in deserialize_and_decrypt");
+		return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+		goto cleanup;
+	}
+	increase_metric_counter(METRIC_COUNTER_ALLOCATIONS, 1);
+
+	// The error vector is subtracted before the inverse, which over GF(2) is the same XOR
+	stage_start_time = start_stage_timer();
+	return_code = multiply_gf2_blocks(plaintext_buffer, ciphertext, number_of_blocks, &context->gf2_key_matrix, context->gf2_error_vector, NULL);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+	stop_stage_timer(PIPELINE_STAGE_BLOCK_MULTIPLY, stage_start_time, ciphertext_size);
+
+	stage_start_time = start_stage_timer();
+	return_code = find_padding_magic(&expanded_size, plaintext_buffer, ciphertext_size);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+	stop_stage_timer(PIPELINE_STAGE_PADDING, stage_start_time, ciphertext_size - expanded_size);
+
+	stage_start_time = start_stage_timer();
+	plaintext_size = remove_random_bits_in_place(plaintext_buffer, expanded_size, secrets->number_of_random_bits_to_add);
+	stop_stage_timer(PIPELINE_STAGE_RANDOM_BIT_EXPANSION, stage_start_time, expanded_size);
+
+	increase_metric_counter(METRIC_COUNTER_BLOCKS_DECRYPTED, number_of_blocks);
+
+	*out_plaintext = plaintext_buffer;
+	plaintext_buffer = NULL;
+	*out_plaintext_size = plaintext_size;
+
+	return_code = STATUS_CODE_SUCCESS;
+cleanup:
+	free(plaintext_buffer);
+	return return_code;
+}
+
+STATUS_CODE encrypt_and_serialize(uint8_t** out_serialized_ciphertext, uint32_t* out_serialized_ciphertext_size, uint8_t* plaintext_vector, uint32_t plaintext_size, Secrets secrets, CIPHERTEXT_FORMAT format)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+	CipherContext context = {0};
+
+	return_code = prepare_cipher_context_for_input(&context, &secrets, plaintext_size);
+	if (STATUS_FAILED(return_code))
+	{
+		log_error("[!] Invalid arguments in encrypt_and_serialize");
+		goto cleanup;
+	}
+
+	return_code = encrypt_and_serialize_with_context(out_serialized_ciphertext, out_serialized_ciphertext_size, plaintext_vector, plaintext_size, &context, format);
+cleanup:
+	free_cipher_context(&context);
+	return return_code;
+}
+
+STATUS_CODE encrypt_and_serialize_with_context(uint8_t** out_serialized_ciphertext, uint32_t* out_serialized_ciphertext_size, uint8_t* plaintext_vector, uint32_t plaintext_size, const CipherContext* context, CIPHERTEXT_FORMAT format)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+	uint64_t expanded_size = 0, number_of_blocks = 0, serialized_size = 0, byte_index = 0, block_number = 0;
+	uint32_t element_size = 0, chunk_size = 0, blocks_in_chunk = 0;
+	size_t row = 0, chunk_elements = 0;
+	const Secrets* secrets = NULL;
+	CirculantKey circulant_key_view = {0};
+	BlockLoop block_loop = {0};
+	BlockMultiplier multiplier;
+	uint8_t* plaintext_chunk = NULL;
+	FieldVector ciphertext_chunk = {0};
+	uint8_t* digits_buffer = NULL;
+	uint8_t* serialized_buffer = NULL;
+	uint8_t* serialized_element = NULL;
+	BitExpansionState expansion_state = {0};
+	SecureRandomPool random_pool;
+	uint64_t stage_start_time = 0;
+
+	if ((NULL == out_serialized_ciphertext) || (NULL == out_serialized_ciphertext_size) || (NULL == plaintext_vector) ||
+		(0 == plaintext_size) || (NULL == context) || (format >= NUMBER_OF_CIPHERTEXT_FORMATS))
+	{
+		log_error("[!] Invalid arguments in encrypt_and_serialize");
+		return_code = STATUS_CODE_INVALID_ARGUMENT;
+		goto cleanup;
+	}
+	secrets = &context->secrets;
+
+	if ((CIPHERTEXT_FORMAT_TEXT == format) && STATUS_FAILED(context->text_format_status))
+	{
+		log_error("[!] The key can't be used with text ciphertexts");
+		return_code = context->text_format_status;
+		goto cleanup;
+	}
+
+	if (context->is_gf2)
+	{
+		return_code = encrypt_gf2_with_context(out_serialized_ciphertext, out_serialized_ciphertext_size, plaintext_vector, plaintext_size, context);
+		goto cleanup;
+	}
+
+	element_size = (CIPHERTEXT_FORMAT_BINARY == format) ?
+		calculate_bytes_per_element(secrets->prime_field) :
+		calculate_digits_per_element(secrets->prime_field);
+
+	// Sizes of every stage are known upfront: expansion, then padding adds the magic byte and zeros up to a full block
+	expanded_size = (((uint64_t)plaintext_size * (BYTE_SIZE + secrets->number_of_random_bits_to_add)) + BYTE_SIZE - 1) / BYTE_SIZE;
+	number_of_blocks = (expanded_size / secrets->dimension) + 1;
+	serialized_size = (number_of_blocks * secrets->dimension * element_size) + ((CIPHERTEXT_FORMAT_TEXT == format) ? 1 : 0);
+	if (serialized_size > UINT32_MAX)
+	{
+		log_error("[!] Serialized ciphertext size overflow in encrypt_and_serialize");
+		return_code = STATUS_CODE_ERROR_INVALID_SIZE;
+		goto cleanup;
+	}
+
+	log_info("Starting fused encryption: dimension=%u, input_size=%u bytes, blocks=%llu",
+		secrets->dimension, plaintext_size, (unsigned long long)number_of_blocks);
+
+	// The context is shared, the circulant transform buffer is not
+	if (context->is_circulant)
+	{
+		return_code = create_circulant_key_view(&circulant_key_view, &context->circulant_key);
+		if (STATUS_FAILED(return_code))
+		{
+			goto cleanup;
+		}
+	}
+
+	return_code = initialize_secure_random_pool(&random_pool);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+
+	return_code = initialize_block_loop(&block_loop, &context->block_loop_configuration);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+	multiplier.dimension = secrets->dimension;
+	multiplier.prime_field = secrets->prime_field;
+	multiplier.flat_matrix = context->is_circulant ? NULL : &context->flat_key_matrix;
+	multiplier.circulant_key = context->is_circulant ? &circulant_key_view : NULL;
+	multiplier.column_tables = context->has_column_tables ? &context->column_tables : NULL;
+	multiplier.offset_vector = &context->combined_error_vector;
+
+	chunk_size = get_block_loop_chunk_size(&block_loop);
+	chunk_size = (chunk_size > number_of_blocks) ? (uint32_t)number_of_blocks : chunk_size;
+
+	return_code = allocate_field_vector(&ciphertext_chunk, chunk_size * secrets->dimension, secrets->prime_field);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+
+	plaintext_chunk = (uint8_t*)malloc((size_t)chunk_size * secrets->dimension);
+	digits_buffer = (uint8_t*)malloc(element_size);
+	serialized_buffer = (uint8_t*)malloc((size_t)serialized_size);
+	if ((NULL == plaintext_chunk) || (NULL == digits_buffer) || (NULL == serialized_buffer))
+	{
+		log_error("[!] Memory allocation failed in encrypt_and_serialize");
+		return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+		goto cleanup;
+	}
+	increase_metric_counter(METRIC_COUNTER_ALLOCATIONS, 3);
+
+	serialized_element = serialized_buffer;
+	for (block_number = 0; block_number < number_of_blocks; block_number += blocks_in_chunk)
+	{
+		blocks_in_chunk = ((number_of_blocks - block_number) < chunk_size) ? (uint32_t)(number_of_blocks - block_number) : chunk_size;
+		chunk_elements = (size_t)blocks_in_chunk * secrets->dimension;
+
+		// Padding is written while assembling the chunk, it is accounted together with the expansion
+		stage_start_time = start_stage_timer();
+		for (row = 0; row < chunk_elements; ++row, ++byte_index)
+		{
+			if (byte_index < expanded_size)
+			{
+				if (0 == secrets->number_of_random_bits_to_add)
+				{
+					plaintext_chunk[row] = plaintext_vector[byte_index];
+				}
+				else
+				{
+					return_code = expand_next_byte(&plaintext_chunk[row], &expansion_state, plaintext_vector, plaintext_size, secrets->number_of_random_bits_to_add, &random_pool);
+					if (STATUS_FAILED(return_code))
+					{
+						log_error("[!] Failed to add random bits between bytes");
+						goto cleanup;
+					}
+				}
+			}
+			else
+			{
+				plaintext_chunk[row] = (byte_index == expanded_size) ? PADDING_MAGIC : 0;
+			}
+		}
+		stop_stage_timer(PIPELINE_STAGE_RANDOM_BIT_EXPANSION, stage_start_time, chunk_elements);
+
+		// The combined error vector is added inside the multiplication, so the affine stage is part of it
+		stage_start_time = start_stage_timer();
+		return_code = multiply_uint8_t_blocks(&ciphertext_chunk, &block_loop, &multiplier, plaintext_chunk, blocks_in_chunk);
+		if (STATUS_FAILED(return_code))
+		{
+			goto cleanup;
+		}
+		stop_stage_timer(PIPELINE_STAGE_BLOCK_MULTIPLY, stage_start_time, chunk_elements);
+
+		return_code = serialize_ciphertext_chunk(serialized_element, &ciphertext_chunk, chunk_elements, element_size, digits_buffer, secrets, &random_pool, format);
+		if (STATUS_FAILED(return_code))
+		{
+			goto cleanup;
+		}
+		serialized_element += chunk_elements * element_size;
+	}
+
+	if (CIPHERTEXT_FORMAT_TEXT == format)
+	{
+		*serialized_element = '\0';
+	}
+
+	log_debug("Fused encryption completed: serialized size=%llu bytes", (unsigned long long)serialized_size);
+	increase_metric_counter(METRIC_COUNTER_BLOCKS_ENCRYPTED, number_of_blocks);
+
+	*out_serialized_ciphertext = serialized_buffer;
+	serialized_buffer = NULL;
+	*out_serialized_ciphertext_size = (uint32_t)serialized_size;
+
+	return_code = STATUS_CODE_SUCCESS;
+cleanup:
+	free_circulant_key_view(&circulant_key_view);
+	free_block_loop(&block_loop);
+	free(plaintext_chunk);
+	free_field_vector(&ciphertext_chunk);
+	free(digits_buffer);
+	free(serialized_buffer);
+	return return_code;
+}
+
+STATUS_CODE deserialize_and_decrypt(uint8_t** out_plaintext, uint32_t* out_plaintext_size, uint8_t* serialized_ciphertext, uint32_t serialized_ciphertext_size, Secrets secrets, CIPHERTEXT_FORMAT format)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+	CipherContext context = {0};
+
+	return_code = prepare_cipher_context_for_input(&context, &secrets, 0);
+	if (STATUS_FAILED(return_code))
+	{
+		log_error("[!] Invalid arguments in deserialize_and_decrypt");
+		goto cleanup;
+	}
+
+	return_code = deserialize_and_decrypt_with_context(out_plaintext, out_plaintext_size, serialized_ciphertext, serialized_ciphertext_size, &context, format);
+cleanup:
+	free_cipher_context(&context);
+	return return_code;
+}
+
+STATUS_CODE deserialize_and_decrypt_with_context(uint8_t** out_plaintext, uint32_t* out_plaintext_size, uint8_t* serialized_ciphertext, uint32_t serialized_ciphertext_size, const CipherContext* context, CIPHERTEXT_FORMAT format)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+	uint32_t element_size = 0, payload_size = 0, number_of_elements = 0, number_of_blocks = 0;
+	uint32_t expanded_size = 0, plaintext_size = 0, chunk_size = 0, blocks_in_chunk = 0;
+	size_t block_number = 0;
+	const Secrets* secrets = NULL;
+	CirculantKey circulant_key_view = {0};
+	BlockLoop block_loop = {0};
+	BlockMultiplier multiplier;
+	FieldVector ciphertext_chunk = {0};
+	uint8_t* plaintext_buffer = NULL;
+	const uint8_t* serialized_element = NULL;
+	uint64_t stage_start_time = 0;
+
+	if ((NULL == out_plaintext) || (NULL == out_plaintext_size) || (NULL == serialized_ciphertext) || (NULL == context) ||
+		(format >= NUMBER_OF_CIPHERTEXT_FORMATS) || ((CIPHERTEXT_FORMAT_TEXT == format) && (0 == serialized_ciphertext_size)))
+	{
+		log_error("[!] Invalid arguments in deserialize_and_decrypt");
+		return_code = STATUS_CODE_INVALID_ARGUMENT;
+		goto cleanup;
+	}
+	secrets = &context->secrets;
+
+	if ((CIPHERTEXT_FORMAT_TEXT == format) && STATUS_FAILED(context->text_format_status))
+	{
+		log_error("[!] The key can't be used with text ciphertexts");
+		return_code = context->text_format_status;
+		goto cleanup;
+	}
+
+	if (context->is_gf2)
+	{
+		return_code = decrypt_gf2_with_context(out_plaintext, out_plaintext_size, serialized_ciphertext, serialized_ciphertext_size, context);
+		goto cleanup;
+	}
+
+	element_size = (CIPHERTEXT_FORMAT_BINARY == format) ?
+		calculate_bytes_per_element(secrets->prime_field) :
+		calculate_digits_per_element(secrets->prime_field);
+	payload_size = serialized_ciphertext_size - ((CIPHERTEXT_FORMAT_TEXT == format) ? 1 : 0); // Text ends with a null terminator
+
+	if ((0 == element_size) || (0 != (payload_size % element_size)) ||
+		(0 == (payload_size / element_size)) || (0 != ((payload_size / element_size) % secrets->dimension)))
+	{
+		log_error("[!] Invalid ciphertext size %u for %u elements of %u bytes per block", serialized_ciphertext_size, secrets->dimension, element_size);
+		return_code = STATUS_CODE_ERROR_INVALID_FILE_SIZE;
+		goto cleanup;
+	}
+	number_of_elements = payload_size / element_size;
+	number_of_blocks = number_of_elements / secrets->dimension;
+
+	log_info("Starting fused decryption: dimension=%u, blocks=%u", secrets->dimension, number_of_blocks);
+
+	// The context is shared, the circulant transform buffer is not
+	if (context->is_circulant)
+	{
+		return_code = create_circulant_key_view(&circulant_key_view, &context->circulant_key);
+		if (STATUS_FAILED(return_code))
+		{
+			goto cleanup;
+		}
+	}
+
+	// Decryption runs with the tuning of the key shape, the work per block is the same as for encryption
+	return_code = initialize_block_loop(&block_loop, &context->block_loop_configuration);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+	multiplier.dimension = secrets->dimension;
+	multiplier.prime_field = secrets->prime_field;
+	multiplier.flat_matrix = context->is_circulant ? NULL : &context->flat_key_matrix;
+	multiplier.circulant_key = context->is_circulant ? &circulant_key_view : NULL;
+	multiplier.column_tables = NULL;
+	multiplier.offset_vector = NULL;
+
+	chunk_size = get_block_loop_chunk_size(&block_loop);
+	chunk_size = (chunk_size > number_of_blocks) ? number_of_blocks : chunk_size;
+
+	return_code = allocate_field_vector(&ciphertext_chunk, chunk_size * secrets->dimension, secrets->prime_field);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+
+	plaintext_buffer = (uint8_t*)malloc(number_of_elements);
+	if (NULL == plaintext_buffer)
+	{
+		log_error("[!] Memory allocation failed in deserialize_and_decrypt");
+		return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+		goto cleanup;
+	}
+	increase_metric_counter(METRIC_COUNTER_ALLOCATIONS, 1);
+
+	serialized_element = serialized_ciphertext;
+	for (block_number = 0; block_number < number_of_blocks; block_number += blocks_in_chunk)
+	{
+		blocks_in_chunk = ((number_of_blocks - block_number) < chunk_size) ? (uint32_t)(number_of_blocks - block_number) : chunk_size;
+
+		return_code = decrypt_serialized_chunk(plaintext_buffer + (block_number * secrets->dimension), serialized_element, blocks_in_chunk,
+			&ciphertext_chunk, &block_loop, &multiplier, context, element_size, format);
+		if (STATUS_FAILED(return_code))
+		{
+			goto cleanup;
+		}
+		serialized_element += (size_t)blocks_in_chunk * secrets->dimension * element_size;
+	}
+
+	stage_start_time = start_stage_timer();
+	return_code = find_padding_magic(&expanded_size, plaintext_buffer, number_of_elements);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+	stop_stage_timer(PIPELINE_STAGE_PADDING, stage_start_time, number_of_elements - expanded_size);
+
+	// Compact the random bits out in place
+	stage_start_time = start_stage_timer();
+	plaintext_size = remove_random_bits_in_place(plaintext_buffer, expanded_size, secrets->number_of_random_bits_to_add);
+	stop_stage_timer(PIPELINE_STAGE_RANDOM_BIT_EXPANSION, stage_start_time, expanded_size);
+
+	log_debug("Fused decryption completed: plaintext size=%u bytes", plaintext_size);
+	increase_metric_counter(METRIC_COUNTER_BLOCKS_DECRYPTED, number_of_blocks);
+
+	*out_plaintext = plaintext_buffer;
+	plaintext_buffer = NULL;
+	*out_plaintext_size = plaintext_size;
+
+	return_code = STATUS_CODE_SUCCESS;
+cleanup:
+	free_circulant_key_view(&circulant_key_view);
+	free_block_loop(&block_loop);
+	free_field_vector(&ciphertext_chunk);
+	free(plaintext_buffer);
+	return return_code;
+}
+
+STATUS_CODE encrypt_stream_with_context(FILE* output, FILE* input, const CipherContext* context, CIPHERTEXT_FORMAT format, ASYNC_IO_BACKEND io_backend,
+	uint64_t* out_bytes_read, uint64_t* out_bytes_written)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+	uint32_t element_size = 0, group_size = 0, read_size = 0, maximum_blocks = 0, blocks = 0;
+	size_t bytes_read = 0, expanded_bytes = 0, pending_size = 0, chunk_elements = 0, serialized_size = 0;
+	uint64_t total_read = 0, total_written = 0, total_blocks = 0;
+	bool reached_end = false;
+	const Secrets* secrets = NULL;
+	CirculantKey circulant_key_view = {0};
+	BlockLoop block_loop = {0};
+	BlockMultiplier multiplier;
+	AsyncFile* reader = NULL;
+	AsyncFile* writer = NULL;
+	const uint8_t* read_chunk = NULL;
+	uint8_t* pending_blocks = NULL;
+	FieldVector ciphertext_chunk = {0};
+	uint8_t* digits_buffer = NULL;
+	uint8_t* serialized_buffer = NULL;
+	SecureRandomPool random_pool;
+	uint64_t stage_start_time = 0;
+
+	if ((NULL == output) || (NULL == input) || (NULL == context) || (format >= NUMBER_OF_CIPHERTEXT_FORMATS) || (io_backend >= NUMBER_OF_ASYNC_IO_BACKENDS))
+	{
+		log_error("[!] Invalid arguments in encrypt_stream_with_context");
+		return_code = STATUS_CODE_INVALID_ARGUMENT;
+		goto cleanup;
+	}
+	secrets = &context->secrets;
+
+	if ((CIPHERTEXT_FORMAT_TEXT == format) && STATUS_FAILED(context->text_format_status))
+	{
+		log_error("[!] The key can't be used with text ciphertexts");
+		return_code = context->text_format_status;
+		goto cleanup;
+	}
+
+	// The streamed chunks are cut at element boundaries, GF(2) blocks of packed bits only go through the whole buffer engine
+	if (context->is_gf2)
+	{
+		log_error("[!] Keys over GF(2) can't be used with streams, encrypt the whole file instead");
+		return_code = STATUS_CODE_INVALID_ARGUMENT;
+		goto cleanup;
+	}
+
+	element_size = (CIPHERTEXT_FORMAT_BINARY == format) ?
+		calculate_bytes_per_element(secrets->prime_field) :
+		calculate_digits_per_element(secrets->prime_field);
+
+	// Every read but the last is whole groups of BYTE_SIZE plaintext bytes, so its expansion ends on a byte boundary
+	// and the chunks expand exactly like the whole stream would
+	group_size = BYTE_SIZE + secrets->number_of_random_bits_to_add;
+	read_size = CIPHER_STREAM_CHUNK_SIZE - (CIPHER_STREAM_CHUNK_SIZE % BYTE_SIZE);
+	// The expansion of a read, the partial block carried over and the padding block
+	maximum_blocks = (uint32_t)((((uint64_t)read_size / BYTE_SIZE) * group_size) / secrets->dimension) + 2;
+
+	log_info("Starting stream encryption: dimension=%u, chunk=%u bytes", secrets->dimension, read_size);
+
+	if (context->is_circulant)
+	{
+		return_code = create_circulant_key_view(&circulant_key_view, &context->circulant_key);
+		if (STATUS_FAILED(return_code))
+		{
+			goto cleanup;
+		}
+	}
+
+	return_code = initialize_secure_random_pool(&random_pool);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+
+	return_code = initialize_block_loop(&block_loop, &context->block_loop_configuration);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+	multiplier.dimension = secrets->dimension;
+	multiplier.prime_field = secrets->prime_field;
+	multiplier.flat_matrix = context->is_circulant ? NULL : &context->flat_key_matrix;
+	multiplier.circulant_key = context->is_circulant ? &circulant_key_view : NULL;
+	multiplier.column_tables = context->has_column_tables ? &context->column_tables : NULL;
+	multiplier.offset_vector = &context->combined_error_vector;
+
+	return_code = allocate_field_vector(&ciphertext_chunk, maximum_blocks * secrets->dimension, secrets->prime_field);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+
+	pending_blocks = (uint8_t*)malloc((size_t)maximum_blocks * secrets->dimension);
+	digits_buffer = (uint8_t*)malloc(element_size);
+	if ((NULL == pending_blocks) || (NULL == digits_buffer))
+	{
+		log_error("[!] Memory allocation failed in encrypt_stream_with_context");
+		return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+		goto cleanup;
+	}
+	increase_metric_counter(METRIC_COUNTER_ALLOCATIONS, 2);
+
+	// The next chunks are read ahead and the previous ones written behind while a chunk is encrypted
+	return_code = open_async_file(&reader, input, false, read_size, io_backend);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+	return_code = open_async_file(&writer, output, true, (size_t)maximum_blocks * secrets->dimension * element_size, io_backend);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+
+	while (!reached_end)
+	{
+		// Only the time spent waiting for the read ahead is counted
+		stage_start_time = start_stage_timer();
+		return_code = async_read_next(&read_chunk, &bytes_read, reader);
+		if (STATUS_FAILED(return_code))
+		{
+			log_error("[!] Failed to read the plaintext stream");
+			goto cleanup;
+		}
+		reached_end = (bytes_read < read_size);
+		stop_stage_timer(PIPELINE_STAGE_READ, stage_start_time, bytes_read);
+		total_read += bytes_read;
+
+		stage_start_time = start_stage_timer();
+		return_code = expand_plaintext_chunk(pending_blocks + pending_size, &expanded_bytes, read_chunk, bytes_read, secrets->number_of_random_bits_to_add, &random_pool);
+		if (STATUS_FAILED(return_code))
+		{
+			goto cleanup;
+		}
+		pending_size += expanded_bytes;
+		if (reached_end)
+		{
+			pending_blocks[pending_size++] = PADDING_MAGIC;
+			while (0 != (pending_size % secrets->dimension))
+			{
+				pending_blocks[pending_size++] = 0;
+			}
+		}
+		stop_stage_timer(PIPELINE_STAGE_RANDOM_BIT_EXPANSION, stage_start_time, expanded_bytes);
+
+		blocks = (uint32_t)(pending_size / secrets->dimension);
+		if (0 == blocks)
+		{
+			continue;
+		}
+		chunk_elements = (size_t)blocks * secrets->dimension;
+
+		stage_start_time = start_stage_timer();
+		return_code = multiply_uint8_t_blocks(&ciphertext_chunk, &block_loop, &multiplier, pending_blocks, blocks);
+		if (STATUS_FAILED(return_code))
+		{
+			goto cleanup;
+		}
+		stop_stage_timer(PIPELINE_STAGE_BLOCK_MULTIPLY, stage_start_time, chunk_elements);
+
+		// Serialized straight into the buffer written behind, waiting for the write it held last
+		stage_start_time = start_stage_timer();
+		return_code = async_write_acquire(&serialized_buffer, writer);
+		if (STATUS_FAILED(return_code))
+		{
+			log_error("[!] Failed to write the ciphertext stream");
+			goto cleanup;
+		}
+		stop_stage_timer(PIPELINE_STAGE_WRITE, stage_start_time, 0);
+
+		return_code = serialize_ciphertext_chunk(serialized_buffer, &ciphertext_chunk, chunk_elements, element_size, digits_buffer, secrets, &random_pool, format);
+		if (STATUS_FAILED(return_code))
+		{
+			goto cleanup;
+		}
+		serialized_size = chunk_elements * element_size;
+
+		stage_start_time = start_stage_timer();
+		return_code = async_write_submit(writer, serialized_size);
+		if (STATUS_FAILED(return_code))
+		{
+			log_error("[!] Failed to write the ciphertext stream");
+			goto cleanup;
+		}
+		stop_stage_timer(PIPELINE_STAGE_WRITE, stage_start_time, serialized_size);
+		total_written += serialized_size;
+		total_blocks += blocks;
+
+		pending_size -= chunk_elements;
+		memmove(pending_blocks, pending_blocks + chunk_elements, pending_size);
+	}
+
+	if (CIPHERTEXT_FORMAT_TEXT == format)
+	{
+		return_code = async_write_acquire(&serialized_buffer, writer);
+		if (STATUS_SUCCESS(return_code))
+		{
+			serialized_buffer[0] = '\0';
+			return_code = async_write_submit(writer, 1);
+		}
+		if (STATUS_FAILED(return_code))
+		{
+			log_error("[!] Failed to write the ciphertext stream");
+			goto cleanup;
+		}
+		++total_written;
+	}
+	// The writes behind are only known to have succeeded once they are drained
+	stage_start_time = start_stage_timer();
+	return_code = close_async_file(&writer);
+	if (STATUS_FAILED(return_code))
+	{
+		log_error("[!] Failed to write the ciphertext stream");
+		goto cleanup;
+	}
+	stop_stage_timer(PIPELINE_STAGE_WRITE, stage_start_time, 0);
+
+	log_debug("Stream encryption completed: %llu bytes in, %llu bytes out", (unsigned long long)total_read, (unsigned long long)total_written);
+	increase_metric_counter(METRIC_COUNTER_BLOCKS_ENCRYPTED, total_blocks);
+
+	if (NULL != out_bytes_read)
+	{
+		*out_bytes_read = total_read;
+	}
+	if (NULL != out_bytes_written)
+	{
+		*out_bytes_written = total_written;
+	}
+
+	return_code = STATUS_CODE_SUCCESS;
+cleanup:
+	(void)close_async_file(&reader);
+	(void)close_async_file(&writer);
+	free_circulant_key_view(&circulant_key_view);
+	free_block_loop(&block_loop);
+	free(pending_blocks);
+	free_field_vector(&ciphertext_chunk);
+	free(digits_buffer);
+	return return_code;
+}
+
+STATUS_CODE decrypt_stream_with_context(FILE* output, FILE* input, const CipherContext* context, CIPHERTEXT_FORMAT format, ASYNC_IO_BACKEND io_backend,
+	uint64_t* out_bytes_read, uint64_t* out_bytes_written)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+	uint32_t element_size = 0, group_size = 0, block_size = 0, blocks_per_read = 0, blocks = 0, expanded_size = 0, plaintext_size = 0;
+	size_t read_size = 0, bytes_read = 0, serialized_pending = 0, expanded_pending = 0, released_size = 0, consumed_size = 0;
+	uint64_t total_read = 0, total_written = 0, total_blocks = 0;
+	bool reached_end = false;
+	const Secrets* secrets = NULL;
+	CirculantKey circulant_key_view = {0};
+	BlockLoop block_loop = {0};
+	BlockMultiplier multiplier;
+	FieldVector ciphertext_chunk = {0};
+	AsyncFile* reader = NULL;
+	AsyncFile* writer = NULL;
+	const uint8_t* read_chunk = NULL;
+	uint8_t* write_buffer = NULL;
+	uint8_t* serialized_buffer = NULL;
+	uint8_t* expanded_buffer = NULL;
+	size_t expanded_buffer_size = 0;
+	uint64_t stage_start_time = 0;
+
+	if ((NULL == output) || (NULL == input) || (NULL == context) || (format >= NUMBER_OF_CIPHERTEXT_FORMATS) || (io_backend >= NUMBER_OF_ASYNC_IO_BACKENDS))
+	{
+		log_error("[!] Invalid arguments in decrypt_stream_with_context");
+		return_code = STATUS_CODE_INVALID_ARGUMENT;
+		goto cleanup;
+	}
+	secrets = &context->secrets;
+
+	if ((CIPHERTEXT_FORMAT_TEXT == format) && STATUS_FAILED(context->text_format_status))
+	{
+		log_error("[!] The key can't be used with text ciphertexts");
+		return_code = context->text_format_status;
+		goto cleanup;
+	}
+
+	// The streamed chunks are cut at element boundaries, GF(2) blocks of packed bits only go through the whole buffer engine
+	if (context->is_gf2)
+	{
+		log_error("[!] Keys over GF(2) can't be used with streams, encrypt the whole file instead");
+		return_code = STATUS_CODE_INVALID_ARGUMENT;
+		goto cleanup;
+	}
+
+	element_size = (CIPHERTEXT_FORMAT_BINARY == format) ?
+		calculate_bytes_per_element(secrets->prime_field) :
+		calculate_digits_per_element(secrets->prime_field);
+	group_size = BYTE_SIZE + secrets->number_of_random_bits_to_add;
+	block_size = secrets->dimension * element_size;
+	blocks_per_read = (CIPHER_STREAM_CHUNK_SIZE / block_size > 0) ? (CIPHER_STREAM_CHUNK_SIZE / block_size) : 1;
+	read_size = (size_t)blocks_per_read * block_size;
+
+	log_info("Starting stream decryption: dimension=%u, chunk=%zu bytes", secrets->dimension, read_size);
+
+	if (context->is_circulant)
+	{
+		return_code = create_circulant_key_view(&circulant_key_view, &context->circulant_key);
+		if (STATUS_FAILED(return_code))
+		{
+			goto cleanup;
+		}
+	}
+
+	return_code = initialize_block_loop(&block_loop, &context->block_loop_configuration);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+	multiplier.dimension = secrets->dimension;
+	multiplier.prime_field = secrets->prime_field;
+	multiplier.flat_matrix = context->is_circulant ? NULL : &context->flat_key_matrix;
+	multiplier.circulant_key = context->is_circulant ? &circulant_key_view : NULL;
+	multiplier.column_tables = NULL;
+	multiplier.offset_vector = NULL;
+
+	// A read completes at most one more block than it holds, with the partial block carried over
+	return_code = allocate_field_vector(&ciphertext_chunk, (blocks_per_read + 1) * secrets->dimension, secrets->prime_field);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+
+	serialized_buffer = (uint8_t*)malloc(read_size + block_size);
+	// The held back last block and partial group of random bits come on top of the blocks of a read
+	expanded_buffer_size = ((size_t)(blocks_per_read + 2) * secrets->dimension) + group_size;
+	expanded_buffer = (uint8_t*)malloc(expanded_buffer_size);
+	if ((NULL == serialized_buffer) || (NULL == expanded_buffer))
+	{
+		log_error("[!] Memory allocation failed in decrypt_stream_with_context");
+		return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+		goto cleanup;
+	}
+	increase_metric_counter(METRIC_COUNTER_ALLOCATIONS, 2);
+
+	// The next chunks are read ahead and the previous ones written behind while a chunk is decrypted
+	return_code = open_async_file(&reader, input, false, read_size, io_backend);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+	return_code = open_async_file(&writer, output, true, expanded_buffer_size, io_backend);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+
+	while (!reached_end)
+	{
+		stage_start_time = start_stage_timer();
+		return_code = async_read_next(&read_chunk, &bytes_read, reader);
+		if (STATUS_FAILED(return_code))
+		{
+			log_error("[!] Failed to read the ciphertext stream");
+			goto cleanup;
+		}
+		reached_end = (bytes_read < read_size);
+		stop_stage_timer(PIPELINE_STAGE_READ, stage_start_time, bytes_read);
+		memcpy(serialized_buffer + serialized_pending, read_chunk, bytes_read);
+		total_read += bytes_read;
+		serialized_pending += bytes_read;
+
+		if (reached_end && (CIPHERTEXT_FORMAT_TEXT == format))
+		{
+			if ((0 == serialized_pending) || ('\0' != serialized_buffer[serialized_pending - 1]))
+			{
+				log_error("[!] Text ciphertext stream doesn't end with a null terminator");
+				return_code = STATUS_CODE_ERROR_INVALID_FILE_SIZE;
+				goto cleanup;
+			}
+			--serialized_pending;
+		}
+
+		blocks = (uint32_t)(serialized_pending / block_size);
+		if (0 != blocks)
+		{
+			return_code = decrypt_serialized_chunk(expanded_buffer + expanded_pending, serialized_buffer, blocks,
+				&ciphertext_chunk, &block_loop, &multiplier, context, element_size, format);
+			if (STATUS_FAILED(return_code))
+			{
+				goto cleanup;
+			}
+			consumed_size = (size_t)blocks * block_size;
+			serialized_pending -= consumed_size;
+			memmove(serialized_buffer, serialized_buffer + consumed_size, serialized_pending);
+			expanded_pending += (size_t)blocks * secrets->dimension;
+			total_blocks += blocks;
+		}
+
+		if (!reached_end)
+		{
+			// Whole groups of random bits before the held back last block are final
+			released_size = (expanded_pending > secrets->dimension) ? (((expanded_pending - secrets->dimension) / group_size) * group_size) : 0;
+		}
+		else
+		{
+			if ((0 != serialized_pending) || (0 == total_blocks))
+			{
+				log_error("[!] Invalid ciphertext stream size for %u elements of %u bytes per block", secrets->dimension, element_size);
+				return_code = STATUS_CODE_ERROR_INVALID_FILE_SIZE;
+				goto cleanup;
+			}
+
+			stage_start_time = start_stage_timer();
+			return_code = find_padding_magic(&expanded_size, expanded_buffer, (uint32_t)expanded_pending);
+			if (STATUS_FAILED(return_code))
+			{
+				goto cleanup;
+			}
+			stop_stage_timer(PIPELINE_STAGE_PADDING, stage_start_time, expanded_pending - expanded_size);
+			released_size = expanded_size;
+		}
+
+		if (0 == released_size)
+		{
+			continue;
+		}
+
+		stage_start_time = start_stage_timer();
+		plaintext_size = remove_random_bits_in_place(expanded_buffer, (uint32_t)released_size, secrets->number_of_random_bits_to_add);
+		stop_stage_timer(PIPELINE_STAGE_RANDOM_BIT_EXPANSION, stage_start_time, released_size);
+
+		stage_start_time = start_stage_timer();
+		return_code = async_write_acquire(&write_buffer, writer);
+		if (STATUS_SUCCESS(return_code))
+		{
+			memcpy(write_buffer, expanded_buffer, plaintext_size);
+			return_code = async_write_submit(writer, plaintext_size);
+		}
+		if (STATUS_FAILED(return_code))
+		{
+			log_error("[!] Failed to write the plaintext stream");
+			goto cleanup;
+		}
+		stop_stage_timer(PIPELINE_STAGE_WRITE, stage_start_time, plaintext_size);
+		total_written += plaintext_size;
+
+		expanded_pending -= released_size;
+		memmove(expanded_buffer, expanded_buffer + released_size, expanded_pending);
+	}
+
+	// The writes behind are only known to have succeeded once they are drained
+	stage_start_time = start_stage_timer();
+	return_code = close_async_file(&writer);
+	if (STATUS_FAILED(return_code))
+	{
+		log_error("[!] Failed to write the plaintext stream");
+		goto cleanup;
+	}
+	stop_stage_timer(PIPELINE_STAGE_WRITE, stage_start_time, 0);
+
+	log_debug("Stream decryption completed: %llu bytes in, %llu bytes out", (unsigned long long)total_read, (unsigned long long)total_written);
+	increase_metric_counter(METRIC_COUNTER_BLOCKS_DECRYPTED, total_blocks);
+
+	if (NULL != out_bytes_read)
+	{
+		*out_bytes_read = total_read;
+	}
+	if (NULL != out_bytes_written)
+	{
+		*out_bytes_written = total_written;
+	}
+
+	return_code = STATUS_CODE_SUCCESS;
+cleanup:
+	(void)close_async_file(&reader);
+	(void)close_async_file(&writer);
+	free_circulant_key_view(&circulant_key_view);
+	free_block_loop(&block_loop);
+	free_field_vector(&ciphertext_chunk);
+	free(serialized_buffer);
+	free(expanded_buffer);
+	return return_code;
+}
+
+STATUS_CODE rekey_serialized_ciphertext(uint8_t** out_serialized_ciphertext, uint32_t* out_serialized_ciphertext_size, uint8_t* serialized_ciphertext, uint32_t serialized_ciphertext_size,
+	Secrets old_decryption_secrets, Secrets new_encryption_secrets, CIPHERTEXT_FORMAT input_format, CIPHERTEXT_FORMAT output_format)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+	uint32_t input_element_size = 0, output_element_size = 0, payload_size = 0, number_of_blocks = 0, value = 0;
+	uint32_t dimension = new_encryption_secrets.dimension, prime_field = new_encryption_secrets.prime_field;
+	uint64_t output_size = 0;
+	size_t block_number = 0, row = 0;
+	RekeyTransform transform = {0};
+	FieldVector old_block = {0};
+	FieldVector new_block = {0};
+	uint8_t* digits_buffer = NULL;
+	uint8_t* output_buffer = NULL;
+	uint8_t* output_element = NULL;
+	const uint8_t* input_element = NULL;
+	int8_t ascii_to_digit_table[ASCII_TABLE_SIZE];
+	SecureRandomPool random_pool;
+	uint64_t stage_start_time = 0;
+
+	if ((NULL == out_serialized_ciphertext) || (NULL == out_serialized_ciphertext_size) || (NULL == serialized_ciphertext) ||
+		(0 == dimension) || (prime_field < 2) || (input_format >= NUMBER_OF_CIPHERTEXT_FORMATS) || (output_format >= NUMBER_OF_CIPHERTEXT_FORMATS) ||
+		((CIPHERTEXT_FORMAT_TEXT == input_format) && ((NULL == old_decryption_secrets.ascii_mapping) || (NULL == old_decryption_secrets.permutation_vector) || (0 == serialized_ciphertext_size))) ||
+		((CIPHERTEXT_FORMAT_TEXT == output_format) && ((NULL == new_encryption_secrets.ascii_mapping) || (NULL == new_encryption_secrets.permutation_vector))))
+	{
+		log_error("[!] Invalid arguments in rekey_serialized_ciphertext");
+		return_code = STATUS_CODE_INVALID_ARGUMENT;
+		goto cleanup;
+	}
+
+	// Rekeying transforms elements, GF(2) ciphertexts hold packed bits
+	if (GF2_PRIME_FIELD == prime_field)
+	{
+		log_error("[!] Ciphertexts over GF(2) can't be rekeyed, decrypt and encrypt them again instead");
+		return_code = STATUS_CODE_INVALID_ARGUMENT;
+		goto cleanup;
+	}
+
+	input_element_size = (CIPHERTEXT_FORMAT_BINARY == input_format) ? calculate_bytes_per_element(prime_field) : calculate_digits_per_element(prime_field);
+	output_element_size = (CIPHERTEXT_FORMAT_BINARY == output_format) ? calculate_bytes_per_element(prime_field) : calculate_digits_per_element(prime_field);
+	payload_size = serialized_ciphertext_size - ((CIPHERTEXT_FORMAT_TEXT == input_format) ? 1 : 0);
+
+	if ((0 == input_element_size) || (0 != (payload_size % input_element_size)) ||
+		(0 == (payload_size / input_element_size)) || (0 != ((payload_size / input_element_size) % dimension)))
+	{
+		log_error("[!] Invalid ciphertext size %u for %u elements of %u bytes per block", serialized_ciphertext_size, dimension, input_element_size);
+		return_code = STATUS_CODE_ERROR_INVALID_FILE_SIZE;
+		goto cleanup;
+	}
+	number_of_blocks = (payload_size / input_element_size) / dimension;
+
+	output_size = ((uint64_t)number_of_blocks * dimension * output_element_size) + ((CIPHERTEXT_FORMAT_TEXT == output_format) ? 1 : 0);
+	if (output_size > UINT32_MAX)
+	{
+		log_error("[!] Serialized ciphertext size overflow in rekey_serialized_ciphertext");
+		return_code = STATUS_CODE_ERROR_INVALID_SIZE;
+		goto cleanup;
+	}
+
+	log_info("Starting rekeying: dimension=%u, blocks=%u", dimension, number_of_blocks);
+
+	if (CIPHERTEXT_FORMAT_TEXT == input_format)
+	{
+		return_code = validate_permutation_vector(old_decryption_secrets.permutation_vector, input_element_size);
+		if (STATUS_FAILED(return_code))
+		{
+			goto cleanup;
+		}
+
+		return_code = build_ascii_to_digit_table(ascii_to_digit_table, old_decryption_secrets.ascii_mapping, old_decryption_secrets.number_of_letters_for_each_digit_ascii_mapping);
+		if (STATUS_FAILED(return_code))
+		{
+			goto cleanup;
+		}
+	}
+
+	if (CIPHERTEXT_FORMAT_TEXT == output_format)
+	{
+		return_code = validate_permutation_vector(new_encryption_secrets.permutation_vector, output_element_size);
+		if (STATUS_FAILED(return_code))
+		{
+			goto cleanup;
+		}
+	}
+
+	return_code = build_rekey_transform(&transform, &old_decryption_secrets, &new_encryption_secrets);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+
+	return_code = initialize_secure_random_pool(&random_pool);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+
+	return_code = allocate_field_vector(&old_block, dimension, prime_field);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+	return_code = allocate_field_vector(&new_block, dimension, prime_field);
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+
+	digits_buffer = (uint8_t*)malloc(output_element_size);
+	output_buffer = (uint8_t*)malloc((size_t)output_size);
+	if ((NULL == digits_buffer) || (NULL == output_buffer))
+	{
+		log_error("[!] Memory allocation failed in rekey_serialized_ciphertext");
+		return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+		goto cleanup;
+	}
+	increase_metric_counter(METRIC_COUNTER_ALLOCATIONS, 2);
+
+	input_element = serialized_ciphertext;
+	output_element = output_buffer;
+	for (block_number = 0; block_number < number_of_blocks; ++block_number)
+	{
+		stage_start_time = start_stage_timer();
+		if (CIPHERTEXT_FORMAT_BINARY == input_format)
+		{
+			return_code = deserialize_field_vector(&old_block, input_element, input_element_size, prime_field);
+			if (STATUS_FAILED(return_code))
+			{
+				goto cleanup;
+			}
+			input_element += (size_t)dimension * input_element_size;
+		}
+		else
+		{
+			for (row = 0; row < dimension; ++row)
+			{
+				return_code = deserialize_element_from_text(&value, input_element, input_element_size, ascii_to_digit_table, old_decryption_secrets.permutation_vector);
+				if (STATUS_FAILED(return_code))
+				{
+					goto cleanup;
+				}
+				set_field_vector_element(&old_block, row, value % prime_field);
+				input_element += input_element_size;
+			}
+		}
+		stop_stage_timer((CIPHERTEXT_FORMAT_BINARY == input_format) ? PIPELINE_STAGE_SERIALIZE : PIPELINE_STAGE_MAPPING_PERMUTATION,
+			stage_start_time, (uint64_t)dimension * input_element_size);
+
+		stage_start_time = start_stage_timer();
+		return_code = apply_rekey_transform(&new_block, &transform, &old_block);
+		if (STATUS_FAILED(return_code))
+		{
+			goto cleanup;
+		}
+		stop_stage_timer(PIPELINE_STAGE_BLOCK_MULTIPLY, stage_start_time, (uint64_t)dimension * input_element_size);
+
+		stage_start_time = start_stage_timer();
+		if (CIPHERTEXT_FORMAT_BINARY == output_format)
+		{
+			return_code = serialize_field_vector(output_element, &new_block, output_element_size);
+			if (STATUS_FAILED(return_code))
+			{
+				goto cleanup;
+			}
+			output_element += (size_t)dimension * output_element_size;
+		}
+		else
+		{
+			for (row = 0; row < dimension; ++row)
+			{
+				return_code = serialize_element_as_text(output_element, get_field_vector_element(&new_block, row), digits_buffer, output_element_size, &new_encryption_secrets, &random_pool);
+				if (STATUS_FAILED(return_code))
+				{
+					log_error("[!] Failed to map ciphertext element to ASCII");
+					goto cleanup;
+				}
+				output_element += output_element_size;
+			}
+		}
+		stop_stage_timer((CIPHERTEXT_FORMAT_BINARY == output_format) ? PIPELINE_STAGE_SERIALIZE : PIPELINE_STAGE_MAPPING_PERMUTATION,
+			stage_start_time, (uint64_t)dimension * output_element_size);
+	}
+
+	if (CIPHERTEXT_FORMAT_TEXT == output_format)
+	{
+		*output_element = '\0';
+	}
+
+	log_debug("Rekeying completed: serialized size=%llu bytes", (unsigned long long)output_size);
+	increase_metric_counter(METRIC_COUNTER_BLOCKS_REKEYED, number_of_blocks);
+
+	*out_serialized_ciphertext = output_buffer;
+	output_buffer = NULL;
+	*out_serialized_ciphertext_size = (uint32_t)output_size;
+
+	return_code = STATUS_CODE_SUCCESS;
+cleanup:
+	free_rekey_transform(&transform);
+	free_field_vector(&old_block);
+	free_field_vector(&new_block);
+	free(digits_buffer);
+	free(output_buffer);
+	return return_code;
+}
@@ -0,0 +1,297 @@
+#include "Cipher/CipherContext.h"
+
+#include "IO/SerDes.h"
+#include "Secrets/SecretsGeneration.h"
+
+static size_t get_field_vector_size(const FieldVector* vector)
+{
+    return (size_t)vector->length * get_field_element_size(vector->width);
+}
+
+static size_t calculate_cipher_context_size(const CipherContext* context)
+{
+    const Secrets* secrets = &context->secrets;
+    size_t size = sizeof(CipherContext), dimension = secrets->dimension;
+
+    // Flat views into a mapped key are accounted with the whole mapping
+    if (NULL != secrets->key_mapping)
+    {
+        size += secrets->key_mapping_size;
+    }
+    else
+    {
+        size += get_field_vector_size(&context->flat_key_matrix) + get_field_vector_size(&context->combined_error_vector);
+    }
+
+    if (NULL != secrets->key_matrix)
+    {
+        size += dimension * (sizeof(int64_t*) + (dimension * sizeof(int64_t)));
+    }
+    if (NULL != secrets->inverse_key_matrix)
+    {
+        size += dimension * (sizeof(int64_t*) + (dimension * sizeof(int64_t)));
+    }
+    if (NULL != secrets->error_vectors)
+    {
+        size += secrets->number_of_error_vectors * (sizeof(int64_t*) + (dimension * sizeof(int64_t)));
+    }
+    if (NULL != secrets->circulant_column)
+    {
+        size += dimension * sizeof(int64_t);
+    }
+    if (context->is_gf2)
+    {
+        size += (dimension + 1) * context->gf2_key_matrix.words_per_row * sizeof(uint64_t);
+    }
+    if (context->has_column_tables)
+    {
+        size += get_field_vector_size(&context->column_tables.products);
+    }
+    if (context->is_circulant)
+    {
+        size += 3 * dimension * sizeof(uint32_t); // Transformed column, workspace, and the roots and inverse roots of half the length each
+    }
+    if (NULL != secrets->ascii_mapping)
+    {
+        size += NUMBER_OF_DIGITS * (sizeof(uint8_t*) + secrets->number_of_letters_for_each_digit_ascii_mapping);
+    }
+    if (NULL != secrets->permutation_vector)
+    {
+        size += calculate_digits_per_element(secrets->prime_field);
+    }
+
+    return size;
+}
+
+static STATUS_CODE prepare_text_format_tables(CipherContext* context)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+
+    memset(context->ascii_to_digit_table, UNMAPPED_ASCII_CHARACTER, sizeof(context->ascii_to_digit_table));
+
+    // Keys without a mapping are still usable with the binary format
+    if ((NULL == context->secrets.ascii_mapping) || (NULL == context->secrets.permutation_vector))
+    {
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    return_code = validate_permutation_vector(context->secrets.permutation_vector, calculate_digits_per_element(context->secrets.prime_field));
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    return_code = build_ascii_to_digit_table(context->ascii_to_digit_table, context->secrets.ascii_mapping,
+                                             context->secrets.number_of_letters_for_each_digit_ascii_mapping);
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE prepare_cipher_context(CipherContext* out_context, const Secrets* secrets)
+{
+    return prepare_cipher_context_for_input(out_context, secrets, UNKNOWN_CIPHER_INPUT_SIZE);
+}
+
+STATUS_CODE prepare_cipher_context_for_input(CipherContext* out_context, const Secrets* secrets, uint64_t input_size)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    CipherContext context;
+    bool is_circulant = false;
+
+    memset(&context, 0, sizeof(context));
+
+    if ((NULL == out_context) || (NULL == secrets))
+    {
+        log_error("[!] Invalid arguments in prepare_cipher_context_for_input");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    is_circulant = (KEY_STRUCTURE_CIRCULANT == secrets->key_structure);
+    if ((0 == secrets->dimension) || (secrets->prime_field < 2) ||
+        (is_circulant ? (NULL == secrets->circulant_column) : ((NULL == secrets->key_matrix) && (NULL == secrets->flat_key_matrix.elements))) ||
+        ((NULL == secrets->error_vectors) && (NULL == secrets->combined_error_vector.elements)))
+    {
+        log_error("[!] Incomplete secrets in prepare_cipher_context_for_input");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    context.secrets = *secrets;
+    context.is_circulant = is_circulant;
+
+    // Circulant keys are kept in the transform domain, dense keys are flattened to field elements unless they are mapped flat
+    if (is_circulant)
+    {
+        return_code = initialize_circulant_key(&context.circulant_key, secrets->circulant_column, secrets->dimension, secrets->prime_field);
+    }
+    else if (NULL == secrets->flat_key_matrix.elements)
+    {
+        return_code = flatten_square_matrix_over_field(&context.flat_key_matrix, secrets->key_matrix, secrets->dimension, secrets->prime_field);
+    }
+    else
+    {
+        context.flat_key_matrix = secrets->flat_key_matrix;
+        return_code = STATUS_CODE_SUCCESS;
+    }
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    if (NULL == secrets->combined_error_vector.elements)
+    {
+        return_code = combine_error_vectors(&context.combined_error_vector, secrets->error_vectors, secrets->number_of_error_vectors,
+                                            secrets->dimension, secrets->prime_field);
+        if (STATUS_FAILED(return_code))
+        {
+            log_error("[!] Failed to combine error vectors");
+            goto cleanup;
+        }
+    }
+    else
+    {
+        context.combined_error_vector = secrets->combined_error_vector;
+    }
+
+    // Over GF(2) every element is a bit, the blocks are packed into bytes and never reach the block loop
+    if (!is_circulant && (GF2_PRIME_FIELD == secrets->prime_field))
+    {
+        if (0 != (secrets->dimension % GF2_BITS_PER_BYTE))
+        {
+            log_error("[!] Keys over GF(2) need a dimension that is a multiple of %u, got %u", GF2_BITS_PER_BYTE, secrets->dimension);
+            return_code = STATUS_CODE_INVALID_ARGUMENT;
+            goto cleanup;
+        }
+
+        return_code = pack_gf2_bit_matrix(&context.gf2_key_matrix, &context.flat_key_matrix, secrets->dimension);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+        return_code = pack_gf2_bit_vector(&context.gf2_error_vector, &context.combined_error_vector, secrets->dimension);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+        context.is_gf2 = true;
+    }
+
+    // Built once per key, every encrypted block reuses them. A decryption key never multiplies plaintext bytes
+    if (!is_circulant && !context.is_gf2 && !secrets->is_decryption_key &&
+        ((input_size / secrets->dimension) >= COLUMN_PRODUCT_TABLE_ENTRIES) &&
+        can_use_column_product_tables(secrets->dimension, secrets->prime_field))
+    {
+        return_code = build_column_product_tables(&context.column_tables, &context.flat_key_matrix, secrets->dimension, secrets->prime_field);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+        context.has_column_tables = true;
+    }
+
+    // Circulant keys always run block by block, only dense keys are worth tuning
+    get_default_block_loop_configuration(&context.block_loop_configuration);
+    if (!is_circulant && !context.is_gf2)
+    {
+        return_code = get_block_loop_configuration(&context.block_loop_configuration, secrets->dimension, secrets->prime_field);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+    }
+
+    context.text_format_status = prepare_text_format_tables(&context);
+    if (context.is_gf2)
+    {
+        // A GF(2) ciphertext is packed bits, there are no elements to write as digits
+        context.text_format_status = STATUS_CODE_INVALID_ARGUMENT;
+    }
+    context.size_in_bytes = calculate_cipher_context_size(&context);
+
+    *out_context = context;
+    memset(&context, 0, sizeof(context));
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free_cipher_context(&context);
+    return return_code;
+}
+
+STATUS_CODE adopt_secrets_into_cipher_context(CipherContext* out_context, Secrets* secrets)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    CipherContext context;
+    Secrets* adopted_secrets = NULL;
+
+    memset(&context, 0, sizeof(context));
+
+    if ((NULL == out_context) || (NULL == secrets))
+    {
+        log_error("[!] Invalid arguments in adopt_secrets_into_cipher_context");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    return_code = prepare_cipher_context(&context, secrets);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    context.owns_secrets = true;
+    memset(secrets, 0, sizeof(*secrets));
+
+    // Nothing reads the jagged forms once the prepared ones exist, a cached key keeps only what it runs with
+    adopted_secrets = &context.secrets;
+    if (NULL != adopted_secrets->key_matrix)
+    {
+        (void)free_int64_matrix(adopted_secrets->key_matrix, adopted_secrets->dimension);
+        adopted_secrets->key_matrix = NULL;
+    }
+    if (NULL != adopted_secrets->inverse_key_matrix)
+    {
+        (void)free_int64_matrix(adopted_secrets->inverse_key_matrix, adopted_secrets->dimension);
+        adopted_secrets->inverse_key_matrix = NULL;
+    }
+    if (NULL != adopted_secrets->error_vectors)
+    {
+        (void)free_int64_matrix(adopted_secrets->error_vectors, adopted_secrets->number_of_error_vectors);
+        adopted_secrets->error_vectors = NULL;
+    }
+    free(adopted_secrets->circulant_column);
+    adopted_secrets->circulant_column = NULL;
+    context.size_in_bytes = calculate_cipher_context_size(&context);
+
+    *out_context = context;
+    memset(&context, 0, sizeof(context));
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free_cipher_context(&context);
+    return return_code;
+}
+
+void free_cipher_context(CipherContext* context)
+{
+    if (NULL == context)
+    {
+        return;
+    }
+
+    free_circulant_key(&context->circulant_key);
+    free_gf2_bit_matrix(&context->gf2_key_matrix);
+    free(context->gf2_error_vector);
+    free_column_product_tables(&context->column_tables);
+    if (context->flat_key_matrix.elements != context->secrets.flat_key_matrix.elements)
+    {
+        free_field_vector(&context->flat_key_matrix);
+    }
+    if (context->combined_error_vector.elements != context->secrets.combined_error_vector.elements)
+    {
+        free_field_vector(&context->combined_error_vector);
+    }
+    if (context->owns_secrets)
+    {
+        free_secrets(&context->secrets);
+    }
+    memset(context, 0, sizeof(*context));
+}
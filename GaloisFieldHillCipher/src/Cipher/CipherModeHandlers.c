@@ -1,5 +1,96 @@
 #include "Cipher/CipherModeHandlers.h"
 
+static CIPHERTEXT_FORMAT get_ciphertext_format(const char* format, const char* ciphertext_file)
+{
+    if (NULL != format)
+    {
+        return (0 == strcmp(format, FORMAT_TEXT)) ? CIPHERTEXT_FORMAT_TEXT : CIPHERTEXT_FORMAT_BINARY;
+    }
+    return STATUS_SUCCESS(validate_file_is_binary(ciphertext_file)) ? CIPHERTEXT_FORMAT_BINARY : CIPHERTEXT_FORMAT_TEXT;
+}
+
+static STATUS_CODE handle_stream(const char* input_file, const char* output_file, const char* key_file, CIPHERTEXT_FORMAT format, const char* io_backend_name, bool is_pipelined, bool is_encryption)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    ASYNC_IO_BACKEND io_backend = ASYNC_IO_BACKEND_AUTO;
+    Secrets secrets = {0};
+    CipherContext context = {0};
+    FILE* input = NULL;
+    FILE* output = NULL;
+    uint32_t key_size = 0;
+    uint64_t bytes_read = 0, bytes_written = 0;
+    uint64_t stage_start_time = 0;
+
+    return_code = parse_async_io_backend(&io_backend, io_backend_name);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    log_info("Loading key from: %s", key_file);
+
+    stage_start_time = start_stage_timer();
+    return_code = load_secrets_file(&secrets, &key_size, key_file);
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("[!] Failed to load secrets.");
+        goto cleanup;
+    }
+    stop_stage_timer(PIPELINE_STAGE_DESERIALIZE_SECRETS, stage_start_time, key_size);
+
+    // Prepared once, every chunk of the stream goes through the same context
+    return_code = prepare_cipher_context_for_input(&context, &secrets, is_encryption ? UNKNOWN_CIPHER_INPUT_SIZE : 0);
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("[!] Failed to prepare the key");
+        goto cleanup;
+    }
+
+    return_code = open_stream(&input, input_file, false);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    return_code = open_stream(&output, output_file, true);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    log_info("Streaming %s to %s as %s ciphertext in chunks of %u bytes%s", input_file, output_file,
+        (CIPHERTEXT_FORMAT_BINARY == format) ? "binary" : "text", CIPHER_STREAM_CHUNK_SIZE, is_pipelined ? " on the staged pipeline" : "");
+
+    if (is_pipelined)
+    {
+        return_code = encrypt_stream_pipelined_with_context(output, input, &context, format, &bytes_read, &bytes_written);
+    }
+    else
+    {
+        return_code = is_encryption ?
+            encrypt_stream_with_context(output, input, &context, format, io_backend, &bytes_read, &bytes_written) :
+            decrypt_stream_with_context(output, input, &context, format, io_backend, &bytes_read, &bytes_written);
+    }
+    increase_metric_counter(METRIC_COUNTER_BYTES_IN, bytes_read);
+    increase_metric_counter(METRIC_COUNTER_BYTES_OUT, bytes_written);
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("[!] %s of the stream failed", is_encryption ? "Encryption" : "Decryption");
+        goto cleanup;
+    }
+
+    log_info("Stream %s completed: %llu bytes in, %llu bytes out", is_encryption ? "encryption" : "decryption",
+        (unsigned long long)bytes_read, (unsigned long long)bytes_written);
+    fprintf(get_status_output(), "[*] %s completed successfully: %llu bytes in, %llu bytes out\n", is_encryption ? "Encryption" : "Decryption",
+        (unsigned long long)bytes_read, (unsigned long long)bytes_written);
+
+cleanup:
+    close_stream(input);
+    close_stream(output);
+    free_cipher_context(&context);
+    free_secrets(&secrets);
+    return return_code;
+}
+
 STATUS_CODE handle_generate_and_encrypt_mode(const GenerateAndEncryptArguments* args)
 {
     STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
@@ -63,12 +154,13 @@ STATUS_CODE handle_key_generation_mode(const KeyGenerationArguments* args)
     uint32_t serialized_size = 0;
     Secrets* secrets = NULL;
 
-    if (!args || !args->output_file || (0 == args->dimension))
+    if (!args || !args->output_file || (0 == args->dimension) || (args->mapped_key && (args->seeded_key || args->circulant_key)))
     {
         log_error("[!] Invalid arguments in key_generation_mode: %s",
             !args ? "args is NULL" :
             !args->output_file ? "output_file is NULL" :
-            "dimension is 0");
+            (0 == args->dimension) ? "dimension is 0" :
+            "a mapped key holds a full dense key, it can't be seeded or circulant");
         return STATUS_CODE_INVALID_ARGUMENT;
     }
 
@@ -82,7 +174,8 @@ STATUS_CODE handle_key_generation_mode(const KeyGenerationArguments* args)
         goto cleanup;
     }
 
-    return_code = serialize_secrets(&serialized_data, &serialized_size, *secrets);
+    return_code = args->mapped_key ? serialize_mapped_secrets(&serialized_data, &serialized_size, *secrets) :
+                                     serialize_secrets(&serialized_data, &serialized_size, *secrets);
     if (STATUS_FAILED(return_code))
     {
         goto cleanup;
@@ -119,13 +212,13 @@ STATUS_CODE handle_encrypt_mode(const EncryptArguments* args)
 {
     STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
     uint8_t* plaintext = NULL;
-    uint8_t* key_data = NULL;
-    int64_t* ciphertext = NULL;
-    uint8_t* mapped_ciphertext = NULL;
-    uint32_t plaintext_size = 0, ciphertext_size = 0, key_size = 0;
+    uint32_t plaintext_size = 0, key_size = 0;
     uint8_t* serialized_ciphertext = NULL;
     uint32_t serialized_ciphertext_size = 0;
+    CIPHERTEXT_FORMAT ciphertext_format = CIPHERTEXT_FORMAT_BINARY;
     Secrets secrets = {0};
+    uint64_t stage_start_time = 0;
+    FILE* status_output = NULL;
 
     if (!args || !args->input_file || !args->key || !args->output_file)
     {
@@ -133,106 +226,87 @@ STATUS_CODE handle_encrypt_mode(const EncryptArguments* args)
         return STATUS_CODE_INVALID_ARGUMENT;
     }
 
-    printf("[*] Starting encryption operation...");
+    // Status lines must not mix with a ciphertext written to stdout
+    if (is_standard_stream_path(args->output_file))
+    {
+        set_status_output(stderr);
+    }
+    status_output = get_status_output();
+    ciphertext_format = get_ciphertext_format(args->format, args->output_file);
+
+    fprintf(status_output, "[*] Starting encryption operation...");
     log_info("Starting encryption operation...");
 
+    // Streams can only be processed in chunks, files are when an I/O backend or the pipeline is asked for
+    if (is_standard_stream_path(args->input_file) || is_standard_stream_path(args->output_file) || (NULL != args->io_backend) || args->pipeline)
+    {
+        if (args->pipeline && (NULL != args->io_backend))
+        {
+            log_warn("The pipeline reads and writes on its own stage threads, the I/O backend is ignored");
+        }
+        return_code = handle_stream(args->input_file, args->output_file, args->key, ciphertext_format, args->io_backend, args->pipeline, true);
+        goto cleanup;
+    }
+
     log_info("Reading plaintext from: %s", args->input_file);
 
+    stage_start_time = start_stage_timer();
     return_code = read_uint8_from_file(&plaintext, &plaintext_size, args->input_file);
     if (STATUS_FAILED(return_code))
     {
         log_error("[!] Failed to read plaintext file");
         goto cleanup;
     }
+    stop_stage_timer(PIPELINE_STAGE_READ, stage_start_time, plaintext_size);
+    increase_metric_counter(METRIC_COUNTER_BYTES_IN, plaintext_size);
 
     log_uint8_vector(plaintext, plaintext_size, "[*] Plaintext data:", false);
 
-    log_info("Reading key from: %s", args->key);
-
-    return_code = read_uint8_from_file(&key_data, &key_size, args->key);
-    if (STATUS_FAILED(return_code))
-    {
-        log_error("[!] Failed to read key file");
-        goto cleanup;
-    }
+    log_info("Loading key from: %s", args->key);
 
-    log_uint8_vector(key_data, key_size, "Key data:", true);
-
-    return_code = deserialize_secrets(&secrets, key_data, key_size);
+    // The key file is mapped, so reading it is part of the deserialization
+    stage_start_time = start_stage_timer();
+    return_code = load_secrets_file(&secrets, &key_size, args->key);
     if (STATUS_FAILED(return_code))
     {
-        log_error("Failed to deserialize secrets");
+        log_error("Failed to load secrets");
         goto cleanup;
     }
+    stop_stage_timer(PIPELINE_STAGE_DESERIALIZE_SECRETS, stage_start_time, key_size);
 
     log_info("Deserialized secrets.");
 
-    return_code = encrypt(&ciphertext, &ciphertext_size, plaintext, plaintext_size * BYTE_SIZE, secrets);
+    log_info("Encrypting and serializing ciphertext to %s...", (CIPHERTEXT_FORMAT_BINARY == ciphertext_format) ? "binary" : "text");
+
+    return_code = encrypt_and_serialize(&serialized_ciphertext, &serialized_ciphertext_size, plaintext, plaintext_size, secrets, ciphertext_format);
     if (STATUS_FAILED(return_code))
     {
         log_error("Encryption process failed");
         goto cleanup;
     }
-    ciphertext_size = (ciphertext_size / (BYTE_SIZE * sizeof(int64_t))); // Size is returned as bits
-
-    log_info("Encryption completed, ciphertext size: %ld", ciphertext_size);
-
-    log_int64_vector(ciphertext, ciphertext_size, "Ciphertext data:", false);
-
-    if (STATUS_SUCCESS(validate_file_is_binary(args->output_file))) // Binary format
-    {
-        log_info("Serializing ciphertext to binary...");
-        return_code = serialize_vector(&serialized_ciphertext, &serialized_ciphertext_size, ciphertext, ciphertext_size, secrets.prime_field);
-        if (STATUS_FAILED(return_code))
-        {
-            log_error("[!] Failed to serialize ciphertext to compact binary.");
-            goto cleanup;
-        }
-
-    }
-    else // Text format
-    {
-        log_info("Mapping int64 ciphertext to text...");
-        return_code = map_from_int64_to_ascii(&mapped_ciphertext, &serialized_ciphertext_size, ciphertext, ciphertext_size, secrets.ascii_mapping, secrets.number_of_letters_for_each_digit_ascii_mapping, calculate_digits_per_element(secrets.prime_field));
-        if (STATUS_FAILED(return_code))
-        {
-            log_error("[!] Failed to map int64 ciphertext to ASCII.");
-            goto cleanup;
-        }
-        log_info("Successfully mapped int64 ciphertext to ASCII.");
-
-        log_info("Permutating ASCII ciphertext...");
-        return_code = permutate_uint8_vector(&serialized_ciphertext, mapped_ciphertext, serialized_ciphertext_size, secrets.permutation_vector, calculate_digits_per_element(secrets.prime_field));
-        if (STATUS_FAILED(return_code))
-        {
-            log_error("[!] Failed to permutate ASCII ciphertext.");
-            goto cleanup;
-        }
-        log_info("Successfully permutated ASCII ciphertext");
 
-        serialized_ciphertext_size++; // Add one for the null terminator
-    }
+    log_info("Encryption completed, serialized ciphertext size: %u", serialized_ciphertext_size);
 
     log_uint8_vector(serialized_ciphertext, serialized_ciphertext_size, "Serialized ciphertext data:", true);
 
     log_info("Encryption completed successfully.");
-    printf("[*] Encryption completed successfully.\n");
+    fprintf(status_output, "[*] Encryption completed successfully.\n");
 
     log_info("Writing ciphertext to: %s", args->output_file);
-    printf("[*] Writing ciphertext to: %s\n", args->output_file);
+    fprintf(status_output, "[*] Writing ciphertext to: %s\n", args->output_file);
+    stage_start_time = start_stage_timer();
     return_code = write_uint8_to_file(args->output_file, serialized_ciphertext, serialized_ciphertext_size);
 
     if (STATUS_SUCCESS(return_code))
     {
+        stop_stage_timer(PIPELINE_STAGE_WRITE, stage_start_time, serialized_ciphertext_size);
+        increase_metric_counter(METRIC_COUNTER_BYTES_OUT, serialized_ciphertext_size);
         log_info("Ciphertext written successfully.");
     }
 
 cleanup:
     free(plaintext);
     free(serialized_ciphertext);
-    free(key_data);
-    free(ciphertext);
-    free(mapped_ciphertext);
     free_secrets(&secrets);
     free((void*)args);
     return return_code;
@@ -241,7 +315,6 @@ cleanup:
 STATUS_CODE handle_decryption_key_generation_mode(const DecryptionKeyGenerationArguments* args)
 {
     STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
-    uint8_t* key_data = NULL;
     uint32_t key_size = 0;
     uint8_t* serialized_data = NULL;
     uint32_t serialized_size = 0;
@@ -257,26 +330,15 @@ STATUS_CODE handle_decryption_key_generation_mode(const DecryptionKeyGenerationA
     printf("[*] Starting decryption key generation operation...");
     log_info("Starting decryption key generation operation...");
 
-    log_info("Reading encryption key from: %s", args->key);
-
-    return_code = read_uint8_from_file(&key_data, &key_size, args->key);
-    if (STATUS_FAILED(return_code))
-    {
-        log_error("Failed to read encryption key file");
-        goto cleanup;
-    }
-
-    log_uint8_vector(key_data, key_size, "Key data:", true);
-
-    log_info("Deserializing encryption secrets...");
+    log_info("Loading encryption key from: %s", args->key);
 
-    return_code = deserialize_secrets(&encryption_secrets, key_data, key_size);
+    return_code = load_secrets_file(&encryption_secrets, &key_size, args->key);
     if (STATUS_FAILED(return_code))
     {
-        log_error("Failed to deserialize encryption secrets");
+        log_error("Failed to load encryption secrets");
         goto cleanup;
     }
-    log_info("Successfully deserialized encryption secrets.");
+    log_info("Successfully loaded encryption secrets.");
 
     return_code = build_decryption_secrets(&decryption_secrets, &encryption_secrets);
     if (STATUS_FAILED(return_code))
@@ -312,7 +374,6 @@ STATUS_CODE handle_decryption_key_generation_mode(const DecryptionKeyGenerationA
 
 cleanup:
     free(serialized_data);
-    free(key_data);
     free_secrets(&encryption_secrets);
     free_secrets(decryption_secrets);
     free(decryption_secrets);
@@ -322,14 +383,14 @@ cleanup:
 STATUS_CODE handle_decrypt_mode(const DecryptArguments* args)
 {
     STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
-    uint8_t* key_data = NULL;
     uint8_t* decrypted_text = NULL;
-    int64_t* ciphertext = NULL;
     uint32_t serialized_ciphertext_size = 0;
-    uint8_t* ciphertext_permutated = NULL;
     uint8_t* serialized_ciphertext = NULL;
-    uint32_t ciphertext_size = 0, decrypted_size = 0, key_size = 0;
+    uint32_t decrypted_size = 0, key_size = 0;
+    CIPHERTEXT_FORMAT ciphertext_format = CIPHERTEXT_FORMAT_BINARY;
     Secrets secrets = {0};
+    uint64_t stage_start_time = 0;
+    FILE* status_output = NULL;
 
     if (!args || !args->input_file || !args->key || !args->output_file)
     {
@@ -338,107 +399,78 @@ STATUS_CODE handle_decrypt_mode(const DecryptArguments* args)
         goto cleanup;
     }
 
-    printf("[*] Starting decryption operation...");
-    log_info("Starting decryption operation...");
+    // Status lines must not mix with a plaintext written to stdout
+    if (is_standard_stream_path(args->output_file))
+    {
+        set_status_output(stderr);
+    }
+    status_output = get_status_output();
+    ciphertext_format = get_ciphertext_format(args->format, args->input_file);
 
-    log_info("Reading key from: %s", args->key);
+    fprintf(status_output, "[*] Starting decryption operation...");
+    log_info("Starting decryption operation...");
 
-    return_code = read_uint8_from_file(&key_data, &key_size, args->key);
-    if (STATUS_FAILED(return_code))
+    // Streams can only be processed in chunks, files are when an I/O backend is asked for
+    if (is_standard_stream_path(args->input_file) || is_standard_stream_path(args->output_file) || (NULL != args->io_backend))
     {
-        log_error("Failed to read key file");
+        return_code = handle_stream(args->input_file, args->output_file, args->key, ciphertext_format, args->io_backend, false, false);
         goto cleanup;
     }
 
-    log_uint8_vector(key_data, key_size, "[*] Key data:", true);
+    log_info("Loading key from: %s", args->key);
 
-    log_info("Deserializing secrets...");
-
-    return_code = deserialize_secrets(&secrets, key_data, key_size);
+    stage_start_time = start_stage_timer();
+    return_code = load_secrets_file(&secrets, &key_size, args->key);
     if (STATUS_FAILED(return_code))
     {
-        log_error("[!] Failed to deserialize secrets.");
+        log_error("[!] Failed to load secrets.");
         goto cleanup;
     }
+    stop_stage_timer(PIPELINE_STAGE_DESERIALIZE_SECRETS, stage_start_time, key_size);
 
-    log_info("Successfully deserialized secrets.");
+    log_info("Successfully loaded secrets.");
 
     log_info("Reading ciphertext from: %s", args->input_file);
 
+    stage_start_time = start_stage_timer();
     return_code = read_uint8_from_file(&serialized_ciphertext, &serialized_ciphertext_size, args->input_file);
     if (STATUS_FAILED(return_code))
     {
         log_error("Failed to read ciphertext file");
         goto cleanup;
     }
+    stop_stage_timer(PIPELINE_STAGE_READ, stage_start_time, serialized_ciphertext_size);
+    increase_metric_counter(METRIC_COUNTER_BYTES_IN, serialized_ciphertext_size);
 
-    if (STATUS_SUCCESS(validate_file_is_binary(args->input_file))) // Binary format
-    {
-        log_info("Deserializing ciphertext from binary...");
-        return_code = deserialize_vector(&ciphertext, &ciphertext_size, serialized_ciphertext, serialized_ciphertext_size, secrets.prime_field);
-        if (STATUS_FAILED(return_code))
-        {
-            log_error("[!] Failed to deserialize ciphertext from binary.");
-            goto cleanup;
-        }
-    }
-    else // Text format
-    {
-        log_info("Permutating ASCII ciphertext...");
-
-        serialized_ciphertext_size -= 1; // Remove NULL terminator
-
-        return_code = permutate_uint8_vector(&ciphertext_permutated, serialized_ciphertext, serialized_ciphertext_size, secrets.permutation_vector, calculate_digits_per_element(secrets.prime_field));
-        if (STATUS_FAILED(return_code))
-        {
-            log_error("[!] Failed to permutate ASCII ciphertext.");
-            goto cleanup;
-        }
-
-        log_info("Successfully permutated ASCII ciphertext.");
-
-        log_info("Mapping ASCII ciphertext to int64...");
-
-        return_code = map_from_ascii_to_int64(&ciphertext, &ciphertext_size, ciphertext_permutated, serialized_ciphertext_size, secrets.ascii_mapping, secrets.number_of_letters_for_each_digit_ascii_mapping, calculate_digits_per_element(secrets.prime_field));
-        if (STATUS_FAILED(return_code))
-        {
-            log_error("[!] Failed to map ASCII ciphertext to int64.");
-            goto cleanup;
-        }
-
-        log_info("Successfully mapped ASCII ciphertext to int64.");
-    }
-
-    log_int64_vector(ciphertext, ciphertext_size / sizeof(int64_t), "[*] Ciphertext data:", false);
+    log_info("Deserializing and decrypting %s ciphertext...", (CIPHERTEXT_FORMAT_BINARY == ciphertext_format) ? "binary" : "text");
 
-    return_code = decrypt(&decrypted_text, &decrypted_size, ciphertext, ciphertext_size * BYTE_SIZE, secrets);
+    return_code = deserialize_and_decrypt(&decrypted_text, &decrypted_size, serialized_ciphertext, serialized_ciphertext_size, secrets, ciphertext_format);
     if (STATUS_FAILED(return_code))
     {
         log_error("Decryption process failed");
         goto cleanup;
     }
-    decrypted_size = (decrypted_size / BYTE_SIZE); // Size is returned as bits
 
-    log_info("Decryption completed, plaintext size: %ld", decrypted_size);
-    printf("[*] Decryption completed successfully, plaintext size: %ld\n", decrypted_size);
+    log_info("Decryption completed, plaintext size: %u", decrypted_size);
+    fprintf(status_output, "[*] Decryption completed successfully, plaintext size: %u\n", decrypted_size);
 
     log_uint8_vector(decrypted_text, decrypted_size, "[*] Decrypted data:", false);
     log_info("Writing plaintext to: %s", args->output_file);
-    printf("[*] Writing plaintext to: %s\n", args->output_file);
+    fprintf(status_output, "[*] Writing plaintext to: %s\n", args->output_file);
 
+    stage_start_time = start_stage_timer();
     return_code = write_uint8_to_file(args->output_file, decrypted_text, decrypted_size);
 
     if (STATUS_SUCCESS(return_code))
     {
+        stop_stage_timer(PIPELINE_STAGE_WRITE, stage_start_time, decrypted_size);
+        increase_metric_counter(METRIC_COUNTER_BYTES_OUT, decrypted_size);
         log_info("Plaintext written successfully.");
     }
 
 cleanup:
-    free(key_data);
     free(serialized_ciphertext);
-    free(ciphertext);
     free(decrypted_text);
-    free(ciphertext_permutated);
     free_secrets(&secrets);
     free((void*)args);
     return return_code;
@@ -486,3 +518,197 @@ cleanup:
     free((void*)args);
     return return_code;
 }
+
+STATUS_CODE handle_rekey_mode(const RekeyArguments* args)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint8_t* serialized_ciphertext = NULL;
+    uint8_t* rekeyed_ciphertext = NULL;
+    uint32_t key_size = 0, new_key_size = 0, serialized_ciphertext_size = 0, rekeyed_ciphertext_size = 0;
+    CIPHERTEXT_FORMAT input_format = CIPHERTEXT_FORMAT_BINARY, output_format = CIPHERTEXT_FORMAT_BINARY;
+    Secrets old_secrets = {0};
+    Secrets new_secrets = {0};
+    uint64_t stage_start_time = 0;
+
+    if (!args || !args->input_file || !args->key || !args->new_key || !args->output_file)
+    {
+        log_error("Invalid arguments in rekey_mode");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    printf("[*] Starting rekey operation...");
+    log_info("Starting rekey operation...");
+
+    log_info("Reading current decryption key from: %s, new encryption key from: %s", args->key, args->new_key);
+
+    stage_start_time = start_stage_timer();
+    return_code = load_secrets_file(&old_secrets, &key_size, args->key);
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("[!] Failed to load current secrets.");
+        goto cleanup;
+    }
+    return_code = load_secrets_file(&new_secrets, &new_key_size, args->new_key);
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("[!] Failed to load new secrets.");
+        goto cleanup;
+    }
+    stop_stage_timer(PIPELINE_STAGE_DESERIALIZE_SECRETS, stage_start_time, key_size + new_key_size);
+
+    // The transform is composed from the jagged matrices and error vectors, which mapped keys don't carry
+    if ((NULL != old_secrets.key_mapping) || (NULL != new_secrets.key_mapping))
+    {
+        log_error("[!] Rekeying needs keys in the full or seeded format, not mapped keys");
+        printf("[!] Rekeying needs keys in the full or seeded format, not mapped keys\n");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    log_info("Reading ciphertext from: %s", args->input_file);
+
+    stage_start_time = start_stage_timer();
+    return_code = read_uint8_from_file(&serialized_ciphertext, &serialized_ciphertext_size, args->input_file);
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("Failed to read ciphertext file");
+        goto cleanup;
+    }
+    stop_stage_timer(PIPELINE_STAGE_READ, stage_start_time, serialized_ciphertext_size);
+    increase_metric_counter(METRIC_COUNTER_BYTES_IN, serialized_ciphertext_size);
+
+    input_format = STATUS_SUCCESS(validate_file_is_binary(args->input_file)) ? CIPHERTEXT_FORMAT_BINARY : CIPHERTEXT_FORMAT_TEXT;
+    output_format = STATUS_SUCCESS(validate_file_is_binary(args->output_file)) ? CIPHERTEXT_FORMAT_BINARY : CIPHERTEXT_FORMAT_TEXT;
+    log_info("Rekeying %s ciphertext to %s...", (CIPHERTEXT_FORMAT_BINARY == input_format) ? "binary" : "text",
+             (CIPHERTEXT_FORMAT_BINARY == output_format) ? "binary" : "text");
+
+    return_code = rekey_serialized_ciphertext(&rekeyed_ciphertext, &rekeyed_ciphertext_size, serialized_ciphertext, serialized_ciphertext_size,
+                                              old_secrets, new_secrets, input_format, output_format);
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("Rekey process failed");
+        goto cleanup;
+    }
+
+    log_info("Rekey completed, ciphertext size: %u", rekeyed_ciphertext_size);
+    printf("[*] Rekey completed successfully, ciphertext size: %u\n", rekeyed_ciphertext_size);
+
+    log_info("Writing ciphertext to: %s", args->output_file);
+    printf("[*] Writing ciphertext to: %s\n", args->output_file);
+
+    stage_start_time = start_stage_timer();
+    return_code = write_uint8_to_file(args->output_file, rekeyed_ciphertext, rekeyed_ciphertext_size);
+
+    if (STATUS_SUCCESS(return_code))
+    {
+        stop_stage_timer(PIPELINE_STAGE_WRITE, stage_start_time, rekeyed_ciphertext_size);
+        increase_metric_counter(METRIC_COUNTER_BYTES_OUT, rekeyed_ciphertext_size);
+        log_info("Ciphertext written successfully.");
+    }
+
+cleanup:
+    free(serialized_ciphertext);
+    free(rekeyed_ciphertext);
+    free_secrets(&old_secrets);
+    free_secrets(&new_secrets);
+    free((void*)args);
+    return return_code;
+}
+
+STATUS_CODE handle_batch_mode(const BatchArguments* args)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    BatchJobList jobs = {0};
+    BatchConfiguration configuration = {0};
+    BatchSummary summary = {0};
+
+    if (!args || !args->input || (args->is_directory && (!args->output_directory || !args->key)) || (0 == args->memory_budget_in_megabytes))
+    {
+        log_error("Invalid arguments in batch_mode");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    printf("[*] Starting batch %s operation...\n", args->decrypt ? "decryption" : "encryption");
+    log_info("Starting batch %s operation...", args->decrypt ? "decryption" : "encryption");
+
+    return_code = args->is_directory ? list_batch_directory(&jobs, args->input, args->output_directory, args->key) :
+                                       read_batch_manifest(&jobs, args->input, args->key);
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("[!] Failed to collect the files of the batch from %s", args->input);
+        goto cleanup;
+    }
+
+    configuration.direction = args->decrypt ? BATCH_DIRECTION_DECRYPT : BATCH_DIRECTION_ENCRYPT;
+    configuration.number_of_threads = (0 == args->number_of_threads) ? get_number_of_hardware_threads() : args->number_of_threads;
+    configuration.in_flight_byte_budget = (size_t)args->memory_budget_in_megabytes * (size_t)BYTES_IN_MEGABYTE;
+    configuration.key_store_byte_budget = BATCH_KEY_STORE_BYTE_BUDGET;
+    configuration.status_output = stdout;
+
+    log_info("Processing %u files on %u threads, %u MB in flight", jobs.number_of_jobs, configuration.number_of_threads, args->memory_budget_in_megabytes);
+
+    return_code = run_batch(&summary, &jobs, &configuration);
+    if (STATUS_FAILED(return_code) && (STATUS_CODE_BATCH_FILES_FAILED != return_code))
+    {
+        log_error("[!] Batch process failed");
+        goto cleanup;
+    }
+
+    printf("[*] Batch completed: %u succeeded, %u failed, %llu bytes in, %llu bytes out, %.3f s, %llu keys loaded, peak %.2f MB in flight\n",
+           summary.succeeded, summary.failed, (unsigned long long)summary.bytes_in, (unsigned long long)summary.bytes_out,
+           (double)summary.elapsed_ns / (double)NANOSECONDS_IN_SECOND, (unsigned long long)summary.key_store_statistics.misses,
+           (double)summary.peak_in_flight_bytes / BYTES_IN_MEGABYTE);
+    log_info("Batch completed: %u succeeded, %u failed, %llu keys loaded for %u files",
+             summary.succeeded, summary.failed, (unsigned long long)summary.key_store_statistics.misses, jobs.number_of_jobs);
+
+cleanup:
+    free_batch_jobs(&jobs);
+    free((void*)args);
+    return return_code;
+}
+
+STATUS_CODE handle_shard_mode(const ShardArguments* args)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    ShardConfiguration configuration = {0};
+    ShardSummary summary = {0};
+
+    if (!args || !args->input_file || !args->output_file || !args->key || (0 == args->shard_size_in_megabytes))
+    {
+        log_error("Invalid arguments in shard_mode");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    printf("[*] Starting sharded %s operation...\n", args->decrypt ? "decryption" : "encryption");
+    log_info("Starting sharded %s operation...", args->decrypt ? "decryption" : "encryption");
+
+    configuration.direction = args->decrypt ? SHARD_DIRECTION_DECRYPT : SHARD_DIRECTION_ENCRYPT;
+    configuration.format = ((NULL != args->format) && (0 == strcmp(args->format, FORMAT_TEXT))) ? CIPHERTEXT_FORMAT_TEXT : CIPHERTEXT_FORMAT_BINARY;
+    configuration.number_of_workers = (0 == args->number_of_workers) ? get_number_of_hardware_threads() : args->number_of_workers;
+    configuration.shard_size = (uint64_t)(args->shard_size_in_megabytes * BYTES_IN_MEGABYTE);
+    configuration.number_of_retries = args->number_of_retries;
+    configuration.status_output = stdout;
+
+    log_info("Sharding %s on %u worker processes, %u MB shards, %u retries", args->input_file, configuration.number_of_workers,
+             args->shard_size_in_megabytes, args->number_of_retries);
+
+    return_code = run_shard_coordinator(&summary, args->output_file, args->input_file, args->key, &configuration);
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("[!] Sharded process failed");
+        goto cleanup;
+    }
+
+    printf("[*] Sharded %s completed: %u shards, %llu bytes in, %llu bytes out, %.3f s, %u workers started, %u retries\n",
+           args->decrypt ? "decryption" : "encryption", summary.number_of_shards, (unsigned long long)summary.bytes_in,
+           (unsigned long long)summary.bytes_out, (double)summary.elapsed_ns / (double)NANOSECONDS_IN_SECOND,
+           summary.workers_started, summary.retries);
+    log_info("Sharded %s completed: %u shards, %u retries", args->decrypt ? "decryption" : "encryption", summary.number_of_shards, summary.retries);
+
+cleanup:
+    free((void*)args);
+    return return_code;
+}
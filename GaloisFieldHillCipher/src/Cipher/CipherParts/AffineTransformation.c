@@ -85,3 +85,43 @@ cleanup:
     free(transformed_vector);
     return return_code;
 }
+
+STATUS_CODE combine_error_vectors(FieldVector* out_combined_error_vector, int64_t** error_vectors, uint32_t number_of_error_vectors, uint32_t dimension, uint32_t prime_field)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    FieldVector combined_error_vector = {0};
+    uint32_t error_vector_index = 0;
+    size_t element_index = 0;
+    int64_t combined_element = 0;
+
+    if ((NULL == out_combined_error_vector) || (NULL == error_vectors) || (0 == prime_field))
+    {
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    return_code = allocate_field_vector(&combined_error_vector, dimension, prime_field);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    for (element_index = 0; element_index < dimension; ++element_index)
+    {
+        combined_element = 0;
+        for (error_vector_index = 0; error_vector_index < number_of_error_vectors; ++error_vector_index)
+        {
+            combined_element = (combined_element +
+                (error_vectors[error_vector_index][element_index] % prime_field) + prime_field) % prime_field;
+        }
+        set_field_vector_element(&combined_error_vector, element_index, (uint32_t)combined_element);
+    }
+
+    *out_combined_error_vector = combined_error_vector;
+    combined_error_vector.elements = NULL;
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free_field_vector(&combined_error_vector);
+    return return_code;
+}
@@ -194,3 +194,53 @@ cleanup:
     free(number_string);
     return return_code;
 }
+
+STATUS_CODE build_ascii_to_digit_table(int8_t* out_table, uint8_t** digit_to_ascii, uint32_t number_of_letters)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    size_t variant = 0, digit = 0;
+
+    if (!out_table || !digit_to_ascii)
+    {
+        log_error("[!] Invalid arguments in build_ascii_to_digit_table");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    memset(out_table, UNMAPPED_ASCII_CHARACTER, ASCII_TABLE_SIZE * sizeof(int8_t));
+
+    // Iterate in reverse so the first matching digit wins, same as ascii_char_to_digit
+    for (digit = MAX_DIGIT + 1; digit > 0; --digit)
+    {
+        for (variant = 0; variant < number_of_letters; ++variant)
+        {
+            out_table[digit_to_ascii[digit - 1][variant]] = (int8_t)(digit - 1);
+        }
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE validate_permutation_vector(const uint8_t* permutation_vector, uint32_t digits_per_element)
+{
+    uint32_t digit_index = 0;
+
+    if (NULL == permutation_vector)
+    {
+        log_error("[!] Invalid arguments in validate_permutation_vector");
+        return STATUS_CODE_INVALID_ARGUMENT;
+    }
+
+    for (digit_index = 0; digit_index < digits_per_element; ++digit_index)
+    {
+        if (permutation_vector[digit_index] >= digits_per_element)
+        {
+            log_error("[!] Invalid permutation index: %u >= %u", permutation_vector[digit_index], digits_per_element);
+            return STATUS_CODE_INVALID_ARGUMENT;
+        }
+    }
+    return STATUS_CODE_SUCCESS;
+}
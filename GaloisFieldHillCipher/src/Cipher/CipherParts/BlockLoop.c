@@ -0,0 +1,503 @@
+#include "Cipher/CipherParts/BlockLoop.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#ifdef _WIN32
+typedef CRITICAL_SECTION BlockLoopMutex;
+typedef CONDITION_VARIABLE BlockLoopCondition;
+typedef HANDLE BlockLoopThread;
+#else
+typedef pthread_mutex_t BlockLoopMutex;
+typedef pthread_cond_t BlockLoopCondition;
+typedef pthread_t BlockLoopThread;
+#endif
+
+static const char* g_block_kernel_names[NUMBER_OF_BLOCK_KERNELS] = {
+    "block_by_block",
+    "batched",
+    "batched_interleaved",
+};
+
+/**
+ * A chunk handed to the loop, encryption reads uint8_t blocks into a field vector, decryption the other way around.
+ */
+struct BlockLoopTask {
+    const BlockMultiplier* multiplier;
+    bool is_decryption;
+    const void* input_blocks;
+    void* output_blocks;
+    uint32_t number_of_blocks;
+} typedef BlockLoopTask;
+
+struct BlockLoopWorker {
+    BlockLoopWorkers* workers;
+    uint32_t share; // The calling thread runs share 0
+    BlockLoopThread thread;
+} typedef BlockLoopWorker;
+
+struct BlockLoopWorkers {
+    BlockLoopConfiguration configuration;
+    BlockLoopMutex mutex;
+    BlockLoopCondition work_ready;
+    BlockLoopCondition work_done;
+    BlockLoopTask task;
+    uint64_t generation; // Bumped for every chunk, workers wait for it to change
+    uint32_t pending_workers;
+    STATUS_CODE status;
+    bool stopping;
+    uint32_t number_of_started_workers;
+    BlockLoopWorker* worker_list;
+};
+
+static void lock_block_loop(BlockLoopWorkers* workers)
+{
+#ifdef _WIN32
+    EnterCriticalSection(&workers->mutex);
+#else
+    pthread_mutex_lock(&workers->mutex);
+#endif
+}
+
+static void unlock_block_loop(BlockLoopWorkers* workers)
+{
+#ifdef _WIN32
+    LeaveCriticalSection(&workers->mutex);
+#else
+    pthread_mutex_unlock(&workers->mutex);
+#endif
+}
+
+static void wait_block_loop_condition(BlockLoopWorkers* workers, BlockLoopCondition* condition)
+{
+#ifdef _WIN32
+    SleepConditionVariableCS(condition, &workers->mutex, INFINITE);
+#else
+    pthread_cond_wait(condition, &workers->mutex);
+#endif
+}
+
+static void wake_block_loop_condition(BlockLoopCondition* condition)
+{
+#ifdef _WIN32
+    WakeAllConditionVariable(condition);
+#else
+    pthread_cond_broadcast(condition);
+#endif
+}
+
+static FieldVector get_field_vector_slice(const FieldVector* vector, size_t first_element, uint32_t length)
+{
+    FieldVector slice;
+
+    slice.elements = (uint8_t*)vector->elements + (first_element * get_field_element_size(vector->width));
+    slice.length = length;
+    slice.width = vector->width;
+    return slice;
+}
+
+static STATUS_CODE multiply_dense_batch(const BlockLoopTask* task, BLOCK_KERNEL kernel, uint32_t first_block, uint32_t number_of_blocks)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    const BlockMultiplier* multiplier = task->multiplier;
+    uint32_t dimension = multiplier->dimension;
+    size_t first_element = (size_t)first_block * dimension;
+    FieldVector batch = {0};
+    FieldVector block = {0};
+    uint32_t block_number = 0;
+
+    if (!task->is_decryption)
+    {
+        const uint8_t* input_blocks = (const uint8_t*)task->input_blocks + first_element;
+        batch = get_field_vector_slice((FieldVector*)task->output_blocks, first_element, number_of_blocks * dimension);
+
+        if (NULL != multiplier->column_tables)
+        {
+            return multiply_column_product_tables_with_uint8_t_blocks(&batch, multiplier->column_tables, input_blocks, number_of_blocks,
+                                                                      multiplier->offset_vector);
+        }
+        if (BLOCK_KERNEL_BLOCK_BY_BLOCK != kernel)
+        {
+            return multiply_flat_matrix_with_uint8_t_blocks(&batch, multiplier->flat_matrix, input_blocks, number_of_blocks, multiplier->offset_vector,
+                                                            dimension, multiplier->prime_field, BLOCK_KERNEL_BATCHED_INTERLEAVED == kernel);
+        }
+        for (block_number = 0; block_number < number_of_blocks; ++block_number)
+        {
+            block = get_field_vector_slice(&batch, (size_t)block_number * dimension, dimension);
+            return_code = multiply_flat_matrix_with_uint8_t_vector(&block, multiplier->flat_matrix, input_blocks + ((size_t)block_number * dimension),
+                                                                   multiplier->offset_vector, dimension, multiplier->prime_field);
+            if (STATUS_FAILED(return_code))
+            {
+                return return_code;
+            }
+        }
+    }
+    else
+    {
+        uint8_t* output_blocks = (uint8_t*)task->output_blocks + first_element;
+        batch = get_field_vector_slice((const FieldVector*)task->input_blocks, first_element, number_of_blocks * dimension);
+
+        if (BLOCK_KERNEL_BLOCK_BY_BLOCK != kernel)
+        {
+            return multiply_flat_matrix_with_field_blocks(output_blocks, multiplier->flat_matrix, &batch, number_of_blocks,
+                                                          dimension, multiplier->prime_field, BLOCK_KERNEL_BATCHED_INTERLEAVED == kernel);
+        }
+        for (block_number = 0; block_number < number_of_blocks; ++block_number)
+        {
+            block = get_field_vector_slice(&batch, (size_t)block_number * dimension, dimension);
+            return_code = multiply_flat_matrix_with_field_vector(output_blocks + ((size_t)block_number * dimension), multiplier->flat_matrix, &block,
+                                                                 dimension, multiplier->prime_field);
+            if (STATUS_FAILED(return_code))
+            {
+                return return_code;
+            }
+        }
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+static STATUS_CODE run_block_loop_share(const BlockLoopTask* task, const BlockLoopConfiguration* configuration, uint32_t share)
+{
+    STATUS_CODE return_code = STATUS_CODE_SUCCESS;
+    uint32_t first_block = (uint32_t)(((uint64_t)task->number_of_blocks * share) / configuration->number_of_threads);
+    uint32_t last_block = (uint32_t)(((uint64_t)task->number_of_blocks * (share + 1)) / configuration->number_of_threads);
+    uint32_t block_number = 0, blocks_in_batch = 0;
+
+    for (block_number = first_block; block_number < last_block; block_number += blocks_in_batch)
+    {
+        blocks_in_batch = ((last_block - block_number) < configuration->blocks_per_batch) ? (last_block - block_number) : configuration->blocks_per_batch;
+        return_code = multiply_dense_batch(task, configuration->kernel, block_number, blocks_in_batch);
+        if (STATUS_FAILED(return_code))
+        {
+            break;
+        }
+    }
+
+    return return_code;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI block_loop_worker(LPVOID argument)
+#else
+static void* block_loop_worker(void* argument)
+#endif
+{
+    BlockLoopWorker* worker = (BlockLoopWorker*)argument;
+    BlockLoopWorkers* workers = worker->workers;
+    BlockLoopTask task;
+    uint64_t seen_generation = 0;
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+
+    lock_block_loop(workers);
+    for (;;)
+    {
+        while (!workers->stopping && (workers->generation == seen_generation))
+        {
+            wait_block_loop_condition(workers, &workers->work_ready);
+        }
+        if (workers->stopping)
+        {
+            break;
+        }
+        seen_generation = workers->generation;
+        task = workers->task;
+        unlock_block_loop(workers);
+
+        return_code = run_block_loop_share(&task, &workers->configuration, worker->share);
+
+        lock_block_loop(workers);
+        if (STATUS_FAILED(return_code) && STATUS_SUCCESS(workers->status))
+        {
+            workers->status = return_code;
+        }
+        if (0 == --workers->pending_workers)
+        {
+            wake_block_loop_condition(&workers->work_done);
+        }
+    }
+    unlock_block_loop(workers);
+
+    return 0;
+}
+
+static STATUS_CODE run_block_loop_task(BlockLoop* loop, const BlockLoopTask* task)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    BlockLoopWorkers* workers = loop->workers;
+    const BlockMultiplier* multiplier = task->multiplier;
+    FieldVector block = {0};
+    uint32_t block_number = 0;
+
+    if (NULL != multiplier->circulant_key)
+    {
+        for (block_number = 0; block_number < task->number_of_blocks; ++block_number)
+        {
+            if (!task->is_decryption)
+            {
+                block = get_field_vector_slice((FieldVector*)task->output_blocks, (size_t)block_number * multiplier->dimension, multiplier->dimension);
+                return_code = multiply_circulant_with_uint8_t_vector(&block, multiplier->circulant_key,
+                                                                     (const uint8_t*)task->input_blocks + ((size_t)block_number * multiplier->dimension), multiplier->offset_vector);
+            }
+            else
+            {
+                block = get_field_vector_slice((const FieldVector*)task->input_blocks, (size_t)block_number * multiplier->dimension, multiplier->dimension);
+                return_code = multiply_circulant_with_field_vector((uint8_t*)task->output_blocks + ((size_t)block_number * multiplier->dimension),
+                                                                   multiplier->circulant_key, &block);
+            }
+            if (STATUS_FAILED(return_code))
+            {
+                return return_code;
+            }
+        }
+        return STATUS_CODE_SUCCESS;
+    }
+
+    if (NULL == workers)
+    {
+        return run_block_loop_share(task, &loop->configuration, 0);
+    }
+
+    lock_block_loop(workers);
+    workers->task = *task;
+    workers->status = STATUS_CODE_SUCCESS;
+    workers->pending_workers = workers->number_of_started_workers;
+    ++workers->generation;
+    wake_block_loop_condition(&workers->work_ready);
+    unlock_block_loop(workers);
+
+    return_code = run_block_loop_share(task, &loop->configuration, 0);
+
+    lock_block_loop(workers);
+    while (0 != workers->pending_workers)
+    {
+        wait_block_loop_condition(workers, &workers->work_done);
+    }
+    if (STATUS_SUCCESS(return_code))
+    {
+        return_code = workers->status;
+    }
+    unlock_block_loop(workers);
+
+    return return_code;
+}
+
+void get_default_block_loop_configuration(BlockLoopConfiguration* out_configuration)
+{
+    if (NULL == out_configuration)
+    {
+        return;
+    }
+
+    out_configuration->kernel = BLOCK_KERNEL_BLOCK_BY_BLOCK;
+    out_configuration->blocks_per_batch = DEFAULT_BLOCKS_PER_BATCH;
+    out_configuration->number_of_threads = DEFAULT_NUMBER_OF_BLOCK_LOOP_THREADS;
+}
+
+STATUS_CODE validate_block_loop_configuration(const BlockLoopConfiguration* configuration)
+{
+    if ((NULL == configuration) || (configuration->kernel >= NUMBER_OF_BLOCK_KERNELS) ||
+        (0 == configuration->blocks_per_batch) || (configuration->blocks_per_batch > MAXIMAL_BLOCKS_PER_BATCH) ||
+        (0 == configuration->number_of_threads) || (configuration->number_of_threads > MAXIMAL_NUMBER_OF_BLOCK_LOOP_THREADS))
+    {
+        log_error("[!] Invalid block loop configuration");
+        return STATUS_CODE_INVALID_ARGUMENT;
+    }
+    return STATUS_CODE_SUCCESS;
+}
+
+const char* get_block_kernel_name(BLOCK_KERNEL kernel)
+{
+    return (kernel < NUMBER_OF_BLOCK_KERNELS) ? g_block_kernel_names[kernel] : "unknown";
+}
+
+STATUS_CODE parse_block_kernel_name(BLOCK_KERNEL* out_kernel, const char* name)
+{
+    size_t kernel = 0;
+
+    if ((NULL == out_kernel) || (NULL == name))
+    {
+        log_error("[!] Invalid arguments in parse_block_kernel_name");
+        return STATUS_CODE_INVALID_ARGUMENT;
+    }
+
+    for (kernel = 0; kernel < NUMBER_OF_BLOCK_KERNELS; ++kernel)
+    {
+        if (0 == strcmp(name, g_block_kernel_names[kernel]))
+        {
+            *out_kernel = (BLOCK_KERNEL)kernel;
+            return STATUS_CODE_SUCCESS;
+        }
+    }
+
+    log_error("[!] Unknown block kernel %s", name);
+    return STATUS_CODE_INVALID_ARGUMENT;
+}
+
+STATUS_CODE initialize_block_loop(BlockLoop* out_loop, const BlockLoopConfiguration* configuration)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    BlockLoopWorkers* workers = NULL;
+    BlockLoopWorker* worker = NULL;
+    uint32_t share = 0;
+
+    if ((NULL == out_loop) || STATUS_FAILED(validate_block_loop_configuration(configuration)))
+    {
+        log_error("[!] Invalid arguments in initialize_block_loop");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    memset(out_loop, 0, sizeof(*out_loop));
+    out_loop->configuration = *configuration;
+    if (1 == configuration->number_of_threads)
+    {
+        return_code = STATUS_CODE_SUCCESS;
+        goto cleanup;
+    }
+
+    workers = (BlockLoopWorkers*)calloc(1, sizeof(BlockLoopWorkers));
+    if (NULL != workers)
+    {
+        workers->worker_list = (BlockLoopWorker*)calloc(configuration->number_of_threads - 1, sizeof(BlockLoopWorker));
+    }
+    if ((NULL == workers) || (NULL == workers->worker_list))
+    {
+        log_error("[!] Memory allocation failed in initialize_block_loop");
+        free(workers);
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    increase_metric_counter(METRIC_COUNTER_ALLOCATIONS, 2);
+
+    workers->configuration = *configuration;
+    workers->status = STATUS_CODE_SUCCESS;
+#ifdef _WIN32
+    InitializeCriticalSection(&workers->mutex);
+    InitializeConditionVariable(&workers->work_ready);
+    InitializeConditionVariable(&workers->work_done);
+#else
+    pthread_mutex_init(&workers->mutex, NULL);
+    pthread_cond_init(&workers->work_ready, NULL);
+    pthread_cond_init(&workers->work_done, NULL);
+#endif
+    out_loop->workers = workers;
+
+    for (share = 1; share < configuration->number_of_threads; ++share)
+    {
+        worker = &workers->worker_list[share - 1];
+        worker->workers = workers;
+        worker->share = share;
+#ifdef _WIN32
+        worker->thread = CreateThread(NULL, 0, block_loop_worker, worker, 0, NULL);
+        if (NULL == worker->thread)
+#else
+        if (0 != pthread_create(&worker->thread, NULL, block_loop_worker, worker))
+#endif
+        {
+            log_error("[!] Failed to start block loop worker %u", share);
+            return_code = STATUS_CODE_COULDNT_START_THREAD;
+            goto cleanup;
+        }
+        ++workers->number_of_started_workers;
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    if (STATUS_FAILED(return_code))
+    {
+        free_block_loop(out_loop);
+    }
+    return return_code;
+}
+
+void free_block_loop(BlockLoop* loop)
+{
+    BlockLoopWorkers* workers = NULL;
+    uint32_t worker_index = 0;
+
+    if ((NULL == loop) || (NULL == loop->workers))
+    {
+        return;
+    }
+
+    workers = loop->workers;
+    lock_block_loop(workers);
+    workers->stopping = true;
+    wake_block_loop_condition(&workers->work_ready);
+    unlock_block_loop(workers);
+
+    for (worker_index = 0; worker_index < workers->number_of_started_workers; ++worker_index)
+    {
+#ifdef _WIN32
+        WaitForSingleObject(workers->worker_list[worker_index].thread, INFINITE);
+        CloseHandle(workers->worker_list[worker_index].thread);
+#else
+        pthread_join(workers->worker_list[worker_index].thread, NULL);
+#endif
+    }
+
+#ifdef _WIN32
+    DeleteCriticalSection(&workers->mutex);
+#else
+    pthread_cond_destroy(&workers->work_done);
+    pthread_cond_destroy(&workers->work_ready);
+    pthread_mutex_destroy(&workers->mutex);
+#endif
+    free(workers->worker_list);
+    free(workers);
+    loop->workers = NULL;
+}
+
+uint32_t get_block_loop_chunk_size(const BlockLoop* loop)
+{
+    if (NULL == loop)
+    {
+        return DEFAULT_BLOCKS_PER_BATCH;
+    }
+    return loop->configuration.blocks_per_batch * loop->configuration.number_of_threads;
+}
+
+STATUS_CODE multiply_uint8_t_blocks(FieldVector* out_blocks, BlockLoop* loop, const BlockMultiplier* multiplier, const uint8_t* blocks, uint32_t number_of_blocks)
+{
+    BlockLoopTask task;
+
+    if ((NULL == out_blocks) || (NULL == loop) || (NULL == multiplier) || (NULL == blocks) || (0 == multiplier->dimension) ||
+        ((NULL == multiplier->flat_matrix) == (NULL == multiplier->circulant_key)) ||
+        ((NULL != multiplier->column_tables) && ((NULL == multiplier->flat_matrix) || (multiplier->column_tables->dimension != multiplier->dimension))) ||
+        (out_blocks->length < ((uint64_t)number_of_blocks * multiplier->dimension)))
+    {
+        log_error("[!] Invalid arguments in multiply_uint8_t_blocks");
+        return STATUS_CODE_INVALID_ARGUMENT;
+    }
+
+    task.multiplier = multiplier;
+    task.is_decryption = false;
+    task.input_blocks = blocks;
+    task.output_blocks = out_blocks;
+    task.number_of_blocks = number_of_blocks;
+    return run_block_loop_task(loop, &task);
+}
+
+STATUS_CODE multiply_field_blocks(uint8_t* out_blocks, BlockLoop* loop, const BlockMultiplier* multiplier, const FieldVector* blocks, uint32_t number_of_blocks)
+{
+    BlockLoopTask task;
+
+    if ((NULL == out_blocks) || (NULL == loop) || (NULL == multiplier) || (NULL == blocks) || (0 == multiplier->dimension) ||
+        ((NULL == multiplier->flat_matrix) == (NULL == multiplier->circulant_key)) ||
+        (blocks->length < ((uint64_t)number_of_blocks * multiplier->dimension)))
+    {
+        log_error("[!] Invalid arguments in multiply_field_blocks");
+        return STATUS_CODE_INVALID_ARGUMENT;
+    }
+
+    task.multiplier = multiplier;
+    task.is_decryption = true;
+    task.input_blocks = blocks;
+    task.output_blocks = out_blocks;
+    task.number_of_blocks = number_of_blocks;
+    return run_block_loop_task(loop, &task);
+}
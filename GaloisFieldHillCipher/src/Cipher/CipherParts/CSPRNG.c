@@ -1,5 +1,90 @@
 #include "Cipher/CipherParts/CSPRNG.h"
 
+#if defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
+#define SEEDED_STREAM_NONCE_SIZE (crypto_stream_chacha20_NONCEBYTES)
+
+static THREAD_LOCAL SeededRandomStream g_seeded_random_stream;
+
+static void draw_seeded_random_bytes(uint8_t* out_buffer, size_t size)
+{
+	uint8_t nonce[SEEDED_STREAM_NONCE_SIZE];
+	size_t index = 0, byte = 0;
+
+	for (index = 0; index < size; ++index)
+	{
+		if (g_seeded_random_stream.position >= SECURE_RANDOM_POOL_SIZE)
+		{
+			// Little endian refill counter as the nonce, so every refill is an independent keystream
+			for (byte = 0; byte < SEEDED_STREAM_NONCE_SIZE; ++byte)
+			{
+				nonce[byte] = (uint8_t)(g_seeded_random_stream.refill_counter >> (byte * CHAR_BIT));
+			}
+			crypto_stream_chacha20(g_seeded_random_stream.buffer, SECURE_RANDOM_POOL_SIZE, nonce, g_seeded_random_stream.seed);
+			++g_seeded_random_stream.refill_counter;
+			g_seeded_random_stream.position = 0;
+		}
+		out_buffer[index] = g_seeded_random_stream.buffer[g_seeded_random_stream.position++];
+	}
+}
+
+static uint32_t draw_seeded_uniform_number(uint32_t upper_bound)
+{
+	uint32_t random_number = 0, rejection_limit = 0;
+	uint8_t random_bytes[sizeof(uint32_t)];
+
+	if (upper_bound < 2)
+	{
+		return 0;
+	}
+
+	// Same rejection as randombytes_uniform, 2^32 mod upper_bound values at the bottom are biased
+	rejection_limit = (1U + ~upper_bound) % upper_bound;
+	do
+	{
+		draw_seeded_random_bytes(random_bytes, sizeof(random_bytes));
+		random_number = (uint32_t)random_bytes[0] | ((uint32_t)random_bytes[1] << 8) |
+			((uint32_t)random_bytes[2] << 16) | ((uint32_t)random_bytes[3] << 24);
+	} while (random_number < rejection_limit);
+
+	return random_number % upper_bound;
+}
+
+STATUS_CODE begin_seeded_random_stream(const uint8_t* seed)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+
+	if (NULL == seed)
+	{
+		return_code = STATUS_CODE_INVALID_ARGUMENT;
+		goto cleanup;
+	}
+
+	return_code = initialize_sodium_library();
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+
+	memcpy(g_seeded_random_stream.seed, seed, RANDOM_SEED_SIZE);
+	g_seeded_random_stream.refill_counter = 0;
+	g_seeded_random_stream.position = SECURE_RANDOM_POOL_SIZE;
+	g_seeded_random_stream.is_active = true;
+
+	return_code = STATUS_CODE_SUCCESS;
+cleanup:
+	return return_code;
+}
+
+void end_seeded_random_stream(void)
+{
+	sodium_memzero(&g_seeded_random_stream, sizeof(g_seeded_random_stream));
+}
+
 STATUS_CODE initialize_sodium_library()
 {
 	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
@@ -29,10 +114,156 @@ STATUS_CODE generate_secure_random_number(uint32_t* out_number, uint32_t minimum
 		goto cleanup;
 	}
 
-	*out_number = randombytes_uniform(maximum_value - minimum_value) + minimum_value;
+	if (g_seeded_random_stream.is_active)
+	{
+		*out_number = draw_seeded_uniform_number(maximum_value - minimum_value) + minimum_value;
+	}
+	else
+	{
+		*out_number = randombytes_uniform(maximum_value - minimum_value) + minimum_value;
+	}
+	increase_metric_counter(METRIC_COUNTER_RNG_BYTES_DRAWN, sizeof(uint32_t));
+
+	return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+	return return_code;
+}
+
+STATUS_CODE generate_secure_random_bytes(uint8_t* out_buffer, size_t size)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+
+	if (NULL == out_buffer)
+	{
+		return_code = STATUS_CODE_INVALID_ARGUMENT;
+		goto cleanup;
+	}
+
+	return_code = initialize_sodium_library();
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+
+	if (g_seeded_random_stream.is_active)
+	{
+		draw_seeded_random_bytes(out_buffer, size);
+	}
+	else
+	{
+		randombytes_buf(out_buffer, size);
+	}
+	increase_metric_counter(METRIC_COUNTER_RNG_BYTES_DRAWN, size);
+
+	return_code = STATUS_CODE_SUCCESS;
+cleanup:
+	return return_code;
+}
+
+STATUS_CODE initialize_secure_random_pool(SecureRandomPool* pool)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+
+	if (NULL == pool)
+	{
+		return_code = STATUS_CODE_INVALID_ARGUMENT;
+		goto cleanup;
+	}
+
+	// Mark the pool as drained so the first draw refills it
+	pool->position = SECURE_RANDOM_POOL_SIZE;
+	pool->bits = 0;
+	pool->number_of_bits_left = 0;
 
 	return_code = STATUS_CODE_SUCCESS;
+cleanup:
+	return return_code;
+}
+
+static STATUS_CODE draw_secure_random_byte(uint8_t* out_byte, SecureRandomPool* pool)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
 
+	if (pool->position >= SECURE_RANDOM_POOL_SIZE)
+	{
+		return_code = generate_secure_random_bytes(pool->buffer, SECURE_RANDOM_POOL_SIZE);
+		if (STATUS_FAILED(return_code))
+		{
+			goto cleanup;
+		}
+		pool->position = 0;
+	}
+
+	*out_byte = pool->buffer[pool->position++];
+
+	return_code = STATUS_CODE_SUCCESS;
+cleanup:
+	return return_code;
+}
+
+STATUS_CODE draw_secure_random_bit(uint8_t* out_bit, SecureRandomPool* pool)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+
+	if ((NULL == out_bit) || (NULL == pool))
+	{
+		return_code = STATUS_CODE_INVALID_ARGUMENT;
+		goto cleanup;
+	}
+
+	if (0 == pool->number_of_bits_left)
+	{
+		return_code = draw_secure_random_byte(&pool->bits, pool);
+		if (STATUS_FAILED(return_code))
+		{
+			goto cleanup;
+		}
+		pool->number_of_bits_left = CHAR_BIT;
+	}
+
+	*out_bit = pool->bits & 1;
+	pool->bits >>= 1;
+	--pool->number_of_bits_left;
+
+	return_code = STATUS_CODE_SUCCESS;
+cleanup:
+	return return_code;
+}
+
+STATUS_CODE draw_secure_random_number(uint32_t* out_number, uint32_t upper_bound, SecureRandomPool* pool)
+{
+	STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+	uint8_t random_byte = 0;
+	uint32_t rejection_limit = 0;
+
+	if ((NULL == out_number) || (NULL == pool) || (upper_bound > SECURE_RANDOM_BYTE_RANGE))
+	{
+		return_code = STATUS_CODE_INVALID_ARGUMENT;
+		goto cleanup;
+	}
+
+	if (upper_bound <= 1)
+	{
+		*out_number = 0;
+		return_code = STATUS_CODE_SUCCESS;
+		goto cleanup;
+	}
+
+	// Reject the biased tail of the byte range to keep the result uniform
+	rejection_limit = SECURE_RANDOM_BYTE_RANGE - (SECURE_RANDOM_BYTE_RANGE % upper_bound);
+	do
+	{
+		return_code = draw_secure_random_byte(&random_byte, pool);
+		if (STATUS_FAILED(return_code))
+		{
+			goto cleanup;
+		}
+	} while (random_byte >= rejection_limit);
+
+	*out_number = random_byte % upper_bound;
+
+	return_code = STATUS_CODE_SUCCESS;
 cleanup:
 	return return_code;
 }
@@ -87,25 +87,26 @@ STATUS_CODE remove_padding(uint8_t** out, uint32_t* out_bit_length, uint8_t* val
 
     log_debug("Removing padding from data of length %u bits", value_bit_length);
 
-    // Find the padding magic byte
-    for (i = 0; i < value_bit_length / BYTE_SIZE; ++i)
+    // Find the padding magic byte, searching from the end since the data itself may contain it
+    for (i = value_bit_length / BYTE_SIZE; i > 0; --i)
     {
-        if (PADDING_MAGIC == value[i])
+        if (0 != value[i - 1])
         {
-            original_bit_length = i * BYTE_SIZE;
-            log_debug("Found padding magic byte at position %u, original length=%u bits",
-                     i, original_bit_length);
             break;
         }
     }
 
-    if (i >= value_bit_length / BYTE_SIZE)
+    if ((0 == i) || (PADDING_MAGIC != value[i - 1]))
     {
         log_error("[!] Padding magic byte not found in data");
         return_code = STATUS_CODE_INVALID_ARGUMENT;
         goto cleanup;
     }
 
+    original_bit_length = (i - 1) * BYTE_SIZE;
+    log_debug("Found padding magic byte at position %u, original length=%u bits",
+             i - 1, original_bit_length);
+
     out_buffer = (uint8_t*)malloc(original_bit_length / BYTE_SIZE);
     if (NULL == out_buffer)
     {
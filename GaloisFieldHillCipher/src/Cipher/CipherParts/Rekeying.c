@@ -0,0 +1,258 @@
+#include "Cipher/CipherParts/Rekeying.h"
+
+/**
+ * @brief Gets the dense matrix of a key, expanding circulant keys.
+ *
+ * @param out_matrix - Pointer to the output matrix.
+ * @param out_is_owned - Set when the matrix was expanded and must be freed by the caller.
+ * @param secrets - The secrets holding the key.
+ * @return STATUS_CODE - Status of the operation.
+ */
+static STATUS_CODE get_dense_key_matrix(int64_t*** out_matrix, bool* out_is_owned, const Secrets* secrets)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+
+    if (KEY_STRUCTURE_CIRCULANT == secrets->key_structure)
+    {
+        return_code = expand_circulant_column(out_matrix, secrets->circulant_column, secrets->dimension);
+        *out_is_owned = STATUS_SUCCESS(return_code);
+    }
+    else
+    {
+        *out_matrix = secrets->key_matrix;
+        *out_is_owned = false;
+        return_code = STATUS_CODE_SUCCESS;
+    }
+
+    return return_code;
+}
+
+/**
+ * @brief Composes R = K' * K^-1 as a circulant key, the first column of R is K' applied to the first column of K^-1.
+ *
+ * @param out_key - Pointer to the output key.
+ * @param old_decryption_secrets - Secrets holding the circulant K^-1.
+ * @param new_encryption_secrets - Secrets holding the circulant K'.
+ * @return STATUS_CODE - Status of the operation.
+ */
+static STATUS_CODE compose_circulant_rekey_matrix(CirculantKey* out_key, const Secrets* old_decryption_secrets, const Secrets* new_encryption_secrets)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint32_t dimension = new_encryption_secrets->dimension, prime_field = new_encryption_secrets->prime_field;
+    CirculantKey new_key = {0};
+    FieldVector old_column = {0};
+    int64_t* composed_column = NULL;
+    uint32_t index = 0;
+
+    return_code = initialize_circulant_key(&new_key, new_encryption_secrets->circulant_column, dimension, prime_field);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    return_code = allocate_field_vector(&old_column, dimension, prime_field);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    for (index = 0; index < dimension; ++index)
+    {
+        set_field_vector_element(&old_column, index,
+            (uint32_t)(((old_decryption_secrets->circulant_column[index] % prime_field) + prime_field) % prime_field));
+    }
+
+    return_code = multiply_circulant_with_field_vector_over_field(&old_column, &new_key, &old_column, NULL);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    composed_column = (int64_t*)malloc(dimension * sizeof(int64_t));
+    if (NULL == composed_column)
+    {
+        log_error("[!] Memory allocation failed in compose_circulant_rekey_matrix");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    for (index = 0; index < dimension; ++index)
+    {
+        composed_column[index] = get_field_vector_element(&old_column, index);
+    }
+
+    return_code = initialize_circulant_key(out_key, composed_column, dimension, prime_field);
+
+cleanup:
+    free_circulant_key(&new_key);
+    free_field_vector(&old_column);
+    free(composed_column);
+    return return_code;
+}
+
+/**
+ * @brief Multiplies a block with R and adds an offset.
+ *
+ * @param out_block - Preallocated output block, must not be the input block.
+ * @param transform - The transform holding R.
+ * @param block - The input block.
+ * @param offset_vector - Vector added to the product, may be NULL.
+ * @return STATUS_CODE - Status of the operation.
+ */
+static STATUS_CODE multiply_with_rekey_matrix(FieldVector* out_block, RekeyTransform* transform, const FieldVector* block, const FieldVector* offset_vector)
+{
+    if (KEY_STRUCTURE_CIRCULANT == transform->key_structure)
+    {
+        return multiply_circulant_with_field_vector_over_field(out_block, &transform->circulant_key, block, offset_vector);
+    }
+    return multiply_flat_matrix_with_field_vector_over_field(out_block, &transform->flat_matrix, block, offset_vector,
+                                                             transform->dimension, transform->prime_field);
+}
+
+STATUS_CODE build_rekey_transform(RekeyTransform* out_transform, const Secrets* old_decryption_secrets, const Secrets* new_encryption_secrets)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    RekeyTransform transform = {0};
+    int64_t** old_matrix = NULL;
+    int64_t** new_matrix = NULL;
+    int64_t** composed_matrix = NULL;
+    bool is_old_matrix_owned = false, is_new_matrix_owned = false;
+    FieldVector old_error_vector = {0};
+    FieldVector new_error_vector = {0};
+    uint32_t dimension = 0, prime_field = 0, index = 0;
+
+    if ((NULL == out_transform) || (NULL == old_decryption_secrets) || (NULL == new_encryption_secrets) ||
+        (NULL == old_decryption_secrets->error_vectors) || (NULL == new_encryption_secrets->error_vectors) ||
+        ((NULL == old_decryption_secrets->key_matrix) && (NULL == old_decryption_secrets->circulant_column)) ||
+        ((NULL == new_encryption_secrets->key_matrix) && (NULL == new_encryption_secrets->circulant_column)))
+    {
+        log_error("[!] Invalid arguments in build_rekey_transform");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    if ((old_decryption_secrets->dimension != new_encryption_secrets->dimension) ||
+        (old_decryption_secrets->prime_field != new_encryption_secrets->prime_field))
+    {
+        log_error("[!] Keys must share dimension and prime field to rekey: old d=%u p=%u, new d=%u p=%u",
+                  old_decryption_secrets->dimension, old_decryption_secrets->prime_field,
+                  new_encryption_secrets->dimension, new_encryption_secrets->prime_field);
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+    dimension = new_encryption_secrets->dimension;
+    prime_field = new_encryption_secrets->prime_field;
+
+    transform.dimension = dimension;
+    transform.prime_field = prime_field;
+
+    if ((KEY_STRUCTURE_CIRCULANT == old_decryption_secrets->key_structure) &&
+        (KEY_STRUCTURE_CIRCULANT == new_encryption_secrets->key_structure))
+    {
+        log_debug("Composing circulant rekey matrix: dimension=%u", dimension);
+        transform.key_structure = KEY_STRUCTURE_CIRCULANT;
+        return_code = compose_circulant_rekey_matrix(&transform.circulant_key, old_decryption_secrets, new_encryption_secrets);
+    }
+    else
+    {
+        log_debug("Composing dense rekey matrix: dimension=%u", dimension);
+        transform.key_structure = KEY_STRUCTURE_DENSE;
+        return_code = get_dense_key_matrix(&old_matrix, &is_old_matrix_owned, old_decryption_secrets);
+        if (STATUS_SUCCESS(return_code))
+        {
+            return_code = get_dense_key_matrix(&new_matrix, &is_new_matrix_owned, new_encryption_secrets);
+        }
+        if (STATUS_SUCCESS(return_code))
+        {
+            return_code = multiply_square_matrices_over_field(&composed_matrix, new_matrix, old_matrix, dimension, prime_field);
+        }
+        if (STATUS_SUCCESS(return_code))
+        {
+            return_code = flatten_square_matrix_over_field(&transform.flat_matrix, composed_matrix, dimension, prime_field);
+        }
+    }
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("[!] Failed to compose the rekey matrix");
+        goto cleanup;
+    }
+
+    return_code = combine_error_vectors(&old_error_vector, old_decryption_secrets->error_vectors,
+                                        old_decryption_secrets->number_of_error_vectors, dimension, prime_field);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    return_code = combine_error_vectors(&new_error_vector, new_encryption_secrets->error_vectors,
+                                        new_encryption_secrets->number_of_error_vectors, dimension, prime_field);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    // offset = e' - R * e
+    return_code = allocate_field_vector(&transform.offset_vector, dimension, prime_field);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    return_code = multiply_with_rekey_matrix(&transform.offset_vector, &transform, &old_error_vector, NULL);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    for (index = 0; index < dimension; ++index)
+    {
+        set_field_vector_element(&transform.offset_vector, index, (uint32_t)(((uint64_t)get_field_vector_element(&new_error_vector, index) +
+            prime_field - get_field_vector_element(&transform.offset_vector, index)) % prime_field));
+    }
+
+    *out_transform = transform;
+    memset(&transform, 0, sizeof(transform));
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    free_rekey_transform(&transform);
+    if (is_old_matrix_owned)
+    {
+        (void)free_int64_matrix(old_matrix, dimension);
+    }
+    if (is_new_matrix_owned)
+    {
+        (void)free_int64_matrix(new_matrix, dimension);
+    }
+    if (NULL != composed_matrix)
+    {
+        (void)free_int64_matrix(composed_matrix, dimension);
+    }
+    free_field_vector(&old_error_vector);
+    free_field_vector(&new_error_vector);
+    return return_code;
+}
+
+STATUS_CODE apply_rekey_transform(FieldVector* out_block, RekeyTransform* transform, const FieldVector* block)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+
+    if ((NULL == out_block) || (NULL == transform) || (NULL == block))
+    {
+        log_error("[!] Invalid arguments in apply_rekey_transform");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    return_code = multiply_with_rekey_matrix(out_block, transform, block, &transform->offset_vector);
+
+cleanup:
+    return return_code;
+}
+
+void free_rekey_transform(RekeyTransform* transform)
+{
+    if (NULL == transform)
+    {
+        return;
+    }
+
+    free_field_vector(&transform->flat_matrix);
+    free_circulant_key(&transform->circulant_key);
+    free_field_vector(&transform->offset_vector);
+}
@@ -0,0 +1,519 @@
+#include "Cipher/CipherPipeline.h"
+#include "Instrumentation/Metrics.h"
+#include "Instrumentation/StageTimers.h"
+#include "Tuning/Autotuner.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#ifdef _WIN32
+typedef HANDLE CipherPipelineThread;
+#define ATOMIC_STORE(pointer, value) ((void)InterlockedExchange64((volatile LONG64*)(pointer), (LONG64)(value)))
+#else
+typedef pthread_t CipherPipelineThread;
+#define ATOMIC_STORE(pointer, value) __atomic_store_n((pointer), (value), __ATOMIC_RELEASE)
+#endif
+
+/**
+ * The buffers of one chunk on its way through every stage, each stage fills the part the next one reads.
+ */
+struct CipherPipelineChunk {
+    uint8_t* plaintext; // read_size bytes
+    size_t plaintext_size;
+    uint8_t* blocks; // maximum_blocks * dimension bytes, the expanded plaintext in whole blocks
+    uint32_t number_of_blocks;
+    FieldVector ciphertext; // maximum_blocks * dimension elements
+    uint8_t* serialized; // maximum_blocks * dimension * element_size bytes and the text null terminator
+    size_t serialized_size;
+    bool is_last;
+} typedef CipherPipelineChunk;
+
+struct CipherPipeline {
+    FILE* input;
+    FILE* output;
+    const CipherContext* context;
+    CIPHERTEXT_FORMAT format;
+    uint32_t element_size;
+    uint32_t read_size;
+    CirculantKey circulant_key_view;
+    BlockLoop block_loop;
+    BlockMultiplier multiplier;
+    SpscQueue* queues[NUMBER_OF_CIPHER_PIPELINE_STAGES]; // queues[stage] carries the chunks a stage is done with to the next stage, the write stage's back to the read stage
+    CipherPipelineChunk chunks[CIPHER_PIPELINE_NUMBER_OF_CHUNKS];
+    uint64_t aborted; // Atomic, raised by the first stage to fail so the others stop waiting on their queues
+    STATUS_CODE stage_status[NUMBER_OF_CIPHER_PIPELINE_STAGES];
+    uint64_t total_read; // Every total is written by a single stage and read once the threads are joined
+    uint64_t total_written;
+    uint64_t total_blocks;
+} typedef CipherPipeline;
+
+struct CipherPipelineWorker {
+    CipherPipeline* pipeline;
+    CIPHER_PIPELINE_STAGE stage;
+} typedef CipherPipelineWorker;
+
+static STATUS_CODE run_read_stage(CipherPipeline* pipeline, CipherPipelineChunk* chunk)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint64_t stage_start_time = start_stage_timer();
+
+    // fread keeps reading a pipe until the chunk is full, so only the last chunk is short
+    chunk->plaintext_size = fread(chunk->plaintext, 1, pipeline->read_size, pipeline->input);
+    if ((chunk->plaintext_size < pipeline->read_size) && ferror(pipeline->input))
+    {
+        log_error("[!] Failed to read the plaintext stream");
+        return_code = STATUS_CODE_COULDNT_READ_FILE;
+        goto cleanup;
+    }
+    chunk->is_last = (chunk->plaintext_size < pipeline->read_size);
+    stop_stage_timer(PIPELINE_STAGE_READ, stage_start_time, chunk->plaintext_size);
+    pipeline->total_read += chunk->plaintext_size;
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
+
+static STATUS_CODE run_expand_stage(CipherPipeline* pipeline, CipherPipelineChunk* chunk, uint8_t* carried_bytes, size_t* carried_size, SecureRandomPool* random_pool)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    const Secrets* secrets = &pipeline->context->secrets;
+    size_t expanded_size = 0, blocks_size = *carried_size;
+    uint64_t stage_start_time = start_stage_timer();
+
+    // The partial block left by the previous chunk starts this one
+    memcpy(chunk->blocks, carried_bytes, blocks_size);
+    return_code = expand_plaintext_chunk(chunk->blocks + blocks_size, &expanded_size, chunk->plaintext, chunk->plaintext_size,
+        secrets->number_of_random_bits_to_add, random_pool);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    blocks_size += expanded_size;
+
+    if (chunk->is_last)
+    {
+        chunk->blocks[blocks_size++] = PADDING_MAGIC;
+        while (0 != (blocks_size % secrets->dimension))
+        {
+            chunk->blocks[blocks_size++] = 0;
+        }
+    }
+    stop_stage_timer(PIPELINE_STAGE_RANDOM_BIT_EXPANSION, stage_start_time, expanded_size);
+
+    chunk->number_of_blocks = (uint32_t)(blocks_size / secrets->dimension);
+    *carried_size = blocks_size % secrets->dimension;
+    memcpy(carried_bytes, chunk->blocks + ((size_t)chunk->number_of_blocks * secrets->dimension), *carried_size);
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
+
+static STATUS_CODE run_multiply_stage(CipherPipeline* pipeline, CipherPipelineChunk* chunk)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint64_t stage_start_time = start_stage_timer();
+
+    if (0 != chunk->number_of_blocks)
+    {
+        return_code = multiply_uint8_t_blocks(&chunk->ciphertext, &pipeline->block_loop, &pipeline->multiplier, chunk->blocks, chunk->number_of_blocks);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+        stop_stage_timer(PIPELINE_STAGE_BLOCK_MULTIPLY, stage_start_time, (uint64_t)chunk->number_of_blocks * pipeline->multiplier.dimension);
+        pipeline->total_blocks += chunk->number_of_blocks;
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
+
+static STATUS_CODE run_encode_stage(CipherPipeline* pipeline, CipherPipelineChunk* chunk, uint8_t* digits_buffer, SecureRandomPool* random_pool)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    size_t chunk_elements = (size_t)chunk->number_of_blocks * pipeline->multiplier.dimension;
+
+    return_code = serialize_ciphertext_chunk(chunk->serialized, &chunk->ciphertext, chunk_elements, pipeline->element_size, digits_buffer,
+        &pipeline->context->secrets, random_pool, pipeline->format);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    chunk->serialized_size = chunk_elements * pipeline->element_size;
+
+    if (chunk->is_last && (CIPHERTEXT_FORMAT_TEXT == pipeline->format))
+    {
+        chunk->serialized[chunk->serialized_size++] = '\0';
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
+
+static STATUS_CODE run_write_stage(CipherPipeline* pipeline, CipherPipelineChunk* chunk)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint64_t stage_start_time = start_stage_timer();
+
+    if ((0 != chunk->serialized_size) && (fwrite(chunk->serialized, 1, chunk->serialized_size, pipeline->output) != chunk->serialized_size))
+    {
+        log_error("[!] Failed to write the ciphertext stream");
+        return_code = STATUS_CODE_COULDNT_WRITE_FILE;
+        goto cleanup;
+    }
+    if (chunk->is_last && (0 != fflush(pipeline->output)))
+    {
+        log_error("[!] Failed to write the ciphertext stream");
+        return_code = STATUS_CODE_COULDNT_WRITE_FILE;
+        goto cleanup;
+    }
+    stop_stage_timer(PIPELINE_STAGE_WRITE, stage_start_time, chunk->serialized_size);
+    pipeline->total_written += chunk->serialized_size;
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
+
+/**
+ * @brief Runs a stage until it has passed the last chunk on, taking chunks from the queue of the stage before it.
+ *
+ * @param pipeline - The pipeline.
+ * @param stage - The stage to run.
+ * @return STATUS_CODE - Status of the operation.
+ */
+static STATUS_CODE run_cipher_pipeline_stage(CipherPipeline* pipeline, CIPHER_PIPELINE_STAGE stage)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    SpscQueue* input_queue = pipeline->queues[(stage + NUMBER_OF_CIPHER_PIPELINE_STAGES - 1) % NUMBER_OF_CIPHER_PIPELINE_STAGES];
+    SpscQueue* output_queue = pipeline->queues[stage];
+    CipherPipelineChunk* chunk = NULL;
+    uint8_t* carried_bytes = NULL;
+    uint8_t* digits_buffer = NULL;
+    size_t carried_size = 0;
+    bool is_last = false;
+    SecureRandomPool random_pool;
+
+    if ((CIPHER_PIPELINE_STAGE_EXPAND == stage) || (CIPHER_PIPELINE_STAGE_ENCODE == stage))
+    {
+        // Every stage drawing random bits has a pool of its own
+        return_code = initialize_secure_random_pool(&random_pool);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+        if (CIPHER_PIPELINE_STAGE_EXPAND == stage)
+        {
+            carried_bytes = (uint8_t*)malloc(pipeline->multiplier.dimension);
+        }
+        else
+        {
+            digits_buffer = (uint8_t*)malloc(pipeline->element_size);
+        }
+        if ((NULL == carried_bytes) && (NULL == digits_buffer))
+        {
+            log_error("[!] Memory allocation failed in run_cipher_pipeline_stage");
+            return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+            goto cleanup;
+        }
+        increase_metric_counter(METRIC_COUNTER_ALLOCATIONS, 1);
+    }
+
+    while (!is_last)
+    {
+        return_code = pop_spsc_queue((void**)&chunk, input_queue);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+
+        switch (stage)
+        {
+        case CIPHER_PIPELINE_STAGE_READ:
+            return_code = run_read_stage(pipeline, chunk);
+            break;
+        case CIPHER_PIPELINE_STAGE_EXPAND:
+            return_code = run_expand_stage(pipeline, chunk, carried_bytes, &carried_size, &random_pool);
+            break;
+        case CIPHER_PIPELINE_STAGE_MULTIPLY:
+            return_code = run_multiply_stage(pipeline, chunk);
+            break;
+        case CIPHER_PIPELINE_STAGE_ENCODE:
+            return_code = run_encode_stage(pipeline, chunk, digits_buffer, &random_pool);
+            break;
+        default:
+            return_code = run_write_stage(pipeline, chunk);
+            break;
+        }
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+
+        // The chunk belongs to the next stage once it is pushed
+        is_last = chunk->is_last;
+        return_code = push_spsc_queue(output_queue, chunk);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    if (STATUS_FAILED(return_code))
+    {
+        ATOMIC_STORE(&pipeline->aborted, 1);
+    }
+    pipeline->stage_status[stage] = return_code;
+    free(carried_bytes);
+    free(digits_buffer);
+    return return_code;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI cipher_pipeline_worker(LPVOID argument)
+#else
+static void* cipher_pipeline_worker(void* argument)
+#endif
+{
+    CipherPipelineWorker* worker = (CipherPipelineWorker*)argument;
+
+    (void)run_cipher_pipeline_stage(worker->pipeline, worker->stage);
+    return 0;
+}
+
+static STATUS_CODE initialize_cipher_pipeline_chunks(CipherPipeline* pipeline, uint32_t maximum_blocks)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    const Secrets* secrets = &pipeline->context->secrets;
+    size_t block_bytes = (size_t)maximum_blocks * secrets->dimension;
+    CipherPipelineChunk* chunk = NULL;
+    uint32_t chunk_index = 0;
+
+    for (chunk_index = 0; chunk_index < CIPHER_PIPELINE_NUMBER_OF_CHUNKS; ++chunk_index)
+    {
+        chunk = &pipeline->chunks[chunk_index];
+        chunk->plaintext = (uint8_t*)malloc(pipeline->read_size);
+        chunk->blocks = (uint8_t*)malloc(block_bytes);
+        chunk->serialized = (uint8_t*)malloc((block_bytes * pipeline->element_size) + 1);
+        if ((NULL == chunk->plaintext) || (NULL == chunk->blocks) || (NULL == chunk->serialized))
+        {
+            log_error("[!] Memory allocation failed in initialize_cipher_pipeline_chunks");
+            return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+            goto cleanup;
+        }
+        increase_metric_counter(METRIC_COUNTER_ALLOCATIONS, 3);
+
+        return_code = allocate_field_vector(&chunk->ciphertext, (uint32_t)block_bytes, secrets->prime_field);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+
+        // Every chunk starts free, queued for the read stage
+        return_code = push_spsc_queue(pipeline->queues[CIPHER_PIPELINE_STAGE_WRITE], chunk);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
+
+static void free_cipher_pipeline(CipherPipeline* pipeline)
+{
+    uint32_t index = 0;
+
+    for (index = 0; index < CIPHER_PIPELINE_NUMBER_OF_CHUNKS; ++index)
+    {
+        free(pipeline->chunks[index].plaintext);
+        free(pipeline->chunks[index].blocks);
+        free(pipeline->chunks[index].serialized);
+        free_field_vector(&pipeline->chunks[index].ciphertext);
+    }
+    for (index = 0; index < NUMBER_OF_CIPHER_PIPELINE_STAGES; ++index)
+    {
+        free_spsc_queue(&pipeline->queues[index]);
+    }
+    free_block_loop(&pipeline->block_loop);
+    free_circulant_key_view(&pipeline->circulant_key_view);
+}
+
+STATUS_CODE encrypt_stream_pipelined_with_context(FILE* output, FILE* input, const CipherContext* context, CIPHERTEXT_FORMAT format,
+    uint64_t* out_bytes_read, uint64_t* out_bytes_written)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    CipherPipeline pipeline;
+    CipherPipelineWorker workers[NUMBER_OF_CIPHER_PIPELINE_STAGES];
+    CipherPipelineThread threads[NUMBER_OF_CIPHER_PIPELINE_STAGES];
+    BlockLoopConfiguration block_loop_configuration;
+    const Secrets* secrets = NULL;
+    uint32_t group_size = 0, maximum_blocks = 0, hardware_threads = 0, number_of_started_threads = 0, stage = 0;
+
+    memset(&pipeline, 0, sizeof(pipeline));
+
+    if ((NULL == output) || (NULL == input) || (NULL == context) || (format >= NUMBER_OF_CIPHERTEXT_FORMATS))
+    {
+        log_error("[!] Invalid arguments in encrypt_stream_pipelined_with_context");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+    secrets = &context->secrets;
+
+    if ((CIPHERTEXT_FORMAT_TEXT == format) && STATUS_FAILED(context->text_format_status))
+    {
+        log_error("[!] The key can't be used with text ciphertexts");
+        return_code = context->text_format_status;
+        goto cleanup;
+    }
+
+    if (context->is_gf2)
+    {
+        log_error("[!] Keys over GF(2) can't be used with streams, encrypt the whole file instead");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    pipeline.input = input;
+    pipeline.output = output;
+    pipeline.context = context;
+    pipeline.format = format;
+    pipeline.element_size = (CIPHERTEXT_FORMAT_BINARY == format) ?
+        calculate_bytes_per_element(secrets->prime_field) :
+        calculate_digits_per_element(secrets->prime_field);
+
+    // The same chunking as encrypt_stream_with_context, so both write the same ciphertext
+    group_size = BYTE_SIZE + secrets->number_of_random_bits_to_add;
+    pipeline.read_size = CIPHER_STREAM_CHUNK_SIZE - (CIPHER_STREAM_CHUNK_SIZE % BYTE_SIZE);
+    maximum_blocks = (uint32_t)((((uint64_t)pipeline.read_size / BYTE_SIZE) * group_size) / secrets->dimension) + 2;
+
+    if (context->is_circulant)
+    {
+        return_code = create_circulant_key_view(&pipeline.circulant_key_view, &context->circulant_key);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+    }
+
+    // A tuned configuration is kept, an untuned dense loop gets the hardware threads the other stages leave
+    block_loop_configuration = context->block_loop_configuration;
+    hardware_threads = get_number_of_hardware_threads();
+    if (!context->is_circulant && (1 == block_loop_configuration.number_of_threads) && (hardware_threads >= NUMBER_OF_CIPHER_PIPELINE_STAGES))
+    {
+        block_loop_configuration.number_of_threads = hardware_threads - (NUMBER_OF_CIPHER_PIPELINE_STAGES - 1);
+        if (block_loop_configuration.number_of_threads > MAXIMAL_NUMBER_OF_BLOCK_LOOP_THREADS)
+        {
+            block_loop_configuration.number_of_threads = MAXIMAL_NUMBER_OF_BLOCK_LOOP_THREADS;
+        }
+    }
+    return_code = initialize_block_loop(&pipeline.block_loop, &block_loop_configuration);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    pipeline.multiplier.dimension = secrets->dimension;
+    pipeline.multiplier.prime_field = secrets->prime_field;
+    pipeline.multiplier.flat_matrix = context->is_circulant ? NULL : &context->flat_key_matrix;
+    pipeline.multiplier.circulant_key = context->is_circulant ? &pipeline.circulant_key_view : NULL;
+    pipeline.multiplier.column_tables = context->has_column_tables ? &context->column_tables : NULL;
+    pipeline.multiplier.offset_vector = &context->combined_error_vector;
+
+    for (stage = 0; stage < NUMBER_OF_CIPHER_PIPELINE_STAGES; ++stage)
+    {
+        return_code = create_spsc_queue(&pipeline.queues[stage], CIPHER_PIPELINE_NUMBER_OF_CHUNKS, &pipeline.aborted);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+    }
+
+    return_code = initialize_cipher_pipeline_chunks(&pipeline, maximum_blocks);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    log_info("Starting pipelined stream encryption: dimension=%u, chunk=%u bytes, %u chunks in flight, %u multiply threads",
+        secrets->dimension, pipeline.read_size, CIPHER_PIPELINE_NUMBER_OF_CHUNKS, block_loop_configuration.number_of_threads);
+
+    // The calling thread runs the write stage, every other stage gets a thread
+    for (stage = 0; stage < CIPHER_PIPELINE_STAGE_WRITE; ++stage)
+    {
+        workers[stage].pipeline = &pipeline;
+        workers[stage].stage = (CIPHER_PIPELINE_STAGE)stage;
+#ifdef _WIN32
+        threads[stage] = CreateThread(NULL, 0, cipher_pipeline_worker, &workers[stage], 0, NULL);
+        if (NULL == threads[stage])
+#else
+        if (0 != pthread_create(&threads[stage], NULL, cipher_pipeline_worker, &workers[stage]))
+#endif
+        {
+            log_error("[!] Failed to start the thread of pipeline stage %u", stage);
+            ATOMIC_STORE(&pipeline.aborted, 1);
+            pipeline.stage_status[stage] = STATUS_CODE_COULDNT_START_THREAD;
+            break;
+        }
+        ++number_of_started_threads;
+    }
+
+    if (CIPHER_PIPELINE_STAGE_WRITE == number_of_started_threads)
+    {
+        (void)run_cipher_pipeline_stage(&pipeline, CIPHER_PIPELINE_STAGE_WRITE);
+    }
+
+    for (stage = 0; stage < number_of_started_threads; ++stage)
+    {
+#ifdef _WIN32
+        WaitForSingleObject(threads[stage], INFINITE);
+        CloseHandle(threads[stage]);
+#else
+        pthread_join(threads[stage], NULL);
+#endif
+    }
+
+    // The stages released by the abort report STATUS_CODE_PIPELINE_ABORTED, the one that failed reports why
+    return_code = STATUS_CODE_SUCCESS;
+    for (stage = 0; stage < NUMBER_OF_CIPHER_PIPELINE_STAGES; ++stage)
+    {
+        if (STATUS_FAILED(pipeline.stage_status[stage]) &&
+            (STATUS_SUCCESS(return_code) || (STATUS_CODE_PIPELINE_ABORTED == return_code)))
+        {
+            return_code = pipeline.stage_status[stage];
+        }
+    }
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("[!] Pipelined stream encryption failed");
+        goto cleanup;
+    }
+
+    log_debug("Pipelined stream encryption completed: %llu bytes in, %llu bytes out",
+        (unsigned long long)pipeline.total_read, (unsigned long long)pipeline.total_written);
+    increase_metric_counter(METRIC_COUNTER_BLOCKS_ENCRYPTED, pipeline.total_blocks);
+
+    if (NULL != out_bytes_read)
+    {
+        *out_bytes_read = pipeline.total_read;
+    }
+    if (NULL != out_bytes_written)
+    {
+        *out_bytes_written = pipeline.total_written;
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free_cipher_pipeline(&pipeline);
+    return return_code;
+}
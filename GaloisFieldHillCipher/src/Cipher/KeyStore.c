@@ -0,0 +1,600 @@
+#include "Cipher/KeyStore.h"
+
+#include <sys/stat.h>
+#include <sodium.h>
+
+#include "IO/SerDes.h"
+#include "Secrets/MappedSecrets.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#ifdef _WIN32
+typedef SRWLOCK KeyStoreLock;
+typedef CRITICAL_SECTION KeyStoreMutex;
+typedef CONDITION_VARIABLE KeyStoreCondition;
+#define ATOMIC_LOAD(pointer) ((uint64_t)InterlockedCompareExchange64((volatile LONG64*)(pointer), 0, 0))
+#define ATOMIC_STORE(pointer, value) ((void)InterlockedExchange64((volatile LONG64*)(pointer), (LONG64)(value)))
+#define ATOMIC_FETCH_ADD(pointer, value) ((uint64_t)InterlockedExchangeAdd64((volatile LONG64*)(pointer), (LONG64)(value)))
+#else
+typedef pthread_rwlock_t KeyStoreLock;
+typedef pthread_mutex_t KeyStoreMutex;
+typedef pthread_cond_t KeyStoreCondition;
+#define ATOMIC_LOAD(pointer) __atomic_load_n((pointer), __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE(pointer, value) __atomic_store_n((pointer), (value), __ATOMIC_RELEASE)
+#define ATOMIC_FETCH_ADD(pointer, value) __atomic_fetch_add((pointer), (value), __ATOMIC_ACQ_REL)
+#endif
+
+struct KeyStoreEntry typedef KeyStoreEntry;
+struct KeyStoreLoad typedef KeyStoreLoad;
+
+struct KeyStoreEntry {
+    CipherContext context; // First member, a released context is converted back to its entry
+    uint8_t digest[KEY_STORE_DIGEST_SIZE];
+    uint64_t file_size; // Path keys only, a cached file that changed is loaded again
+    int64_t file_modification_time;
+    int64_t file_modification_nanoseconds; // A rewrite within the same second at the same size still differs here
+    uint64_t file_inode; // A key replaced by a rename keeps neither the inode nor, across mounts, the device
+    uint64_t file_device;
+    uint64_t last_used; // Atomic, stamped by lookups under the shared lock
+    uint64_t references; // Atomic, one held by the store while the entry is cached and one per acquire
+    KeyStoreEntry* next_in_bucket;
+};
+
+// A key being loaded and prepared by one thread, other threads missing on it wait for it instead of loading it again
+struct KeyStoreLoad {
+    uint8_t digest[KEY_STORE_DIGEST_SIZE];
+    KeyStoreLoad* next;
+};
+
+struct KeyStore {
+    KeyStoreLock lock;
+    KeyStoreMutex load_mutex; // Taken before the lock, never while holding it
+    KeyStoreCondition load_finished;
+    KeyStoreLoad* loads; // Under the load mutex
+    KeyStoreEntry* buckets[KEY_STORE_NUMBER_OF_BUCKETS];
+    size_t byte_budget;
+    size_t bytes_in_use; // Entries and the budget are only changed under the exclusive lock
+    uint64_t number_of_entries;
+    uint64_t clock; // Atomic, the LRU order
+    uint64_t hits; // Atomic
+    uint64_t misses; // Atomic
+    uint64_t evictions; // Atomic
+};
+
+static void lock_key_store_shared(KeyStore* store)
+{
+#ifdef _WIN32
+    AcquireSRWLockShared(&store->lock);
+#else
+    pthread_rwlock_rdlock(&store->lock);
+#endif
+}
+
+static void unlock_key_store_shared(KeyStore* store)
+{
+#ifdef _WIN32
+    ReleaseSRWLockShared(&store->lock);
+#else
+    pthread_rwlock_unlock(&store->lock);
+#endif
+}
+
+static void lock_key_store_exclusive(KeyStore* store)
+{
+#ifdef _WIN32
+    AcquireSRWLockExclusive(&store->lock);
+#else
+    pthread_rwlock_wrlock(&store->lock);
+#endif
+}
+
+static void unlock_key_store_exclusive(KeyStore* store)
+{
+#ifdef _WIN32
+    ReleaseSRWLockExclusive(&store->lock);
+#else
+    pthread_rwlock_unlock(&store->lock);
+#endif
+}
+
+static void lock_key_store_loads(KeyStore* store)
+{
+#ifdef _WIN32
+    EnterCriticalSection(&store->load_mutex);
+#else
+    pthread_mutex_lock(&store->load_mutex);
+#endif
+}
+
+static void unlock_key_store_loads(KeyStore* store)
+{
+#ifdef _WIN32
+    LeaveCriticalSection(&store->load_mutex);
+#else
+    pthread_mutex_unlock(&store->load_mutex);
+#endif
+}
+
+static uint32_t get_key_store_bucket(const uint8_t* digest)
+{
+    uint32_t bucket = 0;
+
+    // The digest is uniform already, its first bytes pick the bucket
+    memcpy(&bucket, digest, sizeof(bucket));
+    return bucket & (KEY_STORE_NUMBER_OF_BUCKETS - 1);
+}
+
+static void drop_key_store_entry_reference(KeyStoreEntry* entry)
+{
+    if (1 == ATOMIC_FETCH_ADD(&entry->references, (uint64_t)-1))
+    {
+        free_cipher_context(&entry->context);
+        free(entry);
+    }
+}
+
+static bool is_key_store_entry_current(const KeyStoreEntry* entry, const KeyStoreEntry* stamp)
+{
+    return (entry->file_size == stamp->file_size) && (entry->file_modification_time == stamp->file_modification_time) &&
+           (entry->file_modification_nanoseconds == stamp->file_modification_nanoseconds) &&
+           (entry->file_inode == stamp->file_inode) && (entry->file_device == stamp->file_device);
+}
+
+/**
+ * @brief Looks a key up under the shared lock and references it on a hit.
+ *
+ * @param stamp - Digest and file stamp of the key.
+ * @return The referenced entry, NULL on a miss.
+ */
+static KeyStoreEntry* find_key_store_entry(KeyStore* store, const KeyStoreEntry* stamp)
+{
+    KeyStoreEntry* entry = NULL;
+
+    lock_key_store_shared(store);
+    for (entry = store->buckets[get_key_store_bucket(stamp->digest)]; NULL != entry; entry = entry->next_in_bucket)
+    {
+        if (0 == memcmp(entry->digest, stamp->digest, KEY_STORE_DIGEST_SIZE))
+        {
+            break;
+        }
+    }
+    if ((NULL != entry) && is_key_store_entry_current(entry, stamp))
+    {
+        (void)ATOMIC_FETCH_ADD(&entry->references, 1);
+        ATOMIC_STORE(&entry->last_used, ATOMIC_FETCH_ADD(&store->clock, 1));
+    }
+    else
+    {
+        entry = NULL;
+    }
+    unlock_key_store_shared(store);
+
+    return entry;
+}
+
+static void unlink_key_store_entry(KeyStore* store, KeyStoreEntry** link)
+{
+    KeyStoreEntry* entry = *link;
+
+    *link = entry->next_in_bucket;
+    entry->next_in_bucket = NULL;
+    store->bytes_in_use -= entry->context.size_in_bytes;
+    --store->number_of_entries;
+}
+
+/**
+ * @brief Evicts the least recently used entries other than the kept one until the store fits its budget, under the exclusive lock.
+ *
+ * @param out_evicted - List of the evicted entries, their store references are dropped once the lock is released.
+ */
+static void evict_key_store_entries(KeyStoreEntry** out_evicted, KeyStore* store, const KeyStoreEntry* kept_entry)
+{
+    KeyStoreEntry** link = NULL;
+    KeyStoreEntry** oldest_link = NULL;
+    KeyStoreEntry* evicted_entry = NULL;
+    uint64_t oldest_use = 0;
+    size_t bucket = 0;
+
+    // A scan per eviction, the store holds a few hundred keys and evicting means a key is about to be prepared anyway
+    while (store->bytes_in_use > store->byte_budget)
+    {
+        oldest_link = NULL;
+        for (bucket = 0; bucket < KEY_STORE_NUMBER_OF_BUCKETS; ++bucket)
+        {
+            for (link = &store->buckets[bucket]; NULL != *link; link = &(*link)->next_in_bucket)
+            {
+                if ((*link != kept_entry) && ((NULL == oldest_link) || (ATOMIC_LOAD(&(*link)->last_used) < oldest_use)))
+                {
+                    oldest_link = link;
+                    oldest_use = ATOMIC_LOAD(&(*link)->last_used);
+                }
+            }
+        }
+        if (NULL == oldest_link)
+        {
+            break;
+        }
+
+        evicted_entry = *oldest_link;
+        unlink_key_store_entry(store, oldest_link);
+        evicted_entry->next_in_bucket = *out_evicted;
+        *out_evicted = evicted_entry;
+        (void)ATOMIC_FETCH_ADD(&store->evictions, 1);
+    }
+}
+
+/**
+ * @brief Caches a newly prepared entry. If another thread cached the same key meanwhile, its entry is used and the new one is freed.
+ *
+ * @param entry - The new entry, holding the reference of the caller.
+ * @return The referenced cached entry.
+ */
+static KeyStoreEntry* insert_key_store_entry(KeyStore* store, KeyStoreEntry* entry)
+{
+    KeyStoreEntry** link = NULL;
+    KeyStoreEntry* cached_entry = entry;
+    KeyStoreEntry* evicted = NULL;
+    KeyStoreEntry* next_evicted = NULL;
+
+    lock_key_store_exclusive(store);
+    for (link = &store->buckets[get_key_store_bucket(entry->digest)]; NULL != *link; link = &(*link)->next_in_bucket)
+    {
+        if (0 == memcmp((*link)->digest, entry->digest, KEY_STORE_DIGEST_SIZE))
+        {
+            break;
+        }
+    }
+
+    if ((NULL != *link) && is_key_store_entry_current(*link, entry))
+    {
+        cached_entry = *link;
+        (void)ATOMIC_FETCH_ADD(&cached_entry->references, 1);
+    }
+    else
+    {
+        // A stale entry of a changed file is replaced, threads still holding it keep their reference
+        if (NULL != *link)
+        {
+            evicted = *link;
+            unlink_key_store_entry(store, link);
+        }
+
+        entry->references = 2;
+        entry->last_used = ATOMIC_FETCH_ADD(&store->clock, 1);
+        entry->next_in_bucket = store->buckets[get_key_store_bucket(entry->digest)];
+        store->buckets[get_key_store_bucket(entry->digest)] = entry;
+        store->bytes_in_use += entry->context.size_in_bytes;
+        ++store->number_of_entries;
+
+        evict_key_store_entries(&evicted, store, entry);
+    }
+    unlock_key_store_exclusive(store);
+
+    for (; NULL != evicted; evicted = next_evicted)
+    {
+        next_evicted = evicted->next_in_bucket;
+        drop_key_store_entry_reference(evicted);
+    }
+    if (cached_entry != entry)
+    {
+        free_cipher_context(&entry->context);
+        free(entry);
+    }
+
+    return cached_entry;
+}
+
+static bool is_key_store_key_loading(const KeyStore* store, const uint8_t* digest)
+{
+    const KeyStoreLoad* load = NULL;
+
+    for (load = store->loads; NULL != load; load = load->next)
+    {
+        if (0 == memcmp(load->digest, digest, KEY_STORE_DIGEST_SIZE))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Waits for a load of the same key by another thread, then either finds the key cached or claims its load.
+ *        The loading thread caches its entry before finishing the load, so a key that is neither loading nor cached is claimed.
+ *
+ * @param load - The claim, listed in the store until finish_key_store_load when the key is claimed.
+ * @return The referenced cached entry, NULL when the caller claimed the load.
+ */
+static KeyStoreEntry* begin_key_store_load(KeyStore* store, KeyStoreLoad* load, const KeyStoreEntry* stamp)
+{
+    KeyStoreEntry* cached_entry = NULL;
+
+    lock_key_store_loads(store);
+    for (;;)
+    {
+        if (is_key_store_key_loading(store, stamp->digest))
+        {
+#ifdef _WIN32
+            SleepConditionVariableCS(&store->load_finished, &store->load_mutex, INFINITE);
+#else
+            pthread_cond_wait(&store->load_finished, &store->load_mutex);
+#endif
+            continue;
+        }
+
+        cached_entry = find_key_store_entry(store, stamp);
+        if (NULL == cached_entry)
+        {
+            memcpy(load->digest, stamp->digest, KEY_STORE_DIGEST_SIZE);
+            load->next = store->loads;
+            store->loads = load;
+        }
+        break;
+    }
+    unlock_key_store_loads(store);
+
+    return cached_entry;
+}
+
+static void finish_key_store_load(KeyStore* store, KeyStoreLoad* load)
+{
+    KeyStoreLoad** link = NULL;
+
+    lock_key_store_loads(store);
+    for (link = &store->loads; NULL != *link; link = &(*link)->next)
+    {
+        if (*link == load)
+        {
+            *link = load->next;
+            break;
+        }
+    }
+#ifdef _WIN32
+    WakeAllConditionVariable(&store->load_finished);
+#else
+    pthread_cond_broadcast(&store->load_finished);
+#endif
+    unlock_key_store_loads(store);
+}
+
+STATUS_CODE create_key_store(KeyStore** out_store, size_t byte_budget)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    KeyStore* store = NULL;
+
+    if ((NULL == out_store) || (0 == byte_budget))
+    {
+        log_error("[!] Invalid arguments in create_key_store");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    store = (KeyStore*)calloc(1, sizeof(KeyStore));
+    if (NULL == store)
+    {
+        log_error("[!] Memory allocation failed in create_key_store");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+#ifdef _WIN32
+    InitializeSRWLock(&store->lock);
+    InitializeCriticalSection(&store->load_mutex);
+    InitializeConditionVariable(&store->load_finished);
+#else
+    if (0 != pthread_rwlock_init(&store->lock, NULL))
+    {
+        log_error("[!] Failed to initialize the key store lock");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    pthread_mutex_init(&store->load_mutex, NULL);
+    pthread_cond_init(&store->load_finished, NULL);
+#endif
+    store->byte_budget = byte_budget;
+
+    *out_store = store;
+    store = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free(store);
+    return return_code;
+}
+
+void free_key_store(KeyStore* store)
+{
+    KeyStoreEntry* entry = NULL;
+    KeyStoreEntry* next_entry = NULL;
+    size_t bucket = 0;
+
+    if (NULL == store)
+    {
+        return;
+    }
+
+    for (bucket = 0; bucket < KEY_STORE_NUMBER_OF_BUCKETS; ++bucket)
+    {
+        for (entry = store->buckets[bucket]; NULL != entry; entry = next_entry)
+        {
+            next_entry = entry->next_in_bucket;
+            drop_key_store_entry_reference(entry);
+        }
+    }
+
+#ifdef _WIN32
+    DeleteCriticalSection(&store->load_mutex);
+#else
+    pthread_rwlock_destroy(&store->lock);
+    pthread_mutex_destroy(&store->load_mutex);
+    pthread_cond_destroy(&store->load_finished);
+#endif
+    free(store);
+}
+
+/**
+ * @brief Looks a key up, and on a miss loads it from its file or its contents, prepares it and caches it.
+ *
+ * @param stamp - Digest and file stamp of the key.
+ * @param filepath - Path of the key file, NULL for keys given by their contents.
+ */
+static STATUS_CODE acquire_key_store_entry(const CipherContext** out_context, KeyStore* store, const KeyStoreEntry* stamp,
+                                           const char* filepath, const uint8_t* data, uint32_t size)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    KeyStoreEntry* cached_entry = NULL;
+    KeyStoreEntry* entry = NULL;
+    KeyStoreLoad load;
+    bool is_loading = false;
+    Secrets secrets = {0};
+
+    cached_entry = find_key_store_entry(store, stamp);
+    if (NULL == cached_entry)
+    {
+        cached_entry = begin_key_store_load(store, &load, stamp);
+        is_loading = (NULL == cached_entry);
+    }
+    if (NULL != cached_entry)
+    {
+        (void)ATOMIC_FETCH_ADD(&store->hits, 1);
+        *out_context = &cached_entry->context;
+        return_code = STATUS_CODE_SUCCESS;
+        goto cleanup;
+    }
+    (void)ATOMIC_FETCH_ADD(&store->misses, 1);
+
+    // Loading and preparing run without the lock, hits on other keys go on meanwhile
+    if (NULL != filepath)
+    {
+        return_code = load_secrets_file(&secrets, NULL, filepath);
+    }
+    else
+    {
+        return_code = deserialize_secrets(&secrets, (uint8_t*)data, size);
+    }
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    entry = (KeyStoreEntry*)calloc(1, sizeof(KeyStoreEntry));
+    if (NULL == entry)
+    {
+        log_error("[!] Memory allocation failed in acquire_key_store_entry");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    memcpy(entry->digest, stamp->digest, KEY_STORE_DIGEST_SIZE);
+    entry->file_size = stamp->file_size;
+    entry->file_modification_time = stamp->file_modification_time;
+    entry->file_modification_nanoseconds = stamp->file_modification_nanoseconds;
+    entry->file_inode = stamp->file_inode;
+    entry->file_device = stamp->file_device;
+
+    return_code = adopt_secrets_into_cipher_context(&entry->context, &secrets);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    *out_context = &insert_key_store_entry(store, entry)->context;
+    entry = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    // Waiting threads find the entry, or claim the load again if it failed
+    if (is_loading)
+    {
+        finish_key_store_load(store, &load);
+    }
+    free(entry);
+    free_secrets(&secrets);
+    return return_code;
+}
+
+STATUS_CODE acquire_key_store_context_from_file(const CipherContext** out_context, KeyStore* store, const char* filepath)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    KeyStoreEntry stamp;
+    struct stat file_status;
+
+    memset(&stamp, 0, sizeof(stamp));
+
+    if ((NULL == out_context) || (NULL == store) || (NULL == filepath))
+    {
+        log_error("[!] Invalid arguments in acquire_key_store_context_from_file");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    if (0 != stat(filepath, &file_status))
+    {
+        log_error("[!] Couldn't stat key file %s", filepath);
+        return_code = STATUS_CODE_COULDNT_OPEN_FILE;
+        goto cleanup;
+    }
+    stamp.file_size = (uint64_t)file_status.st_size;
+    stamp.file_modification_time = (int64_t)file_status.st_mtime;
+#ifndef _WIN32
+    // Windows' stat has whole seconds only and no stable file index
+    stamp.file_modification_nanoseconds = (int64_t)file_status.st_mtim.tv_nsec;
+    stamp.file_inode = (uint64_t)file_status.st_ino;
+#endif
+    stamp.file_device = (uint64_t)file_status.st_dev;
+
+    (void)crypto_generichash(stamp.digest, KEY_STORE_DIGEST_SIZE, (const unsigned char*)filepath, strlen(filepath),
+                             (const unsigned char*)KEY_STORE_PATH_DIGEST_KEY, strlen(KEY_STORE_PATH_DIGEST_KEY));
+
+    return_code = acquire_key_store_entry(out_context, store, &stamp, filepath, NULL, 0);
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE acquire_key_store_context_from_data(const CipherContext** out_context, KeyStore* store, const uint8_t* data, uint32_t size)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    KeyStoreEntry stamp;
+
+    memset(&stamp, 0, sizeof(stamp));
+
+    if ((NULL == out_context) || (NULL == store) || (NULL == data) || (0 == size))
+    {
+        log_error("[!] Invalid arguments in acquire_key_store_context_from_data");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    (void)crypto_generichash(stamp.digest, KEY_STORE_DIGEST_SIZE, data, size, NULL, 0);
+
+    return_code = acquire_key_store_entry(out_context, store, &stamp, NULL, data, size);
+cleanup:
+    return return_code;
+}
+
+void release_key_store_context(const CipherContext* context)
+{
+    if (NULL == context)
+    {
+        return;
+    }
+
+    drop_key_store_entry_reference((KeyStoreEntry*)context);
+}
+
+void get_key_store_statistics(KeyStoreStatistics* out_statistics, KeyStore* store)
+{
+    if ((NULL == out_statistics) || (NULL == store))
+    {
+        return;
+    }
+
+    lock_key_store_shared(store);
+    out_statistics->hits = ATOMIC_LOAD(&store->hits);
+    out_statistics->misses = ATOMIC_LOAD(&store->misses);
+    out_statistics->evictions = ATOMIC_LOAD(&store->evictions);
+    out_statistics->number_of_entries = store->number_of_entries;
+    out_statistics->bytes_in_use = store->bytes_in_use;
+    unlock_key_store_shared(store);
+}
@@ -0,0 +1,1104 @@
+#include "Cipher/ShardCoordinator.h"
+
+#include "Cipher/CipherContext.h"
+#include "Secrets/MappedSecrets.h"
+#include "Secrets/SecretsGeneration.h"
+#include "Instrumentation/StageTimers.h"
+#include "IO/AsyncLogger.h"
+
+#ifdef _WIN32
+#define seek_shard_file(stream, offset) _fseeki64((stream), (__int64)(offset), SEEK_SET)
+#define tell_shard_file(stream) ((int64_t)_ftelli64(stream))
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define seek_shard_file(stream, offset) fseeko((stream), (off_t)(offset), SEEK_SET)
+#define tell_shard_file(stream) ((int64_t)ftello(stream))
+#endif
+
+#define SHARD_MAXIMAL_HELLO_PAYLOAD_SIZE ((uint64_t)2 * 4096 + 16) // Two paths and their sizes
+#define SHARD_MAXIMAL_RESULT_PAYLOAD_SIZE ((uint64_t)SHARD_RESULT_HEADER_SIZE + UINT32_MAX)
+
+static ShardWorkerJobHook g_worker_job_hook = NULL;
+
+static void store_shard_u32(uint8_t* out, uint32_t value)
+{
+    uint32_t byte_index = 0;
+
+    for (byte_index = 0; byte_index < sizeof(uint32_t); ++byte_index)
+    {
+        out[byte_index] = (uint8_t)(value >> (BYTE_SIZE * byte_index));
+    }
+}
+
+static void store_shard_u64(uint8_t* out, uint64_t value)
+{
+    store_shard_u32(out, (uint32_t)value);
+    store_shard_u32(out + sizeof(uint32_t), (uint32_t)(value >> 32));
+}
+
+static uint32_t load_shard_u32(const uint8_t* data)
+{
+    uint32_t value = 0;
+    uint32_t byte_index = 0;
+
+    for (byte_index = 0; byte_index < sizeof(uint32_t); ++byte_index)
+    {
+        value |= (uint32_t)data[byte_index] << (BYTE_SIZE * byte_index);
+    }
+    return value;
+}
+
+static uint64_t load_shard_u64(const uint8_t* data)
+{
+    return (uint64_t)load_shard_u32(data) | ((uint64_t)load_shard_u32(data + sizeof(uint32_t)) << 32);
+}
+
+static STATUS_CODE write_shard_container_index(FILE* output, const ShardContainerHeader* header, const ShardIndexEntry* entries, bool is_complete)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint8_t encoded_header[SHARD_CONTAINER_HEADER_SIZE] = {0};
+    uint8_t encoded_entry[SHARD_CONTAINER_INDEX_ENTRY_SIZE] = {0};
+    uint32_t shard_index = 0;
+
+    // The magic goes in last, so until then the container doesn't parse
+    if (is_complete)
+    {
+        memcpy(encoded_header, SHARD_CONTAINER_MAGIC, SHARD_CONTAINER_MAGIC_SIZE);
+    }
+    store_shard_u32(encoded_header + 8, header->version);
+    store_shard_u32(encoded_header + 12, (uint32_t)header->format);
+    store_shard_u32(encoded_header + 16, header->number_of_shards);
+    store_shard_u64(encoded_header + 24, header->plaintext_size);
+    store_shard_u64(encoded_header + 32, header->shard_size);
+
+    if (0 != seek_shard_file(output, SHARD_CONTAINER_HEADER_SIZE))
+    {
+        log_error("[!] Failed to seek to the index of the shard container");
+        return_code = STATUS_CODE_COULDNT_WRITE_FILE;
+        goto cleanup;
+    }
+    for (shard_index = 0; shard_index < header->number_of_shards; ++shard_index)
+    {
+        store_shard_u64(encoded_entry, entries[shard_index].plaintext_offset);
+        store_shard_u64(encoded_entry + 8, entries[shard_index].plaintext_size);
+        store_shard_u64(encoded_entry + 16, entries[shard_index].ciphertext_offset);
+        store_shard_u64(encoded_entry + 24, entries[shard_index].ciphertext_size);
+        if (1 != fwrite(encoded_entry, sizeof(encoded_entry), 1, output))
+        {
+            log_error("[!] Failed to write the index of the shard container");
+            return_code = STATUS_CODE_COULDNT_WRITE_FILE;
+            goto cleanup;
+        }
+    }
+
+    if ((0 != fflush(output)) || (0 != seek_shard_file(output, 0)) || (1 != fwrite(encoded_header, sizeof(encoded_header), 1, output)) ||
+        (0 != fflush(output)))
+    {
+        log_error("[!] Failed to write the header of the shard container");
+        return_code = STATUS_CODE_COULDNT_WRITE_FILE;
+        goto cleanup;
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE read_shard_container_index(ShardContainerHeader* out_header, ShardIndexEntry** out_entries, FILE* input)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint8_t encoded_header[SHARD_CONTAINER_HEADER_SIZE] = {0};
+    uint8_t encoded_entry[SHARD_CONTAINER_INDEX_ENTRY_SIZE] = {0};
+    ShardContainerHeader header = {0};
+    ShardIndexEntry* entries = NULL;
+    ShardIndexEntry* entry = NULL;
+    int64_t container_size = 0;
+    uint64_t payload_offset = 0;
+    uint64_t covered_plaintext = 0;
+    uint32_t format = 0;
+    uint32_t shard_index = 0;
+
+    if ((NULL == out_header) || (NULL == out_entries) || (NULL == input))
+    {
+        log_error("[!] Invalid arguments in read_shard_container_index");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    if ((0 != fseek(input, 0, SEEK_END)) || (0 > (container_size = tell_shard_file(input))) || (0 != seek_shard_file(input, 0)))
+    {
+        log_error("[!] Failed to get the size of the shard container");
+        return_code = STATUS_CODE_COULDNT_READ_FILE;
+        goto cleanup;
+    }
+
+    if ((1 != fread(encoded_header, sizeof(encoded_header), 1, input)) ||
+        (0 != memcmp(encoded_header, SHARD_CONTAINER_MAGIC, SHARD_CONTAINER_MAGIC_SIZE)))
+    {
+        log_error("[!] The input is not a complete shard container");
+        return_code = STATUS_CODE_INVALID_SHARD_CONTAINER;
+        goto cleanup;
+    }
+    header.version = load_shard_u32(encoded_header + 8);
+    format = load_shard_u32(encoded_header + 12);
+    header.number_of_shards = load_shard_u32(encoded_header + 16);
+    header.plaintext_size = load_shard_u64(encoded_header + 24);
+    header.shard_size = load_shard_u64(encoded_header + 32);
+    payload_offset = SHARD_CONTAINER_HEADER_SIZE + ((uint64_t)header.number_of_shards * SHARD_CONTAINER_INDEX_ENTRY_SIZE);
+
+    if ((SHARD_CONTAINER_VERSION != header.version) || (NUMBER_OF_CIPHERTEXT_FORMATS <= format) || (payload_offset > (uint64_t)container_size))
+    {
+        log_error("[!] Unsupported shard container, version %u, format %u, %u shards", header.version, format, header.number_of_shards);
+        return_code = STATUS_CODE_INVALID_SHARD_CONTAINER;
+        goto cleanup;
+    }
+    header.format = (CIPHERTEXT_FORMAT)format;
+
+    if (0 != header.number_of_shards)
+    {
+        entries = (ShardIndexEntry*)calloc(header.number_of_shards, sizeof(ShardIndexEntry));
+        if (NULL == entries)
+        {
+            log_error("[!] Memory allocation failed in read_shard_container_index");
+            return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+            goto cleanup;
+        }
+    }
+
+    for (shard_index = 0; shard_index < header.number_of_shards; ++shard_index)
+    {
+        if (1 != fread(encoded_entry, sizeof(encoded_entry), 1, input))
+        {
+            log_error("[!] Failed to read the index of the shard container");
+            return_code = STATUS_CODE_COULDNT_READ_FILE;
+            goto cleanup;
+        }
+        entry = &entries[shard_index];
+        entry->plaintext_offset = load_shard_u64(encoded_entry);
+        entry->plaintext_size = load_shard_u64(encoded_entry + 8);
+        entry->ciphertext_offset = load_shard_u64(encoded_entry + 16);
+        entry->ciphertext_size = load_shard_u64(encoded_entry + 24);
+
+        // Shards follow each other in the plaintext, and every ciphertext lies in the payload of the container
+        if ((entry->plaintext_offset != covered_plaintext) || (0 == entry->plaintext_size) || (UINT32_MAX < entry->plaintext_size) ||
+            (0 == entry->ciphertext_size) || (UINT32_MAX < entry->ciphertext_size) || (payload_offset > entry->ciphertext_offset) ||
+            (((uint64_t)container_size - payload_offset) < (entry->ciphertext_offset - payload_offset)) ||
+            (((uint64_t)container_size - entry->ciphertext_offset) < entry->ciphertext_size))
+        {
+            log_error("[!] Invalid index entry %u in the shard container", shard_index);
+            return_code = STATUS_CODE_INVALID_SHARD_CONTAINER;
+            goto cleanup;
+        }
+        covered_plaintext += entry->plaintext_size;
+    }
+
+    if (covered_plaintext != header.plaintext_size)
+    {
+        log_error("[!] The shards of the container cover %llu of its %llu plaintext bytes",
+                  (unsigned long long)covered_plaintext, (unsigned long long)header.plaintext_size);
+        return_code = STATUS_CODE_INVALID_SHARD_CONTAINER;
+        goto cleanup;
+    }
+
+    *out_header = header;
+    *out_entries = entries;
+    entries = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free(entries);
+    return return_code;
+}
+
+void set_shard_worker_job_hook(ShardWorkerJobHook hook)
+{
+    g_worker_job_hook = hook;
+}
+
+#ifdef _WIN32
+
+STATUS_CODE run_shard_coordinator(ShardSummary* out_summary, const char* output_file, const char* input_file, const char* key_file,
+    const ShardConfiguration* configuration)
+{
+    (void)out_summary;
+    (void)output_file;
+    (void)input_file;
+    (void)key_file;
+    (void)configuration;
+
+    log_error("[!] Sharded processing starts its workers with fork and is not supported on Windows");
+    return STATUS_CODE_INVALID_ARGUMENT;
+}
+
+#else
+
+struct ShardWorker {
+    pid_t pid; // 0 when no worker runs in the slot
+    int socket;
+    int64_t shard; // The shard the worker is processing, -1 when idle
+} typedef ShardWorker;
+
+struct ShardCoordinator {
+    const ShardConfiguration* configuration;
+    const char* input_file;
+    const char* key_file;
+    FILE* output;
+    ShardContainerHeader header;
+    ShardIndexEntry* entries;
+    uint32_t* attempts; // Per shard
+    uint32_t* pending; // Ring of the shards waiting for a worker
+    uint32_t pending_head;
+    uint32_t number_of_pending;
+    uint32_t number_of_completed;
+    uint64_t output_offset; // End of the container, where the next shard ciphertext goes
+    ShardWorker* workers;
+    uint32_t number_of_workers;
+    ShardSummary summary;
+} typedef ShardCoordinator;
+
+static STATUS_CODE write_shard_socket(int socket, const uint8_t* data, size_t size)
+{
+    ssize_t written = 0;
+
+    while (0 != size)
+    {
+        // No SIGPIPE when the worker at the other end is gone, the error is handled like any other failed worker
+        written = send(socket, data, size, MSG_NOSIGNAL);
+        if (0 > written)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            return STATUS_CODE_COULDNT_WRITE_FILE;
+        }
+        data += written;
+        size -= (size_t)written;
+    }
+    return STATUS_CODE_SUCCESS;
+}
+
+static STATUS_CODE read_shard_socket(int socket, uint8_t* data, size_t size)
+{
+    ssize_t received = 0;
+
+    while (0 != size)
+    {
+        received = recv(socket, data, size, 0);
+        if (0 > received)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            return STATUS_CODE_COULDNT_READ_FILE;
+        }
+        if (0 == received)
+        {
+            return STATUS_CODE_COULDNT_READ_FILE;
+        }
+        data += received;
+        size -= (size_t)received;
+    }
+    return STATUS_CODE_SUCCESS;
+}
+
+static STATUS_CODE send_shard_message(int socket, SHARD_MESSAGE_TYPE type, const uint8_t* prefix, size_t prefix_size, const uint8_t* data,
+    size_t data_size)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint8_t encoded_header[SHARD_MESSAGE_HEADER_SIZE] = {0};
+
+    store_shard_u32(encoded_header, (uint32_t)type);
+    store_shard_u64(encoded_header + 8, (uint64_t)prefix_size + (uint64_t)data_size);
+
+    return_code = write_shard_socket(socket, encoded_header, sizeof(encoded_header));
+    if (STATUS_SUCCESS(return_code) && (0 != prefix_size))
+    {
+        return_code = write_shard_socket(socket, prefix, prefix_size);
+    }
+    if (STATUS_SUCCESS(return_code) && (0 != data_size))
+    {
+        return_code = write_shard_socket(socket, data, data_size);
+    }
+    return return_code;
+}
+
+static STATUS_CODE receive_shard_message(uint32_t* out_type, uint8_t** out_payload, uint64_t* out_payload_size, int socket,
+    uint64_t maximal_payload_size)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint8_t encoded_header[SHARD_MESSAGE_HEADER_SIZE] = {0};
+    uint8_t* payload = NULL;
+    uint64_t payload_size = 0;
+
+    return_code = read_shard_socket(socket, encoded_header, sizeof(encoded_header));
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    payload_size = load_shard_u64(encoded_header + 8);
+    if (payload_size > maximal_payload_size)
+    {
+        log_error("[!] Shard message of %llu bytes is over the limit of its peer", (unsigned long long)payload_size);
+        return_code = STATUS_CODE_ERROR_INVALID_SIZE;
+        goto cleanup;
+    }
+
+    payload = (uint8_t*)malloc((size_t)payload_size + 1);
+    if (NULL == payload)
+    {
+        log_error("[!] Memory allocation failed in receive_shard_message");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    return_code = read_shard_socket(socket, payload, (size_t)payload_size);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    *out_type = load_shard_u32(encoded_header);
+    *out_payload = payload;
+    *out_payload_size = payload_size;
+    payload = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free(payload);
+    return return_code;
+}
+
+static STATUS_CODE process_shard_job(uint8_t** out_result, uint32_t* out_result_size, int input, uint64_t offset, uint64_t size,
+    const CipherContext* context, SHARD_DIRECTION direction, CIPHERTEXT_FORMAT format)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint8_t* data = NULL;
+    uint64_t read_size = 0;
+    ssize_t read_now = 0;
+
+    if ((0 == size) || (UINT32_MAX < size))
+    {
+        log_error("[!] Invalid shard size %llu", (unsigned long long)size);
+        return_code = STATUS_CODE_ERROR_INVALID_SIZE;
+        goto cleanup;
+    }
+
+    data = (uint8_t*)malloc((size_t)size);
+    if (NULL == data)
+    {
+        log_error("[!] Memory allocation failed in process_shard_job");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    while (read_size < size)
+    {
+        read_now = pread(input, data + read_size, (size_t)(size - read_size), (off_t)(offset + read_size));
+        if ((0 > read_now) && (EINTR == errno))
+        {
+            continue;
+        }
+        if (0 >= read_now)
+        {
+            log_error("[!] Failed to read the shard at offset %llu", (unsigned long long)offset);
+            return_code = STATUS_CODE_COULDNT_READ_FILE;
+            goto cleanup;
+        }
+        read_size += (uint64_t)read_now;
+    }
+
+    return_code = (SHARD_DIRECTION_ENCRYPT == direction) ?
+        encrypt_and_serialize_with_context(out_result, out_result_size, data, (uint32_t)size, context, format) :
+        deserialize_and_decrypt_with_context(out_result, out_result_size, data, (uint32_t)size, context, format);
+cleanup:
+    free(data);
+    return return_code;
+}
+
+/**
+ * @brief The body of a worker process. Loads the key and opens the input named by the hello message,
+ *        then answers every job with its result until the coordinator closes the socket.
+ *        A key or input that can't be opened fails every job, so the coordinator sees the reason in the results.
+ *
+ * @param socket - The worker end of the socket.
+ * @return STATUS_CODE - Status of the operation.
+ */
+static STATUS_CODE run_shard_worker(int socket)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    STATUS_CODE setup_status = STATUS_CODE_UNINITIALIZED;
+    STATUS_CODE job_status = STATUS_CODE_UNINITIALIZED;
+    uint8_t* payload = NULL;
+    uint64_t payload_size = 0;
+    uint32_t type = 0;
+    uint8_t* result = NULL;
+    uint32_t result_size = 0;
+    uint8_t result_header[SHARD_RESULT_HEADER_SIZE] = {0};
+    SHARD_DIRECTION direction = SHARD_DIRECTION_ENCRYPT;
+    CIPHERTEXT_FORMAT format = CIPHERTEXT_FORMAT_BINARY;
+    uint32_t key_path_size = 0;
+    uint32_t input_path_size = 0;
+    char* key_path = NULL;
+    char* input_path = NULL;
+    Secrets secrets = {0};
+    CipherContext context = {0};
+    bool has_context = false;
+    int input = -1;
+
+    return_code = receive_shard_message(&type, &payload, &payload_size, socket, SHARD_MAXIMAL_HELLO_PAYLOAD_SIZE);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    if ((SHARD_MESSAGE_HELLO != type) || (16 > payload_size))
+    {
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+    direction = (SHARD_DIRECTION)load_shard_u32(payload);
+    format = (CIPHERTEXT_FORMAT)load_shard_u32(payload + 4);
+    key_path_size = load_shard_u32(payload + 8);
+    input_path_size = load_shard_u32(payload + 12);
+    if (((uint64_t)16 + key_path_size + input_path_size != payload_size) || (NUMBER_OF_SHARD_DIRECTIONS <= (uint32_t)direction) ||
+        (NUMBER_OF_CIPHERTEXT_FORMATS <= (uint32_t)format))
+    {
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    // The paths are moved in front of each other to leave room for their terminators
+    key_path = (char*)payload;
+    input_path = (char*)payload + key_path_size + 1;
+    memmove(key_path, payload + 16, key_path_size);
+    key_path[key_path_size] = '\0';
+    memmove(input_path, payload + 16 + key_path_size, input_path_size);
+    input_path[input_path_size] = '\0';
+
+    setup_status = load_secrets_file(&secrets, NULL, key_path);
+    if (STATUS_SUCCESS(setup_status))
+    {
+        setup_status = adopt_secrets_into_cipher_context(&context, &secrets);
+        has_context = STATUS_SUCCESS(setup_status);
+    }
+    if (STATUS_SUCCESS(setup_status))
+    {
+        input = open(input_path, O_RDONLY);
+        setup_status = (0 > input) ? STATUS_CODE_INPUT_FILE_DOESNT_EXISTS_OR_NOT_READBLE : STATUS_CODE_SUCCESS;
+    }
+    free(payload);
+    payload = NULL;
+
+    for (;;)
+    {
+        // The coordinator closing the socket is how a worker is told to stop
+        if (STATUS_FAILED(receive_shard_message(&type, &payload, &payload_size, socket, SHARD_JOB_PAYLOAD_SIZE)))
+        {
+            break;
+        }
+        if ((SHARD_MESSAGE_JOB != type) || (SHARD_JOB_PAYLOAD_SIZE != payload_size))
+        {
+            return_code = STATUS_CODE_INVALID_ARGUMENT;
+            goto cleanup;
+        }
+        if (NULL != g_worker_job_hook)
+        {
+            g_worker_job_hook(load_shard_u32(payload));
+        }
+
+        job_status = setup_status;
+        if (STATUS_SUCCESS(job_status))
+        {
+            job_status = process_shard_job(&result, &result_size, input, load_shard_u64(payload + 8), load_shard_u64(payload + 16),
+                                           &context, direction, format);
+        }
+
+        memcpy(result_header, payload, sizeof(uint32_t));
+        store_shard_u32(result_header + 4, (uint32_t)job_status);
+        return_code = send_shard_message(socket, SHARD_MESSAGE_RESULT, result_header, sizeof(result_header), result,
+                                         STATUS_SUCCESS(job_status) ? result_size : 0);
+        free(result);
+        result = NULL;
+        free(payload);
+        payload = NULL;
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    if (0 <= input)
+    {
+        close(input);
+    }
+    if (has_context)
+    {
+        free_cipher_context(&context);
+    }
+    else
+    {
+        free_secrets(&secrets);
+    }
+    free(result);
+    free(payload);
+    return return_code;
+}
+
+static STATUS_CODE start_shard_worker(ShardCoordinator* coordinator, ShardWorker* worker)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    int sockets[2] = {-1, -1};
+    uint8_t hello_header[16] = {0};
+    size_t key_path_size = strlen(coordinator->key_file);
+    size_t input_path_size = strlen(coordinator->input_file);
+    uint8_t* paths = NULL;
+    uint32_t worker_index = 0;
+    pid_t pid = 0;
+
+    paths = (uint8_t*)malloc(key_path_size + input_path_size + 1);
+    if (NULL == paths)
+    {
+        log_error("[!] Memory allocation failed in start_shard_worker");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    memcpy(paths, coordinator->key_file, key_path_size);
+    memcpy(paths + key_path_size, coordinator->input_file, input_path_size);
+
+    if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, sockets))
+    {
+        log_error("[!] Failed to create the socket of a shard worker");
+        return_code = STATUS_CODE_COULDNT_START_THREAD;
+        goto cleanup;
+    }
+
+    pid = fork();
+    if (0 > pid)
+    {
+        log_error("[!] Failed to start a shard worker");
+        return_code = STATUS_CODE_COULDNT_START_THREAD;
+        goto cleanup;
+    }
+    if (0 == pid)
+    {
+        switch_async_logger_to_synchronous_after_fork();
+
+        // The worker keeps only its own end, so the coordinator closing a socket reaches exactly one worker
+        close(sockets[0]);
+        for (worker_index = 0; worker_index < coordinator->number_of_workers; ++worker_index)
+        {
+            if (0 <= coordinator->workers[worker_index].socket)
+            {
+                close(coordinator->workers[worker_index].socket);
+            }
+        }
+        _exit(STATUS_SUCCESS(run_shard_worker(sockets[1])) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    close(sockets[1]);
+    sockets[1] = -1;
+    worker->pid = pid;
+    worker->socket = sockets[0];
+    worker->shard = -1;
+    sockets[0] = -1;
+    ++coordinator->summary.workers_started;
+
+    store_shard_u32(hello_header, (uint32_t)coordinator->configuration->direction);
+    store_shard_u32(hello_header + 4, (uint32_t)coordinator->header.format);
+    store_shard_u32(hello_header + 8, (uint32_t)key_path_size);
+    store_shard_u32(hello_header + 12, (uint32_t)input_path_size);
+    return_code = send_shard_message(worker->socket, SHARD_MESSAGE_HELLO, hello_header, sizeof(hello_header), paths, key_path_size + input_path_size);
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("[!] Failed to send the hello message to shard worker %d", (int)pid);
+        goto cleanup;
+    }
+    log_debug("Started shard worker %d", (int)pid);
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    if (0 <= sockets[0])
+    {
+        close(sockets[0]);
+    }
+    if (0 <= sockets[1])
+    {
+        close(sockets[1]);
+    }
+    free(paths);
+    return return_code;
+}
+
+static void stop_shard_worker(ShardWorker* worker, bool kill_worker)
+{
+    int status = 0;
+
+    if (0 <= worker->socket)
+    {
+        close(worker->socket);
+        worker->socket = -1;
+    }
+    if (0 != worker->pid)
+    {
+        if (kill_worker)
+        {
+            kill(worker->pid, SIGKILL);
+        }
+        while ((0 > waitpid(worker->pid, &status, 0)) && (EINTR == errno))
+        {
+        }
+        worker->pid = 0;
+    }
+    worker->shard = -1;
+}
+
+static void push_pending_shard(ShardCoordinator* coordinator, uint32_t shard)
+{
+    coordinator->pending[(coordinator->pending_head + coordinator->number_of_pending) % coordinator->header.number_of_shards] = shard;
+    ++coordinator->number_of_pending;
+}
+
+/**
+ * @brief Hands a failed shard out again, or fails the run once the shard used up its retries.
+ *
+ * @param coordinator - The coordinator.
+ * @param shard - The shard.
+ * @param failure - Why the attempt failed.
+ * @return STATUS_CODE - Status of the operation, STATUS_CODE_SHARDS_FAILED when the shard is out of retries.
+ */
+static STATUS_CODE retry_shard(ShardCoordinator* coordinator, uint32_t shard, STATUS_CODE failure)
+{
+    if (coordinator->attempts[shard] > coordinator->configuration->number_of_retries)
+    {
+        log_error("[!] Shard %u failed with status %d after %u attempts", shard, (int)failure, coordinator->attempts[shard]);
+        if (NULL != coordinator->configuration->status_output)
+        {
+            fprintf(coordinator->configuration->status_output, "[!] Shard %u/%u failed with status %d after %u attempts\n",
+                    shard + 1, coordinator->header.number_of_shards, (int)failure, coordinator->attempts[shard]);
+        }
+        return STATUS_CODE_SHARDS_FAILED;
+    }
+
+    log_warn("Shard %u failed with status %d on attempt %u, retrying", shard, (int)failure, coordinator->attempts[shard]);
+    push_pending_shard(coordinator, shard);
+    ++coordinator->summary.retries;
+    return STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @brief Stops a worker that died or broke the protocol and hands its shard out again.
+ *        A new worker is started in its slot once a shard is waiting for it.
+ *
+ * @param coordinator - The coordinator.
+ * @param worker - The failed worker.
+ * @param failure - Why the worker is stopped.
+ * @return STATUS_CODE - Status of the operation, STATUS_CODE_SHARDS_FAILED when its shard is out of retries.
+ */
+static STATUS_CODE handle_failed_shard_worker(ShardCoordinator* coordinator, ShardWorker* worker, STATUS_CODE failure)
+{
+    int64_t shard = worker->shard;
+
+    log_warn("Shard worker %d failed, stopping it", (int)worker->pid);
+    stop_shard_worker(worker, true);
+    return (0 > shard) ? STATUS_CODE_SUCCESS : retry_shard(coordinator, (uint32_t)shard, failure);
+}
+
+static STATUS_CODE dispatch_shard(ShardCoordinator* coordinator, ShardWorker* worker)
+{
+    uint8_t job[SHARD_JOB_PAYLOAD_SIZE] = {0};
+    uint32_t shard = coordinator->pending[coordinator->pending_head];
+    const ShardIndexEntry* entry = &coordinator->entries[shard];
+    bool is_encryption = (SHARD_DIRECTION_ENCRYPT == coordinator->configuration->direction);
+
+    coordinator->pending_head = (coordinator->pending_head + 1) % coordinator->header.number_of_shards;
+    --coordinator->number_of_pending;
+    ++coordinator->attempts[shard];
+    worker->shard = shard;
+
+    store_shard_u32(job, shard);
+    store_shard_u64(job + 8, is_encryption ? entry->plaintext_offset : entry->ciphertext_offset);
+    store_shard_u64(job + 16, is_encryption ? entry->plaintext_size : entry->ciphertext_size);
+
+    if (STATUS_FAILED(send_shard_message(worker->socket, SHARD_MESSAGE_JOB, job, sizeof(job), NULL, 0)))
+    {
+        return handle_failed_shard_worker(coordinator, worker, STATUS_CODE_COULDNT_WRITE_FILE);
+    }
+    return STATUS_CODE_SUCCESS;
+}
+
+static STATUS_CODE store_shard_result(ShardCoordinator* coordinator, uint32_t shard, const uint8_t* data, uint64_t size)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    ShardIndexEntry* entry = &coordinator->entries[shard];
+    bool is_encryption = (SHARD_DIRECTION_ENCRYPT == coordinator->configuration->direction);
+    uint64_t offset = is_encryption ? coordinator->output_offset : entry->plaintext_offset;
+
+    if ((0 != seek_shard_file(coordinator->output, offset)) || (1 != fwrite(data, (size_t)size, 1, coordinator->output)))
+    {
+        log_error("[!] Failed to write shard %u at offset %llu", shard, (unsigned long long)offset);
+        return_code = STATUS_CODE_COULDNT_WRITE_FILE;
+        goto cleanup;
+    }
+
+    if (is_encryption)
+    {
+        entry->ciphertext_offset = offset;
+        entry->ciphertext_size = size;
+        coordinator->output_offset += size;
+    }
+    ++coordinator->number_of_completed;
+    coordinator->summary.bytes_in += is_encryption ? entry->plaintext_size : entry->ciphertext_size;
+    coordinator->summary.bytes_out += size;
+
+    log_info("Shard %u done, %llu -> %llu bytes on attempt %u", shard, (unsigned long long)(is_encryption ? entry->plaintext_size : entry->ciphertext_size),
+             (unsigned long long)size, coordinator->attempts[shard]);
+    if (NULL != coordinator->configuration->status_output)
+    {
+        fprintf(coordinator->configuration->status_output, "[*] Shard %u/%u done, %llu -> %llu bytes, attempt %u\n",
+                shard + 1, coordinator->header.number_of_shards,
+                (unsigned long long)(is_encryption ? entry->plaintext_size : entry->ciphertext_size), (unsigned long long)size,
+                coordinator->attempts[shard]);
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
+
+static STATUS_CODE collect_shard_result(ShardCoordinator* coordinator, ShardWorker* worker)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    STATUS_CODE shard_status = STATUS_CODE_UNINITIALIZED;
+    uint8_t* payload = NULL;
+    uint64_t payload_size = 0;
+    uint64_t result_size = 0;
+    uint32_t type = 0;
+    uint32_t shard = (uint32_t)worker->shard;
+
+    return_code = receive_shard_message(&type, &payload, &payload_size, worker->socket, SHARD_MAXIMAL_RESULT_PAYLOAD_SIZE);
+    if (STATUS_FAILED(return_code) || (SHARD_MESSAGE_RESULT != type) || (SHARD_RESULT_HEADER_SIZE > payload_size) ||
+        (shard != load_shard_u32(payload)))
+    {
+        // A dead worker, or one that no longer follows the protocol
+        return_code = handle_failed_shard_worker(coordinator, worker, STATUS_CODE_COULDNT_READ_FILE);
+        goto cleanup;
+    }
+    worker->shard = -1;
+
+    shard_status = (STATUS_CODE)(int32_t)load_shard_u32(payload + 4);
+    result_size = payload_size - SHARD_RESULT_HEADER_SIZE;
+    if (STATUS_SUCCESS(shard_status) &&
+        ((0 == result_size) ||
+         ((SHARD_DIRECTION_DECRYPT == coordinator->configuration->direction) && (result_size != coordinator->entries[shard].plaintext_size))))
+    {
+        log_error("[!] Shard %u came back with %llu bytes", shard, (unsigned long long)result_size);
+        shard_status = STATUS_CODE_ERROR_INVALID_SIZE;
+    }
+    if (STATUS_FAILED(shard_status))
+    {
+        return_code = retry_shard(coordinator, shard, shard_status);
+        goto cleanup;
+    }
+
+    return_code = store_shard_result(coordinator, shard, payload + SHARD_RESULT_HEADER_SIZE, result_size);
+cleanup:
+    free(payload);
+    return return_code;
+}
+
+/**
+ * @brief Hands the shards out to the workers and collects their results until every shard is stored.
+ *
+ * @param coordinator - The coordinator, its shards pending.
+ * @return STATUS_CODE - Status of the operation.
+ */
+static STATUS_CODE run_shard_workers(ShardCoordinator* coordinator)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    struct pollfd* poll_entries = NULL;
+    uint32_t* polled_workers = NULL;
+    uint32_t number_of_polled = 0;
+    uint32_t worker_index = 0;
+    uint32_t poll_index = 0;
+    ShardWorker* worker = NULL;
+
+    poll_entries = (struct pollfd*)calloc(coordinator->number_of_workers, sizeof(struct pollfd));
+    polled_workers = (uint32_t*)calloc(coordinator->number_of_workers, sizeof(uint32_t));
+    if ((NULL == poll_entries) || (NULL == polled_workers))
+    {
+        log_error("[!] Memory allocation failed in run_shard_workers");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    while (coordinator->number_of_completed < coordinator->header.number_of_shards)
+    {
+        number_of_polled = 0;
+        for (worker_index = 0; worker_index < coordinator->number_of_workers; ++worker_index)
+        {
+            worker = &coordinator->workers[worker_index];
+            if ((0 == worker->pid) && (0 != coordinator->number_of_pending))
+            {
+                return_code = start_shard_worker(coordinator, worker);
+                if (STATUS_FAILED(return_code))
+                {
+                    goto cleanup;
+                }
+            }
+            if ((0 != worker->pid) && (0 > worker->shard) && (0 != coordinator->number_of_pending))
+            {
+                return_code = dispatch_shard(coordinator, worker);
+                if (STATUS_FAILED(return_code))
+                {
+                    goto cleanup;
+                }
+            }
+            if ((0 != worker->pid) && (0 <= worker->shard))
+            {
+                poll_entries[number_of_polled].fd = worker->socket;
+                poll_entries[number_of_polled].events = POLLIN;
+                poll_entries[number_of_polled].revents = 0;
+                polled_workers[number_of_polled] = worker_index;
+                ++number_of_polled;
+            }
+        }
+
+        // Every remaining shard failed its dispatch, the loop starts workers for them again
+        if (0 == number_of_polled)
+        {
+            continue;
+        }
+
+        if (0 > poll(poll_entries, number_of_polled, -1))
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            log_error("[!] Failed to wait for the shard workers");
+            return_code = STATUS_CODE_COULDNT_READ_FILE;
+            goto cleanup;
+        }
+
+        for (poll_index = 0; poll_index < number_of_polled; ++poll_index)
+        {
+            if (0 == poll_entries[poll_index].revents)
+            {
+                continue;
+            }
+            return_code = collect_shard_result(coordinator, &coordinator->workers[polled_workers[poll_index]]);
+            if (STATUS_FAILED(return_code))
+            {
+                goto cleanup;
+            }
+        }
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free(poll_entries);
+    free(polled_workers);
+    return return_code;
+}
+
+static STATUS_CODE plan_shards(ShardCoordinator* coordinator)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    const ShardConfiguration* configuration = coordinator->configuration;
+    struct stat input_status = {0};
+    FILE* container = NULL;
+    uint64_t number_of_shards = 0;
+    uint64_t shard_index = 0;
+
+    if (SHARD_DIRECTION_DECRYPT == configuration->direction)
+    {
+        container = fopen(coordinator->input_file, "rb");
+        if (NULL == container)
+        {
+            log_error("[!] Failed to open the shard container %s", coordinator->input_file);
+            return_code = STATUS_CODE_INPUT_FILE_DOESNT_EXISTS_OR_NOT_READBLE;
+            goto cleanup;
+        }
+        return_code = read_shard_container_index(&coordinator->header, &coordinator->entries, container);
+        goto cleanup;
+    }
+
+    if ((0 != stat(coordinator->input_file, &input_status)) || !S_ISREG(input_status.st_mode))
+    {
+        log_error("[!] The input of a sharded encryption must be a regular file: %s", coordinator->input_file);
+        return_code = STATUS_CODE_INPUT_FILE_DOESNT_EXISTS_OR_NOT_READBLE;
+        goto cleanup;
+    }
+
+    number_of_shards = ((uint64_t)input_status.st_size + configuration->shard_size - 1) / configuration->shard_size;
+    if (UINT32_MAX < number_of_shards)
+    {
+        log_error("[!] %llu shards are too many, use larger shards", (unsigned long long)number_of_shards);
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    coordinator->header.version = SHARD_CONTAINER_VERSION;
+    coordinator->header.format = configuration->format;
+    coordinator->header.number_of_shards = (uint32_t)number_of_shards;
+    coordinator->header.plaintext_size = (uint64_t)input_status.st_size;
+    coordinator->header.shard_size = configuration->shard_size;
+
+    if (0 != number_of_shards)
+    {
+        coordinator->entries = (ShardIndexEntry*)calloc((size_t)number_of_shards, sizeof(ShardIndexEntry));
+        if (NULL == coordinator->entries)
+        {
+            log_error("[!] Memory allocation failed in plan_shards");
+            return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+            goto cleanup;
+        }
+    }
+    for (shard_index = 0; shard_index < number_of_shards; ++shard_index)
+    {
+        coordinator->entries[shard_index].plaintext_offset = shard_index * configuration->shard_size;
+        coordinator->entries[shard_index].plaintext_size = (shard_index + 1 == number_of_shards) ?
+            coordinator->header.plaintext_size - coordinator->entries[shard_index].plaintext_offset : configuration->shard_size;
+    }
+    coordinator->output_offset = SHARD_CONTAINER_HEADER_SIZE + (number_of_shards * SHARD_CONTAINER_INDEX_ENTRY_SIZE);
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    if (NULL != container)
+    {
+        fclose(container);
+    }
+    return return_code;
+}
+
+STATUS_CODE run_shard_coordinator(ShardSummary* out_summary, const char* output_file, const char* input_file, const char* key_file,
+    const ShardConfiguration* configuration)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    ShardCoordinator coordinator = {0};
+    uint64_t start_time = get_monotonic_time_ns();
+    uint32_t shard_index = 0;
+    uint32_t worker_index = 0;
+
+    if ((NULL == output_file) || (NULL == input_file) || (NULL == key_file) || (NULL == configuration) ||
+        (NUMBER_OF_SHARD_DIRECTIONS <= configuration->direction) || (NUMBER_OF_CIPHERTEXT_FORMATS <= configuration->format) ||
+        (0 == configuration->number_of_workers) ||
+        ((SHARD_DIRECTION_ENCRYPT == configuration->direction) &&
+         ((0 == configuration->shard_size) || (configuration->shard_size > (uint64_t)(MAXIMAL_SHARD_SIZE_IN_MEGABYTES * BYTES_IN_MEGABYTE)))))
+    {
+        log_error("[!] Invalid arguments in run_shard_coordinator");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    coordinator.configuration = configuration;
+    coordinator.input_file = input_file;
+    coordinator.key_file = key_file;
+
+    return_code = plan_shards(&coordinator);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    coordinator.summary.number_of_shards = coordinator.header.number_of_shards;
+
+    coordinator.output = fopen(output_file, "wb");
+    if (NULL == coordinator.output)
+    {
+        log_error("[!] Failed to create %s", output_file);
+        return_code = STATUS_CODE_COULDNT_CREATE_OUTPUT_FILE;
+        goto cleanup;
+    }
+    // Room for the index, which is only known once every shard is written
+    if (SHARD_DIRECTION_ENCRYPT == configuration->direction)
+    {
+        return_code = write_shard_container_index(coordinator.output, &coordinator.header, coordinator.entries, false);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+    }
+
+    if (0 != coordinator.header.number_of_shards)
+    {
+        coordinator.number_of_workers = (configuration->number_of_workers < coordinator.header.number_of_shards) ?
+            configuration->number_of_workers : coordinator.header.number_of_shards;
+        coordinator.attempts = (uint32_t*)calloc(coordinator.header.number_of_shards, sizeof(uint32_t));
+        coordinator.pending = (uint32_t*)calloc(coordinator.header.number_of_shards, sizeof(uint32_t));
+        coordinator.workers = (ShardWorker*)calloc(coordinator.number_of_workers, sizeof(ShardWorker));
+        if ((NULL == coordinator.attempts) || (NULL == coordinator.pending) || (NULL == coordinator.workers))
+        {
+            log_error("[!] Memory allocation failed in run_shard_coordinator");
+            return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+            goto cleanup;
+        }
+        for (worker_index = 0; worker_index < coordinator.number_of_workers; ++worker_index)
+        {
+            coordinator.workers[worker_index].socket = -1;
+            coordinator.workers[worker_index].shard = -1;
+        }
+        for (shard_index = 0; shard_index < coordinator.header.number_of_shards; ++shard_index)
+        {
+            push_pending_shard(&coordinator, shard_index);
+        }
+
+        // Nothing buffered may be written twice by the workers, they leave with _exit but flush before forking to be sure
+        fflush(NULL);
+        log_info("Sharding %u shards over %u worker processes", coordinator.header.number_of_shards, coordinator.number_of_workers);
+        return_code = run_shard_workers(&coordinator);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+    }
+
+    if (SHARD_DIRECTION_ENCRYPT == configuration->direction)
+    {
+        return_code = write_shard_container_index(coordinator.output, &coordinator.header, coordinator.entries, true);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+    }
+    if (0 != fclose(coordinator.output))
+    {
+        coordinator.output = NULL;
+        log_error("[!] Failed to close %s", output_file);
+        return_code = STATUS_CODE_COULDNT_WRITE_FILE;
+        goto cleanup;
+    }
+    coordinator.output = NULL;
+
+    coordinator.summary.elapsed_ns = get_monotonic_time_ns() - start_time;
+    if (NULL != out_summary)
+    {
+        *out_summary = coordinator.summary;
+    }
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    // Idle workers exit when their socket closes, the ones still busy after a failure are killed
+    for (worker_index = 0; (NULL != coordinator.workers) && (worker_index < coordinator.number_of_workers); ++worker_index)
+    {
+        stop_shard_worker(&coordinator.workers[worker_index], 0 <= coordinator.workers[worker_index].shard);
+    }
+    if (NULL != coordinator.output)
+    {
+        fclose(coordinator.output);
+    }
+    free(coordinator.workers);
+    free(coordinator.pending);
+    free(coordinator.attempts);
+    free(coordinator.entries);
+    return return_code;
+}
+
+#endif
@@ -0,0 +1,214 @@
+#include "Cipher/SpscQueue.h"
+#include "Instrumentation/Metrics.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sched.h>
+#include <time.h>
+#endif
+
+#ifdef _WIN32
+#define ATOMIC_LOAD(pointer) ((uint64_t)InterlockedCompareExchange64((volatile LONG64*)(pointer), 0, 0))
+#define ATOMIC_STORE(pointer, value) ((void)InterlockedExchange64((volatile LONG64*)(pointer), (LONG64)(value)))
+#else
+#define ATOMIC_LOAD(pointer) __atomic_load_n((pointer), __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE(pointer, value) __atomic_store_n((pointer), (value), __ATOMIC_RELEASE)
+#endif
+
+struct SpscQueue {
+    void** slots;
+    uint64_t mask; // capacity - 1
+    const uint64_t* abort_flag;
+    uint8_t producer_padding[SPSC_QUEUE_CACHE_LINE_SIZE];
+    uint64_t tail; // Next position pushed, stored by the producer only
+    uint64_t cached_head; // The producer's last view of head, refreshed when the ring looks full
+    uint8_t consumer_padding[SPSC_QUEUE_CACHE_LINE_SIZE];
+    uint64_t head; // Next position popped, stored by the consumer only
+    uint64_t cached_tail; // The consumer's last view of tail, refreshed when the ring looks empty
+    uint8_t end_padding[SPSC_QUEUE_CACHE_LINE_SIZE];
+};
+
+static bool is_spsc_queue_aborted(const SpscQueue* queue)
+{
+    return (NULL != queue->abort_flag) && (0 != ATOMIC_LOAD(queue->abort_flag));
+}
+
+static void back_off_spsc_queue(uint32_t attempt)
+{
+#ifdef _WIN32
+    if (attempt < SPSC_QUEUE_SPIN_LIMIT)
+    {
+        (void)SwitchToThread();
+    }
+    else
+    {
+        Sleep((SPSC_QUEUE_IDLE_SLEEP_US + 999) / 1000);
+    }
+#else
+    struct timespec duration = {0, SPSC_QUEUE_IDLE_SLEEP_US * 1000L};
+
+    if (attempt < SPSC_QUEUE_SPIN_LIMIT)
+    {
+        (void)sched_yield();
+    }
+    else
+    {
+        nanosleep(&duration, NULL);
+    }
+#endif
+}
+
+STATUS_CODE create_spsc_queue(SpscQueue** out_queue, uint32_t capacity, const uint64_t* abort_flag)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    SpscQueue* queue = NULL;
+    uint64_t rounded_capacity = 1;
+
+    if ((NULL == out_queue) || (0 == capacity))
+    {
+        log_error("[!] Invalid arguments in create_spsc_queue");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    // A power of two, so positions wrap with a mask and keep counting past the capacity
+    while (rounded_capacity < capacity)
+    {
+        rounded_capacity <<= 1;
+    }
+
+    queue = (SpscQueue*)calloc(1, sizeof(SpscQueue));
+    if (NULL == queue)
+    {
+        log_error("[!] Memory allocation failed in create_spsc_queue");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    queue->slots = (void**)calloc((size_t)rounded_capacity, sizeof(void*));
+    if (NULL == queue->slots)
+    {
+        log_error("[!] Memory allocation failed in create_spsc_queue");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    increase_metric_counter(METRIC_COUNTER_ALLOCATIONS, 2);
+    queue->mask = rounded_capacity - 1;
+    queue->abort_flag = abort_flag;
+
+    *out_queue = queue;
+    queue = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free_spsc_queue(&queue);
+    return return_code;
+}
+
+void free_spsc_queue(SpscQueue** queue)
+{
+    if ((NULL == queue) || (NULL == *queue))
+    {
+        return;
+    }
+
+    free((*queue)->slots);
+    free(*queue);
+    *queue = NULL;
+}
+
+bool try_push_spsc_queue(SpscQueue* queue, void* item)
+{
+    uint64_t tail = queue->tail;
+
+    if ((tail - queue->cached_head) > queue->mask)
+    {
+        queue->cached_head = ATOMIC_LOAD(&queue->head);
+        if ((tail - queue->cached_head) > queue->mask)
+        {
+            return false;
+        }
+    }
+
+    // The release store publishes the slot along with everything written to the item before it
+    queue->slots[tail & queue->mask] = item;
+    ATOMIC_STORE(&queue->tail, tail + 1);
+    return true;
+}
+
+bool try_pop_spsc_queue(void** out_item, SpscQueue* queue)
+{
+    uint64_t head = queue->head;
+
+    if (head == queue->cached_tail)
+    {
+        queue->cached_tail = ATOMIC_LOAD(&queue->tail);
+        if (head == queue->cached_tail)
+        {
+            return false;
+        }
+    }
+
+    *out_item = queue->slots[head & queue->mask];
+    ATOMIC_STORE(&queue->head, head + 1);
+    return true;
+}
+
+STATUS_CODE push_spsc_queue(SpscQueue* queue, void* item)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint32_t attempt = 0;
+
+    if (NULL == queue)
+    {
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    while (!try_push_spsc_queue(queue, item))
+    {
+        if (is_spsc_queue_aborted(queue))
+        {
+            return_code = STATUS_CODE_PIPELINE_ABORTED;
+            goto cleanup;
+        }
+        back_off_spsc_queue(attempt);
+        if (attempt < SPSC_QUEUE_SPIN_LIMIT)
+        {
+            ++attempt;
+        }
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE pop_spsc_queue(void** out_item, SpscQueue* queue)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint32_t attempt = 0;
+
+    if ((NULL == out_item) || (NULL == queue))
+    {
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    while (!try_pop_spsc_queue(out_item, queue))
+    {
+        if (is_spsc_queue_aborted(queue))
+        {
+            return_code = STATUS_CODE_PIPELINE_ABORTED;
+            goto cleanup;
+        }
+        back_off_spsc_queue(attempt);
+        if (attempt < SPSC_QUEUE_SPIN_LIMIT)
+        {
+            ++attempt;
+        }
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
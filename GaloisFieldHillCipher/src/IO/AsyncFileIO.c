@@ -0,0 +1,885 @@
+#include "IO/AsyncFileIO.h"
+
+#include <errno.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "Instrumentation/Metrics.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#include <malloc.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(HAVE_IO_URING)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+#define ASYNC_IO_HAS_IO_URING
+#endif
+#endif
+
+#ifdef _WIN32
+typedef CRITICAL_SECTION AsyncIOMutex;
+typedef CONDITION_VARIABLE AsyncIOCondition;
+typedef HANDLE AsyncIOThread;
+#else
+typedef pthread_mutex_t AsyncIOMutex;
+typedef pthread_cond_t AsyncIOCondition;
+typedef pthread_t AsyncIOThread;
+#endif
+
+enum ASYNC_IO_SLOT_STATE
+{
+    ASYNC_IO_SLOT_IDLE = 0, // With the caller or never submitted
+    ASYNC_IO_SLOT_QUEUED,
+    ASYNC_IO_SLOT_DONE
+} typedef ASYNC_IO_SLOT_STATE;
+
+struct AsyncIOSlot {
+    uint8_t* buffer;
+    int64_t offset;
+    size_t size; // Bytes asked for
+    size_t result; // Bytes read or written once done, short of size only at the end of the file or on error
+    int error; // errno of a failed operation
+    ASYNC_IO_SLOT_STATE state;
+} typedef AsyncIOSlot;
+
+#ifdef ASYNC_IO_HAS_IO_URING
+struct AsyncIORing {
+    int descriptor;
+    void* submission_ring;
+    size_t submission_ring_size;
+    void* completion_ring;
+    size_t completion_ring_size;
+    struct io_uring_sqe* entries;
+    size_t entries_size;
+    unsigned* submission_tail;
+    unsigned* submission_mask;
+    unsigned* submission_array;
+    unsigned* completion_head;
+    unsigned* completion_tail;
+    unsigned* completion_mask;
+    struct io_uring_cqe* completions;
+    bool has_registered_buffers; // Registering fails when the buffers exceed RLIMIT_MEMLOCK on older kernels
+    struct iovec vectors[ASYNC_IO_QUEUE_DEPTH];
+} typedef AsyncIORing;
+#endif
+
+struct AsyncFile {
+    ASYNC_IO_BACKEND backend;
+    FILE* stream;
+    int descriptor;
+    bool is_output;
+    bool is_seekable; // Pipes and terminals are read and written in order by the I/O thread instead
+    size_t chunk_size;
+    AsyncIOSlot slots[ASYNC_IO_QUEUE_DEPTH];
+    uint32_t next_slot; // Slots are submitted, completed and handed out in ring order
+    bool holds_slot; // The caller holds the slot before next_slot
+    bool reached_end; // A read came back short
+    int64_t next_offset; // Of the next submitted read or write
+    int64_t consumed_offset; // End of the chunks handed to the caller when reading
+    // I/O thread
+    AsyncIOMutex mutex;
+    AsyncIOCondition slot_queued;
+    AsyncIOCondition slot_done;
+    AsyncIOThread thread;
+    bool has_thread;
+    bool is_stopping;
+#ifdef ASYNC_IO_HAS_IO_URING
+    AsyncIORing ring;
+#endif
+};
+
+static uint8_t* allocate_async_io_buffer(size_t size)
+{
+#ifdef _WIN32
+    return (uint8_t*)_aligned_malloc(size, ASYNC_IO_BUFFER_ALIGNMENT);
+#else
+    void* buffer = NULL;
+
+    if (0 != posix_memalign(&buffer, ASYNC_IO_BUFFER_ALIGNMENT, size))
+    {
+        return NULL;
+    }
+    return (uint8_t*)buffer;
+#endif
+}
+
+static void free_async_io_buffer(uint8_t* buffer)
+{
+#ifdef _WIN32
+    _aligned_free(buffer);
+#else
+    free(buffer);
+#endif
+}
+
+static void lock_async_file(AsyncFile* file)
+{
+#ifdef _WIN32
+    EnterCriticalSection(&file->mutex);
+#else
+    pthread_mutex_lock(&file->mutex);
+#endif
+}
+
+static void unlock_async_file(AsyncFile* file)
+{
+#ifdef _WIN32
+    LeaveCriticalSection(&file->mutex);
+#else
+    pthread_mutex_unlock(&file->mutex);
+#endif
+}
+
+static void wait_async_file(AsyncFile* file, AsyncIOCondition* condition)
+{
+#ifdef _WIN32
+    SleepConditionVariableCS(condition, &file->mutex, INFINITE);
+#else
+    pthread_cond_wait(condition, &file->mutex);
+#endif
+}
+
+static void signal_async_file(AsyncIOCondition* condition)
+{
+#ifdef _WIN32
+    WakeAllConditionVariable(condition);
+#else
+    pthread_cond_broadcast(condition);
+#endif
+}
+
+/**
+ * Reads or writes the rest of a slot from already_done bytes on, until it's whole, the file ends or an error.
+ */
+static void transfer_async_io_slot(AsyncFile* file, AsyncIOSlot* slot, size_t already_done)
+{
+    size_t done = already_done;
+    int64_t count = 0;
+
+    while (done < slot->size)
+    {
+#ifdef _WIN32
+        count = file->is_output ?
+            _write(file->descriptor, slot->buffer + done, (unsigned int)(slot->size - done)) :
+            _read(file->descriptor, slot->buffer + done, (unsigned int)(slot->size - done));
+#else
+        if (file->is_seekable)
+        {
+            count = file->is_output ?
+                pwrite(file->descriptor, slot->buffer + done, slot->size - done, (off_t)(slot->offset + done)) :
+                pread(file->descriptor, slot->buffer + done, slot->size - done, (off_t)(slot->offset + done));
+        }
+        else
+        {
+            count = file->is_output ?
+                write(file->descriptor, slot->buffer + done, slot->size - done) :
+                read(file->descriptor, slot->buffer + done, slot->size - done);
+        }
+#endif
+        if (count < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            slot->error = errno;
+            break;
+        }
+        if (0 == count)
+        {
+            break;
+        }
+        done += (size_t)count;
+    }
+    slot->result = done;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI async_io_worker(LPVOID argument)
+#else
+static void* async_io_worker(void* argument)
+#endif
+{
+    AsyncFile* file = (AsyncFile*)argument;
+    AsyncIOSlot* slot = NULL;
+    uint32_t slot_index = 0;
+
+    lock_async_file(file);
+    for (;;)
+    {
+        slot = &file->slots[slot_index];
+        while (!file->is_stopping && (ASYNC_IO_SLOT_QUEUED != slot->state))
+        {
+            wait_async_file(file, &file->slot_queued);
+        }
+        if (ASYNC_IO_SLOT_QUEUED != slot->state)
+        {
+            break;
+        }
+        unlock_async_file(file);
+
+        transfer_async_io_slot(file, slot, 0);
+
+        lock_async_file(file);
+        slot->state = ASYNC_IO_SLOT_DONE;
+        signal_async_file(&file->slot_done);
+        slot_index = (slot_index + 1) % ASYNC_IO_QUEUE_DEPTH;
+    }
+    unlock_async_file(file);
+
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+#ifdef ASYNC_IO_HAS_IO_URING
+static int enter_io_uring(AsyncIORing* ring, unsigned to_submit, unsigned minimum_completions, unsigned flags)
+{
+    long result = 0;
+
+    do
+    {
+        result = syscall(__NR_io_uring_enter, ring->descriptor, to_submit, minimum_completions, flags, NULL, 0);
+    } while ((result < 0) && (EINTR == errno));
+    return (int)result;
+}
+
+static void free_io_uring(AsyncIORing* ring)
+{
+    if (NULL != ring->entries)
+    {
+        munmap(ring->entries, ring->entries_size);
+    }
+    if ((NULL != ring->completion_ring) && (ring->completion_ring != ring->submission_ring))
+    {
+        munmap(ring->completion_ring, ring->completion_ring_size);
+    }
+    if (NULL != ring->submission_ring)
+    {
+        munmap(ring->submission_ring, ring->submission_ring_size);
+    }
+    if (0 <= ring->descriptor)
+    {
+        close(ring->descriptor);
+    }
+    memset(ring, 0, sizeof(*ring));
+    ring->descriptor = -1;
+}
+
+static bool setup_io_uring(AsyncFile* file)
+{
+    AsyncIORing* ring = &file->ring;
+    struct io_uring_params parameters;
+    uint32_t slot = 0;
+    long descriptor = 0;
+
+    memset(&parameters, 0, sizeof(parameters));
+    descriptor = syscall(__NR_io_uring_setup, ASYNC_IO_QUEUE_DEPTH, &parameters);
+    if (descriptor < 0)
+    {
+        log_debug("io_uring_setup failed: %s", strerror(errno));
+        return false;
+    }
+    ring->descriptor = (int)descriptor;
+
+    ring->submission_ring_size = parameters.sq_off.array + (parameters.sq_entries * sizeof(unsigned));
+    ring->completion_ring_size = parameters.cq_off.cqes + (parameters.cq_entries * sizeof(struct io_uring_cqe));
+    if (0 != (parameters.features & IORING_FEAT_SINGLE_MMAP))
+    {
+        if (ring->completion_ring_size > ring->submission_ring_size)
+        {
+            ring->submission_ring_size = ring->completion_ring_size;
+        }
+        ring->completion_ring_size = ring->submission_ring_size;
+    }
+
+    ring->submission_ring = mmap(NULL, ring->submission_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->descriptor, IORING_OFF_SQ_RING);
+    if (MAP_FAILED == ring->submission_ring)
+    {
+        ring->submission_ring = NULL;
+        goto fail;
+    }
+    if (0 != (parameters.features & IORING_FEAT_SINGLE_MMAP))
+    {
+        ring->completion_ring = ring->submission_ring;
+    }
+    else
+    {
+        ring->completion_ring = mmap(NULL, ring->completion_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->descriptor, IORING_OFF_CQ_RING);
+        if (MAP_FAILED == ring->completion_ring)
+        {
+            ring->completion_ring = NULL;
+            goto fail;
+        }
+    }
+    ring->entries_size = parameters.sq_entries * sizeof(struct io_uring_sqe);
+    ring->entries = (struct io_uring_sqe*)mmap(NULL, ring->entries_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->descriptor, IORING_OFF_SQES);
+    if (MAP_FAILED == (void*)ring->entries)
+    {
+        ring->entries = NULL;
+        goto fail;
+    }
+
+    ring->submission_tail = (unsigned*)((uint8_t*)ring->submission_ring + parameters.sq_off.tail);
+    ring->submission_mask = (unsigned*)((uint8_t*)ring->submission_ring + parameters.sq_off.ring_mask);
+    ring->submission_array = (unsigned*)((uint8_t*)ring->submission_ring + parameters.sq_off.array);
+    ring->completion_head = (unsigned*)((uint8_t*)ring->completion_ring + parameters.cq_off.head);
+    ring->completion_tail = (unsigned*)((uint8_t*)ring->completion_ring + parameters.cq_off.tail);
+    ring->completion_mask = (unsigned*)((uint8_t*)ring->completion_ring + parameters.cq_off.ring_mask);
+    ring->completions = (struct io_uring_cqe*)((uint8_t*)ring->completion_ring + parameters.cq_off.cqes);
+
+    // Registered buffers are pinned once instead of mapped on every operation
+    for (slot = 0; slot < ASYNC_IO_QUEUE_DEPTH; ++slot)
+    {
+        ring->vectors[slot].iov_base = file->slots[slot].buffer;
+        ring->vectors[slot].iov_len = file->chunk_size;
+    }
+    ring->has_registered_buffers = (0 == syscall(__NR_io_uring_register, ring->descriptor, IORING_REGISTER_BUFFERS, ring->vectors, ASYNC_IO_QUEUE_DEPTH));
+    if (!ring->has_registered_buffers)
+    {
+        log_debug("Registering io_uring buffers failed, using vectored operations: %s", strerror(errno));
+    }
+    return true;
+
+fail:
+    log_debug("Mapping the io_uring rings failed: %s", strerror(errno));
+    free_io_uring(ring);
+    return false;
+}
+
+static bool submit_io_uring_slot(AsyncFile* file, uint32_t slot_index)
+{
+    AsyncIORing* ring = &file->ring;
+    AsyncIOSlot* slot = &file->slots[slot_index];
+    struct io_uring_sqe* entry = NULL;
+    unsigned tail = *ring->submission_tail; // Only this thread moves the tail
+    unsigned index = tail & *ring->submission_mask;
+
+    // At most ASYNC_IO_QUEUE_DEPTH operations are in flight, the ring has at least as many entries
+    entry = &ring->entries[index];
+    memset(entry, 0, sizeof(*entry));
+    entry->fd = file->descriptor;
+    entry->off = (uint64_t)slot->offset;
+    entry->user_data = slot_index;
+    if (ring->has_registered_buffers)
+    {
+        entry->opcode = file->is_output ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+        entry->addr = (uint64_t)(uintptr_t)slot->buffer;
+        entry->len = (uint32_t)slot->size;
+        entry->buf_index = (uint16_t)slot_index;
+    }
+    else
+    {
+        ring->vectors[slot_index].iov_len = slot->size;
+        entry->opcode = file->is_output ? IORING_OP_WRITEV : IORING_OP_READV;
+        entry->addr = (uint64_t)(uintptr_t)&ring->vectors[slot_index];
+        entry->len = 1;
+    }
+    ring->submission_array[index] = index;
+    __atomic_store_n(ring->submission_tail, tail + 1, __ATOMIC_RELEASE);
+
+    return (1 == enter_io_uring(ring, 1, 0, 0));
+}
+
+static bool reap_io_uring_completion(AsyncFile* file)
+{
+    AsyncIORing* ring = &file->ring;
+    struct io_uring_cqe* completion = NULL;
+    AsyncIOSlot* slot = NULL;
+    unsigned head = *ring->completion_head;
+
+    while (head == __atomic_load_n(ring->completion_tail, __ATOMIC_ACQUIRE))
+    {
+        if (enter_io_uring(ring, 0, 1, IORING_ENTER_GETEVENTS) < 0)
+        {
+            log_error("[!] Waiting for io_uring completions failed: %s", strerror(errno));
+            return false;
+        }
+    }
+
+    completion = &ring->completions[head & *ring->completion_mask];
+    slot = &file->slots[completion->user_data % ASYNC_IO_QUEUE_DEPTH];
+    if (completion->res < 0)
+    {
+        slot->error = -completion->res;
+        slot->result = 0;
+    }
+    else
+    {
+        slot->result = (size_t)completion->res;
+    }
+    __atomic_store_n(ring->completion_head, head + 1, __ATOMIC_RELEASE);
+
+    // A short transfer is finished in place, for a read it's usually the end of the file and costs one empty pread
+    if ((0 == slot->error) && (slot->result < slot->size))
+    {
+        transfer_async_io_slot(file, slot, slot->result);
+    }
+    slot->state = ASYNC_IO_SLOT_DONE;
+    return true;
+}
+#endif
+
+static STATUS_CODE submit_async_io_slot(AsyncFile* file, uint32_t slot_index, size_t size)
+{
+    AsyncIOSlot* slot = &file->slots[slot_index];
+
+    slot->offset = file->next_offset;
+    slot->size = size;
+    slot->result = 0;
+    slot->error = 0;
+    file->next_offset += (int64_t)size;
+
+#ifdef ASYNC_IO_HAS_IO_URING
+    if (ASYNC_IO_BACKEND_IO_URING == file->backend)
+    {
+        slot->state = ASYNC_IO_SLOT_QUEUED;
+        if (!submit_io_uring_slot(file, slot_index))
+        {
+            log_error("[!] Failed to submit an io_uring %s: %s", file->is_output ? "write" : "read", strerror(errno));
+            slot->state = ASYNC_IO_SLOT_IDLE;
+            return file->is_output ? STATUS_CODE_COULDNT_WRITE_FILE : STATUS_CODE_COULDNT_READ_FILE;
+        }
+        return STATUS_CODE_SUCCESS;
+    }
+#endif
+
+    lock_async_file(file);
+    slot->state = ASYNC_IO_SLOT_QUEUED;
+    signal_async_file(&file->slot_queued);
+    unlock_async_file(file);
+    return STATUS_CODE_SUCCESS;
+}
+
+/**
+ * Waits until a slot isn't queued, and hands it to the caller when take is set.
+ * The I/O thread reads the states under the mutex, so they only change under it.
+ */
+static STATUS_CODE wait_async_io_slot(AsyncFile* file, uint32_t slot_index, bool take)
+{
+    AsyncIOSlot* slot = &file->slots[slot_index];
+
+#ifdef ASYNC_IO_HAS_IO_URING
+    if (ASYNC_IO_BACKEND_IO_URING == file->backend)
+    {
+        while (ASYNC_IO_SLOT_QUEUED == slot->state)
+        {
+            if (!reap_io_uring_completion(file))
+            {
+                return file->is_output ? STATUS_CODE_COULDNT_WRITE_FILE : STATUS_CODE_COULDNT_READ_FILE;
+            }
+        }
+        if (take)
+        {
+            slot->state = ASYNC_IO_SLOT_IDLE;
+        }
+        return STATUS_CODE_SUCCESS;
+    }
+#endif
+
+    lock_async_file(file);
+    while (ASYNC_IO_SLOT_QUEUED == slot->state)
+    {
+        wait_async_file(file, &file->slot_done);
+    }
+    if (take)
+    {
+        slot->state = ASYNC_IO_SLOT_IDLE;
+    }
+    unlock_async_file(file);
+    return STATUS_CODE_SUCCESS;
+}
+
+static STATUS_CODE check_async_io_slot(const AsyncFile* file, const AsyncIOSlot* slot)
+{
+    if (0 != slot->error)
+    {
+        log_error("[!] Async %s of %zu bytes at offset %lld failed: %s", file->is_output ? "write" : "read",
+            slot->size, (long long)slot->offset, strerror(slot->error));
+        return file->is_output ? STATUS_CODE_COULDNT_WRITE_FILE : STATUS_CODE_COULDNT_READ_FILE;
+    }
+    if (file->is_output && (slot->result != slot->size))
+    {
+        log_error("[!] Async write wrote %zu of %zu bytes at offset %lld", slot->result, slot->size, (long long)slot->offset);
+        return STATUS_CODE_COULDNT_WRITE_FILE;
+    }
+    return STATUS_CODE_SUCCESS;
+}
+
+STATUS_CODE parse_async_io_backend(ASYNC_IO_BACKEND* out_backend, const char* name)
+{
+    if (NULL == out_backend)
+    {
+        log_error("[!] Invalid arguments in parse_async_io_backend");
+        return STATUS_CODE_INVALID_ARGUMENT;
+    }
+
+    if ((NULL == name) || (0 == strcmp(name, IO_BACKEND_AUTO)))
+    {
+        *out_backend = ASYNC_IO_BACKEND_AUTO;
+    }
+    else if (0 == strcmp(name, IO_BACKEND_IO_URING))
+    {
+        *out_backend = ASYNC_IO_BACKEND_IO_URING;
+    }
+    else if (0 == strcmp(name, IO_BACKEND_THREADS))
+    {
+        *out_backend = ASYNC_IO_BACKEND_THREADS;
+    }
+    else
+    {
+        log_error("[!] Unknown I/O backend: %s", name);
+        return STATUS_CODE_INVALID_ARGUMENT;
+    }
+    return STATUS_CODE_SUCCESS;
+}
+
+STATUS_CODE open_async_file(AsyncFile** out_file, FILE* stream, bool is_output, size_t chunk_size, ASYNC_IO_BACKEND backend)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    AsyncFile* file = NULL;
+    bool is_regular_file = false;
+    struct stat file_status;
+    uint32_t slot = 0;
+
+    if ((NULL == out_file) || (NULL == stream) || (0 == chunk_size) || (backend >= NUMBER_OF_ASYNC_IO_BACKENDS))
+    {
+        log_error("[!] Invalid arguments in open_async_file");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    file = (AsyncFile*)calloc(1, sizeof(AsyncFile));
+    if (NULL == file)
+    {
+        log_error("[!] Memory allocation failed in open_async_file");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    file->stream = stream;
+    file->is_output = is_output;
+    file->chunk_size = chunk_size;
+#ifdef ASYNC_IO_HAS_IO_URING
+    file->ring.descriptor = -1;
+#endif
+
+    if (is_output && (0 != fflush(stream)))
+    {
+        log_error("[!] Failed to flush the output stream");
+        return_code = STATUS_CODE_COULDNT_WRITE_FILE;
+        goto cleanup;
+    }
+
+    for (slot = 0; slot < ASYNC_IO_QUEUE_DEPTH; ++slot)
+    {
+        file->slots[slot].buffer = allocate_async_io_buffer(chunk_size);
+        if (NULL == file->slots[slot].buffer)
+        {
+            log_error("[!] Memory allocation failed in open_async_file");
+            return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+            goto cleanup;
+        }
+    }
+    increase_metric_counter(METRIC_COUNTER_ALLOCATIONS, ASYNC_IO_QUEUE_DEPTH);
+
+#ifdef _WIN32
+    file->descriptor = _fileno(stream);
+    // Windows has no positioned reads on CRT descriptors, the I/O thread reads and writes in order
+    file->is_seekable = false;
+#else
+    file->descriptor = fileno(stream);
+    file->is_seekable = (0 <= lseek(file->descriptor, 0, SEEK_CUR));
+    // The stream's own position, the descriptor may be ahead of it by what the stream buffered
+    file->next_offset = file->is_seekable ? (int64_t)ftello(stream) : 0;
+    if (file->next_offset < 0)
+    {
+        file->next_offset = 0;
+    }
+#endif
+    file->consumed_offset = file->next_offset;
+    is_regular_file = (0 == fstat(file->descriptor, &file_status)) && S_ISREG(file_status.st_mode);
+
+    file->backend = ASYNC_IO_BACKEND_THREADS;
+    if ((ASYNC_IO_BACKEND_THREADS != backend) && is_regular_file && file->is_seekable)
+    {
+#ifdef ASYNC_IO_HAS_IO_URING
+        if (setup_io_uring(file))
+        {
+            file->backend = ASYNC_IO_BACKEND_IO_URING;
+        }
+#endif
+    }
+    if ((ASYNC_IO_BACKEND_IO_URING == backend) && (ASYNC_IO_BACKEND_IO_URING != file->backend))
+    {
+        log_warn("[!] io_uring is not available for this %s, falling back to the I/O thread", is_regular_file ? "kernel" : "stream");
+    }
+
+    if (ASYNC_IO_BACKEND_THREADS == file->backend)
+    {
+#ifdef _WIN32
+        InitializeCriticalSection(&file->mutex);
+        InitializeConditionVariable(&file->slot_queued);
+        InitializeConditionVariable(&file->slot_done);
+        file->thread = CreateThread(NULL, 0, async_io_worker, file, 0, NULL);
+        file->has_thread = (NULL != file->thread);
+#else
+        pthread_mutex_init(&file->mutex, NULL);
+        pthread_cond_init(&file->slot_queued, NULL);
+        pthread_cond_init(&file->slot_done, NULL);
+        file->has_thread = (0 == pthread_create(&file->thread, NULL, async_io_worker, file));
+#endif
+        if (!file->has_thread)
+        {
+            log_error("[!] Failed to start the I/O thread");
+            return_code = STATUS_CODE_COULDNT_START_THREAD;
+            goto cleanup;
+        }
+    }
+
+    log_debug("Async %s on the %s backend with %u buffers of %zu bytes", is_output ? "writes" : "reads",
+        (ASYNC_IO_BACKEND_IO_URING == file->backend) ? IO_BACKEND_IO_URING : IO_BACKEND_THREADS, ASYNC_IO_QUEUE_DEPTH, chunk_size);
+
+    // Reads start right away so the first chunks are in flight while the caller sets up
+    if (!is_output)
+    {
+        for (slot = 0; slot < ASYNC_IO_QUEUE_DEPTH; ++slot)
+        {
+            return_code = submit_async_io_slot(file, slot, chunk_size);
+            if (STATUS_FAILED(return_code))
+            {
+                goto cleanup;
+            }
+        }
+    }
+
+    *out_file = file;
+    file = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    if (NULL != file)
+    {
+        (void)close_async_file(&file);
+    }
+    return return_code;
+}
+
+ASYNC_IO_BACKEND get_async_file_backend(const AsyncFile* file)
+{
+    return (NULL != file) ? file->backend : ASYNC_IO_BACKEND_THREADS;
+}
+
+STATUS_CODE async_read_next(const uint8_t** out_chunk, size_t* out_size, AsyncFile* file)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    AsyncIOSlot* slot = NULL;
+
+    if ((NULL == out_chunk) || (NULL == out_size) || (NULL == file) || file->is_output)
+    {
+        log_error("[!] Invalid arguments in async_read_next");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    if (file->reached_end)
+    {
+        *out_chunk = NULL;
+        *out_size = 0;
+        return_code = STATUS_CODE_SUCCESS;
+        goto cleanup;
+    }
+
+    // The chunk handed out last goes back to be read ahead
+    if (file->holds_slot)
+    {
+        file->holds_slot = false;
+        return_code = submit_async_io_slot(file, (file->next_slot + ASYNC_IO_QUEUE_DEPTH - 1) % ASYNC_IO_QUEUE_DEPTH, file->chunk_size);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+    }
+
+    return_code = wait_async_io_slot(file, file->next_slot, true);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    slot = &file->slots[file->next_slot];
+    return_code = check_async_io_slot(file, slot);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    file->reached_end = (slot->result < slot->size);
+    file->consumed_offset += (int64_t)slot->result;
+    file->next_slot = (file->next_slot + 1) % ASYNC_IO_QUEUE_DEPTH;
+    file->holds_slot = true;
+
+    *out_chunk = slot->buffer;
+    *out_size = slot->result;
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE async_write_acquire(uint8_t** out_buffer, AsyncFile* file)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    AsyncIOSlot* slot = NULL;
+
+    if ((NULL == out_buffer) || (NULL == file) || !file->is_output || file->holds_slot)
+    {
+        log_error("[!] Invalid arguments in async_write_acquire");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    // The write this buffer held last is the oldest in flight, everything newer keeps going
+    return_code = wait_async_io_slot(file, file->next_slot, true);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    slot = &file->slots[file->next_slot];
+    return_code = check_async_io_slot(file, slot);
+    slot->error = 0;
+    slot->size = 0;
+    slot->result = 0;
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    file->holds_slot = true;
+    *out_buffer = slot->buffer;
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE async_write_submit(AsyncFile* file, size_t size)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+
+    if ((NULL == file) || !file->is_output || !file->holds_slot || (size > file->chunk_size))
+    {
+        log_error("[!] Invalid arguments in async_write_submit");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    file->holds_slot = false;
+    // An empty chunk keeps its slot, so the I/O thread never waits on a slot that won't be queued
+    if (0 == size)
+    {
+        return_code = STATUS_CODE_SUCCESS;
+        goto cleanup;
+    }
+
+    return_code = submit_async_io_slot(file, file->next_slot, size);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    file->next_slot = (file->next_slot + 1) % ASYNC_IO_QUEUE_DEPTH;
+
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE close_async_file(AsyncFile** file)
+{
+    STATUS_CODE return_code = STATUS_CODE_SUCCESS;
+    STATUS_CODE slot_return_code = STATUS_CODE_UNINITIALIZED;
+    AsyncFile* closed_file = NULL;
+    uint32_t slot = 0, slot_index = 0;
+
+    if ((NULL == file) || (NULL == *file))
+    {
+        return STATUS_CODE_SUCCESS;
+    }
+    closed_file = *file;
+    *file = NULL;
+
+    // In ring order, the I/O thread serves the slots in the order they were queued
+    for (slot = 0; slot < ASYNC_IO_QUEUE_DEPTH; ++slot)
+    {
+        slot_index = (closed_file->next_slot + slot) % ASYNC_IO_QUEUE_DEPTH;
+        // Nothing was queued on a file that failed to open
+        if ((NULL == closed_file->slots[slot_index].buffer) || (ASYNC_IO_BACKEND_AUTO == closed_file->backend) ||
+            ((ASYNC_IO_BACKEND_THREADS == closed_file->backend) && !closed_file->has_thread))
+        {
+            continue;
+        }
+        slot_return_code = wait_async_io_slot(closed_file, slot_index, false);
+        if (STATUS_SUCCESS(slot_return_code) && closed_file->is_output)
+        {
+            slot_return_code = check_async_io_slot(closed_file, &closed_file->slots[slot_index]);
+        }
+        if (STATUS_FAILED(slot_return_code) && STATUS_SUCCESS(return_code))
+        {
+            return_code = slot_return_code;
+        }
+    }
+
+    if (ASYNC_IO_BACKEND_THREADS == closed_file->backend)
+    {
+        if (closed_file->has_thread)
+        {
+            lock_async_file(closed_file);
+            closed_file->is_stopping = true;
+            signal_async_file(&closed_file->slot_queued);
+            unlock_async_file(closed_file);
+#ifdef _WIN32
+            WaitForSingleObject(closed_file->thread, INFINITE);
+            CloseHandle(closed_file->thread);
+#else
+            pthread_join(closed_file->thread, NULL);
+#endif
+        }
+#ifdef _WIN32
+        DeleteCriticalSection(&closed_file->mutex);
+#else
+        pthread_mutex_destroy(&closed_file->mutex);
+        pthread_cond_destroy(&closed_file->slot_queued);
+        pthread_cond_destroy(&closed_file->slot_done);
+#endif
+    }
+#ifdef ASYNC_IO_HAS_IO_URING
+    free_io_uring(&closed_file->ring);
+#endif
+
+#ifndef _WIN32
+    // Positioned transfers leave the stream where it was, it's moved past what was read or written
+    if (closed_file->is_seekable && (0 != fseeko(closed_file->stream, (off_t)(closed_file->is_output ? closed_file->next_offset : closed_file->consumed_offset), SEEK_SET)))
+    {
+        log_error("[!] Failed to position the stream after async %s", closed_file->is_output ? "writes" : "reads");
+        if (STATUS_SUCCESS(return_code))
+        {
+            return_code = closed_file->is_output ? STATUS_CODE_COULDNT_WRITE_FILE : STATUS_CODE_COULDNT_READ_FILE;
+        }
+    }
+#endif
+
+    for (slot = 0; slot < ASYNC_IO_QUEUE_DEPTH; ++slot)
+    {
+        free_async_io_buffer(closed_file->slots[slot].buffer);
+    }
+    free(closed_file);
+    return return_code;
+}
@@ -0,0 +1,308 @@
+#include "IO/AsyncLogger.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+#define ATOMIC_LOAD(pointer) ((uint64_t)InterlockedCompareExchange64((volatile LONG64*)(pointer), 0, 0))
+#define ATOMIC_STORE(pointer, value) ((void)InterlockedExchange64((volatile LONG64*)(pointer), (LONG64)(value)))
+#define ATOMIC_FETCH_ADD(pointer, value) ((uint64_t)InterlockedExchangeAdd64((volatile LONG64*)(pointer), (LONG64)(value)))
+#define ATOMIC_COMPARE_EXCHANGE(pointer, expected, desired) \
+    ((uint64_t)InterlockedCompareExchange64((volatile LONG64*)(pointer), (LONG64)(desired), (LONG64)(expected)) == (expected))
+#else
+#define ATOMIC_LOAD(pointer) __atomic_load_n((pointer), __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE(pointer, value) __atomic_store_n((pointer), (value), __ATOMIC_RELEASE)
+#define ATOMIC_FETCH_ADD(pointer, value) __atomic_fetch_add((pointer), (value), __ATOMIC_ACQ_REL)
+#define ATOMIC_COMPARE_EXCHANGE(pointer, expected, desired) \
+    __atomic_compare_exchange_n((pointer), &(expected), (desired), false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)
+#endif
+
+struct AsyncLogCell {
+    uint64_t sequence; // == position when free for the producer of that position, position + 1 once published
+    AsyncLogRecord record;
+} typedef AsyncLogCell;
+
+// Static storage so a log call racing with stop_async_logger never touches freed memory
+static AsyncLogCell g_ring[ASYNC_LOG_RING_CAPACITY];
+static uint64_t g_enqueue_position = 0;
+static uint64_t g_dequeue_position = 0;
+static uint64_t g_dropped_records = 0;
+static uint64_t g_accepting_records = 0;
+static uint64_t g_stop_requested = 0;
+static FILE* g_output = NULL;
+static int g_level = LOG_TRACE;
+static bool g_callback_registered = false;
+static bool g_running = false;
+static bool g_is_synchronous = false; // In a forked child, which has no writer thread, log calls write their own records
+
+#ifdef _WIN32
+static HANDLE g_writer_thread = NULL;
+#else
+static pthread_t g_writer_thread;
+#endif
+
+static void write_async_log_record(const AsyncLogRecord* record)
+{
+    char time_text[ASYNC_LOG_TIME_SIZE] = {0};
+
+    time_text[strftime(time_text, sizeof(time_text), ASYNC_LOG_TIME_FORMAT, &record->time)] = '\0';
+    fprintf(g_output, "%s %-5s %s:%d: %s\n", time_text, log_level_string(record->level), record->file, record->line, record->message);
+}
+
+static void fill_async_log_record(AsyncLogRecord* record, log_Event* event)
+{
+    if (NULL != event->time)
+    {
+        record->time = *event->time;
+    }
+    else
+    {
+        memset(&record->time, 0, sizeof(record->time));
+    }
+    record->file = event->file;
+    record->line = event->line;
+    record->level = event->level;
+    vsnprintf(record->message, ASYNC_LOG_MESSAGE_SIZE, event->fmt, event->ap);
+}
+
+static void async_log_callback(log_Event* event)
+{
+    uint64_t position = 0, sequence = 0;
+    AsyncLogCell* cell = NULL;
+    AsyncLogRecord record;
+
+    if ((0 == ATOMIC_LOAD(&g_accepting_records)) || (event->level < g_level))
+    {
+        return;
+    }
+
+    if (g_is_synchronous)
+    {
+        fill_async_log_record(&record, event);
+        write_async_log_record(&record);
+        fflush(g_output);
+        return;
+    }
+
+    position = ATOMIC_LOAD(&g_enqueue_position);
+    for (;;)
+    {
+        cell = &g_ring[position & (ASYNC_LOG_RING_CAPACITY - 1)];
+        sequence = ATOMIC_LOAD(&cell->sequence);
+        if (sequence == position)
+        {
+            if (ATOMIC_COMPARE_EXCHANGE(&g_enqueue_position, position, position + 1))
+            {
+                break;
+            }
+            // Another producer claimed this position
+            position = ATOMIC_LOAD(&g_enqueue_position);
+        }
+        else if (sequence < position)
+        {
+            // The writer has not released this cell yet, the ring is full
+            (void)ATOMIC_FETCH_ADD(&g_dropped_records, 1);
+            return;
+        }
+        else
+        {
+            position = ATOMIC_LOAD(&g_enqueue_position);
+        }
+    }
+
+    fill_async_log_record(&cell->record, event);
+    ATOMIC_STORE(&cell->sequence, position + 1);
+}
+
+/**
+ * @brief Writes every published record, the writer is the only consumer so the dequeue position needs no atomics.
+ *
+ * @return The number of records written.
+ */
+static uint64_t drain_async_log_ring(void)
+{
+    AsyncLogCell* cell = NULL;
+    uint64_t written_records = 0;
+
+    for (;;)
+    {
+        cell = &g_ring[g_dequeue_position & (ASYNC_LOG_RING_CAPACITY - 1)];
+        if (ATOMIC_LOAD(&cell->sequence) != (g_dequeue_position + 1))
+        {
+            break;
+        }
+
+        write_async_log_record(&cell->record);
+        ATOMIC_STORE(&cell->sequence, g_dequeue_position + ASYNC_LOG_RING_CAPACITY);
+        ++g_dequeue_position;
+        ++written_records;
+    }
+
+    return written_records;
+}
+
+static void sleep_async_logger(void)
+{
+#ifdef _WIN32
+    Sleep(ASYNC_LOG_IDLE_SLEEP_MS);
+#else
+    struct timespec duration = {0, ASYNC_LOG_IDLE_SLEEP_MS * 1000000L};
+    nanosleep(&duration, NULL);
+#endif
+}
+
+#ifdef _WIN32
+static DWORD WINAPI async_logger_writer(LPVOID argument)
+#else
+static void* async_logger_writer(void* argument)
+#endif
+{
+    bool has_unflushed_records = false;
+    (void)argument;
+
+    for (;;)
+    {
+        if (0 != drain_async_log_ring())
+        {
+            has_unflushed_records = true;
+            continue;
+        }
+
+        // Flush only when the ring runs dry, bursts of records share a single flush
+        if (has_unflushed_records)
+        {
+            fflush(g_output);
+            has_unflushed_records = false;
+        }
+
+        if (0 != ATOMIC_LOAD(&g_stop_requested))
+        {
+            break;
+        }
+        sleep_async_logger();
+    }
+
+    return 0;
+}
+
+STATUS_CODE start_async_logger(FILE* output, int level)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint64_t index = 0;
+
+    if ((NULL == output) || g_running)
+    {
+        log_error("[!] Invalid arguments in start_async_logger");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    for (index = 0; index < ASYNC_LOG_RING_CAPACITY; ++index)
+    {
+        g_ring[index].sequence = index;
+    }
+    g_enqueue_position = 0;
+    g_dequeue_position = 0;
+    g_dropped_records = 0;
+    g_stop_requested = 0;
+    g_output = output;
+    g_level = level;
+    g_is_synchronous = false;
+
+#ifdef _WIN32
+    g_writer_thread = CreateThread(NULL, 0, async_logger_writer, NULL, 0, NULL);
+    if (NULL == g_writer_thread)
+#else
+    if (0 != pthread_create(&g_writer_thread, NULL, async_logger_writer, NULL))
+#endif
+    {
+        log_error("[!] Failed to start the log writer thread");
+        return_code = STATUS_CODE_COULDNT_START_THREAD;
+        goto cleanup;
+    }
+    g_running = true;
+
+    // log.c has no way to remove a callback, a stopped logger simply stops accepting records
+    if (!g_callback_registered)
+    {
+        log_add_callback(async_log_callback, NULL, LOG_TRACE);
+        g_callback_registered = true;
+    }
+    ATOMIC_STORE(&g_accepting_records, 1);
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
+
+void stop_async_logger(void)
+{
+    uint64_t dropped_records = 0;
+
+    if (!g_running)
+    {
+        return;
+    }
+
+    ATOMIC_STORE(&g_accepting_records, 0);
+    ATOMIC_STORE(&g_stop_requested, 1);
+#ifdef _WIN32
+    WaitForSingleObject(g_writer_thread, INFINITE);
+    CloseHandle(g_writer_thread);
+    g_writer_thread = NULL;
+#else
+    pthread_join(g_writer_thread, NULL);
+#endif
+    g_running = false;
+
+    // Records published after the writer's last pass
+    (void)drain_async_log_ring();
+
+    dropped_records = ATOMIC_LOAD(&g_dropped_records);
+    if (0 != dropped_records)
+    {
+        fprintf(g_output, "[!] Async logger dropped %llu records, the ring was full\n", (unsigned long long)dropped_records);
+    }
+    fflush(g_output);
+}
+
+void switch_async_logger_to_synchronous_after_fork(void)
+{
+#ifndef _WIN32
+    int descriptor = -1;
+    FILE* output = NULL;
+
+    if (!g_running)
+    {
+        return;
+    }
+    g_running = false;
+
+    // A stream of its own on the same file, the buffer of the inherited stream may hold records the parent still writes
+    descriptor = dup(fileno(g_output));
+    if (0 <= descriptor)
+    {
+        output = fdopen(descriptor, "w");
+    }
+    if (NULL == output)
+    {
+        if (0 <= descriptor)
+        {
+            close(descriptor);
+        }
+        ATOMIC_STORE(&g_accepting_records, 0);
+        return;
+    }
+    g_output = output;
+    g_is_synchronous = true;
+#endif
+}
+
+uint64_t get_async_logger_dropped_records(void)
+{
+    return ATOMIC_LOAD(&g_dropped_records);
+}
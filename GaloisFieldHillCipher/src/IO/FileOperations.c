@@ -101,6 +101,7 @@ STATUS_CODE read_uint8_from_file(uint8_t** out_data, uint32_t* out_size, const c
         return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
         goto cleanup;
     }
+    increase_metric_counter(METRIC_COUNTER_ALLOCATIONS, 1);
 
     size_read = (uint32_t)fread(data, 1, size, file);
     if (size_read != size)
@@ -125,3 +126,58 @@ cleanup:
     free(data);
     return return_code;
 }
+
+STATUS_CODE open_stream(FILE** out_stream, const char* filepath, bool is_output)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    FILE* stream = NULL;
+    bool is_binary = false;
+
+    if (!out_stream || !filepath)
+    {
+        log_error("[!] Invalid arguments in open_stream: %s", !out_stream ? "out_stream is NULL" : "filepath is NULL");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    if (is_standard_stream_path(filepath))
+    {
+        stream = is_output ? stdout : stdin;
+#ifdef _WIN32
+        if (-1 == _setmode(_fileno(stream), _O_BINARY))
+        {
+            log_error("[!] Failed to switch the standard %s to binary mode", is_output ? "output" : "input");
+            return_code = STATUS_CODE_COULDNT_OPEN_FILE;
+            goto cleanup;
+        }
+#endif
+        log_debug("Streaming %s the standard %s", is_output ? "to" : "from", is_output ? "output" : "input");
+    }
+    else
+    {
+        is_binary = STATUS_SUCCESS(validate_file_is_binary(filepath));
+        stream = fopen(filepath, is_output ? (is_binary ? "wb" : "w") : (is_binary ? "rb" : "r"));
+        if (!stream)
+        {
+            log_error("[!] Failed to open file for %s: %s", is_output ? "writing" : "reading", filepath);
+            return_code = is_output ? STATUS_CODE_COULDNT_CREATE_OUTPUT_FILE : STATUS_CODE_COULDNT_READ_FILE;
+            goto cleanup;
+        }
+        log_debug("Streaming %s file %s", is_output ? "to" : "from", filepath);
+    }
+
+    *out_stream = stream;
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    return return_code;
+}
+
+void close_stream(FILE* stream)
+{
+    if ((NULL == stream) || (stdin == stream) || (stdout == stream))
+    {
+        return;
+    }
+    fclose(stream);
+}
@@ -92,3 +92,36 @@ STATUS_CODE validate_file_is_writeable(const char* path)
 cleanup:
     return return_code;
 }
+
+STATUS_CODE validate_path_is_directory(const char* path)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    struct stat path_status;
+
+    if (!path)
+    {
+        log_error("[!] Invalid argument: path is NULL");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    log_debug("Checking if path is a directory: %s", path);
+
+    // S_ISDIR is missing from the Windows headers, the type bits are compared directly
+    if ((0 != stat(path, &path_status)) || (S_IFDIR != (path_status.st_mode & S_IFMT)))
+    {
+        log_debug("Path is not a directory: %s", path);
+        return_code = STATUS_CODE_INPUT_FILE_DOESNT_EXISTS_OR_NOT_READBLE;
+        goto cleanup;
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    return return_code;
+}
+
+bool is_standard_stream_path(const char* path)
+{
+    return (NULL != path) && (0 == strcmp(path, STANDARD_STREAM_PATH));
+}
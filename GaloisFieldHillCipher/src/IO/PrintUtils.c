@@ -1,19 +1,128 @@
 #include "IO/PrintUtils.h"
 
-void print_uint8_vector(const uint8_t* data, size_t size, const char* prefix, bool is_verbose_only)
+typedef int (*PreviewElementFormatter)(char* buffer, size_t buffer_size, const void* data, size_t index);
+typedef uint64_t (*PreviewDigest)(const void* data, size_t number_of_elements);
+
+struct MatrixPreview {
+    int64_t** matrix;
+    uint32_t dimension;
+} typedef MatrixPreview;
+
+uint64_t update_preview_digest(uint64_t digest, const void* data, size_t size)
 {
+    const uint8_t* bytes = (const uint8_t*)data;
     size_t i = 0;
-    char* buffer = NULL;
-    size_t partly_offset_temp = 0;
-    if (!data || !prefix)
+
+    for (i = 0; i < size; ++i)
     {
-        log_error("[!] Invalid argument in print_uint8_vector: %s", !data ? "data is NULL" : "prefix is NULL");
-        goto cleanup;
+        digest = (digest ^ bytes[i]) * PREVIEW_DIGEST_PRIME;
     }
+    return digest;
+}
 
-    log_debug("Printing uint8 vector: size=%zu bytes", size);
+static int format_uint8_element(char* buffer, size_t buffer_size, const void* data, size_t index)
+{
+    return snprintf(buffer, buffer_size, "%02x ", ((const uint8_t*)data)[index]);
+}
+
+static int format_int64_element(char* buffer, size_t buffer_size, const void* data, size_t index)
+{
+    return snprintf(buffer, buffer_size, "%02llx ", (unsigned long long)((const int64_t*)data)[index]);
+}
+
+static int format_matrix_element(char* buffer, size_t buffer_size, const void* data, size_t index)
+{
+    const MatrixPreview* preview = (const MatrixPreview*)data;
+    return snprintf(buffer, buffer_size, "%6lld ", (long long)preview->matrix[index / preview->dimension][index % preview->dimension]);
+}
+
+static uint64_t digest_uint8_vector(const void* data, size_t number_of_elements)
+{
+    return update_preview_digest(PREVIEW_DIGEST_OFFSET_BASIS, data, number_of_elements * sizeof(uint8_t));
+}
+
+static uint64_t digest_int64_vector(const void* data, size_t number_of_elements)
+{
+    return update_preview_digest(PREVIEW_DIGEST_OFFSET_BASIS, data, number_of_elements * sizeof(int64_t));
+}
+
+static uint64_t digest_matrix(const void* data, size_t number_of_elements)
+{
+    const MatrixPreview* preview = (const MatrixPreview*)data;
+    uint64_t digest = PREVIEW_DIGEST_OFFSET_BASIS;
+    uint32_t row = 0;
+    (void)number_of_elements;
+
+    for (row = 0; row < preview->dimension; ++row)
+    {
+        digest = update_preview_digest(digest, preview->matrix[row], preview->dimension * sizeof(int64_t));
+    }
+    return digest;
+}
+
+static bool append_to_preview(size_t buffer_size, size_t* offset, int written)
+{
+    if ((written < 0) || ((size_t)written >= (buffer_size - *offset)))
+    {
+        log_error("[!] Buffer overflow detected while formatting preview.");
+        return false;
+    }
+    *offset += (size_t)written;
+    return true;
+}
+
+static bool append_preview_elements(char* buffer, size_t buffer_size, size_t* offset, const void* data, size_t first, size_t last,
+                                    size_t elements_per_line, PreviewElementFormatter formatter)
+{
+    size_t i = 0;
+
+    for (i = first; i < last; ++i)
+    {
+        if (!append_to_preview(buffer_size, offset, formatter(buffer + *offset, buffer_size - *offset, data, i)))
+        {
+            return false;
+        }
+        if ((i + 1) % elements_per_line == 0) // Line break every amount of elements
+        {
+            if (!append_to_preview(buffer_size, offset, snprintf(buffer + *offset, buffer_size - *offset, "\n")))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
 
-    size_t buffer_size = size * UINT8_HEX_CHARS_PER_ELEMENT + PRINT_BUFFER_EXTRA;
+/**
+ * @brief Formats the prefix and either every element, or the first and last halves of the preview element budget
+ *        followed by the number of elements and the digest of the whole buffer.
+ *        Only the shown elements are formatted and the buffer is sized for them, never for the whole input.
+ *
+ * @param prefix Prefix string placed on the first line
+ * @param data The buffer passed to the formatter and digest
+ * @param number_of_elements Number of elements in the buffer
+ * @param elements_per_line Number of elements before each line break
+ * @param characters_per_element Upper bound on the characters the formatter writes for one element
+ * @param formatter Formats a single element
+ * @param digest Digests the whole buffer, only called when the buffer exceeds the budget
+ * @return The formatted preview, owned by the caller, or NULL on failure
+ */
+static char* format_elements_preview(const char* prefix, const void* data, size_t number_of_elements, size_t elements_per_line,
+                                     size_t characters_per_element, PreviewElementFormatter formatter, PreviewDigest digest)
+{
+    char* buffer = NULL;
+    size_t budget = get_preview_element_budget();
+    size_t head_end = number_of_elements, tail_start = number_of_elements;
+    size_t buffer_size = 0, offset = 0;
+    bool is_truncated = number_of_elements > budget;
+
+    if (is_truncated)
+    {
+        head_end = budget / 2;
+        tail_start = number_of_elements - (budget - head_end);
+    }
+
+    buffer_size = strlen(prefix) + ((head_end + (number_of_elements - tail_start)) * (characters_per_element + 1)) + PRINT_BUFFER_EXTRA;
     buffer = (char*)malloc(buffer_size);
     if (!buffer)
     {
@@ -21,75 +130,92 @@ void print_uint8_vector(const uint8_t* data, size_t size, const char* prefix, bo
         goto cleanup;
     }
 
-    size_t offset = 0;
-    partly_offset_temp = snprintf(buffer + offset, buffer_size - offset, "%s\n", prefix);
-    if ((partly_offset_temp < 0) || (partly_offset_temp >= (buffer_size - offset)))
+    if (!append_to_preview(buffer_size, &offset, snprintf(buffer, buffer_size, "%s\n", prefix)) ||
+        !append_preview_elements(buffer, buffer_size, &offset, data, 0, head_end, elements_per_line, formatter))
     {
-        log_error("[!] Buffer overflow detected while printing uint8 vector.");
-        goto cleanup;
+        goto error;
     }
-    offset += partly_offset_temp;
-    for (i = 0; i < size && offset < buffer_size - UINT8_HEX_CHARS_PER_ELEMENT; ++i)
+
+    if (is_truncated)
     {
-        offset += snprintf(buffer + offset, buffer_size - offset, "%02x ", data[i]);
-        if ((i + 1) % BYTES_LINE_SIZE == 0) // Line break every amount of bytes
+        if (!append_to_preview(buffer_size, &offset, snprintf(buffer + offset, buffer_size - offset, "%s... %zu elements omitted ...\n",
+                                                                      (0 == head_end % elements_per_line) ? "" : "\n", tail_start - head_end)) ||
+            !append_preview_elements(buffer, buffer_size, &offset, data, tail_start, number_of_elements, elements_per_line, formatter) ||
+            !append_to_preview(buffer_size, &offset, snprintf(buffer + offset, buffer_size - offset, "%s[%zu elements, fnv1a64 %016llx]",
+                                                                      (0 == number_of_elements % elements_per_line) ? "" : "\n", number_of_elements, (unsigned long long)digest(data, number_of_elements))))
         {
-            offset += snprintf(buffer + offset, buffer_size - offset, "\n");
+            goto error;
         }
     }
     snprintf(buffer + offset, buffer_size - offset, "\n");
+    goto cleanup;
 
-    if (is_verbose_mode())
-    {
-        printf("%s", buffer);
-    }
-cleanup:
+error:
     free(buffer);
+    buffer = NULL;
+cleanup:
+    return buffer;
 }
 
-void print_int64_vector(const int64_t* data, size_t size, const char* prefix, bool is_verbose_only)
+char* format_uint8_vector_preview(const uint8_t* data, size_t size, const char* prefix)
 {
-    size_t i = 0;
-    char* buffer = NULL;
-    size_t partly_offset_temp = 0;
     if (!data || !prefix)
     {
-        log_error("[!] Invalid argument in print_int64_vector: %s", !data ? "data is NULL" : "prefix is NULL");
-        goto cleanup;
+        log_error("[!] Invalid argument in format_uint8_vector_preview: %s", !data ? "data is NULL" : "prefix is NULL");
+        return NULL;
     }
 
-    log_debug("Printing int64 vector: size=%zu elements", size);
+    return format_elements_preview(prefix, data, size, BYTES_LINE_SIZE, UINT8_HEX_CHARS_PER_ELEMENT, format_uint8_element, digest_uint8_vector);
+}
 
-    size_t buffer_size = size * INT64_HEX_CHARS_PER_ELEMENT + PRINT_BUFFER_EXTRA;
-    buffer = (char*)malloc(buffer_size);
-    if (!buffer)
+char* format_int64_vector_preview(const int64_t* data, size_t size, const char* prefix)
+{
+    if (!data || !prefix)
     {
-        log_error("[!] Memory allocation failed for print buffer (size: %zu)", buffer_size);
-        goto cleanup;
+        log_error("[!] Invalid argument in format_int64_vector_preview: %s", !data ? "data is NULL" : "prefix is NULL");
+        return NULL;
     }
 
-    size_t offset = 0;
-    partly_offset_temp = snprintf(buffer + offset, buffer_size - offset, "%s\n", prefix);
-    if ((partly_offset_temp < 0) || (partly_offset_temp >= (buffer_size - offset)))
+    return format_elements_preview(prefix, data, size, NUMBERS_LINE_SIZE, INT64_HEX_CHARS_PER_ELEMENT, format_int64_element, digest_int64_vector);
+}
+
+char* format_matrix_preview(int64_t** matrix, uint32_t dimension, const char* prefix)
+{
+    MatrixPreview preview = {matrix, dimension};
+    uint32_t row = 0;
+
+    if (!matrix || !prefix || (0 == dimension))
     {
-        log_error("[!] Buffer overflow detected while printing int64 vector.");
-        goto cleanup;
+        log_error("[!] Invalid argument in format_matrix_preview");
+        return NULL;
     }
-    offset += partly_offset_temp;
-    for (i = 0; i < size && offset < buffer_size - INT64_HEX_CHARS_PER_ELEMENT; ++i)
+
+    for (row = 0; row < dimension; ++row)
     {
-        if (data[i] > 0)
-        {
-            partly_offset_temp = snprintf(buffer + offset, buffer_size - offset, "%02llx ", (long long)data[i]);
-        }
-        if ((i + 1) % NUMBERS_LINE_SIZE == 0) // Line break every 8 numbers
+        if (!matrix[row])
         {
-            partly_offset_temp = snprintf(buffer + offset, buffer_size - offset, "\n");
+            log_error("[!] Invalid matrix: row %u is NULL", row);
+            return NULL;
         }
     }
-    snprintf(buffer + offset, buffer_size - offset, "\n");
 
-    if (is_verbose_mode())
+    return format_elements_preview(prefix, &preview, (size_t)dimension * dimension, dimension, MATRIX_HEX_CHARS_PER_ELEMENT, format_matrix_element, digest_matrix);
+}
+
+void print_uint8_vector(const uint8_t* data, size_t size, const char* prefix, bool is_verbose_only)
+{
+    char* buffer = NULL;
+
+    // Nothing reaches the console outside verbose mode, skip the formatting too
+    if (!is_verbose_mode())
+    {
+        goto cleanup;
+    }
+
+    log_debug("Printing uint8 vector: size=%zu bytes", size);
+
+    buffer = format_uint8_vector_preview(data, size, prefix);
+    if (buffer)
     {
         printf("%s", buffer);
     }
@@ -97,62 +223,39 @@ cleanup:
     free(buffer);
 }
 
-void print_matrix(int64_t** matrix, uint32_t dimension, const char* prefix, bool is_verbose_only)
+void print_int64_vector(const int64_t* data, size_t size, const char* prefix, bool is_verbose_only)
 {
     char* buffer = NULL;
-    size_t partly_offset_temp = 0;
-    if (!matrix)
+
+    if (!is_verbose_mode())
     {
-        log_error("[!] Invalid argument: matrix is NULL");
         goto cleanup;
     }
 
-    log_debug("Printing matrix: dimension=%u", dimension);
+    log_debug("Printing int64 vector: size=%zu elements", size);
 
-    size_t buffer_size = dimension * dimension * MATRIX_HEX_CHARS_PER_ELEMENT + PRINT_BUFFER_EXTRA;
-    buffer = (char*)malloc(buffer_size);
-    if (!buffer)
+    buffer = format_int64_vector_preview(data, size, prefix);
+    if (buffer)
     {
-        log_error("[!] Memory allocation failed for print buffer (size: %zu)", buffer_size);
-        goto cleanup;
+        printf("%s", buffer);
     }
+cleanup:
+    free(buffer);
+}
+
+void print_matrix(int64_t** matrix, uint32_t dimension, const char* prefix, bool is_verbose_only)
+{
+    char* buffer = NULL;
 
-    size_t offset = 0;
-    partly_offset_temp = snprintf(buffer + offset, buffer_size - offset, "%s\n", prefix);
-    if ((partly_offset_temp < 0) || (partly_offset_temp >= (buffer_size - offset)))
+    if (!is_verbose_mode() && is_verbose_only)
     {
-        log_error("[!] Buffer overflow detected while printing matrix.");
         goto cleanup;
     }
-    offset += partly_offset_temp;
-    for (size_t row = 0; row < dimension; ++row)
-    {
-        if (!matrix[row])
-        {
-            log_error("[!] Invalid matrix: row %zu is NULL", row);
-            goto cleanup;
-        }
 
-        for (size_t column = 0; column < dimension; ++column)
-        {
-            partly_offset_temp = snprintf(buffer + offset, buffer_size - offset, "%I64d ", matrix[row][column]);
-            if ((partly_offset_temp < 0) || (partly_offset_temp >= (buffer_size - offset)))
-            {
-                log_error("[!] Buffer overflow detected while printing matrix at row %zu.", row);
-                goto cleanup;
-            }
-            offset += partly_offset_temp;
-        }
-        partly_offset_temp = snprintf(buffer + offset, buffer_size - offset, "\n");
-        if ((partly_offset_temp < 0) || (partly_offset_temp >= (buffer_size - offset)))
-        {
-            log_error("[!] Buffer overflow detected while printing matrix at row %zu.", row);
-            goto cleanup;
-        }
-        offset += partly_offset_temp;
-    }
+    log_debug("Printing matrix: dimension=%u", dimension);
 
-    if (is_verbose_mode() || !is_verbose_only)
+    buffer = format_matrix_preview(matrix, dimension, prefix);
+    if (buffer)
     {
         printf("%s", buffer);
     }
@@ -1,4 +1,6 @@
 #include "IO/SerDes.h"
+#include "Secrets/SeededSecrets.h"
+#include "Secrets/MappedSecrets.h"
 
 uint32_t calculate_bytes_per_element(uint32_t prime_field)
 {
@@ -12,13 +14,10 @@ uint32_t calculate_bytes_per_element(uint32_t prime_field)
     }
 
     log_debug("Calculating bytes needed for elements in GF(%u)", prime_field);
+    // Bit length of the largest element, prime_field - 1
     while (value)
     {
         value >>= 1;
-        if (value == 1)
-        {
-            continue;
-        }
         bits++;
     }
     uint32_t bytes = (bits + BYTE_SIZE - 1) / BYTE_SIZE;
@@ -26,6 +25,20 @@ uint32_t calculate_bytes_per_element(uint32_t prime_field)
     return bytes;
 }
 
+// Headerless keys were written with one bit less than the largest element takes, fields where that cost a byte can't be read
+static bool is_legacy_element_width_unchanged(uint32_t prime_field)
+{
+    uint32_t bits = 0;
+    uint32_t value = prime_field - 1;
+
+    while (value)
+    {
+        value >>= 1;
+        bits++;
+    }
+    return (bits < 2) || (1 != (bits % BYTE_SIZE));
+}
+
 uint32_t calculate_digits_per_element(uint32_t prime_field)
 {
     if (prime_field == 0)
@@ -53,21 +66,40 @@ STATUS_CODE serialize_secrets(uint8_t** out_data, uint32_t* out_size, Secrets se
     uint32_t permutation_vector_size = 0;
     uint8_t* buffer = NULL;
     uint32_t buffer_size = 0;
+    uint32_t serialized_dimension = 0;
+    uint32_t format_header[FULL_KEY_HEADER_SIZE / sizeof(uint32_t)];
     size_t offset = 0;
+    bool is_circulant = (KEY_STRUCTURE_CIRCULANT == secrets.key_structure);
+
+    // Keys derived from a seed are stored as the seed, they are regenerated on load
+    if (NULL != secrets.key_seed)
+    {
+        return_code = serialize_seeded_secrets(out_data, out_size, secrets);
+        goto cleanup;
+    }
 
-    if (!out_data || !out_size || !secrets.key_matrix || !secrets.error_vectors ||
+    // Mapped keys have no jagged members, they keep their format
+    if (NULL != secrets.flat_key_matrix.elements)
+    {
+        return_code = serialize_mapped_secrets(out_data, out_size, secrets);
+        goto cleanup;
+    }
+
+    if (!out_data || !out_size || (is_circulant ? !secrets.circulant_column : !secrets.key_matrix) || !secrets.error_vectors ||
         !secrets.ascii_mapping || !secrets.permutation_vector || (0 == secrets.dimension) ||
-        (secrets.dimension > (UINT32_MAX / digits_per_element)) ||
+        (0 != (secrets.dimension & CIRCULANT_KEY_FLAG)) || (secrets.dimension > (UINT32_MAX / digits_per_element)) ||
         secrets.number_of_error_vectors == 0)
     {
         log_error("[!] Invalid arguments in serialize_secrets: %s",
             !out_data ? "out_data is NULL" :
             !out_size ? "out_size is NULL" :
-            !secrets.key_matrix ? "key_matrix is NULL" :
+            is_circulant && !secrets.circulant_column ? "circulant_column is NULL" :
+            !is_circulant && !secrets.key_matrix ? "key_matrix is NULL" :
             !secrets.error_vectors ? "error_vectors is NULL" :
             !secrets.ascii_mapping ? "ascii_mapping is NULL" :
             !secrets.permutation_vector ? "permutation_vector is NULL" :
             secrets.dimension == 0 ? "dimension is 0" :
+            0 != (secrets.dimension & CIRCULANT_KEY_FLAG) ? "dimension is too large" :
             secrets.dimension > (UINT32_MAX / digits_per_element) ? "dimension overflow" :
             "number_of_error_vectors is 0");
         return_code = STATUS_CODE_INVALID_ARGUMENT;
@@ -77,12 +109,21 @@ STATUS_CODE serialize_secrets(uint8_t** out_data, uint32_t* out_size, Secrets se
     log_debug("Starting secrets serialization: dimension=%u, prime_field=%u",
               secrets.dimension, secrets.prime_field);
 
-    return_code = serialize_square_matrix(&key_matrix_data, &key_matrix_size, secrets.key_matrix, secrets.dimension, secrets.prime_field);
+    if (is_circulant)
+    {
+        return_code = serialize_vector(&key_matrix_data, &key_matrix_size, secrets.circulant_column, secrets.dimension, secrets.prime_field);
+        serialized_dimension = secrets.dimension | CIRCULANT_KEY_FLAG;
+    }
+    else
+    {
+        return_code = serialize_square_matrix(&key_matrix_data, &key_matrix_size, secrets.key_matrix, secrets.dimension, secrets.prime_field);
+        serialized_dimension = secrets.dimension;
+    }
     if (STATUS_FAILED(return_code))
     {
         goto cleanup;
     }
-    log_debug("Serialized key matrix: size=%u", key_matrix_size);
+    log_debug("Serialized %s key: size=%u", is_circulant ? "circulant" : "dense", key_matrix_size);
 
     return_code = serialize_matrix(&error_vectors_data, &error_vectors_size, secrets.error_vectors, secrets.number_of_error_vectors, secrets.dimension, secrets.prime_field);
     if (STATUS_FAILED(return_code))
@@ -98,26 +139,30 @@ STATUS_CODE serialize_secrets(uint8_t** out_data, uint32_t* out_size, Secrets se
     }
     log_debug("Serialized ASCII mapping: size=%u", ascii_mapping_size);
 
+    // The section keeps its historical size of digits * dimension bytes, only the first digits bytes hold the permutation
     permutation_vector_size = digits_per_element * secrets.dimension;
-    permutation_vector_data = (uint8_t*)malloc(permutation_vector_size);
+    permutation_vector_data = (uint8_t*)calloc(permutation_vector_size, sizeof(uint8_t));
     if (!permutation_vector_data)
     {
         log_error("[!] Memory allocation failed for permutation vector.");
         return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
         goto cleanup;
     }
-    memcpy(permutation_vector_data, secrets.permutation_vector, permutation_vector_size);
+    memcpy(permutation_vector_data, secrets.permutation_vector, digits_per_element);
     log_debug("Copied permutation vector: size=%u", permutation_vector_size);
 
-    if (permutation_vector_size > (UINT32_MAX - key_matrix_size - error_vectors_size - ascii_mapping_size - (sizeof(uint32_t) * NUMBER_OF_UINT32_SECRETS)))
+    if (permutation_vector_size > (UINT32_MAX - FULL_KEY_HEADER_SIZE - key_matrix_size - error_vectors_size - ascii_mapping_size -
+                                   (sizeof(uint32_t) * NUMBER_OF_UINT32_SECRETS)))
     {
         log_error("[!] Buffer size overflow in serialize_secrets.");
         return_code = STATUS_CODE_ERROR_INVALID_SIZE;
         goto cleanup;
     }
 
-    buffer_size = key_matrix_size + error_vectors_size + ascii_mapping_size + permutation_vector_size + (sizeof(uint32_t) * NUMBER_OF_UINT32_SECRETS);
-    buffer = (uint8_t*)malloc(buffer_size);
+    buffer_size = FULL_KEY_HEADER_SIZE + key_matrix_size + error_vectors_size + ascii_mapping_size + permutation_vector_size +
+                  (sizeof(uint32_t) * NUMBER_OF_UINT32_SECRETS);
+    // Zeroed since the header keeps room for NUMBER_OF_UINT32_SECRETS words while fewer are written
+    buffer = (uint8_t*)calloc(buffer_size, sizeof(uint8_t));
     if (!buffer)
     {
         log_error("[!] Memory allocation failed in serialize_secrets.");
@@ -126,14 +171,19 @@ STATUS_CODE serialize_secrets(uint8_t** out_data, uint32_t* out_size, Secrets se
     }
     log_debug("Allocated buffer for serialization: size=%u", buffer_size);
 
+    format_header[0] = FULL_KEY_MAGIC;
+    format_header[1] = FULL_KEY_VERSION;
+    memcpy(buffer + offset, format_header, FULL_KEY_HEADER_SIZE);
+    offset += FULL_KEY_HEADER_SIZE;
+
     if (offset + sizeof(uint32_t) > buffer_size)
     {
         return_code = STATUS_CODE_ERROR_INVALID_SIZE;
         goto cleanup;
     }
-    memcpy(buffer + offset, &secrets.dimension, sizeof(uint32_t));
+    memcpy(buffer + offset, &serialized_dimension, sizeof(uint32_t));
     offset += sizeof(uint32_t);
-    log_debug("Wrote dimension to buffer: %u", secrets.dimension);
+    log_debug("Wrote dimension to buffer: %u%s", secrets.dimension, is_circulant ? " (circulant)" : "");
 
     if (offset + sizeof(uint32_t) > buffer_size)
     {
@@ -221,11 +271,26 @@ STATUS_CODE deserialize_secrets(Secrets* out_secrets, uint8_t* data, uint32_t si
     uint32_t dimension = 0, number_of_error_vectors = 0, prime_field = 0;
     uint32_t number_of_letters_for_each_digit_ascii_mapping = 0;
     uint32_t bytes_per_element = 0, digits_per_element = 0;
+    uint32_t key_section_size = 0, circulant_column_size = 0;
+    uint32_t format_header[FULL_KEY_HEADER_SIZE / sizeof(uint32_t)];
+    bool is_circulant = false, is_headerless = false;
     int64_t** key_matrix_buffer = NULL;
+    int64_t* circulant_column_buffer = NULL;
     int64_t** error_vectors_buffer = NULL;
     uint8_t** ascii_mapping_buffer = NULL;
     uint8_t* permutation_vector_buffer = NULL;
 
+    if (is_seeded_key_data(data, size))
+    {
+        return_code = deserialize_seeded_secrets(out_secrets, data, size);
+        goto cleanup;
+    }
+    if (is_mapped_key_data(data, size))
+    {
+        return_code = deserialize_mapped_secrets(out_secrets, data, size);
+        goto cleanup;
+    }
+
     if (!out_secrets || !data || size < sizeof(uint32_t) * NUMBER_OF_UINT32_SECRETS)
     {
         log_error("[!] Invalid argument in deserialize_secrets.");
@@ -233,6 +298,22 @@ STATUS_CODE deserialize_secrets(Secrets* out_secrets, uint8_t* data, uint32_t si
         goto cleanup;
     }
 
+    memcpy(format_header, data, FULL_KEY_HEADER_SIZE);
+    if (FULL_KEY_MAGIC == format_header[0])
+    {
+        if (FULL_KEY_VERSION != format_header[1])
+        {
+            log_error("[!] Unsupported key format version %u, this build reads version %u.", format_header[1], FULL_KEY_VERSION);
+            return_code = STATUS_CODE_UNSUPPORTED_KEY_FORMAT;
+            goto cleanup;
+        }
+        offset += FULL_KEY_HEADER_SIZE;
+    }
+    else
+    {
+        is_headerless = true;
+    }
+
     if (offset + sizeof(uint32_t) > size)
     {
         return_code = STATUS_CODE_ERROR_INVALID_SIZE;
@@ -240,6 +321,8 @@ STATUS_CODE deserialize_secrets(Secrets* out_secrets, uint8_t* data, uint32_t si
     }
     memcpy(&dimension, data + offset, sizeof(uint32_t));
     offset += sizeof(uint32_t);
+    is_circulant = (0 != (dimension & CIRCULANT_KEY_FLAG));
+    dimension &= ~CIRCULANT_KEY_FLAG;
 
     if (offset + sizeof(uint32_t) > size)
     {
@@ -265,6 +348,14 @@ STATUS_CODE deserialize_secrets(Secrets* out_secrets, uint8_t* data, uint32_t si
     memcpy(&number_of_letters_for_each_digit_ascii_mapping, data + offset, sizeof(uint32_t));
     offset += sizeof(uint32_t);
 
+    if (is_headerless && (0 != prime_field) && !is_legacy_element_width_unchanged(prime_field))
+    {
+        log_error("[!] Key file has no format header and stores GF(%u) elements one byte narrower than this build reads, "
+                  "regenerate the key and re-encrypt its ciphertexts.", prime_field);
+        return_code = STATUS_CODE_UNSUPPORTED_KEY_FORMAT;
+        goto cleanup;
+    }
+
     bytes_per_element = calculate_bytes_per_element(prime_field);
     digits_per_element = calculate_digits_per_element(prime_field);
 
@@ -282,7 +373,8 @@ STATUS_CODE deserialize_secrets(Secrets* out_secrets, uint8_t* data, uint32_t si
         goto cleanup;
     }
 
-    if (size < offset + (dimension * dimension * bytes_per_element) +
+    key_section_size = is_circulant ? (dimension * bytes_per_element) : (dimension * dimension * bytes_per_element);
+    if (size < offset + key_section_size +
             (number_of_error_vectors * dimension * bytes_per_element) +
             (NUMBER_OF_DIGITS * number_of_letters_for_each_digit_ascii_mapping * bytes_per_element) +
             (digits_per_element * dimension))
@@ -292,13 +384,20 @@ STATUS_CODE deserialize_secrets(Secrets* out_secrets, uint8_t* data, uint32_t si
         goto cleanup;
     }
 
-    return_code = deserialize_square_matrix(&key_matrix_buffer, dimension, data + offset, dimension * dimension * bytes_per_element, prime_field);
+    if (is_circulant)
+    {
+        return_code = deserialize_vector(&circulant_column_buffer, &circulant_column_size, data + offset, key_section_size, prime_field);
+    }
+    else
+    {
+        return_code = deserialize_square_matrix(&key_matrix_buffer, dimension, data + offset, key_section_size, prime_field);
+    }
     if (STATUS_FAILED(return_code))
     {
         goto cleanup;
     }
-    offset += dimension * dimension * bytes_per_element;
-    log_debug("Deserialized key matrix: dimension=%u", dimension);
+    offset += key_section_size;
+    log_debug("Deserialized %s key: dimension=%u", is_circulant ? "circulant" : "dense", dimension);
 
     return_code = deserialize_matrix(&error_vectors_buffer, number_of_error_vectors, dimension, data + offset, number_of_error_vectors * dimension * bytes_per_element, prime_field);
     if (STATUS_FAILED(return_code))
@@ -337,8 +436,11 @@ STATUS_CODE deserialize_secrets(Secrets* out_secrets, uint8_t* data, uint32_t si
     secrets.number_of_error_vectors = number_of_error_vectors;
     secrets.prime_field = prime_field;
     secrets.number_of_letters_for_each_digit_ascii_mapping = number_of_letters_for_each_digit_ascii_mapping;
+    secrets.key_structure = is_circulant ? KEY_STRUCTURE_CIRCULANT : KEY_STRUCTURE_DENSE;
     secrets.key_matrix = key_matrix_buffer;
     key_matrix_buffer = NULL;
+    secrets.circulant_column = circulant_column_buffer;
+    circulant_column_buffer = NULL;
     secrets.error_vectors = error_vectors_buffer;
     error_vectors_buffer = NULL;
     secrets.ascii_mapping = ascii_mapping_buffer;
@@ -347,10 +449,14 @@ STATUS_CODE deserialize_secrets(Secrets* out_secrets, uint8_t* data, uint32_t si
     permutation_vector_buffer = NULL;
 
     *out_secrets = secrets;
+    increase_metric_counter(METRIC_COUNTER_KEYS_LOADED, 1);
+    set_metric_gauge(METRIC_GAUGE_KEY_DIMENSION, secrets.dimension);
+    set_metric_gauge(METRIC_GAUGE_PRIME_FIELD, secrets.prime_field);
     return_code = STATUS_CODE_SUCCESS;
     log_debug("Secrets deserialization completed successfully");
 cleanup:
     (void)free_int64_matrix(key_matrix_buffer, secrets.dimension);
+    free(circulant_column_buffer);
     (void)free_int64_matrix(error_vectors_buffer, secrets.number_of_error_vectors);
     (void)free_uint8_matrix(ascii_mapping_buffer, 10);
     free(permutation_vector_buffer);
@@ -735,3 +841,62 @@ cleanup:
 
     return return_code;
 }
+
+STATUS_CODE serialize_field_vector(uint8_t* out_data, const FieldVector* vector, uint32_t bytes_per_element)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    size_t element_index = 0, byte_index = 0;
+    uint32_t value = 0;
+
+    if (!out_data || !vector || !vector->elements || (0 == bytes_per_element) || (bytes_per_element > sizeof(uint32_t)))
+    {
+        log_error("[!] Invalid argument in serialize_field_vector.");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    for (element_index = 0; element_index < vector->length; ++element_index)
+    {
+        value = get_field_vector_element(vector, element_index);
+        for (byte_index = bytes_per_element; byte_index > 0; --byte_index)
+        {
+            out_data[byte_index - 1] = (uint8_t)(value & BYTE_MASK);
+            value >>= BYTE_SIZE;
+        }
+        out_data += bytes_per_element;
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE deserialize_field_vector(FieldVector* out_vector, const uint8_t* data, uint32_t bytes_per_element, uint32_t prime_field)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    size_t element_index = 0, byte_index = 0;
+    uint32_t value = 0;
+
+    if (!out_vector || !out_vector->elements || !data || (0 == bytes_per_element) ||
+        (bytes_per_element > sizeof(uint32_t)) || (0 == prime_field))
+    {
+        log_error("[!] Invalid argument in deserialize_field_vector.");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    for (element_index = 0; element_index < out_vector->length; ++element_index)
+    {
+        value = 0;
+        for (byte_index = 0; byte_index < bytes_per_element; ++byte_index)
+        {
+            value = (value << BYTE_SIZE) | data[byte_index];
+        }
+        set_field_vector_element(out_vector, element_index, value % prime_field);
+        data += bytes_per_element;
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
@@ -2,6 +2,12 @@
 
 bool g_verbose_mode = false;
 
+// log.c writes every level to the console until told otherwise
+static int g_console_log_level = LOG_TRACE;
+static int g_log_file_level = LOG_LEVEL_DISABLED;
+static size_t g_preview_element_budget = DEFAULT_PREVIEW_ELEMENT_BUDGET;
+static FILE* g_status_output = NULL;
+
 void set_verbose_mode(bool verbose)
 {
     g_verbose_mode = verbose;
@@ -11,3 +17,39 @@ bool is_verbose_mode()
 {
     return g_verbose_mode;
 }
+
+void set_console_log_level(int level)
+{
+    g_console_log_level = level;
+    log_set_level(level);
+}
+
+void set_log_file_level(int level)
+{
+    g_log_file_level = level;
+}
+
+bool is_log_level_enabled(int level)
+{
+    return (level >= g_console_log_level) || (level >= g_log_file_level);
+}
+
+void set_preview_element_budget(size_t budget)
+{
+    g_preview_element_budget = (0 == budget) ? DEFAULT_PREVIEW_ELEMENT_BUDGET : budget;
+}
+
+size_t get_preview_element_budget()
+{
+    return g_preview_element_budget;
+}
+
+void set_status_output(FILE* output)
+{
+    g_status_output = output;
+}
+
+FILE* get_status_output()
+{
+    return (NULL == g_status_output) ? stdout : g_status_output;
+}
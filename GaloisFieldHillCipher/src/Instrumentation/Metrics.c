@@ -0,0 +1,215 @@
+#include "Instrumentation/Metrics.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+struct MetricDescription {
+    const char* name;
+    const char* help;
+} typedef MetricDescription;
+
+static uint64_t g_metric_counters[NUMBER_OF_METRIC_COUNTERS];
+static double g_metric_gauges[NUMBER_OF_METRIC_GAUGES];
+static LatencyHistogram g_stage_latency_histograms[NUMBER_OF_PIPELINE_STAGES];
+
+static const MetricDescription g_counter_descriptions[NUMBER_OF_METRIC_COUNTERS] = {
+    {"blocks_encrypted_total", "Number of plaintext blocks encrypted."},
+    {"blocks_decrypted_total", "Number of ciphertext blocks decrypted."},
+    {"blocks_rekeyed_total", "Number of ciphertext blocks moved to another key."},
+    {"bytes_in_total", "Number of plaintext or ciphertext bytes read for encryption and decryption."},
+    {"bytes_out_total", "Number of ciphertext or plaintext bytes written by encryption and decryption."},
+    {"allocations_total", "Number of buffer allocations made by the cipher pipeline."},
+    {"rng_bytes_drawn_total", "Number of bytes drawn from the CSPRNG."},
+    {"keys_loaded_total", "Number of key files deserialized."}
+};
+
+static const MetricDescription g_gauge_descriptions[NUMBER_OF_METRIC_GAUGES] = {
+    {"key_dimension", "Dimension of the last loaded key."},
+    {"prime_field", "Prime field of the last loaded key."},
+    {"run_duration_seconds", "Wall time of the run."}
+};
+
+// Upper bounds of the latency buckets, the +Inf bucket is the histogram count
+static const uint64_t g_latency_bucket_bounds_ns[NUMBER_OF_LATENCY_BUCKETS] = {
+    1000ULL, 4000ULL, 16000ULL, 64000ULL, 256000ULL, 1000000ULL,
+    4000000ULL, 16000000ULL, 64000000ULL, 256000000ULL, 1000000000ULL, 4000000000ULL
+};
+
+void add_to_shared_counter(uint64_t* counter, uint64_t value)
+{
+#ifdef _WIN32
+    (void)InterlockedExchangeAdd64((volatile LONG64*)counter, (LONG64)value);
+#else
+    (void)__atomic_fetch_add(counter, value, __ATOMIC_RELAXED);
+#endif
+}
+
+void increase_metric_counter(METRIC_COUNTER counter, uint64_t value)
+{
+    if (counter < NUMBER_OF_METRIC_COUNTERS)
+    {
+        // Keys are loaded and files are processed by the worker threads of a batch, counters are shared
+        add_to_shared_counter(&g_metric_counters[counter], value);
+    }
+}
+
+void set_metric_gauge(METRIC_GAUGE gauge, double value)
+{
+    if (gauge < NUMBER_OF_METRIC_GAUGES)
+    {
+        g_metric_gauges[gauge] = value;
+    }
+}
+
+void observe_stage_latency(PIPELINE_STAGE stage, uint64_t latency_ns)
+{
+    LatencyHistogram* histogram = NULL;
+    size_t bucket = 0;
+
+    if (stage >= NUMBER_OF_PIPELINE_STAGES)
+    {
+        return;
+    }
+    histogram = &g_stage_latency_histograms[stage];
+
+    for (bucket = 0; bucket < NUMBER_OF_LATENCY_BUCKETS; ++bucket)
+    {
+        if (latency_ns <= g_latency_bucket_bounds_ns[bucket])
+        {
+            add_to_shared_counter(&histogram->bucket_counts[bucket], 1);
+            break;
+        }
+    }
+    add_to_shared_counter(&histogram->count, 1);
+    add_to_shared_counter(&histogram->sum_ns, latency_ns);
+}
+
+uint64_t get_metric_counter(METRIC_COUNTER counter)
+{
+    return (counter < NUMBER_OF_METRIC_COUNTERS) ? g_metric_counters[counter] : 0;
+}
+
+const LatencyHistogram* get_stage_latency_histogram(PIPELINE_STAGE stage)
+{
+    return (stage < NUMBER_OF_PIPELINE_STAGES) ? &g_stage_latency_histograms[stage] : NULL;
+}
+
+void reset_metrics(void)
+{
+    memset(g_metric_counters, 0, sizeof(g_metric_counters));
+    memset(g_metric_gauges, 0, sizeof(g_metric_gauges));
+    memset(g_stage_latency_histograms, 0, sizeof(g_stage_latency_histograms));
+}
+
+STATUS_CODE write_metrics_prometheus(FILE* output)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    const LatencyHistogram* histogram = NULL;
+    uint64_t cumulative_count = 0;
+    size_t metric = 0, stage = 0, bucket = 0;
+
+    if (NULL == output)
+    {
+        log_error("[!] Invalid arguments in write_metrics_prometheus");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    for (metric = 0; metric < NUMBER_OF_METRIC_COUNTERS; ++metric)
+    {
+        fprintf(output, "# HELP " METRICS_NAME_PREFIX "%s %s\n", g_counter_descriptions[metric].name, g_counter_descriptions[metric].help);
+        fprintf(output, "# TYPE " METRICS_NAME_PREFIX "%s counter\n", g_counter_descriptions[metric].name);
+        fprintf(output, METRICS_NAME_PREFIX "%s %llu\n", g_counter_descriptions[metric].name, (unsigned long long)g_metric_counters[metric]);
+    }
+
+    for (metric = 0; metric < NUMBER_OF_METRIC_GAUGES; ++metric)
+    {
+        fprintf(output, "# HELP " METRICS_NAME_PREFIX "%s %s\n", g_gauge_descriptions[metric].name, g_gauge_descriptions[metric].help);
+        fprintf(output, "# TYPE " METRICS_NAME_PREFIX "%s gauge\n", g_gauge_descriptions[metric].name);
+        fprintf(output, METRICS_NAME_PREFIX "%s %.9g\n", g_gauge_descriptions[metric].name, g_metric_gauges[metric]);
+    }
+
+    fprintf(output, "# HELP " METRICS_NAME_PREFIX "stage_latency_seconds Latency of a single pipeline stage call.\n");
+    fprintf(output, "# TYPE " METRICS_NAME_PREFIX "stage_latency_seconds histogram\n");
+    for (stage = 0; stage < NUMBER_OF_PIPELINE_STAGES; ++stage)
+    {
+        histogram = &g_stage_latency_histograms[stage];
+        if (0 == histogram->count)
+        {
+            continue;
+        }
+
+        cumulative_count = 0;
+        for (bucket = 0; bucket < NUMBER_OF_LATENCY_BUCKETS; ++bucket)
+        {
+            cumulative_count += histogram->bucket_counts[bucket];
+            fprintf(output, METRICS_NAME_PREFIX "stage_latency_seconds_bucket{stage=\"%s\",le=\"%.9g\"} %llu\n",
+                    get_stage_name((PIPELINE_STAGE)stage), (double)g_latency_bucket_bounds_ns[bucket] / (double)NANOSECONDS_IN_SECOND,
+                    (unsigned long long)cumulative_count);
+        }
+        fprintf(output, METRICS_NAME_PREFIX "stage_latency_seconds_bucket{stage=\"%s\",le=\"+Inf\"} %llu\n",
+                get_stage_name((PIPELINE_STAGE)stage), (unsigned long long)histogram->count);
+        fprintf(output, METRICS_NAME_PREFIX "stage_latency_seconds_sum{stage=\"%s\"} %.9g\n",
+                get_stage_name((PIPELINE_STAGE)stage), (double)histogram->sum_ns / (double)NANOSECONDS_IN_SECOND);
+        fprintf(output, METRICS_NAME_PREFIX "stage_latency_seconds_count{stage=\"%s\"} %llu\n",
+                get_stage_name((PIPELINE_STAGE)stage), (unsigned long long)histogram->count);
+    }
+
+    return_code = (0 == ferror(output)) ? STATUS_CODE_SUCCESS : STATUS_CODE_COULDNT_WRITE_FILE;
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE dump_metrics_to_file(const char* filepath)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    char temporary_filepath[METRICS_PATH_SIZE];
+    FILE* output = NULL;
+
+    if ((NULL == filepath) || ((strlen(filepath) + sizeof(METRICS_TEMPORARY_FILE_SUFFIX)) > sizeof(temporary_filepath)))
+    {
+        log_error("[!] Invalid arguments in dump_metrics_to_file");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+    (void)snprintf(temporary_filepath, sizeof(temporary_filepath), "%s" METRICS_TEMPORARY_FILE_SUFFIX, filepath);
+
+    output = fopen(temporary_filepath, "w");
+    if (NULL == output)
+    {
+        log_error("[!] Couldn't open metrics file %s", temporary_filepath);
+        return_code = STATUS_CODE_COULDNT_OPEN_FILE;
+        goto cleanup;
+    }
+
+    return_code = write_metrics_prometheus(output);
+    if (0 != fclose(output))
+    {
+        return_code = STATUS_CODE_COULDNT_WRITE_FILE;
+    }
+    output = NULL;
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("[!] Failed to write metrics to %s", temporary_filepath);
+        goto cleanup;
+    }
+
+#ifdef _WIN32
+    (void)remove(filepath); // rename does not replace an existing file on Windows
+#endif
+    if (0 != rename(temporary_filepath, filepath))
+    {
+        log_error("[!] Couldn't move metrics file into place: %s", filepath);
+        return_code = STATUS_CODE_COULDNT_WRITE_FILE;
+        goto cleanup;
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    if (NULL != output)
+    {
+        fclose(output);
+    }
+    return return_code;
+}
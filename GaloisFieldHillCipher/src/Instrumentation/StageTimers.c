@@ -0,0 +1,123 @@
+#include "Instrumentation/StageTimers.h"
+#include "Instrumentation/Metrics.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+bool g_stage_timing_mode = false;
+
+static StageStatistics g_stage_statistics[NUMBER_OF_PIPELINE_STAGES];
+
+static const char* g_stage_names[NUMBER_OF_PIPELINE_STAGES] = {
+    "read",
+    "deserialize_secrets",
+    "random_bit_expansion",
+    "padding",
+    "block_multiply",
+    "affine",
+    "mapping_permutation",
+    "serialize",
+    "write"
+};
+
+uint64_t get_monotonic_time_ns(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((counter.QuadPart / frequency.QuadPart) * NANOSECONDS_IN_SECOND +
+                      ((counter.QuadPart % frequency.QuadPart) * NANOSECONDS_IN_SECOND) / frequency.QuadPart);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * NANOSECONDS_IN_SECOND) + (uint64_t)now.tv_nsec;
+#endif
+}
+
+void set_stage_timing_mode(bool enabled)
+{
+    g_stage_timing_mode = enabled;
+}
+
+bool is_stage_timing_mode(void)
+{
+    return g_stage_timing_mode;
+}
+
+uint64_t start_stage_timer(void)
+{
+    return g_stage_timing_mode ? get_monotonic_time_ns() : 0;
+}
+
+void stop_stage_timer(PIPELINE_STAGE stage, uint64_t start_time, uint64_t bytes_processed)
+{
+    uint64_t elapsed_ns = 0;
+
+    if (!g_stage_timing_mode || (stage >= NUMBER_OF_PIPELINE_STAGES))
+    {
+        return;
+    }
+
+    elapsed_ns = get_monotonic_time_ns() - start_time;
+    add_to_shared_counter(&g_stage_statistics[stage].calls, 1);
+    add_to_shared_counter(&g_stage_statistics[stage].elapsed_ns, elapsed_ns);
+    add_to_shared_counter(&g_stage_statistics[stage].bytes_processed, bytes_processed);
+    observe_stage_latency(stage, elapsed_ns);
+}
+
+const char* get_stage_name(PIPELINE_STAGE stage)
+{
+    return (stage < NUMBER_OF_PIPELINE_STAGES) ? g_stage_names[stage] : "unknown";
+}
+
+const StageStatistics* get_stage_statistics(PIPELINE_STAGE stage)
+{
+    return (stage < NUMBER_OF_PIPELINE_STAGES) ? &g_stage_statistics[stage] : NULL;
+}
+
+void reset_stage_statistics(void)
+{
+    memset(g_stage_statistics, 0, sizeof(g_stage_statistics));
+}
+
+void print_stage_statistics(FILE* output)
+{
+    uint64_t total_elapsed_ns = 0;
+    const StageStatistics* statistics = NULL;
+    size_t stage = 0;
+
+    if (NULL == output)
+    {
+        return;
+    }
+
+    for (stage = 0; stage < NUMBER_OF_PIPELINE_STAGES; ++stage)
+    {
+        total_elapsed_ns += g_stage_statistics[stage].elapsed_ns;
+    }
+
+    fprintf(output, "[*] Stage statistics:\n");
+    fprintf(output, "    %-22s %10s %12s %14s %12s %7s\n", "stage", "calls", "time (ms)", "bytes", "MB/s", "share");
+    for (stage = 0; stage < NUMBER_OF_PIPELINE_STAGES; ++stage)
+    {
+        statistics = &g_stage_statistics[stage];
+        if (0 == statistics->calls)
+        {
+            continue;
+        }
+
+        fprintf(output, "    %-22s %10llu %12.3f %14llu %12.2f %6.1f%%\n",
+                get_stage_name((PIPELINE_STAGE)stage),
+                (unsigned long long)statistics->calls,
+                (double)statistics->elapsed_ns / NANOSECONDS_IN_MILLISECOND,
+                (unsigned long long)statistics->bytes_processed,
+                (0 == statistics->elapsed_ns) ? 0.0 :
+                    ((double)statistics->bytes_processed / BYTES_IN_MEGABYTE) / ((double)statistics->elapsed_ns / (double)NANOSECONDS_IN_SECOND),
+                (0 == total_elapsed_ns) ? 0.0 : (100.0 * (double)statistics->elapsed_ns / (double)total_elapsed_ns));
+    }
+    fprintf(output, "    %-22s %10s %12.3f\n", "total", "", (double)total_elapsed_ns / NANOSECONDS_IN_MILLISECOND);
+}
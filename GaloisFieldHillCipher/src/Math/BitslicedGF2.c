@@ -0,0 +1,511 @@
+#include "Math/BitslicedGF2.h"
+
+// All ones when the bit is set, so a product term is an AND instead of a branch on the key or the data
+static uint64_t broadcast_gf2_bit(uint64_t word, uint32_t bit)
+{
+    return (uint64_t)0 - ((word >> bit) & 1);
+}
+
+static uint64_t reverse_bits_in_bytes(uint64_t word)
+{
+    word = ((word >> 1) & 0x5555555555555555ULL) | ((word & 0x5555555555555555ULL) << 1);
+    word = ((word >> 2) & 0x3333333333333333ULL) | ((word & 0x3333333333333333ULL) << 2);
+    word = ((word >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((word & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    return word;
+}
+
+// Element i of the bytes is bit i of the word, the bytes hold their elements from the most significant bit
+static uint64_t load_gf2_word(const uint8_t* bytes, uint32_t number_of_bytes)
+{
+    uint64_t word = 0;
+    uint32_t index = 0;
+
+    for (index = 0; index < number_of_bytes; ++index)
+    {
+        word |= (uint64_t)bytes[index] << (index * GF2_BITS_PER_BYTE);
+    }
+    return reverse_bits_in_bytes(word);
+}
+
+static void store_gf2_word(uint8_t* bytes, uint64_t word, uint32_t number_of_bytes)
+{
+    uint32_t index = 0;
+
+    word = reverse_bits_in_bytes(word);
+    for (index = 0; index < number_of_bytes; ++index)
+    {
+        bytes[index] = (uint8_t)(word >> (index * GF2_BITS_PER_BYTE));
+    }
+}
+
+// Bytes of a block in its word, the last word of a dimension that isn't a multiple of 64 is partial
+static uint32_t calculate_gf2_word_bytes(uint32_t bytes_per_block, uint32_t word_index)
+{
+    uint32_t remaining_bytes = bytes_per_block - (word_index * (uint32_t)sizeof(uint64_t));
+
+    return (remaining_bytes < sizeof(uint64_t)) ? remaining_bytes : (uint32_t)sizeof(uint64_t);
+}
+
+static uint64_t calculate_gf2_parity(uint64_t word)
+{
+    word ^= word >> 32;
+    word ^= word >> 16;
+    word ^= word >> 8;
+    word ^= word >> 4;
+    word ^= word >> 2;
+    word ^= word >> 1;
+    return word & 1;
+}
+
+static void xor_gf2_words(uint64_t* destination, const uint64_t* source, uint32_t number_of_words)
+{
+    uint32_t index = 0;
+
+    for (index = 0; index < number_of_words; ++index)
+    {
+        destination[index] ^= source[index];
+    }
+}
+
+static STATUS_CODE allocate_gf2_bit_matrix(GF2BitMatrix* out_matrix, uint32_t dimension)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    GF2BitMatrix matrix = {0};
+
+    if ((NULL == out_matrix) || (0 == dimension))
+    {
+        log_error("[!] Invalid arguments in allocate_gf2_bit_matrix");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    matrix.dimension = dimension;
+    matrix.words_per_row = calculate_gf2_words_per_row(dimension);
+    matrix.rows = (uint64_t*)calloc((size_t)dimension * matrix.words_per_row, sizeof(uint64_t));
+    if (NULL == matrix.rows)
+    {
+        log_error("[!] Memory allocation failed in allocate_gf2_bit_matrix");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    *out_matrix = matrix;
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
+
+uint32_t calculate_gf2_words_per_row(uint32_t dimension)
+{
+    return (dimension + GF2_BITS_PER_WORD - 1) / GF2_BITS_PER_WORD;
+}
+
+STATUS_CODE pack_gf2_bit_matrix(GF2BitMatrix* out_matrix, const FieldVector* flat_matrix, uint32_t dimension)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    GF2BitMatrix matrix = {0};
+    size_t row = 0, column = 0;
+
+    if ((NULL == out_matrix) || (NULL == flat_matrix) || (NULL == flat_matrix->elements) ||
+        ((uint64_t)flat_matrix->length < (uint64_t)dimension * dimension))
+    {
+        log_error("[!] Invalid arguments in pack_gf2_bit_matrix");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    return_code = allocate_gf2_bit_matrix(&matrix, dimension);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    for (row = 0; row < dimension; ++row)
+    {
+        for (column = 0; column < dimension; ++column)
+        {
+            matrix.rows[(row * matrix.words_per_row) + (column / GF2_BITS_PER_WORD)] |=
+                (uint64_t)(get_field_vector_element(flat_matrix, (row * dimension) + column) % GF2_PRIME_FIELD) << (column % GF2_BITS_PER_WORD);
+        }
+    }
+
+    *out_matrix = matrix;
+    memset(&matrix, 0, sizeof(matrix));
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free_gf2_bit_matrix(&matrix);
+    return return_code;
+}
+
+STATUS_CODE pack_gf2_bit_vector(uint64_t** out_vector, const FieldVector* vector, uint32_t dimension)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint64_t* packed_vector = NULL;
+    size_t index = 0;
+
+    if ((NULL == out_vector) || (NULL == vector) || (NULL == vector->elements) || (0 == dimension) || (vector->length < dimension))
+    {
+        log_error("[!] Invalid arguments in pack_gf2_bit_vector");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    packed_vector = (uint64_t*)calloc(calculate_gf2_words_per_row(dimension), sizeof(uint64_t));
+    if (NULL == packed_vector)
+    {
+        log_error("[!] Memory allocation failed in pack_gf2_bit_vector");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    for (index = 0; index < dimension; ++index)
+    {
+        packed_vector[index / GF2_BITS_PER_WORD] |= (uint64_t)(get_field_vector_element(vector, index) % GF2_PRIME_FIELD) << (index % GF2_BITS_PER_WORD);
+    }
+
+    *out_vector = packed_vector;
+    packed_vector = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free(packed_vector);
+    return return_code;
+}
+
+void free_gf2_bit_matrix(GF2BitMatrix* matrix)
+{
+    if (NULL == matrix)
+    {
+        return;
+    }
+
+    free(matrix->rows);
+    memset(matrix, 0, sizeof(*matrix));
+}
+
+STATUS_CODE invert_gf2_bit_matrix(GF2BitMatrix* out_inverse, const GF2BitMatrix* matrix)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    GF2BitMatrix inverse = {0};
+    uint64_t* augmented_matrix = NULL;
+    uint64_t** rows = NULL;
+    uint64_t* combinations = NULL;
+    uint64_t* swapped_row = NULL;
+    uint64_t strip_mask = 0;
+    uint32_t dimension = 0, words_per_row = 0, augmented_words = 0, strip_start = 0, strip_width = 0, strip_word = 0, strip_shift = 0;
+    uint32_t column = 0, pivot = 0, row = 0, combination = 0, lowest_bit = 0;
+
+    if ((NULL == out_inverse) || (NULL == matrix) || (NULL == matrix->rows) || (0 == matrix->dimension))
+    {
+        log_error("[!] Invalid arguments in invert_gf2_bit_matrix");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+    dimension = matrix->dimension;
+    words_per_row = matrix->words_per_row;
+    augmented_words = 2 * words_per_row;
+
+    // Rows are [matrix | identity] and are swapped by pointer
+    augmented_matrix = (uint64_t*)calloc((size_t)dimension * augmented_words, sizeof(uint64_t));
+    rows = (uint64_t**)malloc(dimension * sizeof(uint64_t*));
+    combinations = (uint64_t*)malloc(((size_t)1 << GF2_M4RI_STRIP_WIDTH) * augmented_words * sizeof(uint64_t));
+    if ((NULL == augmented_matrix) || (NULL == rows) || (NULL == combinations))
+    {
+        log_error("[!] Memory allocation failed in invert_gf2_bit_matrix");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    for (row = 0; row < dimension; ++row)
+    {
+        rows[row] = augmented_matrix + ((size_t)row * augmented_words);
+        memcpy(rows[row], matrix->rows + ((size_t)row * words_per_row), words_per_row * sizeof(uint64_t));
+        rows[row][words_per_row + (row / GF2_BITS_PER_WORD)] |= (uint64_t)1 << (row % GF2_BITS_PER_WORD);
+    }
+
+    // Strips never cross a word, GF2_BITS_PER_WORD is a multiple of the strip width
+    for (strip_start = 0; strip_start < dimension; strip_start += GF2_M4RI_STRIP_WIDTH)
+    {
+        strip_width = ((dimension - strip_start) < GF2_M4RI_STRIP_WIDTH) ? (dimension - strip_start) : GF2_M4RI_STRIP_WIDTH;
+        strip_word = strip_start / GF2_BITS_PER_WORD;
+        strip_shift = strip_start % GF2_BITS_PER_WORD;
+
+        // Plain elimination finds the pivots of the strip, a candidate row is reduced by the pivots found so far only once inspected.
+        // The pivot rows are kept reduced against each other, so the strip columns of the pivot rows form the identity
+        for (column = strip_start; column < strip_start + strip_width; ++column)
+        {
+            for (pivot = column; pivot < dimension; ++pivot)
+            {
+                for (row = strip_start; row < column; ++row)
+                {
+                    if (0 != ((rows[pivot][strip_word] >> (row % GF2_BITS_PER_WORD)) & 1))
+                    {
+                        xor_gf2_words(rows[pivot] + strip_word, rows[row] + strip_word, augmented_words - strip_word);
+                    }
+                }
+                if (0 != ((rows[pivot][strip_word] >> (column % GF2_BITS_PER_WORD)) & 1))
+                {
+                    break;
+                }
+            }
+            if (pivot == dimension)
+            {
+                log_error("[!] Matrix is not invertible (zero pivot) in invert_gf2_bit_matrix.");
+                return_code = STATUS_CODE_MATRIX_NOT_INVERTIBLE;
+                goto cleanup;
+            }
+
+            swapped_row = rows[column];
+            rows[column] = rows[pivot];
+            rows[pivot] = swapped_row;
+
+            for (row = strip_start; row < column; ++row)
+            {
+                if (0 != ((rows[row][strip_word] >> (column % GF2_BITS_PER_WORD)) & 1))
+                {
+                    xor_gf2_words(rows[row] + strip_word, rows[column] + strip_word, augmented_words - strip_word);
+                }
+            }
+        }
+
+        // Every combination of the pivot rows, one row XOR per entry. Words left of the strip are zero in the pivot rows
+        memset(combinations, 0, augmented_words * sizeof(uint64_t));
+        for (combination = 1; combination < ((uint32_t)1 << strip_width); ++combination)
+        {
+            for (lowest_bit = 0; 0 == ((combination >> lowest_bit) & 1); ++lowest_bit)
+            {
+            }
+            memcpy(combinations + ((size_t)combination * augmented_words), combinations + ((size_t)(combination & (combination - 1)) * augmented_words),
+                   augmented_words * sizeof(uint64_t));
+            xor_gf2_words(combinations + ((size_t)combination * augmented_words) + strip_word, rows[strip_start + lowest_bit] + strip_word,
+                          augmented_words - strip_word);
+        }
+
+        // The strip bits of a row select the combination that clears all of them
+        strip_mask = ((uint64_t)1 << strip_width) - 1;
+        for (row = 0; row < dimension; ++row)
+        {
+            if ((row >= strip_start) && (row < strip_start + strip_width))
+            {
+                continue;
+            }
+            combination = (uint32_t)((rows[row][strip_word] >> strip_shift) & strip_mask);
+            xor_gf2_words(rows[row] + strip_word, combinations + ((size_t)combination * augmented_words) + strip_word, augmented_words - strip_word);
+        }
+    }
+
+    return_code = allocate_gf2_bit_matrix(&inverse, dimension);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    for (row = 0; row < dimension; ++row)
+    {
+        memcpy(inverse.rows + ((size_t)row * words_per_row), rows[row] + words_per_row, words_per_row * sizeof(uint64_t));
+    }
+
+    *out_inverse = inverse;
+    memset(&inverse, 0, sizeof(inverse));
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free_gf2_bit_matrix(&inverse);
+    free(augmented_matrix);
+    free(rows);
+    free(combinations);
+    return return_code;
+}
+
+STATUS_CODE inverse_square_matrix_over_gf2(int64_t*** out_inverse_matrix, int64_t** matrix, uint32_t dimension)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    GF2BitMatrix packed_matrix = {0};
+    GF2BitMatrix packed_inverse = {0};
+    int64_t** inverse_matrix = NULL;
+    size_t row = 0, column = 0;
+
+    if ((NULL == out_inverse_matrix) || (NULL == matrix))
+    {
+        log_error("[!] Invalid arguments in inverse_square_matrix_over_gf2");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    return_code = allocate_gf2_bit_matrix(&packed_matrix, dimension);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    for (row = 0; row < dimension; ++row)
+    {
+        for (column = 0; column < dimension; ++column)
+        {
+            packed_matrix.rows[(row * packed_matrix.words_per_row) + (column / GF2_BITS_PER_WORD)] |=
+                (uint64_t)(((matrix[row][column] % GF2_PRIME_FIELD) + GF2_PRIME_FIELD) % GF2_PRIME_FIELD) << (column % GF2_BITS_PER_WORD);
+        }
+    }
+
+    return_code = invert_gf2_bit_matrix(&packed_inverse, &packed_matrix);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    return_code = allocate_int64_matrix(&inverse_matrix, dimension, dimension);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    for (row = 0; row < dimension; ++row)
+    {
+        for (column = 0; column < dimension; ++column)
+        {
+            inverse_matrix[row][column] = (int64_t)((packed_inverse.rows[(row * packed_inverse.words_per_row) + (column / GF2_BITS_PER_WORD)] >>
+                (column % GF2_BITS_PER_WORD)) & 1);
+        }
+    }
+
+    *out_inverse_matrix = inverse_matrix;
+    inverse_matrix = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free_gf2_bit_matrix(&packed_matrix);
+    free_gf2_bit_matrix(&packed_inverse);
+    if (NULL != inverse_matrix)
+    {
+        (void)free_int64_matrix(inverse_matrix, dimension);
+    }
+    return return_code;
+}
+
+void transpose_gf2_64x64(uint64_t* words)
+{
+    uint64_t mask = 0x00000000FFFFFFFFULL, swapped = 0;
+    uint32_t width = 0, row = 0;
+
+    // Swaps the off-diagonal blocks of every 2 * width square, from the halves of the whole matrix down to single bits
+    for (width = GF2_BITS_PER_WORD / 2; width != 0; width >>= 1, mask ^= (mask << width))
+    {
+        for (row = 0; row < GF2_BITS_PER_WORD; row = ((row | width) + 1) & ~width)
+        {
+            swapped = ((words[row] >> width) ^ words[row | width]) & mask;
+            words[row] ^= swapped << width;
+            words[row | width] ^= swapped;
+        }
+    }
+}
+
+STATUS_CODE multiply_gf2_blocks(uint8_t* out_blocks, const uint8_t* blocks, size_t number_of_blocks, const GF2BitMatrix* matrix,
+    const uint64_t* input_offset, const uint64_t* output_offset)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint64_t* workspace = NULL;
+    uint64_t* input_slices = NULL;
+    uint64_t* output_slices = NULL;
+    uint64_t* transposed = NULL;
+    const uint64_t* key_row = NULL;
+    uint64_t slice = 0, product = 0;
+    uint32_t words_per_row = 0, bytes_per_block = 0, word_bytes = 0, blocks_in_group = 0;
+    size_t block_number = 0, block = 0, word_index = 0, bit = 0, row = 0;
+
+    if ((NULL == out_blocks) || (NULL == blocks) || (NULL == matrix) || (NULL == matrix->rows) ||
+        (0 == matrix->dimension) || (0 != (matrix->dimension % GF2_BITS_PER_BYTE)))
+    {
+        log_error("[!] Invalid arguments in multiply_gf2_blocks");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+    words_per_row = matrix->words_per_row;
+    bytes_per_block = matrix->dimension / GF2_BITS_PER_BYTE;
+
+    // Slices past the dimension stay zero, so every row runs over whole words
+    workspace = (uint64_t*)calloc(((size_t)2 * words_per_row * GF2_BITS_PER_WORD) + GF2_BLOCKS_PER_SLICE, sizeof(uint64_t));
+    if (NULL == workspace)
+    {
+        log_error("[!] Memory allocation failed in multiply_gf2_blocks");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    input_slices = workspace;
+    output_slices = input_slices + ((size_t)words_per_row * GF2_BITS_PER_WORD);
+    transposed = output_slices + ((size_t)words_per_row * GF2_BITS_PER_WORD);
+
+    for (block_number = 0; (number_of_blocks - block_number) >= GF2_MINIMAL_SLICED_BLOCKS; block_number += blocks_in_group)
+    {
+        blocks_in_group = ((number_of_blocks - block_number) < GF2_BLOCKS_PER_SLICE) ? (uint32_t)(number_of_blocks - block_number) : GF2_BLOCKS_PER_SLICE;
+
+        // Word w of every block becomes the slices of elements 64w to 64w + 63, bit b of a slice belongs to block b of the group
+        for (word_index = 0; word_index < words_per_row; ++word_index)
+        {
+            word_bytes = calculate_gf2_word_bytes(bytes_per_block, (uint32_t)word_index);
+            for (block = 0; block < GF2_BLOCKS_PER_SLICE; ++block)
+            {
+                transposed[block] = (block < blocks_in_group) ?
+                    load_gf2_word(blocks + ((block_number + block) * bytes_per_block) + (word_index * sizeof(uint64_t)), word_bytes) : 0;
+            }
+            transpose_gf2_64x64(transposed);
+            for (bit = 0; bit < GF2_BITS_PER_WORD; ++bit)
+            {
+                input_slices[(word_index * GF2_BITS_PER_WORD) + bit] = transposed[bit] ^
+                    ((NULL == input_offset) ? 0 : broadcast_gf2_bit(input_offset[word_index], (uint32_t)bit));
+            }
+        }
+
+        for (row = 0; row < matrix->dimension; ++row)
+        {
+            key_row = matrix->rows + (row * words_per_row);
+            slice = (NULL == output_offset) ? 0 : broadcast_gf2_bit(output_offset[row / GF2_BITS_PER_WORD], (uint32_t)(row % GF2_BITS_PER_WORD));
+            for (word_index = 0; word_index < words_per_row; ++word_index)
+            {
+                for (bit = 0; bit < GF2_BITS_PER_WORD; ++bit)
+                {
+                    slice ^= input_slices[(word_index * GF2_BITS_PER_WORD) + bit] & broadcast_gf2_bit(key_row[word_index], (uint32_t)bit);
+                }
+            }
+            output_slices[row] = slice;
+        }
+
+        for (word_index = 0; word_index < words_per_row; ++word_index)
+        {
+            word_bytes = calculate_gf2_word_bytes(bytes_per_block, (uint32_t)word_index);
+            memcpy(transposed, output_slices + (word_index * GF2_BITS_PER_WORD), GF2_BITS_PER_WORD * sizeof(uint64_t));
+            transpose_gf2_64x64(transposed);
+            for (block = 0; block < blocks_in_group; ++block)
+            {
+                store_gf2_word(out_blocks + ((block_number + block) * bytes_per_block) + (word_index * sizeof(uint64_t)), transposed[block], word_bytes);
+            }
+        }
+    }
+
+    // The remaining blocks one by one, every element of the product is the parity of a key row AND the block
+    for (; block_number < number_of_blocks; ++block_number)
+    {
+        for (word_index = 0; word_index < words_per_row; ++word_index)
+        {
+            word_bytes = calculate_gf2_word_bytes(bytes_per_block, (uint32_t)word_index);
+            input_slices[word_index] = load_gf2_word(blocks + (block_number * bytes_per_block) + (word_index * sizeof(uint64_t)), word_bytes) ^
+                ((NULL == input_offset) ? 0 : input_offset[word_index]);
+            output_slices[word_index] = (NULL == output_offset) ? 0 : output_offset[word_index];
+        }
+
+        for (row = 0; row < matrix->dimension; ++row)
+        {
+            key_row = matrix->rows + (row * words_per_row);
+            product = 0;
+            for (word_index = 0; word_index < words_per_row; ++word_index)
+            {
+                product ^= key_row[word_index] & input_slices[word_index];
+            }
+            output_slices[row / GF2_BITS_PER_WORD] ^= calculate_gf2_parity(product) << (row % GF2_BITS_PER_WORD);
+        }
+
+        for (word_index = 0; word_index < words_per_row; ++word_index)
+        {
+            word_bytes = calculate_gf2_word_bytes(bytes_per_block, (uint32_t)word_index);
+            store_gf2_word(out_blocks + (block_number * bytes_per_block) + (word_index * sizeof(uint64_t)), output_slices[word_index], word_bytes);
+        }
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free(workspace);
+    return return_code;
+}
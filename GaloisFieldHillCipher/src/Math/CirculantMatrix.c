@@ -0,0 +1,333 @@
+#include "Math/CirculantMatrix.h"
+
+STATUS_CODE initialize_circulant_key(CirculantKey* out_key, const int64_t* column, uint32_t dimension, uint32_t prime_field)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    CirculantKey key = {0};
+    uint32_t index = 0;
+
+    if ((NULL == out_key) || (NULL == column) || !is_ntt_compatible(dimension, prime_field))
+    {
+        log_error("[!] Invalid arguments in initialize_circulant_key: dimension %u must be a power of two dividing %u - 1",
+                  dimension, prime_field);
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    return_code = initialize_ntt_context(&key.transform, dimension, prime_field);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    key.transformed_column = (uint32_t*)malloc(dimension * sizeof(uint32_t));
+    key.workspace = (uint32_t*)malloc(dimension * sizeof(uint32_t));
+    if ((NULL == key.transformed_column) || (NULL == key.workspace))
+    {
+        log_error("[!] Memory allocation failed in initialize_circulant_key");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    for (index = 0; index < dimension; ++index)
+    {
+        key.transformed_column[index] = (uint32_t)(((column[index] % prime_field) + prime_field) % prime_field);
+    }
+    ntt_forward(key.transformed_column, &key.transform);
+
+    *out_key = key;
+    memset(&key, 0, sizeof(key));
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    free_circulant_key(&key);
+    return return_code;
+}
+
+void free_circulant_key(CirculantKey* key)
+{
+    if (NULL == key)
+    {
+        return;
+    }
+
+    free_ntt_context(&key->transform);
+    free(key->transformed_column);
+    free(key->workspace);
+    key->transformed_column = NULL;
+    key->workspace = NULL;
+}
+
+STATUS_CODE create_circulant_key_view(CirculantKey* out_view, const CirculantKey* key)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    CirculantKey view = {0};
+
+    if ((NULL == out_view) || (NULL == key) || (NULL == key->transformed_column) || (0 == key->transform.length))
+    {
+        log_error("[!] Invalid arguments in create_circulant_key_view");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    view = *key;
+    view.workspace = (uint32_t*)malloc(key->transform.length * sizeof(uint32_t));
+    if (NULL == view.workspace)
+    {
+        log_error("[!] Memory allocation failed in create_circulant_key_view");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    *out_view = view;
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
+
+void free_circulant_key_view(CirculantKey* view)
+{
+    if (NULL == view)
+    {
+        return;
+    }
+
+    free(view->workspace);
+    memset(view, 0, sizeof(*view));
+}
+
+STATUS_CODE invert_circulant_column(int64_t** out_inverse_column, const int64_t* column, uint32_t dimension, uint32_t prime_field)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    CirculantKey key = {0};
+    FieldContext field_context = {0};
+    int64_t* eigenvalues = NULL;
+    int64_t* inverse_column = NULL;
+    uint32_t index = 0;
+
+    if (NULL == out_inverse_column)
+    {
+        log_error("[!] Invalid arguments in invert_circulant_column");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    return_code = initialize_circulant_key(&key, column, dimension, prime_field);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    return_code = initialize_field_context(&field_context, prime_field, 1); // The eigenvalues share a single batch inversion
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    eigenvalues = (int64_t*)malloc(dimension * sizeof(int64_t));
+    inverse_column = (int64_t*)malloc(dimension * sizeof(int64_t));
+    if ((NULL == eigenvalues) || (NULL == inverse_column))
+    {
+        log_error("[!] Memory allocation failed in invert_circulant_column");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    for (index = 0; index < dimension; ++index)
+    {
+        eigenvalues[index] = key.transformed_column[index];
+    }
+
+    // A zero eigenvalue zeroes the product of all of them, the batch inversion reports it as not invertible
+    return_code = batch_inverse_over_galois_field(eigenvalues, eigenvalues, dimension, &field_context);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    for (index = 0; index < dimension; ++index)
+    {
+        key.workspace[index] = (uint32_t)eigenvalues[index];
+    }
+    ntt_inverse(key.workspace, &key.transform);
+    for (index = 0; index < dimension; ++index)
+    {
+        inverse_column[index] = key.workspace[index];
+    }
+
+    *out_inverse_column = inverse_column;
+    inverse_column = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    free_circulant_key(&key);
+    free_field_context(&field_context);
+    free(eigenvalues);
+    free(inverse_column);
+    return return_code;
+}
+
+STATUS_CODE expand_circulant_column(int64_t*** out_matrix, const int64_t* column, uint32_t dimension)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    int64_t** matrix = NULL;
+    uint32_t row = 0, matrix_column = 0;
+
+    if ((NULL == out_matrix) || (NULL == column) || (0 == dimension))
+    {
+        log_error("[!] Invalid arguments in expand_circulant_column");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    return_code = allocate_int64_matrix(&matrix, dimension, dimension);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    for (row = 0; row < dimension; ++row)
+    {
+        for (matrix_column = 0; matrix_column < dimension; ++matrix_column)
+        {
+            matrix[row][matrix_column] = column[(row + dimension - matrix_column) % dimension];
+        }
+    }
+
+    *out_matrix = matrix;
+    matrix = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    if (NULL != matrix)
+    {
+        (void)free_int64_matrix(matrix, dimension);
+    }
+    return return_code;
+}
+
+/**
+ * @brief Multiplies the circulant key with the vector held in the key workspace, leaving the product in the workspace.
+ *
+ * @param key - The circulant key, its workspace holds the vector.
+ */
+static void multiply_circulant_with_workspace(CirculantKey* key)
+{
+    uint32_t index = 0;
+    uint32_t prime_field = key->transform.prime_field;
+
+    ntt_forward(key->workspace, &key->transform);
+    for (index = 0; index < key->transform.length; ++index)
+    {
+        key->workspace[index] = (uint32_t)(((uint64_t)key->workspace[index] * key->transformed_column[index]) % prime_field);
+    }
+    ntt_inverse(key->workspace, &key->transform);
+}
+
+STATUS_CODE multiply_circulant_with_uint8_t_vector(FieldVector* out_vector, CirculantKey* key, const uint8_t* vector, const FieldVector* offset_vector)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint32_t index = 0, prime_field = 0;
+    uint64_t result = 0;
+
+    if ((NULL == out_vector) || (NULL == key) || (NULL == key->workspace) || (NULL == vector) ||
+        (out_vector->length != key->transform.length) || ((NULL != offset_vector) && (offset_vector->length != key->transform.length)))
+    {
+        log_error("[!] Invalid arguments in multiply_circulant_with_uint8_t_vector");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+    prime_field = key->transform.prime_field;
+
+    for (index = 0; index < key->transform.length; ++index)
+    {
+        key->workspace[index] = vector[index] % prime_field;
+    }
+    multiply_circulant_with_workspace(key);
+
+    for (index = 0; index < key->transform.length; ++index)
+    {
+        result = key->workspace[index];
+        if (NULL != offset_vector)
+        {
+            result = (result + get_field_vector_element(offset_vector, index)) % prime_field;
+        }
+        set_field_vector_element(out_vector, index, (uint32_t)result);
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE multiply_circulant_with_field_vector(uint8_t* out_vector, CirculantKey* key, const FieldVector* vector)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint32_t index = 0;
+
+    if ((NULL == out_vector) || (NULL == key) || (NULL == key->workspace) || (NULL == vector) ||
+        (vector->length != key->transform.length))
+    {
+        log_error("[!] Invalid arguments in multiply_circulant_with_field_vector");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    for (index = 0; index < key->transform.length; ++index)
+    {
+        key->workspace[index] = get_field_vector_element(vector, index);
+    }
+    multiply_circulant_with_workspace(key);
+
+    for (index = 0; index < key->transform.length; ++index)
+    {
+        if (key->workspace[index] > UINT8_MAX)
+        {
+            log_error("[!] Result width too large in multiply_circulant_with_field_vector: %u > %u", key->workspace[index], UINT8_MAX);
+            return_code = STATUS_CODE_INVALID_RESULT_WIDTH;
+            goto cleanup;
+        }
+        out_vector[index] = (uint8_t)key->workspace[index];
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE multiply_circulant_with_field_vector_over_field(FieldVector* out_vector, CirculantKey* key, const FieldVector* vector, const FieldVector* offset_vector)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint32_t index = 0, prime_field = 0;
+    uint64_t result = 0;
+
+    if ((NULL == out_vector) || (NULL == key) || (NULL == key->workspace) || (NULL == vector) ||
+        (vector->length != key->transform.length) || (out_vector->length != key->transform.length) ||
+        ((NULL != offset_vector) && (offset_vector->length != key->transform.length)))
+    {
+        log_error("[!] Invalid arguments in multiply_circulant_with_field_vector_over_field");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+    prime_field = key->transform.prime_field;
+
+    for (index = 0; index < key->transform.length; ++index)
+    {
+        key->workspace[index] = get_field_vector_element(vector, index);
+    }
+    multiply_circulant_with_workspace(key);
+
+    for (index = 0; index < key->transform.length; ++index)
+    {
+        result = key->workspace[index];
+        if (NULL != offset_vector)
+        {
+            result = (result + get_field_vector_element(offset_vector, index)) % prime_field;
+        }
+        set_field_vector_element(out_vector, index, (uint32_t)result);
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
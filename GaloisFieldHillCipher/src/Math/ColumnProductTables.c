@@ -0,0 +1,261 @@
+#include "Math/ColumnProductTables.h"
+
+/**
+ * @brief Encrypts one block with the tables of a key, out_block = K * block + offset over the field.
+ *
+ * @param out_block - Output of dimension elements of the key width.
+ * @param tables - The column product tables of the key.
+ * @param block - The plaintext block, dimension bytes.
+ * @param offset_vector - Elements of the key width aligned to [0, prime_field) added to the product, may be NULL.
+ */
+typedef void (*ColumnProductKernel)(void* out_block, const ColumnProductTables* tables, const uint8_t* block, const void* offset_vector);
+
+/**
+ * The kernels of one dimension, indexed by the width of the sums.
+ */
+struct ColumnProductKernels {
+    uint32_t dimension;
+    ColumnProductKernel kernels[NUMBER_OF_COLUMN_PRODUCT_SUMS];
+} typedef ColumnProductKernels;
+
+// The sums of a block stay below (dimension + 1) * prime_field, those below 2^32 are reduced with the reciprocal of the prime
+#define REDUCE_WITH_RECIPROCAL(SUM) ((SUM) - ((((uint64_t)(SUM) * tables->reduction_multiplier) >> tables->reduction_shift) * tables->prime_field))
+#define REDUCE_WITH_DIVISION(SUM) ((SUM) % tables->prime_field)
+
+/*
+ * Kernel templates, instantiated for every width of the sums. The runtime-dimension kernel accumulates the rows in strips of
+ * COLUMN_PRODUCT_ROWS_PER_PASS, the kernels of SPECIALIZED_KERNEL_DIMENSIONS keep a whole block of sums and unroll the row loop.
+ */
+#define DEFINE_COLUMN_PRODUCT_KERNEL(ELEMENT_TYPE, SUM_TYPE, REDUCE)                                                        \
+static void multiply_tables_##ELEMENT_TYPE##_into_##SUM_TYPE(void* out_block, const ColumnProductTables* tables,            \
+                                                             const uint8_t* block, const void* offset_vector)               \
+{                                                                                                                           \
+    const ELEMENT_TYPE* products = (const ELEMENT_TYPE*)tables->products.elements;                                          \
+    const ELEMENT_TYPE* offset = (const ELEMENT_TYPE*)offset_vector;                                                        \
+    const ELEMENT_TYPE* product_row = NULL;                                                                                 \
+    ELEMENT_TYPE* out = (ELEMENT_TYPE*)out_block;                                                                           \
+    SUM_TYPE sums[COLUMN_PRODUCT_ROWS_PER_PASS];                                                                            \
+    size_t dimension = tables->dimension, table_length = COLUMN_PRODUCT_TABLE_ENTRIES * dimension;                          \
+    size_t first_row = 0, rows_in_pass = 0, row = 0, column = 0;                                                            \
+                                                                                                                            \
+    for (first_row = 0; first_row < dimension; first_row += rows_in_pass)                                                   \
+    {                                                                                                                       \
+        rows_in_pass = ((dimension - first_row) < COLUMN_PRODUCT_ROWS_PER_PASS) ?                                           \
+            (dimension - first_row) : COLUMN_PRODUCT_ROWS_PER_PASS;                                                         \
+        for (row = 0; row < rows_in_pass; ++row)                                                                            \
+        {                                                                                                                   \
+            sums[row] = (NULL == offset) ? 0 : offset[first_row + row];                                                     \
+        }                                                                                                                   \
+        for (column = 0; column < dimension; ++column)                                                                      \
+        {                                                                                                                   \
+            product_row = products + (column * table_length) + (block[column] * dimension) + first_row;                     \
+            for (row = 0; row < rows_in_pass; ++row)                                                                        \
+            {                                                                                                               \
+                sums[row] += product_row[row];                                                                              \
+            }                                                                                                               \
+        }                                                                                                                   \
+        for (row = 0; row < rows_in_pass; ++row)                                                                            \
+        {                                                                                                                   \
+            out[first_row + row] = (ELEMENT_TYPE)REDUCE(sums[row]);                                                         \
+        }                                                                                                                   \
+    }                                                                                                                       \
+}
+
+#define DEFINE_SPECIALIZED_COLUMN_PRODUCT_KERNEL(DIMENSION, ELEMENT_TYPE, SUM_TYPE, REDUCE)                                 \
+static void multiply_tables_##DIMENSION##_##ELEMENT_TYPE##_into_##SUM_TYPE(void* out_block, const ColumnProductTables* tables, \
+                                                                           const uint8_t* block, const void* offset_vector) \
+{                                                                                                                           \
+    const ELEMENT_TYPE* products = (const ELEMENT_TYPE*)tables->products.elements;                                          \
+    const ELEMENT_TYPE* offset = (const ELEMENT_TYPE*)offset_vector;                                                        \
+    const ELEMENT_TYPE* product_row = NULL;                                                                                 \
+    ELEMENT_TYPE* out = (ELEMENT_TYPE*)out_block;                                                                           \
+    SUM_TYPE sums[DIMENSION];                                                                                               \
+    size_t row = 0, column = 0;                                                                                             \
+                                                                                                                            \
+    for (row = 0; row < (DIMENSION); ++row)                                                                                 \
+    {                                                                                                                       \
+        sums[row] = (NULL == offset) ? 0 : offset[row];                                                                     \
+    }                                                                                                                       \
+    for (column = 0; column < (DIMENSION); ++column)                                                                        \
+    {                                                                                                                       \
+        product_row = products + (column * COLUMN_PRODUCT_TABLE_ENTRIES * (DIMENSION)) + (block[column] * (DIMENSION));     \
+        UNROLL_FULLY                                                                                                        \
+        for (row = 0; row < (DIMENSION); ++row)                                                                             \
+        {                                                                                                                   \
+            sums[row] += product_row[row];                                                                                  \
+        }                                                                                                                   \
+    }                                                                                                                       \
+    for (row = 0; row < (DIMENSION); ++row)                                                                                 \
+    {                                                                                                                       \
+        out[row] = (ELEMENT_TYPE)REDUCE(sums[row]);                                                                         \
+    }                                                                                                                       \
+}
+
+#define DEFINE_SPECIALIZED_COLUMN_PRODUCT_KERNELS(DIMENSION)                                          \
+    DEFINE_SPECIALIZED_COLUMN_PRODUCT_KERNEL(DIMENSION, uint16_t, uint16_t, REDUCE_WITH_RECIPROCAL)   \
+    DEFINE_SPECIALIZED_COLUMN_PRODUCT_KERNEL(DIMENSION, uint16_t, uint32_t, REDUCE_WITH_RECIPROCAL)   \
+    DEFINE_SPECIALIZED_COLUMN_PRODUCT_KERNEL(DIMENSION, uint32_t, uint64_t, REDUCE_WITH_DIVISION)
+
+#define COLUMN_PRODUCT_KERNELS_TABLE_ENTRY(DIMENSION)                                                                       \
+    {                                                                                                                       \
+        (DIMENSION),                                                                                                        \
+        {multiply_tables_##DIMENSION##_uint16_t_into_uint16_t, multiply_tables_##DIMENSION##_uint16_t_into_uint32_t,        \
+         multiply_tables_##DIMENSION##_uint32_t_into_uint64_t}                                                              \
+    },
+
+DEFINE_COLUMN_PRODUCT_KERNEL(uint16_t, uint16_t, REDUCE_WITH_RECIPROCAL)
+DEFINE_COLUMN_PRODUCT_KERNEL(uint16_t, uint32_t, REDUCE_WITH_RECIPROCAL)
+DEFINE_COLUMN_PRODUCT_KERNEL(uint32_t, uint64_t, REDUCE_WITH_DIVISION)
+
+SPECIALIZED_KERNEL_DIMENSIONS(DEFINE_SPECIALIZED_COLUMN_PRODUCT_KERNELS)
+
+static const ColumnProductKernels g_column_product_kernels = {
+    0,
+    {multiply_tables_uint16_t_into_uint16_t, multiply_tables_uint16_t_into_uint32_t, multiply_tables_uint32_t_into_uint64_t}
+};
+
+// Dispatch table keyed on the dimension, the zero entry ends it and keeps it valid for an empty dimension list
+static const ColumnProductKernels g_specialized_column_product_kernels[] = {
+    SPECIALIZED_KERNEL_DIMENSIONS(COLUMN_PRODUCT_KERNELS_TABLE_ENTRY)
+    {0, {NULL, NULL, NULL}}
+};
+
+static const ColumnProductKernels* get_specialized_column_product_kernels(uint32_t dimension)
+{
+    size_t index = 0;
+
+    for (index = 0; 0 != g_specialized_column_product_kernels[index].dimension; ++index)
+    {
+        if (dimension == g_specialized_column_product_kernels[index].dimension)
+        {
+            return &g_specialized_column_product_kernels[index];
+        }
+    }
+    return NULL;
+}
+
+static void select_column_product_sums(ColumnProductTables* tables)
+{
+    uint64_t maximal_sum = (uint64_t)(tables->dimension + 1) * (tables->prime_field - 1);
+    uint32_t shift = 0;
+
+    if (FIELD_ELEMENT_WIDTH_UINT32 == tables->products.width)
+    {
+        tables->sums = COLUMN_PRODUCT_SUMS_UINT64;
+        return;
+    }
+    tables->sums = (maximal_sum <= UINT16_MAX) ? COLUMN_PRODUCT_SUMS_UINT16 : COLUMN_PRODUCT_SUMS_UINT32;
+
+    // (sum * (floor(2^shift / p) + 1)) >> shift is floor(sum / p) for every sum when maximal_sum * p < 2^shift,
+    // the smallest such shift keeps the product of the largest sum below 2^64
+    while ((maximal_sum * tables->prime_field) >= ((uint64_t)1 << shift))
+    {
+        ++shift;
+    }
+    tables->reduction_shift = shift;
+    tables->reduction_multiplier = (((uint64_t)1 << shift) / tables->prime_field) + 1;
+}
+
+uint64_t calculate_column_product_tables_size(uint32_t dimension, uint32_t prime_field)
+{
+    return (uint64_t)dimension * COLUMN_PRODUCT_TABLE_ENTRIES * dimension * get_field_element_size(select_field_element_width(prime_field));
+}
+
+bool can_use_column_product_tables(uint32_t dimension, uint32_t prime_field)
+{
+    return (prime_field >= 2) && (NULL != get_specialized_column_product_kernels(dimension)) &&
+        (calculate_column_product_tables_size(dimension, prime_field) <= (uint64_t)COLUMN_PRODUCT_TABLES_MEMORY_BUDGET);
+}
+
+STATUS_CODE build_column_product_tables(ColumnProductTables* out_tables, const FieldVector* flat_matrix, uint32_t dimension, uint32_t prime_field)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    ColumnProductTables tables = {0};
+    size_t table_length = (size_t)COLUMN_PRODUCT_TABLE_ENTRIES * dimension;
+    uint64_t product = 0;
+    uint32_t key_element = 0;
+    size_t row = 0, column = 0, byte_value = 0;
+
+    if ((NULL == out_tables) || (NULL == flat_matrix) || (NULL == flat_matrix->elements) || (0 == dimension) || (prime_field < 2) ||
+        (flat_matrix->length < (dimension * dimension)) || (flat_matrix->width != select_field_element_width(prime_field)) ||
+        (((uint64_t)dimension * table_length) > UINT32_MAX))
+    {
+        log_error("[!] Invalid arguments in build_column_product_tables");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    return_code = allocate_field_vector(&tables.products, (uint32_t)(dimension * table_length), prime_field);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    tables.dimension = dimension;
+    tables.prime_field = prime_field;
+    select_column_product_sums(&tables);
+
+    // Row 0 stays zero, row b + 1 is row b plus the key column
+    for (column = 0; column < dimension; ++column)
+    {
+        for (row = 0; row < dimension; ++row)
+        {
+            key_element = get_field_vector_element(flat_matrix, (row * dimension) + column);
+            for (byte_value = 1, product = 0; byte_value < COLUMN_PRODUCT_TABLE_ENTRIES; ++byte_value)
+            {
+                product += key_element;
+                product = (product >= prime_field) ? (product - prime_field) : product;
+                set_field_vector_element(&tables.products, (column * table_length) + (byte_value * dimension) + row, (uint32_t)product);
+            }
+        }
+    }
+
+    *out_tables = tables;
+    memset(&tables, 0, sizeof(tables));
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free_column_product_tables(&tables);
+    return return_code;
+}
+
+void free_column_product_tables(ColumnProductTables* tables)
+{
+    if (NULL == tables)
+    {
+        return;
+    }
+
+    free_field_vector(&tables->products);
+    memset(tables, 0, sizeof(*tables));
+}
+
+STATUS_CODE multiply_column_product_tables_with_uint8_t_blocks(FieldVector* out_blocks, const ColumnProductTables* tables, const uint8_t* blocks,
+    uint32_t number_of_blocks, const FieldVector* offset_vector)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    const ColumnProductKernels* kernels = NULL;
+    ColumnProductKernel kernel = NULL;
+    size_t block_size = 0, block = 0;
+
+    if ((NULL == out_blocks) || (NULL == tables) || (NULL == tables->products.elements) || (NULL == blocks) ||
+        (tables->sums >= NUMBER_OF_COLUMN_PRODUCT_SUMS) ||
+        (out_blocks->length < ((uint64_t)number_of_blocks * tables->dimension)) || (out_blocks->width != tables->products.width) ||
+        ((NULL != offset_vector) && ((offset_vector->length < tables->dimension) || (offset_vector->width != tables->products.width))))
+    {
+        log_error("[!] Invalid arguments in column product tables multiplication");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    kernels = get_specialized_column_product_kernels(tables->dimension);
+    kernel = ((NULL == kernels) ? &g_column_product_kernels : kernels)->kernels[tables->sums];
+    block_size = (size_t)tables->dimension * get_field_element_size(tables->products.width);
+    for (block = 0; block < number_of_blocks; ++block)
+    {
+        kernel((uint8_t*)out_blocks->elements + (block * block_size), tables, blocks + (block * tables->dimension),
+               (NULL == offset_vector) ? NULL : offset_vector->elements);
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
@@ -0,0 +1,83 @@
+#include "Math/FieldElement.h"
+
+FIELD_ELEMENT_WIDTH select_field_element_width(uint32_t prime_field)
+{
+    return (prime_field <= MAXIMAL_PRIME_FIELD_FOR_UINT16_ELEMENTS) ? FIELD_ELEMENT_WIDTH_UINT16 : FIELD_ELEMENT_WIDTH_UINT32;
+}
+
+size_t get_field_element_size(FIELD_ELEMENT_WIDTH width)
+{
+    switch (width)
+    {
+        case FIELD_ELEMENT_WIDTH_UINT16:
+            return sizeof(uint16_t);
+        case FIELD_ELEMENT_WIDTH_UINT32:
+            return sizeof(uint32_t);
+        default:
+            return 0;
+    }
+}
+
+STATUS_CODE allocate_field_vector(FieldVector* out_vector, uint32_t length, uint32_t prime_field)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    FIELD_ELEMENT_WIDTH width = select_field_element_width(prime_field);
+    void* elements = NULL;
+
+    if ((NULL == out_vector) || (0 == length) || (0 == prime_field))
+    {
+        log_error("[!] Invalid arguments in allocate_field_vector");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    elements = calloc(length, get_field_element_size(width));
+    if (NULL == elements)
+    {
+        log_error("[!] Memory allocation failed for field vector of %u elements", length);
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    increase_metric_counter(METRIC_COUNTER_ALLOCATIONS, 1);
+    out_vector->elements = elements;
+    out_vector->length = length;
+    out_vector->width = width;
+    elements = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    free(elements);
+    return return_code;
+}
+
+void free_field_vector(FieldVector* vector)
+{
+    if (NULL == vector)
+    {
+        return;
+    }
+
+    free(vector->elements);
+    vector->elements = NULL;
+    vector->length = 0;
+}
+
+uint32_t get_field_vector_element(const FieldVector* vector, size_t index)
+{
+    return (FIELD_ELEMENT_WIDTH_UINT16 == vector->width) ?
+        ((const uint16_t*)vector->elements)[index] :
+        ((const uint32_t*)vector->elements)[index];
+}
+
+void set_field_vector_element(FieldVector* vector, size_t index, uint32_t value)
+{
+    if (FIELD_ELEMENT_WIDTH_UINT16 == vector->width)
+    {
+        ((uint16_t*)vector->elements)[index] = (uint16_t)value;
+    }
+    else
+    {
+        ((uint32_t*)vector->elements)[index] = value;
+    }
+}
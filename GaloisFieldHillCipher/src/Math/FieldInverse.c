@@ -0,0 +1,164 @@
+#include "Math/FieldInverse.h"
+
+STATUS_CODE initialize_field_context(FieldContext* out_context, uint32_t prime_field, uint64_t number_of_inversions)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint32_t* inverse_table = NULL;
+    uint32_t element = 0;
+
+    if ((NULL == out_context) || (prime_field < 2))
+    {
+        log_error("[!] Invalid arguments in initialize_field_context");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    if ((prime_field < INVERSE_TABLE_PRIME_FIELD_LIMIT) && ((number_of_inversions * INVERSE_TABLE_ENTRIES_PER_INVERSION) >= prime_field))
+    {
+        inverse_table = (uint32_t*)malloc(prime_field * sizeof(uint32_t));
+        if (NULL == inverse_table)
+        {
+            log_error("[!] Memory allocation failed for inverse table of GF(%u)", prime_field);
+            return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+            goto cleanup;
+        }
+
+        // inverse(x) = -(p / x) * inverse(p mod x), every entry only depends on a smaller one
+        inverse_table[0] = 0;
+        inverse_table[1] = 1;
+        for (element = 2; element < prime_field; ++element)
+        {
+            inverse_table[element] = (uint32_t)((uint64_t)(prime_field - (prime_field / element)) *
+                                                inverse_table[prime_field % element] % prime_field);
+        }
+        log_debug("Built inverse table for GF(%u)", prime_field);
+    }
+
+    out_context->prime_field = prime_field;
+    out_context->inverse_table = inverse_table;
+    inverse_table = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    free(inverse_table);
+    return return_code;
+}
+
+void free_field_context(FieldContext* context)
+{
+    if (NULL == context)
+    {
+        return;
+    }
+
+    free(context->inverse_table);
+    context->inverse_table = NULL;
+}
+
+uint32_t extended_euclid_inverse(uint32_t element, uint32_t prime_field)
+{
+    int64_t old_remainder = prime_field, remainder = element;
+    int64_t old_coefficient = 0, coefficient = 1;
+    int64_t quotient = 0, temp = 0;
+
+    while (0 != remainder)
+    {
+        quotient = old_remainder / remainder;
+
+        temp = old_remainder - (quotient * remainder);
+        old_remainder = remainder;
+        remainder = temp;
+
+        temp = old_coefficient - (quotient * coefficient);
+        old_coefficient = coefficient;
+        coefficient = temp;
+    }
+
+    return (uint32_t)((old_coefficient < 0) ? (old_coefficient + prime_field) : old_coefficient);
+}
+
+STATUS_CODE inverse_over_galois_field(int64_t* out_inverse, int64_t element, const FieldContext* context)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint32_t aligned_element = 0;
+
+    if ((NULL == out_inverse) || (NULL == context) || (context->prime_field < 2))
+    {
+        log_error("[!] Invalid arguments in inverse_over_galois_field");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    aligned_element = (uint32_t)(((element % context->prime_field) + context->prime_field) % context->prime_field);
+    if (0 == aligned_element)
+    {
+        log_error("[!] Zero has no inverse in GF(%u)", context->prime_field);
+        return_code = STATUS_CODE_MATRIX_NOT_INVERTIBLE;
+        goto cleanup;
+    }
+
+    *out_inverse = (NULL != context->inverse_table) ?
+        context->inverse_table[aligned_element] :
+        extended_euclid_inverse(aligned_element, context->prime_field);
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE batch_inverse_over_galois_field(int64_t* out_inverses, const int64_t* elements, uint32_t length, const FieldContext* context)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    int64_t* prefix_products = NULL;
+    uint64_t running_inverse = 0, aligned_element = 0;
+    int64_t total_inverse = 0;
+    uint32_t prime_field = 0;
+    size_t index = 0;
+
+    if ((NULL == out_inverses) || (NULL == elements) || (0 == length) || (NULL == context) || (context->prime_field < 2))
+    {
+        log_error("[!] Invalid arguments in batch_inverse_over_galois_field");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+    prime_field = context->prime_field;
+
+    prefix_products = (int64_t*)malloc(length * sizeof(int64_t));
+    if (NULL == prefix_products)
+    {
+        log_error("[!] Memory allocation failed in batch_inverse_over_galois_field");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    // prefix_products[i] = elements[0] * ... * elements[i]
+    running_inverse = 1;
+    for (index = 0; index < length; ++index)
+    {
+        aligned_element = (uint64_t)(((elements[index] % prime_field) + prime_field) % prime_field);
+        running_inverse = (running_inverse * aligned_element) % prime_field;
+        prefix_products[index] = (int64_t)running_inverse;
+    }
+
+    // A zero element makes the whole product zero, the single inversion reports it
+    return_code = inverse_over_galois_field(&total_inverse, prefix_products[length - 1], context);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    // Walk back: inverse(elements[i]) = inverse(prefix[i]) * prefix[i - 1], then strip elements[i] off the running inverse
+    running_inverse = (uint64_t)total_inverse;
+    for (index = length - 1; index > 0; --index)
+    {
+        aligned_element = (uint64_t)(((elements[index] % prime_field) + prime_field) % prime_field);
+        out_inverses[index] = (int64_t)((running_inverse * (uint64_t)prefix_products[index - 1]) % prime_field);
+        running_inverse = (running_inverse * aligned_element) % prime_field;
+    }
+    out_inverses[0] = (int64_t)running_inverse;
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free(prefix_products);
+    return return_code;
+}
@@ -127,6 +127,7 @@ STATUS_CODE matrix_determinant_over_galois_field_gauss_jordan(int64_t* out_deter
 	int64_t factor = 0;
 	int64_t product = 0;
 	size_t copy_row_index = 0, copy_column_index = 0, row_iteration = 0, free_index = 0, row = 0, column = 0;
+	FieldContext field_context = {0};
 
 	if ((NULL == matrix) || (NULL == out_determinant) || (0 == dimension) || (0 == prime_field))
     {
@@ -135,6 +136,12 @@ STATUS_CODE matrix_determinant_over_galois_field_gauss_jordan(int64_t* out_deter
     	goto cleanup;
     }
 
+	return_code = initialize_field_context(&field_context, prime_field, dimension); // One inversion per pivot
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+
     matrix_copy = (int64_t**)malloc(dimension * sizeof(int64_t*));
     if (!matrix_copy)
     {
@@ -154,7 +161,7 @@ STATUS_CODE matrix_determinant_over_galois_field_gauss_jordan(int64_t* out_deter
         }
         for (copy_column_index = 0; copy_column_index < dimension; copy_column_index++)
         {
-            matrix_copy[copy_row_index][copy_column_index] = matrix[copy_row_index][copy_column_index];
+            matrix_copy[copy_row_index][copy_column_index] = ((matrix[copy_row_index][copy_column_index] % prime_field) + prime_field) % prime_field;
         }
     }
 
@@ -190,23 +197,29 @@ STATUS_CODE matrix_determinant_over_galois_field_gauss_jordan(int64_t* out_deter
     	// Multiply the diagonal element into the determinant
         determinant = multiply_over_galois_field(determinant, matrix_copy[row_iteration][row_iteration], prime_field);
 
-        inverse_pivot = raise_power_over_galois_field(matrix_copy[row_iteration][row_iteration], prime_field - 2, prime_field);
+        return_code = inverse_over_galois_field(&inverse_pivot, matrix_copy[row_iteration][row_iteration], &field_context);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
 
         // Normalize pivot row
         for (column = row_iteration; column < dimension; column++)
         {
-            matrix_copy[row_iteration][column] = multiply_over_galois_field(matrix_copy[row_iteration][column], inverse_pivot, prime_field);
+            matrix_copy[row_iteration][column] = (int64_t)(((uint64_t)matrix_copy[row_iteration][column] * (uint64_t)inverse_pivot) % prime_field);
         }
-        // Eliminate other rows
-        for (row = 0; row < dimension; row++)
+        // Eliminate the rows below, the rows above do not change the determinant
+        for (row = row_iteration + 1; row < dimension; row++)
 		{
-            if (row != row_iteration && matrix_copy[row][row_iteration] != 0)
+            if (matrix_copy[row][row_iteration] != 0)
 			{
                 factor = matrix_copy[row][row_iteration];
                 for (column = row_iteration; column < dimension; column++)
 				{
-                    product = multiply_over_galois_field(factor, matrix_copy[row_iteration][column], prime_field);
-                    matrix_copy[row][column] = add_over_galois_field(matrix_copy[row][column], negate_over_galois_field(product, prime_field), prime_field);
+                    product = (int64_t)(((uint64_t)factor * (uint64_t)matrix_copy[row_iteration][column]) % prime_field);
+                    matrix_copy[row][column] = (matrix_copy[row][column] >= product) ?
+                        (matrix_copy[row][column] - product) :
+                        (matrix_copy[row][column] + prime_field - product);
                 }
             }
         }
@@ -224,6 +237,7 @@ cleanup:
 		}
 		free(matrix_copy);
 	}
+	free_field_context(&field_context);
 
 	return return_code;
 }
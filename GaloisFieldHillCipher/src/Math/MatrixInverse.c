@@ -145,6 +145,7 @@ STATUS_CODE inverse_square_matrix_gauss_jordan(int64_t*** out_inverse_matrix, in
 	int64_t product = 0;
 	size_t allocation_index = 0, row_iteration = 0, row = 0, column = 0, free_index = 0;
 	int64_t** out_inverse_matrix_buffer = NULL;
+	FieldContext field_context = {0};
 
     if ((NULL == matrix) || (NULL == out_inverse_matrix))
     {
@@ -153,6 +154,18 @@ STATUS_CODE inverse_square_matrix_gauss_jordan(int64_t*** out_inverse_matrix, in
     	goto cleanup;
     }
 
+	if (GF2_PRIME_FIELD == prime_field)
+	{
+		return_code = inverse_square_matrix_over_gf2(out_inverse_matrix, matrix, dimension);
+		goto cleanup;
+	}
+
+	return_code = initialize_field_context(&field_context, prime_field, dimension); // One inversion per pivot
+	if (STATUS_FAILED(return_code))
+	{
+		goto cleanup;
+	}
+
     augmented_matrix = (int64_t**)malloc(dimension * sizeof(int64_t*));
     if (!augmented_matrix)
     {
@@ -177,7 +190,7 @@ STATUS_CODE inverse_square_matrix_gauss_jordan(int64_t*** out_inverse_matrix, in
     {
         for (column = 0; column < dimension; column++)
         {
-            augmented_matrix[row][column] = matrix[row][column];
+            augmented_matrix[row][column] = ((matrix[row][column] % prime_field) + prime_field) % prime_field;
             augmented_matrix[row][column + dimension] = (row == column) ? 1 : 0;
         }
     }
@@ -211,24 +224,30 @@ STATUS_CODE inverse_square_matrix_gauss_jordan(int64_t*** out_inverse_matrix, in
             augmented_matrix[pivot_row] = temp_row;
         }
 
-    	// Normalize pivot row
+    	// Normalize pivot row, columns left of the pivot are already zero
         pivot_element = augmented_matrix[row_iteration][row_iteration];
-        pivot_inverse = raise_power_over_galois_field(pivot_element, prime_field - 2, prime_field);
+        return_code = inverse_over_galois_field(&pivot_inverse, pivot_element, &field_context);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
 
-        for (column = 0; column < 2 * dimension; column++)
-    {
-            augmented_matrix[row_iteration][column] = multiply_over_galois_field(augmented_matrix[row_iteration][column], pivot_inverse, prime_field);
+        for (column = row_iteration; column < 2 * dimension; column++)
+        {
+            augmented_matrix[row_iteration][column] = (int64_t)(((uint64_t)augmented_matrix[row_iteration][column] * (uint64_t)pivot_inverse) % prime_field);
         }
-        // Eliminate other rows
+        // Eliminate other rows, every element stays aligned to [0, prime_field)
         for (row = 0; row < dimension; row++)
         {
             if (row != row_iteration && augmented_matrix[row][row_iteration] != 0)
             {
                 factor = augmented_matrix[row][row_iteration];
-                for (column = 0; column < 2 * dimension; column++)
+                for (column = row_iteration; column < 2 * dimension; column++)
                 {
-                    product = multiply_over_galois_field(factor, augmented_matrix[row_iteration][column], prime_field);
-                    augmented_matrix[row][column] = add_over_galois_field(augmented_matrix[row][column], negate_over_galois_field(product, prime_field), prime_field);
+                    product = (int64_t)(((uint64_t)factor * (uint64_t)augmented_matrix[row_iteration][column]) % prime_field);
+                    augmented_matrix[row][column] = (augmented_matrix[row][column] >= product) ?
+                        (augmented_matrix[row][column] - product) :
+                        (augmented_matrix[row][column] + prime_field - product);
                 }
             }
         }
@@ -268,5 +287,6 @@ STATUS_CODE inverse_square_matrix_gauss_jordan(int64_t*** out_inverse_matrix, in
 cleanup:
 	(void)free_int64_matrix(augmented_matrix, dimension);
 	(void)free_int64_matrix(out_inverse_matrix_buffer, dimension);
+	free_field_context(&field_context);
     return return_code;
 }
@@ -99,3 +99,575 @@ cleanup:
     free(out_vector_buffer);
     return return_code;
 }
+
+static uint32_t calculate_accumulation_window(uint64_t maximal_product, uint32_t prime_field)
+{
+    // Number of products that can be summed on top of a reduced value without overflowing 64 bits
+    if (0 == maximal_product)
+    {
+        return UINT32_MAX;
+    }
+    uint64_t window = (UINT64_MAX - prime_field) / maximal_product;
+    return (window > UINT32_MAX) ? UINT32_MAX : (uint32_t)window;
+}
+
+static uint64_t multiply_uint16_t_row_with_uint8_t_vector(const uint16_t* matrix_row, const uint8_t* vector, uint64_t accumulator, uint32_t dimension, uint32_t accumulation_window, uint32_t prime_field)
+{
+    uint32_t terms_in_window = 0;
+    size_t column = 0;
+
+    for (column = 0; column < dimension; ++column)
+    {
+        accumulator += (uint64_t)matrix_row[column] * vector[column];
+        if (++terms_in_window == accumulation_window)
+        {
+            accumulator %= prime_field;
+            terms_in_window = 0;
+        }
+    }
+    return accumulator % prime_field;
+}
+
+static uint64_t multiply_uint32_t_row_with_uint8_t_vector(const uint32_t* matrix_row, const uint8_t* vector, uint64_t accumulator, uint32_t dimension, uint32_t accumulation_window, uint32_t prime_field)
+{
+    uint32_t terms_in_window = 0;
+    size_t column = 0;
+
+    for (column = 0; column < dimension; ++column)
+    {
+        accumulator += (uint64_t)matrix_row[column] * vector[column];
+        if (++terms_in_window == accumulation_window)
+        {
+            accumulator %= prime_field;
+            terms_in_window = 0;
+        }
+    }
+    return accumulator % prime_field;
+}
+
+static uint64_t multiply_uint16_t_row_with_uint16_t_vector(const uint16_t* matrix_row, const uint16_t* vector, uint32_t dimension, uint32_t accumulation_window, uint32_t prime_field)
+{
+    uint64_t accumulator = 0;
+    uint32_t terms_in_window = 0;
+    size_t column = 0;
+
+    for (column = 0; column < dimension; ++column)
+    {
+        accumulator += (uint64_t)matrix_row[column] * vector[column];
+        if (++terms_in_window == accumulation_window)
+        {
+            accumulator %= prime_field;
+            terms_in_window = 0;
+        }
+    }
+    return accumulator % prime_field;
+}
+
+static uint64_t multiply_uint32_t_row_with_uint32_t_vector(const uint32_t* matrix_row, const uint32_t* vector, uint32_t dimension, uint32_t accumulation_window, uint32_t prime_field)
+{
+    uint64_t accumulator = 0;
+    uint32_t terms_in_window = 0;
+    size_t column = 0;
+
+    for (column = 0; column < dimension; ++column)
+    {
+        accumulator += (uint64_t)matrix_row[column] * vector[column];
+        if (++terms_in_window == accumulation_window)
+        {
+            accumulator %= prime_field;
+            terms_in_window = 0;
+        }
+    }
+    return accumulator % prime_field;
+}
+
+// Four blocks share every load of the matrix row, each accumulator starts from a reduced offset
+static void multiply_uint16_t_row_with_four_uint8_t_vectors(uint64_t* accumulators, const uint16_t* matrix_row, const uint8_t* vectors, uint32_t dimension, uint32_t accumulation_window, uint32_t prime_field)
+{
+    const uint8_t* first = vectors;
+    const uint8_t* second = vectors + dimension;
+    const uint8_t* third = vectors + (2 * (size_t)dimension);
+    const uint8_t* fourth = vectors + (3 * (size_t)dimension);
+    uint64_t element = 0;
+    uint32_t terms_in_window = 0;
+    size_t column = 0;
+
+    for (column = 0; column < dimension; ++column)
+    {
+        element = matrix_row[column];
+        accumulators[0] += element * first[column];
+        accumulators[1] += element * second[column];
+        accumulators[2] += element * third[column];
+        accumulators[3] += element * fourth[column];
+        if (++terms_in_window == accumulation_window)
+        {
+            accumulators[0] %= prime_field;
+            accumulators[1] %= prime_field;
+            accumulators[2] %= prime_field;
+            accumulators[3] %= prime_field;
+            terms_in_window = 0;
+        }
+    }
+}
+
+static void multiply_uint32_t_row_with_four_uint8_t_vectors(uint64_t* accumulators, const uint32_t* matrix_row, const uint8_t* vectors, uint32_t dimension, uint32_t accumulation_window, uint32_t prime_field)
+{
+    const uint8_t* first = vectors;
+    const uint8_t* second = vectors + dimension;
+    const uint8_t* third = vectors + (2 * (size_t)dimension);
+    const uint8_t* fourth = vectors + (3 * (size_t)dimension);
+    uint64_t element = 0;
+    uint32_t terms_in_window = 0;
+    size_t column = 0;
+
+    for (column = 0; column < dimension; ++column)
+    {
+        element = matrix_row[column];
+        accumulators[0] += element * first[column];
+        accumulators[1] += element * second[column];
+        accumulators[2] += element * third[column];
+        accumulators[3] += element * fourth[column];
+        if (++terms_in_window == accumulation_window)
+        {
+            accumulators[0] %= prime_field;
+            accumulators[1] %= prime_field;
+            accumulators[2] %= prime_field;
+            accumulators[3] %= prime_field;
+            terms_in_window = 0;
+        }
+    }
+}
+
+static void multiply_uint16_t_row_with_four_uint16_t_vectors(uint64_t* accumulators, const uint16_t* matrix_row, const uint16_t* vectors, uint32_t dimension, uint32_t accumulation_window, uint32_t prime_field)
+{
+    const uint16_t* first = vectors;
+    const uint16_t* second = vectors + dimension;
+    const uint16_t* third = vectors + (2 * (size_t)dimension);
+    const uint16_t* fourth = vectors + (3 * (size_t)dimension);
+    uint64_t element = 0;
+    uint32_t terms_in_window = 0;
+    size_t column = 0;
+
+    for (column = 0; column < dimension; ++column)
+    {
+        element = matrix_row[column];
+        accumulators[0] += element * first[column];
+        accumulators[1] += element * second[column];
+        accumulators[2] += element * third[column];
+        accumulators[3] += element * fourth[column];
+        if (++terms_in_window == accumulation_window)
+        {
+            accumulators[0] %= prime_field;
+            accumulators[1] %= prime_field;
+            accumulators[2] %= prime_field;
+            accumulators[3] %= prime_field;
+            terms_in_window = 0;
+        }
+    }
+}
+
+static void multiply_uint32_t_row_with_four_uint32_t_vectors(uint64_t* accumulators, const uint32_t* matrix_row, const uint32_t* vectors, uint32_t dimension, uint32_t accumulation_window, uint32_t prime_field)
+{
+    const uint32_t* first = vectors;
+    const uint32_t* second = vectors + dimension;
+    const uint32_t* third = vectors + (2 * (size_t)dimension);
+    const uint32_t* fourth = vectors + (3 * (size_t)dimension);
+    uint64_t element = 0;
+    uint32_t terms_in_window = 0;
+    size_t column = 0;
+
+    for (column = 0; column < dimension; ++column)
+    {
+        element = matrix_row[column];
+        accumulators[0] += element * first[column];
+        accumulators[1] += element * second[column];
+        accumulators[2] += element * third[column];
+        accumulators[3] += element * fourth[column];
+        if (++terms_in_window == accumulation_window)
+        {
+            accumulators[0] %= prime_field;
+            accumulators[1] %= prime_field;
+            accumulators[2] %= prime_field;
+            accumulators[3] %= prime_field;
+            terms_in_window = 0;
+        }
+    }
+}
+
+STATUS_CODE multiply_flat_matrix_with_uint8_t_vector(FieldVector* out_vector, const FieldVector* flat_matrix, const uint8_t* vector, const FieldVector* offset_vector, uint32_t dimension, uint32_t prime_field)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    const SpecializedBlockKernels* specialized_kernels = NULL;
+    uint64_t offset = 0, result = 0;
+    uint32_t accumulation_window = 0;
+    size_t row = 0;
+
+    if ((NULL == out_vector) || (NULL == flat_matrix) || (NULL == vector) || (0 == prime_field) ||
+        (out_vector->length < dimension) || (flat_matrix->length < (dimension * dimension)) ||
+        (out_vector->width != flat_matrix->width) ||
+        ((NULL != offset_vector) && (offset_vector->length < dimension)))
+    {
+        log_error("[!] Invalid arguments in flat matrix-vector multiplication");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    accumulation_window = calculate_accumulation_window((uint64_t)(prime_field - 1) * UINT8_MAX, prime_field);
+
+    // Common dimensions run a fully unrolled kernel when a whole row fits the accumulation window
+    specialized_kernels = get_specialized_block_kernels(dimension);
+    if ((NULL != specialized_kernels) && can_use_specialized_kernel(dimension, accumulation_window) &&
+        ((NULL == offset_vector) || (offset_vector->width == flat_matrix->width)))
+    {
+        specialized_kernels->encrypt_kernels[flat_matrix->width](out_vector->elements, flat_matrix->elements, vector,
+                                                                 (NULL == offset_vector) ? NULL : offset_vector->elements, prime_field);
+        return_code = STATUS_CODE_SUCCESS;
+        goto cleanup;
+    }
+
+    for (row = 0; row < dimension; ++row)
+    {
+        offset = (NULL == offset_vector) ? 0 : get_field_vector_element(offset_vector, row);
+        if (FIELD_ELEMENT_WIDTH_UINT16 == flat_matrix->width)
+        {
+            result = multiply_uint16_t_row_with_uint8_t_vector((const uint16_t*)flat_matrix->elements + (row * dimension),
+                                                               vector, offset, dimension, accumulation_window, prime_field);
+            ((uint16_t*)out_vector->elements)[row] = (uint16_t)result;
+        }
+        else
+        {
+            result = multiply_uint32_t_row_with_uint8_t_vector((const uint32_t*)flat_matrix->elements + (row * dimension),
+                                                               vector, offset, dimension, accumulation_window, prime_field);
+            ((uint32_t*)out_vector->elements)[row] = (uint32_t)result;
+        }
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE multiply_flat_matrix_with_field_vector(uint8_t* out_vector, const FieldVector* flat_matrix, const FieldVector* vector, uint32_t dimension, uint32_t prime_field)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    const SpecializedBlockKernels* specialized_kernels = NULL;
+    uint64_t result = 0;
+    uint32_t accumulation_window = 0;
+    size_t row = 0;
+
+    if ((NULL == out_vector) || (NULL == flat_matrix) || (NULL == vector) || (0 == prime_field) ||
+        (vector->length < dimension) || (flat_matrix->length < (dimension * dimension)) ||
+        (vector->width != flat_matrix->width))
+    {
+        log_error("[!] Invalid arguments in flat matrix-vector multiplication (field vector)");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    accumulation_window = calculate_accumulation_window((uint64_t)(prime_field - 1) * (prime_field - 1), prime_field);
+
+    // Large fields leave a window shorter than a row, those keep the windowed loop below
+    specialized_kernels = get_specialized_block_kernels(dimension);
+    if ((NULL != specialized_kernels) && can_use_specialized_kernel(dimension, accumulation_window))
+    {
+        return_code = specialized_kernels->decrypt_kernels[flat_matrix->width](out_vector, flat_matrix->elements, vector->elements, prime_field);
+        goto cleanup;
+    }
+
+    for (row = 0; row < dimension; ++row)
+    {
+        if (FIELD_ELEMENT_WIDTH_UINT16 == flat_matrix->width)
+        {
+            result = multiply_uint16_t_row_with_uint16_t_vector((const uint16_t*)flat_matrix->elements + (row * dimension),
+                                                                (const uint16_t*)vector->elements, dimension, accumulation_window, prime_field);
+        }
+        else
+        {
+            result = multiply_uint32_t_row_with_uint32_t_vector((const uint32_t*)flat_matrix->elements + (row * dimension),
+                                                                (const uint32_t*)vector->elements, dimension, accumulation_window, prime_field);
+        }
+
+        if (result > UINT8_MAX)
+        {
+            log_error("[!] Result width too large in multiply_flat_matrix_with_field_vector: %llu > %u",
+                     (unsigned long long)result, UINT8_MAX);
+            return_code = STATUS_CODE_INVALID_RESULT_WIDTH;
+            goto cleanup;
+        }
+        out_vector[row] = (uint8_t)result;
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE multiply_flat_matrix_with_field_vector_over_field(FieldVector* out_vector, const FieldVector* flat_matrix, const FieldVector* vector, const FieldVector* offset_vector, uint32_t dimension, uint32_t prime_field)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint64_t offset = 0, result = 0;
+    uint32_t accumulation_window = 0;
+    size_t row = 0;
+
+    if ((NULL == out_vector) || (NULL == flat_matrix) || (NULL == vector) || (0 == prime_field) || (out_vector == vector) ||
+        (out_vector->length < dimension) || (vector->length < dimension) || (flat_matrix->length < (dimension * dimension)) ||
+        (out_vector->width != flat_matrix->width) || (vector->width != flat_matrix->width) ||
+        ((NULL != offset_vector) && (offset_vector->length < dimension)))
+    {
+        log_error("[!] Invalid arguments in flat matrix-vector multiplication over field");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    accumulation_window = calculate_accumulation_window((uint64_t)(prime_field - 1) * (prime_field - 1), prime_field);
+
+    for (row = 0; row < dimension; ++row)
+    {
+        offset = (NULL == offset_vector) ? 0 : get_field_vector_element(offset_vector, row);
+        if (FIELD_ELEMENT_WIDTH_UINT16 == flat_matrix->width)
+        {
+            result = multiply_uint16_t_row_with_uint16_t_vector((const uint16_t*)flat_matrix->elements + (row * dimension),
+                                                                (const uint16_t*)vector->elements, dimension, accumulation_window, prime_field);
+            ((uint16_t*)out_vector->elements)[row] = (uint16_t)((result + offset) % prime_field);
+        }
+        else
+        {
+            result = multiply_uint32_t_row_with_uint32_t_vector((const uint32_t*)flat_matrix->elements + (row * dimension),
+                                                                (const uint32_t*)vector->elements, dimension, accumulation_window, prime_field);
+            ((uint32_t*)out_vector->elements)[row] = (uint32_t)((result + offset) % prime_field);
+        }
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE multiply_square_matrices_over_field(int64_t*** out_matrix, int64_t** left_matrix, int64_t** right_matrix, uint32_t dimension, uint32_t prime_field)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    int64_t** product = NULL;
+    uint64_t left_element = 0;
+    size_t row = 0, column = 0, inner = 0;
+
+    if ((NULL == out_matrix) || (NULL == left_matrix) || (NULL == right_matrix) || (0 == dimension) || (0 == prime_field))
+    {
+        log_error("[!] Invalid arguments in multiply_square_matrices_over_field");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    product = (int64_t**)calloc(dimension, sizeof(int64_t*));
+    if (NULL == product)
+    {
+        log_error("[!] Memory allocation failed in multiply_square_matrices_over_field");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    // Row-by-row (i, k, j) order keeps both the right matrix row and the product row sequential
+    for (row = 0; row < dimension; ++row)
+    {
+        product[row] = (int64_t*)calloc(dimension, sizeof(int64_t));
+        if (NULL == product[row])
+        {
+            log_error("[!] Memory allocation failed in multiply_square_matrices_over_field");
+            return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+            goto cleanup;
+        }
+
+        for (inner = 0; inner < dimension; ++inner)
+        {
+            left_element = (uint64_t)left_matrix[row][inner];
+            if (0 == left_element)
+            {
+                continue;
+            }
+            for (column = 0; column < dimension; ++column)
+            {
+                product[row][column] = (int64_t)(((uint64_t)product[row][column] + left_element * (uint64_t)right_matrix[inner][column]) % prime_field);
+            }
+        }
+    }
+
+    *out_matrix = product;
+    product = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    if (NULL != product)
+    {
+        for (row = 0; row < dimension; ++row)
+        {
+            free(product[row]);
+        }
+        free(product);
+    }
+    return return_code;
+}
+
+STATUS_CODE multiply_flat_matrix_with_uint8_t_blocks(FieldVector* out_blocks, const FieldVector* flat_matrix, const uint8_t* blocks, uint32_t number_of_blocks, const FieldVector* offset_vector, uint32_t dimension, uint32_t prime_field, bool interleave_blocks)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint64_t accumulators[BLOCKS_PER_INTERLEAVED_PASS] = {0};
+    uint64_t offset = 0;
+    uint32_t accumulation_window = 0, interleaved_blocks = 0;
+    size_t row = 0, block = 0, lane = 0;
+
+    if ((NULL == out_blocks) || (NULL == flat_matrix) || (NULL == blocks) || (0 == prime_field) ||
+        (out_blocks->length < ((uint64_t)number_of_blocks * dimension)) || (flat_matrix->length < (dimension * dimension)) ||
+        (out_blocks->width != flat_matrix->width) ||
+        ((NULL != offset_vector) && (offset_vector->length < dimension)))
+    {
+        log_error("[!] Invalid arguments in flat matrix-blocks multiplication");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    accumulation_window = calculate_accumulation_window((uint64_t)(prime_field - 1) * UINT8_MAX, prime_field);
+    interleaved_blocks = interleave_blocks ? (number_of_blocks - (number_of_blocks % BLOCKS_PER_INTERLEAVED_PASS)) : 0;
+
+    for (row = 0; row < dimension; ++row)
+    {
+        offset = (NULL == offset_vector) ? 0 : get_field_vector_element(offset_vector, row);
+        if (FIELD_ELEMENT_WIDTH_UINT16 == flat_matrix->width)
+        {
+            const uint16_t* matrix_row = (const uint16_t*)flat_matrix->elements + (row * dimension);
+            uint16_t* out_elements = (uint16_t*)out_blocks->elements;
+
+            for (block = 0; block < interleaved_blocks; block += BLOCKS_PER_INTERLEAVED_PASS)
+            {
+                for (lane = 0; lane < BLOCKS_PER_INTERLEAVED_PASS; ++lane)
+                {
+                    accumulators[lane] = offset;
+                }
+                multiply_uint16_t_row_with_four_uint8_t_vectors(accumulators, matrix_row, blocks + (block * dimension), dimension, accumulation_window, prime_field);
+                for (lane = 0; lane < BLOCKS_PER_INTERLEAVED_PASS; ++lane)
+                {
+                    out_elements[((block + lane) * dimension) + row] = (uint16_t)(accumulators[lane] % prime_field);
+                }
+            }
+            for (; block < number_of_blocks; ++block)
+            {
+                out_elements[(block * dimension) + row] = (uint16_t)multiply_uint16_t_row_with_uint8_t_vector(matrix_row, blocks + (block * dimension),
+                                                                                                             offset, dimension, accumulation_window, prime_field);
+            }
+        }
+        else
+        {
+            const uint32_t* matrix_row = (const uint32_t*)flat_matrix->elements + (row * dimension);
+            uint32_t* out_elements = (uint32_t*)out_blocks->elements;
+
+            for (block = 0; block < interleaved_blocks; block += BLOCKS_PER_INTERLEAVED_PASS)
+            {
+                for (lane = 0; lane < BLOCKS_PER_INTERLEAVED_PASS; ++lane)
+                {
+                    accumulators[lane] = offset;
+                }
+                multiply_uint32_t_row_with_four_uint8_t_vectors(accumulators, matrix_row, blocks + (block * dimension), dimension, accumulation_window, prime_field);
+                for (lane = 0; lane < BLOCKS_PER_INTERLEAVED_PASS; ++lane)
+                {
+                    out_elements[((block + lane) * dimension) + row] = (uint32_t)(accumulators[lane] % prime_field);
+                }
+            }
+            for (; block < number_of_blocks; ++block)
+            {
+                out_elements[(block * dimension) + row] = (uint32_t)multiply_uint32_t_row_with_uint8_t_vector(matrix_row, blocks + (block * dimension),
+                                                                                                             offset, dimension, accumulation_window, prime_field);
+            }
+        }
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    return return_code;
+}
+
+static STATUS_CODE reduce_to_plaintext_byte(uint8_t* out_byte, uint64_t accumulator, uint32_t prime_field)
+{
+    uint64_t result = accumulator % prime_field;
+
+    if (result > UINT8_MAX)
+    {
+        log_error("[!] Result width too large in multiply_flat_matrix_with_field_blocks: %llu > %u",
+                 (unsigned long long)result, UINT8_MAX);
+        return STATUS_CODE_INVALID_RESULT_WIDTH;
+    }
+    *out_byte = (uint8_t)result;
+    return STATUS_CODE_SUCCESS;
+}
+
+STATUS_CODE multiply_flat_matrix_with_field_blocks(uint8_t* out_blocks, const FieldVector* flat_matrix, const FieldVector* blocks, uint32_t number_of_blocks, uint32_t dimension, uint32_t prime_field, bool interleave_blocks)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint64_t accumulators[BLOCKS_PER_INTERLEAVED_PASS] = {0};
+    uint64_t accumulator = 0;
+    uint32_t accumulation_window = 0, interleaved_blocks = 0;
+    size_t row = 0, block = 0, lane = 0;
+
+    if ((NULL == out_blocks) || (NULL == flat_matrix) || (NULL == blocks) || (0 == prime_field) ||
+        (blocks->length < ((uint64_t)number_of_blocks * dimension)) || (flat_matrix->length < (dimension * dimension)) ||
+        (blocks->width != flat_matrix->width))
+    {
+        log_error("[!] Invalid arguments in flat matrix-blocks multiplication (field blocks)");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    accumulation_window = calculate_accumulation_window((uint64_t)(prime_field - 1) * (prime_field - 1), prime_field);
+    interleaved_blocks = interleave_blocks ? (number_of_blocks - (number_of_blocks % BLOCKS_PER_INTERLEAVED_PASS)) : 0;
+
+    for (row = 0; row < dimension; ++row)
+    {
+        for (block = 0; block < interleaved_blocks; block += BLOCKS_PER_INTERLEAVED_PASS)
+        {
+            memset(accumulators, 0, sizeof(accumulators));
+            if (FIELD_ELEMENT_WIDTH_UINT16 == flat_matrix->width)
+            {
+                multiply_uint16_t_row_with_four_uint16_t_vectors(accumulators, (const uint16_t*)flat_matrix->elements + (row * dimension),
+                                                                 (const uint16_t*)blocks->elements + (block * dimension), dimension, accumulation_window, prime_field);
+            }
+            else
+            {
+                multiply_uint32_t_row_with_four_uint32_t_vectors(accumulators, (const uint32_t*)flat_matrix->elements + (row * dimension),
+                                                                 (const uint32_t*)blocks->elements + (block * dimension), dimension, accumulation_window, prime_field);
+            }
+            for (lane = 0; lane < BLOCKS_PER_INTERLEAVED_PASS; ++lane)
+            {
+                return_code = reduce_to_plaintext_byte(&out_blocks[((block + lane) * dimension) + row], accumulators[lane], prime_field);
+                if (STATUS_FAILED(return_code))
+                {
+                    goto cleanup;
+                }
+            }
+        }
+
+        for (; block < number_of_blocks; ++block)
+        {
+            if (FIELD_ELEMENT_WIDTH_UINT16 == flat_matrix->width)
+            {
+                accumulator = multiply_uint16_t_row_with_uint16_t_vector((const uint16_t*)flat_matrix->elements + (row * dimension),
+                                                                         (const uint16_t*)blocks->elements + (block * dimension), dimension, accumulation_window, prime_field);
+            }
+            else
+            {
+                accumulator = multiply_uint32_t_row_with_uint32_t_vector((const uint32_t*)flat_matrix->elements + (row * dimension),
+                                                                         (const uint32_t*)blocks->elements + (block * dimension), dimension, accumulation_window, prime_field);
+            }
+            return_code = reduce_to_plaintext_byte(&out_blocks[(block * dimension) + row], accumulator, prime_field);
+            if (STATUS_FAILED(return_code))
+            {
+                goto cleanup;
+            }
+        }
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    return return_code;
+}
@@ -199,6 +199,323 @@ cleanup:
     return return_code;
 }
 
+STATUS_CODE allocate_int64_matrix(int64_t*** out_matrix, uint32_t rows, uint32_t columns)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    int64_t** matrix = NULL;
+    size_t row = 0;
+
+    if (!out_matrix || (0 == rows) || (0 == columns))
+    {
+        log_error("[!] Invalid arguments in allocate_int64_matrix");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    matrix = (int64_t**)calloc(rows, sizeof(int64_t*));
+    if (!matrix)
+    {
+        log_error("[!] Memory allocation failed for matrix rows");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    for (row = 0; row < rows; ++row)
+    {
+        matrix[row] = (int64_t*)calloc(columns, sizeof(int64_t));
+        if (!matrix[row])
+        {
+            log_error("[!] Memory allocation failed for matrix row %zu", row);
+            return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+            goto cleanup;
+        }
+    }
+    increase_metric_counter(METRIC_COUNTER_ALLOCATIONS, (uint64_t)rows + 1);
+
+    *out_matrix = matrix;
+    matrix = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    if (matrix)
+    {
+        (void)free_int64_matrix(matrix, rows);
+    }
+    return return_code;
+}
+
+// A sum of products over the field that is only reduced every window terms, the products of aligned elements are summed in 64 bits
+struct WindowedSum {
+    uint64_t sum;
+    uint64_t terms;
+    uint64_t window;
+    uint32_t prime_field;
+} typedef WindowedSum;
+
+static void start_windowed_sum(WindowedSum* windowed_sum, int64_t initial_value, uint32_t prime_field)
+{
+    windowed_sum->sum = (uint64_t)initial_value;
+    windowed_sum->terms = 0;
+    windowed_sum->window = (UINT64_MAX - prime_field) / ((uint64_t)(prime_field - 1) * (prime_field - 1));
+    windowed_sum->prime_field = prime_field;
+}
+
+static void add_product_to_windowed_sum(WindowedSum* windowed_sum, int64_t first_element, int64_t second_element)
+{
+    // Both elements are aligned to [0, prime_field)
+    windowed_sum->sum += (uint64_t)first_element * (uint64_t)second_element;
+    if (++windowed_sum->terms == windowed_sum->window)
+    {
+        windowed_sum->sum %= windowed_sum->prime_field;
+        windowed_sum->terms = 0;
+    }
+}
+
+static int64_t reduce_windowed_sum(const WindowedSum* windowed_sum)
+{
+    return (int64_t)(windowed_sum->sum % windowed_sum->prime_field);
+}
+
+// The field helpers log every call, which dominates the O(n^3) loops below
+static int64_t reduce_negated_windowed_sum(const WindowedSum* windowed_sum, int64_t factor)
+{
+    uint64_t negated = (windowed_sum->prime_field - (windowed_sum->sum % windowed_sum->prime_field)) % windowed_sum->prime_field;
+    return (int64_t)((negated * (uint64_t)factor) % windowed_sum->prime_field);
+}
+
+STATUS_CODE generate_invertible_matrix_over_field(int64_t*** out_matrix, int64_t*** out_inverse_matrix, uint32_t dimension, uint32_t prime_field)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    int64_t** factors = NULL;
+    int64_t** inverse_factors = NULL;
+    int64_t** matrix = NULL;
+    int64_t** inverse_matrix = NULL;
+    uint32_t* row_permutation = NULL;
+    uint32_t random_number = 0, swapped_row = 0;
+    int64_t** permuted_rows = NULL;
+    int64_t* diagonal_inverses = NULL;
+    uint64_t* row_sums = NULL;
+    FieldContext field_context = {0};
+    int64_t diagonal_inverse = 0;
+    WindowedSum windowed_sum;
+    size_t row = 0, column = 0, permuted_column = 0, k = 0;
+
+    if (!out_matrix || (0 == dimension) || (prime_field < 2))
+    {
+        log_error("[!] Invalid arguments in generate_invertible_matrix_over_field");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    log_debug("Generating invertible %ux%u matrix over GF(%u) from random LU factors", dimension, dimension, prime_field);
+
+    // L and U share one matrix: L below the diagonal (with an implicit unit diagonal), U on and above it
+    return_code = allocate_int64_matrix(&factors, dimension, dimension);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    return_code = allocate_int64_matrix(&inverse_factors, dimension, dimension);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    return_code = allocate_int64_matrix(&matrix, dimension, dimension);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    row_permutation = (uint32_t*)malloc(dimension * sizeof(uint32_t));
+    permuted_rows = (int64_t**)malloc(dimension * sizeof(int64_t*));
+    row_sums = (uint64_t*)malloc(dimension * sizeof(uint64_t));
+    if (!row_permutation || !permuted_rows || !row_sums)
+    {
+        log_error("[!] Memory allocation failed for row permutation");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    for (row = 0; row < dimension; ++row)
+    {
+        for (column = 0; column < dimension; ++column)
+        {
+            // The diagonal of U must be non-zero for the product to be invertible
+            return_code = generate_secure_random_number(&random_number, (row == column) ? 1 : 0, prime_field);
+            if (STATUS_FAILED(return_code))
+            {
+                log_error("[!] Failed to generate random number for LU factor[%zu][%zu]", row, column);
+                goto cleanup;
+            }
+            factors[row][column] = random_number;
+        }
+    }
+
+    // Secure Fisher-Yates shuffle of the rows
+    for (row = 0; row < dimension; ++row)
+    {
+        row_permutation[row] = (uint32_t)row;
+    }
+    for (row = dimension - 1; row > 0; --row)
+    {
+        return_code = generate_secure_random_number(&swapped_row, 0, (uint32_t)row + 1);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+        random_number = row_permutation[row];
+        row_permutation[row] = row_permutation[swapped_row];
+        row_permutation[swapped_row] = random_number;
+    }
+
+    // matrix = P * L * U, only the non-zero triangles take part in the sum
+    // Each row is accumulated row-major: L[row][k] scales row k of U, every column gets one term per k so the window is shared
+    start_windowed_sum(&windowed_sum, 0, prime_field);
+    for (row = 0; row < dimension; ++row)
+    {
+        for (column = 0; column < dimension; ++column)
+        {
+            row_sums[column] = (row <= column) ? (uint64_t)factors[row][column] : 0;
+        }
+        for (k = 0, windowed_sum.terms = 0; k < row; ++k)
+        {
+            for (column = k; column < dimension; ++column)
+            {
+                row_sums[column] += (uint64_t)factors[row][k] * (uint64_t)factors[k][column];
+            }
+            if (++windowed_sum.terms == windowed_sum.window)
+            {
+                for (column = 0; column < dimension; ++column)
+                {
+                    row_sums[column] %= prime_field;
+                }
+                windowed_sum.terms = 0;
+            }
+        }
+        for (column = 0; column < dimension; ++column)
+        {
+            matrix[row][column] = (int64_t)(row_sums[column] % prime_field);
+        }
+    }
+    for (row = 0; row < dimension; ++row)
+    {
+        permuted_rows[row] = matrix[row_permutation[row]];
+    }
+    memcpy(matrix, permuted_rows, dimension * sizeof(int64_t*));
+
+    if (NULL != out_inverse_matrix)
+    {
+        return_code = initialize_field_context(&field_context, prime_field, 1); // The diagonal shares a single batch inversion
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+
+        diagonal_inverses = (int64_t*)malloc(dimension * sizeof(int64_t));
+        if (!diagonal_inverses)
+        {
+            log_error("[!] Memory allocation failed for diagonal inverses");
+            return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+            goto cleanup;
+        }
+
+        // L^-1 below the diagonal by forward substitution
+        for (column = 0; column < dimension; ++column)
+        {
+            for (row = column + 1; row < dimension; ++row)
+            {
+                start_windowed_sum(&windowed_sum, factors[row][column], prime_field);
+                for (k = column + 1; k < row; ++k)
+                {
+                    add_product_to_windowed_sum(&windowed_sum, factors[row][k], inverse_factors[k][column]);
+                }
+                inverse_factors[row][column] = reduce_negated_windowed_sum(&windowed_sum, 1);
+            }
+        }
+
+        // U^-1 on and above the diagonal by back substitution, all diagonal inverses come from a single batch inversion
+        for (column = 0; column < dimension; ++column)
+        {
+            diagonal_inverses[column] = factors[column][column];
+        }
+        return_code = batch_inverse_over_galois_field(diagonal_inverses, diagonal_inverses, dimension, &field_context);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+
+        for (column = 0; column < dimension; ++column)
+        {
+            diagonal_inverse = diagonal_inverses[column];
+            inverse_factors[column][column] = diagonal_inverse;
+            for (row = column; row > 0; --row)
+            {
+                start_windowed_sum(&windowed_sum, 0, prime_field);
+                for (k = row - 1; k < column; ++k)
+                {
+                    add_product_to_windowed_sum(&windowed_sum, inverse_factors[row - 1][k], factors[k][column]);
+                }
+                inverse_factors[row - 1][column] = reduce_negated_windowed_sum(&windowed_sum, diagonal_inverse);
+            }
+        }
+
+        return_code = allocate_int64_matrix(&inverse_matrix, dimension, dimension);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+
+        // inverse = U^-1 * L^-1 * P^-1, so inverse[i][j] = (U^-1 * L^-1)[i][permutation[j]]
+        // (U^-1 * L^-1)[i][c] sums over k >= max(i, c), the unit diagonal of L^-1 is implicit
+        for (row = 0; row < dimension; ++row)
+        {
+            for (column = 0; column < dimension; ++column)
+            {
+                permuted_column = row_permutation[column];
+                start_windowed_sum(&windowed_sum, (row <= permuted_column) ? inverse_factors[row][permuted_column] : 0, prime_field);
+                for (k = ((row > permuted_column) ? row : permuted_column + 1); k < dimension; ++k)
+                {
+                    add_product_to_windowed_sum(&windowed_sum, inverse_factors[row][k], inverse_factors[k][permuted_column]);
+                }
+                inverse_matrix[row][column] = reduce_windowed_sum(&windowed_sum);
+            }
+        }
+    }
+
+    *out_matrix = matrix;
+    matrix = NULL;
+    if (NULL != out_inverse_matrix)
+    {
+        *out_inverse_matrix = inverse_matrix;
+        inverse_matrix = NULL;
+    }
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    if (factors)
+    {
+        (void)free_int64_matrix(factors, dimension);
+    }
+    if (inverse_factors)
+    {
+        (void)free_int64_matrix(inverse_factors, dimension);
+    }
+    if (matrix)
+    {
+        (void)free_int64_matrix(matrix, dimension);
+    }
+    if (inverse_matrix)
+    {
+        (void)free_int64_matrix(inverse_matrix, dimension);
+    }
+    free(row_permutation);
+    free(permuted_rows);
+    free(row_sums);
+    free(diagonal_inverses);
+    free_field_context(&field_context);
+    return return_code;
+}
+
 STATUS_CODE build_minor_matrix(int64_t*** out_minor_matrix, int64_t** matrix, uint32_t dimension, uint32_t row_to_exclude, size_t column_to_exclude)
 {
     STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
@@ -268,3 +585,41 @@ cleanup:
     }
     return return_code;
 }
+
+STATUS_CODE flatten_square_matrix_over_field(FieldVector* out_flat_matrix, int64_t** matrix, uint32_t dimension, uint32_t prime_field)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    FieldVector flat_matrix = {0};
+    size_t row = 0, column = 0;
+
+    if (!out_flat_matrix || !matrix || (0 == dimension) || (0 == prime_field) || (dimension > (UINT32_MAX / dimension)))
+    {
+        log_error("[!] Invalid arguments in flatten_square_matrix_over_field");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    return_code = allocate_field_vector(&flat_matrix, dimension * dimension, prime_field);
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("[!] Memory allocation failed for flat matrix");
+        goto cleanup;
+    }
+
+    for (row = 0; row < dimension; ++row)
+    {
+        for (column = 0; column < dimension; ++column)
+        {
+            set_field_vector_element(&flat_matrix, (row * dimension) + column,
+                (uint32_t)(((matrix[row][column] % prime_field) + prime_field) % prime_field));
+        }
+    }
+
+    *out_flat_matrix = flat_matrix;
+    flat_matrix.elements = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    free_field_vector(&flat_matrix);
+    return return_code;
+}
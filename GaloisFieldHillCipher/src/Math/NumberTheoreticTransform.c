@@ -0,0 +1,195 @@
+#include "Math/NumberTheoreticTransform.h"
+
+bool is_ntt_compatible(uint32_t length, uint32_t prime_field)
+{
+    return (0 != length) && (0 == (length & (length - 1))) && (prime_field > 2) && (0 == ((prime_field - 1) % length));
+}
+
+uint32_t power_over_galois_field(uint32_t base, uint64_t exponent, uint32_t prime_field)
+{
+    uint64_t result = 1 % prime_field, square = base % prime_field;
+
+    while (0 != exponent)
+    {
+        if (exponent & 1)
+        {
+            result = (result * square) % prime_field;
+        }
+        square = (square * square) % prime_field;
+        exponent >>= 1;
+    }
+    return (uint32_t)result;
+}
+
+/**
+ * @brief Finds a generator of the multiplicative group of GF(prime_field).
+ *        A candidate generates the group when candidate^((p - 1) / q) != 1 for every prime factor q of p - 1.
+ *
+ * @param prime_field - The prime field.
+ * @return The smallest generator.
+ */
+static uint32_t find_multiplicative_generator(uint32_t prime_field)
+{
+    uint32_t factors[32] = {0};
+    uint32_t number_of_factors = 0, index = 0, candidate = 0;
+    uint32_t remainder = prime_field - 1, divisor = 2;
+    bool is_generator = false;
+
+    // p - 1 < 2^32 has fewer than 32 distinct prime factors, trial division stops at sqrt(p - 1) < 2^16
+    for (divisor = 2; (uint64_t)divisor * divisor <= remainder; ++divisor)
+    {
+        if (0 == (remainder % divisor))
+        {
+            factors[number_of_factors++] = divisor;
+            while (0 == (remainder % divisor))
+            {
+                remainder /= divisor;
+            }
+        }
+    }
+    if (remainder > 1)
+    {
+        factors[number_of_factors++] = remainder;
+    }
+
+    for (candidate = 2; candidate < prime_field; ++candidate)
+    {
+        is_generator = true;
+        for (index = 0; (index < number_of_factors) && is_generator; ++index)
+        {
+            is_generator = (1 != power_over_galois_field(candidate, (prime_field - 1) / factors[index], prime_field));
+        }
+        if (is_generator)
+        {
+            break;
+        }
+    }
+    return candidate;
+}
+
+STATUS_CODE initialize_ntt_context(NttContext* out_context, uint32_t length, uint32_t prime_field)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint32_t* roots = NULL;
+    uint32_t* inverse_roots = NULL;
+    uint32_t root = 0, inverse_root = 0, index = 0;
+    uint32_t half_length = 0;
+
+    if ((NULL == out_context) || !is_ntt_compatible(length, prime_field))
+    {
+        log_error("[!] Invalid arguments in initialize_ntt_context: no transform of length %u over GF(%u)", length, prime_field);
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    half_length = (length > 1) ? (length / 2) : 1;
+    roots = (uint32_t*)malloc(half_length * sizeof(uint32_t));
+    inverse_roots = (uint32_t*)malloc(half_length * sizeof(uint32_t));
+    if ((NULL == roots) || (NULL == inverse_roots))
+    {
+        log_error("[!] Memory allocation failed for NTT twiddle tables");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    root = power_over_galois_field(find_multiplicative_generator(prime_field), (prime_field - 1) / length, prime_field);
+    inverse_root = power_over_galois_field(root, prime_field - 2, prime_field);
+    roots[0] = 1;
+    inverse_roots[0] = 1;
+    for (index = 1; index < half_length; ++index)
+    {
+        roots[index] = (uint32_t)(((uint64_t)roots[index - 1] * root) % prime_field);
+        inverse_roots[index] = (uint32_t)(((uint64_t)inverse_roots[index - 1] * inverse_root) % prime_field);
+    }
+    log_debug("Built NTT of length %u over GF(%u), root %u", length, prime_field, root);
+
+    out_context->prime_field = prime_field;
+    out_context->length = length;
+    out_context->inverse_length = power_over_galois_field(length % prime_field, prime_field - 2, prime_field);
+    out_context->roots = roots;
+    out_context->inverse_roots = inverse_roots;
+    roots = NULL;
+    inverse_roots = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    free(roots);
+    free(inverse_roots);
+    return return_code;
+}
+
+void free_ntt_context(NttContext* context)
+{
+    if (NULL == context)
+    {
+        return;
+    }
+
+    free(context->roots);
+    free(context->inverse_roots);
+    context->roots = NULL;
+    context->inverse_roots = NULL;
+}
+
+/**
+ * @brief Iterative radix-2 Cooley-Tukey transform: bit-reversal permutation, then log2(length) butterfly passes.
+ *
+ * @param values - The values to transform in place.
+ * @param length - The transform length.
+ * @param prime_field - The prime field.
+ * @param roots - The twiddle table, roots[i] = w^i for i < length / 2.
+ */
+static void transform(uint32_t* values, uint32_t length, uint32_t prime_field, const uint32_t* roots)
+{
+    uint32_t index = 0, reversed = 0, bit = 0, temp = 0;
+    uint32_t span = 0, start = 0, offset = 0, stride = 0;
+    uint32_t even = 0, odd = 0;
+    uint64_t sum = 0;
+
+    for (index = 1; index < length; ++index)
+    {
+        for (bit = length >> 1; reversed & bit; bit >>= 1)
+        {
+            reversed ^= bit;
+        }
+        reversed |= bit;
+        if (index < reversed)
+        {
+            temp = values[index];
+            values[index] = values[reversed];
+            values[reversed] = temp;
+        }
+    }
+
+    for (span = 1; span < length; span <<= 1)
+    {
+        stride = length / (span << 1);
+        for (start = 0; start < length; start += span << 1)
+        {
+            for (offset = 0; offset < span; ++offset)
+            {
+                even = values[start + offset];
+                odd = (uint32_t)(((uint64_t)values[start + offset + span] * roots[offset * stride]) % prime_field);
+                sum = (uint64_t)even + odd;
+                values[start + offset] = (uint32_t)((sum >= prime_field) ? (sum - prime_field) : sum);
+                values[start + offset + span] = (even >= odd) ? (even - odd) : (even + prime_field - odd);
+            }
+        }
+    }
+}
+
+void ntt_forward(uint32_t* values, const NttContext* context)
+{
+    transform(values, context->length, context->prime_field, context->roots);
+}
+
+void ntt_inverse(uint32_t* values, const NttContext* context)
+{
+    uint32_t index = 0;
+
+    transform(values, context->length, context->prime_field, context->inverse_roots);
+    for (index = 0; index < context->length; ++index)
+    {
+        values[index] = (uint32_t)(((uint64_t)values[index] * context->inverse_length) % context->prime_field);
+    }
+}
@@ -0,0 +1,146 @@
+#include "Math/SpecializedKernels.h"
+
+static STATUS_CODE store_plaintext_byte(uint8_t* out_byte, uint64_t accumulator, uint32_t prime_field)
+{
+    uint64_t result = accumulator % prime_field;
+
+    if (result > UINT8_MAX)
+    {
+        log_error("[!] Result width too large in specialized decryption kernel: %llu > %u", (unsigned long long)result, UINT8_MAX);
+        return STATUS_CODE_INVALID_RESULT_WIDTH;
+    }
+    *out_byte = (uint8_t)result;
+    return STATUS_CODE_SUCCESS;
+}
+
+/*
+ * Kernel templates, instantiated for every dimension in SPECIALIZED_KERNEL_DIMENSIONS and both element widths.
+ * Rows are register blocked four at a time so every block element is loaded once for four products,
+ * the remaining rows of a dimension that isn't a multiple of four run one at a time.
+ */
+#define DEFINE_SPECIALIZED_ENCRYPT_KERNEL(DIMENSION, ELEMENT_TYPE)                                                          \
+static void encrypt_block_##DIMENSION##_##ELEMENT_TYPE(void* out_block, const void* flat_matrix, const uint8_t* block,      \
+                                                       const void* offset_vector, uint32_t prime_field)                     \
+{                                                                                                                           \
+    const ELEMENT_TYPE* matrix = (const ELEMENT_TYPE*)flat_matrix;                                                          \
+    const ELEMENT_TYPE* offset = (const ELEMENT_TYPE*)offset_vector;                                                        \
+    ELEMENT_TYPE* out = (ELEMENT_TYPE*)out_block;                                                                           \
+    uint64_t first = 0, second = 0, third = 0, fourth = 0, element = 0;                                                     \
+    size_t row = 0, column = 0;                                                                                             \
+                                                                                                                            \
+    for (row = 0; (row + SPECIALIZED_KERNEL_ROWS_PER_PASS) <= (DIMENSION); row += SPECIALIZED_KERNEL_ROWS_PER_PASS)         \
+    {                                                                                                                       \
+        first = (NULL == offset) ? 0 : offset[row];                                                                         \
+        second = (NULL == offset) ? 0 : offset[row + 1];                                                                    \
+        third = (NULL == offset) ? 0 : offset[row + 2];                                                                     \
+        fourth = (NULL == offset) ? 0 : offset[row + 3];                                                                    \
+        UNROLL_FULLY                                                                                                        \
+        for (column = 0; column < (DIMENSION); ++column)                                                                    \
+        {                                                                                                                   \
+            element = block[column];                                                                                        \
+            first += (uint64_t)matrix[(row * (DIMENSION)) + column] * element;                                              \
+            second += (uint64_t)matrix[((row + 1) * (DIMENSION)) + column] * element;                                       \
+            third += (uint64_t)matrix[((row + 2) * (DIMENSION)) + column] * element;                                        \
+            fourth += (uint64_t)matrix[((row + 3) * (DIMENSION)) + column] * element;                                       \
+        }                                                                                                                   \
+        out[row] = (ELEMENT_TYPE)(first % prime_field);                                                                     \
+        out[row + 1] = (ELEMENT_TYPE)(second % prime_field);                                                                \
+        out[row + 2] = (ELEMENT_TYPE)(third % prime_field);                                                                 \
+        out[row + 3] = (ELEMENT_TYPE)(fourth % prime_field);                                                                \
+    }                                                                                                                       \
+    for (row = (DIMENSION) - ((DIMENSION) % SPECIALIZED_KERNEL_ROWS_PER_PASS); row < (DIMENSION); ++row)                    \
+    {                                                                                                                       \
+        first = (NULL == offset) ? 0 : offset[row];                                                                         \
+        UNROLL_FULLY                                                                                                        \
+        for (column = 0; column < (DIMENSION); ++column)                                                                    \
+        {                                                                                                                   \
+            first += (uint64_t)matrix[(row * (DIMENSION)) + column] * block[column];                                        \
+        }                                                                                                                   \
+        out[row] = (ELEMENT_TYPE)(first % prime_field);                                                                     \
+    }                                                                                                                       \
+}
+
+#define DEFINE_SPECIALIZED_DECRYPT_KERNEL(DIMENSION, ELEMENT_TYPE)                                                          \
+static STATUS_CODE decrypt_block_##DIMENSION##_##ELEMENT_TYPE(uint8_t* out_block, const void* flat_matrix,                  \
+                                                              const void* block_elements, uint32_t prime_field)             \
+{                                                                                                                           \
+    const ELEMENT_TYPE* matrix = (const ELEMENT_TYPE*)flat_matrix;                                                          \
+    const ELEMENT_TYPE* block = (const ELEMENT_TYPE*)block_elements;                                                        \
+    uint64_t first = 0, second = 0, third = 0, fourth = 0, element = 0;                                                     \
+    size_t row = 0, column = 0;                                                                                             \
+                                                                                                                            \
+    for (row = 0; (row + SPECIALIZED_KERNEL_ROWS_PER_PASS) <= (DIMENSION); row += SPECIALIZED_KERNEL_ROWS_PER_PASS)         \
+    {                                                                                                                       \
+        first = second = third = fourth = 0;                                                                                \
+        UNROLL_FULLY                                                                                                        \
+        for (column = 0; column < (DIMENSION); ++column)                                                                    \
+        {                                                                                                                   \
+            element = block[column];                                                                                        \
+            first += (uint64_t)matrix[(row * (DIMENSION)) + column] * element;                                              \
+            second += (uint64_t)matrix[((row + 1) * (DIMENSION)) + column] * element;                                       \
+            third += (uint64_t)matrix[((row + 2) * (DIMENSION)) + column] * element;                                        \
+            fourth += (uint64_t)matrix[((row + 3) * (DIMENSION)) + column] * element;                                       \
+        }                                                                                                                   \
+        if (STATUS_FAILED(store_plaintext_byte(&out_block[row], first, prime_field)) ||                                     \
+            STATUS_FAILED(store_plaintext_byte(&out_block[row + 1], second, prime_field)) ||                                \
+            STATUS_FAILED(store_plaintext_byte(&out_block[row + 2], third, prime_field)) ||                                 \
+            STATUS_FAILED(store_plaintext_byte(&out_block[row + 3], fourth, prime_field)))                                  \
+        {                                                                                                                   \
+            return STATUS_CODE_INVALID_RESULT_WIDTH;                                                                        \
+        }                                                                                                                   \
+    }                                                                                                                       \
+    for (row = (DIMENSION) - ((DIMENSION) % SPECIALIZED_KERNEL_ROWS_PER_PASS); row < (DIMENSION); ++row)                    \
+    {                                                                                                                       \
+        first = 0;                                                                                                          \
+        UNROLL_FULLY                                                                                                        \
+        for (column = 0; column < (DIMENSION); ++column)                                                                    \
+        {                                                                                                                   \
+            first += (uint64_t)matrix[(row * (DIMENSION)) + column] * block[column];                                        \
+        }                                                                                                                   \
+        if (STATUS_FAILED(store_plaintext_byte(&out_block[row], first, prime_field)))                                       \
+        {                                                                                                                   \
+            return STATUS_CODE_INVALID_RESULT_WIDTH;                                                                        \
+        }                                                                                                                   \
+    }                                                                                                                       \
+    return STATUS_CODE_SUCCESS;                                                                                             \
+}
+
+#define DEFINE_SPECIALIZED_KERNELS(DIMENSION)                  \
+    DEFINE_SPECIALIZED_ENCRYPT_KERNEL(DIMENSION, uint16_t)     \
+    DEFINE_SPECIALIZED_ENCRYPT_KERNEL(DIMENSION, uint32_t)     \
+    DEFINE_SPECIALIZED_DECRYPT_KERNEL(DIMENSION, uint16_t)     \
+    DEFINE_SPECIALIZED_DECRYPT_KERNEL(DIMENSION, uint32_t)
+
+#define SPECIALIZED_KERNELS_TABLE_ENTRY(DIMENSION)                                        \
+    {                                                                                     \
+        (DIMENSION),                                                                      \
+        {encrypt_block_##DIMENSION##_uint16_t, encrypt_block_##DIMENSION##_uint32_t},     \
+        {decrypt_block_##DIMENSION##_uint16_t, decrypt_block_##DIMENSION##_uint32_t}      \
+    },
+
+SPECIALIZED_KERNEL_DIMENSIONS(DEFINE_SPECIALIZED_KERNELS)
+
+// Dispatch table keyed on the dimension, the zero entry ends it and keeps it valid for an empty dimension list
+static const SpecializedBlockKernels g_specialized_block_kernels[] = {
+    SPECIALIZED_KERNEL_DIMENSIONS(SPECIALIZED_KERNELS_TABLE_ENTRY)
+    {0, {NULL, NULL}, {NULL, NULL}}
+};
+
+const SpecializedBlockKernels* get_specialized_block_kernels(uint32_t dimension)
+{
+    size_t index = 0;
+
+    for (index = 0; 0 != g_specialized_block_kernels[index].dimension; ++index)
+    {
+        if (dimension == g_specialized_block_kernels[index].dimension)
+        {
+            return &g_specialized_block_kernels[index];
+        }
+    }
+    return NULL;
+}
+
+bool can_use_specialized_kernel(uint32_t dimension, uint32_t accumulation_window)
+{
+    return (0 != dimension) && (accumulation_window >= dimension);
+}
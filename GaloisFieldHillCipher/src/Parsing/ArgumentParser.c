@@ -146,16 +146,31 @@ STATUS_CODE parse_mode(OPERATION_MODE* out_mode, int argc, char** argv)
     {
         mode = GENERATE_AND_DECRYPT_MODE;
     }
+    else if (strcmp(mode_string, MODE_REKEY) == 0)
+    {
+        mode = REKEY_MODE;
+    }
+    else if (strcmp(mode_string, MODE_BATCH) == 0)
+    {
+        mode = BATCH_MODE;
+    }
+    else if (strcmp(mode_string, MODE_SHARD) == 0)
+    {
+        mode = SHARD_MODE;
+    }
     else
     {
-        log_error("[!] Invalid mode specified: %s. Available modes: %s, %s, %s, %s, %s, %s.",
+        log_error("[!] Invalid mode specified: %s. Available modes: %s, %s, %s, %s, %s, %s, %s, %s, %s.",
                   mode_string,
                   MODE_KEY_GENERATION,
                   MODE_DECRYPTION_KEY_GENERATION,
                   MODE_ENCRYPT,
                   MODE_DECRYPT,
                   MODE_GENERATE_AND_ENCRYPT,
-                  MODE_GENERATE_AND_DECRYPT);
+                  MODE_GENERATE_AND_DECRYPT,
+                  MODE_REKEY,
+                  MODE_BATCH,
+                  MODE_SHARD);
         return_code = STATUS_CODE_INVALID_ARGUMENT;
         goto cleanup;
     }
@@ -170,12 +185,18 @@ STATUS_CODE parse_global_arguments(GlobalArguments** out_arguments, int argc, ch
 {
     STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
     bool verbose = false;
+    int stats = 0; // argparse stores booleans as int
     const char* log_file = NULL;
+    const char* metrics_file = NULL;
+    const char* tuning_cache_file = NULL;
     GlobalArguments* parsed_arguments = NULL;
 
     struct argparse_option options[] = {
         OPT_BOOLEAN(*FLAG_VERBOSE_SHORT, FLAG_VERBOSE, &verbose, FLAG_VERBOSE_DESCRIPTION),
         OPT_STRING(*FLAG_LOG_FILE_SHORT, FLAG_LOG_FILE, &log_file, FLAG_LOG_FILE_DESCRIPTION),
+        OPT_BOOLEAN(*FLAG_STATS_SHORT, FLAG_STATS, &stats, FLAG_STATS_DESCRIPTION),
+        OPT_STRING(*FLAG_METRICS_FILE_SHORT, FLAG_METRICS_FILE, &metrics_file, FLAG_METRICS_FILE_DESCRIPTION),
+        OPT_STRING(*FLAG_TUNING_CACHE_FILE_SHORT, FLAG_TUNING_CACHE_FILE, &tuning_cache_file, FLAG_TUNING_CACHE_FILE_DESCRIPTION),
         OPT_END()
     };
 
@@ -211,6 +232,9 @@ STATUS_CODE parse_global_arguments(GlobalArguments** out_arguments, int argc, ch
 
     parsed_arguments->verbose = verbose;
     parsed_arguments->log_file = log_file;
+    parsed_arguments->stats = (0 != stats);
+    parsed_arguments->metrics_file = metrics_file;
+    parsed_arguments->tuning_cache_file = tuning_cache_file;
 
     *out_arguments = parsed_arguments;
     parsed_arguments = NULL;
@@ -269,6 +293,24 @@ STATUS_CODE parse_mode_arguments(void** out_mode_arguments, OPERATION_MODE mode,
             *out_mode_arguments = (void*)gen_decrypt_args;
             break;
 
+        case REKEY_MODE:
+            RekeyArguments* rekey_args = NULL;
+            return_code = parse_rekey_arguments(&rekey_args, argc, argv);
+            *out_mode_arguments = (void*)rekey_args;
+            break;
+
+        case BATCH_MODE:
+            BatchArguments* batch_args = NULL;
+            return_code = parse_batch_arguments(&batch_args, argc, argv);
+            *out_mode_arguments = (void*)batch_args;
+            break;
+
+        case SHARD_MODE:
+            ShardArguments* shard_args = NULL;
+            return_code = parse_shard_arguments(&shard_args, argc, argv);
+            *out_mode_arguments = (void*)shard_args;
+            break;
+
         default:
             log_error("[!] Unknown operation mode in parse_mode_arguments.");
             return_code = STATUS_CODE_INVALID_ARGUMENT;
@@ -308,7 +350,7 @@ STATUS_CODE filter_relevant_flags(char*** out_filtered_argv, int* out_filtered_a
     {
         for (const char** flag = relevant_flags; *flag != NULL; ++flag)
         {
-            if (argv[argument_index][0] == '-') // A flag argument
+            if ((argv[argument_index][0] == '-') && (argv[argument_index][1] != '\0')) // A flag argument, a lone '-' is the standard stream value
             {
                 copy_flag = false;
 
@@ -9,6 +9,9 @@ STATUS_CODE parse_key_generation_arguments(KeyGenerationArguments** out_argument
     uint32_t prime_field = DEFAULT_VALUE_OF_GALOIS_FIELD;
     uint32_t number_of_random_bits_to_add = DEFAULT_VALUE_OF_NUMBER_OF_RANDOM_BITS_TO_ADD;
     uint32_t number_of_letters_for_each_digit_ascii_mapping = DEFAULT_VALUE_OF_NUMBER_OF_ASCII_CHARACTERS_MAPPED_TO_EACH_DIGIT;
+    int circulant_key = 0;
+    int seeded_key = 0;
+    int mapped_key = 0;
     KeyGenerationArguments* parsed_arguments = NULL;
 
     struct argparse_option options[] = {
@@ -18,6 +21,9 @@ STATUS_CODE parse_key_generation_arguments(KeyGenerationArguments** out_argument
         OPT_INTEGER(*FLAG_PRIME_FIELD_SHORT, FLAG_PRIME_FIELD, &prime_field, FLAG_PRIME_FIELD_DESCRIPTION, 0, 0),
         OPT_INTEGER(*FLAG_RANDOM_BITS_SHORT, FLAG_RANDOM_BITS, &number_of_random_bits_to_add, FLAG_RANDOM_BITS_DESCRIPTION, 0, 0),
         OPT_INTEGER(*FLAG_ASCII_MAPPING_LETTERS_SHORT, FLAG_ASCII_MAPPING_LETTERS, &number_of_letters_for_each_digit_ascii_mapping, FLAG_ASCII_MAPPING_LETTERS_DESCRIPTION, 0, 0),
+        OPT_BOOLEAN(*FLAG_CIRCULANT_SHORT, FLAG_CIRCULANT, &circulant_key, FLAG_CIRCULANT_DESCRIPTION, 0, 0),
+        OPT_BOOLEAN(*FLAG_SEEDED_KEY_SHORT, FLAG_SEEDED_KEY, &seeded_key, FLAG_SEEDED_KEY_DESCRIPTION, 0, 0),
+        OPT_BOOLEAN(*FLAG_MAPPED_KEY_SHORT, FLAG_MAPPED_KEY, &mapped_key, FLAG_MAPPED_KEY_DESCRIPTION, 0, 0),
         OPT_END(),
     };
 
@@ -45,6 +51,22 @@ STATUS_CODE parse_key_generation_arguments(KeyGenerationArguments** out_argument
         goto cleanup;
     }
 
+    if (circulant_key && !is_ntt_compatible(dimension, prime_field))
+    {
+        log_error("[!] Circulant keys need a power of two dimension dividing prime field - 1, %u does not divide %u - 1 "
+                  "(try a dimension of 2^k with a prime field such as 7340033 or 998244353).", dimension, prime_field);
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    if ((GF2_PRIME_FIELD == prime_field) && (0 != (dimension % GF2_BITS_PER_BYTE)))
+    {
+        log_error("[!] Keys over GF(2) encrypt whole bytes of bits per block, the dimension must be a multiple of %u, got %u.",
+                  GF2_BITS_PER_BYTE, dimension);
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
     parsed_arguments = malloc(sizeof(KeyGenerationArguments));
     if (!parsed_arguments) 
     {
@@ -59,6 +81,9 @@ STATUS_CODE parse_key_generation_arguments(KeyGenerationArguments** out_argument
     parsed_arguments->prime_field = prime_field;
     parsed_arguments->number_of_random_bits_to_add = number_of_random_bits_to_add;
     parsed_arguments->number_of_letters_for_each_digit_ascii_mapping = number_of_letters_for_each_digit_ascii_mapping;
+    parsed_arguments->circulant_key = (0 != circulant_key);
+    parsed_arguments->seeded_key = (0 != seeded_key);
+    parsed_arguments->mapped_key = (0 != mapped_key);
 
     *out_arguments = parsed_arguments;
     parsed_arguments = NULL;
@@ -124,18 +149,33 @@ cleanup:
     return return_code;
 }
 
+static bool is_valid_ciphertext_format(const char* format, const char* ciphertext_file)
+{
+    // A streamed ciphertext has no extension to pick the format from
+    if (NULL == format)
+    {
+        return !is_standard_stream_path(ciphertext_file);
+    }
+    return (0 == strcmp(format, FORMAT_BINARY)) || (0 == strcmp(format, FORMAT_TEXT));
+}
+
 STATUS_CODE parse_decrypt_arguments(DecryptArguments** out_arguments, int argc, char** argv)
 {
     STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
     const char* input_file = NULL;
     const char* output_file = NULL;
     const char* key = NULL;
+    const char* format = NULL;
+    const char* io_backend = NULL;
+    ASYNC_IO_BACKEND parsed_io_backend = ASYNC_IO_BACKEND_AUTO;
     DecryptArguments* parsed_arguments = NULL;
 
     struct argparse_option options[] = {
         OPT_STRING(*FLAG_INPUT_FILE_SHORT, FLAG_INPUT_FILE, &input_file, FLAG_INPUT_FILE_DESCRIPTION, 0, 0),
         OPT_STRING(*FLAG_OUTPUT_FILE_SHORT, FLAG_OUTPUT_FILE, &output_file, FLAG_OUTPUT_FILE_DESCRIPTION, 0, 0),
         OPT_STRING(*FLAG_KEY_FILE_SHORT, FLAG_KEY_FILE, &key, FLAG_KEY_FILE_DESCRIPTION, 0, 0),
+        OPT_STRING(*FLAG_FORMAT_SHORT, FLAG_FORMAT, &format, FLAG_FORMAT_DESCRIPTION, 0, 0),
+        OPT_STRING(*FLAG_IO_BACKEND_SHORT, FLAG_IO_BACKEND, &io_backend, FLAG_IO_BACKEND_DESCRIPTION, 0, 0),
         OPT_END(),
     };
 
@@ -154,9 +194,12 @@ STATUS_CODE parse_decrypt_arguments(DecryptArguments** out_arguments, int argc,
         goto cleanup;
     }
 
-    if (!input_file || !output_file || !key || STATUS_FAILED(validate_file_is_writeable(output_file)) ||
+    if (!input_file || !output_file || !key ||
+        (!is_standard_stream_path(output_file) && STATUS_FAILED(validate_file_is_writeable(output_file))) ||
         STATUS_FAILED(validate_file_is_readable(key)) || STATUS_FAILED(validate_file_is_binary(key)) ||
-        STATUS_FAILED(validate_file_is_readable(input_file)))
+        (!is_standard_stream_path(input_file) && STATUS_FAILED(validate_file_is_readable(input_file))) ||
+        !is_valid_ciphertext_format(format, input_file) ||
+        STATUS_FAILED(parse_async_io_backend(&parsed_io_backend, io_backend)))
     {
         log_error("[!] Invalid arguments for DECRYPT_MODE.");
         fprintf(stderr, "%s", USAGE_DECRYPT_MODE);
@@ -175,6 +218,8 @@ STATUS_CODE parse_decrypt_arguments(DecryptArguments** out_arguments, int argc,
     parsed_arguments->input_file = input_file;
     parsed_arguments->output_file = output_file;
     parsed_arguments->key = key;
+    parsed_arguments->format = format;
+    parsed_arguments->io_backend = io_backend;
 
     *out_arguments = parsed_arguments;
     parsed_arguments = NULL;
@@ -190,12 +235,19 @@ STATUS_CODE parse_encrypt_arguments(EncryptArguments** out_arguments, int argc,
     const char* input_file = NULL;
     const char* output_file = NULL;
     const char* key = NULL;
+    const char* format = NULL;
+    const char* io_backend = NULL;
+    ASYNC_IO_BACKEND parsed_io_backend = ASYNC_IO_BACKEND_AUTO;
+    int pipeline = 0;
     EncryptArguments* parsed_arguments = NULL;
 
     struct argparse_option options[] = {
         OPT_STRING(*FLAG_INPUT_FILE_SHORT, FLAG_INPUT_FILE, &input_file, FLAG_INPUT_FILE_DESCRIPTION, 0, 0),
         OPT_STRING(*FLAG_OUTPUT_FILE_SHORT, FLAG_OUTPUT_FILE, &output_file, FLAG_OUTPUT_FILE_DESCRIPTION, 0, 0),
         OPT_STRING(*FLAG_KEY_FILE_SHORT, FLAG_KEY_FILE, &key, FLAG_KEY_FILE_DESCRIPTION, 0, 0),
+        OPT_STRING(*FLAG_FORMAT_SHORT, FLAG_FORMAT, &format, FLAG_FORMAT_DESCRIPTION, 0, 0),
+        OPT_STRING(*FLAG_IO_BACKEND_SHORT, FLAG_IO_BACKEND, &io_backend, FLAG_IO_BACKEND_DESCRIPTION, 0, 0),
+        OPT_BOOLEAN(*FLAG_PIPELINE_SHORT, FLAG_PIPELINE, &pipeline, FLAG_PIPELINE_DESCRIPTION, 0, 0),
         OPT_END(),
     };
 
@@ -214,9 +266,12 @@ STATUS_CODE parse_encrypt_arguments(EncryptArguments** out_arguments, int argc,
         goto cleanup;
     }
 
-    if (!input_file || !output_file || !key || STATUS_FAILED(validate_file_is_writeable(output_file)) ||
+    if (!input_file || !output_file || !key ||
+        (!is_standard_stream_path(output_file) && STATUS_FAILED(validate_file_is_writeable(output_file))) ||
         STATUS_FAILED(validate_file_is_readable(key)) || STATUS_FAILED(validate_file_is_binary(key)) ||
-        STATUS_FAILED(validate_file_is_readable(input_file)))
+        (!is_standard_stream_path(input_file) && STATUS_FAILED(validate_file_is_readable(input_file))) ||
+        !is_valid_ciphertext_format(format, output_file) ||
+        STATUS_FAILED(parse_async_io_backend(&parsed_io_backend, io_backend)))
     {
         log_error("[!] Invalid arguments for ENCRYPT_MODE.");
         fprintf(stderr, "%s", USAGE_ENCRYPT_MODE);
@@ -235,6 +290,9 @@ STATUS_CODE parse_encrypt_arguments(EncryptArguments** out_arguments, int argc,
     parsed_arguments->input_file = input_file;
     parsed_arguments->output_file = output_file;
     parsed_arguments->key = key;
+    parsed_arguments->format = format;
+    parsed_arguments->io_backend = io_backend;
+    parsed_arguments->pipeline = (0 != pipeline);
 
     *out_arguments = parsed_arguments;
     parsed_arguments = NULL;
@@ -255,6 +313,9 @@ STATUS_CODE parse_generate_and_encrypt_arguments(GenerateAndEncryptArguments** o
     uint32_t prime_field = DEFAULT_VALUE_OF_GALOIS_FIELD;
     uint32_t number_of_random_bits_to_add = DEFAULT_VALUE_OF_NUMBER_OF_RANDOM_BITS_TO_ADD;
     uint32_t number_of_letters_for_each_digit_ascii_mapping = DEFAULT_VALUE_OF_NUMBER_OF_ASCII_CHARACTERS_MAPPED_TO_EACH_DIGIT;
+    int circulant_key = 0;
+    int seeded_key = 0;
+    int mapped_key = 0;
     GenerateAndEncryptArguments* parsed_arguments = NULL;
     EncryptArguments* encrypt_arguments = NULL;
     KeyGenerationArguments* key_arguments = NULL;
@@ -268,6 +329,9 @@ STATUS_CODE parse_generate_and_encrypt_arguments(GenerateAndEncryptArguments** o
         OPT_INTEGER(*FLAG_PRIME_FIELD_SHORT, FLAG_PRIME_FIELD, &prime_field, FLAG_PRIME_FIELD_DESCRIPTION, 0, 0),
         OPT_INTEGER(*FLAG_RANDOM_BITS_SHORT, FLAG_RANDOM_BITS, &number_of_random_bits_to_add, FLAG_RANDOM_BITS_DESCRIPTION, 0, 0),
         OPT_INTEGER(*FLAG_ASCII_MAPPING_LETTERS_SHORT, FLAG_ASCII_MAPPING_LETTERS, &number_of_letters_for_each_digit_ascii_mapping, FLAG_ASCII_MAPPING_LETTERS_DESCRIPTION, 0, 0),
+        OPT_BOOLEAN(*FLAG_CIRCULANT_SHORT, FLAG_CIRCULANT, &circulant_key, FLAG_CIRCULANT_DESCRIPTION, 0, 0),
+        OPT_BOOLEAN(*FLAG_SEEDED_KEY_SHORT, FLAG_SEEDED_KEY, &seeded_key, FLAG_SEEDED_KEY_DESCRIPTION, 0, 0),
+        OPT_BOOLEAN(*FLAG_MAPPED_KEY_SHORT, FLAG_MAPPED_KEY, &mapped_key, FLAG_MAPPED_KEY_DESCRIPTION, 0, 0),
         OPT_END(),
     };
 
@@ -297,6 +361,22 @@ STATUS_CODE parse_generate_and_encrypt_arguments(GenerateAndEncryptArguments** o
         goto cleanup;
     }
 
+    if (circulant_key && !is_ntt_compatible(dimension, prime_field))
+    {
+        log_error("[!] Circulant keys need a power of two dimension dividing prime field - 1, %u does not divide %u - 1 "
+                  "(try a dimension of 2^k with a prime field such as 7340033 or 998244353).", dimension, prime_field);
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    if ((GF2_PRIME_FIELD == prime_field) && (0 != (dimension % GF2_BITS_PER_BYTE)))
+    {
+        log_error("[!] Keys over GF(2) encrypt whole bytes of bits per block, the dimension must be a multiple of %u, got %u.",
+                  GF2_BITS_PER_BYTE, dimension);
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
     parsed_arguments = malloc(sizeof(GenerateAndEncryptArguments));
     if (!parsed_arguments) 
     {
@@ -327,12 +407,18 @@ STATUS_CODE parse_generate_and_encrypt_arguments(GenerateAndEncryptArguments** o
     parsed_arguments->encrypt_arguments->input_file = input_file;
     parsed_arguments->encrypt_arguments->output_file = output_file;
     parsed_arguments->encrypt_arguments->key = key_file;
+    parsed_arguments->encrypt_arguments->format = NULL;
+    parsed_arguments->encrypt_arguments->io_backend = NULL;
+    parsed_arguments->encrypt_arguments->pipeline = false;
     parsed_arguments->key_generation_arguments->output_file = strdup(key_file);
     parsed_arguments->key_generation_arguments->dimension = dimension;
     parsed_arguments->key_generation_arguments->number_of_error_vectors = number_of_error_vectors;
     parsed_arguments->key_generation_arguments->prime_field = prime_field;
     parsed_arguments->key_generation_arguments->number_of_random_bits_to_add = number_of_random_bits_to_add;
     parsed_arguments->key_generation_arguments->number_of_letters_for_each_digit_ascii_mapping = number_of_letters_for_each_digit_ascii_mapping;
+    parsed_arguments->key_generation_arguments->circulant_key = (0 != circulant_key);
+    parsed_arguments->key_generation_arguments->seeded_key = (0 != seeded_key);
+    parsed_arguments->key_generation_arguments->mapped_key = (0 != mapped_key);
 
     *out_arguments = parsed_arguments;
     parsed_arguments = NULL;
@@ -422,6 +508,8 @@ STATUS_CODE parse_generate_and_decrypt_arguments(GenerateAndDecryptArguments** o
     parsed_arguments->decrypt_arguments->input_file = input_file;
     parsed_arguments->decrypt_arguments->output_file = output_file;
     parsed_arguments->decrypt_arguments->key = strdup(decryption_key_output_file);
+    parsed_arguments->decrypt_arguments->format = NULL;
+    parsed_arguments->decrypt_arguments->io_backend = NULL;
     parsed_arguments->key_generation_arguments->key = encryption_key_file;
     parsed_arguments->key_generation_arguments->output_file = decryption_key_output_file;
 
@@ -434,3 +522,222 @@ cleanup:
     free(parsed_arguments);
     return return_code;
 }
+
+STATUS_CODE parse_rekey_arguments(RekeyArguments** out_arguments, int argc, char** argv)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    const char* input_file = NULL;
+    const char* output_file = NULL;
+    const char* key = NULL;
+    const char* new_key = NULL;
+    RekeyArguments* parsed_arguments = NULL;
+
+    struct argparse_option options[] = {
+        OPT_STRING(*FLAG_INPUT_FILE_SHORT, FLAG_INPUT_FILE, &input_file, FLAG_INPUT_FILE_DESCRIPTION, 0, 0),
+        OPT_STRING(*FLAG_OUTPUT_FILE_SHORT, FLAG_OUTPUT_FILE, &output_file, FLAG_OUTPUT_FILE_DESCRIPTION, 0, 0),
+        OPT_STRING(*FLAG_KEY_FILE_SHORT, FLAG_KEY_FILE, &key, FLAG_KEY_FILE_DESCRIPTION, 0, 0),
+        OPT_STRING(*FLAG_NEW_KEY_FILE_SHORT, FLAG_NEW_KEY_FILE, &new_key, FLAG_NEW_KEY_FILE_DESCRIPTION, 0, 0),
+        OPT_END(),
+    };
+
+    if (!out_arguments || !argv)
+    {
+        log_error("[!] Invalid argument: out_arguments or argv is NULL in parse_rekey_arguments.");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    return_code = parse_generic_options(options, argc, argv);
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("[!] Failed to parse arguments for REKEY_MODE.");
+        return_code = STATUS_CODE_PARSE_ARGUMENTS_FAILED;
+        goto cleanup;
+    }
+
+    if (!input_file || !output_file || !key || !new_key || STATUS_FAILED(validate_file_is_writeable(output_file)) ||
+        STATUS_FAILED(validate_file_is_readable(key)) || STATUS_FAILED(validate_file_is_binary(key)) ||
+        STATUS_FAILED(validate_file_is_readable(new_key)) || STATUS_FAILED(validate_file_is_binary(new_key)) ||
+        STATUS_FAILED(validate_file_is_readable(input_file)))
+    {
+        log_error("[!] Invalid arguments for REKEY_MODE.");
+        fprintf(stderr, "%s", USAGE_REKEY_MODE);
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    parsed_arguments = malloc(sizeof(RekeyArguments));
+    if (!parsed_arguments)
+    {
+        log_error("[!] Memory allocation failed for RekeyArguments.");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    parsed_arguments->input_file = input_file;
+    parsed_arguments->output_file = output_file;
+    parsed_arguments->key = key;
+    parsed_arguments->new_key = new_key;
+
+    *out_arguments = parsed_arguments;
+    parsed_arguments = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free(parsed_arguments);
+    return return_code;
+}
+
+STATUS_CODE parse_batch_arguments(BatchArguments** out_arguments, int argc, char** argv)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    const char* input = NULL;
+    const char* output_directory = NULL;
+    const char* key = NULL;
+    int decrypt = 0;
+    uint32_t number_of_threads = 0;
+    uint32_t memory_budget_in_megabytes = DEFAULT_VALUE_OF_BATCH_MEMORY_BUDGET_IN_MEGABYTES;
+    bool is_directory = false;
+    BatchArguments* parsed_arguments = NULL;
+
+    struct argparse_option options[] = {
+        OPT_STRING(*FLAG_INPUT_FILE_SHORT, FLAG_INPUT_FILE, &input, FLAG_INPUT_FILE_DESCRIPTION, 0, 0),
+        OPT_STRING(*FLAG_OUTPUT_FILE_SHORT, FLAG_OUTPUT_FILE, &output_directory, FLAG_OUTPUT_FILE_DESCRIPTION, 0, 0),
+        OPT_STRING(*FLAG_KEY_FILE_SHORT, FLAG_KEY_FILE, &key, FLAG_KEY_FILE_DESCRIPTION, 0, 0),
+        OPT_BOOLEAN(*FLAG_BATCH_DECRYPT_SHORT, FLAG_BATCH_DECRYPT, &decrypt, FLAG_BATCH_DECRYPT_DESCRIPTION, 0, 0),
+        OPT_INTEGER(*FLAG_THREADS_SHORT, FLAG_THREADS, &number_of_threads, FLAG_THREADS_DESCRIPTION, 0, 0),
+        OPT_INTEGER(*FLAG_MEMORY_BUDGET_SHORT, FLAG_MEMORY_BUDGET, &memory_budget_in_megabytes, FLAG_MEMORY_BUDGET_DESCRIPTION, 0, 0),
+        OPT_END(),
+    };
+
+    if (!out_arguments || !argv)
+    {
+        log_error("[!] Invalid argument: out_arguments or argv is NULL in parse_batch_arguments.");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    return_code = parse_generic_options(options, argc, argv);
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("[!] Failed to parse arguments for BATCH_MODE.");
+        return_code = STATUS_CODE_PARSE_ARGUMENTS_FAILED;
+        goto cleanup;
+    }
+
+    is_directory = (NULL != input) && STATUS_SUCCESS(validate_path_is_directory(input));
+
+    // A directory needs somewhere to write and one key for all its files, a manifest names its outputs and may name its keys
+    if (!input || (0 == memory_budget_in_megabytes) ||
+        (is_directory ? (!output_directory || !key || STATUS_FAILED(validate_path_is_directory(output_directory))) :
+                        STATUS_FAILED(validate_file_is_readable(input))) ||
+        (key && (STATUS_FAILED(validate_file_is_readable(key)) || STATUS_FAILED(validate_file_is_binary(key)))))
+    {
+        log_error("[!] Invalid arguments for BATCH_MODE.");
+        fprintf(stderr, "%s", USAGE_BATCH_MODE);
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    parsed_arguments = malloc(sizeof(BatchArguments));
+    if (!parsed_arguments)
+    {
+        log_error("[!] Memory allocation failed for BatchArguments.");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    parsed_arguments->input = input;
+    parsed_arguments->output_directory = output_directory;
+    parsed_arguments->key = key;
+    parsed_arguments->is_directory = is_directory;
+    parsed_arguments->decrypt = (0 != decrypt);
+    parsed_arguments->number_of_threads = number_of_threads;
+    parsed_arguments->memory_budget_in_megabytes = memory_budget_in_megabytes;
+
+    *out_arguments = parsed_arguments;
+    parsed_arguments = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free(parsed_arguments);
+    return return_code;
+}
+
+STATUS_CODE parse_shard_arguments(ShardArguments** out_arguments, int argc, char** argv)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    const char* input_file = NULL;
+    const char* output_file = NULL;
+    const char* key = NULL;
+    const char* format = NULL;
+    int decrypt = 0;
+    uint32_t number_of_workers = 0;
+    uint32_t shard_size_in_megabytes = DEFAULT_VALUE_OF_SHARD_SIZE_IN_MEGABYTES;
+    uint32_t number_of_retries = DEFAULT_VALUE_OF_SHARD_RETRIES;
+    ShardArguments* parsed_arguments = NULL;
+
+    struct argparse_option options[] = {
+        OPT_STRING(*FLAG_INPUT_FILE_SHORT, FLAG_INPUT_FILE, &input_file, FLAG_INPUT_FILE_DESCRIPTION, 0, 0),
+        OPT_STRING(*FLAG_OUTPUT_FILE_SHORT, FLAG_OUTPUT_FILE, &output_file, FLAG_OUTPUT_FILE_DESCRIPTION, 0, 0),
+        OPT_STRING(*FLAG_KEY_FILE_SHORT, FLAG_KEY_FILE, &key, FLAG_KEY_FILE_DESCRIPTION, 0, 0),
+        OPT_STRING(*FLAG_FORMAT_SHORT, FLAG_FORMAT, &format, FLAG_FORMAT_DESCRIPTION, 0, 0),
+        OPT_BOOLEAN(*FLAG_BATCH_DECRYPT_SHORT, FLAG_BATCH_DECRYPT, &decrypt, FLAG_BATCH_DECRYPT_DESCRIPTION, 0, 0),
+        OPT_INTEGER(*FLAG_WORKERS_SHORT, FLAG_WORKERS, &number_of_workers, FLAG_WORKERS_DESCRIPTION, 0, 0),
+        OPT_INTEGER(*FLAG_SHARD_SIZE_SHORT, FLAG_SHARD_SIZE, &shard_size_in_megabytes, FLAG_SHARD_SIZE_DESCRIPTION, 0, 0),
+        OPT_INTEGER(*FLAG_RETRIES_SHORT, FLAG_RETRIES, &number_of_retries, FLAG_RETRIES_DESCRIPTION, 0, 0),
+        OPT_END(),
+    };
+
+    if (!out_arguments || !argv)
+    {
+        log_error("[!] Invalid argument: out_arguments or argv is NULL in parse_shard_arguments.");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    return_code = parse_generic_options(options, argc, argv);
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("[!] Failed to parse arguments for SHARD_MODE.");
+        return_code = STATUS_CODE_PARSE_ARGUMENTS_FAILED;
+        goto cleanup;
+    }
+
+    // Workers read the input at offsets and the coordinator writes the output at offsets, so neither may be a stream
+    if (!input_file || !output_file || !key ||
+        is_standard_stream_path(input_file) || is_standard_stream_path(output_file) ||
+        STATUS_FAILED(validate_file_is_readable(input_file)) ||
+        STATUS_FAILED(validate_file_is_readable(key)) || STATUS_FAILED(validate_file_is_binary(key)) ||
+        (format && (0 != strcmp(format, FORMAT_BINARY)) && (0 != strcmp(format, FORMAT_TEXT))) ||
+        (0 == shard_size_in_megabytes) || (MAXIMAL_SHARD_SIZE_IN_MEGABYTES < shard_size_in_megabytes) ||
+        ((int)number_of_retries < 0))
+    {
+        log_error("[!] Invalid arguments for SHARD_MODE.");
+        fprintf(stderr, "%s", USAGE_SHARD_MODE);
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    parsed_arguments = malloc(sizeof(ShardArguments));
+    if (!parsed_arguments)
+    {
+        log_error("[!] Memory allocation failed for ShardArguments.");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    parsed_arguments->input_file = input_file;
+    parsed_arguments->output_file = output_file;
+    parsed_arguments->key = key;
+    parsed_arguments->format = format;
+    parsed_arguments->decrypt = (0 != decrypt);
+    parsed_arguments->number_of_workers = number_of_workers;
+    parsed_arguments->shard_size_in_megabytes = shard_size_in_megabytes;
+    parsed_arguments->number_of_retries = number_of_retries;
+
+    *out_arguments = parsed_arguments;
+    parsed_arguments = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free(parsed_arguments);
+    return return_code;
+}
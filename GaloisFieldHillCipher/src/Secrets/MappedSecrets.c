@@ -0,0 +1,529 @@
+#include "Secrets/MappedSecrets.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static bool is_little_endian_host(void)
+{
+    const uint16_t probe = 1;
+
+    return 1 == *(const uint8_t*)&probe;
+}
+
+static uint64_t align_to_section(uint64_t offset)
+{
+    return (offset + MAPPED_KEY_SECTION_ALIGNMENT - 1) & ~(uint64_t)(MAPPED_KEY_SECTION_ALIGNMENT - 1);
+}
+
+static void get_mapped_key_section_sizes(uint64_t* out_sizes, uint32_t dimension, uint32_t prime_field, uint32_t letters_per_digit)
+{
+    uint64_t element_size = get_field_element_size(select_field_element_width(prime_field));
+
+    out_sizes[MAPPED_KEY_SECTION_KEY_MATRIX] = (uint64_t)dimension * dimension * element_size;
+    out_sizes[MAPPED_KEY_SECTION_INVERSE_KEY_MATRIX] = (uint64_t)dimension * dimension * element_size;
+    out_sizes[MAPPED_KEY_SECTION_COMBINED_ERROR_VECTOR] = (uint64_t)dimension * element_size;
+    out_sizes[MAPPED_KEY_SECTION_ASCII_MAPPING] = (uint64_t)NUMBER_OF_DIGITS * letters_per_digit;
+    out_sizes[MAPPED_KEY_SECTION_PERMUTATION] = calculate_digits_per_element(prime_field);
+}
+
+bool is_mapped_key_data(const uint8_t* data, size_t size)
+{
+    uint32_t magic = 0;
+
+    if ((NULL == data) || (size < sizeof(MappedKeyHeader)))
+    {
+        return false;
+    }
+
+    memcpy(&magic, data, sizeof(uint32_t));
+    return MAPPED_KEY_MAGIC == magic;
+}
+
+STATUS_CODE serialize_mapped_secrets(uint8_t** out_data, uint32_t* out_size, Secrets secrets)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    FieldVector owned_key_matrix = {0};
+    FieldVector owned_inverse_key_matrix = {0};
+    FieldVector owned_combined_error_vector = {0};
+    const FieldVector* flat_key_matrix = &secrets.flat_key_matrix;
+    const FieldVector* flat_inverse_key_matrix = &secrets.flat_inverse_key_matrix;
+    const FieldVector* combined_error_vector = &secrets.combined_error_vector;
+    int64_t** generated_inverse_key_matrix = NULL;
+    MappedKeyHeader header = {0};
+    MappedKeySection sections[NUMBER_OF_MAPPED_KEY_SECTIONS];
+    uint64_t section_sizes[NUMBER_OF_MAPPED_KEY_SECTIONS];
+    uint64_t offset = 0;
+    uint8_t* buffer = NULL;
+    uint32_t index = 0;
+
+    if (!out_data || !out_size || (KEY_STRUCTURE_CIRCULANT == secrets.key_structure) || (0 == secrets.dimension) ||
+        (secrets.prime_field < 2) || (((uint64_t)secrets.dimension * secrets.dimension) > UINT32_MAX) ||
+        (!secrets.flat_key_matrix.elements && !secrets.key_matrix) ||
+        (!secrets.combined_error_vector.elements && !secrets.error_vectors) ||
+        !secrets.ascii_mapping || !secrets.permutation_vector || (0 == secrets.number_of_letters_for_each_digit_ascii_mapping))
+    {
+        log_error("[!] Invalid arguments in serialize_mapped_secrets: %s",
+                  (KEY_STRUCTURE_CIRCULANT == secrets.key_structure) ? "the mapped format holds dense keys only" : "missing or invalid members");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+    if (!is_little_endian_host())
+    {
+        log_error("[!] Mapped keys are little endian and can't be written on this host");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    if (NULL == flat_key_matrix->elements)
+    {
+        return_code = flatten_square_matrix_over_field(&owned_key_matrix, secrets.key_matrix, secrets.dimension, secrets.prime_field);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+        flat_key_matrix = &owned_key_matrix;
+    }
+
+    // Keys fresh from generation carry their inverse, a loaded full key is inverted once here rather than on every use
+    if (NULL == flat_inverse_key_matrix->elements)
+    {
+        if (NULL == secrets.inverse_key_matrix)
+        {
+            log_info("Generating the inverse key matrix of the mapped key...");
+            return_code = generate_decryption_matrix(&generated_inverse_key_matrix, secrets.dimension, secrets.key_matrix, secrets.prime_field);
+            if (STATUS_FAILED(return_code))
+            {
+                goto cleanup;
+            }
+        }
+        return_code = flatten_square_matrix_over_field(&owned_inverse_key_matrix,
+                                                       generated_inverse_key_matrix ? generated_inverse_key_matrix : secrets.inverse_key_matrix,
+                                                       secrets.dimension, secrets.prime_field);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+        flat_inverse_key_matrix = &owned_inverse_key_matrix;
+    }
+
+    if (NULL == combined_error_vector->elements)
+    {
+        return_code = combine_error_vectors(&owned_combined_error_vector, secrets.error_vectors, secrets.number_of_error_vectors,
+                                            secrets.dimension, secrets.prime_field);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+        combined_error_vector = &owned_combined_error_vector;
+    }
+
+    get_mapped_key_section_sizes(section_sizes, secrets.dimension, secrets.prime_field, secrets.number_of_letters_for_each_digit_ascii_mapping);
+    offset = align_to_section(sizeof(MappedKeyHeader) + sizeof(sections));
+    for (index = 0; index < NUMBER_OF_MAPPED_KEY_SECTIONS; ++index)
+    {
+        sections[index].type = index;
+        sections[index].reserved = 0;
+        sections[index].offset = offset;
+        sections[index].size = section_sizes[index];
+        offset = align_to_section(offset + section_sizes[index]);
+    }
+    offset = sections[NUMBER_OF_MAPPED_KEY_SECTIONS - 1].offset + sections[NUMBER_OF_MAPPED_KEY_SECTIONS - 1].size;
+    if (offset > UINT32_MAX)
+    {
+        log_error("[!] Mapped key size overflow in serialize_mapped_secrets");
+        return_code = STATUS_CODE_ERROR_INVALID_SIZE;
+        goto cleanup;
+    }
+
+    // Zeroed so the alignment padding is deterministic
+    buffer = (uint8_t*)calloc((size_t)offset, sizeof(uint8_t));
+    if (!buffer)
+    {
+        log_error("[!] Memory allocation failed in serialize_mapped_secrets.");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    header.magic = MAPPED_KEY_MAGIC;
+    header.version = MAPPED_KEY_VERSION;
+    header.flags = secrets.is_decryption_key ? MAPPED_KEY_FLAG_DECRYPTION : 0;
+    header.dimension = secrets.dimension;
+    header.prime_field = secrets.prime_field;
+    header.element_size = (uint32_t)get_field_element_size(select_field_element_width(secrets.prime_field));
+    header.number_of_error_vectors = secrets.number_of_error_vectors;
+    header.number_of_letters_for_each_digit_ascii_mapping = secrets.number_of_letters_for_each_digit_ascii_mapping;
+    header.number_of_sections = NUMBER_OF_MAPPED_KEY_SECTIONS;
+    memcpy(buffer, &header, sizeof(header));
+    memcpy(buffer + sizeof(header), sections, sizeof(sections));
+
+    memcpy(buffer + sections[MAPPED_KEY_SECTION_KEY_MATRIX].offset, flat_key_matrix->elements, (size_t)section_sizes[MAPPED_KEY_SECTION_KEY_MATRIX]);
+    memcpy(buffer + sections[MAPPED_KEY_SECTION_INVERSE_KEY_MATRIX].offset, flat_inverse_key_matrix->elements,
+           (size_t)section_sizes[MAPPED_KEY_SECTION_INVERSE_KEY_MATRIX]);
+    memcpy(buffer + sections[MAPPED_KEY_SECTION_COMBINED_ERROR_VECTOR].offset, combined_error_vector->elements,
+           (size_t)section_sizes[MAPPED_KEY_SECTION_COMBINED_ERROR_VECTOR]);
+    for (index = 0; index < NUMBER_OF_DIGITS; ++index)
+    {
+        memcpy(buffer + sections[MAPPED_KEY_SECTION_ASCII_MAPPING].offset + ((size_t)index * secrets.number_of_letters_for_each_digit_ascii_mapping),
+               secrets.ascii_mapping[index], secrets.number_of_letters_for_each_digit_ascii_mapping);
+    }
+    memcpy(buffer + sections[MAPPED_KEY_SECTION_PERMUTATION].offset, secrets.permutation_vector, (size_t)section_sizes[MAPPED_KEY_SECTION_PERMUTATION]);
+    log_debug("Serialized mapped %s key: dimension=%u, prime_field=%u, size=%llu",
+              secrets.is_decryption_key ? "decryption" : "encryption", secrets.dimension, secrets.prime_field, (unsigned long long)offset);
+
+    *out_data = buffer;
+    buffer = NULL;
+    *out_size = (uint32_t)offset;
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free_field_vector(&owned_key_matrix);
+    free_field_vector(&owned_inverse_key_matrix);
+    free_field_vector(&owned_combined_error_vector);
+    if (NULL != generated_inverse_key_matrix)
+    {
+        (void)free_int64_matrix(generated_inverse_key_matrix, secrets.dimension);
+    }
+    free(buffer);
+    return return_code;
+}
+
+static STATUS_CODE attach_flat_section(FieldVector* out_vector, const uint8_t* section, uint32_t length, uint32_t prime_field, bool is_in_place)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+
+    if (is_in_place)
+    {
+        out_vector->elements = (void*)section;
+        out_vector->length = length;
+        out_vector->width = select_field_element_width(prime_field);
+        return STATUS_CODE_SUCCESS;
+    }
+
+    return_code = allocate_field_vector(out_vector, length, prime_field);
+    if (STATUS_SUCCESS(return_code))
+    {
+        memcpy(out_vector->elements, section, (size_t)length * get_field_element_size(out_vector->width));
+    }
+    return return_code;
+}
+
+static STATUS_CODE parse_mapped_secrets(Secrets* out_secrets, const uint8_t* data, size_t size, bool is_in_place)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    MappedKeyHeader header = {0};
+    MappedKeySection section = {0};
+    uint64_t section_sizes[NUMBER_OF_MAPPED_KEY_SECTIONS];
+    uint64_t section_offsets[NUMBER_OF_MAPPED_KEY_SECTIONS];
+    bool is_section_found[NUMBER_OF_MAPPED_KEY_SECTIONS] = {false};
+    Secrets secrets = {0};
+    uint32_t index = 0, digits_per_element = 0;
+
+    if (!out_secrets || !is_mapped_key_data(data, size))
+    {
+        log_error("[!] Invalid arguments in parse_mapped_secrets");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+    if (!is_little_endian_host())
+    {
+        log_error("[!] Mapped keys are little endian and can't be loaded on this host");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    memcpy(&header, data, sizeof(header));
+    if ((MAPPED_KEY_VERSION != header.version) || (0 != (header.flags & ~MAPPED_KEY_KNOWN_FLAGS)))
+    {
+        log_error("[!] Unsupported mapped key version %u or flags 0x%x", header.version, header.flags);
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+    if ((header.prime_field < 2) || (0 == header.dimension) || (((uint64_t)header.dimension * header.dimension) > UINT32_MAX) ||
+        (header.element_size != get_field_element_size(select_field_element_width(header.prime_field))) ||
+        (0 == header.number_of_letters_for_each_digit_ascii_mapping) || (header.number_of_sections > MAPPED_KEY_MAXIMAL_SECTIONS) ||
+        ((sizeof(header) + ((size_t)header.number_of_sections * sizeof(section))) > size))
+    {
+        log_error("[!] Invalid mapped key header: dimension=%u, prime_field=%u, element_size=%u, sections=%u",
+                  header.dimension, header.prime_field, header.element_size, header.number_of_sections);
+        return_code = STATUS_CODE_ERROR_INVALID_SIZE;
+        goto cleanup;
+    }
+
+    // Every section is bounds checked against the file, the element values are trusted like in the other key formats
+    get_mapped_key_section_sizes(section_sizes, header.dimension, header.prime_field, header.number_of_letters_for_each_digit_ascii_mapping);
+    for (index = 0; index < header.number_of_sections; ++index)
+    {
+        memcpy(&section, data + sizeof(header) + ((size_t)index * sizeof(section)), sizeof(section));
+        if ((0 != (section.offset % MAPPED_KEY_SECTION_ALIGNMENT)) || (section.offset > size) || (section.size > (size - section.offset)))
+        {
+            log_error("[!] Mapped key section %u out of bounds: offset=%llu, size=%llu", section.type,
+                      (unsigned long long)section.offset, (unsigned long long)section.size);
+            return_code = STATUS_CODE_ERROR_INVALID_SIZE;
+            goto cleanup;
+        }
+        if (section.type >= NUMBER_OF_MAPPED_KEY_SECTIONS)
+        {
+            log_debug("Skipping unknown mapped key section %u", section.type);
+            continue;
+        }
+        if (is_section_found[section.type] || (section.size != section_sizes[section.type]))
+        {
+            log_error("[!] Mapped key section %u is repeated or has size %llu instead of %llu", section.type,
+                      (unsigned long long)section.size, (unsigned long long)section_sizes[section.type]);
+            return_code = STATUS_CODE_ERROR_INVALID_SIZE;
+            goto cleanup;
+        }
+        is_section_found[section.type] = true;
+        section_offsets[section.type] = section.offset;
+    }
+    for (index = 0; index < NUMBER_OF_MAPPED_KEY_SECTIONS; ++index)
+    {
+        if (!is_section_found[index])
+        {
+            log_error("[!] Mapped key section %u is missing", index);
+            return_code = STATUS_CODE_ERROR_INVALID_SIZE;
+            goto cleanup;
+        }
+    }
+
+    secrets.key_structure = KEY_STRUCTURE_DENSE;
+    secrets.dimension = header.dimension;
+    secrets.prime_field = header.prime_field;
+    secrets.number_of_error_vectors = header.number_of_error_vectors;
+    secrets.number_of_letters_for_each_digit_ascii_mapping = header.number_of_letters_for_each_digit_ascii_mapping;
+    secrets.is_decryption_key = (0 != (header.flags & MAPPED_KEY_FLAG_DECRYPTION));
+
+    return_code = attach_flat_section(&secrets.flat_key_matrix, data + section_offsets[MAPPED_KEY_SECTION_KEY_MATRIX],
+                                      header.dimension * header.dimension, header.prime_field, is_in_place);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    return_code = attach_flat_section(&secrets.flat_inverse_key_matrix, data + section_offsets[MAPPED_KEY_SECTION_INVERSE_KEY_MATRIX],
+                                      header.dimension * header.dimension, header.prime_field, is_in_place);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    return_code = attach_flat_section(&secrets.combined_error_vector, data + section_offsets[MAPPED_KEY_SECTION_COMBINED_ERROR_VECTOR],
+                                      header.dimension, header.prime_field, is_in_place);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    // The mapping and permutation are a few bytes, they are copied so every other key member is owned
+    digits_per_element = calculate_digits_per_element(header.prime_field);
+    secrets.ascii_mapping = (uint8_t**)calloc(NUMBER_OF_DIGITS, sizeof(uint8_t*));
+    secrets.permutation_vector = (uint8_t*)malloc(digits_per_element);
+    if (!secrets.ascii_mapping || !secrets.permutation_vector)
+    {
+        log_error("[!] Memory allocation failed in parse_mapped_secrets.");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    for (index = 0; index < NUMBER_OF_DIGITS; ++index)
+    {
+        secrets.ascii_mapping[index] = (uint8_t*)malloc(header.number_of_letters_for_each_digit_ascii_mapping);
+        if (!secrets.ascii_mapping[index])
+        {
+            log_error("[!] Memory allocation failed in parse_mapped_secrets.");
+            return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+            goto cleanup;
+        }
+        memcpy(secrets.ascii_mapping[index],
+               data + section_offsets[MAPPED_KEY_SECTION_ASCII_MAPPING] + ((size_t)index * header.number_of_letters_for_each_digit_ascii_mapping),
+               header.number_of_letters_for_each_digit_ascii_mapping);
+    }
+    memcpy(secrets.permutation_vector, data + section_offsets[MAPPED_KEY_SECTION_PERMUTATION], digits_per_element);
+    log_debug("Loaded mapped %s key %s: dimension=%u, prime_field=%u", secrets.is_decryption_key ? "decryption" : "encryption",
+              is_in_place ? "in place" : "by copy", secrets.dimension, secrets.prime_field);
+
+    *out_secrets = secrets;
+    memset(&secrets, 0, sizeof(secrets));
+
+    increase_metric_counter(METRIC_COUNTER_KEYS_LOADED, 1);
+    set_metric_gauge(METRIC_GAUGE_KEY_DIMENSION, out_secrets->dimension);
+    set_metric_gauge(METRIC_GAUGE_PRIME_FIELD, out_secrets->prime_field);
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    if (is_in_place)
+    {
+        // Views into the caller's data, not ours to free
+        memset(&secrets.flat_key_matrix, 0, sizeof(FieldVector));
+        memset(&secrets.flat_inverse_key_matrix, 0, sizeof(FieldVector));
+        memset(&secrets.combined_error_vector, 0, sizeof(FieldVector));
+    }
+    free_secrets(&secrets);
+    return return_code;
+}
+
+STATUS_CODE deserialize_mapped_secrets(Secrets* out_secrets, const uint8_t* data, size_t size)
+{
+    return parse_mapped_secrets(out_secrets, data, size, false);
+}
+
+#ifdef _WIN32
+static STATUS_CODE map_secrets_file(void** out_mapping, size_t* out_size, const char* filepath)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE file_mapping = NULL;
+    LARGE_INTEGER file_size;
+    void* mapping = NULL;
+
+    file = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (INVALID_HANDLE_VALUE == file)
+    {
+        log_error("[!] Failed to open key file: %s", filepath);
+        return_code = STATUS_CODE_COULDNT_READ_FILE;
+        goto cleanup;
+    }
+    if (!GetFileSizeEx(file, &file_size) || (file_size.QuadPart <= 0) || ((uint64_t)file_size.QuadPart > UINT32_MAX))
+    {
+        log_error("[!] Invalid key file size: %s", filepath);
+        return_code = STATUS_CODE_ERROR_INVALID_FILE_SIZE;
+        goto cleanup;
+    }
+
+    file_mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    mapping = (NULL != file_mapping) ? MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (NULL == mapping)
+    {
+        log_error("[!] Failed to map key file: %s", filepath);
+        return_code = STATUS_CODE_COULDNT_READ_FILE;
+        goto cleanup;
+    }
+
+    // The view keeps the file mapped after both handles are closed
+    *out_mapping = mapping;
+    *out_size = (size_t)file_size.QuadPart;
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    if (NULL != file_mapping)
+    {
+        CloseHandle(file_mapping);
+    }
+    if (INVALID_HANDLE_VALUE != file)
+    {
+        CloseHandle(file);
+    }
+    return return_code;
+}
+
+void unmap_secrets_file(void* mapping, size_t size)
+{
+    (void)size;
+    if (NULL != mapping)
+    {
+        UnmapViewOfFile(mapping);
+    }
+}
+#else
+static STATUS_CODE map_secrets_file(void** out_mapping, size_t* out_size, const char* filepath)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    int file = -1;
+    struct stat file_status;
+    void* mapping = NULL;
+
+    file = open(filepath, O_RDONLY);
+    if (file < 0)
+    {
+        log_error("[!] Failed to open key file: %s", filepath);
+        return_code = STATUS_CODE_COULDNT_READ_FILE;
+        goto cleanup;
+    }
+    if ((0 != fstat(file, &file_status)) || (file_status.st_size <= 0) || ((uint64_t)file_status.st_size > UINT32_MAX))
+    {
+        log_error("[!] Invalid key file size: %s", filepath);
+        return_code = STATUS_CODE_ERROR_INVALID_FILE_SIZE;
+        goto cleanup;
+    }
+
+    mapping = mmap(NULL, (size_t)file_status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (MAP_FAILED == mapping)
+    {
+        log_error("[!] Failed to map key file: %s", filepath);
+        return_code = STATUS_CODE_COULDNT_READ_FILE;
+        goto cleanup;
+    }
+
+    // The mapping outlives the descriptor
+    *out_mapping = mapping;
+    *out_size = (size_t)file_status.st_size;
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    if (file >= 0)
+    {
+        close(file);
+    }
+    return return_code;
+}
+
+void unmap_secrets_file(void* mapping, size_t size)
+{
+    if (NULL != mapping)
+    {
+        munmap(mapping, size);
+    }
+}
+#endif
+
+STATUS_CODE load_secrets_file(Secrets* out_secrets, uint32_t* out_size, const char* filepath)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    void* mapping = NULL;
+    size_t mapping_size = 0;
+    Secrets secrets = {0};
+
+    if (!out_secrets || !filepath)
+    {
+        log_error("[!] Invalid arguments in load_secrets_file");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    return_code = map_secrets_file(&mapping, &mapping_size, filepath);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    if (is_mapped_key_data((const uint8_t*)mapping, mapping_size))
+    {
+        return_code = parse_mapped_secrets(&secrets, (const uint8_t*)mapping, mapping_size, true);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+        secrets.key_mapping = mapping;
+        secrets.key_mapping_size = mapping_size;
+        mapping = NULL;
+    }
+    else
+    {
+        // The other formats are parsed into owned members, the mapping only replaces reading the file
+        return_code = deserialize_secrets(&secrets, (uint8_t*)mapping, (uint32_t)mapping_size);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+    }
+
+    *out_secrets = secrets;
+    if (NULL != out_size)
+    {
+        *out_size = (uint32_t)mapping_size;
+    }
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    unmap_secrets_file(mapping, mapping_size);
+    return return_code;
+}
@@ -1,4 +1,5 @@
 #include "Secrets/SecretsGeneration.h"
+#include "Secrets/MappedSecrets.h"
 
 STATUS_CODE generate_ascii_mapping(uint8_t*** out_mapping, uint32_t letters_per_digit, uint32_t base)
 {
@@ -117,13 +118,9 @@ cleanup:
     return return_code;
 }
 
-STATUS_CODE generate_encryption_matrix(int64_t*** out_matrix, uint32_t dimension, uint32_t prime_field, uint32_t max_attempts)
+STATUS_CODE generate_encryption_matrix(int64_t*** out_matrix, int64_t*** out_inverse_matrix, uint32_t dimension, uint32_t prime_field)
 {
     STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
-    bool matrix_invertible = false;
-    uint32_t attempt_number = 0;
-    size_t row = 0;
-    int64_t** matrix_buffer = NULL;
 
     if (NULL == out_matrix)
     {
@@ -134,47 +131,69 @@ STATUS_CODE generate_encryption_matrix(int64_t*** out_matrix, uint32_t dimension
 
     log_debug("Generating encryption matrix: dimension=%u, prime_field=%u", dimension, prime_field);
 
-    while (++attempt_number < max_attempts)
+    return_code = generate_invertible_matrix_over_field(out_matrix, out_inverse_matrix, dimension, prime_field);
+    if (STATUS_FAILED(return_code))
     {
-        return_code = generate_square_matrix_over_field(&matrix_buffer, dimension, prime_field);
+        log_error("[!] Failed to generate invertible matrix");
+        goto cleanup;
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+
+cleanup:
+    return return_code;
+}
+
+STATUS_CODE generate_circulant_encryption_column(int64_t** out_column, uint32_t dimension, uint32_t prime_field)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    int64_t** random_row = NULL;
+    int64_t* inverse_column = NULL;
+    uint32_t attempt = 0;
+
+    if (NULL == out_column)
+    {
+        log_error("[!] Invalid argument: out_column is NULL in generate_circulant_encryption_column");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    log_debug("Generating circulant encryption column: dimension=%u, prime_field=%u", dimension, prime_field);
+
+    for (attempt = 0; attempt < MAXIMUM_CIRCULANT_KEY_ATTEMPTS; ++attempt)
+    {
+        return_code = generate_matrix_over_field(&random_row, 1, dimension, prime_field);
         if (STATUS_FAILED(return_code))
         {
-            log_debug("Failed to generate square matrix on attempt %u", attempt_number);
-            continue;
+            goto cleanup;
         }
 
-        return_code = is_matrix_invertible(&matrix_invertible, matrix_buffer, dimension, prime_field);
-        if (STATUS_FAILED(return_code) || !matrix_invertible)
-        {
-            log_debug("Generated matrix not invertible on attempt %u", attempt_number);
-            for (row = 0; row < dimension; ++row)
-            {
-                free((matrix_buffer)[row]);
-                (matrix_buffer)[row] = NULL;
-            }
-            free(matrix_buffer);
-            matrix_buffer = NULL;
-        }
-        else if (matrix_invertible)
+        return_code = invert_circulant_column(&inverse_column, random_row[0], dimension, prime_field);
+        free(inverse_column);
+        inverse_column = NULL;
+        if (STATUS_CODE_MATRIX_NOT_INVERTIBLE != return_code)
         {
-            log_debug("Found invertible matrix on attempt %u", attempt_number);
             break;
         }
+        log_debug("Circulant column %u is singular, drawing another one", attempt);
+        (void)free_int64_matrix(random_row, 1);
+        random_row = NULL;
     }
-
-    if (attempt_number >= max_attempts)
+    if (STATUS_FAILED(return_code))
     {
-        log_error("[!] Failed to generate invertible matrix after %u attempts", max_attempts);
-        return_code = STATUS_CODE_MATRIX_NOT_INVERTIBLE;
+        log_error("[!] Failed to generate an invertible circulant column");
         goto cleanup;
     }
 
-    *out_matrix = matrix_buffer;
-    matrix_buffer = NULL;
+    *out_column = random_row[0];
+    random_row[0] = NULL;
     return_code = STATUS_CODE_SUCCESS;
 
 cleanup:
-    (void)free_int64_matrix(matrix_buffer, dimension);
+    if (NULL != random_row)
+    {
+        (void)free_int64_matrix(random_row, 1);
+    }
     return return_code;
 }
 
@@ -205,7 +224,7 @@ cleanup:
     return return_code;
 }
 
-STATUS_CODE build_encryption_secrets(Secrets** out_secrets, const KeyGenerationArguments *args)
+static STATUS_CODE generate_encryption_secrets(Secrets** out_secrets, const KeyGenerationArguments *args, bool with_inverse_key_matrix)
 {
     STATUS_CODE return_code = STATUS_CODE_SUCCESS;
     Secrets* secrets = NULL;
@@ -214,14 +233,14 @@ STATUS_CODE build_encryption_secrets(Secrets** out_secrets, const KeyGenerationA
 
     if ((NULL == out_secrets) || (NULL == args))
     {
-        log_error("[!] Invalid arguments in build_encryption_secrets");
+        log_error("[!] Invalid arguments in generate_encryption_secrets");
         return_code = STATUS_CODE_INVALID_ARGUMENT;
         goto cleanup;
     }
 
     number_of_digits_per_field_element = calculate_digits_per_element(args->prime_field);
 
-    secrets = (Secrets*)malloc(sizeof(Secrets));
+    secrets = (Secrets*)calloc(1, sizeof(Secrets));
     if (NULL == secrets)
     {
         return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
@@ -231,16 +250,30 @@ STATUS_CODE build_encryption_secrets(Secrets** out_secrets, const KeyGenerationA
     log_info("Starting key generation with parameters: dimension=%u, prime_field=%u, error_vectors=%u",
          args->dimension, args->prime_field, args->number_of_error_vectors);
 
-    return_code = generate_encryption_matrix(&encryption_matrix,
-                                             args->dimension,
-                                             args->prime_field,
-                                             3);
-    if (STATUS_FAILED(return_code))
+    if (args->circulant_key)
     {
-        log_error("[!] Failed to generate encryption matrix");
-        goto cleanup;
+        return_code = generate_circulant_encryption_column(&secrets->circulant_column, args->dimension, args->prime_field);
+        if (STATUS_FAILED(return_code))
+        {
+            log_error("[!] Failed to generate circulant encryption key");
+            goto cleanup;
+        }
+        secrets->key_structure = KEY_STRUCTURE_CIRCULANT;
+        log_info("Circulant encryption key generated.");
+    }
+    else
+    {
+        return_code = generate_encryption_matrix(&encryption_matrix,
+                                                 with_inverse_key_matrix ? &secrets->inverse_key_matrix : NULL,
+                                                 args->dimension,
+                                                 args->prime_field);
+        if (STATUS_FAILED(return_code))
+        {
+            log_error("[!] Failed to generate encryption matrix");
+            goto cleanup;
+        }
+        log_info("Encryption matrix generated.");
     }
-    log_info("Encryption matrix generated.");
 
     secrets->key_matrix = encryption_matrix;
     secrets->dimension = args->dimension;
@@ -291,23 +324,102 @@ cleanup:
     return return_code;
 }
 
+STATUS_CODE build_encryption_secrets(Secrets** out_secrets, const KeyGenerationArguments *args)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint8_t seed[RANDOM_SEED_SIZE];
+
+    if ((NULL == out_secrets) || (NULL == args))
+    {
+        log_error("[!] Invalid arguments in build_encryption_secrets");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    if (!args->seeded_key)
+    {
+        return_code = generate_encryption_secrets(out_secrets, args, true);
+        goto cleanup;
+    }
+
+    return_code = generate_secure_random_bytes(seed, sizeof(seed));
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("[!] Failed to generate key seed");
+        goto cleanup;
+    }
+
+    return_code = build_encryption_secrets_from_seed(out_secrets, args, seed, true);
+cleanup:
+    sodium_memzero(seed, sizeof(seed));
+    return return_code;
+}
+
+STATUS_CODE build_encryption_secrets_from_seed(Secrets** out_secrets, const KeyGenerationArguments *args, const uint8_t* seed, bool with_inverse_key_matrix)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    Secrets* secrets = NULL;
+    uint8_t* key_seed = NULL;
+
+    if ((NULL == out_secrets) || (NULL == args) || (NULL == seed))
+    {
+        log_error("[!] Invalid arguments in build_encryption_secrets_from_seed");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    key_seed = (uint8_t*)malloc(RANDOM_SEED_SIZE);
+    if (NULL == key_seed)
+    {
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    memcpy(key_seed, seed, RANDOM_SEED_SIZE);
+
+    // Every draw of the generation routines comes from the seeded stream, so the same seed and parameters give the same key
+    return_code = begin_seeded_random_stream(seed);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    return_code = generate_encryption_secrets(&secrets, args, with_inverse_key_matrix);
+    end_seeded_random_stream();
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    secrets->key_seed = key_seed;
+    key_seed = NULL;
+
+    *out_secrets = secrets;
+    secrets = NULL;
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free(key_seed);
+    return return_code;
+}
+
 STATUS_CODE build_decryption_secrets(Secrets** out_secrets, Secrets* encryption_secrets)
 {
     STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
     Secrets* decryption_secrets = NULL;
     int64_t** decryption_matrix = NULL;
+    int64_t* decryption_column = NULL;
     uint8_t* reversed_permutation_vector = NULL;
     uint32_t permutation_size = 0, index = 0;
 
     if ((NULL == out_secrets) || (NULL == encryption_secrets) ||
-        (NULL == encryption_secrets->key_matrix) || (NULL == encryption_secrets->error_vectors))
+        ((NULL == encryption_secrets->key_matrix) && (NULL == encryption_secrets->circulant_column) &&
+         (NULL == encryption_secrets->flat_key_matrix.elements)) ||
+        ((NULL == encryption_secrets->error_vectors) && (NULL == encryption_secrets->combined_error_vector.elements)))
     {
         log_error("Invalid arguments in build_decryption_secrets");
         return_code = STATUS_CODE_INVALID_ARGUMENT;
         goto cleanup;
     }
 
-    decryption_secrets = (Secrets*)malloc(sizeof(Secrets));
+    decryption_secrets = (Secrets*)calloc(1, sizeof(Secrets));
     if (NULL == decryption_secrets)
     {
         return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
@@ -316,15 +428,43 @@ STATUS_CODE build_decryption_secrets(Secrets** out_secrets, Secrets* encryption_
 
     log_info("Building decryption secrets from encryption secrets...");
 
-    log_info("Generating decryption matrix...");
-    return_code = generate_decryption_matrix(&decryption_matrix, encryption_secrets->dimension,
-                                           encryption_secrets->key_matrix, encryption_secrets->prime_field);
-    if (STATUS_FAILED(return_code))
+    if (KEY_STRUCTURE_CIRCULANT == encryption_secrets->key_structure)
     {
-        log_error("Failed to generate decryption matrix");
-        goto cleanup;
+        log_info("Inverting circulant key in the transform domain...");
+        return_code = invert_circulant_column(&decryption_column, encryption_secrets->circulant_column,
+                                              encryption_secrets->dimension, encryption_secrets->prime_field);
+        if (STATUS_FAILED(return_code))
+        {
+            log_error("Failed to generate decryption key");
+            goto cleanup;
+        }
+        log_int64_vector(decryption_column, encryption_secrets->dimension, "Decryption circulant column generated:", true);
+    }
+    else if (NULL != encryption_secrets->flat_key_matrix.elements)
+    {
+        log_info("Swapping the key matrix and the inverse key matrix of the mapped key");
+    }
+    else if (NULL != encryption_secrets->inverse_key_matrix)
+    {
+        log_info("Using decryption matrix generated together with the encryption matrix");
+        decryption_matrix = encryption_secrets->inverse_key_matrix;
+        encryption_secrets->inverse_key_matrix = NULL;
+    }
+    else
+    {
+        log_info("Generating decryption matrix...");
+        return_code = generate_decryption_matrix(&decryption_matrix, encryption_secrets->dimension,
+                                               encryption_secrets->key_matrix, encryption_secrets->prime_field);
+        if (STATUS_FAILED(return_code))
+        {
+            log_error("Failed to generate decryption matrix");
+            goto cleanup;
+        }
+    }
+    if (NULL != decryption_matrix)
+    {
+        log_matrix(decryption_matrix, encryption_secrets->dimension, "Decryption matrix generated:", true);
     }
-    log_matrix(decryption_matrix, encryption_secrets->dimension, "Decryption matrix generated:", true);
 
     log_info("Reversing permutation vector...");
     if (encryption_secrets->permutation_vector)
@@ -347,7 +487,11 @@ STATUS_CODE build_decryption_secrets(Secrets** out_secrets, Secrets* encryption_
     decryption_secrets->dimension = encryption_secrets->dimension;
     decryption_secrets->number_of_error_vectors = encryption_secrets->number_of_error_vectors;
     decryption_secrets->prime_field = encryption_secrets->prime_field;
+    decryption_secrets->key_structure = encryption_secrets->key_structure;
     decryption_secrets->key_matrix = decryption_matrix;
+    decryption_matrix = NULL;
+    decryption_secrets->circulant_column = decryption_column;
+    decryption_column = NULL;
     decryption_secrets->error_vectors = encryption_secrets->error_vectors;
     encryption_secrets->error_vectors = NULL;
     decryption_secrets->ascii_mapping = encryption_secrets->ascii_mapping;
@@ -355,6 +499,18 @@ STATUS_CODE build_decryption_secrets(Secrets** out_secrets, Secrets* encryption_
     decryption_secrets->permutation_vector = reversed_permutation_vector;
     decryption_secrets->number_of_letters_for_each_digit_ascii_mapping = encryption_secrets->number_of_letters_for_each_digit_ascii_mapping;
     decryption_secrets->number_of_random_bits_to_add = encryption_secrets->number_of_random_bits_to_add;
+    decryption_secrets->key_seed = encryption_secrets->key_seed;
+    encryption_secrets->key_seed = NULL;
+    decryption_secrets->is_decryption_key = true;
+    decryption_secrets->flat_key_matrix = encryption_secrets->flat_inverse_key_matrix;
+    decryption_secrets->flat_inverse_key_matrix = encryption_secrets->flat_key_matrix;
+    decryption_secrets->combined_error_vector = encryption_secrets->combined_error_vector;
+    decryption_secrets->key_mapping = encryption_secrets->key_mapping;
+    decryption_secrets->key_mapping_size = encryption_secrets->key_mapping_size;
+    memset(&encryption_secrets->flat_key_matrix, 0, sizeof(FieldVector));
+    memset(&encryption_secrets->flat_inverse_key_matrix, 0, sizeof(FieldVector));
+    memset(&encryption_secrets->combined_error_vector, 0, sizeof(FieldVector));
+    encryption_secrets->key_mapping = NULL;
 
     return_code = STATUS_CODE_SUCCESS;
     *out_secrets = decryption_secrets;
@@ -366,6 +522,11 @@ cleanup:
         free_secrets(decryption_secrets);
         free(decryption_secrets);
     }
+    if (NULL != decryption_matrix)
+    {
+        (void)free_int64_matrix(decryption_matrix, encryption_secrets->dimension);
+    }
+    free(decryption_column);
     return return_code;
 }
 
@@ -386,6 +547,7 @@ void free_secrets(Secrets* secrets)
         }
     }
     free(secrets->key_matrix);
+    free(secrets->circulant_column);
     if (secrets->error_vectors != NULL)
     {
         for (index = 0; index < secrets->number_of_error_vectors; ++index)
@@ -403,4 +565,28 @@ void free_secrets(Secrets* secrets)
     }
     free(secrets->ascii_mapping);
     free(secrets->permutation_vector);
+    if (secrets->inverse_key_matrix != NULL)
+    {
+        for (index = 0; index < secrets->dimension; ++index)
+        {
+            free(secrets->inverse_key_matrix[index]);
+        }
+    }
+    free(secrets->inverse_key_matrix);
+    if (secrets->key_seed != NULL)
+    {
+        sodium_memzero(secrets->key_seed, RANDOM_SEED_SIZE);
+    }
+    free(secrets->key_seed);
+    if (secrets->key_mapping != NULL)
+    {
+        unmap_secrets_file(secrets->key_mapping, secrets->key_mapping_size);
+        secrets->key_mapping = NULL;
+    }
+    else
+    {
+        free_field_vector(&secrets->flat_key_matrix);
+        free_field_vector(&secrets->flat_inverse_key_matrix);
+        free_field_vector(&secrets->combined_error_vector);
+    }
 }
@@ -0,0 +1,139 @@
+#include "Secrets/SeededSecrets.h"
+
+bool is_seeded_key_data(const uint8_t* data, uint32_t size)
+{
+    uint32_t magic = 0;
+
+    if ((NULL == data) || (SEEDED_KEY_SIZE != size))
+    {
+        return false;
+    }
+
+    memcpy(&magic, data, sizeof(uint32_t));
+    return SEEDED_KEY_MAGIC == magic;
+}
+
+STATUS_CODE serialize_seeded_secrets(uint8_t** out_data, uint32_t* out_size, Secrets secrets)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint32_t fields[NUMBER_OF_UINT32_SEEDED_KEY_FIELDS];
+    uint8_t* buffer = NULL;
+
+    if (!out_data || !out_size || !secrets.key_seed || (0 == secrets.dimension) || (0 == secrets.number_of_error_vectors))
+    {
+        log_error("[!] Invalid arguments in serialize_seeded_secrets");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    fields[0] = SEEDED_KEY_MAGIC;
+    fields[1] = SEEDED_KEY_VERSION;
+    fields[2] = ((KEY_STRUCTURE_CIRCULANT == secrets.key_structure) ? SEEDED_KEY_FLAG_CIRCULANT : 0) |
+                (secrets.is_decryption_key ? SEEDED_KEY_FLAG_DECRYPTION : 0);
+    fields[3] = secrets.dimension;
+    fields[4] = secrets.number_of_error_vectors;
+    fields[5] = secrets.prime_field;
+    fields[6] = secrets.number_of_letters_for_each_digit_ascii_mapping;
+
+    buffer = (uint8_t*)malloc(SEEDED_KEY_SIZE);
+    if (!buffer)
+    {
+        log_error("[!] Memory allocation failed in serialize_seeded_secrets.");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+    memcpy(buffer, fields, sizeof(fields));
+    memcpy(buffer + sizeof(fields), secrets.key_seed, RANDOM_SEED_SIZE);
+    log_debug("Serialized seeded %s key: dimension=%u, prime_field=%u",
+              secrets.is_decryption_key ? "decryption" : "encryption", secrets.dimension, secrets.prime_field);
+
+    *out_data = buffer;
+    buffer = NULL;
+    *out_size = SEEDED_KEY_SIZE;
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free(buffer);
+    return return_code;
+}
+
+STATUS_CODE deserialize_seeded_secrets(Secrets* out_secrets, const uint8_t* data, uint32_t size)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    uint32_t fields[NUMBER_OF_UINT32_SEEDED_KEY_FIELDS];
+    KeyGenerationArguments arguments = {0};
+    Secrets* encryption_secrets = NULL;
+    Secrets* decryption_secrets = NULL;
+    bool is_decryption_key = false;
+
+    if (!out_secrets || !is_seeded_key_data(data, size))
+    {
+        log_error("[!] Invalid arguments in deserialize_seeded_secrets");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    memcpy(fields, data, sizeof(fields));
+    arguments.dimension = fields[3];
+    arguments.number_of_error_vectors = fields[4];
+    arguments.prime_field = fields[5];
+    arguments.number_of_letters_for_each_digit_ascii_mapping = fields[6];
+    arguments.circulant_key = (0 != (fields[2] & SEEDED_KEY_FLAG_CIRCULANT));
+
+    // The parameters are validated like the full format does, the regeneration must not run on garbage
+    if ((SEEDED_KEY_VERSION != fields[1]) || (0 != (fields[2] & ~SEEDED_KEY_KNOWN_FLAGS)))
+    {
+        log_error("[!] Unsupported seeded key version %u or flags 0x%x", fields[1], fields[2]);
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+    if ((arguments.prime_field < 2) || (0 == arguments.dimension) ||
+        (arguments.dimension > (UINT32_MAX / calculate_digits_per_element(arguments.prime_field))) ||
+        (0 == arguments.number_of_error_vectors) || (arguments.number_of_error_vectors > (UINT32_MAX / arguments.dimension)) ||
+        (0 == arguments.number_of_letters_for_each_digit_ascii_mapping) ||
+        (arguments.circulant_key && !is_ntt_compatible(arguments.dimension, arguments.prime_field)))
+    {
+        log_error("[!] Invalid parameters in seeded key: dimension=%u, prime_field=%u, error_vectors=%u",
+                  arguments.dimension, arguments.prime_field, arguments.number_of_error_vectors);
+        return_code = STATUS_CODE_ERROR_INVALID_SIZE;
+        goto cleanup;
+    }
+
+    is_decryption_key = (0 != (fields[2] & SEEDED_KEY_FLAG_DECRYPTION));
+    log_debug("Regenerating seeded %s key: dimension=%u, prime_field=%u",
+              is_decryption_key ? "decryption" : "encryption", arguments.dimension, arguments.prime_field);
+    return_code = build_encryption_secrets_from_seed(&encryption_secrets, &arguments, data + sizeof(fields), is_decryption_key);
+    if (STATUS_FAILED(return_code))
+    {
+        log_error("[!] Failed to regenerate secrets from seed");
+        goto cleanup;
+    }
+
+    if (is_decryption_key)
+    {
+        return_code = build_decryption_secrets(&decryption_secrets, encryption_secrets);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+        free_secrets(encryption_secrets);
+        free(encryption_secrets);
+        encryption_secrets = decryption_secrets;
+        decryption_secrets = NULL;
+    }
+
+    *out_secrets = *encryption_secrets;
+    free(encryption_secrets);
+    encryption_secrets = NULL;
+
+    increase_metric_counter(METRIC_COUNTER_KEYS_LOADED, 1);
+    set_metric_gauge(METRIC_GAUGE_KEY_DIMENSION, out_secrets->dimension);
+    set_metric_gauge(METRIC_GAUGE_PRIME_FIELD, out_secrets->prime_field);
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free_secrets(encryption_secrets);
+    free(encryption_secrets);
+    free_secrets(decryption_secrets);
+    free(decryption_secrets);
+    return return_code;
+}
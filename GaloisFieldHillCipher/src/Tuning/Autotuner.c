@@ -0,0 +1,648 @@
+#include "Tuning/Autotuner.h"
+
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+typedef SRWLOCK TuningMutex;
+#define TUNING_MUTEX_INITIALIZER SRWLOCK_INIT
+#else
+typedef pthread_mutex_t TuningMutex;
+#define TUNING_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+#endif
+
+#define CPUID_EXTENDED_LEAVES (0x80000000u)
+#define CPUID_BRAND_STRING_FIRST_LEAF (0x80000002u)
+#define CPUID_BRAND_STRING_LEAVES (3)
+#define CPUID_BRAND_STRING_SIZE (48)
+#define PROC_CPUINFO_PATH "/proc/cpuinfo"
+#define PROC_CPUINFO_MODEL_NAME "model name"
+#define UNKNOWN_CPU_MODEL "unknown"
+#define NUMBER_OF_TUNING_CACHE_FIELDS (7)
+
+static const uint32_t g_autotune_batch_sizes[] = {4, 16, 64, 256};
+static const uint32_t g_autotune_thread_counts[] = {2, 3, 4, 6, 8, 12, 16};
+
+// Contexts are prepared concurrently (key store, batch workers), the lookup, tuning and store of a key shape run under the mutex
+static TuningMutex g_tuning_mutex = TUNING_MUTEX_INITIALIZER;
+static const char* g_tuning_cache_file = NULL;
+static bool g_has_tuned_configuration = false;
+static uint32_t g_tuned_dimension = 0;
+static uint32_t g_tuned_prime_field = 0;
+static BlockLoopConfiguration g_tuned_configuration;
+
+static bool read_cpuid_brand_string(char* out_name, size_t size)
+{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    uint32_t registers[CPUID_BRAND_STRING_LEAVES * 4] = {0};
+    char brand_string[CPUID_BRAND_STRING_SIZE + 1] = {0};
+    const char* first_character = brand_string;
+    uint32_t leaf = 0;
+
+#if defined(_M_X64) || defined(_M_IX86)
+    int information[4] = {0};
+    __cpuid(information, (int)CPUID_EXTENDED_LEAVES);
+    if ((uint32_t)information[0] < (CPUID_BRAND_STRING_FIRST_LEAF + CPUID_BRAND_STRING_LEAVES - 1))
+    {
+        return false;
+    }
+    for (leaf = 0; leaf < CPUID_BRAND_STRING_LEAVES; ++leaf)
+    {
+        __cpuid((int*)&registers[leaf * 4], (int)(CPUID_BRAND_STRING_FIRST_LEAF + leaf));
+    }
+#else
+    if (__get_cpuid_max(CPUID_EXTENDED_LEAVES, NULL) < (CPUID_BRAND_STRING_FIRST_LEAF + CPUID_BRAND_STRING_LEAVES - 1))
+    {
+        return false;
+    }
+    for (leaf = 0; leaf < CPUID_BRAND_STRING_LEAVES; ++leaf)
+    {
+        __get_cpuid(CPUID_BRAND_STRING_FIRST_LEAF + leaf, &registers[leaf * 4], &registers[(leaf * 4) + 1],
+                    &registers[(leaf * 4) + 2], &registers[(leaf * 4) + 3]);
+    }
+#endif
+
+    memcpy(brand_string, registers, CPUID_BRAND_STRING_SIZE);
+    while (' ' == *first_character)
+    {
+        ++first_character;
+    }
+    if ('\0' == *first_character)
+    {
+        return false;
+    }
+    strncpy(out_name, first_character, size - 1);
+    out_name[size - 1] = '\0';
+    return true;
+#else
+    (void)out_name;
+    (void)size;
+    return false;
+#endif
+}
+
+static bool read_proc_cpuinfo_model_name(char* out_name, size_t size)
+{
+    char line[TUNING_CACHE_LINE_SIZE] = {0};
+    const char* value = NULL;
+    bool found = false;
+    FILE* cpuinfo = fopen(PROC_CPUINFO_PATH, "r");
+
+    if (NULL == cpuinfo)
+    {
+        return false;
+    }
+
+    while (!found && (NULL != fgets(line, sizeof(line), cpuinfo)))
+    {
+        if ((0 != strncmp(line, PROC_CPUINFO_MODEL_NAME, strlen(PROC_CPUINFO_MODEL_NAME))) || (NULL == (value = strchr(line, ':'))))
+        {
+            continue;
+        }
+        for (++value; ' ' == *value; ++value)
+        {
+        }
+        strncpy(out_name, value, size - 1);
+        out_name[size - 1] = '\0';
+        found = ('\0' != out_name[0]);
+    }
+
+    fclose(cpuinfo);
+    return found;
+}
+
+void get_cpu_model_name(char* out_name, size_t size)
+{
+    size_t index = 0, length = 0;
+
+    if ((NULL == out_name) || (0 == size))
+    {
+        return;
+    }
+
+    if (!read_cpuid_brand_string(out_name, size) && !read_proc_cpuinfo_model_name(out_name, size))
+    {
+        strncpy(out_name, UNKNOWN_CPU_MODEL, size - 1);
+        out_name[size - 1] = '\0';
+    }
+
+    length = strlen(out_name);
+    for (index = 0; index < length; ++index)
+    {
+        if ((TUNING_CACHE_SEPARATOR == out_name[index]) || ('\n' == out_name[index]) || ('\r' == out_name[index]))
+        {
+            out_name[index] = ' ';
+        }
+    }
+    while ((length > 0) && (' ' == out_name[length - 1]))
+    {
+        out_name[--length] = '\0';
+    }
+}
+
+uint32_t get_number_of_hardware_threads(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    return (0 == system_info.dwNumberOfProcessors) ? 1 : (uint32_t)system_info.dwNumberOfProcessors;
+#else
+    long hardware_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    return (hardware_threads < 1) ? 1 : (uint32_t)hardware_threads;
+#endif
+}
+
+void get_host_tuning_key(TuningKey* out_key, uint32_t dimension, uint32_t prime_field)
+{
+    if (NULL == out_key)
+    {
+        return;
+    }
+
+    memset(out_key, 0, sizeof(*out_key));
+    get_cpu_model_name(out_key->cpu_model, sizeof(out_key->cpu_model));
+    out_key->hardware_threads = get_number_of_hardware_threads();
+    out_key->dimension = dimension;
+    out_key->prime_field = prime_field;
+}
+
+static uint64_t next_autotune_random(uint64_t* state)
+{
+    // xorshift64, the samples only need to look like key material, not be secret
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static STATUS_CODE measure_block_loop(uint64_t* out_elapsed_ns, const BlockLoopConfiguration* configuration, const BlockMultiplier* multiplier,
+                                      const uint8_t* blocks, FieldVector* out_blocks, uint32_t number_of_blocks)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    BlockLoop loop = {0};
+    uint64_t start_time = 0, elapsed_time = 0, fastest_time = UINT64_MAX;
+    uint32_t repetition = 0, block_number = 0, chunk_size = 0, blocks_in_chunk = 0;
+
+    return_code = initialize_block_loop(&loop, configuration);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    chunk_size = get_block_loop_chunk_size(&loop);
+
+    // Chunks are multiplied into the same output like the cipher loops do, the first run warms caches and threads up
+    for (repetition = 0; repetition <= AUTOTUNE_REPETITIONS; ++repetition)
+    {
+        start_time = get_monotonic_time_ns();
+        for (block_number = 0; block_number < number_of_blocks; block_number += blocks_in_chunk)
+        {
+            blocks_in_chunk = ((number_of_blocks - block_number) < chunk_size) ? (number_of_blocks - block_number) : chunk_size;
+            return_code = multiply_uint8_t_blocks(out_blocks, &loop, multiplier, blocks + ((size_t)block_number * multiplier->dimension), blocks_in_chunk);
+            if (STATUS_FAILED(return_code))
+            {
+                goto cleanup;
+            }
+        }
+        elapsed_time = get_monotonic_time_ns() - start_time;
+        if ((0 != repetition) && (elapsed_time < fastest_time))
+        {
+            fastest_time = elapsed_time;
+        }
+    }
+
+    log_debug("Autotune candidate %s, batch=%u, threads=%u: %llu ns", get_block_kernel_name(configuration->kernel),
+              configuration->blocks_per_batch, configuration->number_of_threads, (unsigned long long)fastest_time);
+    *out_elapsed_ns = fastest_time;
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free_block_loop(&loop);
+    return return_code;
+}
+
+STATUS_CODE autotune_block_loop(BlockLoopConfiguration* out_configuration, uint32_t dimension, uint32_t prime_field)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    FieldVector flat_matrix = {0};
+    FieldVector offset_vector = {0};
+    FieldVector out_blocks = {0};
+    uint8_t* blocks = NULL;
+    BlockMultiplier multiplier;
+    BlockLoopConfiguration candidate, best;
+    uint64_t elapsed_time = 0, best_time = 0, random_state = 0x9E3779B97F4A7C15ULL;
+    uint64_t sample_blocks = 0;
+    uint32_t hardware_threads = 0, kernel = 0;
+    size_t index = 0;
+
+    if ((NULL == out_configuration) || (0 == dimension) || (prime_field < 2))
+    {
+        log_error("[!] Invalid arguments in autotune_block_loop");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    // Enough blocks for a fixed amount of work per measurement, but always a few chunks worth
+    sample_blocks = AUTOTUNE_MULTIPLY_ADDS_PER_SAMPLE / ((uint64_t)dimension * dimension);
+    sample_blocks = (sample_blocks < AUTOTUNE_MINIMAL_SAMPLE_BLOCKS) ? AUTOTUNE_MINIMAL_SAMPLE_BLOCKS :
+                    (sample_blocks > AUTOTUNE_MAXIMAL_SAMPLE_BLOCKS) ? AUTOTUNE_MAXIMAL_SAMPLE_BLOCKS : sample_blocks;
+
+    return_code = allocate_field_vector(&flat_matrix, dimension * dimension, prime_field);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    return_code = allocate_field_vector(&offset_vector, dimension, prime_field);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    return_code = allocate_field_vector(&out_blocks, (uint32_t)sample_blocks * dimension, prime_field);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+    blocks = (uint8_t*)malloc((size_t)sample_blocks * dimension);
+    if (NULL == blocks)
+    {
+        log_error("[!] Memory allocation failed in autotune_block_loop");
+        return_code = STATUS_CODE_ERROR_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    for (index = 0; index < flat_matrix.length; ++index)
+    {
+        set_field_vector_element(&flat_matrix, index, (uint32_t)(next_autotune_random(&random_state) % prime_field));
+    }
+    for (index = 0; index < offset_vector.length; ++index)
+    {
+        set_field_vector_element(&offset_vector, index, (uint32_t)(next_autotune_random(&random_state) % prime_field));
+    }
+    for (index = 0; index < (size_t)sample_blocks * dimension; ++index)
+    {
+        blocks[index] = (uint8_t)next_autotune_random(&random_state);
+    }
+
+    multiplier.dimension = dimension;
+    multiplier.prime_field = prime_field;
+    multiplier.flat_matrix = &flat_matrix;
+    multiplier.circulant_key = NULL;
+    multiplier.column_tables = NULL;
+    multiplier.offset_vector = &offset_vector;
+
+    log_info("Autotuning block loop: dimension=%u, prime_field=%u, sample=%llu blocks", dimension, prime_field, (unsigned long long)sample_blocks);
+
+    get_default_block_loop_configuration(&best);
+    return_code = measure_block_loop(&best_time, &best, &multiplier, blocks, &out_blocks, (uint32_t)sample_blocks);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    // Kernels and batch sizes on a single thread first
+    for (kernel = BLOCK_KERNEL_BATCHED; kernel < NUMBER_OF_BLOCK_KERNELS; ++kernel)
+    {
+        for (index = 0; index < sizeof(g_autotune_batch_sizes) / sizeof(g_autotune_batch_sizes[0]); ++index)
+        {
+            if (g_autotune_batch_sizes[index] > sample_blocks)
+            {
+                break;
+            }
+            candidate.kernel = (BLOCK_KERNEL)kernel;
+            candidate.blocks_per_batch = g_autotune_batch_sizes[index];
+            candidate.number_of_threads = 1;
+            return_code = measure_block_loop(&elapsed_time, &candidate, &multiplier, blocks, &out_blocks, (uint32_t)sample_blocks);
+            if (STATUS_FAILED(return_code))
+            {
+                goto cleanup;
+            }
+            if (elapsed_time < best_time)
+            {
+                best = candidate;
+                best_time = elapsed_time;
+            }
+        }
+    }
+
+    // Then the single thread winner is scaled over threads, every thread needs at least one batch per chunk
+    hardware_threads = get_number_of_hardware_threads();
+    hardware_threads = (hardware_threads > AUTOTUNE_MAXIMAL_THREADS) ? AUTOTUNE_MAXIMAL_THREADS : hardware_threads;
+    candidate = best;
+    for (index = 0; index < sizeof(g_autotune_thread_counts) / sizeof(g_autotune_thread_counts[0]); ++index)
+    {
+        if ((g_autotune_thread_counts[index] > hardware_threads) ||
+            (((uint64_t)candidate.blocks_per_batch * g_autotune_thread_counts[index]) > sample_blocks))
+        {
+            break;
+        }
+        candidate.number_of_threads = g_autotune_thread_counts[index];
+        return_code = measure_block_loop(&elapsed_time, &candidate, &multiplier, blocks, &out_blocks, (uint32_t)sample_blocks);
+        if (STATUS_FAILED(return_code))
+        {
+            goto cleanup;
+        }
+        if (elapsed_time < best_time)
+        {
+            best = candidate;
+            best_time = elapsed_time;
+        }
+    }
+
+    log_info("Autotuned block loop: kernel=%s, batch=%u, threads=%u (%.2f ns per block)", get_block_kernel_name(best.kernel),
+             best.blocks_per_batch, best.number_of_threads, (double)best_time / (double)sample_blocks);
+    *out_configuration = best;
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    free_field_vector(&flat_matrix);
+    free_field_vector(&offset_vector);
+    free_field_vector(&out_blocks);
+    free(blocks);
+    return return_code;
+}
+
+static bool parse_tuning_cache_number(uint32_t* out_number, const char* text)
+{
+    char* end = NULL;
+    unsigned long number = 0;
+
+    if ('\0' == *text)
+    {
+        return false;
+    }
+    number = strtoul(text, &end, 10);
+    if (('\0' != *end) || (number > UINT32_MAX))
+    {
+        return false;
+    }
+    *out_number = (uint32_t)number;
+    return true;
+}
+
+static bool parse_tuning_cache_line(TuningKey* out_key, BlockLoopConfiguration* out_configuration, char* line)
+{
+    char* fields[NUMBER_OF_TUNING_CACHE_FIELDS] = {0};
+    char* separator = NULL;
+    size_t field = 0;
+
+    line[strcspn(line, "\r\n")] = '\0';
+    fields[0] = line;
+    for (field = 1; field < NUMBER_OF_TUNING_CACHE_FIELDS; ++field)
+    {
+        separator = strchr(fields[field - 1], TUNING_CACHE_SEPARATOR);
+        if (NULL == separator)
+        {
+            return false;
+        }
+        *separator = '\0';
+        fields[field] = separator + 1;
+    }
+
+    memset(out_key, 0, sizeof(*out_key));
+    snprintf(out_key->cpu_model, sizeof(out_key->cpu_model), "%s", fields[0]);
+    return parse_tuning_cache_number(&out_key->hardware_threads, fields[1]) &&
+           parse_tuning_cache_number(&out_key->dimension, fields[2]) &&
+           parse_tuning_cache_number(&out_key->prime_field, fields[3]) &&
+           STATUS_SUCCESS(parse_block_kernel_name(&out_configuration->kernel, fields[4])) &&
+           parse_tuning_cache_number(&out_configuration->blocks_per_batch, fields[5]) &&
+           parse_tuning_cache_number(&out_configuration->number_of_threads, fields[6]) &&
+           STATUS_SUCCESS(validate_block_loop_configuration(out_configuration));
+}
+
+static void lock_tuning(void)
+{
+#ifdef _WIN32
+    AcquireSRWLockExclusive(&g_tuning_mutex);
+#else
+    pthread_mutex_lock(&g_tuning_mutex);
+#endif
+}
+
+static void unlock_tuning(void)
+{
+#ifdef _WIN32
+    ReleaseSRWLockExclusive(&g_tuning_mutex);
+#else
+    pthread_mutex_unlock(&g_tuning_mutex);
+#endif
+}
+
+// Advisory lock of the whole cache file, shard workers are processes that may append to the same cache
+static bool lock_tuning_cache_file(FILE* cache, bool is_locked)
+{
+#ifdef _WIN32
+    HANDLE handle = (HANDLE)_get_osfhandle(_fileno(cache));
+    OVERLAPPED overlapped = {0};
+
+    return is_locked ? (0 != LockFileEx(handle, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped)) :
+                       (0 != UnlockFileEx(handle, 0, MAXDWORD, MAXDWORD, &overlapped));
+#else
+    struct flock lock = {0};
+
+    lock.l_type = is_locked ? F_WRLCK : F_UNLCK;
+    lock.l_whence = SEEK_SET;
+    return 0 == fcntl(fileno(cache), F_SETLKW, &lock);
+#endif
+}
+
+static bool are_tuning_keys_equal(const TuningKey* first, const TuningKey* second)
+{
+    return (0 == strcmp(first->cpu_model, second->cpu_model)) && (first->hardware_threads == second->hardware_threads) &&
+           (first->dimension == second->dimension) && (first->prime_field == second->prime_field);
+}
+
+STATUS_CODE load_tuned_block_loop_configuration(BlockLoopConfiguration* out_configuration, bool* out_found, const char* cache_path, const TuningKey* key)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    char line[TUNING_CACHE_LINE_SIZE] = {0};
+    TuningKey line_key;
+    BlockLoopConfiguration line_configuration;
+    uint32_t line_number = 0;
+    FILE* cache = NULL;
+
+    if ((NULL == out_configuration) || (NULL == out_found) || (NULL == cache_path) || (NULL == key))
+    {
+        log_error("[!] Invalid arguments in load_tuned_block_loop_configuration");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    *out_found = false;
+    cache = fopen(cache_path, "r");
+    if (NULL == cache)
+    {
+        log_debug("Tuning cache %s does not exist yet", cache_path);
+        return_code = STATUS_CODE_SUCCESS;
+        goto cleanup;
+    }
+
+    while (NULL != fgets(line, sizeof(line), cache))
+    {
+        ++line_number;
+        if ((TUNING_CACHE_COMMENT == line[0]) || ('\n' == line[0]) || ('\r' == line[0]))
+        {
+            continue;
+        }
+        if (!parse_tuning_cache_line(&line_key, &line_configuration, line))
+        {
+            log_warn("[!] Skipping malformed line %u of tuning cache %s", line_number, cache_path);
+            continue;
+        }
+        // Re-tuned entries are appended, so the last match is the newest
+        if (are_tuning_keys_equal(&line_key, key))
+        {
+            *out_configuration = line_configuration;
+            *out_found = true;
+        }
+    }
+
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    if (NULL != cache)
+    {
+        fclose(cache);
+    }
+    return return_code;
+}
+
+STATUS_CODE store_tuned_block_loop_configuration(const char* cache_path, const TuningKey* key, const BlockLoopConfiguration* configuration)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    FILE* cache = NULL;
+    bool is_locked = false;
+
+    if ((NULL == cache_path) || (NULL == key) || STATUS_FAILED(validate_block_loop_configuration(configuration)))
+    {
+        log_error("[!] Invalid arguments in store_tuned_block_loop_configuration");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    cache = fopen(cache_path, "a");
+    if (NULL == cache)
+    {
+        log_error("[!] Couldn't open tuning cache %s", cache_path);
+        return_code = STATUS_CODE_COULDNT_OPEN_FILE;
+        goto cleanup;
+    }
+    is_locked = lock_tuning_cache_file(cache, true);
+    if (!is_locked)
+    {
+        log_warn("[!] Couldn't lock tuning cache %s, appending unlocked", cache_path);
+    }
+
+    fseek(cache, 0, SEEK_END);
+    if (0 == ftell(cache))
+    {
+        fputs(TUNING_CACHE_HEADER, cache);
+    }
+    fprintf(cache, "%s%c%u%c%u%c%u%c%s%c%u%c%u\n",
+            key->cpu_model, TUNING_CACHE_SEPARATOR, key->hardware_threads, TUNING_CACHE_SEPARATOR,
+            key->dimension, TUNING_CACHE_SEPARATOR, key->prime_field, TUNING_CACHE_SEPARATOR,
+            get_block_kernel_name(configuration->kernel), TUNING_CACHE_SEPARATOR,
+            configuration->blocks_per_batch, TUNING_CACHE_SEPARATOR, configuration->number_of_threads);
+
+    // Flushed before the lock is dropped, the header check and the line of another process can't interleave with it
+    return_code = ((0 == fflush(cache)) && (0 == ferror(cache))) ? STATUS_CODE_SUCCESS : STATUS_CODE_COULDNT_WRITE_FILE;
+cleanup:
+    if (is_locked)
+    {
+        (void)lock_tuning_cache_file(cache, false);
+    }
+    if (NULL != cache)
+    {
+        fclose(cache);
+    }
+    return return_code;
+}
+
+void set_tuning_cache_file(const char* cache_path)
+{
+    lock_tuning();
+    g_tuning_cache_file = cache_path;
+    g_has_tuned_configuration = false;
+    unlock_tuning();
+}
+
+STATUS_CODE get_block_loop_configuration(BlockLoopConfiguration* out_configuration, uint32_t dimension, uint32_t prime_field)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    BlockLoopConfiguration configuration;
+    TuningKey key;
+    bool found = false, is_locked = false;
+
+    if (NULL == out_configuration)
+    {
+        log_error("[!] Invalid arguments in get_block_loop_configuration");
+        return_code = STATUS_CODE_INVALID_ARGUMENT;
+        goto cleanup;
+    }
+
+    get_default_block_loop_configuration(&configuration);
+    // Held through tuning, threads preparing the same key shape wait for one measurement instead of running their own
+    lock_tuning();
+    is_locked = true;
+    if (NULL == g_tuning_cache_file)
+    {
+        *out_configuration = configuration;
+        return_code = STATUS_CODE_SUCCESS;
+        goto cleanup;
+    }
+
+    // The cache is read once per key shape and process
+    if (g_has_tuned_configuration && (g_tuned_dimension == dimension) && (g_tuned_prime_field == prime_field))
+    {
+        *out_configuration = g_tuned_configuration;
+        return_code = STATUS_CODE_SUCCESS;
+        goto cleanup;
+    }
+
+    get_host_tuning_key(&key, dimension, prime_field);
+    return_code = load_tuned_block_loop_configuration(&configuration, &found, g_tuning_cache_file, &key);
+    if (STATUS_FAILED(return_code))
+    {
+        goto cleanup;
+    }
+
+    if (found)
+    {
+        log_info("Loaded tuned block loop for %s: kernel=%s, batch=%u, threads=%u", key.cpu_model,
+                 get_block_kernel_name(configuration.kernel), configuration.blocks_per_batch, configuration.number_of_threads);
+    }
+    else
+    {
+        return_code = autotune_block_loop(&configuration, dimension, prime_field);
+        if (STATUS_FAILED(return_code))
+        {
+            log_error("[!] Failed to autotune the block loop");
+            goto cleanup;
+        }
+        // A read-only cache still leaves this run tuned
+        if (STATUS_FAILED(store_tuned_block_loop_configuration(g_tuning_cache_file, &key, &configuration)))
+        {
+            log_warn("[!] Couldn't store the tuned block loop in %s", g_tuning_cache_file);
+        }
+    }
+
+    g_tuned_configuration = configuration;
+    g_tuned_dimension = dimension;
+    g_tuned_prime_field = prime_field;
+    g_has_tuned_configuration = true;
+    *out_configuration = configuration;
+    return_code = STATUS_CODE_SUCCESS;
+cleanup:
+    if (is_locked)
+    {
+        unlock_tuning();
+    }
+    return return_code;
+}
@@ -0,0 +1,152 @@
+#include "test_HillCipher.hpp"
+
+#include <vector>
+
+static KeyGenerationArguments make_key_generation_arguments(uint32_t prime_field, bool circulant_key)
+{
+    KeyGenerationArguments arguments = {};
+    arguments.dimension = HILL_CIPHER_TEST_DIMENSION;
+    arguments.number_of_error_vectors = 3;
+    arguments.prime_field = prime_field;
+    arguments.number_of_random_bits_to_add = 2;
+    arguments.number_of_letters_for_each_digit_ascii_mapping = 2;
+    arguments.circulant_key = circulant_key;
+    return arguments;
+}
+
+// Keys are used the way the CLI loads them, through their serialized form
+static hill::Secrets make_encryption_secrets(uint32_t prime_field, bool circulant_key)
+{
+    return hill::Secrets::from_bytes(hill::Secrets::generate(make_key_generation_arguments(prime_field, circulant_key)).to_bytes().span());
+}
+
+static std::vector<uint8_t> make_plaintext()
+{
+    std::vector<uint8_t> plaintext(HILL_CIPHER_TEST_PLAINTEXT_SIZE);
+    for (std::size_t index = 0; index < plaintext.size(); ++index)
+    {
+        plaintext[index] = static_cast<uint8_t>((index * 37) + 11);
+    }
+    return plaintext;
+}
+
+template <uint32_t PrimeField>
+static void assert_fixed_shape_interoperates_with_c_core()
+{
+    // Arrange
+    const std::vector<uint8_t> plaintext = make_plaintext();
+    hill::Secrets encryption_secrets = hill::Secrets::generate(make_key_generation_arguments(PrimeField, false));
+    hill::Secrets decryption_secrets = encryption_secrets.to_decryption_secrets();
+    const hill::HillCipher<HILL_CIPHER_TEST_DIMENSION, PrimeField> encryptor(std::move(encryption_secrets));
+    const hill::HillCipher<HILL_CIPHER_TEST_DIMENSION, PrimeField> decryptor(std::move(decryption_secrets));
+    uint8_t* c_ciphertext = nullptr;
+    uint8_t* c_plaintext = nullptr;
+    uint32_t c_ciphertext_size = 0, c_plaintext_size = 0;
+
+    // Act
+    const hill::Buffer ciphertext = encryptor.encrypt(plaintext);
+    const STATUS_CODE c_decryption_status = deserialize_and_decrypt(&c_plaintext, &c_plaintext_size, const_cast<uint8_t*>(ciphertext.data()),
+                                                                    static_cast<uint32_t>(ciphertext.size()), decryptor.secrets().get(), CIPHERTEXT_FORMAT_BINARY);
+    const STATUS_CODE c_encryption_status = encrypt_and_serialize(&c_ciphertext, &c_ciphertext_size, const_cast<uint8_t*>(plaintext.data()),
+                                                                  static_cast<uint32_t>(plaintext.size()), encryptor.secrets().get(), CIPHERTEXT_FORMAT_BINARY);
+    const hill::Buffer c_ciphertext_buffer(c_ciphertext, c_ciphertext_size);
+    const hill::Buffer c_plaintext_buffer(c_plaintext, c_plaintext_size);
+    const hill::Buffer decrypted = decryptor.decrypt(c_ciphertext_buffer.span());
+
+    // Assert
+    TEST_ASSERT_TRUE(encryptor.uses_fixed_shape_kernels());
+    TEST_ASSERT_TRUE(decryptor.uses_fixed_shape_kernels());
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, c_decryption_status);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, c_encryption_status);
+    TEST_ASSERT_EQUAL(c_ciphertext_size, ciphertext.size());
+    TEST_ASSERT_EQUAL(plaintext.size(), c_plaintext_buffer.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext.data(), c_plaintext_buffer.data(), plaintext.size());
+    TEST_ASSERT_EQUAL(plaintext.size(), decrypted.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext.data(), decrypted.data(), plaintext.size());
+}
+
+void test_HillCipher_FixedShape_InteroperatesWithCCoreForSmallPrime()
+{
+    assert_fixed_shape_interoperates_with_c_core<HILL_CIPHER_TEST_SMALL_PRIME>();
+}
+
+void test_HillCipher_FixedShape_InteroperatesWithCCoreForLargePrime()
+{
+    assert_fixed_shape_interoperates_with_c_core<HILL_CIPHER_TEST_LARGE_PRIME>();
+}
+
+void test_HillCipher_Dynamic_RoundTripsTextFormatAndCirculantKeys()
+{
+    // Arrange
+    const std::vector<uint8_t> plaintext = make_plaintext();
+    hill::Secrets encryption_secrets = make_encryption_secrets(HILL_CIPHER_TEST_SMALL_PRIME, true);
+    hill::Secrets decryption_secrets = encryption_secrets.to_decryption_secrets();
+    const hill::HillCipher<> encryptor(std::move(encryption_secrets));
+    const hill::HillCipher<HILL_CIPHER_TEST_DIMENSION, HILL_CIPHER_TEST_SMALL_PRIME> decryptor(std::move(decryption_secrets));
+
+    // Act
+    const hill::Buffer binary_ciphertext = encryptor.encrypt(plaintext);
+    const hill::Buffer text_ciphertext = encryptor.encrypt(plaintext, hill::Format::Text);
+    const hill::Buffer binary_decrypted = decryptor.decrypt(binary_ciphertext.span());
+    const hill::Buffer text_decrypted = decryptor.decrypt(text_ciphertext.span(), hill::Format::Text);
+
+    // Assert
+    TEST_ASSERT_FALSE(encryptor.uses_fixed_shape_kernels());
+    TEST_ASSERT_FALSE(decryptor.uses_fixed_shape_kernels());
+    TEST_ASSERT_EQUAL(plaintext.size(), binary_decrypted.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext.data(), binary_decrypted.data(), plaintext.size());
+    TEST_ASSERT_EQUAL(plaintext.size(), text_decrypted.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext.data(), text_decrypted.data(), plaintext.size());
+}
+
+void test_HillCipher_FixedShape_RejectsKeyOfAnotherShape()
+{
+    // Arrange
+    hill::Secrets secrets = make_encryption_secrets(HILL_CIPHER_TEST_LARGE_PRIME, false);
+    STATUS_CODE status = STATUS_CODE_SUCCESS;
+
+    // Act
+    try
+    {
+        const hill::HillCipher<HILL_CIPHER_TEST_DIMENSION, HILL_CIPHER_TEST_SMALL_PRIME> cipher(std::move(secrets));
+    }
+    catch (const hill::Error& error)
+    {
+        status = error.status();
+    }
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGUMENT, status);
+}
+
+void test_HillCipher_Move_TransfersOwnership()
+{
+    // Arrange
+    const std::vector<uint8_t> plaintext = make_plaintext();
+    hill::Secrets encryption_secrets = make_encryption_secrets(HILL_CIPHER_TEST_SMALL_PRIME, false);
+    hill::Secrets decryption_secrets = encryption_secrets.to_decryption_secrets();
+    hill::HillCipher<HILL_CIPHER_TEST_DIMENSION, HILL_CIPHER_TEST_SMALL_PRIME> encryptor(std::move(encryption_secrets));
+    const hill::HillCipher<HILL_CIPHER_TEST_DIMENSION, HILL_CIPHER_TEST_SMALL_PRIME> decryptor(std::move(decryption_secrets));
+
+    // Act
+    hill::HillCipher<HILL_CIPHER_TEST_DIMENSION, HILL_CIPHER_TEST_SMALL_PRIME> moved_encryptor(std::move(encryptor));
+    hill::Buffer ciphertext = moved_encryptor.encrypt(plaintext);
+    const hill::Buffer moved_ciphertext(std::move(ciphertext));
+    const hill::Buffer decrypted = decryptor.decrypt(moved_ciphertext.span());
+
+    // Assert
+    TEST_ASSERT_EQUAL(0, encryption_secrets.dimension());
+    TEST_ASSERT_NULL(ciphertext.data());
+    TEST_ASSERT_EQUAL(0, ciphertext.size());
+    TEST_ASSERT_EQUAL(plaintext.size(), decrypted.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext.data(), decrypted.data(), plaintext.size());
+}
+
+void run_all_HillCipher_tests()
+{
+    RUN_TEST(test_HillCipher_FixedShape_InteroperatesWithCCoreForSmallPrime);
+    RUN_TEST(test_HillCipher_FixedShape_InteroperatesWithCCoreForLargePrime);
+    RUN_TEST(test_HillCipher_Dynamic_RoundTripsTextFormatAndCirculantKeys);
+    RUN_TEST(test_HillCipher_FixedShape_RejectsKeyOfAnotherShape);
+    RUN_TEST(test_HillCipher_Move_TransfersOwnership);
+}
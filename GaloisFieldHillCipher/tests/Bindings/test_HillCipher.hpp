@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+
+#include "unity.h"
+#include "Bindings/HillCipher.hpp"
+
+#define HILL_CIPHER_TEST_DIMENSION (8)
+#define HILL_CIPHER_TEST_SMALL_PRIME (257)
+#define HILL_CIPHER_TEST_LARGE_PRIME (65537)
+#define HILL_CIPHER_TEST_PLAINTEXT_SIZE (301)
+
+void run_all_HillCipher_tests();
+
+void test_HillCipher_FixedShape_InteroperatesWithCCoreForSmallPrime();
+void test_HillCipher_FixedShape_InteroperatesWithCCoreForLargePrime();
+void test_HillCipher_Dynamic_RoundTripsTextFormatAndCirculantKeys();
+void test_HillCipher_FixedShape_RejectsKeyOfAnotherShape();
+void test_HillCipher_Move_TransfersOwnership();
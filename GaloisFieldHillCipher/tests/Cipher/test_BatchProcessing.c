@@ -0,0 +1,270 @@
+#include "test_BatchProcessing.h"
+
+#ifdef _WIN32
+#include <direct.h>
+#define make_batch_test_directory(path) _mkdir(path)
+#define remove_batch_test_directory(path) _rmdir(path)
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#define make_batch_test_directory(path) mkdir((path), 0755)
+#define remove_batch_test_directory(path) rmdir(path)
+#endif
+
+static void write_batch_test_key_pair(const char* encryption_key_file, const char* decryption_key_file)
+{
+    KeyGenerationArguments arguments = make_test_key_generation_arguments(BATCH_TEST_DIMENSION, BATCH_TEST_PRIME_FIELD,
+                                                                          BATCH_TEST_NUMBER_OF_ERROR_VECTORS, BATCH_TEST_LETTERS_PER_DIGIT);
+
+    arguments.number_of_random_bits_to_add = 2;
+    write_test_key_pair(&arguments, encryption_key_file, decryption_key_file);
+}
+
+static void write_batch_test_file(const char* path, uint32_t size, uint8_t salt)
+{
+    uint8_t* data = NULL;
+    uint32_t index = 0;
+    FILE* file = NULL;
+
+    if (0 == size)
+    {
+        file = fopen(path, "wb");
+        TEST_ASSERT_NOT_NULL(file);
+        fclose(file);
+        return;
+    }
+    data = (uint8_t*)malloc(size);
+    TEST_ASSERT_NOT_NULL(data);
+    for (index = 0; index < size; ++index)
+    {
+        data[index] = (uint8_t)((index * 31) + salt);
+    }
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, write_uint8_to_file(path, data, size));
+    free(data);
+}
+
+static void assert_batch_test_files_equal(const char* expected_path, const char* actual_path)
+{
+    uint8_t* expected = NULL;
+    uint8_t* actual = NULL;
+    uint32_t expected_size = 0, actual_size = 0;
+
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, read_uint8_from_file(&expected, &expected_size, expected_path));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, read_uint8_from_file(&actual, &actual_size, actual_path));
+    TEST_ASSERT_EQUAL_UINT32(expected_size, actual_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, actual, expected_size);
+    free(expected);
+    free(actual);
+}
+
+static void get_batch_test_configuration(BatchConfiguration* out_configuration, BATCH_DIRECTION direction, size_t in_flight_byte_budget)
+{
+    memset(out_configuration, 0, sizeof(*out_configuration));
+    out_configuration->direction = direction;
+    out_configuration->number_of_threads = BATCH_TEST_NUMBER_OF_THREADS;
+    out_configuration->in_flight_byte_budget = in_flight_byte_budget;
+    out_configuration->key_store_byte_budget = BATCH_TEST_MEMORY_BUDGET;
+    out_configuration->status_output = NULL;
+}
+
+static void write_batch_test_manifest(const char* contents)
+{
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, write_uint8_to_file(BATCH_TEST_MANIFEST_FILE, (const uint8_t*)contents, (uint32_t)strlen(contents)));
+}
+
+void test_BatchProcessing_ManifestWithTwoKeys_RoundTripsEveryFileAndLoadsEachKeyOnce()
+{
+    // Arrange
+    const char* plaintext_files[BATCH_TEST_NUMBER_OF_FILES] = {"batch_test_0.bin", "batch_test_1.txt", "batch_test_2.bin", "batch_test_3.txt", "batch_test_4.bin", "batch_test_5.bin"};
+    const char* ciphertext_files[BATCH_TEST_NUMBER_OF_FILES] = {"batch_test_0.enc.bin", "batch_test_1.enc.txt", "batch_test_2.enc.bin", "batch_test_3.enc.txt", "batch_test_4.enc.bin", "batch_test_5.enc.bin"};
+    const char* decrypted_files[BATCH_TEST_NUMBER_OF_FILES] = {"batch_test_0.dec.bin", "batch_test_1.dec.txt", "batch_test_2.dec.bin", "batch_test_3.dec.txt", "batch_test_4.dec.bin", "batch_test_5.dec.bin"};
+    char manifest[1024] = {0};
+    char line[3 * BATCH_TEST_PATH_LENGTH];
+    BatchJobList jobs = {0};
+    BatchConfiguration configuration;
+    BatchSummary encryption_summary = {0};
+    BatchSummary decryption_summary = {0};
+    uint32_t file = 0;
+    write_batch_test_key_pair("batch_test_key_a.bin", "batch_test_decryption_key_a.bin");
+    write_batch_test_key_pair("batch_test_key_b.bin", "batch_test_decryption_key_b.bin");
+    // Odd files name key b, even files fall back to the default key a
+    strcat(manifest, "# input output key\n\n");
+    for (file = 0; file < BATCH_TEST_NUMBER_OF_FILES; ++file)
+    {
+        write_batch_test_file(plaintext_files[file], (file + 1) * BATCH_TEST_FILE_SIZE_STEP, (uint8_t)file);
+        snprintf(line, sizeof(line), (1 == (file % 2)) ? "%s %s batch_test_key_b.bin\n" : "%s\t%s\n", plaintext_files[file], ciphertext_files[file]);
+        strcat(manifest, line);
+    }
+    write_batch_test_manifest(manifest);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, read_batch_manifest(&jobs, BATCH_TEST_MANIFEST_FILE, "batch_test_key_a.bin"));
+    get_batch_test_configuration(&configuration, BATCH_DIRECTION_ENCRYPT, BATCH_TEST_MEMORY_BUDGET);
+
+    // Act
+    STATUS_CODE encryption_return_code = run_batch(&encryption_summary, &jobs, &configuration);
+    free_batch_jobs(&jobs);
+    manifest[0] = '\0';
+    for (file = 0; file < BATCH_TEST_NUMBER_OF_FILES; ++file)
+    {
+        snprintf(line, sizeof(line), "%s %s batch_test_decryption_key_%c.bin\n", ciphertext_files[file], decrypted_files[file], (1 == (file % 2)) ? 'b' : 'a');
+        strcat(manifest, line);
+    }
+    write_batch_test_manifest(manifest);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, read_batch_manifest(&jobs, BATCH_TEST_MANIFEST_FILE, NULL));
+    configuration.direction = BATCH_DIRECTION_DECRYPT;
+    STATUS_CODE decryption_return_code = run_batch(&decryption_summary, &jobs, &configuration);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, encryption_return_code);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, decryption_return_code);
+    TEST_ASSERT_EQUAL_UINT32(BATCH_TEST_NUMBER_OF_FILES, encryption_summary.succeeded);
+    TEST_ASSERT_EQUAL_UINT32(BATCH_TEST_NUMBER_OF_FILES, decryption_summary.succeeded);
+    TEST_ASSERT_EQUAL_UINT64(2, encryption_summary.key_store_statistics.misses); // Each key is prepared once for the whole batch
+    TEST_ASSERT_EQUAL_UINT64(BATCH_TEST_NUMBER_OF_FILES - 2, encryption_summary.key_store_statistics.hits);
+    TEST_ASSERT_EQUAL_UINT64(encryption_summary.bytes_out, decryption_summary.bytes_in);
+    TEST_ASSERT_EQUAL_UINT64(encryption_summary.bytes_in, decryption_summary.bytes_out);
+    for (file = 0; file < BATCH_TEST_NUMBER_OF_FILES; ++file)
+    {
+        assert_batch_test_files_equal(plaintext_files[file], decrypted_files[file]);
+        remove(plaintext_files[file]);
+        remove(ciphertext_files[file]);
+        remove(decrypted_files[file]);
+    }
+
+    free_batch_jobs(&jobs);
+    remove(BATCH_TEST_MANIFEST_FILE);
+    remove("batch_test_key_a.bin");
+    remove("batch_test_key_b.bin");
+    remove("batch_test_decryption_key_a.bin");
+    remove("batch_test_decryption_key_b.bin");
+}
+
+void test_BatchProcessing_ManifestLineWithoutKey_IsRejected()
+{
+    // Arrange
+    BatchJobList jobs = {0};
+    write_batch_test_manifest("with spaces.bin\tout put.bin\tkey.bin\nno_key.bin no_key_out.bin\n");
+
+    // Act
+    STATUS_CODE return_code = read_batch_manifest(&jobs, BATCH_TEST_MANIFEST_FILE, NULL);
+    STATUS_CODE default_key_return_code = read_batch_manifest(&jobs, BATCH_TEST_MANIFEST_FILE, "default.bin");
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGUMENT, return_code);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, default_key_return_code);
+    TEST_ASSERT_EQUAL_UINT32(2, jobs.number_of_jobs);
+    TEST_ASSERT_EQUAL_STRING("with spaces.bin", jobs.jobs[0].input_file);
+    TEST_ASSERT_EQUAL_STRING("out put.bin", jobs.jobs[0].output_file);
+    TEST_ASSERT_EQUAL_STRING("key.bin", jobs.jobs[0].key_file);
+    TEST_ASSERT_EQUAL_STRING("default.bin", jobs.jobs[1].key_file);
+
+    free_batch_jobs(&jobs);
+    remove(BATCH_TEST_MANIFEST_FILE);
+}
+
+void test_BatchProcessing_DirectoryWithEmptyFile_ReportsItAndProcessesTheOthers()
+{
+    // Arrange
+    const char* names[3] = {"a.bin", "b.bin", "c.txt"};
+    char input_path[BATCH_TEST_PATH_LENGTH];
+    char output_path[BATCH_TEST_PATH_LENGTH];
+    BatchJobList jobs = {0};
+    BatchConfiguration configuration;
+    BatchSummary summary = {0};
+    uint32_t file = 0;
+    write_batch_test_key_pair("batch_test_key_a.bin", "batch_test_decryption_key_a.bin");
+    make_batch_test_directory(BATCH_TEST_DIRECTORY);
+    make_batch_test_directory(BATCH_TEST_OUTPUT_DIRECTORY);
+    for (file = 0; file < 3; ++file)
+    {
+        snprintf(input_path, sizeof(input_path), "%s/%s", BATCH_TEST_DIRECTORY, names[file]);
+        write_batch_test_file(input_path, (1 == file) ? 0 : BATCH_TEST_FILE_SIZE_STEP, (uint8_t)file); // b.bin is empty
+    }
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, list_batch_directory(&jobs, BATCH_TEST_DIRECTORY, BATCH_TEST_OUTPUT_DIRECTORY, "batch_test_key_a.bin"));
+    get_batch_test_configuration(&configuration, BATCH_DIRECTION_ENCRYPT, BATCH_TEST_MEMORY_BUDGET);
+
+    // Act
+    STATUS_CODE return_code = run_batch(&summary, &jobs, &configuration);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_BATCH_FILES_FAILED, return_code);
+    TEST_ASSERT_EQUAL_UINT32(3, jobs.number_of_jobs);
+    TEST_ASSERT_EQUAL_STRING(BATCH_TEST_DIRECTORY "/a.bin", jobs.jobs[0].input_file); // Sorted by name
+    TEST_ASSERT_EQUAL_STRING(BATCH_TEST_OUTPUT_DIRECTORY "/c.txt", jobs.jobs[2].output_file);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, jobs.jobs[0].status);
+    TEST_ASSERT_NOT_EQUAL(STATUS_CODE_SUCCESS, jobs.jobs[1].status);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, jobs.jobs[2].status);
+    TEST_ASSERT_EQUAL_UINT32(2, summary.succeeded);
+    TEST_ASSERT_EQUAL_UINT32(1, summary.failed);
+
+    free_batch_jobs(&jobs);
+    for (file = 0; file < 3; ++file)
+    {
+        snprintf(input_path, sizeof(input_path), "%s/%s", BATCH_TEST_DIRECTORY, names[file]);
+        snprintf(output_path, sizeof(output_path), "%s/%s", BATCH_TEST_OUTPUT_DIRECTORY, names[file]);
+        remove(input_path);
+        remove(output_path);
+    }
+    remove_batch_test_directory(BATCH_TEST_DIRECTORY);
+    remove_batch_test_directory(BATCH_TEST_OUTPUT_DIRECTORY);
+    remove("batch_test_key_a.bin");
+    remove("batch_test_decryption_key_a.bin");
+}
+
+void test_BatchProcessing_BudgetBelowOneFile_KeepsOneFileInFlight()
+{
+    // Arrange
+    char input_path[BATCH_TEST_PATH_LENGTH];
+    char output_path[BATCH_TEST_PATH_LENGTH];
+    char manifest[1024] = {0};
+    char line[3 * BATCH_TEST_PATH_LENGTH];
+    BatchJobList jobs = {0};
+    BatchConfiguration configuration;
+    BatchSummary summary = {0};
+    size_t largest_job = 0, job_size = 0;
+    uint32_t file = 0;
+    write_batch_test_key_pair("batch_test_key_a.bin", "batch_test_decryption_key_a.bin");
+    for (file = 0; file < BATCH_TEST_NUMBER_OF_FILES; ++file)
+    {
+        snprintf(input_path, sizeof(input_path), "batch_test_budget_%u.bin", file);
+        snprintf(output_path, sizeof(output_path), "batch_test_budget_%u.enc.bin", file);
+        write_batch_test_file(input_path, (file + 1) * BATCH_TEST_FILE_SIZE_STEP, (uint8_t)file);
+        snprintf(line, sizeof(line), "%s %s\n", input_path, output_path);
+        strcat(manifest, line);
+    }
+    write_batch_test_manifest(manifest);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, read_batch_manifest(&jobs, BATCH_TEST_MANIFEST_FILE, "batch_test_key_a.bin"));
+    get_batch_test_configuration(&configuration, BATCH_DIRECTION_ENCRYPT, 1);
+
+    // Act
+    STATUS_CODE return_code = run_batch(&summary, &jobs, &configuration);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, return_code);
+    TEST_ASSERT_EQUAL_UINT32(BATCH_TEST_NUMBER_OF_FILES, summary.succeeded);
+    for (file = 0; file < BATCH_TEST_NUMBER_OF_FILES; ++file)
+    {
+        // A binary encryption reserves its input, its ciphertext and one byte
+        job_size = (size_t)jobs.jobs[file].input_size + jobs.jobs[file].output_size + 1;
+        largest_job = (job_size > largest_job) ? job_size : largest_job;
+    }
+    TEST_ASSERT_TRUE(summary.peak_in_flight_bytes > 0);
+    TEST_ASSERT_TRUE(summary.peak_in_flight_bytes <= largest_job);
+
+    for (file = 0; file < BATCH_TEST_NUMBER_OF_FILES; ++file)
+    {
+        remove(jobs.jobs[file].input_file);
+        remove(jobs.jobs[file].output_file);
+    }
+    free_batch_jobs(&jobs);
+    remove(BATCH_TEST_MANIFEST_FILE);
+    remove("batch_test_key_a.bin");
+    remove("batch_test_decryption_key_a.bin");
+}
+
+void run_all_BatchProcessing_tests()
+{
+    RUN_TEST(test_BatchProcessing_ManifestWithTwoKeys_RoundTripsEveryFileAndLoadsEachKeyOnce);
+    RUN_TEST(test_BatchProcessing_ManifestLineWithoutKey_IsRejected);
+    RUN_TEST(test_BatchProcessing_DirectoryWithEmptyFile_ReportsItAndProcessesTheOthers);
+    RUN_TEST(test_BatchProcessing_BudgetBelowOneFile_KeepsOneFileInFlight);
+}
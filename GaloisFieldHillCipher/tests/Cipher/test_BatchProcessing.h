@@ -0,0 +1,33 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "TestSecrets.h"
+#include "Cipher/BatchProcessing.h"
+#include "Cipher/Cipher.h"
+#include "Secrets/SecretsGeneration.h"
+#include "IO/FileOperations.h"
+#include "IO/SerDes.h"
+
+#define BATCH_TEST_DIMENSION (8)
+#define BATCH_TEST_PRIME_FIELD (257)
+#define BATCH_TEST_NUMBER_OF_ERROR_VECTORS (3)
+#define BATCH_TEST_LETTERS_PER_DIGIT (3)
+#define BATCH_TEST_NUMBER_OF_FILES (6)
+#define BATCH_TEST_NUMBER_OF_THREADS (3)
+#define BATCH_TEST_FILE_SIZE_STEP (300)
+#define BATCH_TEST_MEMORY_BUDGET ((size_t)1 << 24)
+#define BATCH_TEST_PATH_LENGTH (64)
+#define BATCH_TEST_MANIFEST_FILE "batch_test_manifest.txt"
+#define BATCH_TEST_DIRECTORY "batch_test_input"
+#define BATCH_TEST_OUTPUT_DIRECTORY "batch_test_output"
+
+void run_all_BatchProcessing_tests();
+
+void test_BatchProcessing_ManifestWithTwoKeys_RoundTripsEveryFileAndLoadsEachKeyOnce();
+void test_BatchProcessing_ManifestLineWithoutKey_IsRejected();
+void test_BatchProcessing_DirectoryWithEmptyFile_ReportsItAndProcessesTheOthers();
+void test_BatchProcessing_BudgetBelowOneFile_KeepsOneFileInFlight();
@@ -0,0 +1,229 @@
+#include "test_CipherPipeline.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+struct SpscQueueTestProducer {
+    SpscQueue* queue;
+    uint32_t failures;
+} typedef SpscQueueTestProducer;
+
+#ifdef _WIN32
+static DWORD WINAPI spsc_queue_test_producer(LPVOID argument)
+#else
+static void* spsc_queue_test_producer(void* argument)
+#endif
+{
+    SpscQueueTestProducer* producer = (SpscQueueTestProducer*)argument;
+    uintptr_t item = 0;
+
+    for (item = 1; item <= CIPHER_PIPELINE_TEST_TRANSFERRED_ITEMS; ++item)
+    {
+        if (STATUS_FAILED(push_spsc_queue(producer->queue, (void*)item)))
+        {
+            ++producer->failures;
+        }
+    }
+    return 0;
+}
+
+static void fill_pipeline_test_plaintext(uint8_t* plaintext, uint32_t plaintext_size)
+{
+    uint32_t index = 0;
+
+    for (index = 0; index < plaintext_size; ++index)
+    {
+        plaintext[index] = (uint8_t)((index * 89) ^ (index >> 9));
+    }
+}
+
+static Secrets* generate_pipeline_test_secrets(uint32_t dimension, uint32_t prime_field, uint32_t number_of_random_bits)
+{
+    KeyGenerationArguments arguments = make_test_key_generation_arguments(dimension, prime_field, 3, 2);
+
+    arguments.number_of_random_bits_to_add = number_of_random_bits;
+    return generate_test_secrets(&arguments);
+}
+
+/**
+ * @brief Encrypts a plaintext on the pipeline under a new key and decrypts it back with decrypt_stream_with_context.
+ */
+static void run_pipelined_stream_roundtrip(const uint8_t* plaintext, uint32_t plaintext_size, uint32_t dimension, uint32_t prime_field,
+    uint32_t number_of_random_bits, CIPHERTEXT_FORMAT format)
+{
+    Secrets* encryption_secrets = generate_pipeline_test_secrets(dimension, prime_field, number_of_random_bits);
+    Secrets* decryption_secrets = NULL;
+    CipherContext encryption_context = {0};
+    CipherContext decryption_context = {0};
+    FILE* input = tmpfile();
+    FILE* ciphertext = tmpfile();
+    FILE* output = tmpfile();
+    uint64_t bytes_read = 0, bytes_written = 0, ciphertext_bytes_read = 0, plaintext_bytes_written = 0;
+    uint8_t* decrypted = (uint8_t*)malloc(plaintext_size + 1);
+    TEST_ASSERT_NOT_NULL(input);
+    TEST_ASSERT_NOT_NULL(ciphertext);
+    TEST_ASSERT_NOT_NULL(output);
+    TEST_ASSERT_NOT_NULL(decrypted);
+    TEST_ASSERT_EQUAL_UINT64(plaintext_size, fwrite(plaintext, 1, plaintext_size, input));
+    rewind(input);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, prepare_cipher_context(&encryption_context, encryption_secrets));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_decryption_secrets(&decryption_secrets, encryption_secrets));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, prepare_cipher_context(&decryption_context, decryption_secrets));
+
+    // Act
+    STATUS_CODE return_code = encrypt_stream_pipelined_with_context(ciphertext, input, &encryption_context, format, &bytes_read, &bytes_written);
+    rewind(ciphertext);
+    STATUS_CODE decryption_return_code = decrypt_stream_with_context(output, ciphertext, &decryption_context, format, ASYNC_IO_BACKEND_THREADS,
+        &ciphertext_bytes_read, &plaintext_bytes_written);
+    rewind(output);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, return_code);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, decryption_return_code);
+    TEST_ASSERT_EQUAL_UINT64(plaintext_size, bytes_read);
+    TEST_ASSERT_EQUAL_UINT64(bytes_written, ciphertext_bytes_read);
+    TEST_ASSERT_EQUAL_UINT64(plaintext_size, plaintext_bytes_written);
+    TEST_ASSERT_EQUAL_UINT64(plaintext_size, fread(decrypted, 1, plaintext_size + 1, output));
+    if (0 != plaintext_size)
+    {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, decrypted, plaintext_size);
+    }
+
+    fclose(input);
+    fclose(ciphertext);
+    fclose(output);
+    free_cipher_context(&encryption_context);
+    free_cipher_context(&decryption_context);
+    free_test_secrets(encryption_secrets);
+    free_test_secrets(decryption_secrets);
+    free(decrypted);
+}
+
+void test_SpscQueue_PushUntilFull_PopsInOrder()
+{
+    // Arrange
+    SpscQueue* queue = NULL;
+    void* item = NULL;
+    uintptr_t expected_item = 0;
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, create_spsc_queue(&queue, CIPHER_PIPELINE_TEST_QUEUE_CAPACITY, NULL));
+
+    // Act
+    for (expected_item = 1; expected_item <= CIPHER_PIPELINE_TEST_QUEUE_CAPACITY; ++expected_item)
+    {
+        TEST_ASSERT_TRUE(try_push_spsc_queue(queue, (void*)expected_item));
+    }
+    bool is_pushed_when_full = try_push_spsc_queue(queue, (void*)expected_item);
+
+    // Assert
+    TEST_ASSERT_FALSE(is_pushed_when_full);
+    for (expected_item = 1; expected_item <= CIPHER_PIPELINE_TEST_QUEUE_CAPACITY; ++expected_item)
+    {
+        TEST_ASSERT_TRUE(try_pop_spsc_queue(&item, queue));
+        TEST_ASSERT_EQUAL_PTR((void*)expected_item, item);
+    }
+    TEST_ASSERT_FALSE(try_pop_spsc_queue(&item, queue));
+
+    free_spsc_queue(&queue);
+    TEST_ASSERT_NULL(queue);
+}
+
+void test_SpscQueue_Aborted_ReleasesWaitingPop()
+{
+    // Arrange
+    SpscQueue* queue = NULL;
+    uint64_t aborted = 1;
+    void* item = NULL;
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, create_spsc_queue(&queue, CIPHER_PIPELINE_TEST_QUEUE_CAPACITY, &aborted));
+
+    // Act
+    STATUS_CODE return_code = pop_spsc_queue(&item, queue);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_PIPELINE_ABORTED, return_code);
+    TEST_ASSERT_NULL(item);
+
+    free_spsc_queue(&queue);
+}
+
+void test_SpscQueue_ProducerAndConsumerThreads_TransferEveryItemInOrder()
+{
+    // Arrange
+    SpscQueueTestProducer producer = {0};
+    uintptr_t expected_item = 0;
+    uint32_t out_of_order_items = 0;
+    void* item = NULL;
+#ifdef _WIN32
+    HANDLE thread = NULL;
+#else
+    pthread_t thread;
+#endif
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, create_spsc_queue(&producer.queue, CIPHER_PIPELINE_TEST_QUEUE_CAPACITY, NULL));
+
+    // Act
+#ifdef _WIN32
+    thread = CreateThread(NULL, 0, spsc_queue_test_producer, &producer, 0, NULL);
+    TEST_ASSERT_NOT_NULL(thread);
+#else
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, spsc_queue_test_producer, &producer));
+#endif
+    for (expected_item = 1; expected_item <= CIPHER_PIPELINE_TEST_TRANSFERRED_ITEMS; ++expected_item)
+    {
+        TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, pop_spsc_queue(&item, producer.queue));
+        if ((void*)expected_item != item)
+        {
+            ++out_of_order_items;
+        }
+    }
+#ifdef _WIN32
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT32(0, producer.failures);
+    TEST_ASSERT_EQUAL_UINT32(0, out_of_order_items);
+    TEST_ASSERT_FALSE(try_pop_spsc_queue(&item, producer.queue));
+
+    free_spsc_queue(&producer.queue);
+}
+
+void test_encrypt_stream_pipelined_with_context_SeveralChunks_DecryptsInOnePass()
+{
+    // Arrange
+    uint8_t* plaintext = (uint8_t*)malloc(CIPHER_PIPELINE_TEST_PLAINTEXT_SIZE);
+    TEST_ASSERT_NOT_NULL(plaintext);
+    fill_pipeline_test_plaintext(plaintext, CIPHER_PIPELINE_TEST_PLAINTEXT_SIZE);
+
+    // Act & Assert
+    run_pipelined_stream_roundtrip(plaintext, CIPHER_PIPELINE_TEST_PLAINTEXT_SIZE, 5, 65537, 3, CIPHERTEXT_FORMAT_BINARY);
+
+    free(plaintext);
+}
+
+void test_encrypt_stream_pipelined_with_context_TextAndEmpty_DecryptAsStreams()
+{
+    // Arrange
+    uint8_t* plaintext = (uint8_t*)malloc(CIPHER_PIPELINE_TEST_PLAINTEXT_SIZE);
+    TEST_ASSERT_NOT_NULL(plaintext);
+    fill_pipeline_test_plaintext(plaintext, CIPHER_PIPELINE_TEST_PLAINTEXT_SIZE);
+
+    // Act & Assert
+    run_pipelined_stream_roundtrip(plaintext, CIPHER_PIPELINE_TEST_PLAINTEXT_SIZE, 4, 257, 0, CIPHERTEXT_FORMAT_TEXT);
+    run_pipelined_stream_roundtrip(plaintext, 0, 8, 65537, 2, CIPHERTEXT_FORMAT_BINARY);
+
+    free(plaintext);
+}
+
+void run_all_CipherPipeline_tests()
+{
+    RUN_TEST(test_SpscQueue_PushUntilFull_PopsInOrder);
+    RUN_TEST(test_SpscQueue_Aborted_ReleasesWaitingPop);
+    RUN_TEST(test_SpscQueue_ProducerAndConsumerThreads_TransferEveryItemInOrder);
+    RUN_TEST(test_encrypt_stream_pipelined_with_context_SeveralChunks_DecryptsInOnePass);
+    RUN_TEST(test_encrypt_stream_pipelined_with_context_TextAndEmpty_DecryptAsStreams);
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "TestSecrets.h"
+#include "Cipher/CipherPipeline.h"
+#include "Cipher/SpscQueue.h"
+#include "Cipher/Cipher.h"
+#include "Secrets/SecretsGeneration.h"
+
+#define CIPHER_PIPELINE_TEST_QUEUE_CAPACITY (4)
+#define CIPHER_PIPELINE_TEST_TRANSFERRED_ITEMS (100000)
+#define CIPHER_PIPELINE_TEST_PLAINTEXT_SIZE ((3 * CIPHER_STREAM_CHUNK_SIZE) + 77) // Three full chunks and a partial one
+
+void run_all_CipherPipeline_tests();
+
+void test_SpscQueue_PushUntilFull_PopsInOrder();
+void test_SpscQueue_Aborted_ReleasesWaitingPop();
+void test_SpscQueue_ProducerAndConsumerThreads_TransferEveryItemInOrder();
+void test_encrypt_stream_pipelined_with_context_SeveralChunks_DecryptsInOnePass();
+void test_encrypt_stream_pipelined_with_context_TextAndEmpty_DecryptAsStreams();
@@ -123,6 +123,25 @@ void test_remove_padding_InvalidPadding()
     free(output);
 }
 
+void test_remove_padding_MagicInsideData()
+{
+    // Arrange
+    uint8_t input[] = {PADDING_MAGIC, 2, PADDING_MAGIC, 4, PADDING_MAGIC, 0x00, 0x00, 0x00};
+    uint32_t input_bit_length = sizeof(input) * BYTE_SIZE;
+    uint8_t* output = NULL;
+    uint32_t output_bit_length = 0;
+
+    // Act
+    STATUS_CODE status = remove_padding(&output, &output_bit_length, input, input_bit_length);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, status);
+    TEST_ASSERT_EQUAL(4 * BYTE_SIZE, output_bit_length);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(input, output, 4);
+
+    free(output);
+}
+
 void test_pad_to_length_BlockSize1()
 {
     // Arrange
@@ -381,6 +400,341 @@ void test_ascii_mapping_sanity()
     free(decoded);
 }
 
+static void run_encrypt_and_serialize_roundtrip(CIPHERTEXT_FORMAT format)
+{
+    // Arrange
+    uint8_t plaintext[] = {0x00, PADDING_MAGIC, 0xFF, 'H', 'i', 'l', 'l', PADDING_MAGIC, 0x00, 0x80, 0x01};
+    uint32_t plaintext_size = sizeof(plaintext);
+    KeyGenerationArguments key_generation_arguments = {NULL, 3, 2, 16777619, 3, 2};
+    Secrets* encryption_secrets = NULL;
+    Secrets* decryption_secrets = NULL;
+    uint8_t* ciphertext = NULL;
+    uint32_t ciphertext_size = 0;
+    uint8_t* decrypted = NULL;
+    uint32_t decrypted_size = 0;
+    STATUS_CODE encryption_status = STATUS_CODE_UNINITIALIZED;
+    STATUS_CODE decryption_status = STATUS_CODE_UNINITIALIZED;
+
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_encryption_secrets(&encryption_secrets, &key_generation_arguments));
+
+    // Act
+    encryption_status = encrypt_and_serialize(&ciphertext, &ciphertext_size, plaintext, plaintext_size,
+                                              *encryption_secrets, format);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_decryption_secrets(&decryption_secrets, encryption_secrets));
+    decryption_status = deserialize_and_decrypt(&decrypted, &decrypted_size, ciphertext, ciphertext_size,
+                                                *decryption_secrets, format);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, encryption_status);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, decryption_status);
+    TEST_ASSERT_EQUAL(plaintext_size, decrypted_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, decrypted, plaintext_size);
+
+    free_secrets(encryption_secrets);
+    free(encryption_secrets);
+    free_secrets(decryption_secrets);
+    free(decryption_secrets);
+    free(ciphertext);
+    free(decrypted);
+}
+
+void test_encrypt_and_serialize_BinaryRoundtrip()
+{
+    run_encrypt_and_serialize_roundtrip(CIPHERTEXT_FORMAT_BINARY);
+}
+
+void test_encrypt_and_serialize_TextRoundtrip()
+{
+    run_encrypt_and_serialize_roundtrip(CIPHERTEXT_FORMAT_TEXT);
+}
+
+static void run_rekey_serialized_ciphertext_roundtrip(CIPHERTEXT_FORMAT input_format, CIPHERTEXT_FORMAT output_format)
+{
+    // Arrange
+    uint8_t plaintext[] = {'R', 'e', 'k', 'e', 'y', PADDING_MAGIC, 0x00, 0xFF, 0x80, 0x01};
+    uint32_t plaintext_size = sizeof(plaintext);
+    KeyGenerationArguments key_generation_arguments = {NULL, 4, 2, 65537, 3, 2};
+    Secrets* old_encryption_secrets = NULL;
+    Secrets* old_decryption_secrets = NULL;
+    Secrets* new_encryption_secrets = NULL;
+    Secrets* new_decryption_secrets = NULL;
+    uint8_t* ciphertext = NULL;
+    uint32_t ciphertext_size = 0;
+    uint8_t* rekeyed_ciphertext = NULL;
+    uint32_t rekeyed_ciphertext_size = 0;
+    uint8_t* decrypted = NULL;
+    uint32_t decrypted_size = 0;
+    STATUS_CODE rekey_status = STATUS_CODE_UNINITIALIZED;
+
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_encryption_secrets(&old_encryption_secrets, &key_generation_arguments));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, encrypt_and_serialize(&ciphertext, &ciphertext_size, plaintext, plaintext_size,
+                                                                 *old_encryption_secrets, input_format));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_decryption_secrets(&old_decryption_secrets, old_encryption_secrets));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_encryption_secrets(&new_encryption_secrets, &key_generation_arguments));
+
+    // Act
+    rekey_status = rekey_serialized_ciphertext(&rekeyed_ciphertext, &rekeyed_ciphertext_size, ciphertext, ciphertext_size,
+                                               *old_decryption_secrets, *new_encryption_secrets, input_format, output_format);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, rekey_status);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_decryption_secrets(&new_decryption_secrets, new_encryption_secrets));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, deserialize_and_decrypt(&decrypted, &decrypted_size, rekeyed_ciphertext, rekeyed_ciphertext_size,
+                                                                   *new_decryption_secrets, output_format));
+    TEST_ASSERT_EQUAL(plaintext_size, decrypted_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, decrypted, plaintext_size);
+
+    free_secrets(old_encryption_secrets);
+    free(old_encryption_secrets);
+    free_secrets(old_decryption_secrets);
+    free(old_decryption_secrets);
+    free_secrets(new_encryption_secrets);
+    free(new_encryption_secrets);
+    free_secrets(new_decryption_secrets);
+    free(new_decryption_secrets);
+    free(ciphertext);
+    free(rekeyed_ciphertext);
+    free(decrypted);
+}
+
+void test_rekey_serialized_ciphertext_BinaryToText()
+{
+    run_rekey_serialized_ciphertext_roundtrip(CIPHERTEXT_FORMAT_BINARY, CIPHERTEXT_FORMAT_TEXT);
+}
+
+void test_rekey_serialized_ciphertext_TextToBinary()
+{
+    run_rekey_serialized_ciphertext_roundtrip(CIPHERTEXT_FORMAT_TEXT, CIPHERTEXT_FORMAT_BINARY);
+}
+
+static STATUS_CODE deserialize_test_key_with_header(uint32_t prime_field, bool keep_header, uint32_t version, uint32_t* out_dimension)
+{
+    KeyGenerationArguments key_generation_arguments = {NULL, 3, 2, prime_field, 3, 2};
+    Secrets* secrets = NULL;
+    Secrets loaded_secrets = {0};
+    uint8_t* key_data = NULL;
+    uint32_t key_size = 0;
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_encryption_secrets(&secrets, &key_generation_arguments));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, serialize_secrets(&key_data, &key_size, *secrets));
+    if (keep_header)
+    {
+        memcpy(key_data + sizeof(uint32_t), &version, sizeof(uint32_t));
+    }
+    else
+    {
+        // A file written before the format header, the parameters start the file
+        key_size -= FULL_KEY_HEADER_SIZE;
+        memmove(key_data, key_data + FULL_KEY_HEADER_SIZE, key_size);
+    }
+
+    return_code = deserialize_secrets(&loaded_secrets, key_data, key_size);
+    *out_dimension = loaded_secrets.dimension;
+
+    if (STATUS_SUCCESS(return_code))
+    {
+        free_secrets(&loaded_secrets);
+    }
+    free_secrets(secrets);
+    free(secrets);
+    free(key_data);
+    return return_code;
+}
+
+void test_deserialize_secrets_CurrentVersion_Loads()
+{
+    // Arrange
+    uint32_t dimension = 0;
+
+    // Act & Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, deserialize_test_key_with_header(257, true, FULL_KEY_VERSION, &dimension));
+    TEST_ASSERT_EQUAL_UINT32(3, dimension);
+}
+
+void test_deserialize_secrets_UnknownVersion_IsRejected()
+{
+    // Arrange
+    uint32_t dimension = 0;
+
+    // Act & Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_UNSUPPORTED_KEY_FORMAT, deserialize_test_key_with_header(257, true, FULL_KEY_VERSION + 1, &dimension));
+}
+
+void test_deserialize_secrets_HeaderlessKey_LoadsOnlyWithUnchangedWidth()
+{
+    // Arrange
+    uint32_t dimension = 0;
+
+    // Act & Assert - GF(65521) elements took 16 bits before and after, GF(257) and GF(16777619) elements gained a byte
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, deserialize_test_key_with_header(65521, false, 0, &dimension));
+    TEST_ASSERT_EQUAL_UINT32(3, dimension);
+    TEST_ASSERT_EQUAL(STATUS_CODE_UNSUPPORTED_KEY_FORMAT, deserialize_test_key_with_header(257, false, 0, &dimension));
+    TEST_ASSERT_EQUAL(STATUS_CODE_UNSUPPORTED_KEY_FORMAT, deserialize_test_key_with_header(16777619, false, 0, &dimension));
+}
+
+static void fill_stream_test_plaintext(uint8_t* plaintext, uint32_t plaintext_size)
+{
+    uint32_t index = 0;
+
+    for (index = 0; index < plaintext_size; ++index)
+    {
+        plaintext[index] = (uint8_t)((index * 131) ^ (index >> 8));
+    }
+}
+
+static void read_stream_test_file(uint8_t** out_data, uint32_t* out_size, FILE* stream)
+{
+    long size = 0;
+
+    TEST_ASSERT_EQUAL_INT(0, fseek(stream, 0, SEEK_END));
+    size = ftell(stream);
+    TEST_ASSERT_TRUE(size > 0);
+    rewind(stream);
+    *out_data = (uint8_t*)malloc((size_t)size);
+    TEST_ASSERT_NOT_NULL(*out_data);
+    TEST_ASSERT_EQUAL_UINT64((size_t)size, fread(*out_data, 1, (size_t)size, stream));
+    *out_size = (uint32_t)size;
+}
+
+void test_encrypt_stream_with_context_SeveralChunks_DecryptsInOnePass()
+{
+    // Arrange
+    uint32_t plaintext_size = (2 * CIPHER_STREAM_CHUNK_SIZE) + 123; // Two full chunks and a partial one
+    uint8_t* plaintext = (uint8_t*)malloc(plaintext_size);
+    KeyGenerationArguments key_generation_arguments = {NULL, 5, 2, 65537, 3, 2};
+    Secrets* encryption_secrets = NULL;
+    Secrets* decryption_secrets = NULL;
+    CipherContext context = {0};
+    FILE* input = tmpfile();
+    FILE* output = tmpfile();
+    uint64_t bytes_read = 0, bytes_written = 0;
+    uint8_t* ciphertext = NULL;
+    uint32_t ciphertext_size = 0;
+    uint8_t* decrypted = NULL;
+    uint32_t decrypted_size = 0;
+    TEST_ASSERT_NOT_NULL(plaintext);
+    TEST_ASSERT_NOT_NULL(input);
+    TEST_ASSERT_NOT_NULL(output);
+    fill_stream_test_plaintext(plaintext, plaintext_size);
+    TEST_ASSERT_EQUAL_UINT64(plaintext_size, fwrite(plaintext, 1, plaintext_size, input));
+    rewind(input);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_encryption_secrets(&encryption_secrets, &key_generation_arguments));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, prepare_cipher_context(&context, encryption_secrets));
+
+    // Act
+    STATUS_CODE return_code = encrypt_stream_with_context(output, input, &context, CIPHERTEXT_FORMAT_BINARY, ASYNC_IO_BACKEND_AUTO, &bytes_read, &bytes_written);
+    free_cipher_context(&context);
+    read_stream_test_file(&ciphertext, &ciphertext_size, output);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_decryption_secrets(&decryption_secrets, encryption_secrets));
+    STATUS_CODE decryption_return_code = deserialize_and_decrypt(&decrypted, &decrypted_size, ciphertext, ciphertext_size, *decryption_secrets, CIPHERTEXT_FORMAT_BINARY);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, return_code);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, decryption_return_code);
+    TEST_ASSERT_EQUAL_UINT64(plaintext_size, bytes_read);
+    TEST_ASSERT_EQUAL_UINT64(ciphertext_size, bytes_written);
+    TEST_ASSERT_EQUAL_UINT32(plaintext_size, decrypted_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, decrypted, plaintext_size);
+
+    fclose(input);
+    fclose(output);
+    free_secrets(encryption_secrets);
+    free(encryption_secrets);
+    free_secrets(decryption_secrets);
+    free(decryption_secrets);
+    free(plaintext);
+    free(ciphertext);
+    free(decrypted);
+}
+
+void test_decrypt_stream_with_context_TextCiphertext_MatchesPlaintext()
+{
+    // Arrange
+    uint32_t plaintext_size = CIPHER_STREAM_CHUNK_SIZE + 7;
+    uint8_t* plaintext = (uint8_t*)malloc(plaintext_size);
+    KeyGenerationArguments key_generation_arguments = {NULL, 4, 2, 257, 3, 3};
+    Secrets* encryption_secrets = NULL;
+    Secrets* decryption_secrets = NULL;
+    CipherContext context = {0};
+    FILE* input = tmpfile();
+    FILE* output = tmpfile();
+    uint64_t bytes_read = 0, bytes_written = 0;
+    uint8_t* ciphertext = NULL;
+    uint32_t ciphertext_size = 0;
+    uint8_t* decrypted = NULL;
+    uint32_t decrypted_size = 0;
+    TEST_ASSERT_NOT_NULL(plaintext);
+    TEST_ASSERT_NOT_NULL(input);
+    TEST_ASSERT_NOT_NULL(output);
+    fill_stream_test_plaintext(plaintext, plaintext_size);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_encryption_secrets(&encryption_secrets, &key_generation_arguments));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, encrypt_and_serialize(&ciphertext, &ciphertext_size, plaintext, plaintext_size, *encryption_secrets, CIPHERTEXT_FORMAT_TEXT));
+    TEST_ASSERT_EQUAL_UINT64(ciphertext_size, fwrite(ciphertext, 1, ciphertext_size, input));
+    rewind(input);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_decryption_secrets(&decryption_secrets, encryption_secrets));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, prepare_cipher_context(&context, decryption_secrets));
+
+    // Act
+    STATUS_CODE return_code = decrypt_stream_with_context(output, input, &context, CIPHERTEXT_FORMAT_TEXT, ASYNC_IO_BACKEND_THREADS, &bytes_read, &bytes_written);
+    read_stream_test_file(&decrypted, &decrypted_size, output);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, return_code);
+    TEST_ASSERT_EQUAL_UINT64(ciphertext_size, bytes_read);
+    TEST_ASSERT_EQUAL_UINT64(plaintext_size, bytes_written);
+    TEST_ASSERT_EQUAL_UINT32(plaintext_size, decrypted_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, decrypted, plaintext_size);
+
+    fclose(input);
+    fclose(output);
+    free_cipher_context(&context);
+    free_secrets(encryption_secrets);
+    free(encryption_secrets);
+    free_secrets(decryption_secrets);
+    free(decryption_secrets);
+    free(plaintext);
+    free(ciphertext);
+    free(decrypted);
+}
+
+void test_decrypt_stream_with_context_PartialBlock_IsRejected()
+{
+    // Arrange
+    uint8_t plaintext[] = {'S', 't', 'r', 'e', 'a', 'm', PADDING_MAGIC, 0x00};
+    KeyGenerationArguments key_generation_arguments = {NULL, 3, 2, 65537, 3, 2};
+    Secrets* encryption_secrets = NULL;
+    Secrets* decryption_secrets = NULL;
+    CipherContext context = {0};
+    FILE* input = tmpfile();
+    FILE* output = tmpfile();
+    uint8_t* ciphertext = NULL;
+    uint32_t ciphertext_size = 0;
+    TEST_ASSERT_NOT_NULL(input);
+    TEST_ASSERT_NOT_NULL(output);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_encryption_secrets(&encryption_secrets, &key_generation_arguments));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, encrypt_and_serialize(&ciphertext, &ciphertext_size, plaintext, sizeof(plaintext), *encryption_secrets, CIPHERTEXT_FORMAT_BINARY));
+    TEST_ASSERT_EQUAL_UINT64(ciphertext_size - 1, fwrite(ciphertext, 1, ciphertext_size - 1, input)); // The last byte is cut off
+    rewind(input);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_decryption_secrets(&decryption_secrets, encryption_secrets));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, prepare_cipher_context(&context, decryption_secrets));
+
+    // Act
+    STATUS_CODE return_code = decrypt_stream_with_context(output, input, &context, CIPHERTEXT_FORMAT_BINARY, ASYNC_IO_BACKEND_AUTO, NULL, NULL);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_ERROR_INVALID_FILE_SIZE, return_code);
+
+    fclose(input);
+    fclose(output);
+    free_cipher_context(&context);
+    free_secrets(encryption_secrets);
+    free(encryption_secrets);
+    free_secrets(decryption_secrets);
+    free(decryption_secrets);
+    free(ciphertext);
+}
+
 void run_all_CipherUtils_tests()
 {
     #ifdef NDEBUG
@@ -395,6 +749,7 @@ void run_all_CipherUtils_tests()
 
     RUN_TEST(test_remove_padding_sanity);
     RUN_TEST(test_remove_padding_InvalidPadding);
+    RUN_TEST(test_remove_padding_MagicInsideData);
     RUN_TEST(test_pad_to_length_BlockSize1);
     RUN_TEST(test_pad_to_length_LargePadding);
     RUN_TEST(test_remove_padding_ZeroLength);
@@ -407,4 +762,18 @@ void run_all_CipherUtils_tests()
     RUN_TEST(test_ascii_mapping_sanity);
     RUN_TEST(test_permutation_vector_with_numbers_and_larger_group);
     RUN_TEST(test_permutation_vector_ascii_sanity);
+
+    RUN_TEST(test_encrypt_and_serialize_BinaryRoundtrip);
+    RUN_TEST(test_encrypt_and_serialize_TextRoundtrip);
+
+    RUN_TEST(test_rekey_serialized_ciphertext_BinaryToText);
+    RUN_TEST(test_rekey_serialized_ciphertext_TextToBinary);
+
+    RUN_TEST(test_deserialize_secrets_CurrentVersion_Loads);
+    RUN_TEST(test_deserialize_secrets_UnknownVersion_IsRejected);
+    RUN_TEST(test_deserialize_secrets_HeaderlessKey_LoadsOnlyWithUnchangedWidth);
+
+    RUN_TEST(test_encrypt_stream_with_context_SeveralChunks_DecryptsInOnePass);
+    RUN_TEST(test_decrypt_stream_with_context_TextCiphertext_MatchesPlaintext);
+    RUN_TEST(test_decrypt_stream_with_context_PartialBlock_IsRejected);
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include <stdint.h>
+#include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 
@@ -9,6 +10,9 @@
 #include "Cipher/CipherParts/Padding.h"
 #include "Cipher/CipherParts/AsciiMapping.h"
 #include "Cipher/CipherParts/Permutation.h"
+#include "Cipher/Cipher.h"
+#include "Secrets/SecretsGeneration.h"
+#include "IO/SerDes.h"
 
 void test_add_random_bits_between_bytes_Sanity();
 void test_add_random_bits_between_bytes_EmptyInput();
@@ -16,6 +20,7 @@ void test_pad_to_length_sanity();
 void test_pad_to_length_ExactBlock();
 void test_remove_padding_sanity();
 void test_remove_padding_InvalidPadding();
+void test_remove_padding_MagicInsideData();
 void test_pad_to_length_BlockSize1();
 void test_pad_to_length_LargePadding();
 void test_remove_padding_ZeroLength();
@@ -24,6 +29,18 @@ void test_divide_uint8_t_into_blocks_UnevenSize();
 void test_divide_int64_t_into_blocks_sanity();
 void test_divide_int64_t_into_blocks_UnevenSize();
 void test_ascii_mapping_sanity();
+void test_encrypt_and_serialize_BinaryRoundtrip();
+void test_encrypt_and_serialize_TextRoundtrip();
+void test_rekey_serialized_ciphertext_BinaryToText();
+void test_rekey_serialized_ciphertext_TextToBinary();
+
+void test_deserialize_secrets_CurrentVersion_Loads();
+void test_deserialize_secrets_UnknownVersion_IsRejected();
+void test_deserialize_secrets_HeaderlessKey_LoadsOnlyWithUnchangedWidth();
+
+void test_encrypt_stream_with_context_SeveralChunks_DecryptsInOnePass();
+void test_decrypt_stream_with_context_TextCiphertext_MatchesPlaintext();
+void test_decrypt_stream_with_context_PartialBlock_IsRejected();
 
 void run_all_CipherUtils_tests();
 
@@ -0,0 +1,340 @@
+#include "test_KeyStore.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+struct KeyStoreTestWorker {
+    KeyStore* store;
+    const uint8_t* key_data;
+    uint32_t key_size;
+    const uint8_t* plaintext;
+    const uint8_t* expected_ciphertext;
+    uint32_t expected_size;
+    uint32_t failures;
+} typedef KeyStoreTestWorker;
+
+static Secrets* generate_key_store_test_secrets(uint32_t dimension, bool circulant_key)
+{
+    KeyGenerationArguments arguments = make_test_key_generation_arguments(dimension, KEY_STORE_TEST_PRIME_FIELD,
+                                                                          KEY_STORE_TEST_NUMBER_OF_ERROR_VECTORS, KEY_STORE_TEST_LETTERS_PER_DIGIT);
+
+    arguments.circulant_key = circulant_key;
+    return generate_test_secrets(&arguments);
+}
+
+static void fill_key_store_test_plaintext(uint8_t* plaintext)
+{
+    uint32_t index = 0;
+
+    for (index = 0; index < KEY_STORE_TEST_PLAINTEXT_SIZE; ++index)
+    {
+        plaintext[index] = (uint8_t)(index * 37 + 5);
+    }
+}
+
+void test_KeyStore_AcquireSameKeyTwice_HitsAndSharesPreparedContext()
+{
+    // Arrange
+    Secrets* secrets = generate_key_store_test_secrets(KEY_STORE_TEST_DIMENSION, false);
+    KeyStore* store = NULL;
+    KeyStoreStatistics statistics = {0};
+    const CipherContext* first_context = NULL;
+    const CipherContext* second_context = NULL;
+    uint8_t plaintext[KEY_STORE_TEST_PLAINTEXT_SIZE];
+    uint8_t* key_data = NULL;
+    uint8_t* expected_ciphertext = NULL;
+    uint8_t* ciphertext = NULL;
+    uint32_t key_size = 0, expected_size = 0, ciphertext_size = 0;
+    fill_key_store_test_plaintext(plaintext);
+    serialize_test_secrets(&key_data, &key_size, secrets);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, encrypt_and_serialize(&expected_ciphertext, &expected_size, plaintext, KEY_STORE_TEST_PLAINTEXT_SIZE, *secrets, CIPHERTEXT_FORMAT_BINARY));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, create_key_store(&store, KEY_STORE_TEST_BYTE_BUDGET));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, acquire_key_store_context_from_data(&first_context, store, key_data, key_size));
+
+    // Act
+    STATUS_CODE return_code = acquire_key_store_context_from_data(&second_context, store, key_data, key_size);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, return_code);
+    TEST_ASSERT_EQUAL_PTR(first_context, second_context);
+    TEST_ASSERT_NULL(second_context->secrets.key_matrix); // Only the prepared forms are cached
+    get_key_store_statistics(&statistics, store);
+    TEST_ASSERT_EQUAL_UINT64(1, statistics.hits);
+    TEST_ASSERT_EQUAL_UINT64(1, statistics.misses);
+    TEST_ASSERT_EQUAL_UINT64(1, statistics.number_of_entries);
+    TEST_ASSERT_EQUAL_UINT64(second_context->size_in_bytes, statistics.bytes_in_use);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, encrypt_and_serialize_with_context(&ciphertext, &ciphertext_size, plaintext, KEY_STORE_TEST_PLAINTEXT_SIZE, second_context, CIPHERTEXT_FORMAT_BINARY));
+    TEST_ASSERT_EQUAL_UINT32(expected_size, ciphertext_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_ciphertext, ciphertext, expected_size);
+
+    release_key_store_context(first_context);
+    release_key_store_context(second_context);
+    free_key_store(store);
+    free(ciphertext);
+    free(expected_ciphertext);
+    free(key_data);
+    free_test_secrets(secrets);
+}
+
+void test_KeyStore_OverBudget_EvictsLeastRecentlyUsedAndKeepsAcquiredContextValid()
+{
+    // Arrange
+    Secrets* secrets[3] = {NULL};
+    uint8_t* key_data[3] = {NULL};
+    uint32_t key_size[3] = {0};
+    KeyStore* store = NULL;
+    KeyStoreStatistics statistics = {0};
+    const CipherContext* context = NULL;
+    const CipherContext* evicted_context = NULL;
+    uint8_t plaintext[KEY_STORE_TEST_PLAINTEXT_SIZE];
+    uint8_t* ciphertext = NULL;
+    uint32_t ciphertext_size = 0;
+    size_t key = 0, context_size = 0;
+    fill_key_store_test_plaintext(plaintext);
+    for (key = 0; key < 3; ++key)
+    {
+        secrets[key] = generate_key_store_test_secrets(KEY_STORE_TEST_DIMENSION, false);
+        serialize_test_secrets(&key_data[key], &key_size[key], secrets[key]);
+    }
+    // Keys of one shape take the same space, the budget holds two of them
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, create_key_store(&store, KEY_STORE_TEST_BYTE_BUDGET));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, acquire_key_store_context_from_data(&context, store, key_data[0], key_size[0]));
+    context_size = context->size_in_bytes;
+    release_key_store_context(context);
+    free_key_store(store);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, create_key_store(&store, 2 * context_size));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, acquire_key_store_context_from_data(&context, store, key_data[0], key_size[0]));
+    release_key_store_context(context);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, acquire_key_store_context_from_data(&evicted_context, store, key_data[1], key_size[1]));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, acquire_key_store_context_from_data(&context, store, key_data[0], key_size[0]));
+    release_key_store_context(context);
+
+    // Act
+    STATUS_CODE return_code = acquire_key_store_context_from_data(&context, store, key_data[2], key_size[2]);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, return_code);
+    release_key_store_context(context);
+    get_key_store_statistics(&statistics, store);
+    TEST_ASSERT_EQUAL_UINT64(1, statistics.evictions);
+    TEST_ASSERT_EQUAL_UINT64(2, statistics.number_of_entries);
+    TEST_ASSERT_TRUE(statistics.bytes_in_use <= 2 * context_size);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, encrypt_and_serialize_with_context(&ciphertext, &ciphertext_size, plaintext, KEY_STORE_TEST_PLAINTEXT_SIZE, evicted_context, CIPHERTEXT_FORMAT_TEXT));
+    release_key_store_context(evicted_context);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, acquire_key_store_context_from_data(&context, store, key_data[0], key_size[0]));
+    release_key_store_context(context);
+    get_key_store_statistics(&statistics, store);
+    TEST_ASSERT_EQUAL_UINT64(2, statistics.hits);
+    TEST_ASSERT_EQUAL_UINT64(3, statistics.misses);
+
+    free_key_store(store);
+    free(ciphertext);
+    for (key = 0; key < 3; ++key)
+    {
+        free(key_data[key]);
+        free_test_secrets(secrets[key]);
+    }
+}
+
+void test_KeyStore_ChangedKeyFile_IsLoadedAgain()
+{
+    // Arrange
+    Secrets* old_secrets = generate_key_store_test_secrets(KEY_STORE_TEST_DIMENSION, false);
+    Secrets* new_secrets = generate_key_store_test_secrets(KEY_STORE_TEST_DIMENSION / 2, false);
+    uint8_t* key_data = NULL;
+    uint32_t key_size = 0;
+    KeyStore* store = NULL;
+    KeyStoreStatistics statistics = {0};
+    const CipherContext* old_context = NULL;
+    const CipherContext* new_context = NULL;
+    serialize_test_secrets(&key_data, &key_size, old_secrets);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, write_uint8_to_file(KEY_STORE_TEST_KEY_FILE, key_data, key_size));
+    free(key_data);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, create_key_store(&store, KEY_STORE_TEST_BYTE_BUDGET));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, acquire_key_store_context_from_file(&old_context, store, KEY_STORE_TEST_KEY_FILE));
+    serialize_test_secrets(&key_data, &key_size, new_secrets); // A smaller key, so the change shows even within one mtime tick
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, write_uint8_to_file(KEY_STORE_TEST_KEY_FILE, key_data, key_size));
+
+    // Act
+    STATUS_CODE return_code = acquire_key_store_context_from_file(&new_context, store, KEY_STORE_TEST_KEY_FILE);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, return_code);
+    TEST_ASSERT_EQUAL_UINT32(KEY_STORE_TEST_DIMENSION, old_context->secrets.dimension);
+    TEST_ASSERT_EQUAL_UINT32(KEY_STORE_TEST_DIMENSION / 2, new_context->secrets.dimension);
+    get_key_store_statistics(&statistics, store);
+    TEST_ASSERT_EQUAL_UINT64(2, statistics.misses);
+    TEST_ASSERT_EQUAL_UINT64(1, statistics.number_of_entries);
+
+    release_key_store_context(old_context);
+    release_key_store_context(new_context);
+    free_key_store(store);
+    free(key_data);
+    free_test_secrets(new_secrets);
+    free_test_secrets(old_secrets);
+    remove(KEY_STORE_TEST_KEY_FILE);
+}
+
+void test_KeyStore_KeyFileReplacedBySameSize_IsLoadedAgain()
+{
+    // Arrange
+    Secrets* old_secrets = generate_key_store_test_secrets(KEY_STORE_TEST_DIMENSION, false);
+    Secrets* new_secrets = generate_key_store_test_secrets(KEY_STORE_TEST_DIMENSION, false);
+    uint8_t* old_key_data = NULL;
+    uint8_t* new_key_data = NULL;
+    uint32_t old_key_size = 0;
+    uint32_t new_key_size = 0;
+    KeyStore* store = NULL;
+    KeyStoreStatistics statistics = {0};
+    const CipherContext* old_context = NULL;
+    const CipherContext* new_context = NULL;
+    serialize_test_secrets(&old_key_data, &old_key_size, old_secrets);
+    serialize_test_secrets(&new_key_data, &new_key_size, new_secrets);
+    TEST_ASSERT_EQUAL_UINT32(old_key_size, new_key_size);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, write_uint8_to_file(KEY_STORE_TEST_KEY_FILE, old_key_data, old_key_size));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, create_key_store(&store, KEY_STORE_TEST_BYTE_BUDGET));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, acquire_key_store_context_from_file(&old_context, store, KEY_STORE_TEST_KEY_FILE));
+    // Renamed over the cached file within the same second, only the inode tells the two apart
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, write_uint8_to_file(KEY_STORE_TEST_REPLACEMENT_KEY_FILE, new_key_data, new_key_size));
+    TEST_ASSERT_EQUAL(0, rename(KEY_STORE_TEST_REPLACEMENT_KEY_FILE, KEY_STORE_TEST_KEY_FILE));
+
+    // Act
+    STATUS_CODE return_code = acquire_key_store_context_from_file(&new_context, store, KEY_STORE_TEST_KEY_FILE);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, return_code);
+    TEST_ASSERT_TRUE(old_context != new_context);
+    get_key_store_statistics(&statistics, store);
+    TEST_ASSERT_EQUAL_UINT64(2, statistics.misses);
+    TEST_ASSERT_EQUAL_UINT64(1, statistics.number_of_entries);
+
+    release_key_store_context(old_context);
+    release_key_store_context(new_context);
+    free_key_store(store);
+    free(new_key_data);
+    free(old_key_data);
+    free_test_secrets(new_secrets);
+    free_test_secrets(old_secrets);
+    remove(KEY_STORE_TEST_KEY_FILE);
+}
+
+static void run_key_store_test_worker(KeyStoreTestWorker* worker)
+{
+    const CipherContext* context = NULL;
+    uint8_t* ciphertext = NULL;
+    uint32_t ciphertext_size = 0;
+    size_t acquire = 0;
+
+    for (acquire = 0; acquire < KEY_STORE_TEST_ACQUIRES_PER_THREAD; ++acquire)
+    {
+        if (STATUS_FAILED(acquire_key_store_context_from_data(&context, worker->store, worker->key_data, worker->key_size)))
+        {
+            ++worker->failures;
+            continue;
+        }
+        if (STATUS_FAILED(encrypt_and_serialize_with_context(&ciphertext, &ciphertext_size, (uint8_t*)worker->plaintext, KEY_STORE_TEST_PLAINTEXT_SIZE, context, CIPHERTEXT_FORMAT_BINARY)) ||
+            (ciphertext_size != worker->expected_size) || (0 != memcmp(ciphertext, worker->expected_ciphertext, ciphertext_size)))
+        {
+            ++worker->failures;
+        }
+        free(ciphertext);
+        ciphertext = NULL;
+        release_key_store_context(context);
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI key_store_test_thread(LPVOID parameter)
+{
+    run_key_store_test_worker((KeyStoreTestWorker*)parameter);
+    return 0;
+}
+#else
+static void* key_store_test_thread(void* parameter)
+{
+    run_key_store_test_worker((KeyStoreTestWorker*)parameter);
+    return NULL;
+}
+#endif
+
+void test_KeyStore_ConcurrentAcquires_ShareOneCirculantContext()
+{
+    // Arrange
+    Secrets* secrets = generate_key_store_test_secrets(KEY_STORE_TEST_DIMENSION, true);
+    KeyStore* store = NULL;
+    KeyStoreStatistics statistics = {0};
+    KeyStoreTestWorker workers[KEY_STORE_TEST_NUMBER_OF_THREADS];
+    uint8_t plaintext[KEY_STORE_TEST_PLAINTEXT_SIZE];
+    uint8_t* key_data = NULL;
+    uint8_t* expected_ciphertext = NULL;
+    uint32_t key_size = 0, expected_size = 0;
+    size_t worker = 0;
+#ifdef _WIN32
+    HANDLE threads[KEY_STORE_TEST_NUMBER_OF_THREADS];
+#else
+    pthread_t threads[KEY_STORE_TEST_NUMBER_OF_THREADS];
+#endif
+    fill_key_store_test_plaintext(plaintext);
+    serialize_test_secrets(&key_data, &key_size, secrets);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, encrypt_and_serialize(&expected_ciphertext, &expected_size, plaintext, KEY_STORE_TEST_PLAINTEXT_SIZE, *secrets, CIPHERTEXT_FORMAT_BINARY));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, create_key_store(&store, KEY_STORE_TEST_BYTE_BUDGET));
+    for (worker = 0; worker < KEY_STORE_TEST_NUMBER_OF_THREADS; ++worker)
+    {
+        workers[worker].store = store;
+        workers[worker].key_data = key_data;
+        workers[worker].key_size = key_size;
+        workers[worker].plaintext = plaintext;
+        workers[worker].expected_ciphertext = expected_ciphertext;
+        workers[worker].expected_size = expected_size;
+        workers[worker].failures = 0;
+    }
+
+    // Act
+    for (worker = 0; worker < KEY_STORE_TEST_NUMBER_OF_THREADS; ++worker)
+    {
+#ifdef _WIN32
+        threads[worker] = CreateThread(NULL, 0, key_store_test_thread, &workers[worker], 0, NULL);
+        TEST_ASSERT_NOT_NULL(threads[worker]);
+#else
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[worker], NULL, key_store_test_thread, &workers[worker]));
+#endif
+    }
+    for (worker = 0; worker < KEY_STORE_TEST_NUMBER_OF_THREADS; ++worker)
+    {
+#ifdef _WIN32
+        WaitForSingleObject(threads[worker], INFINITE);
+        CloseHandle(threads[worker]);
+#else
+        pthread_join(threads[worker], NULL);
+#endif
+    }
+
+    // Assert
+    for (worker = 0; worker < KEY_STORE_TEST_NUMBER_OF_THREADS; ++worker)
+    {
+        TEST_ASSERT_EQUAL_UINT32(0, workers[worker].failures);
+    }
+    get_key_store_statistics(&statistics, store);
+    TEST_ASSERT_EQUAL_UINT64(1, statistics.number_of_entries);
+    TEST_ASSERT_EQUAL_UINT64(KEY_STORE_TEST_NUMBER_OF_THREADS * KEY_STORE_TEST_ACQUIRES_PER_THREAD, statistics.hits + statistics.misses);
+    TEST_ASSERT_EQUAL_UINT64(1, statistics.misses); // Threads racing on the first acquire wait for its load
+
+    free_key_store(store);
+    free(expected_ciphertext);
+    free(key_data);
+    free_test_secrets(secrets);
+}
+
+void run_all_KeyStore_tests()
+{
+    RUN_TEST(test_KeyStore_AcquireSameKeyTwice_HitsAndSharesPreparedContext);
+    RUN_TEST(test_KeyStore_OverBudget_EvictsLeastRecentlyUsedAndKeepsAcquiredContextValid);
+    RUN_TEST(test_KeyStore_ChangedKeyFile_IsLoadedAgain);
+#ifndef _WIN32
+    RUN_TEST(test_KeyStore_KeyFileReplacedBySameSize_IsLoadedAgain); // Windows stamps have no inode to compare
+#endif
+    RUN_TEST(test_KeyStore_ConcurrentAcquires_ShareOneCirculantContext);
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "TestSecrets.h"
+#include "Cipher/KeyStore.h"
+#include "Cipher/Cipher.h"
+#include "Secrets/SecretsGeneration.h"
+#include "IO/FileOperations.h"
+#include "IO/SerDes.h"
+
+#define KEY_STORE_TEST_DIMENSION (16)
+#define KEY_STORE_TEST_PRIME_FIELD (257) // 16 divides 256, so the same shape also makes circulant keys
+#define KEY_STORE_TEST_NUMBER_OF_ERROR_VECTORS (3)
+#define KEY_STORE_TEST_LETTERS_PER_DIGIT (3)
+#define KEY_STORE_TEST_PLAINTEXT_SIZE (100)
+#define KEY_STORE_TEST_BYTE_BUDGET ((size_t)1 << 24)
+#define KEY_STORE_TEST_NUMBER_OF_THREADS (4)
+#define KEY_STORE_TEST_ACQUIRES_PER_THREAD (50)
+#define KEY_STORE_TEST_KEY_FILE "key_store_test_key.bin"
+#define KEY_STORE_TEST_REPLACEMENT_KEY_FILE "key_store_test_replacement_key.bin"
+
+void run_all_KeyStore_tests();
+
+void test_KeyStore_AcquireSameKeyTwice_HitsAndSharesPreparedContext();
+void test_KeyStore_OverBudget_EvictsLeastRecentlyUsedAndKeepsAcquiredContextValid();
+void test_KeyStore_ChangedKeyFile_IsLoadedAgain();
+void test_KeyStore_KeyFileReplacedBySameSize_IsLoadedAgain();
+void test_KeyStore_ConcurrentAcquires_ShareOneCirculantContext();
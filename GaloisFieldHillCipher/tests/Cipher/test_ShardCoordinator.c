@@ -0,0 +1,309 @@
+#include "test_ShardCoordinator.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Mapped shared, so the forked workers count the jobs together
+struct ShardTestCrashes {
+    uint32_t jobs_received;
+    uint32_t number_of_crashes;
+} typedef ShardTestCrashes;
+
+static ShardTestCrashes* g_shard_test_crashes = NULL;
+
+// The first jobs the workers receive make their worker exit without replying
+static void crash_shard_test_worker(uint32_t shard)
+{
+    (void)shard;
+    if (__atomic_fetch_add(&g_shard_test_crashes->jobs_received, 1, __ATOMIC_ACQ_REL) < g_shard_test_crashes->number_of_crashes)
+    {
+        _exit(SHARD_TEST_CRASH_EXIT_CODE);
+    }
+}
+
+static void inject_shard_test_crashes(uint32_t number_of_crashes)
+{
+    if (NULL == g_shard_test_crashes)
+    {
+        g_shard_test_crashes = (ShardTestCrashes*)mmap(NULL, sizeof(ShardTestCrashes), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        TEST_ASSERT_TRUE(MAP_FAILED != (void*)g_shard_test_crashes);
+    }
+    g_shard_test_crashes->jobs_received = 0;
+    g_shard_test_crashes->number_of_crashes = number_of_crashes;
+    set_shard_worker_job_hook(crash_shard_test_worker);
+}
+#endif
+
+static void write_shard_test_key_pair()
+{
+    KeyGenerationArguments arguments = make_test_key_generation_arguments(SHARD_TEST_DIMENSION, SHARD_TEST_PRIME_FIELD,
+                                                                          SHARD_TEST_NUMBER_OF_ERROR_VECTORS, SHARD_TEST_LETTERS_PER_DIGIT);
+
+    arguments.number_of_random_bits_to_add = 2;
+    write_test_key_pair(&arguments, SHARD_TEST_KEY_FILE, SHARD_TEST_DECRYPTION_KEY_FILE);
+}
+
+static void write_shard_test_plaintext(uint32_t size)
+{
+    uint8_t* data = NULL;
+    uint32_t index = 0;
+    FILE* file = NULL;
+
+    if (0 == size)
+    {
+        file = fopen(SHARD_TEST_PLAINTEXT_FILE, "wb");
+        TEST_ASSERT_NOT_NULL(file);
+        fclose(file);
+        return;
+    }
+    data = (uint8_t*)malloc(size);
+    TEST_ASSERT_NOT_NULL(data);
+    for (index = 0; index < size; ++index)
+    {
+        data[index] = (uint8_t)((index * 73) ^ (index >> 11));
+    }
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, write_uint8_to_file(SHARD_TEST_PLAINTEXT_FILE, data, size));
+    free(data);
+}
+
+static uint64_t get_shard_test_file_size(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+    long size = 0;
+
+    TEST_ASSERT_NOT_NULL(file);
+    TEST_ASSERT_EQUAL(0, fseek(file, 0, SEEK_END));
+    size = ftell(file);
+    fclose(file);
+    return (uint64_t)size;
+}
+
+static void assert_shard_test_files_equal(const char* expected_path, const char* actual_path)
+{
+    uint8_t* expected = NULL;
+    uint8_t* actual = NULL;
+    uint32_t expected_size = 0, actual_size = 0;
+
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, read_uint8_from_file(&expected, &expected_size, expected_path));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, read_uint8_from_file(&actual, &actual_size, actual_path));
+    TEST_ASSERT_EQUAL_UINT32(expected_size, actual_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, actual, expected_size);
+    free(expected);
+    free(actual);
+}
+
+static ShardConfiguration make_shard_test_configuration(SHARD_DIRECTION direction, CIPHERTEXT_FORMAT format)
+{
+    ShardConfiguration configuration = {0};
+
+    configuration.direction = direction;
+    configuration.format = format;
+    configuration.number_of_workers = SHARD_TEST_NUMBER_OF_WORKERS;
+    configuration.shard_size = SHARD_TEST_SHARD_SIZE;
+    configuration.number_of_retries = 3;
+    return configuration;
+}
+
+static void remove_shard_test_files()
+{
+    remove(SHARD_TEST_KEY_FILE);
+    remove(SHARD_TEST_DECRYPTION_KEY_FILE);
+    remove(SHARD_TEST_PLAINTEXT_FILE);
+    remove(SHARD_TEST_CONTAINER_FILE);
+    remove(SHARD_TEST_DECRYPTED_FILE);
+}
+
+void test_run_shard_coordinator_LocalWorkers_RoundTripThroughContainer()
+{
+#ifdef _WIN32
+    TEST_IGNORE_MESSAGE("Shard workers are forked, not supported on Windows");
+#else
+    // Arrange
+    ShardConfiguration encryption = make_shard_test_configuration(SHARD_DIRECTION_ENCRYPT, CIPHERTEXT_FORMAT_BINARY);
+    ShardConfiguration decryption = make_shard_test_configuration(SHARD_DIRECTION_DECRYPT, CIPHERTEXT_FORMAT_BINARY);
+    ShardSummary encryption_summary = {0};
+    ShardSummary decryption_summary = {0};
+    ShardContainerHeader header = {0};
+    ShardIndexEntry* entries = NULL;
+    FILE* container = NULL;
+    uint32_t shard_index = 0;
+    write_shard_test_key_pair();
+    write_shard_test_plaintext(SHARD_TEST_PLAINTEXT_SIZE);
+
+    // Act
+    STATUS_CODE encryption_status = run_shard_coordinator(&encryption_summary, SHARD_TEST_CONTAINER_FILE, SHARD_TEST_PLAINTEXT_FILE,
+                                                          SHARD_TEST_KEY_FILE, &encryption);
+    STATUS_CODE decryption_status = run_shard_coordinator(&decryption_summary, SHARD_TEST_DECRYPTED_FILE, SHARD_TEST_CONTAINER_FILE,
+                                                          SHARD_TEST_DECRYPTION_KEY_FILE, &decryption);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, encryption_status);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, decryption_status);
+    TEST_ASSERT_EQUAL_UINT32(SHARD_TEST_NUMBER_OF_SHARDS, encryption_summary.number_of_shards);
+    TEST_ASSERT_EQUAL_UINT32(0, encryption_summary.retries);
+    TEST_ASSERT_EQUAL_UINT32(SHARD_TEST_NUMBER_OF_WORKERS, encryption_summary.workers_started);
+    TEST_ASSERT_EQUAL_UINT64(SHARD_TEST_PLAINTEXT_SIZE, encryption_summary.bytes_in);
+    TEST_ASSERT_EQUAL_UINT64(SHARD_TEST_PLAINTEXT_SIZE, decryption_summary.bytes_out);
+    assert_shard_test_files_equal(SHARD_TEST_PLAINTEXT_FILE, SHARD_TEST_DECRYPTED_FILE);
+
+    container = fopen(SHARD_TEST_CONTAINER_FILE, "rb");
+    TEST_ASSERT_NOT_NULL(container);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, read_shard_container_index(&header, &entries, container));
+    fclose(container);
+    TEST_ASSERT_EQUAL_UINT32(SHARD_TEST_NUMBER_OF_SHARDS, header.number_of_shards);
+    TEST_ASSERT_EQUAL_UINT64(SHARD_TEST_PLAINTEXT_SIZE, header.plaintext_size);
+    for (shard_index = 0; shard_index < SHARD_TEST_NUMBER_OF_SHARDS; ++shard_index)
+    {
+        TEST_ASSERT_EQUAL_UINT64((uint64_t)shard_index * SHARD_TEST_SHARD_SIZE, entries[shard_index].plaintext_offset);
+    }
+    TEST_ASSERT_EQUAL_UINT64(33, entries[SHARD_TEST_NUMBER_OF_SHARDS - 1].plaintext_size);
+
+    free(entries);
+    remove_shard_test_files();
+#endif
+}
+
+void test_run_shard_coordinator_InjectedWorkerCrashes_AreRetried()
+{
+#ifdef _WIN32
+    TEST_IGNORE_MESSAGE("Shard workers are forked, not supported on Windows");
+#else
+    // Arrange
+    ShardConfiguration encryption = make_shard_test_configuration(SHARD_DIRECTION_ENCRYPT, CIPHERTEXT_FORMAT_TEXT);
+    ShardConfiguration decryption = make_shard_test_configuration(SHARD_DIRECTION_DECRYPT, CIPHERTEXT_FORMAT_BINARY);
+    ShardSummary encryption_summary = {0};
+    ShardSummary decryption_summary = {0};
+    write_shard_test_key_pair();
+    write_shard_test_plaintext(SHARD_TEST_PLAINTEXT_SIZE);
+
+    // Act
+    inject_shard_test_crashes(2);
+    STATUS_CODE encryption_status = run_shard_coordinator(&encryption_summary, SHARD_TEST_CONTAINER_FILE, SHARD_TEST_PLAINTEXT_FILE,
+                                                          SHARD_TEST_KEY_FILE, &encryption);
+    inject_shard_test_crashes(4);
+    STATUS_CODE decryption_status = run_shard_coordinator(&decryption_summary, SHARD_TEST_DECRYPTED_FILE, SHARD_TEST_CONTAINER_FILE,
+                                                          SHARD_TEST_DECRYPTION_KEY_FILE, &decryption);
+    set_shard_worker_job_hook(NULL);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, encryption_status);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, decryption_status);
+    TEST_ASSERT_EQUAL_UINT32(2, encryption_summary.retries);
+    TEST_ASSERT_EQUAL_UINT32(SHARD_TEST_NUMBER_OF_WORKERS + 2, encryption_summary.workers_started);
+    TEST_ASSERT_EQUAL_UINT32(4, decryption_summary.retries);
+    TEST_ASSERT_EQUAL_UINT32(SHARD_TEST_NUMBER_OF_WORKERS + 4, decryption_summary.workers_started);
+    assert_shard_test_files_equal(SHARD_TEST_PLAINTEXT_FILE, SHARD_TEST_DECRYPTED_FILE);
+
+    remove_shard_test_files();
+#endif
+}
+
+void test_run_shard_coordinator_OutOfRetries_FailsWithoutValidContainer()
+{
+#ifdef _WIN32
+    TEST_IGNORE_MESSAGE("Shard workers are forked, not supported on Windows");
+#else
+    // Arrange
+    ShardConfiguration encryption = make_shard_test_configuration(SHARD_DIRECTION_ENCRYPT, CIPHERTEXT_FORMAT_BINARY);
+    ShardContainerHeader header = {0};
+    ShardIndexEntry* entries = NULL;
+    FILE* container = NULL;
+    encryption.number_of_workers = 1;
+    encryption.number_of_retries = 1;
+    write_shard_test_key_pair();
+    write_shard_test_plaintext(SHARD_TEST_PLAINTEXT_SIZE);
+    inject_shard_test_crashes(SHARD_TEST_NUMBER_OF_SHARDS + 1); // Retries queue behind the first attempts, the first shard then crashes twice
+
+    // Act
+    STATUS_CODE encryption_status = run_shard_coordinator(NULL, SHARD_TEST_CONTAINER_FILE, SHARD_TEST_PLAINTEXT_FILE,
+                                                          SHARD_TEST_KEY_FILE, &encryption);
+    set_shard_worker_job_hook(NULL);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SHARDS_FAILED, encryption_status);
+    container = fopen(SHARD_TEST_CONTAINER_FILE, "rb");
+    TEST_ASSERT_NOT_NULL(container);
+    TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_SHARD_CONTAINER, read_shard_container_index(&header, &entries, container));
+    TEST_ASSERT_NULL(entries);
+    fclose(container);
+
+    remove_shard_test_files();
+#endif
+}
+
+void test_run_shard_coordinator_EmptyInput_WritesContainerWithoutShards()
+{
+#ifdef _WIN32
+    TEST_IGNORE_MESSAGE("Shard workers are forked, not supported on Windows");
+#else
+    // Arrange
+    ShardConfiguration encryption = make_shard_test_configuration(SHARD_DIRECTION_ENCRYPT, CIPHERTEXT_FORMAT_BINARY);
+    ShardConfiguration decryption = make_shard_test_configuration(SHARD_DIRECTION_DECRYPT, CIPHERTEXT_FORMAT_BINARY);
+    ShardSummary encryption_summary = {0};
+    write_shard_test_key_pair();
+    write_shard_test_plaintext(0);
+
+    // Act
+    STATUS_CODE encryption_status = run_shard_coordinator(&encryption_summary, SHARD_TEST_CONTAINER_FILE, SHARD_TEST_PLAINTEXT_FILE,
+                                                          SHARD_TEST_KEY_FILE, &encryption);
+    STATUS_CODE decryption_status = run_shard_coordinator(NULL, SHARD_TEST_DECRYPTED_FILE, SHARD_TEST_CONTAINER_FILE,
+                                                          SHARD_TEST_DECRYPTION_KEY_FILE, &decryption);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, encryption_status);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, decryption_status);
+    TEST_ASSERT_EQUAL_UINT32(0, encryption_summary.number_of_shards);
+    TEST_ASSERT_EQUAL_UINT32(0, encryption_summary.workers_started);
+    TEST_ASSERT_EQUAL_UINT64(SHARD_CONTAINER_HEADER_SIZE, get_shard_test_file_size(SHARD_TEST_CONTAINER_FILE));
+    TEST_ASSERT_EQUAL_UINT64(0, get_shard_test_file_size(SHARD_TEST_DECRYPTED_FILE));
+
+    remove_shard_test_files();
+#endif
+}
+
+void test_read_shard_container_index_GapBetweenShards_IsRejected()
+{
+#ifdef _WIN32
+    TEST_IGNORE_MESSAGE("Shard workers are forked, not supported on Windows");
+#else
+    // Arrange
+    ShardConfiguration encryption = make_shard_test_configuration(SHARD_DIRECTION_ENCRYPT, CIPHERTEXT_FORMAT_BINARY);
+    ShardContainerHeader header = {0};
+    ShardIndexEntry* entries = NULL;
+    FILE* container = NULL;
+    uint8_t plaintext_offset_low_byte = 0;
+    write_shard_test_key_pair();
+    write_shard_test_plaintext(SHARD_TEST_PLAINTEXT_SIZE);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, run_shard_coordinator(NULL, SHARD_TEST_CONTAINER_FILE, SHARD_TEST_PLAINTEXT_FILE,
+                                                                 SHARD_TEST_KEY_FILE, &encryption));
+
+    // The second shard claims to start a byte after the end of the first one
+    container = fopen(SHARD_TEST_CONTAINER_FILE, "r+b");
+    TEST_ASSERT_NOT_NULL(container);
+    TEST_ASSERT_EQUAL(0, fseek(container, SHARD_CONTAINER_HEADER_SIZE + SHARD_CONTAINER_INDEX_ENTRY_SIZE, SEEK_SET));
+    TEST_ASSERT_EQUAL(1, fread(&plaintext_offset_low_byte, 1, 1, container));
+    ++plaintext_offset_low_byte;
+    TEST_ASSERT_EQUAL(0, fseek(container, SHARD_CONTAINER_HEADER_SIZE + SHARD_CONTAINER_INDEX_ENTRY_SIZE, SEEK_SET));
+    TEST_ASSERT_EQUAL(1, fwrite(&plaintext_offset_low_byte, 1, 1, container));
+
+    // Act
+    STATUS_CODE return_code = read_shard_container_index(&header, &entries, container);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_SHARD_CONTAINER, return_code);
+    TEST_ASSERT_NULL(entries);
+
+    fclose(container);
+    remove_shard_test_files();
+#endif
+}
+
+void run_all_ShardCoordinator_tests()
+{
+    RUN_TEST(test_run_shard_coordinator_LocalWorkers_RoundTripThroughContainer);
+    RUN_TEST(test_run_shard_coordinator_InjectedWorkerCrashes_AreRetried);
+    RUN_TEST(test_run_shard_coordinator_OutOfRetries_FailsWithoutValidContainer);
+    RUN_TEST(test_run_shard_coordinator_EmptyInput_WritesContainerWithoutShards);
+    RUN_TEST(test_read_shard_container_index_GapBetweenShards_IsRejected);
+}
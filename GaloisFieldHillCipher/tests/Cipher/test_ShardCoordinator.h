@@ -0,0 +1,36 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "TestSecrets.h"
+#include "Cipher/ShardCoordinator.h"
+#include "Cipher/Cipher.h"
+#include "Secrets/SecretsGeneration.h"
+#include "IO/FileOperations.h"
+#include "IO/SerDes.h"
+
+#define SHARD_TEST_DIMENSION (5)
+#define SHARD_TEST_PRIME_FIELD (65537)
+#define SHARD_TEST_NUMBER_OF_ERROR_VECTORS (3)
+#define SHARD_TEST_LETTERS_PER_DIGIT (2)
+#define SHARD_TEST_SHARD_SIZE (4096)
+#define SHARD_TEST_PLAINTEXT_SIZE ((10 * SHARD_TEST_SHARD_SIZE) + 33) // Ten full shards and a partial one
+#define SHARD_TEST_NUMBER_OF_SHARDS (11)
+#define SHARD_TEST_NUMBER_OF_WORKERS (3)
+#define SHARD_TEST_CRASH_EXIT_CODE (3)
+#define SHARD_TEST_KEY_FILE "shard_test_key.bin"
+#define SHARD_TEST_DECRYPTION_KEY_FILE "shard_test_decryption_key.bin"
+#define SHARD_TEST_PLAINTEXT_FILE "shard_test_plaintext.bin"
+#define SHARD_TEST_CONTAINER_FILE "shard_test_container.bin"
+#define SHARD_TEST_DECRYPTED_FILE "shard_test_decrypted.bin"
+
+void run_all_ShardCoordinator_tests();
+
+void test_run_shard_coordinator_LocalWorkers_RoundTripThroughContainer();
+void test_run_shard_coordinator_InjectedWorkerCrashes_AreRetried();
+void test_run_shard_coordinator_OutOfRetries_FailsWithoutValidContainer();
+void test_run_shard_coordinator_EmptyInput_WritesContainerWithoutShards();
+void test_read_shard_container_index_GapBetweenShards_IsRejected();
@@ -0,0 +1,168 @@
+#include "test_AsyncFileIO.h"
+
+static void fill_async_file_test_data(uint8_t* data, size_t size)
+{
+    size_t index = 0;
+
+    for (index = 0; index < size; ++index)
+    {
+        data[index] = (uint8_t)((index * 29) ^ (index >> 9));
+    }
+}
+
+static void read_async_file_test_stream(uint8_t* out_data, size_t* out_size, FILE* stream, ASYNC_IO_BACKEND backend)
+{
+    AsyncFile* reader = NULL;
+    const uint8_t* chunk = NULL;
+    size_t chunk_size = 0, size = 0;
+
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, open_async_file(&reader, stream, false, ASYNC_FILE_IO_TEST_CHUNK_SIZE, backend));
+    do
+    {
+        TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, async_read_next(&chunk, &chunk_size, reader));
+        TEST_ASSERT_TRUE(size + chunk_size <= ASYNC_FILE_IO_TEST_FILE_SIZE);
+        if (0 != chunk_size)
+        {
+            memcpy(out_data + size, chunk, chunk_size);
+        }
+        size += chunk_size;
+    } while (ASYNC_FILE_IO_TEST_CHUNK_SIZE == chunk_size);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, close_async_file(&reader));
+    TEST_ASSERT_NULL(reader);
+    *out_size = size;
+}
+
+static void run_async_file_roundtrip(ASYNC_IO_BACKEND backend)
+{
+    // Arrange
+    uint8_t* data = (uint8_t*)malloc(ASYNC_FILE_IO_TEST_FILE_SIZE);
+    uint8_t* read_back = (uint8_t*)malloc(ASYNC_FILE_IO_TEST_FILE_SIZE);
+    FILE* stream = tmpfile();
+    AsyncFile* writer = NULL;
+    uint8_t* buffer = NULL;
+    size_t written = 0, chunk_size = 0, read_size = 0;
+    uint32_t chunk = 0;
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_NOT_NULL(read_back);
+    TEST_ASSERT_NOT_NULL(stream);
+    fill_async_file_test_data(data, ASYNC_FILE_IO_TEST_FILE_SIZE);
+
+    // Act
+    // Chunks of uneven sizes, with an empty one, must land back to back
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, open_async_file(&writer, stream, true, ASYNC_FILE_IO_TEST_CHUNK_SIZE, backend));
+    TEST_ASSERT_NOT_EQUAL(ASYNC_IO_BACKEND_AUTO, get_async_file_backend(writer));
+    for (chunk = 0; written < ASYNC_FILE_IO_TEST_FILE_SIZE; ++chunk)
+    {
+        chunk_size = (0 == (chunk % 3)) ? ASYNC_FILE_IO_TEST_CHUNK_SIZE : ((chunk * 617) % ASYNC_FILE_IO_TEST_CHUNK_SIZE);
+        if (chunk_size > ASYNC_FILE_IO_TEST_FILE_SIZE - written)
+        {
+            chunk_size = ASYNC_FILE_IO_TEST_FILE_SIZE - written;
+        }
+        TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, async_write_acquire(&buffer, writer));
+        memcpy(buffer, data + written, chunk_size);
+        TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, async_write_submit(writer, chunk_size));
+        written += chunk_size;
+    }
+    STATUS_CODE close_return_code = close_async_file(&writer);
+    long position_after_writes = ftell(stream);
+    rewind(stream);
+    read_async_file_test_stream(read_back, &read_size, stream, backend);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, close_return_code);
+    TEST_ASSERT_EQUAL_INT64(ASYNC_FILE_IO_TEST_FILE_SIZE, position_after_writes);
+    TEST_ASSERT_EQUAL_UINT64(ASYNC_FILE_IO_TEST_FILE_SIZE, read_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, read_back, ASYNC_FILE_IO_TEST_FILE_SIZE);
+    TEST_ASSERT_EQUAL_INT64(ASYNC_FILE_IO_TEST_FILE_SIZE, ftell(stream));
+
+    fclose(stream);
+    free(data);
+    free(read_back);
+}
+
+void test_AsyncFileIO_ThreadsBackend_WritesAndReadsBackInOrder()
+{
+    run_async_file_roundtrip(ASYNC_IO_BACKEND_THREADS);
+}
+
+void test_AsyncFileIO_AutoBackend_WritesAndReadsBackInOrder()
+{
+    // io_uring where the kernel has it, the I/O thread otherwise
+    run_async_file_roundtrip(ASYNC_IO_BACKEND_AUTO);
+}
+
+void test_AsyncFileIO_Read_StartsAtStreamPosition()
+{
+    // Arrange
+    uint8_t* data = (uint8_t*)malloc(ASYNC_FILE_IO_TEST_FILE_SIZE);
+    uint8_t* read_back = (uint8_t*)malloc(ASYNC_FILE_IO_TEST_FILE_SIZE);
+    FILE* stream = tmpfile();
+    size_t read_size = 0;
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_NOT_NULL(read_back);
+    TEST_ASSERT_NOT_NULL(stream);
+    fill_async_file_test_data(data, ASYNC_FILE_IO_TEST_FILE_SIZE);
+    TEST_ASSERT_EQUAL_UINT64(ASYNC_FILE_IO_TEST_FILE_SIZE, fwrite(data, 1, ASYNC_FILE_IO_TEST_FILE_SIZE, stream));
+    TEST_ASSERT_EQUAL_INT(0, fseek(stream, ASYNC_FILE_IO_TEST_START_OFFSET, SEEK_SET));
+
+    // Act
+    read_async_file_test_stream(read_back, &read_size, stream, ASYNC_IO_BACKEND_AUTO);
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT64(ASYNC_FILE_IO_TEST_FILE_SIZE - ASYNC_FILE_IO_TEST_START_OFFSET, read_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data + ASYNC_FILE_IO_TEST_START_OFFSET, read_back, read_size);
+
+    fclose(stream);
+    free(data);
+    free(read_back);
+}
+
+void test_AsyncFileIO_EmptyFile_ReadsNothing()
+{
+    // Arrange
+    FILE* stream = tmpfile();
+    AsyncFile* reader = NULL;
+    const uint8_t* chunk = NULL;
+    size_t first_size = 1, second_size = 1;
+    TEST_ASSERT_NOT_NULL(stream);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, open_async_file(&reader, stream, false, ASYNC_FILE_IO_TEST_CHUNK_SIZE, ASYNC_IO_BACKEND_THREADS));
+
+    // Act
+    STATUS_CODE first_return_code = async_read_next(&chunk, &first_size, reader);
+    STATUS_CODE second_return_code = async_read_next(&chunk, &second_size, reader);
+    STATUS_CODE close_return_code = close_async_file(&reader);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, first_return_code);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, second_return_code);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, close_return_code);
+    TEST_ASSERT_EQUAL_UINT64(0, first_size);
+    TEST_ASSERT_EQUAL_UINT64(0, second_size);
+
+    fclose(stream);
+}
+
+void test_parse_async_io_backend_UnknownName_IsRejected()
+{
+    // Arrange
+    ASYNC_IO_BACKEND backend = ASYNC_IO_BACKEND_THREADS;
+    ASYNC_IO_BACKEND default_backend = ASYNC_IO_BACKEND_THREADS;
+
+    // Act
+    STATUS_CODE return_code = parse_async_io_backend(&backend, "aio");
+    STATUS_CODE default_return_code = parse_async_io_backend(&default_backend, NULL);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGUMENT, return_code);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, default_return_code);
+    TEST_ASSERT_EQUAL(ASYNC_IO_BACKEND_AUTO, default_backend);
+}
+
+void run_all_AsyncFileIO_tests()
+{
+    RUN_TEST(test_AsyncFileIO_ThreadsBackend_WritesAndReadsBackInOrder);
+    RUN_TEST(test_AsyncFileIO_AutoBackend_WritesAndReadsBackInOrder);
+    RUN_TEST(test_AsyncFileIO_Read_StartsAtStreamPosition);
+    RUN_TEST(test_AsyncFileIO_EmptyFile_ReadsNothing);
+    RUN_TEST(test_parse_async_io_backend_UnknownName_IsRejected);
+}
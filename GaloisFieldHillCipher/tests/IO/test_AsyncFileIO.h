@@ -0,0 +1,20 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "IO/AsyncFileIO.h"
+
+#define ASYNC_FILE_IO_TEST_CHUNK_SIZE (4096)
+#define ASYNC_FILE_IO_TEST_FILE_SIZE ((7 * ASYNC_FILE_IO_TEST_CHUNK_SIZE) + 1000) // Wraps the ring of buffers twice and ends on a partial chunk
+#define ASYNC_FILE_IO_TEST_START_OFFSET (100)
+
+void run_all_AsyncFileIO_tests();
+
+void test_AsyncFileIO_ThreadsBackend_WritesAndReadsBackInOrder();
+void test_AsyncFileIO_AutoBackend_WritesAndReadsBackInOrder();
+void test_AsyncFileIO_Read_StartsAtStreamPosition();
+void test_AsyncFileIO_EmptyFile_ReadsNothing();
+void test_parse_async_io_backend_UnknownName_IsRejected();
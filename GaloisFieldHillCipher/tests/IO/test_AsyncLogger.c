@@ -0,0 +1,115 @@
+#include "test_AsyncLogger.h"
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+void test_AsyncLogger_WritesEveryRecordInOrder()
+{
+    // Arrange
+    char line[ASYNC_LOGGER_TEST_LINE_SIZE] = {0};
+    char expected_message[ASYNC_LOGGER_TEST_LINE_SIZE] = {0};
+    uint32_t index = 0, number_of_lines = 0;
+    FILE* output = tmpfile();
+    TEST_ASSERT_NOT_NULL(output);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, start_async_logger(output, LOG_TRACE));
+
+    // Act
+    for (index = 0; index < ASYNC_LOGGER_TEST_RECORDS; ++index)
+    {
+        log_trace("async record %u", index);
+    }
+    stop_async_logger();
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT64(0, get_async_logger_dropped_records());
+    rewind(output);
+    while (NULL != fgets(line, sizeof(line), output))
+    {
+        snprintf(expected_message, sizeof(expected_message), ": async record %u\n", number_of_lines);
+        TEST_ASSERT_NOT_NULL(strstr(line, "TRACE"));
+        TEST_ASSERT_NOT_NULL(strstr(line, expected_message));
+        ++number_of_lines;
+    }
+    TEST_ASSERT_EQUAL_UINT32(ASYNC_LOGGER_TEST_RECORDS, number_of_lines);
+
+    fclose(output);
+}
+
+void test_AsyncLogger_FiltersRecordsBelowLevel()
+{
+    // Arrange
+    char line[ASYNC_LOGGER_TEST_LINE_SIZE] = {0};
+    uint32_t number_of_lines = 0;
+    FILE* output = tmpfile();
+    TEST_ASSERT_NOT_NULL(output);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, start_async_logger(output, LOG_WARN));
+
+    // Act
+    log_debug("filtered record");
+    log_warn("kept record");
+    stop_async_logger();
+    log_warn("record after stop");
+
+    // Assert
+    rewind(output);
+    while (NULL != fgets(line, sizeof(line), output))
+    {
+        TEST_ASSERT_NOT_NULL(strstr(line, "kept record"));
+        ++number_of_lines;
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, number_of_lines);
+
+    fclose(output);
+}
+
+void test_AsyncLogger_ForkedChild_WritesItsRecordsItself()
+{
+#ifdef _WIN32
+    TEST_IGNORE_MESSAGE("fork is not supported on Windows");
+#else
+    // Arrange
+    char line[ASYNC_LOGGER_TEST_LINE_SIZE] = {0};
+    uint32_t parent_lines = 0, child_lines = 0;
+    int status = 0;
+    pid_t pid = 0;
+    FILE* output = tmpfile();
+    TEST_ASSERT_NOT_NULL(output);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, start_async_logger(output, LOG_TRACE));
+    log_info("parent record");
+    fflush(NULL);
+
+    // Act
+    pid = fork();
+    TEST_ASSERT_TRUE(0 <= pid);
+    if (0 == pid)
+    {
+        switch_async_logger_to_synchronous_after_fork();
+        log_info("child record");
+        _exit(EXIT_SUCCESS);
+    }
+    TEST_ASSERT_EQUAL(pid, waitpid(pid, &status, 0));
+    stop_async_logger();
+
+    // Assert
+    TEST_ASSERT_TRUE(WIFEXITED(status));
+    rewind(output);
+    while (NULL != fgets(line, sizeof(line), output))
+    {
+        parent_lines += (NULL != strstr(line, "parent record")) ? 1 : 0;
+        child_lines += (NULL != strstr(line, "child record")) ? 1 : 0;
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, parent_lines);
+    TEST_ASSERT_EQUAL_UINT32(1, child_lines);
+
+    fclose(output);
+#endif
+}
+
+void run_all_AsyncLogger_tests()
+{
+    RUN_TEST(test_AsyncLogger_WritesEveryRecordInOrder);
+    RUN_TEST(test_AsyncLogger_FiltersRecordsBelowLevel);
+    RUN_TEST(test_AsyncLogger_ForkedChild_WritesItsRecordsItself);
+}
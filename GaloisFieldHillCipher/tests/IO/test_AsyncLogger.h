@@ -0,0 +1,17 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "IO/AsyncLogger.h"
+
+#define ASYNC_LOGGER_TEST_RECORDS (1000)
+#define ASYNC_LOGGER_TEST_LINE_SIZE (512)
+
+void run_all_AsyncLogger_tests();
+
+void test_AsyncLogger_WritesEveryRecordInOrder();
+void test_AsyncLogger_FiltersRecordsBelowLevel();
+void test_AsyncLogger_ForkedChild_WritesItsRecordsItself();
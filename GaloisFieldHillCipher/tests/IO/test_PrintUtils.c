@@ -0,0 +1,52 @@
+#include "test_PrintUtils.h"
+
+void test_PrintUtils_Preview_WithinBudget_ShowsEveryElement()
+{
+    // Arrange
+    const uint8_t data[] = {0x00, 0x01, 0xab, 0xff};
+    char* preview = NULL;
+    set_preview_element_budget(PREVIEW_TEST_BUDGET);
+
+    // Act
+    preview = format_uint8_vector_preview(data, sizeof(data), "Data:");
+
+    // Assert
+    TEST_ASSERT_NOT_NULL(preview);
+    TEST_ASSERT_EQUAL_STRING("Data:\n00 01 ab ff \n", preview);
+
+    free(preview);
+    set_preview_element_budget(0);
+}
+
+void test_PrintUtils_Preview_AboveBudget_ShowsHeadTailAndDigest()
+{
+    // Arrange
+    uint8_t* data = (uint8_t*)malloc(PREVIEW_TEST_LARGE_SIZE);
+    char expected_digest[64] = {0};
+    char* preview = NULL;
+    TEST_ASSERT_NOT_NULL(data);
+    memset(data, 0x11, PREVIEW_TEST_LARGE_SIZE);
+    data[PREVIEW_TEST_LARGE_SIZE - 1] = 0xee;
+    set_preview_element_budget(PREVIEW_TEST_BUDGET);
+    snprintf(expected_digest, sizeof(expected_digest), "[%d elements, fnv1a64 %016llx]", PREVIEW_TEST_LARGE_SIZE,
+             (unsigned long long)update_preview_digest(PREVIEW_DIGEST_OFFSET_BASIS, data, PREVIEW_TEST_LARGE_SIZE));
+
+    // Act
+    preview = format_uint8_vector_preview(data, PREVIEW_TEST_LARGE_SIZE, "Data:");
+
+    // Assert
+    TEST_ASSERT_NOT_NULL(preview);
+    TEST_ASSERT_EQUAL(0, strncmp(preview, "Data:\n11 11 11 11 \n... 999992 elements omitted ...\n11 11 11 ee ", 63));
+    TEST_ASSERT_NOT_NULL(strstr(preview, expected_digest));
+    TEST_ASSERT_TRUE(strlen(preview) < PRINT_BUFFER_EXTRA + 64);
+
+    free(preview);
+    free(data);
+    set_preview_element_budget(0);
+}
+
+void run_all_PrintUtils_tests()
+{
+    RUN_TEST(test_PrintUtils_Preview_WithinBudget_ShowsEveryElement);
+    RUN_TEST(test_PrintUtils_Preview_AboveBudget_ShowsHeadTailAndDigest);
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "IO/PrintUtils.h"
+
+#define PREVIEW_TEST_BUDGET (8)
+#define PREVIEW_TEST_LARGE_SIZE (1000000)
+
+void run_all_PrintUtils_tests();
+
+void test_PrintUtils_Preview_WithinBudget_ShowsEveryElement();
+void test_PrintUtils_Preview_AboveBudget_ShowsHeadTailAndDigest();
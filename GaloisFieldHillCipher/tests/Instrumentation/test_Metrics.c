@@ -0,0 +1,64 @@
+#include "test_Metrics.h"
+
+void test_Metrics_Histogram_CumulativeBuckets()
+{
+    // Arrange
+    const LatencyHistogram* histogram = NULL;
+    reset_metrics();
+
+    // Act
+    observe_stage_latency(PIPELINE_STAGE_AFFINE, 500);            // First bucket, 1us
+    observe_stage_latency(PIPELINE_STAGE_AFFINE, 3000);           // Second bucket, 4us
+    observe_stage_latency(PIPELINE_STAGE_AFFINE, 10000000000ULL); // Above every bound, only in +Inf
+    histogram = get_stage_latency_histogram(PIPELINE_STAGE_AFFINE);
+
+    // Assert
+    TEST_ASSERT_NOT_NULL(histogram);
+    TEST_ASSERT_EQUAL_UINT64(1, histogram->bucket_counts[0]);
+    TEST_ASSERT_EQUAL_UINT64(1, histogram->bucket_counts[1]);
+    TEST_ASSERT_EQUAL_UINT64(0, histogram->bucket_counts[NUMBER_OF_LATENCY_BUCKETS - 1]);
+    TEST_ASSERT_EQUAL_UINT64(3, histogram->count);
+    TEST_ASSERT_EQUAL_UINT64(10000003500ULL, histogram->sum_ns);
+
+    reset_metrics();
+}
+
+void test_Metrics_PrometheusText_ContainsCountersAndHistogram()
+{
+    // Arrange
+    char text[METRICS_TEST_BUFFER_SIZE] = {0};
+    size_t text_size = 0;
+    FILE* output = tmpfile();
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    TEST_ASSERT_NOT_NULL(output);
+    reset_metrics();
+    increase_metric_counter(METRIC_COUNTER_BLOCKS_ENCRYPTED, 40);
+    increase_metric_counter(METRIC_COUNTER_BLOCKS_ENCRYPTED, 2);
+    set_metric_gauge(METRIC_GAUGE_KEY_DIMENSION, 16);
+    observe_stage_latency(PIPELINE_STAGE_WRITE, 2000);
+
+    // Act
+    return_code = write_metrics_prometheus(output);
+    rewind(output);
+    text_size = fread(text, 1, sizeof(text) - 1, output);
+    text[text_size] = '\0';
+    fclose(output);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, return_code);
+    TEST_ASSERT_EQUAL_UINT64(42, get_metric_counter(METRIC_COUNTER_BLOCKS_ENCRYPTED));
+    TEST_ASSERT_NOT_NULL(strstr(text, "# TYPE hillcipher_blocks_encrypted_total counter\nhillcipher_blocks_encrypted_total 42\n"));
+    TEST_ASSERT_NOT_NULL(strstr(text, "hillcipher_key_dimension 16\n"));
+    TEST_ASSERT_NOT_NULL(strstr(text, "hillcipher_stage_latency_seconds_bucket{stage=\"write\",le=\"1e-06\"} 0\n"));
+    TEST_ASSERT_NOT_NULL(strstr(text, "hillcipher_stage_latency_seconds_bucket{stage=\"write\",le=\"4e-06\"} 1\n"));
+    TEST_ASSERT_NOT_NULL(strstr(text, "hillcipher_stage_latency_seconds_count{stage=\"write\"} 1\n"));
+    TEST_ASSERT_NULL(strstr(text, "stage=\"read\""));
+
+    reset_metrics();
+}
+
+void run_all_Metrics_tests()
+{
+    RUN_TEST(test_Metrics_Histogram_CumulativeBuckets);
+    RUN_TEST(test_Metrics_PrometheusText_ContainsCountersAndHistogram);
+}
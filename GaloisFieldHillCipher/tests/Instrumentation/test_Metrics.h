@@ -0,0 +1,14 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "unity.h"
+#include "Instrumentation/Metrics.h"
+
+#define METRICS_TEST_BUFFER_SIZE (16384)
+
+void run_all_Metrics_tests();
+
+void test_Metrics_Histogram_CumulativeBuckets();
+void test_Metrics_PrometheusText_ContainsCountersAndHistogram();
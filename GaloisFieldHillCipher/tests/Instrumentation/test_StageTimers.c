@@ -0,0 +1,47 @@
+#include "test_StageTimers.h"
+
+void test_StageTimers_Disabled_RecordsNothing()
+{
+    // Arrange
+    uint64_t start_time = 0;
+    set_stage_timing_mode(false);
+    reset_stage_statistics();
+
+    // Act
+    start_time = start_stage_timer();
+    stop_stage_timer(PIPELINE_STAGE_BLOCK_MULTIPLY, start_time, 64);
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT64(0, start_time);
+    TEST_ASSERT_EQUAL_UINT64(0, get_stage_statistics(PIPELINE_STAGE_BLOCK_MULTIPLY)->calls);
+    TEST_ASSERT_EQUAL_UINT64(0, get_stage_statistics(PIPELINE_STAGE_BLOCK_MULTIPLY)->bytes_processed);
+}
+
+void test_StageTimers_Enabled_AccumulatesCallsAndBytes()
+{
+    // Arrange
+    uint64_t start_time = 0;
+    set_stage_timing_mode(true);
+    reset_stage_statistics();
+
+    // Act
+    start_time = start_stage_timer();
+    stop_stage_timer(PIPELINE_STAGE_SERIALIZE, start_time, 100);
+    start_time = start_stage_timer();
+    stop_stage_timer(PIPELINE_STAGE_SERIALIZE, start_time, 28);
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT64(2, get_stage_statistics(PIPELINE_STAGE_SERIALIZE)->calls);
+    TEST_ASSERT_EQUAL_UINT64(128, get_stage_statistics(PIPELINE_STAGE_SERIALIZE)->bytes_processed);
+    TEST_ASSERT_EQUAL_UINT64(0, get_stage_statistics(PIPELINE_STAGE_WRITE)->calls);
+    TEST_ASSERT_NULL(get_stage_statistics(NUMBER_OF_PIPELINE_STAGES));
+
+    set_stage_timing_mode(false);
+    reset_stage_statistics();
+}
+
+void run_all_StageTimers_tests()
+{
+    RUN_TEST(test_StageTimers_Disabled_RecordsNothing);
+    RUN_TEST(test_StageTimers_Enabled_AccumulatesCallsAndBytes);
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include <stdint.h>
+
+#include "unity.h"
+#include "Instrumentation/StageTimers.h"
+
+void run_all_StageTimers_tests();
+
+void test_StageTimers_Disabled_RecordsNothing();
+void test_StageTimers_Enabled_AccumulatesCallsAndBytes();
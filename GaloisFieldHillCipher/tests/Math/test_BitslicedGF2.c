@@ -0,0 +1,239 @@
+#include "test_BitslicedGF2.h"
+
+static const uint32_t g_test_dimensions[] = {8, 24, 64, 72, 136}; // Whole, partial and several words per row
+static const size_t g_test_block_counts[] = {1, 7, 8, 64, 65, BITSLICED_GF2_TEST_MAXIMAL_BLOCKS}; // Row parities, one or more slices and both
+
+static uint64_t next_test_word(uint64_t* state)
+{
+    *state = (*state * 6364136223846793005ULL) + 1442695040888963407ULL;
+    return *state ^ (*state >> 29);
+}
+
+static uint32_t get_test_block_bit(const uint8_t* block, size_t element)
+{
+    return (block[element / 8] >> (7 - (element % 8))) & 1;
+}
+
+void test_BitslicedGF2_Transpose_SwapsRowsAndColumns()
+{
+    // Arrange
+    uint64_t words[GF2_BITS_PER_WORD] = {0}, original[GF2_BITS_PER_WORD] = {0};
+    uint64_t state = 17;
+    size_t row = 0, column = 0;
+
+    for (row = 0; row < GF2_BITS_PER_WORD; ++row)
+    {
+        original[row] = next_test_word(&state);
+        words[row] = original[row];
+    }
+
+    // Act
+    transpose_gf2_64x64(words);
+
+    // Assert
+    for (row = 0; row < GF2_BITS_PER_WORD; ++row)
+    {
+        for (column = 0; column < GF2_BITS_PER_WORD; ++column)
+        {
+            TEST_ASSERT_EQUAL_UINT64((original[column] >> row) & 1, (words[row] >> column) & 1);
+        }
+    }
+}
+
+void test_BitslicedGF2_Invert_ProductWithMatrixIsIdentity()
+{
+    int64_t** matrix = NULL;
+    int64_t** inverse = NULL;
+    uint32_t dimension = 0;
+    int64_t sum = 0;
+    size_t dimension_index = 0, row = 0, column = 0, k = 0;
+
+    for (dimension_index = 0; dimension_index < sizeof(g_test_dimensions) / sizeof(g_test_dimensions[0]); ++dimension_index)
+    {
+        // Arrange
+        dimension = g_test_dimensions[dimension_index];
+        TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, generate_invertible_matrix_over_field(&matrix, NULL, dimension, GF2_PRIME_FIELD));
+
+        // Act
+        TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, inverse_square_matrix_over_gf2(&inverse, matrix, dimension));
+
+        // Assert
+        for (row = 0; row < dimension; ++row)
+        {
+            for (column = 0; column < dimension; ++column)
+            {
+                for (k = 0, sum = 0; k < dimension; ++k)
+                {
+                    sum ^= matrix[row][k] & inverse[k][column];
+                }
+                TEST_ASSERT_EQUAL_INT64((row == column) ? 1 : 0, sum);
+            }
+        }
+
+        (void)free_int64_matrix(matrix, dimension);
+        (void)free_int64_matrix(inverse, dimension);
+        matrix = NULL;
+        inverse = NULL;
+    }
+}
+
+void test_BitslicedGF2_Invert_SingularMatrixIsRejected()
+{
+    // Arrange - the last row is the sum of the first two
+    int64_t** matrix = NULL;
+    int64_t** inverse = NULL;
+    uint32_t dimension = 24;
+    size_t column = 0;
+
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, generate_invertible_matrix_over_field(&matrix, NULL, dimension, GF2_PRIME_FIELD));
+    for (column = 0; column < dimension; ++column)
+    {
+        matrix[dimension - 1][column] = matrix[0][column] ^ matrix[1][column];
+    }
+
+    // Act & Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_MATRIX_NOT_INVERTIBLE, inverse_square_matrix_over_gf2(&inverse, matrix, dimension));
+    TEST_ASSERT_NULL(inverse);
+
+    (void)free_int64_matrix(matrix, dimension);
+}
+
+void test_BitslicedGF2_Multiply_MatchesNaiveProductForEveryBlockCount()
+{
+    FieldVector flat_matrix = {0}, input_offset = {0}, output_offset = {0};
+    GF2BitMatrix matrix = {0};
+    uint64_t* packed_input_offset = NULL;
+    uint64_t* packed_output_offset = NULL;
+    uint8_t* blocks = NULL;
+    uint8_t* out_blocks = NULL;
+    uint64_t state = 5;
+    uint32_t dimension = 0, bytes_per_block = 0, expected = 0;
+    size_t dimension_index = 0, count_index = 0, number_of_blocks = 0, block = 0, row = 0, column = 0;
+
+    blocks = (uint8_t*)malloc(BITSLICED_GF2_TEST_MAXIMAL_BLOCKS * BITSLICED_GF2_TEST_MAXIMAL_DIMENSION / 8);
+    out_blocks = (uint8_t*)malloc(BITSLICED_GF2_TEST_MAXIMAL_BLOCKS * BITSLICED_GF2_TEST_MAXIMAL_DIMENSION / 8);
+    TEST_ASSERT_NOT_NULL(blocks);
+    TEST_ASSERT_NOT_NULL(out_blocks);
+
+    for (dimension_index = 0; dimension_index < sizeof(g_test_dimensions) / sizeof(g_test_dimensions[0]); ++dimension_index)
+    {
+        // Arrange
+        dimension = g_test_dimensions[dimension_index];
+        bytes_per_block = dimension / 8;
+        TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_field_vector(&flat_matrix, dimension * dimension, GF2_PRIME_FIELD));
+        TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_field_vector(&input_offset, dimension, GF2_PRIME_FIELD));
+        TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_field_vector(&output_offset, dimension, GF2_PRIME_FIELD));
+        for (row = 0; row < flat_matrix.length; ++row)
+        {
+            set_field_vector_element(&flat_matrix, row, (uint32_t)(next_test_word(&state) & 1));
+        }
+        for (row = 0; row < dimension; ++row)
+        {
+            set_field_vector_element(&input_offset, row, (uint32_t)(next_test_word(&state) & 1));
+            set_field_vector_element(&output_offset, row, (uint32_t)(next_test_word(&state) & 1));
+        }
+        TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, pack_gf2_bit_matrix(&matrix, &flat_matrix, dimension));
+        TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, pack_gf2_bit_vector(&packed_input_offset, &input_offset, dimension));
+        TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, pack_gf2_bit_vector(&packed_output_offset, &output_offset, dimension));
+
+        for (count_index = 0; count_index < sizeof(g_test_block_counts) / sizeof(g_test_block_counts[0]); ++count_index)
+        {
+            number_of_blocks = g_test_block_counts[count_index];
+            for (block = 0; block < number_of_blocks * bytes_per_block; ++block)
+            {
+                blocks[block] = (uint8_t)next_test_word(&state);
+            }
+
+            // Act
+            TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, multiply_gf2_blocks(out_blocks, blocks, number_of_blocks, &matrix,
+                                                                       packed_input_offset, packed_output_offset));
+
+            // Assert
+            for (block = 0; block < number_of_blocks; ++block)
+            {
+                for (row = 0; row < dimension; ++row)
+                {
+                    expected = get_field_vector_element(&output_offset, row);
+                    for (column = 0; column < dimension; ++column)
+                    {
+                        expected ^= get_field_vector_element(&flat_matrix, (row * dimension) + column) &
+                            (get_test_block_bit(blocks + (block * bytes_per_block), column) ^ get_field_vector_element(&input_offset, column));
+                    }
+                    TEST_ASSERT_EQUAL_UINT32(expected, get_test_block_bit(out_blocks + (block * bytes_per_block), row));
+                }
+            }
+        }
+
+        free_gf2_bit_matrix(&matrix);
+        free(packed_input_offset);
+        free(packed_output_offset);
+        packed_input_offset = NULL;
+        packed_output_offset = NULL;
+        free_field_vector(&flat_matrix);
+        free_field_vector(&input_offset);
+        free_field_vector(&output_offset);
+    }
+
+    free(blocks);
+    free(out_blocks);
+}
+
+void test_BitslicedGF2_EncryptAndSerialize_Roundtrip()
+{
+    // Arrange - enough plaintext for whole slices and a tail of row parities
+    uint8_t plaintext[1000] = {0};
+    uint32_t plaintext_size = sizeof(plaintext);
+    KeyGenerationArguments key_generation_arguments = {NULL, 64, 2, GF2_PRIME_FIELD, 3, 2};
+    Secrets* encryption_secrets = NULL;
+    Secrets* decryption_secrets = NULL;
+    uint8_t* ciphertext = NULL;
+    uint32_t ciphertext_size = 0;
+    uint8_t* decrypted = NULL;
+    uint32_t decrypted_size = 0;
+    uint8_t* text_ciphertext = NULL;
+    uint32_t text_ciphertext_size = 0;
+    STATUS_CODE encryption_status = STATUS_CODE_UNINITIALIZED;
+    STATUS_CODE decryption_status = STATUS_CODE_UNINITIALIZED;
+    STATUS_CODE text_status = STATUS_CODE_UNINITIALIZED;
+    size_t index = 0;
+
+    for (index = 0; index < plaintext_size; ++index)
+    {
+        plaintext[index] = (uint8_t)((index * 37) ^ (index >> 3));
+    }
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_encryption_secrets(&encryption_secrets, &key_generation_arguments));
+
+    // Act
+    encryption_status = encrypt_and_serialize(&ciphertext, &ciphertext_size, plaintext, plaintext_size,
+                                              *encryption_secrets, CIPHERTEXT_FORMAT_BINARY);
+    text_status = encrypt_and_serialize(&text_ciphertext, &text_ciphertext_size, plaintext, plaintext_size,
+                                        *encryption_secrets, CIPHERTEXT_FORMAT_TEXT);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_decryption_secrets(&decryption_secrets, encryption_secrets));
+    decryption_status = deserialize_and_decrypt(&decrypted, &decrypted_size, ciphertext, ciphertext_size,
+                                                *decryption_secrets, CIPHERTEXT_FORMAT_BINARY);
+
+    // Assert - a block is 8 bytes, 11 bits of expansion per byte and the padding magic byte
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, encryption_status);
+    TEST_ASSERT_EQUAL(((((plaintext_size * 11) + 7) / 8) / 8 + 1) * 8, ciphertext_size);
+    TEST_ASSERT_NOT_EQUAL(STATUS_CODE_SUCCESS, text_status);
+    TEST_ASSERT_NULL(text_ciphertext);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, decryption_status);
+    TEST_ASSERT_EQUAL(plaintext_size, decrypted_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, decrypted, plaintext_size);
+
+    free_secrets(encryption_secrets);
+    free(encryption_secrets);
+    free_secrets(decryption_secrets);
+    free(decryption_secrets);
+    free(ciphertext);
+    free(decrypted);
+}
+
+void run_all_BitslicedGF2_tests()
+{
+    RUN_TEST(test_BitslicedGF2_Transpose_SwapsRowsAndColumns);
+    RUN_TEST(test_BitslicedGF2_Invert_ProductWithMatrixIsIdentity);
+    RUN_TEST(test_BitslicedGF2_Invert_SingularMatrixIsRejected);
+    RUN_TEST(test_BitslicedGF2_Multiply_MatchesNaiveProductForEveryBlockCount);
+    RUN_TEST(test_BitslicedGF2_EncryptAndSerialize_Roundtrip);
+}
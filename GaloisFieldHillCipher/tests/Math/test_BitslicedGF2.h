@@ -0,0 +1,20 @@
+#pragma once
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "unity.h"
+#include "Math/BitslicedGF2.h"
+#include "Math/MatrixUtils.h"
+#include "Cipher/Cipher.h"
+#include "Secrets/SecretsGeneration.h"
+
+#define BITSLICED_GF2_TEST_MAXIMAL_DIMENSION (136)
+#define BITSLICED_GF2_TEST_MAXIMAL_BLOCKS (131)
+
+void run_all_BitslicedGF2_tests();
+
+void test_BitslicedGF2_Transpose_SwapsRowsAndColumns();
+void test_BitslicedGF2_Invert_ProductWithMatrixIsIdentity();
+void test_BitslicedGF2_Invert_SingularMatrixIsRejected();
+void test_BitslicedGF2_Multiply_MatchesNaiveProductForEveryBlockCount();
+void test_BitslicedGF2_EncryptAndSerialize_Roundtrip();
@@ -0,0 +1,113 @@
+#include "test_CirculantMatrix.h"
+
+static void fill_test_column(int64_t* column)
+{
+    uint32_t index = 0;
+
+    for (index = 0; index < CIRCULANT_TEST_DIMENSION; ++index)
+    {
+        column[index] = ((int64_t)index * 7919 + 3) % CIRCULANT_TEST_PRIME_FIELD;
+    }
+}
+
+void test_CirculantMatrix_Ntt_ForwardThenInverse_ReturnsInput()
+{
+    // Arrange
+    NttContext context = {0};
+    uint32_t values[CIRCULANT_TEST_DIMENSION] = {0};
+    uint32_t expected[CIRCULANT_TEST_DIMENSION] = {0};
+    uint32_t index = 0;
+    for (index = 0; index < CIRCULANT_TEST_DIMENSION; ++index)
+    {
+        values[index] = expected[index] = (index * 104729u) % CIRCULANT_TEST_PRIME_FIELD;
+    }
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, initialize_ntt_context(&context, CIRCULANT_TEST_DIMENSION, CIRCULANT_TEST_PRIME_FIELD));
+
+    // Act
+    ntt_forward(values, &context);
+    ntt_inverse(values, &context);
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, values, CIRCULANT_TEST_DIMENSION);
+    TEST_ASSERT_FALSE(is_ntt_compatible(CIRCULANT_TEST_DIMENSION, 16777619));
+
+    free_ntt_context(&context);
+}
+
+void test_CirculantMatrix_Multiply_MatchesExpandedDenseMatrix()
+{
+    // Arrange
+    int64_t column[CIRCULANT_TEST_DIMENSION] = {0};
+    uint8_t plaintext[CIRCULANT_TEST_DIMENSION] = {0};
+    int64_t** dense_matrix = NULL;
+    int64_t* dense_product = NULL;
+    CirculantKey key = {0};
+    FieldVector circulant_product = {0};
+    uint32_t index = 0;
+    fill_test_column(column);
+    for (index = 0; index < CIRCULANT_TEST_DIMENSION; ++index)
+    {
+        plaintext[index] = (uint8_t)(index * 37 + 250);
+    }
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, expand_circulant_column(&dense_matrix, column, CIRCULANT_TEST_DIMENSION));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, multiply_matrix_with_uint8_t_vector(&dense_product, dense_matrix, plaintext, CIRCULANT_TEST_DIMENSION, CIRCULANT_TEST_PRIME_FIELD));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, initialize_circulant_key(&key, column, CIRCULANT_TEST_DIMENSION, CIRCULANT_TEST_PRIME_FIELD));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_field_vector(&circulant_product, CIRCULANT_TEST_DIMENSION, CIRCULANT_TEST_PRIME_FIELD));
+
+    // Act
+    STATUS_CODE return_code = multiply_circulant_with_uint8_t_vector(&circulant_product, &key, plaintext, NULL);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, return_code);
+    for (index = 0; index < CIRCULANT_TEST_DIMENSION; ++index)
+    {
+        TEST_ASSERT_EQUAL_UINT32((uint32_t)dense_product[index], get_field_vector_element(&circulant_product, index));
+    }
+
+    free_field_vector(&circulant_product);
+    free_circulant_key(&key);
+    free(dense_product);
+    (void)free_int64_matrix(dense_matrix, CIRCULANT_TEST_DIMENSION);
+}
+
+void test_CirculantMatrix_InverseColumn_DecryptsCirculantProduct()
+{
+    // Arrange
+    int64_t column[CIRCULANT_TEST_DIMENSION] = {0};
+    int64_t* inverse_column = NULL;
+    uint8_t plaintext[CIRCULANT_TEST_DIMENSION] = {0};
+    uint8_t decrypted[CIRCULANT_TEST_DIMENSION] = {0};
+    CirculantKey key = {0};
+    CirculantKey inverse_key = {0};
+    FieldVector ciphertext = {0};
+    uint32_t index = 0;
+    fill_test_column(column);
+    for (index = 0; index < CIRCULANT_TEST_DIMENSION; ++index)
+    {
+        plaintext[index] = (uint8_t)(255 - index * 13);
+    }
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, invert_circulant_column(&inverse_column, column, CIRCULANT_TEST_DIMENSION, CIRCULANT_TEST_PRIME_FIELD));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, initialize_circulant_key(&key, column, CIRCULANT_TEST_DIMENSION, CIRCULANT_TEST_PRIME_FIELD));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, initialize_circulant_key(&inverse_key, inverse_column, CIRCULANT_TEST_DIMENSION, CIRCULANT_TEST_PRIME_FIELD));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_field_vector(&ciphertext, CIRCULANT_TEST_DIMENSION, CIRCULANT_TEST_PRIME_FIELD));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, multiply_circulant_with_uint8_t_vector(&ciphertext, &key, plaintext, NULL));
+
+    // Act
+    STATUS_CODE return_code = multiply_circulant_with_field_vector(decrypted, &inverse_key, &ciphertext);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, return_code);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, decrypted, CIRCULANT_TEST_DIMENSION);
+
+    free_field_vector(&ciphertext);
+    free_circulant_key(&inverse_key);
+    free_circulant_key(&key);
+    free(inverse_column);
+}
+
+void run_all_CirculantMatrix_tests()
+{
+    RUN_TEST(test_CirculantMatrix_Ntt_ForwardThenInverse_ReturnsInput);
+    RUN_TEST(test_CirculantMatrix_Multiply_MatchesExpandedDenseMatrix);
+    RUN_TEST(test_CirculantMatrix_InverseColumn_DecryptsCirculantProduct);
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "unity.h"
+#include "Math/CirculantMatrix.h"
+#include "Math/MatrixMultiplication.h"
+
+#define CIRCULANT_TEST_DIMENSION (16)
+#define CIRCULANT_TEST_PRIME_FIELD (7340033) // 7 * 2^20 + 1
+
+void run_all_CirculantMatrix_tests();
+
+void test_CirculantMatrix_Ntt_ForwardThenInverse_ReturnsInput();
+void test_CirculantMatrix_Multiply_MatchesExpandedDenseMatrix();
+void test_CirculantMatrix_InverseColumn_DecryptsCirculantProduct();
@@ -0,0 +1,144 @@
+#include "test_ColumnProductTables.h"
+
+// Every accumulator width: 16 bit sums, 16 bit elements with 32 bit sums and 32 bit elements
+static const uint32_t g_test_primes[] = {3, 257, 65521, 2147483647};
+// Unrolled kernels (8 and 64) and the runtime-dimension loop, the largest takes two passes of rows
+static const uint32_t g_test_dimensions[] = {1, 8, 17, 64, COLUMN_PRODUCT_TABLES_TEST_MAXIMAL_DIMENSION};
+
+static uint64_t next_test_number(uint64_t* state)
+{
+    *state = (*state * 6364136223846793005ULL) + 1442695040888963407ULL;
+    return *state >> 29;
+}
+
+void test_ColumnProductTables_Multiply_MatchesMatrixProduct()
+{
+    FieldVector flat_matrix = {0}, offset_vector = {0}, out_blocks = {0}, expected_block = {0};
+    ColumnProductTables tables = {0};
+    uint8_t blocks[COLUMN_PRODUCT_TABLES_TEST_NUMBER_OF_BLOCKS * COLUMN_PRODUCT_TABLES_TEST_MAXIMAL_DIMENSION] = {0};
+    uint64_t state = 11;
+    uint32_t dimension = 0, prime_field = 0;
+    size_t prime_index = 0, dimension_index = 0, index = 0, block = 0, row = 0;
+
+    for (prime_index = 0; prime_index < sizeof(g_test_primes) / sizeof(g_test_primes[0]); ++prime_index)
+    {
+        for (dimension_index = 0; dimension_index < sizeof(g_test_dimensions) / sizeof(g_test_dimensions[0]); ++dimension_index)
+        {
+            // Arrange - the largest key element and byte value are always present
+            prime_field = g_test_primes[prime_index];
+            dimension = g_test_dimensions[dimension_index];
+            TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_field_vector(&flat_matrix, dimension * dimension, prime_field));
+            TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_field_vector(&offset_vector, dimension, prime_field));
+            TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_field_vector(&out_blocks, COLUMN_PRODUCT_TABLES_TEST_NUMBER_OF_BLOCKS * dimension, prime_field));
+            TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_field_vector(&expected_block, dimension, prime_field));
+            for (index = 0; index < flat_matrix.length; ++index)
+            {
+                set_field_vector_element(&flat_matrix, index, (0 == index) ? (prime_field - 1) : (uint32_t)(next_test_number(&state) % prime_field));
+            }
+            for (index = 0; index < dimension; ++index)
+            {
+                set_field_vector_element(&offset_vector, index, (uint32_t)(next_test_number(&state) % prime_field));
+            }
+            for (index = 0; index < COLUMN_PRODUCT_TABLES_TEST_NUMBER_OF_BLOCKS * dimension; ++index)
+            {
+                blocks[index] = (0 == index) ? UINT8_MAX : (uint8_t)next_test_number(&state);
+            }
+            TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_column_product_tables(&tables, &flat_matrix, dimension, prime_field));
+
+            // Act
+            TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, multiply_column_product_tables_with_uint8_t_blocks(&out_blocks, &tables, blocks,
+                                                                                                    COLUMN_PRODUCT_TABLES_TEST_NUMBER_OF_BLOCKS, &offset_vector));
+
+            // Assert
+            for (block = 0; block < COLUMN_PRODUCT_TABLES_TEST_NUMBER_OF_BLOCKS; ++block)
+            {
+                TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, multiply_flat_matrix_with_uint8_t_vector(&expected_block, &flat_matrix, blocks + (block * dimension),
+                                                                                               &offset_vector, dimension, prime_field));
+                for (row = 0; row < dimension; ++row)
+                {
+                    TEST_ASSERT_EQUAL_UINT32(get_field_vector_element(&expected_block, row), get_field_vector_element(&out_blocks, (block * dimension) + row));
+                }
+            }
+
+            free_column_product_tables(&tables);
+            free_field_vector(&flat_matrix);
+            free_field_vector(&offset_vector);
+            free_field_vector(&out_blocks);
+            free_field_vector(&expected_block);
+        }
+    }
+}
+
+void test_ColumnProductTables_CanUse_RespectsMemoryBudget()
+{
+    // Act & Assert - with the default budget and dimension list
+    TEST_ASSERT_EQUAL_UINT64(256ULL * 8 * 8 * sizeof(uint16_t), calculate_column_product_tables_size(8, 257));
+    TEST_ASSERT_EQUAL_UINT64(256ULL * 8 * 8 * sizeof(uint32_t), calculate_column_product_tables_size(8, 65537));
+    TEST_ASSERT_TRUE(can_use_column_product_tables(8, 257));
+    TEST_ASSERT_TRUE(can_use_column_product_tables(16, 65537));
+    TEST_ASSERT_FALSE(can_use_column_product_tables(32, 257)); // 512 KiB of tables
+    TEST_ASSERT_FALSE(can_use_column_product_tables(12, 257)); // No unrolled kernel
+    TEST_ASSERT_FALSE(can_use_column_product_tables(0, 257));
+    TEST_ASSERT_FALSE(can_use_column_product_tables(8, 1));
+}
+
+void test_ColumnProductTables_EncryptionContext_BuildsTablesAndRoundtrips()
+{
+    // Arrange
+    uint8_t plaintext[777] = {0};
+    uint32_t plaintext_size = sizeof(plaintext);
+    KeyGenerationArguments key_generation_arguments = {NULL, 8, 2, 257, 3, 2};
+    Secrets* encryption_secrets = NULL;
+    Secrets* decryption_secrets = NULL;
+    CipherContext encryption_context = {0};
+    CipherContext decryption_context = {0};
+    CIPHERTEXT_FORMAT formats[] = {CIPHERTEXT_FORMAT_BINARY, CIPHERTEXT_FORMAT_TEXT};
+    uint8_t* ciphertexts[sizeof(formats) / sizeof(formats[0])] = {NULL};
+    uint32_t ciphertext_sizes[sizeof(formats) / sizeof(formats[0])] = {0};
+    uint8_t* decrypted = NULL;
+    uint32_t decrypted_size = 0;
+    size_t index = 0;
+
+    for (index = 0; index < plaintext_size; ++index)
+    {
+        plaintext[index] = (uint8_t)((index * 131) ^ (index >> 2));
+    }
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_encryption_secrets(&encryption_secrets, &key_generation_arguments));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, prepare_cipher_context(&encryption_context, encryption_secrets));
+
+    // Act & Assert - the decryption secrets take members of the encryption secrets, so every encryption comes first
+    TEST_ASSERT_TRUE(encryption_context.has_column_tables);
+    for (index = 0; index < sizeof(formats) / sizeof(formats[0]); ++index)
+    {
+        TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, encrypt_and_serialize_with_context(&ciphertexts[index], &ciphertext_sizes[index], plaintext,
+                                                                                  plaintext_size, &encryption_context, formats[index]));
+    }
+    free_cipher_context(&encryption_context);
+
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_decryption_secrets(&decryption_secrets, encryption_secrets));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, prepare_cipher_context(&decryption_context, decryption_secrets));
+    TEST_ASSERT_FALSE(decryption_context.has_column_tables);
+    for (index = 0; index < sizeof(formats) / sizeof(formats[0]); ++index)
+    {
+        TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, deserialize_and_decrypt_with_context(&decrypted, &decrypted_size, ciphertexts[index],
+                                                                                    ciphertext_sizes[index], &decryption_context, formats[index]));
+        TEST_ASSERT_EQUAL(plaintext_size, decrypted_size);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, decrypted, plaintext_size);
+        free(ciphertexts[index]);
+        free(decrypted);
+        decrypted = NULL;
+    }
+
+    free_cipher_context(&decryption_context);
+    free_secrets(encryption_secrets);
+    free(encryption_secrets);
+    free_secrets(decryption_secrets);
+    free(decryption_secrets);
+}
+
+void run_all_ColumnProductTables_tests()
+{
+    RUN_TEST(test_ColumnProductTables_Multiply_MatchesMatrixProduct);
+    RUN_TEST(test_ColumnProductTables_CanUse_RespectsMemoryBudget);
+    RUN_TEST(test_ColumnProductTables_EncryptionContext_BuildsTablesAndRoundtrips);
+}
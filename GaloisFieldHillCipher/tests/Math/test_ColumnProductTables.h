@@ -0,0 +1,19 @@
+#pragma once
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "unity.h"
+#include "Math/ColumnProductTables.h"
+#include "Math/MatrixMultiplication.h"
+#include "Cipher/Cipher.h"
+#include "Cipher/CipherContext.h"
+#include "Secrets/SecretsGeneration.h"
+
+#define COLUMN_PRODUCT_TABLES_TEST_MAXIMAL_DIMENSION (70)
+#define COLUMN_PRODUCT_TABLES_TEST_NUMBER_OF_BLOCKS (5)
+
+void run_all_ColumnProductTables_tests();
+
+void test_ColumnProductTables_Multiply_MatchesMatrixProduct();
+void test_ColumnProductTables_CanUse_RespectsMemoryBudget();
+void test_ColumnProductTables_EncryptionContext_BuildsTablesAndRoundtrips();
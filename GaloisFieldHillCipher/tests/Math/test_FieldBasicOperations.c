@@ -158,6 +158,117 @@ void test_FieldBasicOperations_Power_LargeExponent()
     TEST_ASSERT_EQUAL_INT64(expected_result, result);
 }
 
+void test_FieldBasicOperations_Inverse_TableMatchesPower()
+{
+    // Arrange
+    FieldContext context = {0};
+    uint32_t prime_field = 65521;
+    int64_t inverse = 0;
+    int64_t element = 0;
+    STATUS_CODE status = initialize_field_context(&context, prime_field, prime_field);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, status);
+    TEST_ASSERT_NOT_NULL(context.inverse_table);
+
+    for (element = 1; element < prime_field; element += 97)
+    {
+        // Act
+        status = inverse_over_galois_field(&inverse, element, &context);
+
+        // Assert
+        TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, status);
+        TEST_ASSERT_EQUAL_INT64(raise_power_over_galois_field(element, prime_field - 2, prime_field), inverse);
+    }
+
+    free_field_context(&context);
+}
+
+void test_FieldBasicOperations_Inverse_ExtendedEuclidLargeField()
+{
+    // Arrange
+    FieldContext context = {0};
+    uint32_t prime_field = 2147483647;
+    int64_t elements[] = {1, 2, 12345, -1, 2147483646, 4294967296};
+    int64_t inverse = 0;
+    size_t index = 0;
+    STATUS_CODE status = initialize_field_context(&context, prime_field, prime_field);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, status);
+    TEST_ASSERT_NULL(context.inverse_table);
+
+    for (index = 0; index < sizeof(elements) / sizeof(elements[0]); ++index)
+    {
+        // Act
+        status = inverse_over_galois_field(&inverse, elements[index], &context);
+
+        // Assert
+        TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, status);
+        TEST_ASSERT_EQUAL_INT64(1, (int64_t)((((uint64_t)(((elements[index] % prime_field) + prime_field) % prime_field)) * (uint64_t)inverse) % prime_field));
+    }
+
+    free_field_context(&context);
+}
+
+void test_FieldBasicOperations_Inverse_FewInversions_SkipsTable()
+{
+    // Arrange
+    FieldContext context = {0};
+    uint32_t prime_field = 65521;
+    int64_t inverse = 0;
+    STATUS_CODE status = initialize_field_context(&context, prime_field, 64);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, status);
+    TEST_ASSERT_NULL(context.inverse_table);
+
+    // Act
+    status = inverse_over_galois_field(&inverse, 12345, &context);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, status);
+    TEST_ASSERT_EQUAL_INT64(raise_power_over_galois_field(12345, prime_field - 2, prime_field), inverse);
+
+    free_field_context(&context);
+}
+
+void test_FieldBasicOperations_Inverse_ZeroElement()
+{
+    // Arrange
+    FieldContext context = {0};
+    int64_t inverse = 0;
+    STATUS_CODE status = initialize_field_context(&context, TEST_FIELD, 1);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, status);
+
+    // Act
+    status = inverse_over_galois_field(&inverse, TEST_FIELD * 3, &context);
+
+    // Assert
+    TEST_ASSERT_NOT_EQUAL(STATUS_CODE_SUCCESS, status);
+
+    free_field_context(&context);
+}
+
+void test_FieldBasicOperations_BatchInverse_MatchesSingleInverse()
+{
+    // Arrange
+    FieldContext context = {0};
+    int64_t elements[] = {3, 1, 6, -2, 5, 10};
+    int64_t inverses[6] = {0};
+    int64_t expected = 0;
+    size_t index = 0;
+    STATUS_CODE status = initialize_field_context(&context, TEST_FIELD, 1);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, status);
+
+    // Act
+    status = batch_inverse_over_galois_field(inverses, elements, 6, &context);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, status);
+    for (index = 0; index < 6; ++index)
+    {
+        TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, inverse_over_galois_field(&expected, elements[index], &context));
+        TEST_ASSERT_EQUAL_INT64(expected, inverses[index]);
+    }
+
+    free_field_context(&context);
+}
+
 void run_all_FieldBasicOperations_tests()
 {
     RUN_TEST(test_FieldBasicOperations_Addition_ZeroElement);
@@ -176,4 +287,10 @@ void run_all_FieldBasicOperations_tests()
     RUN_TEST(test_FieldBasicOperations_Power_BaseIsZero);
     RUN_TEST(test_FieldBasicOperations_Power_BaseEqualsField);
     RUN_TEST(test_FieldBasicOperations_Power_LargeExponent);
+
+    RUN_TEST(test_FieldBasicOperations_Inverse_TableMatchesPower);
+    RUN_TEST(test_FieldBasicOperations_Inverse_ExtendedEuclidLargeField);
+    RUN_TEST(test_FieldBasicOperations_Inverse_FewInversions_SkipsTable);
+    RUN_TEST(test_FieldBasicOperations_Inverse_ZeroElement);
+    RUN_TEST(test_FieldBasicOperations_BatchInverse_MatchesSingleInverse);
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "unity.h"
 #include "Math/FieldBasicOperations.h"
+#include "Math/FieldInverse.h"
 
 #define TEST_FIELD 7
 
@@ -20,4 +21,8 @@ void test_FieldBasicOperations_Power_ExponentIsZero();
 void test_FieldBasicOperations_Power_BaseIsZero();
 void test_FieldBasicOperations_Power_BaseEqualsField();
 void test_FieldBasicOperations_Power_LargeExponent();
-
+void test_FieldBasicOperations_Inverse_TableMatchesPower();
+void test_FieldBasicOperations_Inverse_ExtendedEuclidLargeField();
+void test_FieldBasicOperations_Inverse_FewInversions_SkipsTable();
+void test_FieldBasicOperations_Inverse_ZeroElement();
+void test_FieldBasicOperations_BatchInverse_MatchesSingleInverse();
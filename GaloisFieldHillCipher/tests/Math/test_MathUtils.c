@@ -446,6 +446,128 @@ void test_MathUtils_gcd_large_numbers()
     TEST_ASSERT_EQUAL_INT64(expected_result, gcd_result);
 }
 
+void test_MathUtils_multiply_flat_matrix_with_uint8_t_vector_uint16_width()
+{
+    // Arrange
+    uint32_t dimension = 2;
+    uint32_t prime_field = 5;
+    int64_t** matrix = allocate_matrix(dimension);
+    matrix[0][0] = -1; matrix[0][1] = 6;
+    matrix[1][0] = 7; matrix[1][1] = -3;
+    uint8_t vector[] = {3, 4};
+    int64_t offset[] = {1, 2};
+    int64_t* offsets[] = {offset};
+    FieldVector flat_matrix = {0};
+    FieldVector combined_offset = {0};
+    FieldVector result_vector = {0};
+
+    // Act
+    STATUS_CODE flatten_status = flatten_square_matrix_over_field(&flat_matrix, matrix, dimension, prime_field);
+    STATUS_CODE combine_status = combine_error_vectors(&combined_offset, offsets, 1, dimension, prime_field);
+    STATUS_CODE allocate_status = allocate_field_vector(&result_vector, dimension, prime_field);
+    STATUS_CODE status = multiply_flat_matrix_with_uint8_t_vector(&result_vector, &flat_matrix, vector, &combined_offset, dimension, prime_field);
+
+    // row0: (4 * 3 + 1 * 4 + 1) mod 5 = 17 mod 5 = 2
+    // row1: (2 * 3 + 2 * 4 + 2) mod 5 = 16 mod 5 = 1
+    uint32_t expected[] = {2, 1};
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, flatten_status);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, combine_status);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_status);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, status);
+    TEST_ASSERT_EQUAL(FIELD_ELEMENT_WIDTH_UINT16, flat_matrix.width);
+    TEST_ASSERT_EQUAL_UINT32(expected[0], get_field_vector_element(&result_vector, 0));
+    TEST_ASSERT_EQUAL_UINT32(expected[1], get_field_vector_element(&result_vector, 1));
+
+    free_field_vector(&flat_matrix);
+    free_field_vector(&combined_offset);
+    free_field_vector(&result_vector);
+    (void)free_int64_matrix(matrix, dimension);
+}
+
+void test_MathUtils_multiply_flat_matrix_with_field_vector_uint32_width()
+{
+    // Arrange
+    uint32_t dimension = 2;
+    uint32_t prime_field = 2147483647;
+    int64_t** matrix = allocate_matrix(dimension);
+    matrix[0][0] = 2147483646; matrix[0][1] = 1;
+    matrix[1][0] = 0; matrix[1][1] = 2147483646;
+    FieldVector flat_matrix = {0};
+    FieldVector vector = {0};
+    uint8_t result_vector[2] = {0};
+
+    // Act
+    STATUS_CODE flatten_status = flatten_square_matrix_over_field(&flat_matrix, matrix, dimension, prime_field);
+    STATUS_CODE allocate_status = allocate_field_vector(&vector, dimension, prime_field);
+    set_field_vector_element(&vector, 0, 2147483600);
+    set_field_vector_element(&vector, 1, 2147483646);
+    STATUS_CODE status = multiply_flat_matrix_with_field_vector(result_vector, &flat_matrix, &vector, dimension, prime_field);
+
+    // row0: (-1 * -47 + 1 * -1) mod p = 46
+    // row1: (0 * -47 + -1 * -1) mod p = 1
+    uint8_t expected[] = {46, 1};
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, flatten_status);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_status);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, status);
+    TEST_ASSERT_EQUAL(FIELD_ELEMENT_WIDTH_UINT32, flat_matrix.width);
+    TEST_ASSERT_EQUAL_UINT8(expected[0], result_vector[0]);
+    TEST_ASSERT_EQUAL_UINT8(expected[1], result_vector[1]);
+
+    free_field_vector(&flat_matrix);
+    free_field_vector(&vector);
+    (void)free_int64_matrix(matrix, dimension);
+}
+
+static void assert_generated_matrix_inverse_is_exact(uint32_t dimension, uint32_t prime_field)
+{
+    // Arrange
+    int64_t** matrix = NULL;
+    int64_t** inverse_matrix = NULL;
+    int64_t** gauss_jordan_inverse = NULL;
+    uint64_t product = 0;
+    size_t row = 0, column = 0, k = 0;
+
+    // Act
+    STATUS_CODE status = generate_invertible_matrix_over_field(&matrix, &inverse_matrix, dimension, prime_field);
+    STATUS_CODE gauss_jordan_status = inverse_square_matrix_gauss_jordan(&gauss_jordan_inverse, matrix, dimension, prime_field);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, status);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, gauss_jordan_status);
+    for (row = 0; row < dimension; ++row)
+    {
+        for (column = 0; column < dimension; ++column)
+        {
+            product = 0;
+            for (k = 0; k < dimension; ++k)
+            {
+                product = (product + (((uint64_t)matrix[row][k] * (uint64_t)inverse_matrix[k][column]) % prime_field)) % prime_field;
+            }
+            TEST_ASSERT_EQUAL_UINT64((row == column) ? 1 : 0, product);
+            TEST_ASSERT_EQUAL_INT64(gauss_jordan_inverse[row][column], inverse_matrix[row][column]);
+        }
+    }
+
+    (void)free_int64_matrix(matrix, dimension);
+    (void)free_int64_matrix(inverse_matrix, dimension);
+    (void)free_int64_matrix(gauss_jordan_inverse, dimension);
+}
+
+void test_MathUtils_generate_invertible_matrix_over_field_small_prime()
+{
+    assert_generated_matrix_inverse_is_exact(16, 2);
+    assert_generated_matrix_inverse_is_exact(9, 3);
+}
+
+void test_MathUtils_generate_invertible_matrix_over_field_large_prime()
+{
+    assert_generated_matrix_inverse_is_exact(12, 2147483647);
+}
+
 void run_all_MathUtils_tests()
 {
     RUN_TEST(test_MathUtils_matrix_determinant_1x1);
@@ -473,4 +595,10 @@ void run_all_MathUtils_tests()
     RUN_TEST(test_MathUtils_multiply_matrix_with_int64_t_vector);
     RUN_TEST(test_MathUtils_multiply_matrix_with_int64_t_vector_negative_and_not_aligned_values);
     RUN_TEST(test_MathUtils_multiply_matrix_with_int64_t_vector_negative_and_not_aligned_values);
+
+    RUN_TEST(test_MathUtils_multiply_flat_matrix_with_uint8_t_vector_uint16_width);
+    RUN_TEST(test_MathUtils_multiply_flat_matrix_with_field_vector_uint32_width);
+
+    RUN_TEST(test_MathUtils_generate_invertible_matrix_over_field_small_prime);
+    RUN_TEST(test_MathUtils_generate_invertible_matrix_over_field_large_prime);
 }
@@ -7,6 +7,9 @@
 #include "Math/MathUtils.h"
 #include "Math/MatrixUtils.h"
 #include "Math/MatrixMultiplication.h"
+#include "Math/MatrixInverse.h"
+#include "Math/FieldElement.h"
+#include "Cipher/CipherParts/AffineTransformation.h"
 
 void run_all_MathUtils_tests();
 
@@ -39,3 +42,9 @@ void test_MathUtils_multiply_matrix_with_uint8_t_vector_negative_and_not_aligned
 void test_MathUtils_multiply_matrix_with_int64_t_vector();
 void test_MathUtils_multiply_matrix_with_int64_t_vector_negative_and_not_aligned_values();
 void test_MathUtils_multiply_matrix_with_int64_t_vector_negative_and_not_aligned_values();
+
+void test_MathUtils_multiply_flat_matrix_with_uint8_t_vector_uint16_width();
+void test_MathUtils_multiply_flat_matrix_with_field_vector_uint32_width();
+
+void test_MathUtils_generate_invertible_matrix_over_field_small_prime();
+void test_MathUtils_generate_invertible_matrix_over_field_large_prime();
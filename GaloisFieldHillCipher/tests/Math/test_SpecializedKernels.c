@@ -0,0 +1,121 @@
+#include "test_SpecializedKernels.h"
+
+static const uint32_t g_test_dimensions[] = {8, 16, 32, 64};
+static const uint32_t g_test_prime_fields[] = {257, 16777619}; // One field per element width
+
+void test_SpecializedKernels_Encrypt_MatchesReferenceForEveryDimension()
+{
+    FieldVector matrix = {0}, offset = {0}, out = {0};
+    uint8_t block[SPECIALIZED_KERNELS_TEST_MAXIMAL_DIMENSION] = {0};
+    const SpecializedBlockKernels* kernels = NULL;
+    uint64_t expected = 0;
+    uint32_t dimension = 0, prime_field = 0;
+    size_t dimension_index = 0, prime_index = 0, row = 0, column = 0;
+
+    for (prime_index = 0; prime_index < sizeof(g_test_prime_fields) / sizeof(g_test_prime_fields[0]); ++prime_index)
+    {
+        for (dimension_index = 0; dimension_index < sizeof(g_test_dimensions) / sizeof(g_test_dimensions[0]); ++dimension_index)
+        {
+            // Arrange
+            prime_field = g_test_prime_fields[prime_index];
+            dimension = g_test_dimensions[dimension_index];
+            kernels = get_specialized_block_kernels(dimension);
+            TEST_ASSERT_NOT_NULL(kernels);
+            TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_field_vector(&matrix, dimension * dimension, prime_field));
+            TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_field_vector(&offset, dimension, prime_field));
+            TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_field_vector(&out, dimension, prime_field));
+            for (row = 0; row < matrix.length; ++row)
+            {
+                set_field_vector_element(&matrix, row, (uint32_t)(((uint64_t)row * 2654435761u + 11) % prime_field));
+            }
+            for (row = 0; row < dimension; ++row)
+            {
+                set_field_vector_element(&offset, row, (uint32_t)((prime_field - 1) - (row % prime_field)));
+                block[row] = (uint8_t)(UINT8_MAX - (row * 13));
+            }
+
+            // Act
+            kernels->encrypt_kernels[matrix.width](out.elements, matrix.elements, block, offset.elements, prime_field);
+
+            // Assert
+            for (row = 0; row < dimension; ++row)
+            {
+                expected = get_field_vector_element(&offset, row);
+                for (column = 0; column < dimension; ++column)
+                {
+                    expected = (expected + ((uint64_t)get_field_vector_element(&matrix, (row * dimension) + column) * block[column])) % prime_field;
+                }
+                TEST_ASSERT_EQUAL_UINT32((uint32_t)expected, get_field_vector_element(&out, row));
+            }
+
+            free_field_vector(&matrix);
+            free_field_vector(&offset);
+            free_field_vector(&out);
+        }
+    }
+}
+
+void test_SpecializedKernels_Decrypt_RecoversBlockForEveryDimension()
+{
+    FieldVector inverse = {0}, ciphertext = {0};
+    uint8_t block[SPECIALIZED_KERNELS_TEST_MAXIMAL_DIMENSION] = {0};
+    uint8_t decrypted[SPECIALIZED_KERNELS_TEST_MAXIMAL_DIMENSION] = {0};
+    const SpecializedBlockKernels* kernels = NULL;
+    uint32_t dimension = 0, prime_field = 0, power = 0;
+    size_t dimension_index = 0, prime_index = 0, row = 0, column = 0;
+
+    for (prime_index = 0; prime_index < sizeof(g_test_prime_fields) / sizeof(g_test_prime_fields[0]); ++prime_index)
+    {
+        for (dimension_index = 0; dimension_index < sizeof(g_test_dimensions) / sizeof(g_test_dimensions[0]); ++dimension_index)
+        {
+            // Arrange - the ciphertext is (I + shift) * block, whose inverse is sum_k (-1)^k * shift^k
+            prime_field = g_test_prime_fields[prime_index];
+            dimension = g_test_dimensions[dimension_index];
+            kernels = get_specialized_block_kernels(dimension);
+            TEST_ASSERT_NOT_NULL(kernels);
+            TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_field_vector(&inverse, dimension * dimension, prime_field));
+            TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_field_vector(&ciphertext, dimension, prime_field));
+            for (row = 0; row < dimension; ++row)
+            {
+                for (column = 0, power = 1; column <= row; ++column)
+                {
+                    set_field_vector_element(&inverse, (row * dimension) + (row - column), power);
+                    power = prime_field - power;
+                }
+                block[row] = (uint8_t)((row * 37) + 5);
+                set_field_vector_element(&ciphertext, row, (uint32_t)((block[row] + ((0 == row) ? 0 : block[row - 1])) % prime_field));
+            }
+
+            // Act
+            STATUS_CODE return_code = kernels->decrypt_kernels[inverse.width](decrypted, inverse.elements, ciphertext.elements, prime_field);
+
+            // Assert
+            TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, return_code);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(block, decrypted, dimension);
+
+            free_field_vector(&inverse);
+            free_field_vector(&ciphertext);
+        }
+    }
+}
+
+void test_SpecializedKernels_Dispatch_FallsBackForOtherDimensionsAndLargeFields()
+{
+    // Arrange
+    const uint64_t largest_product = (uint64_t)(2147483647u - 1) * (2147483647u - 1);
+    const uint32_t decryption_window = (uint32_t)((UINT64_MAX - 2147483647u) / largest_product);
+
+    // Act & Assert
+    TEST_ASSERT_NULL(get_specialized_block_kernels(5));
+    TEST_ASSERT_NULL(get_specialized_block_kernels(0));
+    TEST_ASSERT_NOT_NULL(get_specialized_block_kernels(16));
+    TEST_ASSERT_TRUE(can_use_specialized_kernel(64, 64));
+    TEST_ASSERT_FALSE(can_use_specialized_kernel(8, decryption_window));
+}
+
+void run_all_SpecializedKernels_tests()
+{
+    RUN_TEST(test_SpecializedKernels_Encrypt_MatchesReferenceForEveryDimension);
+    RUN_TEST(test_SpecializedKernels_Decrypt_RecoversBlockForEveryDimension);
+    RUN_TEST(test_SpecializedKernels_Dispatch_FallsBackForOtherDimensionsAndLargeFields);
+}
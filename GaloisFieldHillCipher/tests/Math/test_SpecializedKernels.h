@@ -0,0 +1,15 @@
+#pragma once
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "unity.h"
+#include "Math/SpecializedKernels.h"
+#include "Math/MatrixMultiplication.h"
+
+#define SPECIALIZED_KERNELS_TEST_MAXIMAL_DIMENSION (64)
+
+void run_all_SpecializedKernels_tests();
+
+void test_SpecializedKernels_Encrypt_MatchesReferenceForEveryDimension();
+void test_SpecializedKernels_Decrypt_RecoversBlockForEveryDimension();
+void test_SpecializedKernels_Dispatch_FallsBackForOtherDimensionsAndLargeFields();
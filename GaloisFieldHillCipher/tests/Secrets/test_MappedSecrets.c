@@ -0,0 +1,127 @@
+#include "test_MappedSecrets.h"
+
+static Secrets* generate_mapped_test_secrets()
+{
+    KeyGenerationArguments arguments = make_test_key_generation_arguments(MAPPED_TEST_DIMENSION, MAPPED_TEST_PRIME_FIELD,
+                                                                          MAPPED_TEST_NUMBER_OF_ERROR_VECTORS, MAPPED_TEST_LETTERS_PER_DIGIT);
+
+    arguments.mapped_key = true;
+    return generate_test_secrets(&arguments);
+}
+
+static void write_mapped_test_key(Secrets* secrets)
+{
+    uint8_t* mapped_data = NULL;
+    uint32_t mapped_size = 0;
+
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, serialize_mapped_secrets(&mapped_data, &mapped_size, *secrets));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, write_uint8_to_file(MAPPED_TEST_KEY_FILE, mapped_data, mapped_size));
+    free(mapped_data);
+}
+
+void test_MappedSecrets_LoadFile_PointsAlignedViewsIntoMapping()
+{
+    // Arrange
+    Secrets* secrets = generate_mapped_test_secrets();
+    Secrets loaded_secrets = {0};
+    FieldVector expected_matrix = {0};
+    uint32_t loaded_size = 0, index = 0;
+    const uint8_t* mapping_end = NULL;
+    write_mapped_test_key(secrets);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, flatten_square_matrix_over_field(&expected_matrix, secrets->key_matrix, MAPPED_TEST_DIMENSION, MAPPED_TEST_PRIME_FIELD));
+
+    // Act
+    STATUS_CODE return_code = load_secrets_file(&loaded_secrets, &loaded_size, MAPPED_TEST_KEY_FILE);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, return_code);
+    TEST_ASSERT_NOT_NULL(loaded_secrets.key_mapping);
+    TEST_ASSERT_NULL(loaded_secrets.key_matrix);
+    TEST_ASSERT_FALSE(loaded_secrets.is_decryption_key);
+    mapping_end = (const uint8_t*)loaded_secrets.key_mapping + loaded_size;
+    TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)((uintptr_t)loaded_secrets.flat_key_matrix.elements % MAPPED_KEY_SECTION_ALIGNMENT));
+    TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)((uintptr_t)loaded_secrets.flat_inverse_key_matrix.elements % MAPPED_KEY_SECTION_ALIGNMENT));
+    TEST_ASSERT_TRUE(((const uint8_t*)loaded_secrets.flat_key_matrix.elements > (const uint8_t*)loaded_secrets.key_mapping) &&
+                     ((const uint8_t*)loaded_secrets.flat_key_matrix.elements < mapping_end));
+    TEST_ASSERT_EQUAL(expected_matrix.width, loaded_secrets.flat_key_matrix.width);
+    for (index = 0; index < expected_matrix.length; ++index)
+    {
+        TEST_ASSERT_EQUAL_UINT32(get_field_vector_element(&expected_matrix, index), get_field_vector_element(&loaded_secrets.flat_key_matrix, index));
+    }
+
+    free_field_vector(&expected_matrix);
+    free_secrets(&loaded_secrets);
+    free_test_secrets(secrets);
+    remove(MAPPED_TEST_KEY_FILE);
+}
+
+void test_MappedSecrets_Encrypt_MatchesFullKeyAndDecryptsWithSwappedKey()
+{
+    // Arrange
+    Secrets* secrets = generate_mapped_test_secrets();
+    Secrets mapped_secrets = {0};
+    Secrets* decryption_secrets = NULL;
+    uint8_t plaintext[MAPPED_TEST_PLAINTEXT_SIZE] = {0};
+    uint8_t* full_ciphertext = NULL;
+    uint8_t* mapped_ciphertext = NULL;
+    uint8_t* decrypted = NULL;
+    uint32_t full_size = 0, mapped_size = 0, decrypted_size = 0, index = 0;
+    for (index = 0; index < MAPPED_TEST_PLAINTEXT_SIZE; ++index)
+    {
+        plaintext[index] = (uint8_t)(index * 53 + 11);
+    }
+    write_mapped_test_key(secrets);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, load_secrets_file(&mapped_secrets, NULL, MAPPED_TEST_KEY_FILE));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, encrypt_and_serialize(&full_ciphertext, &full_size, plaintext, MAPPED_TEST_PLAINTEXT_SIZE, *secrets, CIPHERTEXT_FORMAT_BINARY));
+
+    // Act
+    STATUS_CODE return_code = encrypt_and_serialize(&mapped_ciphertext, &mapped_size, plaintext, MAPPED_TEST_PLAINTEXT_SIZE, mapped_secrets, CIPHERTEXT_FORMAT_BINARY);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, return_code);
+    TEST_ASSERT_EQUAL_UINT32(full_size, mapped_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(full_ciphertext, mapped_ciphertext, full_size);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_decryption_secrets(&decryption_secrets, &mapped_secrets));
+    TEST_ASSERT_NULL(mapped_secrets.key_mapping);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, deserialize_and_decrypt(&decrypted, &decrypted_size, mapped_ciphertext, mapped_size, *decryption_secrets, CIPHERTEXT_FORMAT_BINARY));
+    TEST_ASSERT_EQUAL_UINT32(MAPPED_TEST_PLAINTEXT_SIZE, decrypted_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, decrypted, MAPPED_TEST_PLAINTEXT_SIZE);
+
+    free(decrypted);
+    free(mapped_ciphertext);
+    free(full_ciphertext);
+    free_test_secrets(decryption_secrets);
+    free_secrets(&mapped_secrets);
+    free_test_secrets(secrets);
+    remove(MAPPED_TEST_KEY_FILE);
+}
+
+void test_MappedSecrets_SectionOutOfBounds_IsRejected()
+{
+    // Arrange
+    Secrets* secrets = generate_mapped_test_secrets();
+    Secrets loaded_secrets = {0};
+    uint8_t* mapped_data = NULL;
+    uint32_t mapped_size = 0;
+    MappedKeySection section = {0};
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, serialize_mapped_secrets(&mapped_data, &mapped_size, *secrets));
+    memcpy(&section, mapped_data + sizeof(MappedKeyHeader), sizeof(section));
+    section.offset = mapped_size - MAPPED_KEY_SECTION_ALIGNMENT; // Aligned, but the matrix runs past the end of the key
+    memcpy(mapped_data + sizeof(MappedKeyHeader), &section, sizeof(section));
+
+    // Act
+    STATUS_CODE return_code = deserialize_secrets(&loaded_secrets, mapped_data, mapped_size);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_ERROR_INVALID_SIZE, return_code);
+
+    free(mapped_data);
+    free_test_secrets(secrets);
+}
+
+void run_all_MappedSecrets_tests()
+{
+    RUN_TEST(test_MappedSecrets_LoadFile_PointsAlignedViewsIntoMapping);
+    RUN_TEST(test_MappedSecrets_Encrypt_MatchesFullKeyAndDecryptsWithSwappedKey);
+    RUN_TEST(test_MappedSecrets_SectionOutOfBounds_IsRejected);
+}
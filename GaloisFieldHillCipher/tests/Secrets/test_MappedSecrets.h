@@ -0,0 +1,26 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "TestSecrets.h"
+#include "Secrets/MappedSecrets.h"
+#include "Secrets/SecretsGeneration.h"
+#include "Cipher/Cipher.h"
+#include "IO/FileOperations.h"
+#include "IO/SerDes.h"
+
+#define MAPPED_TEST_DIMENSION (16)
+#define MAPPED_TEST_PRIME_FIELD (65537) // Just above the uint16_t elements, so the sections hold uint32_t elements
+#define MAPPED_TEST_NUMBER_OF_ERROR_VECTORS (3)
+#define MAPPED_TEST_LETTERS_PER_DIGIT (3)
+#define MAPPED_TEST_PLAINTEXT_SIZE (100)
+#define MAPPED_TEST_KEY_FILE "mapped_secrets_test_key.bin"
+
+void run_all_MappedSecrets_tests();
+
+void test_MappedSecrets_LoadFile_PointsAlignedViewsIntoMapping();
+void test_MappedSecrets_Encrypt_MatchesFullKeyAndDecryptsWithSwappedKey();
+void test_MappedSecrets_SectionOutOfBounds_IsRejected();
@@ -0,0 +1,162 @@
+#include "test_SeededSecrets.h"
+
+static KeyGenerationArguments make_seeded_test_arguments()
+{
+    KeyGenerationArguments arguments = make_test_key_generation_arguments(SEEDED_TEST_DIMENSION, SEEDED_TEST_PRIME_FIELD,
+                                                                          SEEDED_TEST_NUMBER_OF_ERROR_VECTORS, SEEDED_TEST_LETTERS_PER_DIGIT);
+
+    arguments.seeded_key = true;
+    return arguments;
+}
+
+static void fill_test_seed(uint8_t* seed)
+{
+    uint32_t index = 0;
+
+    for (index = 0; index < RANDOM_SEED_SIZE; ++index)
+    {
+        seed[index] = (uint8_t)(index * 29 + 7);
+    }
+}
+
+// Serializes in the full format so every regenerated member takes part in the comparison
+static void serialize_in_full(uint8_t** out_data, uint32_t* out_size, Secrets* secrets)
+{
+    uint8_t* key_seed = secrets->key_seed;
+
+    secrets->key_seed = NULL;
+    serialize_test_secrets(out_data, out_size, secrets);
+    secrets->key_seed = key_seed;
+}
+
+void test_SeededSecrets_SameSeed_RegeneratesIdenticalSecrets()
+{
+    // Arrange
+    KeyGenerationArguments arguments = make_seeded_test_arguments();
+    uint8_t seed[RANDOM_SEED_SIZE] = {0};
+    Secrets* first_secrets = NULL;
+    Secrets* second_secrets = NULL;
+    uint8_t* first_data = NULL;
+    uint8_t* second_data = NULL;
+    uint32_t first_size = 0, second_size = 0;
+    fill_test_seed(seed);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_encryption_secrets_from_seed(&first_secrets, &arguments, seed, false));
+
+    // Act
+    STATUS_CODE return_code = build_encryption_secrets_from_seed(&second_secrets, &arguments, seed, false);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, return_code);
+    serialize_in_full(&first_data, &first_size, first_secrets);
+    serialize_in_full(&second_data, &second_size, second_secrets);
+    TEST_ASSERT_EQUAL_UINT32(first_size, second_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(first_data, second_data, first_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(seed, second_secrets->key_seed, RANDOM_SEED_SIZE);
+
+    free(second_data);
+    free(first_data);
+    free_test_secrets(second_secrets);
+    free_test_secrets(first_secrets);
+}
+
+void test_SeededSecrets_SerializeThenDeserialize_ReturnsSameMatrices()
+{
+    // Arrange
+    KeyGenerationArguments arguments = make_seeded_test_arguments();
+    Secrets* secrets = NULL;
+    Secrets loaded_secrets = {0};
+    uint8_t* seeded_data = NULL;
+    uint8_t* expected_data = NULL;
+    uint8_t* loaded_data = NULL;
+    uint32_t seeded_size = 0, expected_size = 0, loaded_size = 0;
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_encryption_secrets(&secrets, &arguments));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, serialize_secrets(&seeded_data, &seeded_size, *secrets));
+
+    // Act
+    STATUS_CODE return_code = deserialize_secrets(&loaded_secrets, seeded_data, seeded_size);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, return_code);
+    TEST_ASSERT_EQUAL_UINT32(SEEDED_KEY_SIZE, seeded_size);
+    TEST_ASSERT_TRUE(is_seeded_key_data(seeded_data, seeded_size));
+    TEST_ASSERT_FALSE(loaded_secrets.is_decryption_key);
+    serialize_in_full(&expected_data, &expected_size, secrets);
+    serialize_in_full(&loaded_data, &loaded_size, &loaded_secrets);
+    TEST_ASSERT_EQUAL_UINT32(expected_size, loaded_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_data, loaded_data, expected_size);
+
+    free(loaded_data);
+    free(expected_data);
+    free(seeded_data);
+    free_secrets(&loaded_secrets);
+    free_test_secrets(secrets);
+}
+
+void test_SeededSecrets_DecryptionKey_RegeneratesInverseMatrix()
+{
+    // Arrange
+    KeyGenerationArguments arguments = make_seeded_test_arguments();
+    Secrets* encryption_secrets = NULL;
+    Secrets* decryption_secrets = NULL;
+    Secrets loaded_secrets = {0};
+    uint8_t* seeded_data = NULL;
+    int64_t** product = NULL;
+    uint32_t seeded_size = 0, row = 0, column = 0;
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_encryption_secrets(&encryption_secrets, &arguments));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_decryption_secrets(&decryption_secrets, encryption_secrets));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, serialize_secrets(&seeded_data, &seeded_size, *decryption_secrets));
+
+    // Act
+    STATUS_CODE return_code = deserialize_secrets(&loaded_secrets, seeded_data, seeded_size);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, return_code);
+    TEST_ASSERT_EQUAL_UINT32(SEEDED_KEY_SIZE, seeded_size);
+    TEST_ASSERT_TRUE(loaded_secrets.is_decryption_key);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, multiply_square_matrices_over_field(&product, encryption_secrets->key_matrix,
+                                                                              loaded_secrets.key_matrix, SEEDED_TEST_DIMENSION,
+                                                                              SEEDED_TEST_PRIME_FIELD));
+    for (row = 0; row < SEEDED_TEST_DIMENSION; ++row)
+    {
+        for (column = 0; column < SEEDED_TEST_DIMENSION; ++column)
+        {
+            TEST_ASSERT_EQUAL_INT64((row == column) ? 1 : 0, product[row][column]);
+        }
+    }
+
+    (void)free_int64_matrix(product, SEEDED_TEST_DIMENSION);
+    free(seeded_data);
+    free_secrets(&loaded_secrets);
+    free_test_secrets(decryption_secrets);
+    free_test_secrets(encryption_secrets);
+}
+
+void test_SeededSecrets_UnknownVersion_IsRejected()
+{
+    // Arrange
+    KeyGenerationArguments arguments = make_seeded_test_arguments();
+    Secrets* secrets = NULL;
+    Secrets loaded_secrets = {0};
+    uint8_t* seeded_data = NULL;
+    uint32_t seeded_size = 0, version = SEEDED_KEY_VERSION + 1;
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_encryption_secrets(&secrets, &arguments));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, serialize_secrets(&seeded_data, &seeded_size, *secrets));
+    memcpy(seeded_data + sizeof(uint32_t), &version, sizeof(version));
+
+    // Act
+    STATUS_CODE return_code = deserialize_secrets(&loaded_secrets, seeded_data, seeded_size);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGUMENT, return_code);
+
+    free(seeded_data);
+    free_test_secrets(secrets);
+}
+
+void run_all_SeededSecrets_tests()
+{
+    RUN_TEST(test_SeededSecrets_SameSeed_RegeneratesIdenticalSecrets);
+    RUN_TEST(test_SeededSecrets_SerializeThenDeserialize_ReturnsSameMatrices);
+    RUN_TEST(test_SeededSecrets_DecryptionKey_RegeneratesInverseMatrix);
+    RUN_TEST(test_SeededSecrets_UnknownVersion_IsRejected);
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "TestSecrets.h"
+#include "Secrets/SeededSecrets.h"
+#include "Secrets/SecretsGeneration.h"
+#include "IO/SerDes.h"
+#include "Math/MatrixMultiplication.h"
+
+#define SEEDED_TEST_DIMENSION (8)
+#define SEEDED_TEST_PRIME_FIELD (257)
+#define SEEDED_TEST_NUMBER_OF_ERROR_VECTORS (2)
+#define SEEDED_TEST_LETTERS_PER_DIGIT (2)
+
+void run_all_SeededSecrets_tests();
+
+void test_SeededSecrets_SameSeed_RegeneratesIdenticalSecrets();
+void test_SeededSecrets_SerializeThenDeserialize_ReturnsSameMatrices();
+void test_SeededSecrets_DecryptionKey_RegeneratesInverseMatrix();
+void test_SeededSecrets_UnknownVersion_IsRejected();
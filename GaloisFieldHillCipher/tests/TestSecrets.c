@@ -0,0 +1,56 @@
+#include "TestSecrets.h"
+
+KeyGenerationArguments make_test_key_generation_arguments(uint32_t dimension, uint32_t prime_field, uint32_t number_of_error_vectors,
+                                                          uint32_t letters_per_digit)
+{
+    KeyGenerationArguments arguments = {0};
+
+    arguments.dimension = dimension;
+    arguments.prime_field = prime_field;
+    arguments.number_of_error_vectors = number_of_error_vectors;
+    arguments.number_of_letters_for_each_digit_ascii_mapping = letters_per_digit;
+    return arguments;
+}
+
+Secrets* generate_test_secrets(const KeyGenerationArguments* arguments)
+{
+    Secrets* secrets = NULL;
+
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_encryption_secrets(&secrets, arguments));
+    return secrets;
+}
+
+void serialize_test_secrets(uint8_t** out_data, uint32_t* out_size, Secrets* secrets)
+{
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, serialize_secrets(out_data, out_size, *secrets));
+}
+
+void write_test_key_pair(const KeyGenerationArguments* arguments, const char* encryption_key_file, const char* decryption_key_file)
+{
+    Secrets* encryption_secrets = generate_test_secrets(arguments);
+    Secrets* decryption_secrets = NULL;
+    uint8_t* key_data = NULL;
+    uint32_t key_size = 0;
+
+    // The decryption secrets take over the error vectors, the encryption key is written first
+    serialize_test_secrets(&key_data, &key_size, encryption_secrets);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, write_uint8_to_file(encryption_key_file, key_data, key_size));
+    free(key_data);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, build_decryption_secrets(&decryption_secrets, encryption_secrets));
+    serialize_test_secrets(&key_data, &key_size, decryption_secrets);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, write_uint8_to_file(decryption_key_file, key_data, key_size));
+    free(key_data);
+
+    free_test_secrets(decryption_secrets);
+    free_test_secrets(encryption_secrets);
+}
+
+void free_test_secrets(Secrets* secrets)
+{
+    if (NULL == secrets)
+    {
+        return;
+    }
+    free_secrets(secrets);
+    free(secrets);
+}
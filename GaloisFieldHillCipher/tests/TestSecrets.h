@@ -0,0 +1,54 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "unity.h"
+#include "Secrets/SecretsGeneration.h"
+#include "IO/FileOperations.h"
+#include "IO/SerDes.h"
+
+/**
+ * @brief Fills the key generation arguments every test key sets, the rest is left zero for the test to set.
+ *
+ * @param dimension - Dimension of the key matrix.
+ * @param prime_field - Prime of the field the key is over.
+ * @param number_of_error_vectors - Number of error vectors.
+ * @param letters_per_digit - Letters mapped to each digit of the ASCII mapping.
+ * @return KeyGenerationArguments - The filled arguments.
+ */
+KeyGenerationArguments make_test_key_generation_arguments(uint32_t dimension, uint32_t prime_field, uint32_t number_of_error_vectors,
+                                                          uint32_t letters_per_digit);
+
+/**
+ * @brief Builds encryption secrets and fails the test if they couldn't be built.
+ *
+ * @param arguments - Key generation arguments.
+ * @return Secrets* - The secrets, released with free_test_secrets.
+ */
+Secrets* generate_test_secrets(const KeyGenerationArguments* arguments);
+
+/**
+ * @brief Serializes secrets in the full key format and fails the test if they couldn't be serialized.
+ *
+ * @param out_data - Serialized key, released by the caller.
+ * @param out_size - Size of the serialized key.
+ * @param secrets - Secrets to serialize.
+ */
+void serialize_test_secrets(uint8_t** out_data, uint32_t* out_size, Secrets* secrets);
+
+/**
+ * @brief Writes a fresh encryption key and its matching decryption key to files.
+ *
+ * @param arguments - Key generation arguments of the encryption key.
+ * @param encryption_key_file - Path of the encryption key.
+ * @param decryption_key_file - Path of the decryption key.
+ */
+void write_test_key_pair(const KeyGenerationArguments* arguments, const char* encryption_key_file, const char* decryption_key_file);
+
+/**
+ * @brief Frees secrets from generate_test_secrets or build_decryption_secrets together with their struct.
+ *
+ * @param secrets - Secrets to free, may be NULL.
+ */
+void free_test_secrets(Secrets* secrets);
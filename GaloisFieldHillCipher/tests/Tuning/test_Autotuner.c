@@ -0,0 +1,263 @@
+#include "test_Autotuner.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+struct AutotunerTestWorker {
+    BlockLoopConfiguration configuration;
+    STATUS_CODE return_code;
+} typedef AutotunerTestWorker;
+
+static STATUS_CODE multiply_with_configuration(FieldVector* out_encrypted, uint8_t* out_decrypted, const BlockLoopConfiguration* configuration,
+                                               const BlockMultiplier* multiplier, const BlockMultiplier* inverse_multiplier,
+                                               const uint8_t* blocks, const FieldVector* field_blocks)
+{
+    STATUS_CODE return_code = STATUS_CODE_UNINITIALIZED;
+    BlockLoop loop = {0};
+
+    return_code = initialize_block_loop(&loop, configuration);
+    if (STATUS_SUCCESS(return_code))
+    {
+        return_code = multiply_uint8_t_blocks(out_encrypted, &loop, multiplier, blocks, AUTOTUNER_TEST_NUMBER_OF_BLOCKS);
+    }
+    if (STATUS_SUCCESS(return_code))
+    {
+        return_code = multiply_field_blocks(out_decrypted, &loop, inverse_multiplier, field_blocks, AUTOTUNER_TEST_NUMBER_OF_BLOCKS);
+    }
+    free_block_loop(&loop);
+    return return_code;
+}
+
+static void assert_every_configuration_matches_default(uint32_t prime_field)
+{
+    // Arrange
+    const uint32_t batch_sizes[] = {1, 3, 8, 64};
+    const uint32_t thread_counts[] = {1, 3};
+    const size_t number_of_elements = (size_t)AUTOTUNER_TEST_NUMBER_OF_BLOCKS * AUTOTUNER_TEST_DIMENSION;
+    const uint32_t subdiagonal = 3;
+    FieldVector flat_matrix = {0}, inverse_matrix = {0}, offset_vector = {0}, field_blocks = {0}, expected_encrypted = {0}, encrypted = {0};
+    uint8_t blocks[AUTOTUNER_TEST_NUMBER_OF_BLOCKS * AUTOTUNER_TEST_DIMENSION] = {0};
+    uint8_t decrypted[AUTOTUNER_TEST_NUMBER_OF_BLOCKS * AUTOTUNER_TEST_DIMENSION] = {0};
+    BlockLoopConfiguration configuration;
+    BlockMultiplier multiplier, inverse_multiplier;
+    uint32_t kernel = 0, row = 0, column = 0, power = 0;
+    size_t index = 0, batch = 0, threads = 0;
+
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_field_vector(&flat_matrix, AUTOTUNER_TEST_DIMENSION * AUTOTUNER_TEST_DIMENSION, prime_field));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_field_vector(&inverse_matrix, AUTOTUNER_TEST_DIMENSION * AUTOTUNER_TEST_DIMENSION, prime_field));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_field_vector(&offset_vector, AUTOTUNER_TEST_DIMENSION, prime_field));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_field_vector(&field_blocks, (uint32_t)number_of_elements, prime_field));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_field_vector(&expected_encrypted, (uint32_t)number_of_elements, prime_field));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, allocate_field_vector(&encrypted, (uint32_t)number_of_elements, prime_field));
+    for (index = 0; index < flat_matrix.length; ++index)
+    {
+        set_field_vector_element(&flat_matrix, index, (uint32_t)(((uint64_t)index * 2654435761u + 17) % prime_field));
+    }
+    for (index = 0; index < offset_vector.length; ++index)
+    {
+        set_field_vector_element(&offset_vector, index, (uint32_t)((index * 40503u + 5) % prime_field));
+    }
+    // Ciphertext blocks under I + c * shift, whose inverse sum_k (-c)^k * shift^k recovers the plaintext bytes
+    for (row = 0; row < AUTOTUNER_TEST_DIMENSION; ++row)
+    {
+        for (column = 0, power = 1; column <= row; ++column)
+        {
+            set_field_vector_element(&inverse_matrix, ((size_t)row * AUTOTUNER_TEST_DIMENSION) + (row - column), power);
+            power = (uint32_t)(((uint64_t)power * (prime_field - subdiagonal)) % prime_field);
+        }
+    }
+    for (index = 0; index < number_of_elements; ++index)
+    {
+        blocks[index] = (uint8_t)(index * 31 + 7);
+        set_field_vector_element(&field_blocks, index, (uint32_t)((blocks[index] +
+            ((0 == (index % AUTOTUNER_TEST_DIMENSION)) ? 0 : ((uint64_t)subdiagonal * blocks[index - 1]))) % prime_field));
+    }
+    multiplier.dimension = AUTOTUNER_TEST_DIMENSION;
+    multiplier.prime_field = prime_field;
+    multiplier.flat_matrix = &flat_matrix;
+    multiplier.circulant_key = NULL;
+    multiplier.column_tables = NULL;
+    multiplier.offset_vector = &offset_vector;
+    inverse_multiplier = multiplier;
+    inverse_multiplier.flat_matrix = &inverse_matrix;
+    inverse_multiplier.offset_vector = NULL;
+    get_default_block_loop_configuration(&configuration);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, multiply_with_configuration(&expected_encrypted, decrypted, &configuration, &multiplier, &inverse_multiplier, blocks, &field_blocks));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(blocks, decrypted, number_of_elements);
+
+    for (kernel = 0; kernel < NUMBER_OF_BLOCK_KERNELS; ++kernel)
+    {
+        for (batch = 0; batch < sizeof(batch_sizes) / sizeof(batch_sizes[0]); ++batch)
+        {
+            for (threads = 0; threads < sizeof(thread_counts) / sizeof(thread_counts[0]); ++threads)
+            {
+                configuration.kernel = (BLOCK_KERNEL)kernel;
+                configuration.blocks_per_batch = batch_sizes[batch];
+                configuration.number_of_threads = thread_counts[threads];
+                memset(decrypted, 0, sizeof(decrypted));
+
+                // Act
+                STATUS_CODE return_code = multiply_with_configuration(&encrypted, decrypted, &configuration, &multiplier, &inverse_multiplier, blocks, &field_blocks);
+
+                // Assert
+                TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, return_code);
+                for (index = 0; index < number_of_elements; ++index)
+                {
+                    TEST_ASSERT_EQUAL_UINT32(get_field_vector_element(&expected_encrypted, index), get_field_vector_element(&encrypted, index));
+                }
+                TEST_ASSERT_EQUAL_UINT8_ARRAY(blocks, decrypted, number_of_elements);
+            }
+        }
+    }
+
+    free_field_vector(&flat_matrix);
+    free_field_vector(&inverse_matrix);
+    free_field_vector(&offset_vector);
+    free_field_vector(&field_blocks);
+    free_field_vector(&expected_encrypted);
+    free_field_vector(&encrypted);
+}
+
+void test_Autotuner_BlockLoop_EveryConfigurationMatchesDefault_SmallField()
+{
+    assert_every_configuration_matches_default(257);
+}
+
+void test_Autotuner_BlockLoop_EveryConfigurationMatchesDefault_LargeField()
+{
+    assert_every_configuration_matches_default(16777619);
+}
+
+void test_Autotuner_TuningCache_StoreThenLoad_LastMatchWins()
+{
+    // Arrange
+    TuningKey key, other_key;
+    BlockLoopConfiguration first = {BLOCK_KERNEL_BATCHED, 16, 2};
+    BlockLoopConfiguration second = {BLOCK_KERNEL_BATCHED_INTERLEAVED, 64, 4};
+    BlockLoopConfiguration other = {BLOCK_KERNEL_BLOCK_BY_BLOCK, 1, 1};
+    BlockLoopConfiguration loaded;
+    bool found = false;
+    get_host_tuning_key(&key, 64, 16777619);
+    other_key = key;
+    other_key.dimension = 128;
+    remove(AUTOTUNER_TEST_CACHE_FILE);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, store_tuned_block_loop_configuration(AUTOTUNER_TEST_CACHE_FILE, &key, &first));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, store_tuned_block_loop_configuration(AUTOTUNER_TEST_CACHE_FILE, &key, &second));
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, store_tuned_block_loop_configuration(AUTOTUNER_TEST_CACHE_FILE, &other_key, &other));
+
+    // Act
+    STATUS_CODE return_code = load_tuned_block_loop_configuration(&loaded, &found, AUTOTUNER_TEST_CACHE_FILE, &key);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, return_code);
+    TEST_ASSERT_TRUE(found);
+    TEST_ASSERT_EQUAL(second.kernel, loaded.kernel);
+    TEST_ASSERT_EQUAL_UINT32(second.blocks_per_batch, loaded.blocks_per_batch);
+    TEST_ASSERT_EQUAL_UINT32(second.number_of_threads, loaded.number_of_threads);
+
+    other_key.prime_field = 257;
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, load_tuned_block_loop_configuration(&loaded, &found, AUTOTUNER_TEST_CACHE_FILE, &other_key));
+    TEST_ASSERT_FALSE(found);
+
+    remove(AUTOTUNER_TEST_CACHE_FILE);
+}
+
+void test_Autotuner_Autotune_ReturnsValidConfiguration()
+{
+    // Arrange
+    BlockLoopConfiguration configuration;
+
+    // Act
+    STATUS_CODE return_code = autotune_block_loop(&configuration, 64, 65537);
+
+    // Assert
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, return_code);
+    TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, validate_block_loop_configuration(&configuration));
+    TEST_ASSERT_TRUE(configuration.number_of_threads <= get_number_of_hardware_threads());
+}
+
+#ifdef _WIN32
+static DWORD WINAPI autotuner_test_thread(LPVOID parameter)
+{
+    AutotunerTestWorker* worker = (AutotunerTestWorker*)parameter;
+    worker->return_code = get_block_loop_configuration(&worker->configuration, AUTOTUNER_TEST_DIMENSION, 257);
+    return 0;
+}
+#else
+static void* autotuner_test_thread(void* parameter)
+{
+    AutotunerTestWorker* worker = (AutotunerTestWorker*)parameter;
+    worker->return_code = get_block_loop_configuration(&worker->configuration, AUTOTUNER_TEST_DIMENSION, 257);
+    return NULL;
+}
+#endif
+
+void test_Autotuner_TuningCache_ConcurrentCallers_TuneOnce()
+{
+    // Arrange
+    AutotunerTestWorker workers[AUTOTUNER_TEST_NUMBER_OF_THREADS];
+    char line[TUNING_CACHE_LINE_SIZE] = {0};
+    uint32_t number_of_entries = 0;
+    size_t worker = 0;
+    FILE* cache = NULL;
+#ifdef _WIN32
+    HANDLE threads[AUTOTUNER_TEST_NUMBER_OF_THREADS];
+#else
+    pthread_t threads[AUTOTUNER_TEST_NUMBER_OF_THREADS];
+#endif
+    remove(AUTOTUNER_TEST_CACHE_FILE);
+    set_tuning_cache_file(AUTOTUNER_TEST_CACHE_FILE);
+
+    // Act
+    for (worker = 0; worker < AUTOTUNER_TEST_NUMBER_OF_THREADS; ++worker)
+    {
+        workers[worker].return_code = STATUS_CODE_UNINITIALIZED;
+#ifdef _WIN32
+        threads[worker] = CreateThread(NULL, 0, autotuner_test_thread, &workers[worker], 0, NULL);
+        TEST_ASSERT_NOT_NULL(threads[worker]);
+#else
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[worker], NULL, autotuner_test_thread, &workers[worker]));
+#endif
+    }
+    for (worker = 0; worker < AUTOTUNER_TEST_NUMBER_OF_THREADS; ++worker)
+    {
+#ifdef _WIN32
+        WaitForSingleObject(threads[worker], INFINITE);
+        CloseHandle(threads[worker]);
+#else
+        pthread_join(threads[worker], NULL);
+#endif
+    }
+    set_tuning_cache_file(NULL);
+
+    // Assert - one tuning, every caller got its result
+    for (worker = 0; worker < AUTOTUNER_TEST_NUMBER_OF_THREADS; ++worker)
+    {
+        TEST_ASSERT_EQUAL(STATUS_CODE_SUCCESS, workers[worker].return_code);
+        TEST_ASSERT_EQUAL(workers[0].configuration.kernel, workers[worker].configuration.kernel);
+        TEST_ASSERT_EQUAL_UINT32(workers[0].configuration.blocks_per_batch, workers[worker].configuration.blocks_per_batch);
+        TEST_ASSERT_EQUAL_UINT32(workers[0].configuration.number_of_threads, workers[worker].configuration.number_of_threads);
+    }
+    cache = fopen(AUTOTUNER_TEST_CACHE_FILE, "r");
+    TEST_ASSERT_NOT_NULL(cache);
+    while (NULL != fgets(line, sizeof(line), cache))
+    {
+        number_of_entries += (TUNING_CACHE_COMMENT == line[0]) ? 0 : 1;
+    }
+    fclose(cache);
+    TEST_ASSERT_EQUAL_UINT32(1, number_of_entries);
+
+    remove(AUTOTUNER_TEST_CACHE_FILE);
+}
+
+void run_all_Autotuner_tests()
+{
+    RUN_TEST(test_Autotuner_BlockLoop_EveryConfigurationMatchesDefault_SmallField);
+    RUN_TEST(test_Autotuner_BlockLoop_EveryConfigurationMatchesDefault_LargeField);
+    RUN_TEST(test_Autotuner_TuningCache_StoreThenLoad_LastMatchWins);
+    RUN_TEST(test_Autotuner_TuningCache_ConcurrentCallers_TuneOnce);
+    RUN_TEST(test_Autotuner_Autotune_ReturnsValidConfiguration);
+}
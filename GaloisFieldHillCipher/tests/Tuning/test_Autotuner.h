@@ -0,0 +1,22 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "unity.h"
+#include "Tuning/Autotuner.h"
+#include "Cipher/CipherParts/BlockLoop.h"
+
+#define AUTOTUNER_TEST_DIMENSION (5) // Odd, so interleaved passes leave a remainder
+#define AUTOTUNER_TEST_NUMBER_OF_BLOCKS (37)
+#define AUTOTUNER_TEST_CACHE_FILE "autotuner_test_cache.txt"
+#define AUTOTUNER_TEST_NUMBER_OF_THREADS (4)
+
+void run_all_Autotuner_tests();
+
+void test_Autotuner_BlockLoop_EveryConfigurationMatchesDefault_SmallField();
+void test_Autotuner_BlockLoop_EveryConfigurationMatchesDefault_LargeField();
+void test_Autotuner_TuningCache_StoreThenLoad_LastMatchWins();
+void test_Autotuner_TuningCache_ConcurrentCallers_TuneOnce();
+void test_Autotuner_Autotune_ReturnsValidConfiguration();
@@ -0,0 +1,14 @@
+#include "unity.h"
+#include "Bindings/test_HillCipher.hpp"
+
+extern "C" void setUp() {}
+extern "C" void tearDown() {}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    run_all_HillCipher_tests();
+
+    return UNITY_END();
+}
@@ -1,7 +1,23 @@
 #include "unity.h"
 #include "Cipher/test_CipherUtils.h"
+#include "Cipher/test_KeyStore.h"
+#include "Cipher/test_BatchProcessing.h"
+#include "Cipher/test_CipherPipeline.h"
+#include "Cipher/test_ShardCoordinator.h"
 #include "Math/test_FieldBasicOperations.h"
 #include "Math/test_MathUtils.h"
+#include "Math/test_CirculantMatrix.h"
+#include "Math/test_SpecializedKernels.h"
+#include "Math/test_BitslicedGF2.h"
+#include "Math/test_ColumnProductTables.h"
+#include "Instrumentation/test_StageTimers.h"
+#include "Instrumentation/test_Metrics.h"
+#include "IO/test_AsyncLogger.h"
+#include "IO/test_AsyncFileIO.h"
+#include "IO/test_PrintUtils.h"
+#include "Tuning/test_Autotuner.h"
+#include "Secrets/test_SeededSecrets.h"
+#include "Secrets/test_MappedSecrets.h"
 
 void setUp() {}
 void tearDown() {}
@@ -12,7 +28,23 @@ int main()
 
     run_all_FieldBasicOperations_tests();
     run_all_MathUtils_tests();
+    run_all_CirculantMatrix_tests();
+    run_all_SpecializedKernels_tests();
+    run_all_BitslicedGF2_tests();
+    run_all_ColumnProductTables_tests();
     run_all_CipherUtils_tests();
+    run_all_StageTimers_tests();
+    run_all_Metrics_tests();
+    run_all_AsyncLogger_tests();
+    run_all_AsyncFileIO_tests();
+    run_all_PrintUtils_tests();
+    run_all_Autotuner_tests();
+    run_all_SeededSecrets_tests();
+    run_all_MappedSecrets_tests();
+    run_all_KeyStore_tests();
+    run_all_BatchProcessing_tests();
+    run_all_CipherPipeline_tests();
+    run_all_ShardCoordinator_tests();
 
     return UNITY_END();
 }